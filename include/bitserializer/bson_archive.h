@@ -0,0 +1,922 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "bitserializer/serialization_detail/archive_base.h"
+#include "bitserializer/serialization_detail/archive_traits.h"
+#include "bitserializer/serialization_detail/bin_timestamp.h"
+#include "bitserializer/serialization_detail/errors_handling.h"
+
+
+namespace BitSerializer::Bson {
+namespace Detail {
+
+using BitSerializer::Detail::CBinTimestamp;
+
+/// <summary>
+/// The traits of BSON archive (internal implementation - no dependencies)
+/// </summary>
+struct BsonArchiveTraits
+{
+	static constexpr ArchiveType archive_type = ArchiveType::Bson;
+	using key_type = std::string;
+	using supported_key_types = TSupportedKeyTypes<const char*, std::string_view, key_type>;
+	using preferred_output_format = std::basic_string<char, std::char_traits<char>>;
+	using preferred_stream_char_type = char;
+	static constexpr char path_separator = '/';
+
+protected:
+	~BsonArchiveTraits() = default;
+};
+
+/// <summary>
+/// Types of BSON elements (https://bsonspec.org/spec.html).
+/// </summary>
+enum class BsonType : uint8_t
+{
+	EndOfDocument = 0x00,
+	Double = 0x01,
+	String = 0x02,
+	Document = 0x03,
+	Array = 0x04,
+	Binary = 0x05,
+	Undefined = 0x06,
+	ObjectId = 0x07,
+	Boolean = 0x08,
+	DateTime = 0x09,
+	Null = 0x0A,
+	Regex = 0x0B,
+	DbPointer = 0x0C,
+	JavaScript = 0x0D,
+	Symbol = 0x0E,
+	JavaScriptWithScope = 0x0F,
+	Int32 = 0x10,
+	Timestamp = 0x11,
+	Int64 = 0x12,
+	Decimal128 = 0x13,
+	MaxKey = 0x7F,
+	MinKey = 0xFF
+};
+
+class IBsonWriter
+{
+public:
+	virtual ~IBsonWriter() = default;
+
+	virtual void WriteNull(std::string_view key) = 0;
+	virtual void WriteBoolean(std::string_view key, bool value) = 0;
+	virtual void WriteInt32(std::string_view key, int32_t value) = 0;
+	virtual void WriteInt64(std::string_view key, int64_t value) = 0;
+	virtual void WriteDouble(std::string_view key, double value) = 0;
+	virtual void WriteString(std::string_view key, std::string_view value) = 0;
+	virtual void WriteDateTime(std::string_view key, const CBinTimestamp& timestamp) = 0;
+	virtual void WriteBinary(const void* data, size_t size) = 0;
+	virtual void BeginRootDocument() = 0;
+	virtual void BeginDocument(std::string_view key) = 0;
+	virtual void BeginArray(std::string_view key) = 0;
+	virtual void EndDocument() noexcept = 0;
+	virtual void Flush() = 0;
+};
+
+class IBsonReader
+{
+public:
+	virtual ~IBsonReader() = default;
+
+	[[nodiscard]] virtual size_t GetPosition() const noexcept = 0;
+	virtual void SetPosition(size_t pos) noexcept = 0;
+	virtual void ReadKey(std::string_view& key) noexcept = 0;
+	virtual bool ReadValue(std::nullptr_t& value) = 0;
+	virtual bool ReadValue(bool& value) = 0;
+	virtual bool ReadValue(uint8_t& value) = 0;
+	virtual bool ReadValue(uint16_t& value) = 0;
+	virtual bool ReadValue(uint32_t& value) = 0;
+	virtual bool ReadValue(uint64_t& value) = 0;
+	virtual bool ReadValue(int8_t& value) = 0;
+	virtual bool ReadValue(int16_t& value) = 0;
+	virtual bool ReadValue(int32_t& value) = 0;
+	virtual bool ReadValue(int64_t& value) = 0;
+	virtual bool ReadValue(float& value) = 0;
+	virtual bool ReadValue(double& value) = 0;
+	virtual bool ReadValue(std::string_view& value) = 0;
+	virtual bool ReadValue(CBinTimestamp& timestamp) = 0;
+	virtual void ReadRootDocument(size_t& endPos) = 0;
+	[[nodiscard]] virtual size_t CountRootDocuments() const noexcept = 0;
+	virtual bool ReadDocument(size_t& endPos) = 0;
+	virtual bool ReadArray(size_t& arraySize, size_t& endPos) = 0;
+	[[nodiscard]] virtual size_t CountElements(size_t startPos, size_t endPos) const noexcept = 0;
+	virtual bool ReadBinary(void* data, size_t size) noexcept = 0;
+	virtual void EndArray(size_t endPos) noexcept = 0;
+	virtual void SkipValue() noexcept = 0;
+};
+
+
+/// <summary>
+/// Base class of BSON scope
+/// </summary>
+class BsonScopeBase : public BsonArchiveTraits
+{
+public:
+	BsonScopeBase(const BsonScopeBase&) = delete;
+	BsonScopeBase& operator=(const BsonScopeBase&) = delete;
+
+	/// <summary>
+	/// Gets the current path in BSON (in the same format as JSON Pointer).
+	/// </summary>
+	[[nodiscard]] virtual std::string GetPath() const
+	{
+		const std::string localPath = mParentKey.empty()
+			? std::string()
+			: path_separator + std::string(mParentKey);
+		return mParent == nullptr ? localPath : mParent->GetPath() + localPath;
+	}
+
+protected:
+	explicit BsonScopeBase(const BsonScopeBase* parent = nullptr, std::string_view parentKey = {}) noexcept
+		: mParent(parent)
+		, mParentKey(parentKey)
+	{ }
+
+	~BsonScopeBase() = default;
+
+	/// <summary>
+	/// Number type with fixed width which is used for loading value with type `T`.
+	/// </summary>
+	template <typename T>
+	using fixed_number_t = std::conditional_t<std::is_floating_point_v<T>,
+		std::conditional_t<std::is_same_v<T, float>, float, double>,
+		std::conditional_t<std::is_signed_v<T>,
+			std::conditional_t<sizeof(T) == 1, int8_t, std::conditional_t<sizeof(T) == 2, int16_t, std::conditional_t<sizeof(T) == 4, int32_t, int64_t>>>,
+			std::conditional_t<sizeof(T) == 1, uint8_t, std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>>>;
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	static bool LoadValue(IBsonReader* bsonReader, T& value)
+	{
+		if constexpr (std::is_same_v<T, bool> || std::is_null_pointer_v<T>)
+		{
+			return bsonReader->ReadValue(value);
+		}
+		else
+		{
+			fixed_number_t<T> fixedValue;
+			if (bsonReader->ReadValue(fixedValue))
+			{
+				value = static_cast<T>(fixedValue);
+				return true;
+			}
+			return false;
+		}
+	}
+
+	template <typename TSym, typename TAllocator>
+	static bool LoadValue(IBsonReader* bsonReader, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		if (std::string_view strValue; bsonReader->ReadValue(strValue))
+		{
+			if constexpr (std::is_same_v<TSym, char>) {
+				value.assign(strValue.data(), strValue.size());
+			}
+			else {
+				value = Convert::To<std::basic_string<TSym, std::char_traits<TSym>, TAllocator>>(strValue);
+			}
+			return true;
+		}
+		return false;
+	}
+
+	/// <summary>
+	/// Saves the fundamental value with the most compact BSON type (integers which fit to 32 bits are stored as "int32").
+	/// </summary>
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	static void SaveValue(IBsonWriter* bsonWriter, std::string_view key, const T& value)
+	{
+		if constexpr (std::is_null_pointer_v<T>) {
+			bsonWriter->WriteNull(key);
+		}
+		else if constexpr (std::is_same_v<T, bool>) {
+			bsonWriter->WriteBoolean(key, value);
+		}
+		else if constexpr (std::is_floating_point_v<T>) {
+			bsonWriter->WriteDouble(key, static_cast<double>(value));
+		}
+		else if constexpr (sizeof(T) < 4 || (std::is_signed_v<T> && sizeof(T) == 4)) {
+			bsonWriter->WriteInt32(key, static_cast<int32_t>(value));
+		}
+		else
+		{
+			if constexpr (std::is_unsigned_v<T> && sizeof(T) == 8)
+			{
+				// BSON does not have unsigned 64-bit integer type
+				if (value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+				{
+					throw SerializationException(SerializationErrorCode::Overflow,
+						"The number " + Convert::ToString(value) + " does not fit to BSON \"int64\" type");
+				}
+			}
+			bsonWriter->WriteInt64(key, static_cast<int64_t>(value));
+		}
+	}
+
+	template <typename TSym, typename TAllocator>
+	static void SaveValue(IBsonWriter* bsonWriter, std::string_view key, const std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		if constexpr (std::is_same_v<TSym, char>) {
+			bsonWriter->WriteString(key, std::string_view(value.data(), value.size()));
+		}
+		else {
+			bsonWriter->WriteString(key, Convert::ToString(value));
+		}
+	}
+
+	const BsonScopeBase* mParent;
+	std::string_view mParentKey;
+};
+
+
+// Forward declarations
+class BsonWriteObjectScope;
+
+/// <summary>
+/// BSON scope for writing arrays (stored as documents with keys "0", "1", "2" ...).
+/// Arrays of bytes are written as BSON binary (when they are serialized via `SerializeBlock()`).
+/// </summary>
+class BsonWriteArrayScope final : public TArchiveScope<SerializeMode::Save>, public BsonScopeBase
+{
+public:
+	BsonWriteArrayScope(IBsonWriter* bsonWriter, SerializationContext& serializationContext,
+		const BsonScopeBase* parent = nullptr, std::string_view parentKey = {})
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, BsonScopeBase(parent, parentKey)
+		, mBsonWriter(bsonWriter)
+	{ }
+
+	~BsonWriteArrayScope()
+	{
+		mBsonWriter->EndDocument();
+	}
+
+	/// <summary>
+	/// Gets the current path in BSON (in the same format as JSON Pointer).
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const override
+	{
+		return BsonScopeBase::GetPath() + path_separator + Convert::ToString(mIndex);
+	}
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		SaveValue(mBsonWriter, NextKey(), value);
+		return true;
+	}
+
+	template <typename TSym, typename TAllocator>
+	bool SerializeValue(std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		SaveValue(mBsonWriter, NextKey(), value);
+		return true;
+	}
+
+	bool SerializeValue(std::string_view& value)
+	{
+		mBsonWriter->WriteString(NextKey(), value);
+		return true;
+	}
+
+	bool SerializeValue(CBinTimestamp& timestamp)
+	{
+		mBsonWriter->WriteDateTime(NextKey(), timestamp);
+		return true;
+	}
+
+	/// <summary>
+	/// Writes the array of bytes as BSON binary (must be called before any other values).
+	/// </summary>
+	template <typename T, std::enable_if_t<is_binary_item_v<T>, int> = 0>
+	bool SerializeBlock(T* data, size_t size)
+	{
+		if (mIndex != 0)
+		{
+			for (size_t i = 0; i < size; ++i) {
+				SerializeValue(data[i]);
+			}
+			return true;
+		}
+		mBsonWriter->WriteBinary(data, size);
+		mIndex = size;
+		return true;
+	}
+
+	std::optional<BsonWriteObjectScope> OpenObjectScope();
+
+	std::optional<BsonWriteArrayScope> OpenArrayScope(size_t)
+	{
+		mBsonWriter->BeginArray(NextKey());
+		return std::make_optional<BsonWriteArrayScope>(mBsonWriter, GetContext(), this);
+	}
+
+private:
+	/// <summary>
+	/// Returns the key of the next item (index of item as string).
+	/// </summary>
+	std::string_view NextKey() noexcept
+	{
+		const auto result = std::to_chars(mKeyBuffer, mKeyBuffer + sizeof(mKeyBuffer), mIndex++);
+		return { mKeyBuffer, static_cast<size_t>(result.ptr - mKeyBuffer) };
+	}
+
+	IBsonWriter* mBsonWriter;
+	size_t mIndex = 0;
+	char mKeyBuffer[24] = {};
+};
+
+
+/// <summary>
+/// BSON scope for writing objects (list of values with keys).
+/// </summary>
+class BsonWriteObjectScope final : public TArchiveScope<SerializeMode::Save>, public BsonScopeBase
+{
+public:
+	BsonWriteObjectScope(IBsonWriter* bsonWriter, SerializationContext& serializationContext,
+		const BsonScopeBase* parent = nullptr, std::string_view parentKey = {})
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, BsonScopeBase(parent, parentKey)
+		, mBsonWriter(bsonWriter)
+	{ }
+
+	~BsonWriteObjectScope()
+	{
+		mBsonWriter->EndDocument();
+	}
+
+	/// <summary>
+	/// Constant iterator for keys (saved keys are not accessible, so the range is always empty).
+	/// </summary>
+	class key_const_iterator
+	{
+	public:
+		bool operator==(const key_const_iterator&) const noexcept { return true; }
+		bool operator!=(const key_const_iterator&) const noexcept { return false; }
+		key_const_iterator& operator++() noexcept { return *this; }
+		key_type operator*() const { return {}; }
+	};
+
+	[[nodiscard]] key_const_iterator cbegin() const noexcept { return {}; }
+	[[nodiscard]] key_const_iterator cend() const noexcept { return {}; }
+
+	template <typename TKey, typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(TKey&& key, T& value)
+	{
+		SaveValue(mBsonWriter, std::string_view(key), value);
+		return true;
+	}
+
+	template <typename TKey, typename TSym, typename TAllocator>
+	bool SerializeValue(TKey&& key, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		SaveValue(mBsonWriter, std::string_view(key), value);
+		return true;
+	}
+
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, std::string_view& value)
+	{
+		mBsonWriter->WriteString(std::string_view(key), value);
+		return true;
+	}
+
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, CBinTimestamp& timestamp)
+	{
+		mBsonWriter->WriteDateTime(std::string_view(key), timestamp);
+		return true;
+	}
+
+	template <typename TKey>
+	std::optional<BsonWriteObjectScope> OpenObjectScope(TKey&& key)
+	{
+		const std::string_view keyView(key);
+		mBsonWriter->BeginDocument(keyView);
+		return std::make_optional<BsonWriteObjectScope>(mBsonWriter, GetContext(), this, keyView);
+	}
+
+	template <typename TKey>
+	std::optional<BsonWriteArrayScope> OpenArrayScope(TKey&& key, size_t)
+	{
+		const std::string_view keyView(key);
+		mBsonWriter->BeginArray(keyView);
+		return std::make_optional<BsonWriteArrayScope>(mBsonWriter, GetContext(), this, keyView);
+	}
+
+private:
+	IBsonWriter* mBsonWriter;
+};
+
+inline std::optional<BsonWriteObjectScope> BsonWriteArrayScope::OpenObjectScope()
+{
+	mBsonWriter->BeginDocument(NextKey());
+	return std::make_optional<BsonWriteObjectScope>(mBsonWriter, GetContext(), this);
+}
+
+
+/// <summary>
+/// BSON scope for writing the sequence of root documents (the same layout as in dumps of document databases).
+/// Each completed document is flushed to the output stream, so the whole sequence is not kept in memory.
+/// </summary>
+class BsonWriteRootArrayScope final : public TArchiveScope<SerializeMode::Save>, public BsonScopeBase
+{
+public:
+	BsonWriteRootArrayScope(IBsonWriter* bsonWriter, SerializationContext& serializationContext) noexcept
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mBsonWriter(bsonWriter)
+	{ }
+
+	/// <summary>
+	/// Gets the current path in BSON (in the same format as JSON Pointer).
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const override
+	{
+		return path_separator + Convert::ToString(mIndex);
+	}
+
+	std::optional<BsonWriteObjectScope> OpenObjectScope()
+	{
+		if (mIndex++ != 0) {
+			mBsonWriter->Flush();
+		}
+		mBsonWriter->BeginRootDocument();
+		return std::make_optional<BsonWriteObjectScope>(mBsonWriter, GetContext(), this);
+	}
+
+private:
+	IBsonWriter* mBsonWriter;
+	size_t mIndex = 0;
+};
+
+
+/// <summary>
+/// BSON root scope (can write one document or the sequence of documents)
+/// </summary>
+class BsonWriteRootScope final : public TArchiveScope<SerializeMode::Save>, public BsonScopeBase
+{
+public:
+	BsonWriteRootScope(std::string& outputData, SerializationContext& serializationContext);
+	BsonWriteRootScope(std::vector<uint8_t>& outputData, SerializationContext& serializationContext);
+	BsonWriteRootScope(std::ostream& outputStream, SerializationContext& serializationContext);
+
+	std::optional<BsonWriteObjectScope> OpenObjectScope()
+	{
+		mBsonWriter->BeginRootDocument();
+		return std::make_optional<BsonWriteObjectScope>(mBsonWriter.get(), GetContext());
+	}
+
+	std::optional<BsonWriteRootArrayScope> OpenArrayScope(size_t)
+	{
+		return std::make_optional<BsonWriteRootArrayScope>(mBsonWriter.get(), GetContext());
+	}
+
+	void Finalize()
+	{
+		mBsonWriter->Flush();
+	}
+
+private:
+	std::unique_ptr<IBsonWriter> mBsonWriter;
+};
+
+
+// Forward declarations
+class BsonReadObjectScope;
+
+/// <summary>
+/// BSON scope for reading arrays (documents with keys "0", "1", "2" ... or binary data).
+/// </summary>
+class BsonReadArrayScope final : public TArchiveScope<SerializeMode::Load>, public BsonScopeBase
+{
+public:
+	BsonReadArrayScope(IBsonReader* bsonReader, size_t arraySize, size_t endPos, SerializationContext& serializationContext,
+		const BsonScopeBase* parent = nullptr, std::string_view parentKey = {}) noexcept
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, BsonScopeBase(parent, parentKey)
+		, mBsonReader(bsonReader)
+		, mSize(arraySize)
+		, mEndPos(endPos)
+	{ }
+
+	~BsonReadArrayScope()
+	{
+		// Skip not loaded items (the size of array is known, so it does not require parsing them)
+		mBsonReader->EndArray(mEndPos);
+	}
+
+	/// <summary>
+	/// Gets the current path in BSON (in the same format as JSON Pointer).
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const override
+	{
+		return BsonScopeBase::GetPath() + path_separator + Convert::ToString(mIndex);
+	}
+
+	/// <summary>
+	/// Returns the exact number of items to load (for reserving the size of containers).
+	/// </summary>
+	[[nodiscard]] size_t GetEstimatedSize() const noexcept
+	{
+		return mSize;
+	}
+
+	/// <summary>
+	/// Returns `true` when all no more values to load.
+	/// </summary>
+	[[nodiscard]] bool IsEnd() const noexcept
+	{
+		return mIndex == mSize;
+	}
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		NextItem();
+		return LoadValue(mBsonReader, value);
+	}
+
+	template <typename TSym, typename TAllocator>
+	bool SerializeValue(std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		NextItem();
+		return LoadValue(mBsonReader, value);
+	}
+
+	/// <summary>
+	/// Reads the value as view to the input data (valid until the archive is destroyed).
+	/// </summary>
+	bool SerializeValue(std::string_view& value)
+	{
+		NextItem();
+		return mBsonReader->ReadValue(value);
+	}
+
+	bool SerializeValue(CBinTimestamp& timestamp)
+	{
+		NextItem();
+		return mBsonReader->ReadValue(timestamp);
+	}
+
+	/// <summary>
+	/// Loads all bytes of array into the continuous block of memory.
+	/// The BSON binary is just copied, regular arrays are loaded item by item.
+	/// </summary>
+	template <typename T, std::enable_if_t<is_binary_item_v<T>, int> = 0>
+	bool SerializeBlock(T* data, size_t size)
+	{
+		if (mIndex != 0 || size != mSize)
+		{
+			throw SerializationException(SerializationErrorCode::OutOfRange,
+				"The size of target block does not match the number of loading items");
+		}
+		if (mBsonReader->ReadBinary(data, size))
+		{
+			mIndex = size;
+			return true;
+		}
+		for (size_t i = 0; i < size; ++i) {
+			SerializeValue(data[i]);
+		}
+		return true;
+	}
+
+	std::optional<BsonReadObjectScope> OpenObjectScope();
+
+	std::optional<BsonReadArrayScope> OpenArrayScope(size_t)
+	{
+		NextItem();
+		if (size_t actualSize, endPos; mBsonReader->ReadArray(actualSize, endPos)) {
+			return std::make_optional<BsonReadArrayScope>(mBsonReader, actualSize, endPos, GetContext(), this);
+		}
+		return std::nullopt;
+	}
+
+private:
+	void NextItem()
+	{
+		if (mIndex == mSize) {
+			throw SerializationException(SerializationErrorCode::OutOfRange, "No more items to load");
+		}
+		++mIndex;
+		std::string_view key;
+		mBsonReader->ReadKey(key);
+	}
+
+	IBsonReader* mBsonReader;
+	size_t mSize;
+	size_t mEndPos;
+	size_t mIndex = 0;
+};
+
+
+/// <summary>
+/// BSON scope for reading objects (list of values with keys).
+/// Values are searched starting from the last loaded one, so loading in the same order as they were saved does not require any lookups.
+/// Not matched elements are skipped by their length prefixes, without parsing them.
+/// </summary>
+class BsonReadObjectScope final : public TArchiveScope<SerializeMode::Load>, public BsonScopeBase
+{
+public:
+	BsonReadObjectScope(IBsonReader* bsonReader, size_t endPos, SerializationContext& serializationContext,
+		const BsonScopeBase* parent = nullptr, std::string_view parentKey = {}) noexcept
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, BsonScopeBase(parent, parentKey)
+		, mBsonReader(bsonReader)
+		, mStartPos(bsonReader->GetPosition())
+		, mEndPos(endPos)
+	{ }
+
+	~BsonReadObjectScope()
+	{
+		// Skip not loaded elements
+		mBsonReader->SetPosition(mEndPos);
+	}
+
+	/// <summary>
+	/// Constant iterator for keys.
+	/// </summary>
+	class key_const_iterator
+	{
+		friend class BsonReadObjectScope;
+
+		IBsonReader* mBsonReader;
+		size_t mPos;
+
+		key_const_iterator(IBsonReader* bsonReader, size_t pos) noexcept
+			: mBsonReader(bsonReader), mPos(pos) { }
+
+	public:
+		bool operator==(const key_const_iterator& rhs) const noexcept {
+			return mPos == rhs.mPos;
+		}
+		bool operator!=(const key_const_iterator& rhs) const noexcept {
+			return mPos != rhs.mPos;
+		}
+
+		key_const_iterator& operator++() noexcept
+		{
+			const size_t currentPos = mBsonReader->GetPosition();
+			mBsonReader->SetPosition(mPos);
+			std::string_view key;
+			mBsonReader->ReadKey(key);
+			mBsonReader->SkipValue();
+			mPos = mBsonReader->GetPosition();
+			mBsonReader->SetPosition(currentPos);
+			return *this;
+		}
+
+		key_type operator*() const
+		{
+			const size_t currentPos = mBsonReader->GetPosition();
+			mBsonReader->SetPosition(mPos);
+			std::string_view key;
+			mBsonReader->ReadKey(key);
+			mBsonReader->SetPosition(currentPos);
+			return key_type(key);
+		}
+	};
+
+	/// <summary>
+	/// Get the begin constant iterator of keys.
+	/// </summary>
+	[[nodiscard]] key_const_iterator cbegin() const noexcept {
+		return { mBsonReader, mStartPos };
+	}
+
+	/// <summary>
+	/// Get the end constant iterator of keys.
+	/// </summary>
+	[[nodiscard]] key_const_iterator cend() const noexcept {
+		return { mBsonReader, GetTerminatorPos() };
+	}
+
+	/// <summary>
+	/// Returns the exact number of elements to load (for reserving the size of containers).
+	/// </summary>
+	[[nodiscard]] size_t GetEstimatedSize() const noexcept
+	{
+		return mBsonReader->CountElements(mStartPos, GetTerminatorPos());
+	}
+
+	template <typename TKey, typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(TKey&& key, T& value)
+	{
+		return FindValue(key) && LoadValue(mBsonReader, value);
+	}
+
+	template <typename TKey, typename TSym, typename TAllocator>
+	bool SerializeValue(TKey&& key, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		return FindValue(key) && LoadValue(mBsonReader, value);
+	}
+
+	/// <summary>
+	/// Reads the value as view to the input data (valid until the archive is destroyed).
+	/// </summary>
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, std::string_view& value)
+	{
+		return FindValue(key) && mBsonReader->ReadValue(value);
+	}
+
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, CBinTimestamp& timestamp)
+	{
+		return FindValue(key) && mBsonReader->ReadValue(timestamp);
+	}
+
+	template <typename TKey>
+	std::optional<BsonReadObjectScope> OpenObjectScope(TKey&& key)
+	{
+		const std::string_view keyView(key);
+		if (size_t endPos; FindValue(keyView) && mBsonReader->ReadDocument(endPos)) {
+			return std::make_optional<BsonReadObjectScope>(mBsonReader, endPos, GetContext(), this, keyView);
+		}
+		return std::nullopt;
+	}
+
+	template <typename TKey>
+	std::optional<BsonReadArrayScope> OpenArrayScope(TKey&& key, size_t)
+	{
+		const std::string_view keyView(key);
+		if (size_t actualSize, endPos; FindValue(keyView) && mBsonReader->ReadArray(actualSize, endPos)) {
+			return std::make_optional<BsonReadArrayScope>(mBsonReader, actualSize, endPos, GetContext(), this, keyView);
+		}
+		return std::nullopt;
+	}
+
+private:
+	/// <summary>
+	/// Returns position of the terminating zero of document.
+	/// </summary>
+	[[nodiscard]] size_t GetTerminatorPos() const noexcept
+	{
+		return mEndPos - 1;
+	}
+
+	/// <summary>
+	/// Finds the value by key, starts searching from the current position of reader (must point to the element).
+	/// When the key is found, the reader will be positioned on the value.
+	/// </summary>
+	bool FindValue(std::string_view key) noexcept
+	{
+		const size_t terminatorPos = GetTerminatorPos();
+		if (mBsonReader->GetPosition() == terminatorPos) {
+			mBsonReader->SetPosition(mStartPos);
+		}
+
+		const size_t firstPos = mBsonReader->GetPosition();
+		if (firstPos == terminatorPos) {
+			return false;
+		}
+		do
+		{
+			std::string_view currentKey;
+			mBsonReader->ReadKey(currentKey);
+			if (currentKey == key) {
+				return true;
+			}
+			mBsonReader->SkipValue();
+			if (mBsonReader->GetPosition() == terminatorPos) {
+				mBsonReader->SetPosition(mStartPos);
+			}
+		} while (mBsonReader->GetPosition() != firstPos);
+		return false;
+	}
+
+	IBsonReader* mBsonReader;
+	size_t mStartPos;
+	size_t mEndPos;
+};
+
+inline std::optional<BsonReadObjectScope> BsonReadArrayScope::OpenObjectScope()
+{
+	NextItem();
+	if (size_t endPos; mBsonReader->ReadDocument(endPos)) {
+		return std::make_optional<BsonReadObjectScope>(mBsonReader, endPos, GetContext(), this);
+	}
+	return std::nullopt;
+}
+
+
+/// <summary>
+/// BSON scope for reading the sequence of root documents (the same layout as in dumps of document databases).
+/// </summary>
+class BsonReadRootArrayScope final : public TArchiveScope<SerializeMode::Load>, public BsonScopeBase
+{
+public:
+	BsonReadRootArrayScope(IBsonReader* bsonReader, SerializationContext& serializationContext) noexcept
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mBsonReader(bsonReader)
+		, mSize(bsonReader->CountRootDocuments())
+	{ }
+
+	/// <summary>
+	/// Gets the current path in BSON (in the same format as JSON Pointer).
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const override
+	{
+		return path_separator + Convert::ToString(mIndex);
+	}
+
+	/// <summary>
+	/// Returns the exact number of documents to load (for reserving the size of containers).
+	/// </summary>
+	[[nodiscard]] size_t GetEstimatedSize() const noexcept
+	{
+		return mSize;
+	}
+
+	/// <summary>
+	/// Returns `true` when all no more documents to load.
+	/// </summary>
+	[[nodiscard]] bool IsEnd() const noexcept
+	{
+		return mIndex == mSize;
+	}
+
+	std::optional<BsonReadObjectScope> OpenObjectScope()
+	{
+		if (mIndex == mSize) {
+			throw SerializationException(SerializationErrorCode::OutOfRange, "No more items to load");
+		}
+		++mIndex;
+		size_t endPos;
+		mBsonReader->ReadRootDocument(endPos);
+		return std::make_optional<BsonReadObjectScope>(mBsonReader, endPos, GetContext(), this);
+	}
+
+private:
+	IBsonReader* mBsonReader;
+	size_t mSize;
+	size_t mIndex = 0;
+};
+
+
+/// <summary>
+/// BSON root scope (can read one document or the sequence of documents)
+/// </summary>
+class BsonReadRootScope final : public TArchiveScope<SerializeMode::Load>, public BsonScopeBase
+{
+public:
+	BsonReadRootScope(std::string_view inputData, SerializationContext& serializationContext);
+	BsonReadRootScope(const std::vector<uint8_t>& inputData, SerializationContext& serializationContext);
+	BsonReadRootScope(std::istream& inputStream, SerializationContext& serializationContext);
+
+	std::optional<BsonReadObjectScope> OpenObjectScope()
+	{
+		if (mBsonReader->CountRootDocuments() != 1)
+		{
+			throw ParsingException("Input data must contain exactly one root document (load it as array for reading a sequence of documents)",
+				0, mBsonReader->GetPosition());
+		}
+		size_t endPos;
+		mBsonReader->ReadRootDocument(endPos);
+		return std::make_optional<BsonReadObjectScope>(mBsonReader.get(), endPos, GetContext());
+	}
+
+	std::optional<BsonReadRootArrayScope> OpenArrayScope(size_t)
+	{
+		return std::make_optional<BsonReadRootArrayScope>(mBsonReader.get(), GetContext());
+	}
+
+	void Finalize() const noexcept { /* Not required */ }
+
+private:
+	std::string mStreamData;
+	std::unique_ptr<IBsonReader> mBsonReader;
+};
+
+}
+
+
+/// <summary>
+/// BSON archive (internal implementation - no dependencies).
+/// Documents are written in a single pass (sizes are patched when documents are closed), elements are read directly
+/// from the input data, not matched ones are skipped by their length prefixes. The root array is represented as
+/// a sequence of documents, in the same way as dumps of document databases.
+/// Supports load/save from:
+/// - <c>std::string</c>: binary data
+/// - <c>std::vector&lt;uint8_t&gt;</c>: binary data
+/// - <c>std::istream</c> and <c>std::ostream</c>: binary data
+/// </summary>
+using BsonArchive = TArchiveBase<
+	Detail::BsonArchiveTraits,
+	Detail::BsonReadRootScope,
+	Detail::BsonWriteRootScope>;
+
+}
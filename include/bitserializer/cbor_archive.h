@@ -0,0 +1,830 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "bitserializer/serialization_detail/archive_base.h"
+#include "bitserializer/serialization_detail/errors_handling.h"
+#include "bitserializer/serialization_detail/bin_timestamp.h"
+
+
+namespace BitSerializer::Cbor {
+namespace Detail {
+
+using BitSerializer::Detail::CBinTimestamp;
+
+/// <summary>
+/// The traits of CBOR archive (internal implementation - no dependencies)
+/// </summary>
+struct CborArchiveTraits
+{
+	static constexpr ArchiveType archive_type = ArchiveType::Cbor;
+	using key_type = std::string;
+	using supported_key_types = TSupportedKeyTypes<const char*, std::string_view, key_type>;
+	using preferred_output_format = std::basic_string<char, std::char_traits<char>>;
+	using preferred_stream_char_type = char;
+	static constexpr char path_separator = '/';
+
+protected:
+	~CborArchiveTraits() = default;
+};
+
+class ICborWriter
+{
+public:
+	virtual ~ICborWriter() = default;
+
+	virtual void WriteNull() = 0;
+	virtual void WriteBoolean(bool value) = 0;
+	virtual void WriteSignedInteger(int64_t value) = 0;
+	virtual void WriteUnsignedInteger(uint64_t value) = 0;
+	virtual void WriteFloat(float value) = 0;
+	virtual void WriteDouble(double value) = 0;
+	virtual void WriteString(std::string_view value) = 0;
+	virtual void WriteTimestamp(const CBinTimestamp& timestamp) = 0;
+	virtual void BeginArray(size_t arraySize) = 0;
+	virtual void EndArray(size_t actualSize) noexcept = 0;
+	virtual void BeginMap() = 0;
+	virtual void EndMap(size_t actualSize) noexcept = 0;
+	virtual void Flush() = 0;
+};
+
+class ICborReader
+{
+public:
+	virtual ~ICborReader() = default;
+
+	[[nodiscard]] virtual size_t GetPosition() const noexcept = 0;
+	virtual void SetPosition(size_t pos) noexcept = 0;
+	virtual bool ReadValue(std::nullptr_t& value) = 0;
+	virtual bool ReadValue(bool& value) = 0;
+	virtual bool ReadValue(uint8_t& value) = 0;
+	virtual bool ReadValue(uint16_t& value) = 0;
+	virtual bool ReadValue(uint32_t& value) = 0;
+	virtual bool ReadValue(uint64_t& value) = 0;
+	virtual bool ReadValue(int8_t& value) = 0;
+	virtual bool ReadValue(int16_t& value) = 0;
+	virtual bool ReadValue(int32_t& value) = 0;
+	virtual bool ReadValue(int64_t& value) = 0;
+	virtual bool ReadValue(float& value) = 0;
+	virtual bool ReadValue(double& value) = 0;
+	virtual bool ReadValue(std::string_view& value) = 0;
+	virtual bool ReadValue(CBinTimestamp& timestamp) = 0;
+	virtual bool ReadKey(std::string_view& key) = 0;
+	virtual bool ReadArraySize(size_t& arraySize, bool& isIndefinite) noexcept = 0;
+	virtual bool ReadMapSize(size_t& mapSize, bool& isIndefinite) noexcept = 0;
+	virtual void SkipValue() noexcept = 0;
+	virtual void SkipBreak() noexcept = 0;
+};
+
+
+/// <summary>
+/// Base class of CBOR scope
+/// </summary>
+class CborScopeBase : public CborArchiveTraits
+{
+public:
+	CborScopeBase(const CborScopeBase&) = delete;
+	CborScopeBase& operator=(const CborScopeBase&) = delete;
+
+	/// <summary>
+	/// Gets the current path in CBOR (in the same format as JSON Pointer).
+	/// </summary>
+	[[nodiscard]] virtual std::string GetPath() const
+	{
+		const std::string localPath = mParentKey.empty()
+			? std::string()
+			: path_separator + std::string(mParentKey);
+		return mParent == nullptr ? localPath : mParent->GetPath() + localPath;
+	}
+
+protected:
+	explicit CborScopeBase(const CborScopeBase* parent = nullptr, std::string_view parentKey = {}) noexcept
+		: mParent(parent)
+		, mParentKey(parentKey)
+	{ }
+
+	~CborScopeBase() = default;
+
+	/// <summary>
+	/// Integral type with fixed width which is used for reading value with type `T`.
+	/// </summary>
+	template <typename T>
+	using fixed_integral_t = std::conditional_t<std::is_signed_v<T>,
+		std::conditional_t<sizeof(T) == 1, int8_t, std::conditional_t<sizeof(T) == 2, int16_t, std::conditional_t<sizeof(T) == 4, int32_t, int64_t>>>,
+		std::conditional_t<sizeof(T) == 1, uint8_t, std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>>;
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	static bool LoadValue(ICborReader* cborReader, T& value)
+	{
+		if constexpr (std::is_same_v<T, bool> || std::is_null_pointer_v<T> || std::is_same_v<T, float> || std::is_same_v<T, double>)
+		{
+			return cborReader->ReadValue(value);
+		}
+		else if constexpr (std::is_floating_point_v<T>)
+		{
+			double fixedValue;
+			if (cborReader->ReadValue(fixedValue))
+			{
+				value = static_cast<T>(fixedValue);
+				return true;
+			}
+			return false;
+		}
+		else
+		{
+			fixed_integral_t<T> fixedValue;
+			if (cborReader->ReadValue(fixedValue))
+			{
+				value = static_cast<T>(fixedValue);
+				return true;
+			}
+			return false;
+		}
+	}
+
+	template <typename TSym, typename TAllocator>
+	static bool LoadValue(ICborReader* cborReader, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		if (std::string_view strValue; cborReader->ReadValue(strValue))
+		{
+			if constexpr (std::is_same_v<TSym, char>) {
+				value.assign(strValue.data(), strValue.size());
+			}
+			else {
+				value = Convert::To<std::basic_string<TSym, std::char_traits<TSym>, TAllocator>>(strValue);
+			}
+			return true;
+		}
+		return false;
+	}
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	static void SaveValue(ICborWriter* cborWriter, const T& value)
+	{
+		if constexpr (std::is_null_pointer_v<T>) {
+			cborWriter->WriteNull();
+		}
+		else if constexpr (std::is_same_v<T, bool>) {
+			cborWriter->WriteBoolean(value);
+		}
+		else if constexpr (std::is_same_v<T, float>) {
+			cborWriter->WriteFloat(value);
+		}
+		else if constexpr (std::is_floating_point_v<T>) {
+			cborWriter->WriteDouble(static_cast<double>(value));
+		}
+		else if constexpr (std::is_signed_v<T>) {
+			cborWriter->WriteSignedInteger(value);
+		}
+		else {
+			cborWriter->WriteUnsignedInteger(value);
+		}
+	}
+
+	template <typename TSym, typename TAllocator>
+	static void SaveValue(ICborWriter* cborWriter, const std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		if constexpr (std::is_same_v<TSym, char>) {
+			cborWriter->WriteString(std::string_view(value.data(), value.size()));
+		}
+		else {
+			cborWriter->WriteString(Convert::ToString(value));
+		}
+	}
+
+	const CborScopeBase* mParent;
+	std::string_view mParentKey;
+};
+
+
+// Forward declarations
+class CborWriteObjectScope;
+
+/// <summary>
+/// CBOR scope for writing arrays (list of values without keys).
+/// </summary>
+class CborWriteArrayScope final : public TArchiveScope<SerializeMode::Save>, public CborScopeBase
+{
+public:
+	CborWriteArrayScope(ICborWriter* cborWriter, size_t arraySize, SerializationContext& serializationContext,
+		const CborScopeBase* parent = nullptr, std::string_view parentKey = {})
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, CborScopeBase(parent, parentKey)
+		, mCborWriter(cborWriter)
+	{
+		mCborWriter->BeginArray(arraySize);
+	}
+
+	~CborWriteArrayScope()
+	{
+		mCborWriter->EndArray(mIndex);
+	}
+
+	/// <summary>
+	/// Gets the current path in CBOR (in the same format as JSON Pointer).
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const override
+	{
+		return CborScopeBase::GetPath() + path_separator + Convert::ToString(mIndex);
+	}
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		SaveValue(mCborWriter, value);
+		++mIndex;
+		return true;
+	}
+
+	template <typename TSym, typename TAllocator>
+	bool SerializeValue(std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		SaveValue(mCborWriter, value);
+		++mIndex;
+		return true;
+	}
+
+	bool SerializeValue(std::string_view& value)
+	{
+		mCborWriter->WriteString(value);
+		++mIndex;
+		return true;
+	}
+
+	bool SerializeValue(CBinTimestamp& timestamp)
+	{
+		mCborWriter->WriteTimestamp(timestamp);
+		++mIndex;
+		return true;
+	}
+
+	std::optional<CborWriteObjectScope> OpenObjectScope();
+
+	std::optional<CborWriteArrayScope> OpenArrayScope(size_t arraySize)
+	{
+		++mIndex;
+		return std::make_optional<CborWriteArrayScope>(mCborWriter, arraySize, GetContext(), this);
+	}
+
+private:
+	ICborWriter* mCborWriter;
+	size_t mIndex = 0;
+};
+
+
+/// <summary>
+/// CBOR scope for writing objects (list of values with keys).
+/// </summary>
+class CborWriteObjectScope final : public TArchiveScope<SerializeMode::Save>, public CborScopeBase
+{
+public:
+	CborWriteObjectScope(ICborWriter* cborWriter, SerializationContext& serializationContext,
+		const CborScopeBase* parent = nullptr, std::string_view parentKey = {})
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, CborScopeBase(parent, parentKey)
+		, mCborWriter(cborWriter)
+	{
+		mCborWriter->BeginMap();
+	}
+
+	~CborWriteObjectScope()
+	{
+		mCborWriter->EndMap(mSize);
+	}
+
+	/// <summary>
+	/// Constant iterator for keys (saved keys are not accessible, so the range is always empty).
+	/// </summary>
+	class key_const_iterator
+	{
+	public:
+		bool operator==(const key_const_iterator&) const noexcept { return true; }
+		bool operator!=(const key_const_iterator&) const noexcept { return false; }
+		key_const_iterator& operator++() noexcept { return *this; }
+		key_type operator*() const { return {}; }
+	};
+
+	[[nodiscard]] key_const_iterator cbegin() const noexcept { return {}; }
+	[[nodiscard]] key_const_iterator cend() const noexcept { return {}; }
+
+	template <typename TKey, typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(TKey&& key, T& value)
+	{
+		WriteKey(key);
+		SaveValue(mCborWriter, value);
+		return true;
+	}
+
+	template <typename TKey, typename TSym, typename TAllocator>
+	bool SerializeValue(TKey&& key, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		WriteKey(key);
+		SaveValue(mCborWriter, value);
+		return true;
+	}
+
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, std::string_view& value)
+	{
+		WriteKey(key);
+		mCborWriter->WriteString(value);
+		return true;
+	}
+
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, CBinTimestamp& timestamp)
+	{
+		WriteKey(key);
+		mCborWriter->WriteTimestamp(timestamp);
+		return true;
+	}
+
+	template <typename TKey>
+	std::optional<CborWriteObjectScope> OpenObjectScope(TKey&& key)
+	{
+		const std::string_view keyView = WriteKey(key);
+		return std::make_optional<CborWriteObjectScope>(mCborWriter, GetContext(), this, keyView);
+	}
+
+	template <typename TKey>
+	std::optional<CborWriteArrayScope> OpenArrayScope(TKey&& key, size_t arraySize)
+	{
+		const std::string_view keyView = WriteKey(key);
+		return std::make_optional<CborWriteArrayScope>(mCborWriter, arraySize, GetContext(), this, keyView);
+	}
+
+private:
+	template <typename TKey>
+	std::string_view WriteKey(const TKey& key)
+	{
+		const std::string_view keyView(key);
+		mCborWriter->WriteString(keyView);
+		++mSize;
+		return keyView;
+	}
+
+	ICborWriter* mCborWriter;
+	size_t mSize = 0;
+};
+
+inline std::optional<CborWriteObjectScope> CborWriteArrayScope::OpenObjectScope()
+{
+	++mIndex;
+	return std::make_optional<CborWriteObjectScope>(mCborWriter, GetContext(), this);
+}
+
+
+/// <summary>
+/// CBOR root scope (can write value, array or object)
+/// </summary>
+class CborWriteRootScope final : public TArchiveScope<SerializeMode::Save>, public CborScopeBase
+{
+public:
+	CborWriteRootScope(std::string& outputData, SerializationContext& serializationContext);
+	CborWriteRootScope(std::vector<uint8_t>& outputData, SerializationContext& serializationContext);
+	CborWriteRootScope(std::ostream& outputStream, SerializationContext& serializationContext);
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		SaveValue(mCborWriter.get(), value);
+		return true;
+	}
+
+	template <typename TSym, typename TAllocator>
+	bool SerializeValue(std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		SaveValue(mCborWriter.get(), value);
+		return true;
+	}
+
+	bool SerializeValue(std::string_view& value)
+	{
+		mCborWriter->WriteString(value);
+		return true;
+	}
+
+	bool SerializeValue(CBinTimestamp& timestamp)
+	{
+		mCborWriter->WriteTimestamp(timestamp);
+		return true;
+	}
+
+	std::optional<CborWriteObjectScope> OpenObjectScope()
+	{
+		return std::make_optional<CborWriteObjectScope>(mCborWriter.get(), GetContext());
+	}
+
+	std::optional<CborWriteArrayScope> OpenArrayScope(size_t arraySize)
+	{
+		return std::make_optional<CborWriteArrayScope>(mCborWriter.get(), arraySize, GetContext());
+	}
+
+	void Finalize()
+	{
+		mCborWriter->Flush();
+	}
+
+private:
+	std::unique_ptr<ICborWriter> mCborWriter;
+};
+
+
+// Forward declarations
+class CborReadObjectScope;
+
+/// <summary>
+/// CBOR scope for reading arrays (list of values without keys).
+/// The size of indefinite-length arrays is counted in advance, so they can be loaded in the same way as definite ones.
+/// </summary>
+class CborReadArrayScope final : public TArchiveScope<SerializeMode::Load>, public CborScopeBase
+{
+public:
+	CborReadArrayScope(ICborReader* cborReader, size_t arraySize, bool isIndefinite, SerializationContext& serializationContext,
+		const CborScopeBase* parent = nullptr, std::string_view parentKey = {}) noexcept
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, CborScopeBase(parent, parentKey)
+		, mCborReader(cborReader)
+		, mSize(arraySize)
+		, mIsIndefinite(isIndefinite)
+	{ }
+
+	~CborReadArrayScope()
+	{
+		// Skip not loaded items, for continue reading from the end of array
+		for (; mIndex < mSize; ++mIndex) {
+			mCborReader->SkipValue();
+		}
+		if (mIsIndefinite) {
+			mCborReader->SkipBreak();
+		}
+	}
+
+	/// <summary>
+	/// Gets the current path in CBOR (in the same format as JSON Pointer).
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const override
+	{
+		return CborScopeBase::GetPath() + path_separator + Convert::ToString(mIndex);
+	}
+
+	/// <summary>
+	/// Returns the exact number of items to load (for reserving the size of containers).
+	/// </summary>
+	[[nodiscard]] size_t GetEstimatedSize() const noexcept
+	{
+		return mSize;
+	}
+
+	/// <summary>
+	/// Returns `true` when all no more values to load.
+	/// </summary>
+	[[nodiscard]] bool IsEnd() const noexcept
+	{
+		return mIndex == mSize;
+	}
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		NextItem();
+		return LoadValue(mCborReader, value);
+	}
+
+	template <typename TSym, typename TAllocator>
+	bool SerializeValue(std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		NextItem();
+		return LoadValue(mCborReader, value);
+	}
+
+	/// <summary>
+	/// Reads the value as view to the input data (valid until the archive is destroyed, but indefinite-length strings are valid only until the next read).
+	/// </summary>
+	bool SerializeValue(std::string_view& value)
+	{
+		NextItem();
+		return mCborReader->ReadValue(value);
+	}
+
+	bool SerializeValue(CBinTimestamp& timestamp)
+	{
+		NextItem();
+		return mCborReader->ReadValue(timestamp);
+	}
+
+	std::optional<CborReadObjectScope> OpenObjectScope();
+
+	std::optional<CborReadArrayScope> OpenArrayScope(size_t arraySize)
+	{
+		NextItem();
+		bool isIndefinite = false;
+		if (size_t actualSize; mCborReader->ReadArraySize(actualSize, isIndefinite)) {
+			return std::make_optional<CborReadArrayScope>(mCborReader, actualSize, isIndefinite, GetContext(), this);
+		}
+		return std::nullopt;
+	}
+
+private:
+	void NextItem()
+	{
+		if (mIndex == mSize) {
+			throw SerializationException(SerializationErrorCode::OutOfRange, "No more items to load");
+		}
+		++mIndex;
+	}
+
+	ICborReader* mCborReader;
+	size_t mSize;
+	bool mIsIndefinite;
+	size_t mIndex = 0;
+};
+
+
+/// <summary>
+/// CBOR scope for reading objects (list of values with keys).
+/// Values are searched starting from the last loaded one, so loading in the same order as they were saved does not require any lookups.
+/// </summary>
+class CborReadObjectScope final : public TArchiveScope<SerializeMode::Load>, public CborScopeBase
+{
+public:
+	CborReadObjectScope(ICborReader* cborReader, size_t mapSize, bool isIndefinite, SerializationContext& serializationContext,
+		const CborScopeBase* parent = nullptr, std::string_view parentKey = {}) noexcept
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, CborScopeBase(parent, parentKey)
+		, mCborReader(cborReader)
+		, mSize(mapSize)
+		, mIsIndefinite(isIndefinite)
+		, mStartPos(cborReader->GetPosition())
+		, mFurthestPos(mStartPos)
+	{ }
+
+	~CborReadObjectScope()
+	{
+		// Skip not loaded items, for continue reading from the end of map
+		UpdateFurthestPosition();
+		mCborReader->SetPosition(mFurthestPos);
+		for (size_t i = mFurthestIndex; i < mSize; ++i)
+		{
+			mCborReader->SkipValue();
+			mCborReader->SkipValue();
+		}
+		if (mIsIndefinite) {
+			mCborReader->SkipBreak();
+		}
+	}
+
+	/// <summary>
+	/// Constant iterator for keys.
+	/// </summary>
+	class key_const_iterator
+	{
+		friend class CborReadObjectScope;
+
+		ICborReader* mCborReader;
+		size_t mPos;
+		size_t mIndex;
+
+		key_const_iterator(ICborReader* cborReader, size_t pos, size_t index) noexcept
+			: mCborReader(cborReader), mPos(pos), mIndex(index) { }
+
+	public:
+		bool operator==(const key_const_iterator& rhs) const noexcept {
+			return mIndex == rhs.mIndex;
+		}
+		bool operator!=(const key_const_iterator& rhs) const noexcept {
+			return mIndex != rhs.mIndex;
+		}
+
+		key_const_iterator& operator++() noexcept
+		{
+			const size_t currentPos = mCborReader->GetPosition();
+			mCborReader->SetPosition(mPos);
+			mCborReader->SkipValue();
+			mCborReader->SkipValue();
+			mPos = mCborReader->GetPosition();
+			mCborReader->SetPosition(currentPos);
+			++mIndex;
+			return *this;
+		}
+
+		key_type operator*() const
+		{
+			const size_t currentPos = mCborReader->GetPosition();
+			mCborReader->SetPosition(mPos);
+			std::string_view key;
+			mCborReader->ReadKey(key);
+			mCborReader->SetPosition(currentPos);
+			return key_type(key);
+		}
+	};
+
+	/// <summary>
+	/// Get the begin constant iterator of keys.
+	/// </summary>
+	[[nodiscard]] key_const_iterator cbegin() const noexcept {
+		return { mCborReader, mStartPos, 0 };
+	}
+
+	/// <summary>
+	/// Get the end constant iterator of keys.
+	/// </summary>
+	[[nodiscard]] key_const_iterator cend() const noexcept {
+		return { mCborReader, 0, mSize };
+	}
+
+	/// <summary>
+	/// Returns the exact number of items to load (for reserving the size of containers).
+	/// </summary>
+	[[nodiscard]] size_t GetEstimatedSize() const noexcept
+	{
+		return mSize;
+	}
+
+	template <typename TKey, typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(TKey&& key, T& value)
+	{
+		return FindValue(key) && LoadValue(mCborReader, value);
+	}
+
+	template <typename TKey, typename TSym, typename TAllocator>
+	bool SerializeValue(TKey&& key, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		return FindValue(key) && LoadValue(mCborReader, value);
+	}
+
+	/// <summary>
+	/// Reads the value as view to the input data (valid until the archive is destroyed, but indefinite-length strings are valid only until the next read).
+	/// </summary>
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, std::string_view& value)
+	{
+		return FindValue(key) && mCborReader->ReadValue(value);
+	}
+
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, CBinTimestamp& timestamp)
+	{
+		return FindValue(key) && mCborReader->ReadValue(timestamp);
+	}
+
+	template <typename TKey>
+	std::optional<CborReadObjectScope> OpenObjectScope(TKey&& key)
+	{
+		const std::string_view keyView(key);
+		bool isIndefinite = false;
+		if (size_t mapSize; FindValue(keyView) && mCborReader->ReadMapSize(mapSize, isIndefinite)) {
+			return std::make_optional<CborReadObjectScope>(mCborReader, mapSize, isIndefinite, GetContext(), this, keyView);
+		}
+		return std::nullopt;
+	}
+
+	template <typename TKey>
+	std::optional<CborReadArrayScope> OpenArrayScope(TKey&& key, size_t arraySize)
+	{
+		const std::string_view keyView(key);
+		bool isIndefinite = false;
+		if (size_t actualSize; FindValue(keyView) && mCborReader->ReadArraySize(actualSize, isIndefinite)) {
+			return std::make_optional<CborReadArrayScope>(mCborReader, actualSize, isIndefinite, GetContext(), this, keyView);
+		}
+		return std::nullopt;
+	}
+
+private:
+	/// <summary>
+	/// Finds the value by key, starts searching from the current position of reader (must point to the key).
+	/// When the key is found, the reader will be positioned on the value.
+	/// </summary>
+	bool FindValue(std::string_view key)
+	{
+		for (size_t i = 0; i < mSize; ++i)
+		{
+			UpdateFurthestPosition();
+			if (mNextIndex == mSize)
+			{
+				mNextIndex = 0;
+				mCborReader->SetPosition(mStartPos);
+			}
+
+			++mNextIndex;
+			if (std::string_view currentKey; mCborReader->ReadKey(currentKey) && currentKey == key) {
+				return true;
+			}
+			mCborReader->SkipValue();
+		}
+		return false;
+	}
+
+	void UpdateFurthestPosition() noexcept
+	{
+		if (mNextIndex > mFurthestIndex)
+		{
+			mFurthestIndex = mNextIndex;
+			mFurthestPos = mCborReader->GetPosition();
+		}
+	}
+
+	ICborReader* mCborReader;
+	size_t mSize;
+	bool mIsIndefinite;
+	size_t mStartPos;
+	size_t mNextIndex = 0;
+	size_t mFurthestIndex = 0;
+	size_t mFurthestPos;
+};
+
+inline std::optional<CborReadObjectScope> CborReadArrayScope::OpenObjectScope()
+{
+	NextItem();
+	bool isIndefinite = false;
+	if (size_t mapSize; mCborReader->ReadMapSize(mapSize, isIndefinite)) {
+		return std::make_optional<CborReadObjectScope>(mCborReader, mapSize, isIndefinite, GetContext(), this);
+	}
+	return std::nullopt;
+}
+
+
+/// <summary>
+/// CBOR root scope (can read value, array or object)
+/// </summary>
+class CborReadRootScope final : public TArchiveScope<SerializeMode::Load>, public CborScopeBase
+{
+public:
+	CborReadRootScope(std::string_view inputData, SerializationContext& serializationContext);
+	CborReadRootScope(const std::vector<uint8_t>& inputData, SerializationContext& serializationContext);
+	CborReadRootScope(std::istream& inputStream, SerializationContext& serializationContext);
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		return LoadValue(mCborReader.get(), value);
+	}
+
+	template <typename TSym, typename TAllocator>
+	bool SerializeValue(std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		return LoadValue(mCborReader.get(), value);
+	}
+
+	/// <summary>
+	/// Reads the value as view to the input data (valid until the archive is destroyed, but indefinite-length strings are valid only until the next read).
+	/// </summary>
+	bool SerializeValue(std::string_view& value)
+	{
+		return mCborReader->ReadValue(value);
+	}
+
+	bool SerializeValue(CBinTimestamp& timestamp)
+	{
+		return mCborReader->ReadValue(timestamp);
+	}
+
+	std::optional<CborReadObjectScope> OpenObjectScope()
+	{
+		bool isIndefinite = false;
+		if (size_t mapSize; mCborReader->ReadMapSize(mapSize, isIndefinite)) {
+			return std::make_optional<CborReadObjectScope>(mCborReader.get(), mapSize, isIndefinite, GetContext());
+		}
+		return std::nullopt;
+	}
+
+	std::optional<CborReadArrayScope> OpenArrayScope(size_t arraySize)
+	{
+		bool isIndefinite = false;
+		if (size_t actualSize; mCborReader->ReadArraySize(actualSize, isIndefinite)) {
+			return std::make_optional<CborReadArrayScope>(mCborReader.get(), actualSize, isIndefinite, GetContext());
+		}
+		return std::nullopt;
+	}
+
+	void Finalize() const noexcept { /* Not required */ }
+
+private:
+	std::string mStreamData;
+	std::unique_ptr<ICborReader> mCborReader;
+};
+
+}
+
+
+/// <summary>
+/// CBOR archive (RFC 8949, internal implementation - no dependencies).
+/// Values are saved in the preferred (shortest) form with definite lengths, both definite and indefinite lengths are supported when loading.
+/// Supports load/save from:
+/// - <c>std::string</c>: binary data
+/// - <c>std::vector&lt;uint8_t&gt;</c>: binary data
+/// - <c>std::istream</c> and <c>std::ostream</c>: binary data
+/// </summary>
+using CborArchive = TArchiveBase<
+	Detail::CborArchiveTraits,
+	Detail::CborReadRootScope,
+	Detail::CborWriteRootScope>;
+
+}
@@ -0,0 +1,433 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "bitserializer/serialization_detail/archive_base.h"
+#include "bitserializer/serialization_detail/errors_handling.h"
+
+
+namespace BitSerializer::Columnar {
+namespace Detail {
+
+/// <summary>
+/// The traits of Columnar archive (internal implementation - no dependencies)
+/// </summary>
+struct ColumnarArchiveTraits
+{
+	static constexpr ArchiveType archive_type = ArchiveType::Columnar;
+	using key_type = std::string;
+	using supported_key_types = TSupportedKeyTypes<const char*, std::string_view, key_type>;
+	using preferred_output_format = std::basic_string<char, std::char_traits<char>>;
+	using preferred_stream_char_type = char;
+	static constexpr char path_separator = '/';
+
+protected:
+	~ColumnarArchiveTraits() = default;
+};
+
+class IColumnarWriter
+{
+public:
+	virtual ~IColumnarWriter() = default;
+
+	virtual void SetEstimatedSize(size_t size) = 0;
+	virtual void WriteNull(std::string_view key) = 0;
+	virtual void WriteBoolean(std::string_view key, bool value) = 0;
+	virtual void WriteSignedInteger(std::string_view key, int64_t value) = 0;
+	virtual void WriteUnsignedInteger(std::string_view key, uint64_t value) = 0;
+	virtual void WriteFloat(std::string_view key, float value) = 0;
+	virtual void WriteDouble(std::string_view key, double value) = 0;
+	virtual void WriteString(std::string_view key, std::string_view value) = 0;
+	/// <summary>
+	/// Finishes the current row (does not throw as it is called from the destructor of scope, the number of values is checked in next calls).
+	/// </summary>
+	virtual void NextRow() noexcept = 0;
+	[[nodiscard]] virtual size_t GetCurrentIndex() const noexcept = 0;
+	virtual void Flush() = 0;
+};
+
+class IColumnarReader
+{
+public:
+	virtual ~IColumnarReader() = default;
+
+	[[nodiscard]] virtual size_t GetCurrentIndex() const noexcept = 0;
+	[[nodiscard]] virtual size_t GetRowsCount() const noexcept = 0;
+	[[nodiscard]] virtual size_t GetColumnsCount() const noexcept = 0;
+	[[nodiscard]] virtual bool IsEnd() const noexcept = 0;
+	virtual bool NextRow() noexcept = 0;
+	virtual bool ReadValue(std::string_view key, std::nullptr_t& value) = 0;
+	virtual bool ReadValue(std::string_view key, bool& value) = 0;
+	virtual bool ReadValue(std::string_view key, uint8_t& value) = 0;
+	virtual bool ReadValue(std::string_view key, uint16_t& value) = 0;
+	virtual bool ReadValue(std::string_view key, uint32_t& value) = 0;
+	virtual bool ReadValue(std::string_view key, uint64_t& value) = 0;
+	virtual bool ReadValue(std::string_view key, int8_t& value) = 0;
+	virtual bool ReadValue(std::string_view key, int16_t& value) = 0;
+	virtual bool ReadValue(std::string_view key, int32_t& value) = 0;
+	virtual bool ReadValue(std::string_view key, int64_t& value) = 0;
+	virtual bool ReadValue(std::string_view key, float& value) = 0;
+	virtual bool ReadValue(std::string_view key, double& value) = 0;
+	virtual bool ReadValue(std::string_view key, std::string_view& value) = 0;
+};
+
+
+/// <summary>
+/// Base class of Columnar scope
+/// </summary>
+class ColumnarScopeBase : public ColumnarArchiveTraits
+{
+protected:
+	~ColumnarScopeBase() = default;
+
+	/// <summary>
+	/// Number type with fixed width which is used for loading value with type `T`.
+	/// </summary>
+	template <typename T>
+	using fixed_number_t = std::conditional_t<std::is_floating_point_v<T>,
+		std::conditional_t<std::is_same_v<T, float>, float, double>,
+		std::conditional_t<std::is_signed_v<T>,
+			std::conditional_t<sizeof(T) == 1, int8_t, std::conditional_t<sizeof(T) == 2, int16_t, std::conditional_t<sizeof(T) == 4, int32_t, int64_t>>>,
+			std::conditional_t<sizeof(T) == 1, uint8_t, std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>>>;
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	static bool LoadValue(IColumnarReader* columnarReader, std::string_view key, T& value)
+	{
+		if constexpr (std::is_same_v<T, bool> || std::is_null_pointer_v<T>)
+		{
+			return columnarReader->ReadValue(key, value);
+		}
+		else
+		{
+			fixed_number_t<T> fixedValue;
+			if (columnarReader->ReadValue(key, fixedValue))
+			{
+				value = static_cast<T>(fixedValue);
+				return true;
+			}
+			return false;
+		}
+	}
+
+	template <typename TSym, typename TAllocator>
+	static bool LoadValue(IColumnarReader* columnarReader, std::string_view key, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		if (std::string_view strValue; columnarReader->ReadValue(key, strValue))
+		{
+			if constexpr (std::is_same_v<TSym, char>) {
+				value.assign(strValue.data(), strValue.size());
+			}
+			else {
+				value = Convert::To<std::basic_string<TSym, std::char_traits<TSym>, TAllocator>>(strValue);
+			}
+			return true;
+		}
+		return false;
+	}
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	static void SaveValue(IColumnarWriter* columnarWriter, std::string_view key, const T& value)
+	{
+		if constexpr (std::is_null_pointer_v<T>) {
+			columnarWriter->WriteNull(key);
+		}
+		else if constexpr (std::is_same_v<T, bool>) {
+			columnarWriter->WriteBoolean(key, value);
+		}
+		else if constexpr (std::is_same_v<T, float>) {
+			columnarWriter->WriteFloat(key, value);
+		}
+		else if constexpr (std::is_floating_point_v<T>) {
+			columnarWriter->WriteDouble(key, static_cast<double>(value));
+		}
+		else if constexpr (std::is_signed_v<T>) {
+			columnarWriter->WriteSignedInteger(key, static_cast<int64_t>(value));
+		}
+		else {
+			columnarWriter->WriteUnsignedInteger(key, static_cast<uint64_t>(value));
+		}
+	}
+
+	template <typename TSym, typename TAllocator>
+	static void SaveValue(IColumnarWriter* columnarWriter, std::string_view key, const std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		if constexpr (std::is_same_v<TSym, char>) {
+			columnarWriter->WriteString(key, std::string_view(value.data(), value.size()));
+		}
+		else {
+			columnarWriter->WriteString(key, Convert::ToString(value));
+		}
+	}
+};
+
+
+/// <summary>
+/// Columnar scope for writing objects (values are appended to the columns with the same keys).
+/// </summary>
+class ColumnarWriteObjectScope final : public TArchiveScope<SerializeMode::Save>, public ColumnarScopeBase
+{
+public:
+	ColumnarWriteObjectScope(IColumnarWriter* columnarWriter, SerializationContext& serializationContext) noexcept
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mColumnarWriter(columnarWriter)
+	{ }
+
+	~ColumnarWriteObjectScope()
+	{
+		mColumnarWriter->NextRow();
+	}
+
+	/// <summary>
+	/// Gets the current path in Columnar archive.
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const
+	{
+		return path_separator + Convert::ToString(mColumnarWriter->GetCurrentIndex());
+	}
+
+	template <typename TKey, typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(TKey&& key, T& value)
+	{
+		SaveValue(mColumnarWriter, std::forward<TKey>(key), value);
+		return true;
+	}
+
+	template <typename TKey, typename TSym, typename TAllocator>
+	bool SerializeValue(TKey&& key, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		SaveValue(mColumnarWriter, std::forward<TKey>(key), value);
+		return true;
+	}
+
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, std::string_view& value)
+	{
+		mColumnarWriter->WriteString(std::forward<TKey>(key), value);
+		return true;
+	}
+
+private:
+	IColumnarWriter* mColumnarWriter;
+};
+
+/// <summary>
+/// Columnar scope for writing arrays (list of objects, each of them is a row).
+/// </summary>
+class ColumnarWriteArrayScope final : public TArchiveScope<SerializeMode::Save>, public ColumnarScopeBase
+{
+public:
+	ColumnarWriteArrayScope(IColumnarWriter* columnarWriter, SerializationContext& serializationContext) noexcept
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mColumnarWriter(columnarWriter)
+	{ }
+
+	/// <summary>
+	/// Gets the current path in Columnar archive.
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const
+	{
+		return path_separator + Convert::ToString(mColumnarWriter->GetCurrentIndex());
+	}
+
+	[[nodiscard]] std::optional<ColumnarWriteObjectScope> OpenObjectScope() const
+	{
+		return std::make_optional<ColumnarWriteObjectScope>(mColumnarWriter, GetContext());
+	}
+
+private:
+	IColumnarWriter* mColumnarWriter;
+};
+
+
+/// <summary>
+/// Columnar root scope (can write only array of flat objects)
+/// </summary>
+class ColumnarWriteRootScope final : public TArchiveScope<SerializeMode::Save>, public ColumnarScopeBase
+{
+public:
+	ColumnarWriteRootScope(std::string& outputData, SerializationContext& serializationContext);
+	ColumnarWriteRootScope(std::vector<uint8_t>& outputData, SerializationContext& serializationContext);
+	ColumnarWriteRootScope(std::ostream& outputStream, SerializationContext& serializationContext);
+
+	/// <summary>
+	/// Gets the current path in Columnar archive.
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const noexcept
+	{
+		return "";
+	}
+
+	[[nodiscard]] std::optional<ColumnarWriteArrayScope> OpenArrayScope(size_t arraySize) const
+	{
+		mColumnarWriter->SetEstimatedSize(arraySize);
+		return std::make_optional<ColumnarWriteArrayScope>(mColumnarWriter.get(), GetContext());
+	}
+
+	void Finalize()
+	{
+		mColumnarWriter->Flush();
+	}
+
+private:
+	std::unique_ptr<IColumnarWriter> mColumnarWriter;
+};
+
+
+/// <summary>
+/// Columnar scope for reading objects (values are taken from the columns with the same keys).
+/// </summary>
+class ColumnarReadObjectScope final : public TArchiveScope<SerializeMode::Load>, public ColumnarScopeBase
+{
+public:
+	ColumnarReadObjectScope(IColumnarReader* columnarReader, SerializationContext& serializationContext) noexcept
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mColumnarReader(columnarReader)
+	{ }
+
+	/// <summary>
+	/// Gets the current path in Columnar archive.
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const
+	{
+		return path_separator + Convert::ToString(mColumnarReader->GetCurrentIndex());
+	}
+
+	/// <summary>
+	/// Returns the estimated number of items to load (for reserving the size of containers).
+	/// </summary>
+	[[nodiscard]] size_t GetEstimatedSize() const noexcept
+	{
+		return mColumnarReader->GetColumnsCount();
+	}
+
+	template <typename TKey, typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(TKey&& key, T& value)
+	{
+		return LoadValue(mColumnarReader, std::forward<TKey>(key), value);
+	}
+
+	template <typename TKey, typename TSym, typename TAllocator>
+	bool SerializeValue(TKey&& key, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		return LoadValue(mColumnarReader, std::forward<TKey>(key), value);
+	}
+
+	/// <summary>
+	/// Reads the value as view to the input data (valid until the end of loading).
+	/// </summary>
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, std::string_view& value)
+	{
+		return mColumnarReader->ReadValue(std::forward<TKey>(key), value);
+	}
+
+private:
+	IColumnarReader* mColumnarReader;
+};
+
+
+/// <summary>
+/// Columnar scope for reading arrays (list of objects, each of them is a row).
+/// </summary>
+class ColumnarReadArrayScope final : public TArchiveScope<SerializeMode::Load>, public ColumnarScopeBase
+{
+public:
+	ColumnarReadArrayScope(IColumnarReader* columnarReader, SerializationContext& serializationContext) noexcept
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mColumnarReader(columnarReader)
+	{ }
+
+	/// <summary>
+	/// Gets the current path in Columnar archive.
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const
+	{
+		return path_separator + Convert::ToString(mColumnarReader->GetCurrentIndex());
+	}
+
+	/// <summary>
+	/// Returns the estimated number of items to load (for reserving the size of containers).
+	/// </summary>
+	[[nodiscard]] size_t GetEstimatedSize() const noexcept
+	{
+		return mColumnarReader->GetRowsCount();
+	}
+
+	/// <summary>
+	/// Returns `true` when all no more values to load.
+	/// </summary>
+	[[nodiscard]] bool IsEnd() const noexcept
+	{
+		return mColumnarReader->IsEnd();
+	}
+
+	std::optional<ColumnarReadObjectScope> OpenObjectScope()
+	{
+		if (mColumnarReader->NextRow())
+		{
+			return std::make_optional<ColumnarReadObjectScope>(mColumnarReader, GetContext());
+		}
+		return std::nullopt;
+	}
+
+private:
+	IColumnarReader* mColumnarReader;
+};
+
+
+/// <summary>
+/// Columnar root scope (can read only array of flat objects)
+/// </summary>
+class ColumnarReadRootScope final : public TArchiveScope<SerializeMode::Load>, public ColumnarScopeBase
+{
+public:
+	ColumnarReadRootScope(std::string_view inputData, SerializationContext& serializationContext);
+	ColumnarReadRootScope(const std::vector<uint8_t>& inputData, SerializationContext& serializationContext);
+	ColumnarReadRootScope(std::istream& inputStream, SerializationContext& serializationContext);
+
+	/// <summary>
+	/// Gets the current path in Columnar archive.
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const noexcept
+	{
+		return "";
+	}
+
+	std::optional<ColumnarReadArrayScope> OpenArrayScope(size_t)
+	{
+		return std::make_optional<ColumnarReadArrayScope>(mColumnarReader.get(), GetContext());
+	}
+
+	void Finalize() const noexcept { /* Not required */ }
+
+private:
+	std::string mStreamData;
+	std::unique_ptr<IColumnarReader> mColumnarReader;
+};
+
+}
+
+
+/// <summary>
+/// Columnar binary archive (internal implementation - no dependencies).
+/// The root must be an array of flat objects, which is transposed into per-field column blocks:
+/// integers are bit-packed (with delta encoding when it is more compact) and strings are dictionary encoded
+/// when they have many repeated values.
+/// Supports load/save from:
+/// - <c>std::string</c>
+/// - <c>std::vector&lt;uint8_t&gt;</c>
+/// - <c>std::istream</c> and <c>std::ostream</c>
+/// </summary>
+using ColumnarArchive = TArchiveBase<
+	Detail::ColumnarArchiveTraits,
+	Detail::ColumnarReadRootScope,
+	Detail::ColumnarWriteRootScope>;
+
+}
@@ -9,6 +9,9 @@
 #include <climits>
 #include <chrono>
 #include <charconv>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
 #include "convert_utf.h"
 
 
@@ -34,30 +37,32 @@ namespace BitSerializer
 
 namespace BitSerializer::Convert::Detail
 {
-	constexpr size_t UtcBufSize = 32;
+	constexpr size_t UtcBufSize = 40;
 	static constexpr int DaysInMonth[12] = { 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
 
 	struct tm_ext : tm
 	{
 		tm_ext() : tm() { }
-		tm_ext(tm inTm, int inMs) : tm(inTm), ms(inMs) { }
+		tm_ext(tm inTm, int inNs) : tm(inTm), ns(inNs) { }
 
-		int ms = 0;
+		int ns = 0;		// Fractions of second in nanoseconds [0, 999999999]
+	};
+
+	struct civil_date
+	{
+		int year;
+		int month;		// [1, 12]
+		int day;		// [1, 31]
 	};
 
 	/// <summary>
-	/// Converts Unix time to UTC expressed in the `tm` structure.
+	/// Converts number of days since Unix EPOCH to the civil date.
 	/// </summary>
-	static tm UnixTimeToUtc(time_t dateTime) noexcept
+	inline civil_date DaysToCivil(int64_t days) noexcept
 	{
 		// Based on Howard Hinnant's algorithm
 		static_assert(sizeof(int) >= 4, "This algorithm has not been ported to a 16 bit integers");
-
-		auto days = dateTime / 86400;
-		const auto time = static_cast<int>(dateTime - days * 86400);
-		if (time < 0) --days;
-
-		auto const z = days + 719468;
+		auto const z = days + 719468ll;
 		auto const era = (z >= 0 ? z : z - 146096) / 146097;
 		auto const doe = static_cast<unsigned>(z - era * 146097);				// [0, 146096]
 		auto const yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;	// [0, 399]
@@ -66,50 +71,257 @@ namespace BitSerializer::Convert::Detail
 		auto const mp = (5 * doy + 2) / 153;									// [0, 11]
 		auto const d = doy - (153 * mp + 2) / 5 + 1;							// [1, 31]
 		auto const m = mp < 10 ? mp + 3 : mp - 9;								// [1, 12]
+		return { static_cast<int>(y) + (m <= 2), static_cast<int>(m), static_cast<int>(d) };
+	}
+
+	/// <summary>
+	/// Converts the civil date to number of days since Unix EPOCH.
+	/// </summary>
+	inline int64_t CivilToDays(int year, int month, int day) noexcept
+	{
+		// Based on Howard Hinnant's algorithm
+		static_assert(sizeof(int) >= 4, "This algorithm has not been ported to a 16 bit integers");
+		auto const y = year - (month <= 2);
+		auto const m = static_cast<unsigned>(month);
+		auto const d = static_cast<unsigned>(day);
+		auto const era = (y >= 0 ? y : y - 399) / 400;
+		auto const yoe = static_cast<unsigned>(y - era * 400);				// [0, 399]
+		auto const doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;	// [0, 365]
+		auto const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;				// [0, 146096]
+		return era * 146097ll + (static_cast<int64_t>(doe) - 719468);
+	}
+
+	/// <summary>
+	/// The same as `DaysToCivil()`, but reuses the result of previous call when timestamps belong to the same day (typical for logs and tables).
+	/// </summary>
+	inline civil_date DaysToCivilCached(int64_t days) noexcept
+	{
+		thread_local int64_t lastDays = 0;
+		thread_local civil_date lastDate = { 1970, 1, 1 };
+		if (days != lastDays)
+		{
+			lastDate = DaysToCivil(days);
+			lastDays = days;
+		}
+		return lastDate;
+	}
+
+	/// <summary>
+	/// The same as `CivilToDays()`, but reuses the result of previous call when timestamps belong to the same day (typical for logs and tables).
+	/// </summary>
+	inline int64_t CivilToDaysCached(int year, int month, int day) noexcept
+	{
+		thread_local civil_date lastDate = { 1970, 1, 1 };
+		thread_local int64_t lastDays = 0;
+		if (day != lastDate.day || month != lastDate.month || year != lastDate.year)
+		{
+			lastDays = CivilToDays(year, month, day);
+			lastDate = { year, month, day };
+		}
+		return lastDays;
+	}
+
+	/// <summary>
+	/// Converts Unix time to UTC expressed in the `tm` structure.
+	/// </summary>
+	static tm UnixTimeToUtc(time_t dateTime) noexcept
+	{
+		auto days = dateTime / 86400;
+		auto time = static_cast<int>(dateTime - days * 86400);
+		if (time < 0)
+		{
+			--days;
+			time += 86400;
+		}
 
+		const civil_date date = DaysToCivilCached(days);
 		tm utc{};
-		utc.tm_year = static_cast<int>(y) + (m <= 2);
-		utc.tm_mon = static_cast<int>(m);
-		utc.tm_mday = static_cast<int>(d);
+		utc.tm_year = date.year;
+		utc.tm_mon = date.month;
+		utc.tm_mday = date.day;
 		utc.tm_hour = time / 3600;
 		utc.tm_min = time % 3600 / 60;
 		utc.tm_sec = time % 60;
-		// Adjust time before EPOCH
-		if (time < 0)
+		return utc;
+	}
+
+	/// <summary>
+	/// Converts UTC expressed in the `tm` structure to Unix time.
+	/// </summary>
+	static time_t UtcToUnixTime(const tm& utc) noexcept
+	{
+		const auto days = CivilToDaysCached(utc.tm_year, utc.tm_mon, utc.tm_mday);
+		const auto time = static_cast<long long>(utc.tm_hour) * 3600 + static_cast<long long>(utc.tm_min) * 60 + utc.tm_sec;
+		return static_cast<time_t>(days * 86400 + time);
+	}
+
+	/// <summary>
+	/// Writes number with leading zeros to the buffer (the value must fit into the specified number of digits).
+	/// </summary>
+	inline char* WriteFixedDigits(char* pos, unsigned value, size_t digits) noexcept
+	{
+		for (char* it = pos + digits; it != pos; value /= 10) {
+			*--it = static_cast<char>('0' + value % 10);
+		}
+		return pos + digits;
+	}
+
+	/// <summary>
+	/// Parses fixed number of digits, returns -1 when there is any other character.
+	/// </summary>
+	inline int ParseFixedDigits(const char* pos, size_t digits) noexcept
+	{
+		int value = 0;
+		for (const char* end = pos + digits; pos != end; ++pos)
 		{
-			if (utc.tm_sec < 0) utc.tm_sec += 60;
-			utc.tm_min += utc.tm_sec == 0 ? 60 : 59;
-			if (utc.tm_min == 60)
-			{
-				utc.tm_min = 0;
-				utc.tm_hour += 24;
+			const unsigned digit = static_cast<unsigned char>(*pos) - static_cast<unsigned>('0');
+			if (digit > 9) {
+				return -1;
+			}
+			value = value * 10 + static_cast<int>(digit);
+		}
+		return value;
+	}
+
+	/// <summary>
+	/// Writes UTC to the buffer in ISO 8601 format: [+/-]YYYY-MM-DDThh:mm:ss[.SSS[SSS[SSS]]]Z.
+	/// The buffer must have size at least `UtcBufSize`.
+	/// </summary>
+	inline char* WriteIsoDateTime(char* pos, const tm& in, int ns, bool withFraction) noexcept
+	{
+		// Years out of range [0, 9999] are written with sign (expanded representation)
+		if (in.tm_year >= 0 && in.tm_year < 10000) {
+			pos = WriteFixedDigits(pos, static_cast<unsigned>(in.tm_year), 4);
+		}
+		else
+		{
+			const auto absYear = in.tm_year < 0 ? 0u - static_cast<unsigned>(in.tm_year) : static_cast<unsigned>(in.tm_year);
+			*pos++ = in.tm_year < 0 ? '-' : '+';
+			pos = absYear < 10000 ? WriteFixedDigits(pos, absYear, 4) : std::to_chars(pos, pos + 10, absYear).ptr;
+		}
+		*pos++ = '-';
+		pos = WriteFixedDigits(pos, static_cast<unsigned>(in.tm_mon), 2);
+		*pos++ = '-';
+		pos = WriteFixedDigits(pos, static_cast<unsigned>(in.tm_mday), 2);
+		*pos++ = 'T';
+		pos = WriteFixedDigits(pos, static_cast<unsigned>(in.tm_hour), 2);
+		*pos++ = ':';
+		pos = WriteFixedDigits(pos, static_cast<unsigned>(in.tm_min), 2);
+		*pos++ = ':';
+		pos = WriteFixedDigits(pos, static_cast<unsigned>(in.tm_sec), 2);
+		if (withFraction)
+		{
+			// Render the minimal group of digits which represents the fraction without loss (ms, us or ns)
+			*pos++ = '.';
+			if (ns % 1000000 == 0) {
+				pos = WriteFixedDigits(pos, static_cast<unsigned>(ns / 1000000), 3);
+			}
+			else if (ns % 1000 == 0) {
+				pos = WriteFixedDigits(pos, static_cast<unsigned>(ns / 1000), 6);
 			}
 			else {
-				utc.tm_hour += 23;
+				pos = WriteFixedDigits(pos, static_cast<unsigned>(ns), 9);
 			}
 		}
-		return utc;
+		*pos++ = 'Z';
+		return pos;
 	}
 
 	/// <summary>
-	/// Converts UTC expressed in the `tm` structure to Unix time.
+	/// Parses ISO 8601/UTC datetime (YYYY-MM-DDThh:mm:ss[.fffffffff]Z) to `tm_ext` structure.
 	/// </summary>
-	static time_t UtcToUnixTime(const tm& utc) noexcept
+	inline tm_ext ParseIsoDateTime(const char* pos, const char* end)
 	{
-		// Based on Howard Hinnant's algorithm
-		static_assert(sizeof(int) >= 4, "This algorithm has not been ported to a 16 bit integers");
+		static constexpr char invalidDatetimeMsg[] = "Input string is not a valid ISO datetime: YYYY-MM-DDThh:mm:ss[.SSS]Z";
 
-		auto const y = static_cast<int>(utc.tm_year) - (utc.tm_mon <= 2);
-		auto const m = static_cast<unsigned>(utc.tm_mon);
-		auto const d = static_cast<unsigned>(utc.tm_mday);
-		auto const era = (y >= 0 ? y : y - 399) / 400;
-		auto const yoe = static_cast<unsigned>(y - era * 400);				// [0, 399]
-		auto const doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;	// [0, 365]
-		auto const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;				// [0, 146096]
+		tm_ext utc{};
+		// Fast path for the most common fixed-width form (4-digits year)
+		if (constexpr size_t fixedSize = 19; end - pos >= static_cast<ptrdiff_t>(fixedSize) && pos[4] == '-' && pos[7] == '-' && pos[10] == 'T' && pos[13] == ':' && pos[16] == ':'
+			&& (utc.tm_year = ParseFixedDigits(pos, 4)) >= 0
+			&& (utc.tm_mon = ParseFixedDigits(pos + 5, 2)) >= 0
+			&& (utc.tm_mday = ParseFixedDigits(pos + 8, 2)) >= 0
+			&& (utc.tm_hour = ParseFixedDigits(pos + 11, 2)) >= 0
+			&& (utc.tm_min = ParseFixedDigits(pos + 14, 2)) >= 0
+			&& (utc.tm_sec = ParseFixedDigits(pos + 17, 2)) >= 0)
+		{
+			if (utc.tm_mon < 1 || utc.tm_mon > 12 || utc.tm_mday < 1 || utc.tm_mday > DaysInMonth[utc.tm_mon - 1]
+				|| utc.tm_hour > 23 || utc.tm_min > 59 || utc.tm_sec > 59)
+			{
+				throw std::invalid_argument("Input datetime contains out-of-bounds values");
+			}
+			pos += fixedSize;
+		}
+		else
+		{
+			auto parseDatetimePart = [](const char* buf, const char* end, int& outValue, int minValue, int maxValue, char delimiter = 0, bool isYear = false) -> const char*
+			{
+				if (buf != end && (std::isdigit(*buf) || isYear))
+				{
+					if (isYear && *buf == '+') {
+						++buf;
+					}
+					const std::from_chars_result result = std::from_chars(buf, end, outValue);
+					if (result.ec == std::errc())
+					{
+						if (maxValue && (outValue < minValue || outValue > maxValue)) {
+							throw std::invalid_argument("Input datetime contains out-of-bounds values");
+						}
+						if (delimiter)
+						{
+							if (result.ptr != end && *result.ptr == delimiter) {
+								return result.ptr + 1;
+							}
+						}
+						else {
+							return result.ptr;
+						}
+					}
+					if (result.ec == std::errc::result_out_of_range) {
+						throw std::out_of_range("ISO datetime contains too big number");
+					}
+				}
+				throw std::invalid_argument(invalidDatetimeMsg);
+			};
 
-		const auto days = era * 146097 + static_cast<int>(doe) - 719468;
-		const auto time = static_cast<long long>(utc.tm_hour) * 3600 + static_cast<long long>(utc.tm_min) * 60 + utc.tm_sec;
-		return static_cast<long long>(days) * 86400 + time;
+			utc = tm_ext();
+			pos = parseDatetimePart(pos, end, utc.tm_year, 0, 0, '-', true);
+			pos = parseDatetimePart(pos, end, utc.tm_mon, 1, 12, '-');
+			pos = parseDatetimePart(pos, end, utc.tm_mday, 1, DaysInMonth[utc.tm_mon - 1], 'T');
+			pos = parseDatetimePart(pos, end, utc.tm_hour, 0, 23, ':');
+			pos = parseDatetimePart(pos, end, utc.tm_min, 0, 59, ':');
+			pos = parseDatetimePart(pos, end, utc.tm_sec, 0, 59);
+		}
+
+		// Parse optional fractions of second (up to nanoseconds)
+		if (pos != end && *pos == '.')
+		{
+			static constexpr int scales[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+			constexpr size_t maxDigits = 9;
+
+			const auto frPos = ++pos;
+			int value = 0;
+			for (; pos != end && pos - frPos < static_cast<ptrdiff_t>(maxDigits); ++pos)
+			{
+				const unsigned digit = static_cast<unsigned char>(*pos) - static_cast<unsigned>('0');
+				if (digit > 9) {
+					break;
+				}
+				value = value * 10 + static_cast<int>(digit);
+			}
+			if (pos != end && static_cast<unsigned>(static_cast<unsigned char>(*pos) - static_cast<unsigned>('0')) <= 9) {
+				throw std::invalid_argument("ISO datetime contains more than 9 digits in the fractions of second");
+			}
+			const auto digits = static_cast<size_t>(pos - frPos);
+			if (digits == 0) {
+				throw std::invalid_argument(invalidDatetimeMsg);
+			}
+			// Accordingly to ISO: 0.500 and 0.5 = 500ms
+			utc.ns = value * scales[maxDigits - digits];
+		}
+		if (pos == end || *pos != 'Z') {
+			throw std::invalid_argument(invalidDatetimeMsg);
+		}
+		return utc;
 	}
 
 	/// <summary>
@@ -210,115 +422,44 @@ namespace BitSerializer::Convert::Detail
 	void To(const tm& in, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& out)
 	{
 		char buffer[UtcBufSize];
-		const size_t outSize = snprintf(buffer, UtcBufSize, "%04d-%02d-%02dT%02d:%02d:%02dZ", in.tm_year, in.tm_mon, in.tm_mday, in.tm_hour, in.tm_min, in.tm_sec);
-		if (outSize <= 0) {
-			throw std::runtime_error("Unknown error");
-		}
-		if (in.tm_year >= 10000) {
-			out.push_back('+');
-		}
-		out.append(buffer, buffer + outSize);
+		char* endPos = WriteIsoDateTime(buffer, in, 0, false);
+		out.append(buffer, endPos);
 	}
 
 	/// <summary>
-	/// Converts UTC expressed in the `tm_ext` structure (includes ms) to `std::string` (ISO 8601/UTC).
+	/// Converts UTC expressed in the `tm_ext` structure (includes fractions of second) to `std::string` (ISO 8601/UTC).
+	///	Fractions of second are rendered with 3, 6 or 9 digits, depending on precision of value.
 	/// </summary>
 	template <typename TSym, typename TAllocator>
 	void To(const tm_ext& in, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& out)
 	{
 		char buffer[UtcBufSize];
-		const size_t outSize = snprintf(buffer, UtcBufSize, "%04d-%02d-%02dT%02d:%02d:%02d.%03dZ",
-			in.tm_year, in.tm_mon, in.tm_mday, in.tm_hour, in.tm_min, in.tm_sec, in.ms);
-		if (outSize <= 0) {
-			throw std::runtime_error("Unknown error");
-		}
-		if (in.tm_year >= 10000) {
-			out.push_back('+');
-		}
-		out.append(buffer, buffer + outSize);
+		char* endPos = WriteIsoDateTime(buffer, in, in.ns, true);
+		out.append(buffer, endPos);
 	}
 
 	/// <summary>
-	/// Converts from `std::string_view` (ISO 8601/UTC format: YYYY-MM-DDThh:mm:ss[.SSS]Z)) to `tm_ext` structure (includes ms).
-	///	Fractions of second are optional, only 3 digits are allowed.
+	/// Converts from `std::string_view` (ISO 8601/UTC format: YYYY-MM-DDThh:mm:ss[.SSS]Z)) to `tm_ext` structure (includes fractions of second).
+	///	Fractions of second are optional, allowed up to 9 digits (nanoseconds).
 	/// </summary>
 	template <typename TSym>
 	static void To(std::basic_string_view<TSym> in, tm_ext& out)
 	{
-		auto parseDatetime = [](const char* pos, const char* end)
-		{
-			auto parseDatetimePart = [](const char* buf, const char* end, int& outValue, int maxValue = 0, char delimiter = 0, bool isYear = false) -> const char*
-			{
-				if (buf != end && (std::isdigit(*buf) || isYear))
-				{
-					if (isYear && *buf == '+') {
-						++buf;
-					}
-					const std::from_chars_result result = std::from_chars(buf, end, outValue);
-					if (result.ec == std::errc())
-					{
-						if (maxValue && outValue > maxValue) {
-							throw std::invalid_argument("Input datetime contains out-of-bounds values");
-						}
-						if (delimiter)
-						{
-							if (result.ptr != end && *result.ptr == delimiter) {
-								return result.ptr + 1;
-							}
-						}
-						else {
-							return result.ptr;
-						}
-					}
-					if (result.ec == std::errc::result_out_of_range) {
-						throw std::out_of_range("ISO datetime contains too big number");
-					}
-				}
-				throw std::invalid_argument("Input string is not a valid ISO datetime: YYYY-MM-DDThh:mm:ss[.SSS]Z");
-			};
-
-			tm_ext utc{};
-			pos = parseDatetimePart(pos, end, utc.tm_year, 0, '-', true);
-			pos = parseDatetimePart(pos, end, utc.tm_mon, 12, '-');
-			pos = parseDatetimePart(pos, end, utc.tm_mday, DaysInMonth[utc.tm_mon - 1], 'T');
-			pos = parseDatetimePart(pos, end, utc.tm_hour, 23, ':');
-			pos = parseDatetimePart(pos, end, utc.tm_min, 59, ':');
-			pos = parseDatetimePart(pos, end, utc.tm_sec, 59);
-			// Parse optional fractions of second
-			if (const auto sym = *pos; sym == '.')
-			{
-				int value = 0;
-				const auto frPos = ++pos;
-				pos = parseDatetimePart(frPos, end, value, 999, 'Z');
-				const auto digits = pos - frPos - 1;
-				// Accordingly to ISO: 0.500 and 0.5 = 500ms
-				if (digits == 3) {
-					utc.ms = value;
-				}
-				else if (digits == 2 && value < 100) {
-					utc.ms = value * 10;
-				}
-				else if (digits == 1 && value < 10) {
-					utc.ms = value * 100;
-				}
-				else {
-					throw std::invalid_argument("ISO datetime contains more than 3 digits in the fractions of second");
-				}
-			}
-			else if (sym != 'Z') {
-				throw std::invalid_argument("Input string is not a valid ISO datetime: YYYY-MM-DDThh:mm:ss[.SSS]Z");
-			}
-			return utc;
-		};
-
 		if constexpr (sizeof(TSym) == sizeof(char)) {
-			out = parseDatetime(in.data(), in.data() + in.size());
+			out = ParseIsoDateTime(in.data(), in.data() + in.size());
 		}
 		else
 		{
-			std::string utf8Str;
-			Utf8::Encode(in.cbegin(), in.cend(), utf8Str);
-			out = parseDatetime(utf8Str.data(), utf8Str.data() + utf8Str.size());
+			// Valid datetime consists only of ASCII characters, so it can be narrowed without transcoding
+			char buffer[UtcBufSize * 2];
+			if (in.size() > std::size(buffer)) {
+				throw std::invalid_argument("Input string is too long for datetime");
+			}
+			const size_t size = in.size();
+			for (size_t i = 0; i < size; ++i) {
+				buffer[i] = static_cast<uint32_t>(in[i]) < 0x80 ? static_cast<char>(in[i]) : '?';
+			}
+			out = ParseIsoDateTime(buffer, buffer + size);
 		}
 	}
 
@@ -330,7 +471,7 @@ namespace BitSerializer::Convert::Detail
 	{
 		tm_ext tmExt;
 		To(in, tmExt);
-		out = static_cast<tm>(tmExt);	// Ignore 'ms' part
+		out = static_cast<tm>(tmExt);	// Ignore fractions of second
 	}
 
 	/// <summary>
@@ -356,7 +497,7 @@ namespace BitSerializer::Convert::Detail
 
 	/// <summary>
 	/// Converts from `std::chrono::time_point` to `std::string` (ISO 8601/UTC).
-	///	Fractions of second will be rendered only when they present (non-zero).
+	///	Fractions of second will be rendered only when they present (non-zero), with 3, 6 or 9 digits.
 	/// </summary>
 	template <typename TClock, typename TDuration, typename TSym, typename TAllocator, std::enable_if_t<(TClock::is_steady == false), int> = 0>
 	static void To(const std::chrono::time_point<TClock, TDuration>& in, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& out)
@@ -364,73 +505,50 @@ namespace BitSerializer::Convert::Detail
 		using TDays = std::chrono::duration<typename TDuration::rep, std::ratio<86400>>;
 		const auto datePart = std::chrono::floor<TDays>(in);
 		const auto timePart = in - datePart;
-		auto timeInSec = std::chrono::floor<std::chrono::seconds>(timePart).count();
-		auto days = datePart.time_since_epoch().count();
-
-		// Based on Howard Hinnant's algorithm
-		static_assert(sizeof(int) >= 4, "This algorithm has not been ported to a 16 bit integers");
-		auto const z = days + 719468ll;
-		auto const era = (z >= 0 ? z : z - 146096) / 146097;
-		auto const doe = static_cast<unsigned>(z - era * 146097);				// [0, 146096]
-		auto const yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;	// [0, 399]
-		auto const y = yoe + era * 400;
-		auto const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);				// [0, 365]
-		auto const mp = (5 * doy + 2) / 153;									// [0, 11]
-		auto const d = doy - (153 * mp + 2) / 5 + 1;							// [1, 31]
-		auto const m = mp < 10 ? mp + 3 : mp - 9;								// [1, 12]
+		const auto timeInSec = std::chrono::floor<std::chrono::seconds>(timePart);
+		const auto secondsOfDay = static_cast<int>(timeInSec.count());
+		const civil_date date = DaysToCivilCached(static_cast<int64_t>(datePart.time_since_epoch().count()));
 
 		tm_ext utc{};
-		utc.tm_year = static_cast<int>(y) + (m <= 2);
-		utc.tm_mon = static_cast<int>(m);
-		utc.tm_mday = static_cast<int>(d);
-		utc.tm_hour = static_cast<int>(timeInSec / 3600);
-		utc.tm_min = timeInSec % 3600 / 60;
-		utc.tm_sec = timeInSec % 60;
-		utc.ms = static_cast<int>(std::chrono::round<std::chrono::milliseconds>(timePart - std::chrono::seconds(timeInSec)).count());
-		if (utc.ms != 0)
+		utc.tm_year = date.year;
+		utc.tm_mon = date.month;
+		utc.tm_mday = date.day;
+		utc.tm_hour = secondsOfDay / 3600;
+		utc.tm_min = secondsOfDay % 3600 / 60;
+		utc.tm_sec = secondsOfDay % 60;
+		if constexpr (std::ratio_less_v<typename TDuration::period, std::ratio<1>>)
 		{
-			if (utc.ms < 0) utc.ms += 1000;
-			To(utc, out);
-		}
-		else {
-			To(static_cast<tm&>(utc), out);		// Print without 'ms' part
+			utc.ns = static_cast<int>(std::chrono::floor<std::chrono::nanoseconds>(timePart - timeInSec).count());
+			if (utc.ns != 0)
+			{
+				To(utc, out);
+				return;
+			}
 		}
+		To(static_cast<tm&>(utc), out);		// Print without fractions of second
 	}
 
 	/// <summary>
 	/// Converts from `std::string_view` (ISO 8601/UTC format: YYYY-MM-DDThh:mm:ss[.SSS]Z) to `std::chrono::time_point`.
-	///	Fractions of second are optional, only 3 digits are allowed.
+	///	Fractions of second are optional, allowed up to 9 digits (nanoseconds).
 	///	Examples of allowed dates:
 	///	- 1872-01-01T00:00:00Z
 	///	- 2023-07-14T22:44:51.925Z
+	///	- 2023-07-14T22:44:51.925000001Z
 	/// </summary>
+	/// <exception cref="std::out_of_range">Thrown when the range or precision of target time_point is not enough.</exception>
 	template <typename TSym, typename TClock, typename TDuration, std::enable_if_t<(TClock::is_steady == false), int> = 0>
 	static void To(std::basic_string_view<TSym> in, std::chrono::time_point<TClock, TDuration>& out)
 	{
 		tm_ext tmExt;
 		To(in, tmExt);
 
-		// Based on Howard Hinnant's algorithm
-		static_assert(sizeof(int) >= 4, "This algorithm has not been ported to a 16 bit integers");
-		auto const y = tmExt.tm_year - (tmExt.tm_mon <= 2);
-		auto const m = static_cast<unsigned>(tmExt.tm_mon);
-		auto const d = static_cast<unsigned>(tmExt.tm_mday);
-		auto const era = (y >= 0 ? y : y - 399) / 400;
-		auto const yoe = static_cast<unsigned>(y - era * 400);				// [0, 399]
-		auto const doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;	// [0, 365]
-		auto const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;				// [0, 146096]
-
-		if (era > std::numeric_limits<int64_t>::max() / 146097ll ||
-			era < std::numeric_limits<int64_t>::min() / 146097ll)
-		{
-			throw std::out_of_range("Target duration is not enough");
-		}
-		const int64_t days = era * 146097ll + (static_cast<int>(doe) - 719468);
+		const int64_t days = CivilToDaysCached(tmExt.tm_year, tmExt.tm_mon, tmExt.tm_mday);
 		const auto time = static_cast<long long>(tmExt.tm_hour) * 3600 + static_cast<long long>(tmExt.tm_min) * 60 + tmExt.tm_sec;
 
 		std::chrono::time_point<TClock, TDuration> tp;
 		SafeAddDuration(tp, std::chrono::seconds(time));
-		SafeAddDuration(tp, std::chrono::milliseconds(tmExt.ms));
+		SafeAddDuration(tp, std::chrono::nanoseconds(tmExt.ns));
 		SafeAddDuration(tp, std::chrono::duration<int64_t, std::ratio<86400>>(days));
 		out = tp;
 	}
@@ -446,7 +564,10 @@ namespace BitSerializer::Convert::Detail
 			return;
 		}
 
-		const auto printTimePart = [](auto time, char type, std::string& outStr)
+		// Enough for sign, designators and four 64-bit numbers
+		char buffer[96];
+		char* pos = buffer;
+		const auto printTimePart = [&pos](auto time, char type)
 		{
 			if (time.count())
 			{
@@ -454,12 +575,12 @@ namespace BitSerializer::Convert::Detail
 				{
 					constexpr uint64_t maxI64Negative = 9223372036854775808u;
 					const uint64_t absTime = time.count() == LLONG_MIN ? maxI64Negative : static_cast<uint64_t>(std::abs(time.count()));
-					outStr.append(std::to_string(absTime));
+					pos = std::to_chars(pos, pos + 20, absTime).ptr;
 				}
 				else {
-					outStr.append(std::to_string(time.count()));
+					pos = std::to_chars(pos, pos + 20, static_cast<uint64_t>(time.count())).ptr;
 				}
-				outStr.push_back(type);
+				*pos++ = type;
 			}
 			return time;
 		};
@@ -469,16 +590,19 @@ namespace BitSerializer::Convert::Detail
 		using minutes = std::chrono::duration<TRep, std::ratio<60>>;
 		using seconds = std::chrono::duration<TRep, std::ratio<1>>;
 
-		std::string isoDur(in.count() < 0 ? "-P" : "P");
-		const auto hoursLeft = in - printTimePart(std::chrono::duration_cast<days>(in), 'D', isoDur);
+		if (in.count() < 0) {
+			*pos++ = '-';
+		}
+		*pos++ = 'P';
+		const auto hoursLeft = in - printTimePart(std::chrono::duration_cast<days>(in), 'D');
 		if (hoursLeft.count())
 		{
-			isoDur.push_back('T');
-			const auto minutesLeft = hoursLeft - printTimePart(std::chrono::duration_cast<hours>(hoursLeft), 'H', isoDur);
-			const auto secondsLeft = minutesLeft - printTimePart(std::chrono::duration_cast<minutes>(minutesLeft), 'M', isoDur);
-			printTimePart(std::chrono::duration_cast<seconds>(secondsLeft), 'S', isoDur);
+			*pos++ = 'T';
+			const auto minutesLeft = hoursLeft - printTimePart(std::chrono::duration_cast<hours>(hoursLeft), 'H');
+			const auto secondsLeft = minutesLeft - printTimePart(std::chrono::duration_cast<minutes>(minutesLeft), 'M');
+			printTimePart(std::chrono::duration_cast<seconds>(secondsLeft), 'S');
 		}
-		out.append(isoDur.data(), isoDur.data() + isoDur.size());
+		out.append(buffer, pos);
 	}
 
 	/// <summary>
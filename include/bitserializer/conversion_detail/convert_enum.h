@@ -8,6 +8,9 @@
 #include <cstring>
 #include <algorithm>
 #include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <cstdint>
 
 
 /// <summary>
@@ -69,6 +72,8 @@ namespace BitSerializer::Convert::Detail
 	template <typename TEnum>
 	class EnumRegistry
 	{
+		using underlying_type = std::make_unsigned_t<std::underlying_type_t<TEnum>>;
+
 	public:
 		template <size_t Size>
 		[[deprecated("Please use new macro REGISTER_ENUM() for registration enum types")]]
@@ -88,32 +93,102 @@ namespace BitSerializer::Convert::Detail
 			std::memcpy(descriptors_, descriptors, sizeof(EnumMetadata<TEnum>) * Size);
 			mBeginIt = descriptors_;
 			mEndIt = descriptors_ + Size;
+
+			// Build hash table for search by names (case-insensitive, uses open addressing with linear probing)
+			constexpr size_t namesIndexSize = GetNamesIndexSize(Size);
+			static size_t namesIndex[namesIndexSize] = {};
+			for (size_t i = 0; i < Size; ++i)
+			{
+				size_t pos = HashName(descriptors_[i].Name) & (namesIndexSize - 1);
+				while (namesIndex[pos] != 0) {
+					pos = (pos + 1) & (namesIndexSize - 1);
+				}
+				namesIndex[pos] = i + 1;
+			}
+			mNamesIndex = namesIndex;
+			mNamesIndexMask = namesIndexSize - 1;
+
+			// Build index for search by values (direct lookup table when values are dense, otherwise sorted for binary search)
+			static size_t valuesIndex[Size];
+			const auto minIt = std::min_element(descriptors_, mEndIt, [](const auto& lhs, const auto& rhs) {
+				return lhs.Value < rhs.Value;
+			});
+			mMinValue = static_cast<underlying_type>(minIt->Value);
+			mIsDenseValues = true;
+			std::fill(std::begin(valuesIndex), std::end(valuesIndex), Size);
+			for (size_t i = 0; i < Size; ++i)
+			{
+				const auto offset = static_cast<underlying_type>(static_cast<underlying_type>(descriptors_[i].Value) - mMinValue);
+				if (offset >= Size)
+				{
+					mIsDenseValues = false;
+					break;
+				}
+				// Keep the first registered descriptor when value has aliases
+				if (valuesIndex[offset] == Size) {
+					valuesIndex[offset] = i;
+				}
+			}
+			if (!mIsDenseValues)
+			{
+				for (size_t i = 0; i < Size; ++i) {
+					valuesIndex[i] = i;
+				}
+				std::stable_sort(std::begin(valuesIndex), std::end(valuesIndex), [](size_t lhs, size_t rhs) {
+					return mBeginIt[lhs].Value < mBeginIt[rhs].Value;
+				});
+			}
+			mValuesIndex = valuesIndex;
 			return true;
 		}
 
 		static const EnumMetadata<TEnum>& GetEnumMetadata(TEnum val)
 		{
-			const auto it = std::find_if(mBeginIt, mEndIt, [val](const EnumMetadata<TEnum>& metadata) {
-				return metadata.Value == val;
-			});
-			if (it == cend()) {
-				throw std::invalid_argument("Enum with passed value is not registered");
+			if (mIsDenseValues)
+			{
+				const auto offset = static_cast<underlying_type>(static_cast<underlying_type>(val) - mMinValue);
+				if (offset < size() && mValuesIndex[offset] != size()) {
+					return mBeginIt[mValuesIndex[offset]];
+				}
+			}
+			else if (mValuesIndex != nullptr)
+			{
+				const auto it = std::lower_bound(mValuesIndex, mValuesIndex + size(), val, [](size_t index, TEnum value) {
+					return mBeginIt[index].Value < value;
+				});
+				if (it != mValuesIndex + size() && mBeginIt[*it].Value == val) {
+					return mBeginIt[*it];
+				}
 			}
-			return *it;
+			throw std::invalid_argument("Enum with passed value is not registered");
 		}
 
 		template <typename TSym>
 		static const EnumMetadata<TEnum>& GetEnumMetadata(std::basic_string_view<TSym> name)
 		{
-			const auto it = std::find_if(mBeginIt, mEndIt, [name](const auto& metadata) {
-				return std::equal(name.cbegin(), name.cend(), metadata.Name.cbegin(), metadata.Name.cend(), [](const TSym lhs, const char rhs) {
-					return std::tolower(static_cast<int>(lhs)) == std::tolower(rhs);
-				});
-			});
-			if (it == cend()) {
-				throw std::invalid_argument("Enum with passed name is not registered");
+			if (mNamesIndex != nullptr)
+			{
+				const EnumMetadata<TEnum>* caseInsensitiveMatch = nullptr;
+				for (size_t pos = HashName(name) & mNamesIndexMask; mNamesIndex[pos] != 0; pos = (pos + 1) & mNamesIndexMask)
+				{
+					const auto& metadata = mBeginIt[mNamesIndex[pos] - 1];
+					// Exact match has priority over case-insensitive
+					if (std::equal(name.cbegin(), name.cend(), metadata.Name.cbegin(), metadata.Name.cend(), [](const TSym lhs, const char rhs) {
+						return ToCharCode(lhs) == ToCharCode(rhs);
+					})) {
+						return metadata;
+					}
+					if (caseInsensitiveMatch == nullptr && std::equal(name.cbegin(), name.cend(), metadata.Name.cbegin(), metadata.Name.cend(), [](const TSym lhs, const char rhs) {
+						return ToLowerCharCode(lhs) == ToLowerCharCode(rhs);
+					})) {
+						caseInsensitiveMatch = &metadata;
+					}
+				}
+				if (caseInsensitiveMatch != nullptr) {
+					return *caseInsensitiveMatch;
+				}
 			}
-			return *it;
+			throw std::invalid_argument("Enum with passed name is not registered");
 		}
 
 		template <typename TSym, typename TAllocator>
@@ -142,7 +217,51 @@ namespace BitSerializer::Convert::Detail
 		}
 
 	private:
+		/// <summary>
+		/// Returns size of hash table for names (power of two, at least twice more than number of elements).
+		/// </summary>
+		static constexpr size_t GetNamesIndexSize(size_t elementsCount) noexcept
+		{
+			size_t result = 1;
+			while (result < elementsCount * 2) {
+				result <<= 1;
+			}
+			return result;
+		}
+
+		template <typename TSym>
+		static constexpr uint32_t ToCharCode(TSym sym) noexcept {
+			return static_cast<uint32_t>(static_cast<std::make_unsigned_t<TSym>>(sym));
+		}
+
+		template <typename TSym>
+		static constexpr uint32_t ToLowerCharCode(TSym sym) noexcept
+		{
+			const uint32_t code = ToCharCode(sym);
+			return (code >= 'A' && code <= 'Z') ? code + ('a' - 'A') : code;
+		}
+
+		/// <summary>
+		/// Calculates case-insensitive hash of name (FNV-1a).
+		/// </summary>
+		template <typename TSym>
+		static size_t HashName(std::basic_string_view<TSym> name) noexcept
+		{
+			uint32_t hash = 2166136261u;
+			for (const TSym sym : name)
+			{
+				hash ^= ToLowerCharCode(sym);
+				hash *= 16777619u;
+			}
+			return hash;
+		}
+
 		static inline EnumMetadata<TEnum>* mBeginIt = nullptr;
 		static inline EnumMetadata<TEnum>* mEndIt = nullptr;
+		static inline const size_t* mNamesIndex = nullptr;
+		static inline size_t mNamesIndexMask = 0;
+		static inline const size_t* mValuesIndex = nullptr;
+		static inline underlying_type mMinValue = 0;
+		static inline bool mIsDenseValues = false;
 	};
 }
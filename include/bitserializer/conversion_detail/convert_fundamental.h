@@ -3,6 +3,7 @@
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
 #pragma once
+#include <algorithm>
 #include <cstring>
 #include <cstdio>
 #include <cstdlib>
@@ -10,6 +11,7 @@
 #include <limits>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include "convert_utf.h"
 
 namespace BitSerializer::Convert::Detail
@@ -241,6 +243,27 @@ namespace BitSerializer::Convert::Detail
 		}
 	}
 
+	/// <summary>
+	/// Formats floating point number into the buffer (must be at least 32 chars) with the passed number of significant
+	/// digits or in the shortest form which guarantees round-trip (when precision is zero).
+	/// </summary>
+	template <typename T, std::enable_if_t<(std::is_floating_point_v<T>), int> = 0>
+	std::string_view FormatFloat(T value, char* buffer, size_t bufferSize, uint8_t precision = 0)
+	{
+		// Digits above the maximum of the type do not give any precision
+		const int digits = std::min(static_cast<int>(precision), std::numeric_limits<T>::max_digits10);
+#if defined(__cpp_lib_to_chars)
+		const auto result = digits == 0
+			? std::to_chars(buffer, buffer + bufferSize, value)
+			: std::to_chars(buffer, buffer + bufferSize, value, std::chars_format::general, digits);
+		return { buffer, static_cast<size_t>(result.ptr - buffer) };
+#else
+		// Fallback for old compilers which do not support floating types in std::to_chars()
+		const int size = snprintf(buffer, bufferSize, "%.*g", digits == 0 ? std::numeric_limits<T>::max_digits10 : digits, static_cast<double>(value));
+		return { buffer, static_cast<size_t>(size) };
+#endif
+	}
+
 	/// <summary>
 	/// Converts boolean type to any UTF string.
 	/// The output representation is "true|false", please cast your boolean type to <int> if you would like to represent it as "1|0".
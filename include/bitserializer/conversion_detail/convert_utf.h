@@ -8,9 +8,16 @@
 #include <istream>
 #include <iterator>
 #include <string>
+#include <stdexcept>
+#include <vector>
 #include <cstring>
 #include "convert_enum.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BITSERIALIZER_HAS_SSE2
+#endif
+
 namespace BitSerializer::Convert
 {
 	/// <summary>
@@ -89,6 +96,43 @@ namespace BitSerializer::Convert
 			}
 			return nullptr;
 		}
+
+		/// <summary>
+		/// Swaps the byte order of 16 or 32-bit code units (input and output buffers can be the same for in-place conversion).
+		/// </summary>
+		template <typename TChar>
+		void SwapByteOrder(const TChar* in, size_t size, TChar* out) noexcept
+		{
+			static_assert(sizeof(TChar) == sizeof(char16_t) || sizeof(TChar) == sizeof(char32_t), "Only 16 or 32-bit characters are supported");
+
+			size_t i = 0;
+#ifdef BITSERIALIZER_HAS_SSE2
+			// Process by blocks of 16 bytes
+			constexpr size_t blockSize = sizeof(__m128i) / sizeof(TChar);
+			for (; i + blockSize <= size; i += blockSize)
+			{
+				__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				if constexpr (sizeof(TChar) == sizeof(char32_t))
+				{
+					// Swap 16-bit halves of each 32-bit code unit
+					block = _mm_shufflelo_epi16(block, _MM_SHUFFLE(2, 3, 0, 1));
+					block = _mm_shufflehi_epi16(block, _MM_SHUFFLE(2, 3, 0, 1));
+				}
+				block = _mm_or_si128(_mm_slli_epi16(block, 8), _mm_srli_epi16(block, 8));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), block);
+			}
+#endif
+			for (; i < size; ++i)
+			{
+				const auto sym = static_cast<uint32_t>(in[i]);
+				if constexpr (sizeof(TChar) == sizeof(char16_t)) {
+					out[i] = static_cast<TChar>(((sym >> 8) | (sym << 8)) & 0xFFFF);
+				}
+				else {
+					out[i] = static_cast<TChar>((sym >> 24) | ((sym << 8) & 0x00FF0000) | ((sym >> 8) & 0x0000FF00) | (sym << 24));
+				}
+			}
+		}
 	}
 
 	class Utf8
@@ -439,6 +483,17 @@ namespace BitSerializer::Convert
 			TBaseIt mBaseIt;
 		};
 
+		/// <summary>
+		/// Checks that big-endian code unit is the first part of surrogate pair.
+		/// </summary>
+		static bool IsHighSurrogate(const char16_t beSym) noexcept
+		{
+			const auto sym = static_cast<uint16_t>((beSym >> 8) | (beSym << 8));
+			return sym >= Unicode::HighSurrogatesStart && sym <= Unicode::HighSurrogatesEnd;
+		}
+
+		static constexpr size_t BufferSize = 256;
+
 	public:
 		using char_type = char16_t;
 		static constexpr UtfType utfType = UtfType::Utf16be;
@@ -456,7 +511,46 @@ namespace BitSerializer::Convert
 			static_assert(sizeof(decltype(*in)) == sizeof(char_type), "Input stream should represents sequence of 16-bit characters");
 			static_assert(sizeof(TOutChar) == sizeof(char) || sizeof(TOutChar) == sizeof(char16_t) || sizeof(TOutChar) == sizeof(char32_t), "Output string should have 8, 16 or 32-bit characters");
 
-			return Utf16Le::Decode(U16BeConstIterator<TInIt>(in), U16BeConstIterator<TInIt>(end), outStr, encodePolicy, errorMark);
+			if constexpr (std::is_pointer_v<TInIt>)
+			{
+				// Contiguous input can be converted to the native byte order by blocks
+				if constexpr (sizeof(TOutChar) == sizeof(char16_t))
+				{
+					auto size = static_cast<size_t>(end - in);
+					// Do not copy only first part of surrogate pair
+					if (size != 0 && IsHighSurrogate(in[size - 1])) {
+						--size;
+					}
+					const size_t startOutPos = outStr.size();
+					outStr.resize(startOutPos + size);
+					Detail::SwapByteOrder(reinterpret_cast<const char_type*>(in), size, reinterpret_cast<char_type*>(outStr.data() + startOutPos));
+					return in + size;
+				}
+				else
+				{
+					char_type buffer[BufferSize];
+					while (in != end)
+					{
+						auto size = std::min(static_cast<size_t>(end - in), BufferSize);
+						const bool isLastBlock = in + size == end;
+						// Move the first part of surrogate pair to the next block
+						if (!isLastBlock && IsHighSurrogate(in[size - 1])) {
+							--size;
+						}
+						Detail::SwapByteOrder(reinterpret_cast<const char_type*>(in), size, buffer);
+						const char_type* it = Utf16Le::Decode(static_cast<const char_type*>(buffer), static_cast<const char_type*>(buffer + size), outStr, encodePolicy, errorMark);
+						if (isLastBlock) {
+							return in + (it - buffer);
+						}
+						in += size;
+					}
+					return in;
+				}
+			}
+			else
+			{
+				return Utf16Le::Decode(U16BeConstIterator<TInIt>(in), U16BeConstIterator<TInIt>(end), outStr, encodePolicy, errorMark);
+			}
 		}
 
 		/// <summary>
@@ -472,9 +566,7 @@ namespace BitSerializer::Convert
 			const size_t startOutPos = outStr.size();
 			auto it = Utf16Le::Encode(in, end, outStr, encodePolicy, errorMark);
 
-			std::for_each(outStr.begin() + startOutPos, outStr.end(), [](TOutChar& sym) {
-				sym = static_cast<TOutChar>(sym >> 8) | static_cast<TOutChar>(sym << 8);
-			});
+			Detail::SwapByteOrder(outStr.data() + startOutPos, outStr.size() - startOutPos, outStr.data() + startOutPos);
 			return it;
 		}
 	};
@@ -567,6 +659,8 @@ namespace BitSerializer::Convert
 			TBaseIt mBaseIt;
 		};
 
+		static constexpr size_t BufferSize = 128;
+
 	public:
 		using char_type = char32_t;
 		static constexpr UtfType utfType = UtfType::Utf32be;
@@ -584,7 +678,32 @@ namespace BitSerializer::Convert
 			static_assert(sizeof(decltype(*in)) == sizeof(char_type), "Input stream should represents sequence of 32-bit characters");
 			static_assert(sizeof(TOutChar) == sizeof(char) || sizeof(TOutChar) == sizeof(char16_t) || sizeof(TOutChar) == sizeof(char32_t), "Output string should have 8, 16 or 32-bit characters");
 
-			return Utf32Le::Decode(U32BeConstIterator<TInIt>(in), U32BeConstIterator<TInIt>(end), outStr, encodePolicy, errorMark);
+			if constexpr (std::is_pointer_v<TInIt>)
+			{
+				// Contiguous input can be converted to the native byte order by blocks
+				if constexpr (sizeof(TOutChar) == sizeof(char32_t))
+				{
+					const auto size = static_cast<size_t>(end - in);
+					const size_t startOutPos = outStr.size();
+					outStr.resize(startOutPos + size);
+					Detail::SwapByteOrder(reinterpret_cast<const char_type*>(in), size, reinterpret_cast<char_type*>(outStr.data() + startOutPos));
+				}
+				else
+				{
+					char_type buffer[BufferSize];
+					for (size_t size; in != end; in += size)
+					{
+						size = std::min(static_cast<size_t>(end - in), BufferSize);
+						Detail::SwapByteOrder(reinterpret_cast<const char_type*>(in), size, buffer);
+						Utf32Le::Decode(static_cast<const char_type*>(buffer), static_cast<const char_type*>(buffer + size), outStr, encodePolicy, errorMark);
+					}
+				}
+				return end;
+			}
+			else
+			{
+				return Utf32Le::Decode(U32BeConstIterator<TInIt>(in), U32BeConstIterator<TInIt>(end), outStr, encodePolicy, errorMark);
+			}
 		}
 
 		/// <summary>
@@ -602,9 +721,7 @@ namespace BitSerializer::Convert
 			const size_t startOutPos = outStr.size();
 			auto it = Utf32Le::Encode(in, end, outStr, encodePolicy, errorMark);
 
-			std::for_each(outStr.begin() + startOutPos, outStr.end(), [](TOutChar& sym) {
-				sym = (sym >> 24) | ((sym << 8) & 0x00FF0000) | ((sym >> 8) & 0x0000FF00) | (sym << 24);
-			});
+			Detail::SwapByteOrder(outStr.data() + startOutPos, outStr.size() - startOutPos, outStr.data() + startOutPos);
 			return it;
 		}
 	};
@@ -776,8 +893,9 @@ namespace BitSerializer::Convert
 
 	/// <summary>
 	/// Allows to read streams in various UTF encodings with automatic detection.
+	/// The chunk size (in bytes) can be passed in the constructor, template argument defines only its default value.
 	/// </summary>
-	template <typename TTargetUtfType, size_t ChunkSize = 256>
+	template <typename TTargetUtfType, size_t ChunkSize = 65536>
 	class CEncodedStreamReader
 	{
 	public:
@@ -792,15 +910,23 @@ namespace BitSerializer::Convert
 		~CEncodedStreamReader() = default;
 
 		CEncodedStreamReader(std::istream& inputStream, EncodeErrorPolicy encodeErrorPolicy = EncodeErrorPolicy::WriteErrorMark,
-			const target_char_type* errorMark = Detail::GetDefaultErrorMark<target_char_type>())
+			const target_char_type* errorMark = Detail::GetDefaultErrorMark<target_char_type>(), size_t chunkSize = ChunkSize)
 			: mInputStream(inputStream)
 			, mEncodeErrorPolicy(encodeErrorPolicy)
 			, mErrorMark(errorMark)
+			, mEncodedBuffer(chunkSize)
 		{
 			static_assert((ChunkSize % 4) == 0, "Chunk size size must be a multiple of 4");
 			static_assert(std::is_same_v<TTargetUtfType, Utf8> || std::is_same_v<TTargetUtfType, Utf16Le> || std::is_same_v<TTargetUtfType, Utf32Le>, 
 				"TTargetUtfType can be only UTF-8, UTF-16Le or UTF-32Le");
 
+			if (chunkSize == 0 || (chunkSize % 4) != 0)
+			{
+				throw std::invalid_argument("Chunk size size must be a multiple of 4");
+			}
+			mStartDataPtr = mEndDataPtr = mEncodedBuffer.data();
+			mEndBufferPtr = mEncodedBuffer.data() + mEncodedBuffer.size();
+
 			if (ReadNextEncodedChunk())
 			{
 				size_t bomSize = 0;
@@ -809,32 +935,53 @@ namespace BitSerializer::Convert
 			}
 		}
 
+		/// <summary>
+		/// Reads next chunk of stream and appends decoded data to the output string.
+		/// Returns false when there is no more data.
+		/// </summary>
 		template<typename TAllocator>
 		bool ReadChunk(std::basic_string<target_char_type, std::char_traits<target_char_type>, TAllocator>& outStr)
 		{
-			if (IsEnd())
+			const auto prevOutSize = outStr.size();
+			if (mPendingPos != mPendingStr.size())
 			{
-				return false;
+				outStr.append(mPendingStr, mPendingPos);
+				mPendingStr.clear();
+				mPendingPos = 0;
 			}
 
-			if (!ReadNextEncodedChunk() && mStartDataPtr == mEndDataPtr)
+			if (mStartDataPtr == mEndDataPtr && mInputStream.eof())
 			{
-				return false;
+				return prevOutSize != outStr.size();
 			}
 
-			const auto prevOutSize = outStr.size();
-			switch (mUtfType)
+			if constexpr (std::is_same_v<TTargetUtfType, Utf8>)
 			{
-			case UtfType::Utf8:
-				if constexpr (std::is_same_v<TTargetUtfType, Utf8>)
+				if (mUtfType == UtfType::Utf8)
 				{
+					// Read directly into the tail of output string (its capacity grows geometrically, the size is trimmed to the read bytes)
 					outStr.append(mStartDataPtr, mEndDataPtr);
-					mStartDataPtr = mEndDataPtr = mEncodedBuffer;
-				}
-				else
-				{
-					mStartDataPtr = TTargetUtfType::Encode(mStartDataPtr, mEndDataPtr, outStr, mEncodeErrorPolicy, mErrorMark);
+					mStartDataPtr = mEndDataPtr = mEncodedBuffer.data();
+					const size_t readPos = outStr.size();
+					const size_t chunkSize = mEncodedBuffer.size();
+					if (outStr.capacity() < readPos + chunkSize) {
+						outStr.reserve(std::max(readPos + chunkSize, outStr.capacity() * 2));
+					}
+					outStr.resize(readPos + chunkSize);
+					outStr.resize(readPos + ReadFromStream(outStr.data() + readPos, chunkSize));
+					return prevOutSize != outStr.size();
 				}
+			}
+
+			if (!ReadNextEncodedChunk() && mStartDataPtr == mEndDataPtr)
+			{
+				return prevOutSize != outStr.size();
+			}
+
+			switch (mUtfType)
+			{
+			case UtfType::Utf8:
+				mStartDataPtr = TTargetUtfType::Encode(mStartDataPtr, mEndDataPtr, outStr, mEncodeErrorPolicy, mErrorMark);
 				break;
 			case UtfType::Utf16le:
 				mStartDataPtr = reinterpret_cast<char*>(Utf16Le::Decode(
@@ -861,55 +1008,107 @@ namespace BitSerializer::Convert
 			if (mInputStream.eof() && mStartDataPtr != mEndDataPtr)
 			{
 				Detail::HandleEncodingError(outStr, mEncodeErrorPolicy, mErrorMark);
-				mStartDataPtr = mEndDataPtr = mEncodedBuffer;
+				mStartDataPtr = mEndDataPtr = mEncodedBuffer.data();
 			}
 
 			return prevOutSize != outStr.size();
 		}
 
+		/// <summary>
+		/// Reads next chunk of stream and writes decoded data to the caller's buffer.
+		/// Returns number of written characters (zero when there is no more data).
+		/// </summary>
+		size_t ReadChunk(target_char_type* outBuffer, size_t bufferSize)
+		{
+			size_t outSize = 0;
+			if constexpr (std::is_same_v<TTargetUtfType, Utf8>)
+			{
+				if (mUtfType == UtfType::Utf8)
+				{
+					// Copy rest of data from internal buffer and read directly to the caller's buffer
+					outSize = std::min(bufferSize, static_cast<size_t>(mEndDataPtr - mStartDataPtr));
+					std::memcpy(outBuffer, mStartDataPtr, outSize);
+					mStartDataPtr += outSize;
+					if (mStartDataPtr == mEndDataPtr)
+					{
+						mStartDataPtr = mEndDataPtr = mEncodedBuffer.data();
+						if (outSize != bufferSize && !mInputStream.eof()) {
+							outSize += ReadFromStream(outBuffer + outSize, bufferSize - outSize);
+						}
+					}
+					return outSize;
+				}
+			}
+
+			// Decode to intermediate string, the rest of data will be returned by the next call
+			while (mPendingPos == mPendingStr.size())
+			{
+				mPendingStr.clear();
+				mPendingPos = 0;
+				if (!ReadChunk(mPendingStr)) {
+					return 0;
+				}
+			}
+			outSize = std::min(bufferSize, mPendingStr.size() - mPendingPos);
+			std::copy_n(mPendingStr.data() + mPendingPos, outSize, outBuffer);
+			mPendingPos += outSize;
+			return outSize;
+		}
+
 		[[nodiscard]] bool IsEnd() const {
-			return mStartDataPtr == mEndDataPtr && mInputStream.eof();
+			return mPendingPos == mPendingStr.size() && mStartDataPtr == mEndDataPtr && mInputStream.eof();
 		}
 
 		[[nodiscard]] UtfType GetSourceUtfType() const noexcept {
 			return mUtfType;
 		}
 
+		[[nodiscard]] size_t GetChunkSize() const noexcept {
+			return mEncodedBuffer.size();
+		}
+
 	private:
 		template <typename T>
 		T* GetAlignedEndDataPtr() noexcept {
 			return reinterpret_cast<T*>(mEndDataPtr - ((mEndDataPtr - mStartDataPtr) % sizeof(T)));
 		}
 
+		size_t ReadFromStream(char* outBuffer, size_t size)
+		{
+			mInputStream.read(outBuffer, static_cast<std::streamsize>(size));
+			return static_cast<size_t>(mInputStream.gcount());
+		}
+
 		bool ReadNextEncodedChunk()
 		{
 			if (mStartDataPtr == mEndBufferPtr)
 			{
-				mStartDataPtr = mEndDataPtr = mEncodedBuffer;
+				mStartDataPtr = mEndDataPtr = mEncodedBuffer.data();
 			}
-			else if (mStartDataPtr != mEncodedBuffer)
+			else if (mStartDataPtr != mEncodedBuffer.data())
 			{
 				// Squeeze buffer
-				std::memcpy(mEncodedBuffer, mStartDataPtr, mEndDataPtr - mStartDataPtr);
-				mEndDataPtr -= mStartDataPtr - mEncodedBuffer;
-				mStartDataPtr = mEncodedBuffer;
+				std::memmove(mEncodedBuffer.data(), mStartDataPtr, mEndDataPtr - mStartDataPtr);
+				mEndDataPtr -= mStartDataPtr - mEncodedBuffer.data();
+				mStartDataPtr = mEncodedBuffer.data();
 			}
 
 			// Read next chunk
-			mInputStream.read(mEndDataPtr, static_cast<std::streamsize>(mEndBufferPtr - mEndDataPtr));
-			const auto lastReadSize = mInputStream.gcount();
+			const auto lastReadSize = ReadFromStream(mEndDataPtr, mEndBufferPtr - mEndDataPtr);
 			mEndDataPtr += lastReadSize;
-			assert(mStartDataPtr >= mEncodedBuffer && mStartDataPtr <= mEndDataPtr);
+			assert(mStartDataPtr >= mEncodedBuffer.data() && mStartDataPtr <= mEndDataPtr);
 			return lastReadSize != 0;
 		}
 
-		UtfType mUtfType;
+		UtfType mUtfType = UtfType::Utf8;
 		std::istream& mInputStream;
 		EncodeErrorPolicy mEncodeErrorPolicy;
 		const target_char_type* mErrorMark;
-		char mEncodedBuffer[ChunkSize];
-		char* const mEndBufferPtr = mEncodedBuffer + ChunkSize;
-		char* mStartDataPtr = mEncodedBuffer;
-		char* mEndDataPtr = mEncodedBuffer;
+		std::vector<char> mEncodedBuffer;
+		char* mEndBufferPtr = nullptr;
+		char* mStartDataPtr = nullptr;
+		char* mEndDataPtr = nullptr;
+		std::basic_string<target_char_type> mPendingStr;
+		size_t mPendingPos = 0;
 	};
 }
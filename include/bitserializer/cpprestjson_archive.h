@@ -3,11 +3,15 @@
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
 #pragma once
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <iterator>
 #include <optional>
 #include <type_traits>
 #include <utility>
 #include <variant>
+#include <vector>
 #include "bitserializer/serialization_detail/archive_base.h"
 #include "bitserializer/serialization_detail/errors_handling.h"
 
@@ -233,8 +237,10 @@ public:
 		}
 		else
 		{
+			// Items of array usually have the same structure, so the number of fields in the previous one is used as hint for reservation
+			const size_t fieldsCountHint = mIndex == 0 ? 0 : (*mNode)[mIndex - 1].size();
 			auto& jsonValue = SaveJsonValue(web::json::value::object());
-			return std::make_optional<JsonObjectScope<TMode>>(&jsonValue, this->GetContext(), this);
+			return std::make_optional<JsonObjectScope<TMode>>(&jsonValue, this->GetContext(), this, key_type_view(), fieldsCountHint);
 		}
 	}
 
@@ -317,11 +323,29 @@ template <SerializeMode TMode>
 class JsonObjectScope final : public TArchiveScope<TMode>, public JsonScopeBase
 {
 public:
-	explicit JsonObjectScope(web::json::value* node, SerializationContext& serializationContext, JsonScopeBase* parent = nullptr, key_type_view parentKey = {})
+	explicit JsonObjectScope(web::json::value* node, SerializationContext& serializationContext, JsonScopeBase* parent = nullptr, key_type_view parentKey = {},
+		size_t fieldsCountHint = 0)
 		: TArchiveScope<TMode>(serializationContext)
 		, JsonScopeBase(node, parent, parentKey)
 	{
 		assert(mNode->is_object());
+		if constexpr (TMode == SerializeMode::Save) {
+			mFields.reserve(fieldsCountHint);
+		}
+	}
+
+	JsonObjectScope(JsonObjectScope&&) = default;
+	JsonObjectScope& operator=(JsonObjectScope&&) = delete;
+
+	~JsonObjectScope()
+	{
+		if constexpr (TMode == SerializeMode::Save)
+		{
+			// Fields are collected into the vector and moved to the JSON object at once (CppRestSdk sorts them only once)
+			if (!mFields.empty()) {
+				*mNode = web::json::value::object(std::move(mFields));
+			}
+		}
 	}
 
 	[[nodiscard]] key_const_iterator cbegin() const {
@@ -410,20 +434,40 @@ public:
 	}
 
 protected:
-	web::json::value* LoadJsonValue(const key_type& key) const
+	web::json::value* LoadJsonValue(const key_type& key)
 	{
 		auto& jObject = mNode->as_object();
-		auto it = std::find_if(jObject.begin(), jObject.end(), [&key](const auto& p) { return p.first == key; });
-		return it == jObject.end() ? nullptr : &it->second;
+		// Fast path - the member which follows the previously loaded one (when the order of members matches the order of serialization)
+		if (mNextMemberIndex < jObject.size())
+		{
+			const auto it = jObject.begin() + static_cast<std::ptrdiff_t>(mNextMemberIndex);
+			if (it->first == key)
+			{
+				++mNextMemberIndex;
+				return &it->second;
+			}
+		}
+
+		// Search by key (members are kept sorted by the CppRestSdk, except when their order is required to be preserved)
+		const auto it = jObject.find(key);
+		if (it == jObject.end()) {
+			return nullptr;
+		}
+		mNextMemberIndex = static_cast<size_t>(std::distance(jObject.begin(), it)) + 1;
+		return &it->second;
 	}
 
-	web::json::value& SaveJsonValue(const key_type& key, web::json::value&& jsonValue) const
+	web::json::value& SaveJsonValue(const key_type& key, web::json::value&& jsonValue)
 	{
 		// Checks that object was not saved previously under the same key
-		assert(mNode->as_object().find(key) == mNode->as_object().end());
+		assert(std::none_of(mFields.cbegin(), mFields.cend(), [&key](const auto& field) { return field.first == key; }));
 
-		return (*mNode)[key] = std::move(jsonValue);
+		return mFields.emplace_back(key, std::move(jsonValue)).second;
 	}
+
+private:
+	size_t mNextMemberIndex = 0;
+	std::vector<std::pair<utility::string_t, web::json::value>> mFields;
 };
 
 /// <summary>
@@ -37,7 +37,7 @@ public:
 	virtual ~ICsvWriter() = default;
 
 	virtual void SetEstimatedSize(size_t size) = 0;
-	virtual void WriteValue(const std::string_view& key, const std::string& value) = 0;
+	virtual void WriteValue(const std::string_view& key, std::string_view value) = 0;
 	virtual void NextLine() = 0;
 	[[nodiscard]] virtual size_t GetCurrentIndex() const noexcept = 0;
 };
@@ -101,6 +101,13 @@ public:
 		return true;
 	}
 
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, std::string_view& value)
+	{
+		mCsvWriter->WriteValue(std::forward<TKey>(key), value);
+		return true;
+	}
+
 	template <typename TKey>
 	bool SerializeValue(TKey&& key, std::nullptr_t&)
 	{
@@ -220,6 +227,16 @@ public:
 		return false;
 	}
 
+	/// <summary>
+	/// Reads the value as view to the internal buffer of reader, it is valid only until the next value is read (the row buffer is
+	/// reused for next rows), so it should be copied when it needs to be kept. Used for loading enums without temporary strings.
+	/// </summary>
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, std::string_view& value)
+	{
+		return mCsvReader->ReadValue(key, value);
+	}
+
 	template <typename TKey, typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
 	bool SerializeValue(TKey&& key, T& value)
 	{
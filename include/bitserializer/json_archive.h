@@ -0,0 +1,927 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include "bitserializer/serialization_detail/archive_base.h"
+#include "bitserializer/serialization_detail/errors_handling.h"
+
+
+namespace BitSerializer::Json::Simd {
+namespace Detail {
+
+/// <summary>
+/// The traits of JSON archive (internal implementation - no dependencies)
+/// </summary>
+struct JsonArchiveTraits
+{
+	static constexpr ArchiveType archive_type = ArchiveType::Json;
+	using key_type = std::string;
+	using supported_key_types = TSupportedKeyTypes<const char*, std::string_view, key_type>;
+	using preferred_output_format = std::basic_string<char, std::char_traits<char>>;
+	using preferred_stream_char_type = char;
+	static constexpr char path_separator = '/';
+
+protected:
+	~JsonArchiveTraits() = default;
+};
+
+class IJsonWriter
+{
+public:
+	virtual ~IJsonWriter() = default;
+
+	virtual void WriteNull() = 0;
+	virtual void WriteBoolean(bool value) = 0;
+	virtual void WriteSignedInteger(int64_t value) = 0;
+	virtual void WriteUnsignedInteger(uint64_t value) = 0;
+	virtual void WriteFloat(float value) = 0;
+	virtual void WriteDouble(double value) = 0;
+	virtual void WriteString(std::string_view value) = 0;
+	virtual void WriteKey(std::string_view key) = 0;
+	virtual void BeginArray() = 0;
+	virtual void EndArray() = 0;
+	virtual void BeginObject() = 0;
+	virtual void EndObject() = 0;
+	virtual void Flush() = 0;
+};
+
+class IJsonReader
+{
+public:
+	virtual ~IJsonReader() = default;
+
+	[[nodiscard]] virtual size_t GetPosition() const noexcept = 0;
+	virtual void SetPosition(size_t pos) noexcept = 0;
+	virtual bool ReadValue(std::nullptr_t& value) = 0;
+	virtual bool ReadValue(bool& value) = 0;
+	virtual bool ReadValue(uint8_t& value) = 0;
+	virtual bool ReadValue(uint16_t& value) = 0;
+	virtual bool ReadValue(uint32_t& value) = 0;
+	virtual bool ReadValue(uint64_t& value) = 0;
+	virtual bool ReadValue(int8_t& value) = 0;
+	virtual bool ReadValue(int16_t& value) = 0;
+	virtual bool ReadValue(int32_t& value) = 0;
+	virtual bool ReadValue(int64_t& value) = 0;
+	virtual bool ReadValue(float& value) = 0;
+	virtual bool ReadValue(double& value) = 0;
+	virtual bool ReadValue(std::string_view& value) = 0;
+	virtual void ReadKey(std::string_view& key) = 0;
+	virtual bool ReadArraySize(size_t& arraySize) noexcept = 0;
+	virtual bool ReadObjectSize(size_t& objectSize) noexcept = 0;
+	virtual void SkipValue() noexcept = 0;
+};
+
+class IJsonLinesReader
+{
+public:
+	virtual ~IJsonLinesReader() = default;
+
+	[[nodiscard]] virtual bool IsEnd() = 0;
+	/// <summary>
+	/// Parses the next record and returns the reader of it (valid until the next record is requested).
+	/// </summary>
+	virtual IJsonReader* ReadNextRecord() = 0;
+};
+
+
+/// <summary>
+/// Base class of JSON scope
+/// </summary>
+class JsonScopeBase : public JsonArchiveTraits
+{
+public:
+	JsonScopeBase(const JsonScopeBase&) = delete;
+	JsonScopeBase& operator=(const JsonScopeBase&) = delete;
+
+	/// <summary>
+	/// Gets the current path in JSON (RFC 6901 - JSON Pointer).
+	/// </summary>
+	[[nodiscard]] virtual std::string GetPath() const
+	{
+		const std::string localPath = mParentKey.empty()
+			? std::string()
+			: path_separator + std::string(mParentKey);
+		return mParent == nullptr ? localPath : mParent->GetPath() + localPath;
+	}
+
+protected:
+	explicit JsonScopeBase(const JsonScopeBase* parent = nullptr, std::string_view parentKey = {}) noexcept
+		: mParent(parent)
+		, mParentKey(parentKey)
+	{ }
+
+	~JsonScopeBase() = default;
+
+	/// <summary>
+	/// Integral type with fixed width which is used for reading value with type `T`.
+	/// </summary>
+	template <typename T>
+	using fixed_integral_t = std::conditional_t<std::is_signed_v<T>,
+		std::conditional_t<sizeof(T) == 1, int8_t, std::conditional_t<sizeof(T) == 2, int16_t, std::conditional_t<sizeof(T) == 4, int32_t, int64_t>>>,
+		std::conditional_t<sizeof(T) == 1, uint8_t, std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>>;
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	static bool LoadValue(IJsonReader* jsonReader, T& value)
+	{
+		if constexpr (std::is_same_v<T, bool> || std::is_null_pointer_v<T> || std::is_same_v<T, float> || std::is_same_v<T, double>)
+		{
+			return jsonReader->ReadValue(value);
+		}
+		else if constexpr (std::is_floating_point_v<T>)
+		{
+			double fixedValue;
+			if (jsonReader->ReadValue(fixedValue))
+			{
+				value = static_cast<T>(fixedValue);
+				return true;
+			}
+			return false;
+		}
+		else
+		{
+			fixed_integral_t<T> fixedValue;
+			if (jsonReader->ReadValue(fixedValue))
+			{
+				value = static_cast<T>(fixedValue);
+				return true;
+			}
+			return false;
+		}
+	}
+
+	template <typename TSym, typename TAllocator>
+	static bool LoadValue(IJsonReader* jsonReader, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		if (std::string_view strValue; jsonReader->ReadValue(strValue))
+		{
+			if constexpr (std::is_same_v<TSym, char>) {
+				value.assign(strValue.data(), strValue.size());
+			}
+			else {
+				value = Convert::To<std::basic_string<TSym, std::char_traits<TSym>, TAllocator>>(strValue);
+			}
+			return true;
+		}
+		return false;
+	}
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	static void SaveValue(IJsonWriter* jsonWriter, const T& value)
+	{
+		if constexpr (std::is_null_pointer_v<T>) {
+			jsonWriter->WriteNull();
+		}
+		else if constexpr (std::is_same_v<T, bool>) {
+			jsonWriter->WriteBoolean(value);
+		}
+		else if constexpr (std::is_same_v<T, float>) {
+			jsonWriter->WriteFloat(value);
+		}
+		else if constexpr (std::is_floating_point_v<T>) {
+			jsonWriter->WriteDouble(static_cast<double>(value));
+		}
+		else if constexpr (std::is_signed_v<T>) {
+			jsonWriter->WriteSignedInteger(value);
+		}
+		else {
+			jsonWriter->WriteUnsignedInteger(value);
+		}
+	}
+
+	template <typename TSym, typename TAllocator>
+	static void SaveValue(IJsonWriter* jsonWriter, const std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		if constexpr (std::is_same_v<TSym, char>) {
+			jsonWriter->WriteString(std::string_view(value.data(), value.size()));
+		}
+		else {
+			jsonWriter->WriteString(Convert::ToString(value));
+		}
+	}
+
+	const JsonScopeBase* mParent;
+	std::string_view mParentKey;
+};
+
+
+// Forward declarations
+class JsonWriteObjectScope;
+
+/// <summary>
+/// JSON scope for writing arrays (list of values without keys).
+/// </summary>
+class JsonWriteArrayScope final : public TArchiveScope<SerializeMode::Save>, public JsonScopeBase
+{
+public:
+	JsonWriteArrayScope(IJsonWriter* jsonWriter, SerializationContext& serializationContext,
+		const JsonScopeBase* parent = nullptr, std::string_view parentKey = {})
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, JsonScopeBase(parent, parentKey)
+		, mJsonWriter(jsonWriter)
+	{
+		mJsonWriter->BeginArray();
+	}
+
+	~JsonWriteArrayScope()
+	{
+		mJsonWriter->EndArray();
+	}
+
+	/// <summary>
+	/// Gets the current path in JSON (RFC 6901 - JSON Pointer).
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const override
+	{
+		return JsonScopeBase::GetPath() + path_separator + Convert::ToString(mIndex);
+	}
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		SaveValue(mJsonWriter, value);
+		++mIndex;
+		return true;
+	}
+
+	template <typename TSym, typename TAllocator>
+	bool SerializeValue(std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		SaveValue(mJsonWriter, value);
+		++mIndex;
+		return true;
+	}
+
+	bool SerializeValue(std::string_view& value)
+	{
+		mJsonWriter->WriteString(value);
+		++mIndex;
+		return true;
+	}
+
+	std::optional<JsonWriteObjectScope> OpenObjectScope();
+
+	std::optional<JsonWriteArrayScope> OpenArrayScope(size_t)
+	{
+		++mIndex;
+		return std::make_optional<JsonWriteArrayScope>(mJsonWriter, GetContext(), this);
+	}
+
+private:
+	IJsonWriter* mJsonWriter;
+	size_t mIndex = 0;
+};
+
+
+/// <summary>
+/// JSON scope for writing objects (list of values with keys).
+/// </summary>
+class JsonWriteObjectScope final : public TArchiveScope<SerializeMode::Save>, public JsonScopeBase
+{
+public:
+	JsonWriteObjectScope(IJsonWriter* jsonWriter, SerializationContext& serializationContext,
+		const JsonScopeBase* parent = nullptr, std::string_view parentKey = {})
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, JsonScopeBase(parent, parentKey)
+		, mJsonWriter(jsonWriter)
+	{
+		mJsonWriter->BeginObject();
+	}
+
+	~JsonWriteObjectScope()
+	{
+		mJsonWriter->EndObject();
+	}
+
+	/// <summary>
+	/// Constant iterator for keys (saved keys are not accessible, so the range is always empty).
+	/// </summary>
+	class key_const_iterator
+	{
+	public:
+		bool operator==(const key_const_iterator&) const noexcept { return true; }
+		bool operator!=(const key_const_iterator&) const noexcept { return false; }
+		key_const_iterator& operator++() noexcept { return *this; }
+		key_type operator*() const { return {}; }
+	};
+
+	[[nodiscard]] key_const_iterator cbegin() const noexcept { return {}; }
+	[[nodiscard]] key_const_iterator cend() const noexcept { return {}; }
+
+	template <typename TKey, typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(TKey&& key, T& value)
+	{
+		WriteKey(key);
+		SaveValue(mJsonWriter, value);
+		return true;
+	}
+
+	template <typename TKey, typename TSym, typename TAllocator>
+	bool SerializeValue(TKey&& key, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		WriteKey(key);
+		SaveValue(mJsonWriter, value);
+		return true;
+	}
+
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, std::string_view& value)
+	{
+		WriteKey(key);
+		mJsonWriter->WriteString(value);
+		return true;
+	}
+
+	template <typename TKey>
+	std::optional<JsonWriteObjectScope> OpenObjectScope(TKey&& key)
+	{
+		const std::string_view keyView = WriteKey(key);
+		return std::make_optional<JsonWriteObjectScope>(mJsonWriter, GetContext(), this, keyView);
+	}
+
+	template <typename TKey>
+	std::optional<JsonWriteArrayScope> OpenArrayScope(TKey&& key, size_t)
+	{
+		const std::string_view keyView = WriteKey(key);
+		return std::make_optional<JsonWriteArrayScope>(mJsonWriter, GetContext(), this, keyView);
+	}
+
+private:
+	template <typename TKey>
+	std::string_view WriteKey(const TKey& key)
+	{
+		const std::string_view keyView(key);
+		mJsonWriter->WriteKey(keyView);
+		return keyView;
+	}
+
+	IJsonWriter* mJsonWriter;
+};
+
+inline std::optional<JsonWriteObjectScope> JsonWriteArrayScope::OpenObjectScope()
+{
+	++mIndex;
+	return std::make_optional<JsonWriteObjectScope>(mJsonWriter, GetContext(), this);
+}
+
+
+/// <summary>
+/// JSON root scope (can write value, array or object)
+/// </summary>
+class JsonWriteRootScope final : public TArchiveScope<SerializeMode::Save>, public JsonScopeBase
+{
+public:
+	JsonWriteRootScope(std::string& outputData, SerializationContext& serializationContext);
+	JsonWriteRootScope(std::ostream& outputStream, SerializationContext& serializationContext);
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		SaveValue(mJsonWriter.get(), value);
+		return true;
+	}
+
+	template <typename TSym, typename TAllocator>
+	bool SerializeValue(std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		SaveValue(mJsonWriter.get(), value);
+		return true;
+	}
+
+	bool SerializeValue(std::string_view& value)
+	{
+		mJsonWriter->WriteString(value);
+		return true;
+	}
+
+	std::optional<JsonWriteObjectScope> OpenObjectScope()
+	{
+		return std::make_optional<JsonWriteObjectScope>(mJsonWriter.get(), GetContext());
+	}
+
+	std::optional<JsonWriteArrayScope> OpenArrayScope(size_t)
+	{
+		return std::make_optional<JsonWriteArrayScope>(mJsonWriter.get(), GetContext());
+	}
+
+	void Finalize()
+	{
+		mJsonWriter->Flush();
+	}
+
+private:
+	std::unique_ptr<IJsonWriter> mJsonWriter;
+};
+
+/// <summary>
+/// JSON Lines root scope (can write only list of records, each of them is written on a separate line)
+/// </summary>
+class JsonLinesWriteRootScope final : public TArchiveScope<SerializeMode::Save>, public JsonScopeBase
+{
+public:
+	JsonLinesWriteRootScope(std::string& outputData, SerializationContext& serializationContext);
+	JsonLinesWriteRootScope(std::ostream& outputStream, SerializationContext& serializationContext);
+
+	std::optional<JsonWriteArrayScope> OpenArrayScope(size_t)
+	{
+		return std::make_optional<JsonWriteArrayScope>(mJsonWriter.get(), GetContext());
+	}
+
+	void Finalize()
+	{
+		mJsonWriter->Flush();
+	}
+
+private:
+	std::unique_ptr<IJsonWriter> mJsonWriter;
+};
+
+
+// Forward declarations
+class JsonReadObjectScope;
+
+/// <summary>
+/// JSON scope for reading arrays (list of values without keys).
+/// </summary>
+class JsonReadArrayScope final : public TArchiveScope<SerializeMode::Load>, public JsonScopeBase
+{
+public:
+	JsonReadArrayScope(IJsonReader* jsonReader, size_t arraySize, SerializationContext& serializationContext,
+		const JsonScopeBase* parent = nullptr, std::string_view parentKey = {}) noexcept
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, JsonScopeBase(parent, parentKey)
+		, mJsonReader(jsonReader)
+		, mSize(arraySize)
+	{ }
+
+	~JsonReadArrayScope()
+	{
+		// Skip not loaded items, for continue reading from the end of array
+		for (; mIndex < mSize; ++mIndex) {
+			mJsonReader->SkipValue();
+		}
+	}
+
+	/// <summary>
+	/// Gets the current path in JSON (RFC 6901 - JSON Pointer).
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const override
+	{
+		return JsonScopeBase::GetPath() + path_separator + Convert::ToString(mIndex);
+	}
+
+	/// <summary>
+	/// Returns the exact number of items to load (for reserving the size of containers).
+	/// </summary>
+	[[nodiscard]] size_t GetEstimatedSize() const noexcept
+	{
+		return mSize;
+	}
+
+	/// <summary>
+	/// Returns `true` when all no more values to load.
+	/// </summary>
+	[[nodiscard]] bool IsEnd() const noexcept
+	{
+		return mIndex == mSize;
+	}
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		NextItem();
+		return LoadValue(mJsonReader, value);
+	}
+
+	template <typename TSym, typename TAllocator>
+	bool SerializeValue(std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		NextItem();
+		return LoadValue(mJsonReader, value);
+	}
+
+	/// <summary>
+	/// Reads the value as view to the input data, strings with escaped characters are decoded into the internal buffer
+	/// (the view is valid until the next reading).
+	/// </summary>
+	bool SerializeValue(std::string_view& value)
+	{
+		NextItem();
+		return mJsonReader->ReadValue(value);
+	}
+
+	std::optional<JsonReadObjectScope> OpenObjectScope();
+
+	std::optional<JsonReadArrayScope> OpenArrayScope(size_t)
+	{
+		NextItem();
+		if (size_t actualSize; mJsonReader->ReadArraySize(actualSize)) {
+			return std::make_optional<JsonReadArrayScope>(mJsonReader, actualSize, GetContext(), this);
+		}
+		return std::nullopt;
+	}
+
+private:
+	void NextItem()
+	{
+		if (mIndex == mSize) {
+			throw SerializationException(SerializationErrorCode::OutOfRange, "No more items to load");
+		}
+		++mIndex;
+	}
+
+	IJsonReader* mJsonReader;
+	size_t mSize;
+	size_t mIndex = 0;
+};
+
+
+/// <summary>
+/// JSON scope for reading objects (list of values with keys).
+/// Values are bound on demand: keys are searched starting from the last loaded one, so loading in the same order
+/// as they were saved does not require any lookups.
+/// </summary>
+class JsonReadObjectScope final : public TArchiveScope<SerializeMode::Load>, public JsonScopeBase
+{
+public:
+	JsonReadObjectScope(IJsonReader* jsonReader, size_t objectSize, SerializationContext& serializationContext,
+		const JsonScopeBase* parent = nullptr, std::string_view parentKey = {}) noexcept
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, JsonScopeBase(parent, parentKey)
+		, mJsonReader(jsonReader)
+		, mSize(objectSize)
+		, mStartPos(jsonReader->GetPosition())
+		, mFurthestPos(mStartPos)
+	{ }
+
+	~JsonReadObjectScope()
+	{
+		// Skip not loaded items, for continue reading from the end of object
+		UpdateFurthestPosition();
+		mJsonReader->SetPosition(mFurthestPos);
+		for (size_t i = mFurthestIndex; i < mSize; ++i)
+		{
+			mJsonReader->SkipValue();
+			mJsonReader->SkipValue();
+		}
+	}
+
+	/// <summary>
+	/// Constant iterator for keys.
+	/// </summary>
+	class key_const_iterator
+	{
+		friend class JsonReadObjectScope;
+
+		IJsonReader* mJsonReader;
+		size_t mPos;
+		size_t mIndex;
+
+		key_const_iterator(IJsonReader* jsonReader, size_t pos, size_t index) noexcept
+			: mJsonReader(jsonReader), mPos(pos), mIndex(index) { }
+
+	public:
+		bool operator==(const key_const_iterator& rhs) const noexcept {
+			return mIndex == rhs.mIndex;
+		}
+		bool operator!=(const key_const_iterator& rhs) const noexcept {
+			return mIndex != rhs.mIndex;
+		}
+
+		key_const_iterator& operator++() noexcept
+		{
+			const size_t currentPos = mJsonReader->GetPosition();
+			mJsonReader->SetPosition(mPos);
+			mJsonReader->SkipValue();
+			mJsonReader->SkipValue();
+			mPos = mJsonReader->GetPosition();
+			mJsonReader->SetPosition(currentPos);
+			++mIndex;
+			return *this;
+		}
+
+		key_type operator*() const
+		{
+			const size_t currentPos = mJsonReader->GetPosition();
+			mJsonReader->SetPosition(mPos);
+			std::string_view key;
+			mJsonReader->ReadKey(key);
+			mJsonReader->SetPosition(currentPos);
+			return key_type(key);
+		}
+	};
+
+	/// <summary>
+	/// Get the begin constant iterator of keys.
+	/// </summary>
+	[[nodiscard]] key_const_iterator cbegin() const noexcept {
+		return { mJsonReader, mStartPos, 0 };
+	}
+
+	/// <summary>
+	/// Get the end constant iterator of keys.
+	/// </summary>
+	[[nodiscard]] key_const_iterator cend() const noexcept {
+		return { mJsonReader, 0, mSize };
+	}
+
+	/// <summary>
+	/// Returns the exact number of items to load (for reserving the size of containers).
+	/// </summary>
+	[[nodiscard]] size_t GetEstimatedSize() const noexcept
+	{
+		return mSize;
+	}
+
+	template <typename TKey, typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(TKey&& key, T& value)
+	{
+		return FindValue(key) && LoadValue(mJsonReader, value);
+	}
+
+	template <typename TKey, typename TSym, typename TAllocator>
+	bool SerializeValue(TKey&& key, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		return FindValue(key) && LoadValue(mJsonReader, value);
+	}
+
+	/// <summary>
+	/// Reads the value as view to the input data, strings with escaped characters are decoded into the internal buffer
+	/// (the view is valid until the next reading).
+	/// </summary>
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, std::string_view& value)
+	{
+		return FindValue(key) && mJsonReader->ReadValue(value);
+	}
+
+	template <typename TKey>
+	std::optional<JsonReadObjectScope> OpenObjectScope(TKey&& key)
+	{
+		const std::string_view keyView(key);
+		if (size_t objectSize; FindValue(keyView) && mJsonReader->ReadObjectSize(objectSize)) {
+			return std::make_optional<JsonReadObjectScope>(mJsonReader, objectSize, GetContext(), this, keyView);
+		}
+		return std::nullopt;
+	}
+
+	template <typename TKey>
+	std::optional<JsonReadArrayScope> OpenArrayScope(TKey&& key, size_t)
+	{
+		const std::string_view keyView(key);
+		if (size_t actualSize; FindValue(keyView) && mJsonReader->ReadArraySize(actualSize)) {
+			return std::make_optional<JsonReadArrayScope>(mJsonReader, actualSize, GetContext(), this, keyView);
+		}
+		return std::nullopt;
+	}
+
+private:
+	/// <summary>
+	/// Finds the value by key, starts searching from the current position of reader (must point to the key).
+	/// When the key is found, the reader will be positioned on the value.
+	/// </summary>
+	bool FindValue(std::string_view key)
+	{
+		for (size_t i = 0; i < mSize; ++i)
+		{
+			UpdateFurthestPosition();
+			if (mNextIndex == mSize)
+			{
+				mNextIndex = 0;
+				mJsonReader->SetPosition(mStartPos);
+			}
+
+			++mNextIndex;
+			std::string_view currentKey;
+			mJsonReader->ReadKey(currentKey);
+			if (currentKey == key) {
+				return true;
+			}
+			mJsonReader->SkipValue();
+		}
+		return false;
+	}
+
+	void UpdateFurthestPosition() noexcept
+	{
+		if (mNextIndex > mFurthestIndex)
+		{
+			mFurthestIndex = mNextIndex;
+			mFurthestPos = mJsonReader->GetPosition();
+		}
+	}
+
+	IJsonReader* mJsonReader;
+	size_t mSize;
+	size_t mStartPos;
+	size_t mNextIndex = 0;
+	size_t mFurthestIndex = 0;
+	size_t mFurthestPos;
+};
+
+inline std::optional<JsonReadObjectScope> JsonReadArrayScope::OpenObjectScope()
+{
+	NextItem();
+	if (size_t objectSize; mJsonReader->ReadObjectSize(objectSize)) {
+		return std::make_optional<JsonReadObjectScope>(mJsonReader, objectSize, GetContext(), this);
+	}
+	return std::nullopt;
+}
+
+
+/// <summary>
+/// JSON root scope (can read value, array or object)
+/// </summary>
+class JsonReadRootScope final : public TArchiveScope<SerializeMode::Load>, public JsonScopeBase
+{
+public:
+	JsonReadRootScope(std::string_view inputData, SerializationContext& serializationContext);
+	JsonReadRootScope(std::istream& inputStream, SerializationContext& serializationContext);
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		return LoadValue(mJsonReader.get(), value);
+	}
+
+	template <typename TSym, typename TAllocator>
+	bool SerializeValue(std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		return LoadValue(mJsonReader.get(), value);
+	}
+
+	/// <summary>
+	/// Reads the value as view to the input data, strings with escaped characters are decoded into the internal buffer
+	/// (the view is valid until the next reading).
+	/// </summary>
+	bool SerializeValue(std::string_view& value)
+	{
+		return mJsonReader->ReadValue(value);
+	}
+
+	std::optional<JsonReadObjectScope> OpenObjectScope()
+	{
+		if (size_t objectSize; mJsonReader->ReadObjectSize(objectSize)) {
+			return std::make_optional<JsonReadObjectScope>(mJsonReader.get(), objectSize, GetContext());
+		}
+		return std::nullopt;
+	}
+
+	std::optional<JsonReadArrayScope> OpenArrayScope(size_t)
+	{
+		if (size_t actualSize; mJsonReader->ReadArraySize(actualSize)) {
+			return std::make_optional<JsonReadArrayScope>(mJsonReader.get(), actualSize, GetContext());
+		}
+		return std::nullopt;
+	}
+
+	void Finalize() const noexcept { /* Not required */ }
+
+private:
+	std::string mStreamData;
+	std::unique_ptr<IJsonReader> mJsonReader;
+};
+
+
+/// <summary>
+/// JSON Lines scope for reading the list of records (each record is parsed when it is requested).
+/// </summary>
+class JsonLinesReadArrayScope final : public TArchiveScope<SerializeMode::Load>, public JsonScopeBase
+{
+public:
+	JsonLinesReadArrayScope(IJsonLinesReader* jsonLinesReader, SerializationContext& serializationContext) noexcept
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mJsonLinesReader(jsonLinesReader)
+	{ }
+
+	/// <summary>
+	/// Gets the current path in JSON (RFC 6901 - JSON Pointer).
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const override
+	{
+		return JsonScopeBase::GetPath() + path_separator + Convert::ToString(mIndex);
+	}
+
+	/// <summary>
+	/// Returns the estimated number of items to load (the number of records is not known in advance).
+	/// </summary>
+	[[nodiscard]] size_t GetEstimatedSize() const noexcept
+	{
+		return 0;
+	}
+
+	/// <summary>
+	/// Returns `true` when there are no more records to load.
+	/// </summary>
+	[[nodiscard]] bool IsEnd() const
+	{
+		return mJsonLinesReader->IsEnd();
+	}
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		return LoadValue(NextRecord(), value);
+	}
+
+	template <typename TSym, typename TAllocator>
+	bool SerializeValue(std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		return LoadValue(NextRecord(), value);
+	}
+
+	/// <summary>
+	/// Reads the value as view to the input data, strings with escaped characters are decoded into the internal buffer
+	/// (the view is valid until the next reading).
+	/// </summary>
+	bool SerializeValue(std::string_view& value)
+	{
+		return NextRecord()->ReadValue(value);
+	}
+
+	std::optional<JsonReadObjectScope> OpenObjectScope()
+	{
+		IJsonReader* jsonReader = NextRecord();
+		if (size_t objectSize; jsonReader->ReadObjectSize(objectSize)) {
+			return std::make_optional<JsonReadObjectScope>(jsonReader, objectSize, GetContext(), this);
+		}
+		return std::nullopt;
+	}
+
+	std::optional<JsonReadArrayScope> OpenArrayScope(size_t)
+	{
+		IJsonReader* jsonReader = NextRecord();
+		if (size_t actualSize; jsonReader->ReadArraySize(actualSize)) {
+			return std::make_optional<JsonReadArrayScope>(jsonReader, actualSize, GetContext(), this);
+		}
+		return std::nullopt;
+	}
+
+private:
+	IJsonReader* NextRecord()
+	{
+		IJsonReader* jsonReader = mJsonLinesReader->ReadNextRecord();
+		++mIndex;
+		return jsonReader;
+	}
+
+	IJsonLinesReader* mJsonLinesReader;
+	size_t mIndex = 0;
+};
+
+
+/// <summary>
+/// JSON Lines root scope (can read only list of records, each of them must be on a separate line)
+/// </summary>
+class JsonLinesReadRootScope final : public TArchiveScope<SerializeMode::Load>, public JsonScopeBase
+{
+public:
+	JsonLinesReadRootScope(std::string_view inputData, SerializationContext& serializationContext);
+	JsonLinesReadRootScope(std::istream& inputStream, SerializationContext& serializationContext);
+
+	std::optional<JsonLinesReadArrayScope> OpenArrayScope(size_t)
+	{
+		return std::make_optional<JsonLinesReadArrayScope>(mJsonLinesReader.get(), GetContext());
+	}
+
+	void Finalize() const noexcept { /* Not required */ }
+
+private:
+	std::unique_ptr<IJsonLinesReader> mJsonLinesReader;
+};
+
+}
+
+
+/// <summary>
+/// JSON archive (internal implementation - no dependencies).
+/// The input is indexed by a vectorized scanner (SSE2 when available), values are bound on demand without building a DOM.
+/// Supports load/save from:
+/// - <c>std::string</c>: UTF-8
+/// - <c>std::istream</c> and <c>std::ostream</c>: UTF-8, UTF-16LE, UTF-16BE, UTF-32LE, UTF-32BE
+/// </summary>
+using JsonArchive = TArchiveBase<
+	Detail::JsonArchiveTraits,
+	Detail::JsonReadRootScope,
+	Detail::JsonWriteRootScope>;
+
+
+/// <summary>
+/// JSON Lines archive (also known as NDJSON), the root is a list of records which are separated by newlines.
+/// Records are parsed one by one when they are loaded (the stream is read by chunks), the line number of wrong record
+/// is reported in the <c>ParsingException</c>.
+/// Supports load/save from:
+/// - <c>std::string</c>: UTF-8
+/// - <c>std::istream</c> and <c>std::ostream</c>: UTF-8, UTF-16LE, UTF-16BE, UTF-32LE, UTF-32BE
+/// </summary>
+using JsonLinesArchive = TArchiveBase<
+	Detail::JsonArchiveTraits,
+	Detail::JsonLinesReadRootScope,
+	Detail::JsonLinesWriteRootScope>;
+
+}
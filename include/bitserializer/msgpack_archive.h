@@ -0,0 +1,848 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "bitserializer/serialization_detail/archive_base.h"
+#include "bitserializer/serialization_detail/archive_traits.h"
+#include "bitserializer/serialization_detail/errors_handling.h"
+
+
+namespace BitSerializer::MsgPack {
+namespace Detail {
+
+/// <summary>
+/// The traits of MessagePack archive (internal implementation - no dependencies)
+/// </summary>
+struct MsgPackArchiveTraits
+{
+	static constexpr ArchiveType archive_type = ArchiveType::MsgPack;
+	using key_type = std::string;
+	using supported_key_types = TSupportedKeyTypes<const char*, std::string_view, key_type>;
+	using preferred_output_format = std::basic_string<char, std::char_traits<char>>;
+	using preferred_stream_char_type = char;
+	static constexpr char path_separator = '/';
+
+protected:
+	~MsgPackArchiveTraits() = default;
+};
+
+class IMsgPackWriter
+{
+public:
+	virtual ~IMsgPackWriter() = default;
+
+	virtual void WriteNil() = 0;
+	virtual void WriteBoolean(bool value) = 0;
+	virtual void WriteSignedInteger(int64_t value) = 0;
+	virtual void WriteUnsignedInteger(uint64_t value) = 0;
+	virtual void WriteFloat(float value) = 0;
+	virtual void WriteDouble(double value) = 0;
+	virtual void WriteString(std::string_view value) = 0;
+	virtual void WriteBinary(const void* data, size_t size) = 0;
+	virtual void BeginArray(size_t arraySize) = 0;
+	virtual void EndArray(size_t actualSize) noexcept = 0;
+	virtual void BeginMap() = 0;
+	virtual void EndMap(size_t actualSize) noexcept = 0;
+	virtual void Flush() = 0;
+};
+
+class IMsgPackReader
+{
+public:
+	virtual ~IMsgPackReader() = default;
+
+	[[nodiscard]] virtual size_t GetPosition() const noexcept = 0;
+	virtual void SetPosition(size_t pos) noexcept = 0;
+	virtual bool ReadValue(std::nullptr_t& value) = 0;
+	virtual bool ReadValue(bool& value) = 0;
+	virtual bool ReadValue(uint8_t& value) = 0;
+	virtual bool ReadValue(uint16_t& value) = 0;
+	virtual bool ReadValue(uint32_t& value) = 0;
+	virtual bool ReadValue(uint64_t& value) = 0;
+	virtual bool ReadValue(int8_t& value) = 0;
+	virtual bool ReadValue(int16_t& value) = 0;
+	virtual bool ReadValue(int32_t& value) = 0;
+	virtual bool ReadValue(int64_t& value) = 0;
+	virtual bool ReadValue(float& value) = 0;
+	virtual bool ReadValue(double& value) = 0;
+	virtual bool ReadValue(std::string_view& value) = 0;
+	virtual bool ReadKey(std::string_view& key) noexcept = 0;
+	virtual bool ReadArraySize(size_t& arraySize, bool& isBinary) noexcept = 0;
+	virtual bool ReadMapSize(size_t& mapSize) noexcept = 0;
+	virtual void ReadBinary(void* data, size_t size) noexcept = 0;
+	virtual void SkipValue() noexcept = 0;
+};
+
+
+/// <summary>
+/// Base class of MessagePack scope
+/// </summary>
+class MsgPackScopeBase : public MsgPackArchiveTraits
+{
+public:
+	MsgPackScopeBase(const MsgPackScopeBase&) = delete;
+	MsgPackScopeBase& operator=(const MsgPackScopeBase&) = delete;
+
+	/// <summary>
+	/// Gets the current path in MessagePack (in the same format as JSON Pointer).
+	/// </summary>
+	[[nodiscard]] virtual std::string GetPath() const
+	{
+		const std::string localPath = mParentKey.empty()
+			? std::string()
+			: path_separator + std::string(mParentKey);
+		return mParent == nullptr ? localPath : mParent->GetPath() + localPath;
+	}
+
+protected:
+	explicit MsgPackScopeBase(const MsgPackScopeBase* parent = nullptr, std::string_view parentKey = {}) noexcept
+		: mParent(parent)
+		, mParentKey(parentKey)
+	{ }
+
+	~MsgPackScopeBase() = default;
+
+	/// <summary>
+	/// Integral type with fixed width which is used for reading value with type `T`.
+	/// </summary>
+	template <typename T>
+	using fixed_integral_t = std::conditional_t<std::is_signed_v<T>,
+		std::conditional_t<sizeof(T) == 1, int8_t, std::conditional_t<sizeof(T) == 2, int16_t, std::conditional_t<sizeof(T) == 4, int32_t, int64_t>>>,
+		std::conditional_t<sizeof(T) == 1, uint8_t, std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>>;
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	static bool LoadValue(IMsgPackReader* msgPackReader, T& value)
+	{
+		if constexpr (std::is_same_v<T, bool> || std::is_null_pointer_v<T> || std::is_same_v<T, float> || std::is_same_v<T, double>)
+		{
+			return msgPackReader->ReadValue(value);
+		}
+		else if constexpr (std::is_floating_point_v<T>)
+		{
+			double fixedValue;
+			if (msgPackReader->ReadValue(fixedValue))
+			{
+				value = static_cast<T>(fixedValue);
+				return true;
+			}
+			return false;
+		}
+		else
+		{
+			fixed_integral_t<T> fixedValue;
+			if (msgPackReader->ReadValue(fixedValue))
+			{
+				value = static_cast<T>(fixedValue);
+				return true;
+			}
+			return false;
+		}
+	}
+
+	template <typename TSym, typename TAllocator>
+	static bool LoadValue(IMsgPackReader* msgPackReader, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		if (std::string_view strValue; msgPackReader->ReadValue(strValue))
+		{
+			if constexpr (std::is_same_v<TSym, char>) {
+				value.assign(strValue.data(), strValue.size());
+			}
+			else {
+				value = Convert::To<std::basic_string<TSym, std::char_traits<TSym>, TAllocator>>(strValue);
+			}
+			return true;
+		}
+		return false;
+	}
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	static void SaveValue(IMsgPackWriter* msgPackWriter, const T& value)
+	{
+		if constexpr (std::is_null_pointer_v<T>) {
+			msgPackWriter->WriteNil();
+		}
+		else if constexpr (std::is_same_v<T, bool>) {
+			msgPackWriter->WriteBoolean(value);
+		}
+		else if constexpr (std::is_same_v<T, float>) {
+			msgPackWriter->WriteFloat(value);
+		}
+		else if constexpr (std::is_floating_point_v<T>) {
+			msgPackWriter->WriteDouble(static_cast<double>(value));
+		}
+		else if constexpr (std::is_signed_v<T>) {
+			msgPackWriter->WriteSignedInteger(value);
+		}
+		else {
+			msgPackWriter->WriteUnsignedInteger(value);
+		}
+	}
+
+	template <typename TSym, typename TAllocator>
+	static void SaveValue(IMsgPackWriter* msgPackWriter, const std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		if constexpr (std::is_same_v<TSym, char>) {
+			msgPackWriter->WriteString(std::string_view(value.data(), value.size()));
+		}
+		else {
+			msgPackWriter->WriteString(Convert::ToString(value));
+		}
+	}
+
+	const MsgPackScopeBase* mParent;
+	std::string_view mParentKey;
+};
+
+
+// Forward declarations
+class MsgPackWriteObjectScope;
+
+/// <summary>
+/// MessagePack scope for writing arrays (list of values without keys).
+/// </summary>
+class MsgPackWriteArrayScope final : public TArchiveScope<SerializeMode::Save>, public MsgPackScopeBase
+{
+public:
+	MsgPackWriteArrayScope(IMsgPackWriter* msgPackWriter, size_t arraySize, SerializationContext& serializationContext,
+		const MsgPackScopeBase* parent = nullptr, std::string_view parentKey = {})
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, MsgPackScopeBase(parent, parentKey)
+		, mMsgPackWriter(msgPackWriter)
+	{
+		mMsgPackWriter->BeginArray(arraySize);
+	}
+
+	~MsgPackWriteArrayScope()
+	{
+		mMsgPackWriter->EndArray(mIndex);
+	}
+
+	/// <summary>
+	/// Gets the current path in MessagePack (in the same format as JSON Pointer).
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const override
+	{
+		return MsgPackScopeBase::GetPath() + path_separator + Convert::ToString(mIndex);
+	}
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		SaveValue(mMsgPackWriter, value);
+		++mIndex;
+		return true;
+	}
+
+	template <typename TSym, typename TAllocator>
+	bool SerializeValue(std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		SaveValue(mMsgPackWriter, value);
+		++mIndex;
+		return true;
+	}
+
+	bool SerializeValue(std::string_view& value)
+	{
+		mMsgPackWriter->WriteString(value);
+		++mIndex;
+		return true;
+	}
+
+	/// <summary>
+	/// Writes the array of bytes as MessagePack binary (must be called before any other values).
+	/// </summary>
+	template <typename T, std::enable_if_t<is_binary_item_v<T>, int> = 0>
+	bool SerializeBlock(T* data, size_t size)
+	{
+		if (mIndex != 0)
+		{
+			for (size_t i = 0; i < size; ++i) {
+				SerializeValue(data[i]);
+			}
+			return true;
+		}
+		mMsgPackWriter->WriteBinary(data, size);
+		mIndex = size;
+		return true;
+	}
+
+	std::optional<MsgPackWriteObjectScope> OpenObjectScope();
+
+	std::optional<MsgPackWriteArrayScope> OpenArrayScope(size_t arraySize)
+	{
+		++mIndex;
+		return std::make_optional<MsgPackWriteArrayScope>(mMsgPackWriter, arraySize, GetContext(), this);
+	}
+
+private:
+	IMsgPackWriter* mMsgPackWriter;
+	size_t mIndex = 0;
+};
+
+
+/// <summary>
+/// MessagePack scope for writing objects (list of values with keys).
+/// </summary>
+class MsgPackWriteObjectScope final : public TArchiveScope<SerializeMode::Save>, public MsgPackScopeBase
+{
+public:
+	MsgPackWriteObjectScope(IMsgPackWriter* msgPackWriter, SerializationContext& serializationContext,
+		const MsgPackScopeBase* parent = nullptr, std::string_view parentKey = {})
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, MsgPackScopeBase(parent, parentKey)
+		, mMsgPackWriter(msgPackWriter)
+	{
+		mMsgPackWriter->BeginMap();
+	}
+
+	~MsgPackWriteObjectScope()
+	{
+		mMsgPackWriter->EndMap(mSize);
+	}
+
+	/// <summary>
+	/// Constant iterator for keys (saved keys are not accessible, so the range is always empty).
+	/// </summary>
+	class key_const_iterator
+	{
+	public:
+		bool operator==(const key_const_iterator&) const noexcept { return true; }
+		bool operator!=(const key_const_iterator&) const noexcept { return false; }
+		key_const_iterator& operator++() noexcept { return *this; }
+		key_type operator*() const { return {}; }
+	};
+
+	[[nodiscard]] key_const_iterator cbegin() const noexcept { return {}; }
+	[[nodiscard]] key_const_iterator cend() const noexcept { return {}; }
+
+	template <typename TKey, typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(TKey&& key, T& value)
+	{
+		WriteKey(key);
+		SaveValue(mMsgPackWriter, value);
+		return true;
+	}
+
+	template <typename TKey, typename TSym, typename TAllocator>
+	bool SerializeValue(TKey&& key, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		WriteKey(key);
+		SaveValue(mMsgPackWriter, value);
+		return true;
+	}
+
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, std::string_view& value)
+	{
+		WriteKey(key);
+		mMsgPackWriter->WriteString(value);
+		return true;
+	}
+
+	template <typename TKey>
+	std::optional<MsgPackWriteObjectScope> OpenObjectScope(TKey&& key)
+	{
+		const std::string_view keyView = WriteKey(key);
+		return std::make_optional<MsgPackWriteObjectScope>(mMsgPackWriter, GetContext(), this, keyView);
+	}
+
+	template <typename TKey>
+	std::optional<MsgPackWriteArrayScope> OpenArrayScope(TKey&& key, size_t arraySize)
+	{
+		const std::string_view keyView = WriteKey(key);
+		return std::make_optional<MsgPackWriteArrayScope>(mMsgPackWriter, arraySize, GetContext(), this, keyView);
+	}
+
+private:
+	template <typename TKey>
+	std::string_view WriteKey(const TKey& key)
+	{
+		const std::string_view keyView(key);
+		mMsgPackWriter->WriteString(keyView);
+		++mSize;
+		return keyView;
+	}
+
+	IMsgPackWriter* mMsgPackWriter;
+	size_t mSize = 0;
+};
+
+inline std::optional<MsgPackWriteObjectScope> MsgPackWriteArrayScope::OpenObjectScope()
+{
+	++mIndex;
+	return std::make_optional<MsgPackWriteObjectScope>(mMsgPackWriter, GetContext(), this);
+}
+
+
+/// <summary>
+/// MessagePack root scope (can write value, array or object)
+/// </summary>
+class MsgPackWriteRootScope final : public TArchiveScope<SerializeMode::Save>, public MsgPackScopeBase
+{
+public:
+	MsgPackWriteRootScope(std::string& outputData, SerializationContext& serializationContext);
+	MsgPackWriteRootScope(std::vector<uint8_t>& outputData, SerializationContext& serializationContext);
+	MsgPackWriteRootScope(std::ostream& outputStream, SerializationContext& serializationContext);
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		SaveValue(mMsgPackWriter.get(), value);
+		return true;
+	}
+
+	template <typename TSym, typename TAllocator>
+	bool SerializeValue(std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		SaveValue(mMsgPackWriter.get(), value);
+		return true;
+	}
+
+	bool SerializeValue(std::string_view& value)
+	{
+		mMsgPackWriter->WriteString(value);
+		return true;
+	}
+
+	std::optional<MsgPackWriteObjectScope> OpenObjectScope()
+	{
+		return std::make_optional<MsgPackWriteObjectScope>(mMsgPackWriter.get(), GetContext());
+	}
+
+	std::optional<MsgPackWriteArrayScope> OpenArrayScope(size_t arraySize)
+	{
+		return std::make_optional<MsgPackWriteArrayScope>(mMsgPackWriter.get(), arraySize, GetContext());
+	}
+
+	void Finalize()
+	{
+		mMsgPackWriter->Flush();
+	}
+
+private:
+	std::unique_ptr<IMsgPackWriter> mMsgPackWriter;
+};
+
+
+// Forward declarations
+class MsgPackReadObjectScope;
+
+/// <summary>
+/// MessagePack scope for reading arrays (list of values without keys).
+/// The binary type is also read as array, but it can be loaded only as block of bytes (via `SerializeBlock()`).
+/// </summary>
+class MsgPackReadArrayScope final : public TArchiveScope<SerializeMode::Load>, public MsgPackScopeBase
+{
+public:
+	MsgPackReadArrayScope(IMsgPackReader* msgPackReader, size_t arraySize, bool isBinary, SerializationContext& serializationContext,
+		const MsgPackScopeBase* parent = nullptr, std::string_view parentKey = {}) noexcept
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, MsgPackScopeBase(parent, parentKey)
+		, mMsgPackReader(msgPackReader)
+		, mSize(arraySize)
+		, mIsBinary(isBinary)
+	{ }
+
+	~MsgPackReadArrayScope()
+	{
+		// Skip not loaded items, for continue reading from the end of array
+		if (mIsBinary)
+		{
+			mMsgPackReader->SetPosition(mMsgPackReader->GetPosition() + mSize - mIndex);
+			return;
+		}
+		for (; mIndex < mSize; ++mIndex) {
+			mMsgPackReader->SkipValue();
+		}
+	}
+
+	/// <summary>
+	/// Gets the current path in MessagePack (in the same format as JSON Pointer).
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const override
+	{
+		return MsgPackScopeBase::GetPath() + path_separator + Convert::ToString(mIndex);
+	}
+
+	/// <summary>
+	/// Returns the exact number of items to load (for reserving the size of containers).
+	/// </summary>
+	[[nodiscard]] size_t GetEstimatedSize() const noexcept
+	{
+		return mSize;
+	}
+
+	/// <summary>
+	/// Returns `true` when all no more values to load.
+	/// </summary>
+	[[nodiscard]] bool IsEnd() const noexcept
+	{
+		return mIndex == mSize;
+	}
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		NextItem();
+		return !mIsBinary ? LoadValue(mMsgPackReader, value) : HandleBinaryItem();
+	}
+
+	template <typename TSym, typename TAllocator>
+	bool SerializeValue(std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		NextItem();
+		return !mIsBinary ? LoadValue(mMsgPackReader, value) : HandleBinaryItem();
+	}
+
+	/// <summary>
+	/// Reads the value as view to the input data (valid until the archive is destroyed).
+	/// </summary>
+	bool SerializeValue(std::string_view& value)
+	{
+		NextItem();
+		return !mIsBinary ? mMsgPackReader->ReadValue(value) : HandleBinaryItem();
+	}
+
+	/// <summary>
+	/// Loads all bytes of array into the continuous block of memory.
+	/// The MessagePack binary is just copied, regular arrays are loaded item by item.
+	/// </summary>
+	template <typename T, std::enable_if_t<is_binary_item_v<T>, int> = 0>
+	bool SerializeBlock(T* data, size_t size)
+	{
+		if (mIndex != 0 || size != mSize)
+		{
+			throw SerializationException(SerializationErrorCode::OutOfRange,
+				"The size of target block does not match the number of loading items");
+		}
+		if (mIsBinary)
+		{
+			mMsgPackReader->ReadBinary(data, size);
+			mIndex = size;
+			return true;
+		}
+		for (size_t i = 0; i < size; ++i) {
+			SerializeValue(data[i]);
+		}
+		return true;
+	}
+
+	std::optional<MsgPackReadObjectScope> OpenObjectScope();
+
+	std::optional<MsgPackReadArrayScope> OpenArrayScope(size_t arraySize)
+	{
+		NextItem();
+		if (mIsBinary)
+		{
+			HandleBinaryItem();
+			return std::nullopt;
+		}
+		bool isBinary = false;
+		if (size_t actualSize; mMsgPackReader->ReadArraySize(actualSize, isBinary)) {
+			return std::make_optional<MsgPackReadArrayScope>(mMsgPackReader, actualSize, isBinary, GetContext(), this);
+		}
+		return std::nullopt;
+	}
+
+private:
+	void NextItem()
+	{
+		if (mIndex == mSize) {
+			throw SerializationException(SerializationErrorCode::OutOfRange, "No more items to load");
+		}
+		++mIndex;
+	}
+
+	/// <summary>
+	/// Skips the byte of binary which is requested as value of other type (binary can be loaded only as block of bytes).
+	/// </summary>
+	bool HandleBinaryItem()
+	{
+		mMsgPackReader->SetPosition(mMsgPackReader->GetPosition() + 1);
+		if (GetOptions().mismatchedTypesPolicy == MismatchedTypesPolicy::ThrowError)
+		{
+			throw SerializationException(SerializationErrorCode::MismatchedTypes,
+				"The binary data can be loaded only into the container of bytes");
+		}
+		return false;
+	}
+
+	IMsgPackReader* mMsgPackReader;
+	size_t mSize;
+	size_t mIndex = 0;
+	bool mIsBinary;
+};
+
+
+/// <summary>
+/// MessagePack scope for reading objects (list of values with keys).
+/// Values are searched starting from the last loaded one, so loading in the same order as they were saved does not require any lookups.
+/// </summary>
+class MsgPackReadObjectScope final : public TArchiveScope<SerializeMode::Load>, public MsgPackScopeBase
+{
+public:
+	MsgPackReadObjectScope(IMsgPackReader* msgPackReader, size_t mapSize, SerializationContext& serializationContext,
+		const MsgPackScopeBase* parent = nullptr, std::string_view parentKey = {}) noexcept
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, MsgPackScopeBase(parent, parentKey)
+		, mMsgPackReader(msgPackReader)
+		, mSize(mapSize)
+		, mStartPos(msgPackReader->GetPosition())
+		, mFurthestPos(mStartPos)
+	{ }
+
+	~MsgPackReadObjectScope()
+	{
+		// Skip not loaded items, for continue reading from the end of map
+		UpdateFurthestPosition();
+		mMsgPackReader->SetPosition(mFurthestPos);
+		for (size_t i = mFurthestIndex; i < mSize; ++i)
+		{
+			mMsgPackReader->SkipValue();
+			mMsgPackReader->SkipValue();
+		}
+	}
+
+	/// <summary>
+	/// Constant iterator for keys.
+	/// </summary>
+	class key_const_iterator
+	{
+		friend class MsgPackReadObjectScope;
+
+		IMsgPackReader* mMsgPackReader;
+		size_t mPos;
+		size_t mIndex;
+
+		key_const_iterator(IMsgPackReader* msgPackReader, size_t pos, size_t index) noexcept
+			: mMsgPackReader(msgPackReader), mPos(pos), mIndex(index) { }
+
+	public:
+		bool operator==(const key_const_iterator& rhs) const noexcept {
+			return mIndex == rhs.mIndex;
+		}
+		bool operator!=(const key_const_iterator& rhs) const noexcept {
+			return mIndex != rhs.mIndex;
+		}
+
+		key_const_iterator& operator++() noexcept
+		{
+			const size_t currentPos = mMsgPackReader->GetPosition();
+			mMsgPackReader->SetPosition(mPos);
+			mMsgPackReader->SkipValue();
+			mMsgPackReader->SkipValue();
+			mPos = mMsgPackReader->GetPosition();
+			mMsgPackReader->SetPosition(currentPos);
+			++mIndex;
+			return *this;
+		}
+
+		key_type operator*() const
+		{
+			const size_t currentPos = mMsgPackReader->GetPosition();
+			mMsgPackReader->SetPosition(mPos);
+			std::string_view key;
+			mMsgPackReader->ReadKey(key);
+			mMsgPackReader->SetPosition(currentPos);
+			return key_type(key);
+		}
+	};
+
+	/// <summary>
+	/// Get the begin constant iterator of keys.
+	/// </summary>
+	[[nodiscard]] key_const_iterator cbegin() const noexcept {
+		return { mMsgPackReader, mStartPos, 0 };
+	}
+
+	/// <summary>
+	/// Get the end constant iterator of keys.
+	/// </summary>
+	[[nodiscard]] key_const_iterator cend() const noexcept {
+		return { mMsgPackReader, 0, mSize };
+	}
+
+	/// <summary>
+	/// Returns the exact number of items to load (for reserving the size of containers).
+	/// </summary>
+	[[nodiscard]] size_t GetEstimatedSize() const noexcept
+	{
+		return mSize;
+	}
+
+	template <typename TKey, typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(TKey&& key, T& value)
+	{
+		return FindValue(key) && LoadValue(mMsgPackReader, value);
+	}
+
+	template <typename TKey, typename TSym, typename TAllocator>
+	bool SerializeValue(TKey&& key, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		return FindValue(key) && LoadValue(mMsgPackReader, value);
+	}
+
+	/// <summary>
+	/// Reads the value as view to the input data (valid until the archive is destroyed).
+	/// </summary>
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, std::string_view& value)
+	{
+		return FindValue(key) && mMsgPackReader->ReadValue(value);
+	}
+
+	template <typename TKey>
+	std::optional<MsgPackReadObjectScope> OpenObjectScope(TKey&& key)
+	{
+		const std::string_view keyView(key);
+		if (size_t mapSize; FindValue(keyView) && mMsgPackReader->ReadMapSize(mapSize)) {
+			return std::make_optional<MsgPackReadObjectScope>(mMsgPackReader, mapSize, GetContext(), this, keyView);
+		}
+		return std::nullopt;
+	}
+
+	template <typename TKey>
+	std::optional<MsgPackReadArrayScope> OpenArrayScope(TKey&& key, size_t arraySize)
+	{
+		const std::string_view keyView(key);
+		bool isBinary = false;
+		if (size_t actualSize; FindValue(keyView) && mMsgPackReader->ReadArraySize(actualSize, isBinary)) {
+			return std::make_optional<MsgPackReadArrayScope>(mMsgPackReader, actualSize, isBinary, GetContext(), this, keyView);
+		}
+		return std::nullopt;
+	}
+
+private:
+	/// <summary>
+	/// Finds the value by key, starts searching from the current position of reader (must point to the key).
+	/// When the key is found, the reader will be positioned on the value.
+	/// </summary>
+	bool FindValue(std::string_view key) noexcept
+	{
+		for (size_t i = 0; i < mSize; ++i)
+		{
+			UpdateFurthestPosition();
+			if (mNextIndex == mSize)
+			{
+				mNextIndex = 0;
+				mMsgPackReader->SetPosition(mStartPos);
+			}
+
+			++mNextIndex;
+			if (std::string_view currentKey; mMsgPackReader->ReadKey(currentKey) && currentKey == key) {
+				return true;
+			}
+			mMsgPackReader->SkipValue();
+		}
+		return false;
+	}
+
+	void UpdateFurthestPosition() noexcept
+	{
+		if (mNextIndex > mFurthestIndex)
+		{
+			mFurthestIndex = mNextIndex;
+			mFurthestPos = mMsgPackReader->GetPosition();
+		}
+	}
+
+	IMsgPackReader* mMsgPackReader;
+	size_t mSize;
+	size_t mStartPos;
+	size_t mNextIndex = 0;
+	size_t mFurthestIndex = 0;
+	size_t mFurthestPos;
+};
+
+inline std::optional<MsgPackReadObjectScope> MsgPackReadArrayScope::OpenObjectScope()
+{
+	NextItem();
+	if (mIsBinary)
+	{
+		HandleBinaryItem();
+		return std::nullopt;
+	}
+	if (size_t mapSize; mMsgPackReader->ReadMapSize(mapSize)) {
+		return std::make_optional<MsgPackReadObjectScope>(mMsgPackReader, mapSize, GetContext(), this);
+	}
+	return std::nullopt;
+}
+
+
+/// <summary>
+/// MessagePack root scope (can read value, array or object)
+/// </summary>
+class MsgPackReadRootScope final : public TArchiveScope<SerializeMode::Load>, public MsgPackScopeBase
+{
+public:
+	MsgPackReadRootScope(std::string_view inputData, SerializationContext& serializationContext);
+	MsgPackReadRootScope(const std::vector<uint8_t>& inputData, SerializationContext& serializationContext);
+	MsgPackReadRootScope(std::istream& inputStream, SerializationContext& serializationContext);
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		return LoadValue(mMsgPackReader.get(), value);
+	}
+
+	template <typename TSym, typename TAllocator>
+	bool SerializeValue(std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		return LoadValue(mMsgPackReader.get(), value);
+	}
+
+	/// <summary>
+	/// Reads the value as view to the input data (valid until the archive is destroyed).
+	/// </summary>
+	bool SerializeValue(std::string_view& value)
+	{
+		return mMsgPackReader->ReadValue(value);
+	}
+
+	std::optional<MsgPackReadObjectScope> OpenObjectScope()
+	{
+		if (size_t mapSize; mMsgPackReader->ReadMapSize(mapSize)) {
+			return std::make_optional<MsgPackReadObjectScope>(mMsgPackReader.get(), mapSize, GetContext());
+		}
+		return std::nullopt;
+	}
+
+	std::optional<MsgPackReadArrayScope> OpenArrayScope(size_t arraySize)
+	{
+		bool isBinary = false;
+		if (size_t actualSize; mMsgPackReader->ReadArraySize(actualSize, isBinary)) {
+			return std::make_optional<MsgPackReadArrayScope>(mMsgPackReader.get(), actualSize, isBinary, GetContext());
+		}
+		return std::nullopt;
+	}
+
+	void Finalize() const noexcept { /* Not required */ }
+
+private:
+	std::string mStreamData;
+	std::unique_ptr<IMsgPackReader> mMsgPackReader;
+};
+
+}
+
+
+/// <summary>
+/// MessagePack archive (internal implementation - no dependencies).
+/// Supports load/save from:
+/// - <c>std::string</c>: binary data
+/// - <c>std::vector&lt;uint8_t&gt;</c>: binary data
+/// - <c>std::istream</c> and <c>std::ostream</c>: binary data
+/// </summary>
+using MsgPackArchive = TArchiveBase<
+	Detail::MsgPackArchiveTraits,
+	Detail::MsgPackReadRootScope,
+	Detail::MsgPackWriteRootScope>;
+
+}
@@ -0,0 +1,933 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "bitserializer/serialization_detail/archive_base.h"
+#include "bitserializer/serialization_detail/archive_traits.h"
+#include "bitserializer/serialization_detail/archive_helpers.h"
+#include "bitserializer/serialization_detail/bin_timestamp.h"
+#include "bitserializer/serialization_detail/errors_handling.h"
+
+
+namespace BitSerializer::Protobuf {
+namespace Detail {
+
+using BitSerializer::Detail::CBinTimestamp;
+
+/// <summary>
+/// The traits of Protobuf archive (internal implementation - no dependencies).
+/// Keys are numbers of fields (tags) as they are declared in the `.proto` file.
+/// </summary>
+struct ProtobufArchiveTraits
+{
+	static constexpr ArchiveType archive_type = ArchiveType::Protobuf;
+	using key_type = uint32_t;
+	using supported_key_types = TSupportedKeyTypes<key_type>;
+	using preferred_output_format = std::basic_string<char, std::char_traits<char>>;
+	using preferred_stream_char_type = char;
+	static constexpr char path_separator = '/';
+
+protected:
+	~ProtobufArchiveTraits() = default;
+};
+
+/// <summary>
+/// Wire types of Protobuf fields (groups are deprecated and not supported).
+/// </summary>
+enum class WireType : uint8_t
+{
+	VarInt = 0,
+	Fixed64 = 1,
+	LengthDelimited = 2,
+	StartGroup = 3,
+	EndGroup = 4,
+	Fixed32 = 5
+};
+
+/// <summary>
+/// Types of numbers in blocks (packed repeated fields).
+/// </summary>
+enum class ProtobufNumberType : uint8_t
+{
+	Int8,
+	UInt8,
+	Int16,
+	UInt16,
+	Int32,
+	UInt32,
+	Int64,
+	UInt64,
+	Float,
+	Double
+};
+
+/// <summary>
+/// Returns the type of number with fixed width (`int8_t` ... `uint64_t`, `float` or `double`).
+/// </summary>
+template <typename T>
+constexpr ProtobufNumberType GetNumberType() noexcept
+{
+	if constexpr (std::is_same_v<T, float>) {
+		return ProtobufNumberType::Float;
+	}
+	else if constexpr (std::is_floating_point_v<T>) {
+		return ProtobufNumberType::Double;
+	}
+	else if constexpr (sizeof(T) == 1) {
+		return std::is_signed_v<T> ? ProtobufNumberType::Int8 : ProtobufNumberType::UInt8;
+	}
+	else if constexpr (sizeof(T) == 2) {
+		return std::is_signed_v<T> ? ProtobufNumberType::Int16 : ProtobufNumberType::UInt16;
+	}
+	else if constexpr (sizeof(T) == 4) {
+		return std::is_signed_v<T> ? ProtobufNumberType::Int32 : ProtobufNumberType::UInt32;
+	}
+	else {
+		return std::is_signed_v<T> ? ProtobufNumberType::Int64 : ProtobufNumberType::UInt64;
+	}
+}
+
+/// <summary>
+/// Returns the wire type of items in packed repeated field (`float` and `double` are fixed, all integers are varints).
+/// </summary>
+template <typename T>
+constexpr WireType GetPackedWireType() noexcept
+{
+	if constexpr (std::is_same_v<T, float>) {
+		return WireType::Fixed32;
+	}
+	else if constexpr (std::is_floating_point_v<T>) {
+		return WireType::Fixed64;
+	}
+	else {
+		return WireType::VarInt;
+	}
+}
+
+using BitSerializer::Detail::ZigZagEncode;
+using BitSerializer::Detail::ZigZagDecode;
+
+/// <summary>
+/// The field of Protobuf message (or item of packed repeated field).
+/// </summary>
+struct CProtobufField
+{
+	uint32_t Number = 0;
+	WireType Type = WireType::VarInt;
+	// Value of varint and fixed fields
+	uint64_t Value = 0;
+	// Payload of length-delimited field (string, embedded message or packed repeated field)
+	std::string_view Data;
+};
+
+class IProtobufWriter
+{
+public:
+	virtual ~IProtobufWriter() = default;
+
+	virtual void WriteVarInt(uint32_t fieldNumber, uint64_t value) = 0;
+	virtual void WriteFixed32(uint32_t fieldNumber, uint32_t value) = 0;
+	virtual void WriteFixed64(uint32_t fieldNumber, uint64_t value) = 0;
+	virtual void WriteBytes(uint32_t fieldNumber, std::string_view value) = 0;
+	virtual void WriteTimestamp(uint32_t fieldNumber, const CBinTimestamp& timestamp) = 0;
+	virtual void WritePackedBlock(uint32_t fieldNumber, ProtobufNumberType itemType, const void* data, size_t size) = 0;
+	virtual void WritePackedItem(WireType itemType, uint64_t value) = 0;
+	virtual void BeginLengthDelimited(uint32_t fieldNumber) = 0;
+	virtual void EndLengthDelimited() = 0;
+	virtual void Flush() = 0;
+};
+
+class IProtobufReader
+{
+public:
+	virtual ~IProtobufReader() = default;
+
+	/// <summary>
+	/// Parses all fields of the message and appends them to the list (malformed message causes `ParsingException`).
+	/// </summary>
+	virtual void ReadMessage(std::string_view messageData, std::vector<CProtobufField>& fields) = 0;
+	/// <summary>
+	/// Reads the next item from the data of packed repeated field.
+	/// </summary>
+	virtual void ReadPackedItem(std::string_view& packedData, WireType itemType, CProtobufField& item) = 0;
+	virtual bool ReadValue(const CProtobufField& field, std::nullptr_t& value) = 0;
+	virtual bool ReadValue(const CProtobufField& field, bool& value) = 0;
+	virtual bool ReadValue(const CProtobufField& field, uint8_t& value) = 0;
+	virtual bool ReadValue(const CProtobufField& field, uint16_t& value) = 0;
+	virtual bool ReadValue(const CProtobufField& field, uint32_t& value) = 0;
+	virtual bool ReadValue(const CProtobufField& field, uint64_t& value) = 0;
+	virtual bool ReadValue(const CProtobufField& field, int8_t& value) = 0;
+	virtual bool ReadValue(const CProtobufField& field, int16_t& value) = 0;
+	virtual bool ReadValue(const CProtobufField& field, int32_t& value) = 0;
+	virtual bool ReadValue(const CProtobufField& field, int64_t& value) = 0;
+	virtual bool ReadValue(const CProtobufField& field, float& value) = 0;
+	virtual bool ReadValue(const CProtobufField& field, double& value) = 0;
+	virtual bool ReadValue(const CProtobufField& field, std::string_view& value) = 0;
+	virtual bool ReadValue(const CProtobufField& field, CBinTimestamp& timestamp) = 0;
+};
+
+
+/// <summary>
+/// Base class of Protobuf scope
+/// </summary>
+class ProtobufScopeBase : public ProtobufArchiveTraits
+{
+public:
+	ProtobufScopeBase(const ProtobufScopeBase&) = delete;
+	ProtobufScopeBase& operator=(const ProtobufScopeBase&) = delete;
+
+	/// <summary>
+	/// Gets the current path in Protobuf message (numbers of fields separated by '/').
+	/// </summary>
+	[[nodiscard]] virtual std::string GetPath() const
+	{
+		const std::string localPath = mParentKey == 0
+			? std::string()
+			: path_separator + Convert::ToString(mParentKey);
+		return mParent == nullptr ? localPath : mParent->GetPath() + localPath;
+	}
+
+protected:
+	explicit ProtobufScopeBase(const ProtobufScopeBase* parent = nullptr, key_type parentKey = 0) noexcept
+		: mParent(parent)
+		, mParentKey(parentKey)
+	{ }
+
+	~ProtobufScopeBase() = default;
+
+	/// <summary>
+	/// Number type with fixed width which is used for loading value with type `T`.
+	/// </summary>
+	template <typename T>
+	using fixed_number_t = std::conditional_t<std::is_floating_point_v<T>,
+		std::conditional_t<std::is_same_v<T, float>, float, double>,
+		std::conditional_t<std::is_signed_v<T>,
+			std::conditional_t<sizeof(T) == 1, int8_t, std::conditional_t<sizeof(T) == 2, int16_t, std::conditional_t<sizeof(T) == 4, int32_t, int64_t>>>,
+			std::conditional_t<sizeof(T) == 1, uint8_t, std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>>>;
+
+	/// <summary>
+	/// Converts the number to the raw value of field: booleans and unsigned integers as is, signed integers in the ZigZag encoding
+	/// (like `sint32` and `sint64`), floating point numbers as bits.
+	/// </summary>
+	template <typename T>
+	static uint64_t ToWireValue(const T& value) noexcept
+	{
+		if constexpr (std::is_same_v<T, bool>) {
+			return value ? 1 : 0;
+		}
+		else if constexpr (std::is_same_v<T, float>)
+		{
+			uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return bits;
+		}
+		else if constexpr (std::is_floating_point_v<T>)
+		{
+			const auto doubleValue = static_cast<double>(value);
+			uint64_t bits;
+			std::memcpy(&bits, &doubleValue, sizeof(bits));
+			return bits;
+		}
+		else if constexpr (std::is_signed_v<T>) {
+			return ZigZagEncode(static_cast<int64_t>(value));
+		}
+		else {
+			return static_cast<uint64_t>(value);
+		}
+	}
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	static bool LoadValue(IProtobufReader* protobufReader, const CProtobufField& field, T& value)
+	{
+		if constexpr (std::is_same_v<T, bool> || std::is_null_pointer_v<T>)
+		{
+			return protobufReader->ReadValue(field, value);
+		}
+		else
+		{
+			fixed_number_t<T> fixedValue;
+			if (protobufReader->ReadValue(field, fixedValue))
+			{
+				value = static_cast<T>(fixedValue);
+				return true;
+			}
+			return false;
+		}
+	}
+
+	template <typename TSym, typename TAllocator>
+	static bool LoadValue(IProtobufReader* protobufReader, const CProtobufField& field, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		if (std::string_view strValue; protobufReader->ReadValue(field, strValue))
+		{
+			if constexpr (std::is_same_v<TSym, char>) {
+				value.assign(strValue.data(), strValue.size());
+			}
+			else {
+				value = Convert::To<std::basic_string<TSym, std::char_traits<TSym>, TAllocator>>(strValue);
+			}
+			return true;
+		}
+		return false;
+	}
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	static void SaveValue(IProtobufWriter* protobufWriter, key_type fieldNumber, const T& value)
+	{
+		if constexpr (std::is_null_pointer_v<T>) {
+			// Null value is represented by the absence of field
+		}
+		else if constexpr (std::is_same_v<T, float>) {
+			protobufWriter->WriteFixed32(fieldNumber, static_cast<uint32_t>(ToWireValue(value)));
+		}
+		else if constexpr (std::is_floating_point_v<T>) {
+			protobufWriter->WriteFixed64(fieldNumber, ToWireValue(value));
+		}
+		else {
+			protobufWriter->WriteVarInt(fieldNumber, ToWireValue(value));
+		}
+	}
+
+	template <typename TSym, typename TAllocator>
+	static void SaveValue(IProtobufWriter* protobufWriter, key_type fieldNumber, const std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		if constexpr (std::is_same_v<TSym, char>) {
+			protobufWriter->WriteBytes(fieldNumber, std::string_view(value.data(), value.size()));
+		}
+		else {
+			protobufWriter->WriteBytes(fieldNumber, Convert::ToString(value));
+		}
+	}
+
+	const ProtobufScopeBase* mParent;
+	key_type mParentKey;
+};
+
+
+// Forward declarations
+class ProtobufWriteObjectScope;
+
+/// <summary>
+/// Protobuf scope for writing repeated fields.
+/// Numbers are written as packed repeated field, strings and objects as separate fields with the same number.
+/// </summary>
+class ProtobufWriteArrayScope final : public TArchiveScope<SerializeMode::Save>, public ProtobufScopeBase
+{
+public:
+	ProtobufWriteArrayScope(IProtobufWriter* protobufWriter, SerializationContext& serializationContext,
+		const ProtobufScopeBase* parent, key_type fieldNumber)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, ProtobufScopeBase(parent, fieldNumber)
+		, mProtobufWriter(protobufWriter)
+	{ }
+
+	~ProtobufWriteArrayScope()
+	{
+		EndPacked();
+	}
+
+	/// <summary>
+	/// Gets the current path in Protobuf message (numbers of fields separated by '/').
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const override
+	{
+		return ProtobufScopeBase::GetPath() + path_separator + Convert::ToString(mIndex);
+	}
+
+	template <typename T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		if (!mIsPacked)
+		{
+			mProtobufWriter->BeginLengthDelimited(mParentKey);
+			mIsPacked = true;
+		}
+		mProtobufWriter->WritePackedItem(GetPackedWireType<T>(), ToWireValue(value));
+		++mIndex;
+		return true;
+	}
+
+	template <typename TSym, typename TAllocator>
+	bool SerializeValue(std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		EndPacked();
+		SaveValue(mProtobufWriter, mParentKey, value);
+		++mIndex;
+		return true;
+	}
+
+	bool SerializeValue(std::string_view& value)
+	{
+		EndPacked();
+		mProtobufWriter->WriteBytes(mParentKey, value);
+		++mIndex;
+		return true;
+	}
+
+	bool SerializeValue(CBinTimestamp& timestamp)
+	{
+		EndPacked();
+		mProtobufWriter->WriteTimestamp(mParentKey, timestamp);
+		++mIndex;
+		return true;
+	}
+
+	/// <summary>
+	/// Writes the continuous block of numbers as packed repeated field (the size of field is calculated before writing items).
+	/// </summary>
+	template <typename T, std::enable_if_t<is_block_item_v<T>, int> = 0>
+	bool SerializeBlock(T* data, size_t size)
+	{
+		EndPacked();
+		if (size != 0) {
+			mProtobufWriter->WritePackedBlock(mParentKey, GetNumberType<fixed_number_t<T>>(), data, size);
+		}
+		mIndex += size;
+		return true;
+	}
+
+	std::optional<ProtobufWriteObjectScope> OpenObjectScope();
+
+private:
+	void EndPacked()
+	{
+		if (mIsPacked)
+		{
+			mProtobufWriter->EndLengthDelimited();
+			mIsPacked = false;
+		}
+	}
+
+	IProtobufWriter* mProtobufWriter;
+	size_t mIndex = 0;
+	bool mIsPacked = false;
+};
+
+
+/// <summary>
+/// Protobuf scope for writing messages (fields with numbers).
+/// </summary>
+class ProtobufWriteObjectScope final : public TArchiveScope<SerializeMode::Save>, public ProtobufScopeBase
+{
+public:
+	/// <summary>
+	/// Opens the embedded message as field with passed number (or the root message when the number is zero).
+	/// </summary>
+	ProtobufWriteObjectScope(IProtobufWriter* protobufWriter, key_type fieldNumber, SerializationContext& serializationContext,
+		const ProtobufScopeBase* parent = nullptr, key_type parentKey = 0)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, ProtobufScopeBase(parent, parentKey)
+		, mProtobufWriter(protobufWriter)
+		, mIsEmbedded(fieldNumber != 0)
+	{
+		if (mIsEmbedded) {
+			mProtobufWriter->BeginLengthDelimited(fieldNumber);
+		}
+	}
+
+	~ProtobufWriteObjectScope()
+	{
+		if (mIsEmbedded) {
+			mProtobufWriter->EndLengthDelimited();
+		}
+	}
+
+	/// <summary>
+	/// Constant iterator for keys (saved keys are not accessible, so the range is always empty).
+	/// </summary>
+	class key_const_iterator
+	{
+	public:
+		bool operator==(const key_const_iterator&) const noexcept { return true; }
+		bool operator!=(const key_const_iterator&) const noexcept { return false; }
+		key_const_iterator& operator++() noexcept { return *this; }
+		key_type operator*() const { return {}; }
+	};
+
+	[[nodiscard]] key_const_iterator cbegin() const noexcept { return {}; }
+	[[nodiscard]] key_const_iterator cend() const noexcept { return {}; }
+
+	template <typename TKey, typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(TKey&& key, T& value)
+	{
+		SaveValue(mProtobufWriter, static_cast<key_type>(key), value);
+		return true;
+	}
+
+	template <typename TKey, typename TSym, typename TAllocator>
+	bool SerializeValue(TKey&& key, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		SaveValue(mProtobufWriter, static_cast<key_type>(key), value);
+		return true;
+	}
+
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, std::string_view& value)
+	{
+		mProtobufWriter->WriteBytes(static_cast<key_type>(key), value);
+		return true;
+	}
+
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, CBinTimestamp& timestamp)
+	{
+		mProtobufWriter->WriteTimestamp(static_cast<key_type>(key), timestamp);
+		return true;
+	}
+
+	template <typename TKey>
+	std::optional<ProtobufWriteObjectScope> OpenObjectScope(TKey&& key)
+	{
+		const auto fieldNumber = static_cast<key_type>(key);
+		return std::make_optional<ProtobufWriteObjectScope>(mProtobufWriter, fieldNumber, GetContext(), this, fieldNumber);
+	}
+
+	template <typename TKey>
+	std::optional<ProtobufWriteArrayScope> OpenArrayScope(TKey&& key, size_t)
+	{
+		return std::make_optional<ProtobufWriteArrayScope>(mProtobufWriter, GetContext(), this, static_cast<key_type>(key));
+	}
+
+private:
+	IProtobufWriter* mProtobufWriter;
+	bool mIsEmbedded;
+};
+
+inline std::optional<ProtobufWriteObjectScope> ProtobufWriteArrayScope::OpenObjectScope()
+{
+	EndPacked();
+	++mIndex;
+	return std::make_optional<ProtobufWriteObjectScope>(mProtobufWriter, mParentKey, GetContext(), this);
+}
+
+
+/// <summary>
+/// Protobuf root scope (the root of Protobuf data is always a message)
+/// </summary>
+class ProtobufWriteRootScope final : public TArchiveScope<SerializeMode::Save>, public ProtobufScopeBase
+{
+public:
+	ProtobufWriteRootScope(std::string& outputData, SerializationContext& serializationContext);
+	ProtobufWriteRootScope(std::vector<uint8_t>& outputData, SerializationContext& serializationContext);
+	ProtobufWriteRootScope(std::ostream& outputStream, SerializationContext& serializationContext);
+
+	std::optional<ProtobufWriteObjectScope> OpenObjectScope()
+	{
+		return std::make_optional<ProtobufWriteObjectScope>(mProtobufWriter.get(), 0, GetContext());
+	}
+
+	void Finalize()
+	{
+		mProtobufWriter->Flush();
+	}
+
+private:
+	std::unique_ptr<IProtobufWriter> mProtobufWriter;
+};
+
+
+// Forward declarations
+class ProtobufReadObjectScope;
+
+/// <summary>
+/// Protobuf scope for reading repeated fields (all fields with the same number in the message).
+/// Items of packed repeated fields are decoded one by one directly from the input data.
+/// </summary>
+class ProtobufReadArrayScope final : public TArchiveScope<SerializeMode::Load>, public ProtobufScopeBase
+{
+public:
+	/// <summary>
+	/// Constructs the scope for fields which are placed at the end of list (from the passed index), they are removed when the scope is destroyed.
+	/// </summary>
+	ProtobufReadArrayScope(IProtobufReader* protobufReader, std::vector<CProtobufField>* fields, size_t startIndex,
+		SerializationContext& serializationContext, const ProtobufScopeBase* parent, key_type fieldNumber) noexcept
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, ProtobufScopeBase(parent, fieldNumber)
+		, mProtobufReader(protobufReader)
+		, mFields(fields)
+		, mStartIndex(startIndex)
+		, mEndIndex(fields->size())
+		, mNextIndex(startIndex)
+	{ }
+
+	~ProtobufReadArrayScope()
+	{
+		mFields->resize(mStartIndex);
+	}
+
+	/// <summary>
+	/// Gets the current path in Protobuf message (numbers of fields separated by '/').
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const override
+	{
+		return ProtobufScopeBase::GetPath() + path_separator + Convert::ToString(mIndex);
+	}
+
+	/// <summary>
+	/// Returns the number of fields (the real number of items may be bigger, when numbers are packed).
+	/// </summary>
+	[[nodiscard]] size_t GetEstimatedSize() const noexcept
+	{
+		return mEndIndex - mStartIndex;
+	}
+
+	/// <summary>
+	/// Returns `true` when all no more values to load.
+	/// </summary>
+	[[nodiscard]] bool IsEnd() const noexcept
+	{
+		return mNextIndex == mEndIndex && mPackedData.empty();
+	}
+
+	template <typename T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		while (mPackedData.empty())
+		{
+			const CProtobufField& field = NextField();
+			if (field.Type != WireType::LengthDelimited)
+			{
+				// Not packed item
+				return LoadValue(mProtobufReader, field, value);
+			}
+			mPackedData = field.Data;
+		}
+
+		CProtobufField item;
+		item.Number = mParentKey;
+		mProtobufReader->ReadPackedItem(mPackedData, GetPackedWireType<T>(), item);
+		++mIndex;
+		return LoadValue(mProtobufReader, item, value);
+	}
+
+	template <typename TSym, typename TAllocator>
+	bool SerializeValue(std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		return LoadValue(mProtobufReader, NextField(), value);
+	}
+
+	/// <summary>
+	/// Reads the value as view to the input data (valid until the archive is destroyed).
+	/// </summary>
+	bool SerializeValue(std::string_view& value)
+	{
+		return mProtobufReader->ReadValue(NextField(), value);
+	}
+
+	bool SerializeValue(CBinTimestamp& timestamp)
+	{
+		return mProtobufReader->ReadValue(NextField(), timestamp);
+	}
+
+	std::optional<ProtobufReadObjectScope> OpenObjectScope();
+
+private:
+	const CProtobufField& NextField()
+	{
+		if (mNextIndex == mEndIndex) {
+			throw SerializationException(SerializationErrorCode::OutOfRange, "No more items to load");
+		}
+		++mIndex;
+		return (*mFields)[mNextIndex++];
+	}
+
+	IProtobufReader* mProtobufReader;
+	std::vector<CProtobufField>* mFields;
+	size_t mStartIndex;
+	size_t mEndIndex;
+	size_t mNextIndex;
+	size_t mIndex = 0;
+	std::string_view mPackedData;
+};
+
+
+/// <summary>
+/// Protobuf scope for reading messages (fields with numbers).
+/// All fields of message are indexed when the scope is opened (without decoding values), then they are searched starting
+/// from the last loaded one, so loading in the same order as they were saved does not require any lookups.
+/// </summary>
+class ProtobufReadObjectScope final : public TArchiveScope<SerializeMode::Load>, public ProtobufScopeBase
+{
+public:
+	/// <summary>
+	/// Parses fields of the message and places them at the end of list (they are removed when the scope is destroyed).
+	/// </summary>
+	ProtobufReadObjectScope(IProtobufReader* protobufReader, std::vector<CProtobufField>* fields, std::string_view messageData,
+		SerializationContext& serializationContext, const ProtobufScopeBase* parent = nullptr, key_type parentKey = 0)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, ProtobufScopeBase(parent, parentKey)
+		, mProtobufReader(protobufReader)
+		, mFields(fields)
+		, mStartIndex(fields->size())
+	{
+		mProtobufReader->ReadMessage(messageData, *mFields);
+		mEndIndex = mFields->size();
+		mNextIndex = mStartIndex;
+
+		// Repeated fields require searching of the last value (fields with numbers above 63 are considered as repeated)
+		uint64_t foundFields = 0;
+		for (size_t i = mStartIndex; i < mEndIndex && !mHasRepeatedFields; ++i)
+		{
+			const uint32_t number = (*mFields)[i].Number;
+			const uint64_t fieldBit = number < 64 ? uint64_t(1) << number : 0;
+			mHasRepeatedFields = fieldBit == 0 || (foundFields & fieldBit) != 0;
+			foundFields |= fieldBit;
+		}
+	}
+
+	~ProtobufReadObjectScope()
+	{
+		mFields->resize(mStartIndex);
+	}
+
+	/// <summary>
+	/// Constant iterator for keys (numbers of fields).
+	/// </summary>
+	class key_const_iterator
+	{
+		friend class ProtobufReadObjectScope;
+
+		const std::vector<CProtobufField>* mFields;
+		size_t mIndex;
+
+		key_const_iterator(const std::vector<CProtobufField>* fields, size_t index) noexcept
+			: mFields(fields), mIndex(index) { }
+
+	public:
+		bool operator==(const key_const_iterator& rhs) const noexcept {
+			return mIndex == rhs.mIndex;
+		}
+		bool operator!=(const key_const_iterator& rhs) const noexcept {
+			return mIndex != rhs.mIndex;
+		}
+
+		key_const_iterator& operator++() noexcept
+		{
+			++mIndex;
+			return *this;
+		}
+
+		key_type operator*() const noexcept
+		{
+			return (*mFields)[mIndex].Number;
+		}
+	};
+
+	/// <summary>
+	/// Get the begin constant iterator of keys.
+	/// </summary>
+	[[nodiscard]] key_const_iterator cbegin() const noexcept {
+		return { mFields, mStartIndex };
+	}
+
+	/// <summary>
+	/// Get the end constant iterator of keys.
+	/// </summary>
+	[[nodiscard]] key_const_iterator cend() const noexcept {
+		return { mFields, mEndIndex };
+	}
+
+	/// <summary>
+	/// Returns the number of fields in the message.
+	/// </summary>
+	[[nodiscard]] size_t GetEstimatedSize() const noexcept
+	{
+		return mEndIndex - mStartIndex;
+	}
+
+	/// <summary>
+	/// Loads the null value, which is represented by the absence of field.
+	/// </summary>
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, std::nullptr_t& value)
+	{
+		const CProtobufField* field = FindField(static_cast<key_type>(key));
+		return field == nullptr || mProtobufReader->ReadValue(*field, value);
+	}
+
+	template <typename TKey, typename T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+	bool SerializeValue(TKey&& key, T& value)
+	{
+		const CProtobufField* field = FindField(static_cast<key_type>(key));
+		return field != nullptr && LoadValue(mProtobufReader, *field, value);
+	}
+
+	template <typename TKey, typename TSym, typename TAllocator>
+	bool SerializeValue(TKey&& key, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		const CProtobufField* field = FindField(static_cast<key_type>(key));
+		return field != nullptr && LoadValue(mProtobufReader, *field, value);
+	}
+
+	/// <summary>
+	/// Reads the value as view to the input data (valid until the archive is destroyed).
+	/// </summary>
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, std::string_view& value)
+	{
+		const CProtobufField* field = FindField(static_cast<key_type>(key));
+		return field != nullptr && mProtobufReader->ReadValue(*field, value);
+	}
+
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, CBinTimestamp& timestamp)
+	{
+		const CProtobufField* field = FindField(static_cast<key_type>(key));
+		return field != nullptr && mProtobufReader->ReadValue(*field, timestamp);
+	}
+
+	template <typename TKey>
+	std::optional<ProtobufReadObjectScope> OpenObjectScope(TKey&& key)
+	{
+		const auto fieldNumber = static_cast<key_type>(key);
+		const CProtobufField* field = FindField(fieldNumber);
+		if (field == nullptr) {
+			return std::nullopt;
+		}
+		if (field->Type != WireType::LengthDelimited)
+		{
+			HandleMismatchedType();
+			return std::nullopt;
+		}
+		// The field is not accessed after opening the scope, as the list of fields may be reallocated
+		const std::string_view messageData = field->Data;
+		return std::make_optional<ProtobufReadObjectScope>(mProtobufReader, mFields, messageData, GetContext(), this, fieldNumber);
+	}
+
+	/// <summary>
+	/// Opens all fields with passed number as array (the absence of fields means an empty array).
+	/// </summary>
+	template <typename TKey>
+	std::optional<ProtobufReadArrayScope> OpenArrayScope(TKey&& key, size_t)
+	{
+		const auto fieldNumber = static_cast<key_type>(key);
+		const size_t startIndex = mFields->size();
+		for (size_t i = mStartIndex; i < mEndIndex; ++i)
+		{
+			if ((*mFields)[i].Number == fieldNumber)
+			{
+				const CProtobufField field = (*mFields)[i];
+				mFields->push_back(field);
+			}
+		}
+		return std::make_optional<ProtobufReadArrayScope>(mProtobufReader, mFields, startIndex, GetContext(), this, fieldNumber);
+	}
+
+private:
+	/// <summary>
+	/// Finds the field by number, starts searching from the field which is next to the last found.
+	/// When the field is repeated, returns the last one (as required by Protobuf specification).
+	/// </summary>
+	const CProtobufField* FindField(key_type fieldNumber) noexcept
+	{
+		for (size_t i = mStartIndex; i < mEndIndex; ++i)
+		{
+			if (mNextIndex == mEndIndex) {
+				mNextIndex = mStartIndex;
+			}
+
+			const CProtobufField* field = &(*mFields)[mNextIndex++];
+			if (field->Number == fieldNumber)
+			{
+				if (mHasRepeatedFields)
+				{
+					for (size_t k = mNextIndex; k < mEndIndex; ++k)
+					{
+						if ((*mFields)[k].Number == fieldNumber) {
+							field = &(*mFields)[k];
+						}
+					}
+				}
+				return field;
+			}
+		}
+		return nullptr;
+	}
+
+	bool HandleMismatchedType() const
+	{
+		if (GetOptions().mismatchedTypesPolicy == MismatchedTypesPolicy::ThrowError)
+		{
+			throw SerializationException(SerializationErrorCode::MismatchedTypes,
+				"The type of target field does not match the value being loaded");
+		}
+		return false;
+	}
+
+	IProtobufReader* mProtobufReader;
+	std::vector<CProtobufField>* mFields;
+	size_t mStartIndex;
+	size_t mEndIndex = 0;
+	size_t mNextIndex = 0;
+	bool mHasRepeatedFields = false;
+};
+
+inline std::optional<ProtobufReadObjectScope> ProtobufReadArrayScope::OpenObjectScope()
+{
+	const CProtobufField& field = NextField();
+	if (field.Type != WireType::LengthDelimited)
+	{
+		if (GetOptions().mismatchedTypesPolicy == MismatchedTypesPolicy::ThrowError)
+		{
+			throw SerializationException(SerializationErrorCode::MismatchedTypes,
+				"The type of target field does not match the value being loaded");
+		}
+		return std::nullopt;
+	}
+	const std::string_view messageData = field.Data;
+	return std::make_optional<ProtobufReadObjectScope>(mProtobufReader, mFields, messageData, GetContext(), this);
+}
+
+
+/// <summary>
+/// Protobuf root scope (the root of Protobuf data is always a message)
+/// </summary>
+class ProtobufReadRootScope final : public TArchiveScope<SerializeMode::Load>, public ProtobufScopeBase
+{
+public:
+	ProtobufReadRootScope(std::string_view inputData, SerializationContext& serializationContext);
+	ProtobufReadRootScope(const std::vector<uint8_t>& inputData, SerializationContext& serializationContext);
+	ProtobufReadRootScope(std::istream& inputStream, SerializationContext& serializationContext);
+
+	std::optional<ProtobufReadObjectScope> OpenObjectScope()
+	{
+		return std::make_optional<ProtobufReadObjectScope>(mProtobufReader.get(), &mFields, mInputData, GetContext());
+	}
+
+	void Finalize() const noexcept { /* Not required */ }
+
+private:
+	std::string mStreamData;
+	std::string_view mInputData;
+	// Fields of all opened messages and repeated fields (each scope adds its fields to the end and removes them when closed)
+	std::vector<CProtobufField> mFields;
+	std::unique_ptr<IProtobufReader> mProtobufReader;
+};
+
+}
+
+
+/// <summary>
+/// Protobuf archive (internal implementation - no dependencies).
+/// Writes and reads the Protobuf wire format, keys are numbers of fields (e.g. <c>MakeKeyValue(1, value)</c>).
+/// Signed integers are encoded by ZigZag (like <c>sint32</c> and <c>sint64</c>), arrays of numbers are written as packed
+/// repeated fields, arrays of strings and objects as repeated fields.
+/// Supports load/save from:
+/// - <c>std::string</c>: binary data
+/// - <c>std::vector&lt;uint8_t&gt;</c>: binary data
+/// - <c>std::istream</c> and <c>std::ostream</c>: binary data
+/// </summary>
+using ProtobufArchive = TArchiveBase<
+	Detail::ProtobufArchiveTraits,
+	Detail::ProtobufReadRootScope,
+	Detail::ProtobufWriteRootScope>;
+
+}
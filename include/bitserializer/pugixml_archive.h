@@ -3,11 +3,16 @@
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
 #pragma once
+#include <algorithm>
 #include <cassert>
+#include <charconv>
+#include <cstdio>
+#include <exception>
+#include <limits>
+#include <memory>
 #include <optional>
-#include <sstream>
 #include <type_traits>
-#include <variant>
+#include <vector>
 #include "bitserializer/serialization_detail/archive_base.h"
 #include "bitserializer/serialization_detail/errors_handling.h"
 
@@ -40,30 +45,1032 @@ protected:
 	~PugiXmlArchiveTraits() = default;
 };
 
-namespace PugiXmlExtensions
+/// <summary>
+/// Streaming XML writer, escapes and writes elements directly to the output string (without building DOM).
+/// The output is the same as PugiXml produces (including the formatting with indents).
+/// </summary>
+class CXmlWriter
+{
+public:
+	CXmlWriter(std::string& outputString, const FormatOptions& formatOptions)
+		: mOutput(outputString)
+		, mFormatOptions(formatOptions)
+	{
+		assert(!mFormatOptions.enableFormat || mFormatOptions.paddingCharNum);
+	}
+
+	CXmlWriter(const CXmlWriter&) = delete;
+	CXmlWriter& operator=(const CXmlWriter&) = delete;
+	virtual ~CXmlWriter() = default;
+
+	[[nodiscard]] const FormatOptions& GetFormatOptions() const noexcept {
+		return mFormatOptions;
+	}
+
+	void WriteDeclaration()
+	{
+		mOutput.append(R"(<?xml version="1.0"?>)");
+		WriteNewLine();
+	}
+
+	/// <summary>
+	/// Writes the start tag of element, it stays open for attributes until the first child or text is written.
+	/// </summary>
+	void BeginElement(std::string_view name)
+	{
+		if (!mElements.empty())
+		{
+			auto& parent = mElements.back();
+			if (parent.State == ElementState::StartTag)
+			{
+				mOutput.push_back('>');
+				WriteNewLine();
+			}
+			parent.State = ElementState::Children;
+		}
+		WriteIndent(mElements.size());
+		mOutput.push_back('<');
+		mOutput.append(name);
+		mElements.push_back({ mNames.size(), name.size(), ElementState::StartTag });
+		mNames.append(name);
+	}
+
+	[[nodiscard]] bool IsStartTagOpened() const noexcept
+	{
+		return !mElements.empty() && mElements.back().State == ElementState::StartTag;
+	}
+
+	void WriteAttribute(std::string_view name, std::string_view value)
+	{
+		assert(IsStartTagOpened());
+		mOutput.push_back(' ');
+		mOutput.append(name);
+		mOutput.append("=\"");
+		WriteEscaped(value, true);
+		mOutput.push_back('"');
+	}
+
+	void WriteText(std::string_view text)
+	{
+		auto& element = mElements.back();
+		if (element.State == ElementState::StartTag)
+		{
+			mOutput.push_back('>');
+			element.State = ElementState::Text;
+		}
+		WriteEscaped(text, false);
+	}
+
+	void EndElement()
+	{
+		const Element element = mElements.back();
+		mElements.pop_back();
+		if (element.State == ElementState::StartTag)
+		{
+			// Element without children and text
+			mOutput.append(mFormatOptions.enableFormat ? " />" : "/>");
+		}
+		else
+		{
+			if (element.State == ElementState::Children) {
+				WriteIndent(mElements.size());
+			}
+			mOutput.append("</");
+			mOutput.append(mNames, element.NamePos, element.NameSize);
+			mOutput.push_back('>');
+		}
+		mNames.resize(element.NamePos);
+		WriteNewLine();
+		OnElementWritten();
+	}
+
+	/// <summary>
+	/// Gets the path of current element (names of all opened elements).
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const
+	{
+		std::string path;
+		for (const auto& element : mElements)
+		{
+			path.push_back('/');
+			path.append(mNames, element.NamePos, element.NameSize);
+		}
+		return path;
+	}
+
+	virtual void Flush() { }
+
+protected:
+	/// <summary>
+	/// Called after each closed element (output is not split in the middle of UTF-8 sequences there).
+	/// </summary>
+	virtual void OnElementWritten() { }
+
+	enum class ElementState : uint8_t
+	{
+		StartTag,
+		Text,
+		Children
+	};
+
+	struct Element
+	{
+		size_t NamePos;
+		size_t NameSize;
+		ElementState State;
+	};
+
+	void WriteNewLine()
+	{
+		if (mFormatOptions.enableFormat) {
+			mOutput.push_back('\n');
+		}
+	}
+
+	void WriteIndent(size_t level)
+	{
+		if (mFormatOptions.enableFormat) {
+			mOutput.append(level * mFormatOptions.paddingCharNum, mFormatOptions.paddingChar);
+		}
+	}
+
+	/// <summary>
+	/// Escapes special characters like PugiXml does (control characters are written as character references).
+	/// </summary>
+	void WriteEscaped(std::string_view text, bool isAttribute)
+	{
+		const char* begin = text.data();
+		const char* const end = begin + text.size();
+		for (const char* it = begin; it != end; ++it)
+		{
+			const auto ch = static_cast<unsigned char>(*it);
+			if (ch >= 0x20 && ch != '&' && ch != '<' && ch != '>' && ch != '"') {
+				continue;
+			}
+			if (!isAttribute && (ch == '"' || ch == '\t' || ch == '\n' || ch == '\r')) {
+				continue;
+			}
+			if (isAttribute && ch == '>') {
+				continue;
+			}
+
+			mOutput.append(begin, it);
+			begin = it + 1;
+			switch (ch)
+			{
+			case '&':
+				mOutput.append("&amp;");
+				break;
+			case '<':
+				mOutput.append("&lt;");
+				break;
+			case '>':
+				mOutput.append("&gt;");
+				break;
+			case '"':
+				mOutput.append("&quot;");
+				break;
+			default:
+				mOutput.append("&#");
+				mOutput.push_back(static_cast<char>('0' + ch / 10));
+				mOutput.push_back(static_cast<char>('0' + ch % 10));
+				mOutput.push_back(';');
+				break;
+			}
+		}
+		mOutput.append(begin, end);
+	}
+
+	std::string& mOutput;
+	const FormatOptions& mFormatOptions;
+	std::vector<Element> mElements;
+	// Names of all opened elements (for writing end tags)
+	std::string mNames;
+};
+
+/// <summary>
+/// Holds the internal buffer of stream writer (must be constructed before the base writer).
+/// </summary>
+struct CXmlStreamBuffer
 {
-	inline pugi::xml_node AppendChild(pugi::xml_node& node, const PugiXmlArchiveTraits::key_type& key) {
-		return node.append_child(key.c_str());
+	std::string mStreamBuffer;
+};
+
+/// <summary>
+/// Streaming XML writer to the `std::ostream`, the output is written by chunks in the required UTF encoding.
+/// </summary>
+class CXmlStreamWriter final : private CXmlStreamBuffer, public CXmlWriter
+{
+public:
+	CXmlStreamWriter(std::ostream& outputStream, const FormatOptions& formatOptions, const StreamOptions& streamOptions)
+		: CXmlWriter(mStreamBuffer, formatOptions)
+		, mOutputStream(outputStream)
+		, mEncoding(streamOptions.encoding)
+	{
+		switch (mEncoding)
+		{
+		case Convert::UtfType::Utf8:
+		case Convert::UtfType::Utf16le:
+		case Convert::UtfType::Utf16be:
+		case Convert::UtfType::Utf32le:
+		case Convert::UtfType::Utf32be:
+			break;
+		default:
+			const auto strEncodingType = Convert::TryTo<std::string>(mEncoding);
+			throw SerializationException(SerializationErrorCode::UnsupportedEncoding,
+				"The archive does not support encoding: " +
+				(strEncodingType.has_value() ? strEncodingType.value() : std::to_string(static_cast<int>(mEncoding))));
+		}
+
+		mStreamBuffer.reserve(StreamChunkSize + StreamChunkSize / 4);
+		if (streamOptions.writeBom) {
+			Convert::WriteBom(mOutputStream, mEncoding);
+		}
+	}
+
+	void Flush() override
+	{
+		FlushToStream();
+		mOutputStream.flush();
+		if (!mOutputStream.good()) {
+			throw SerializationException(SerializationErrorCode::InputOutputError, "Error writing to the output stream");
+		}
+	}
+
+protected:
+	static constexpr size_t StreamChunkSize = 64 * 1024;
+
+	void OnElementWritten() override
+	{
+		if (mStreamBuffer.size() >= StreamChunkSize) {
+			FlushToStream();
+		}
+	}
+
+	void FlushToStream()
+	{
+		if (mStreamBuffer.empty()) {
+			return;
+		}
+
+		switch (mEncoding)
+		{
+		case Convert::UtfType::Utf8:
+			mOutputStream.write(mStreamBuffer.data(), static_cast<std::streamsize>(mStreamBuffer.size()));
+			break;
+		case Convert::UtfType::Utf16le:
+			WriteEncoded<Convert::Utf16Le, std::u16string>();
+			break;
+		case Convert::UtfType::Utf16be:
+			WriteEncoded<Convert::Utf16Be, std::u16string>();
+			break;
+		case Convert::UtfType::Utf32le:
+			WriteEncoded<Convert::Utf32Le, std::u32string>();
+			break;
+		case Convert::UtfType::Utf32be:
+			WriteEncoded<Convert::Utf32Be, std::u32string>();
+			break;
+		}
+		mStreamBuffer.clear();
+	}
+
+	template <typename TUtf, typename TString>
+	void WriteEncoded()
+	{
+		TString encodedStr;
+		TUtf::Encode(mStreamBuffer.cbegin(), mStreamBuffer.cend(), encodedStr);
+		mOutputStream.write(reinterpret_cast<const char*>(encodedStr.data()),
+			static_cast<std::streamsize>(encodedStr.size() * sizeof(typename TString::value_type)));
+	}
+
+	std::ostream& mOutputStream;
+	Convert::UtfType mEncoding;
+};
+
+/// <summary>
+/// Pull XML reader, which reads elements in the document order from the string or incrementally from the stream.
+/// Elements that are not loaded are skipped without allocations, texts are returned as views that are valid until the next read.
+/// Errors which are detected in noexcept methods (like leaving an element from the destructor of scope) are deferred until the next read.
+/// </summary>
+class CXmlPullReader
+{
+public:
+	explicit CXmlPullReader(std::string_view inputData)
+		: mData(inputData)
+	{
+		// Skip UTF-8 BOM
+		if (mData.size() >= 3 && mData.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+			mPos = 3;
+		}
+	}
+
+	explicit CXmlPullReader(std::istream& inputStream)
+		: mInputStream(&inputStream)
+		, mStreamStartPos(inputStream.tellg())
+		, mEncodedStreamReader(std::make_unique<Convert::CEncodedStreamReader<Convert::Utf8>>(inputStream))
+	{
+		ReadNextChunk();
+	}
+
+	/// <summary>
+	/// Peeks the next child element of the current element (or the document element at the top level).
+	/// Returns false when the end of the current element is reached.
+	/// </summary>
+	bool PeekElement()
+	{
+		CheckError();
+		if (mHasPending) {
+			return true;
+		}
+		if (mElements.empty() ? mIsRootLoaded : mElements.back().IsSelfClosed || mElements.back().IsEndReached) {
+			return false;
+		}
+
+		for (;;)
+		{
+			DiscardProcessedData();
+			const size_t tagPos = Find('<', mPos);
+			if (tagPos == std::string_view::npos)
+			{
+				mPos = mData.size();
+				if (!mElements.empty()) {
+					ThrowParsingError("Unexpected end of XML", mPos);
+				}
+				return false;
+			}
+			mPos = tagPos;
+			if (!IsAvailable(mPos + 1)) {
+				ThrowParsingError("Unexpected end of XML", mPos);
+			}
+
+			const char ch = mData[mPos + 1];
+			if (ch == '/')
+			{
+				if (mElements.empty()) {
+					ThrowParsingError("Unexpected end tag", mPos);
+				}
+				mElements.back().IsEndReached = true;
+				return false;
+			}
+			if (ch == '!' || ch == '?')
+			{
+				SkipSpecialNode();
+				continue;
+			}
+			ParseStartTag();
+			return true;
+		}
+	}
+
+	/// <summary>
+	/// Returns the name of the peeked element.
+	/// </summary>
+	[[nodiscard]] std::string_view GetPendingName() const noexcept {
+		return mPendingName;
+	}
+
+	/// <summary>
+	/// Returns the sequence number of the peeked element in the document (starts from 1).
+	/// </summary>
+	[[nodiscard]] uint64_t GetPendingIndex() const noexcept {
+		return mElementIndex;
+	}
+
+	/// <summary>
+	/// Enters into the peeked element, its attributes and children become available for reading.
+	/// </summary>
+	void EnterElement()
+	{
+		assert(mHasPending);
+		mHasPending = false;
+		const size_t depth = mElements.size();
+		mElements.push_back({ mNames.size(), mPendingName.size(), mIsPendingSelfClosed, false });
+		mNames.append(mPendingName);
+		if (mAttributes.size() <= depth) {
+			mAttributes.resize(depth + 1);
+		}
+		std::swap(mAttributes[depth], mPendingAttributes);
+	}
+
+	/// <summary>
+	/// Skips the peeked element with all its children (without allocations).
+	/// </summary>
+	void SkipElement()
+	{
+		CheckError();
+		assert(mHasPending);
+		mHasPending = false;
+		if (mIsPendingSelfClosed) {
+			return;
+		}
+
+		for (size_t depth = 1; depth != 0;)
+		{
+			DiscardProcessedData();
+			const size_t tagPos = Find('<', mPos);
+			if (tagPos == std::string_view::npos || !IsAvailable(tagPos + 1)) {
+				ThrowParsingError("Unexpected end of XML", mData.size());
+			}
+			mPos = tagPos;
+
+			const char ch = mData[mPos + 1];
+			if (ch == '!' || ch == '?')
+			{
+				SkipSpecialNode();
+				continue;
+			}
+
+			// Find the end of tag (the '>' character is allowed in the quoted values of attributes)
+			size_t pos = mPos + 1;
+			for (char quote = 0;; ++pos)
+			{
+				if (!IsAvailable(pos)) {
+					ThrowParsingError("Unexpected end of XML", pos);
+				}
+				const char c = mData[pos];
+				if (quote != 0) {
+					quote = c == quote ? 0 : quote;
+				}
+				else if (c == '"' || c == '\'') {
+					quote = c;
+				}
+				else if (c == '>') {
+					break;
+				}
+			}
+
+			if (ch == '/') {
+				--depth;
+			}
+			else if (mData[pos - 1] != '/') {
+				++depth;
+			}
+			mPos = pos + 1;
+		}
+	}
+
+	/// <summary>
+	/// Leaves the current element (skips all children that were not loaded and validates the end tag).
+	/// </summary>
+	void LeaveElement() noexcept
+	{
+		try
+		{
+			while (PeekElement()) {
+				SkipElement();
+			}
+
+			const Element element = mElements.back();
+			if (!element.IsSelfClosed)
+			{
+				// The current position points to the end tag "</name>"
+				const size_t endPos = Find('>', mPos + 2);
+				if (endPos == std::string_view::npos) {
+					ThrowParsingError("Unexpected end of XML", mData.size());
+				}
+				auto name = mData.substr(mPos + 2, endPos - mPos - 2);
+				while (!name.empty() && IsWhitespace(name.back())) {
+					name.remove_suffix(1);
+				}
+				if (name != std::string_view(mNames).substr(element.NamePos, element.NameSize)) {
+					ThrowParsingError("Start-end tags mismatch", mPos);
+				}
+				mPos = endPos + 1;
+			}
+
+			mElements.pop_back();
+			mNames.resize(element.NamePos);
+			mIsRootLoaded = mElements.empty();
+		}
+		catch (...)
+		{
+			mDeferredError = std::current_exception();
+		}
+	}
+
+	/// <summary>
+	/// Reads the text of the current element (till the next child or the end tag).
+	/// The text is returned as view to the input data when it does not contain entities, otherwise it is decoded into the internal buffer.
+	/// Returns false when the element does not have text (whitespaces only text is ignored as PugiXml does).
+	/// </summary>
+	bool ReadText(std::string_view& text)
+	{
+		CheckError();
+		assert(!mHasPending && !mElements.empty());
+		if (mElements.back().IsSelfClosed || mElements.back().IsEndReached) {
+			return false;
+		}
+
+		DiscardProcessedData();
+		mTextBuffer.clear();
+		bool isDecoded = false;
+		size_t textPos = mPos, textSize = 0;
+		for (;;)
+		{
+			const size_t tagPos = Find('<', mPos);
+			if (tagPos == std::string_view::npos) {
+				ThrowParsingError("Unexpected end of XML", mData.size());
+			}
+
+			if (tagPos != mPos)
+			{
+				const auto part = mData.substr(mPos, tagPos - mPos);
+				if (!isDecoded && textSize == 0 && part.find_first_of("&\r") == std::string_view::npos)
+				{
+					textPos = mPos;
+					textSize = part.size();
+				}
+				else
+				{
+					MoveTextToBuffer(isDecoded, textPos, textSize);
+					AppendDecoded(mTextBuffer, part, false);
+				}
+			}
+			mPos = tagPos;
+
+			if (StartsWith(mPos, "<![CDATA["))
+			{
+				const size_t endPos = Find("]]>", mPos + 9);
+				if (endPos == std::string_view::npos) {
+					ThrowParsingError("Unexpected end of XML", mData.size());
+				}
+				MoveTextToBuffer(isDecoded, textPos, textSize);
+				mTextBuffer.append(mData.substr(mPos + 9, endPos - mPos - 9));
+				mPos = endPos + 3;
+			}
+			else if (StartsWith(mPos, "<!--") || StartsWith(mPos, "<?")) {
+				SkipSpecialNode();
+			}
+			else {
+				break;
+			}
+		}
+
+		text = isDecoded ? std::string_view(mTextBuffer) : mData.substr(textPos, textSize);
+		return std::any_of(text.cbegin(), text.cend(), [](char ch) { return !IsWhitespace(ch); });
+	}
+
+	/// <summary>
+	/// Finds the attribute of the current element.
+	/// </summary>
+	bool FindAttribute(std::string_view name, std::string_view& value) const
+	{
+		assert(!mElements.empty());
+		const auto& attributes = mAttributes[mElements.size() - 1];
+		for (size_t i = 0; i < attributes.Count; ++i)
+		{
+			if (attributes.Items[i].first == name)
+			{
+				value = attributes.Items[i].second;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/// <summary>
+	/// Returns the path of the current element.
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const
+	{
+		std::string path;
+		for (const auto& element : mElements)
+		{
+			path.push_back('/');
+			path.append(mNames, element.NamePos, element.NameSize);
+		}
+		return path;
+	}
+
+	/// <summary>
+	/// Remembers the position before the peeked element (or the current position when there is no peeked one) for restoring it later.
+	/// When loading from the stream, the data after bookmark is kept in the buffer up to the limited size (the rest is re-read
+	/// from the seekable stream when restoring), the non-seekable stream keeps all data until the bookmark is restored or released.
+	/// </summary>
+	void SetBookmark() noexcept
+	{
+		assert(!mElements.empty());
+		mBookmark.Pos = mDiscardedSize + (mHasPending ? mPendingPos : mPos);
+		mBookmark.ElementIndex = mHasPending ? mElementIndex - 1 : mElementIndex;
+		mBookmark.IsEndReached = mElements.back().IsEndReached;
+		mHasBookmark = true;
+	}
+
+	/// <summary>
+	/// Returns to the position which was remembered by the bookmark (the next element will be peeked again).
+	/// </summary>
+	void RestoreBookmark()
+	{
+		assert(mHasBookmark && !mElements.empty());
+		if (mBookmark.Pos < mDiscardedSize) {
+			RereadStream(mBookmark.Pos);
+		}
+		mPos = mBookmark.Pos - mDiscardedSize;
+		mElementIndex = mBookmark.ElementIndex;
+		mElements.back().IsEndReached = mBookmark.IsEndReached;
+		mHasPending = false;
+		mHasBookmark = false;
+	}
+
+	/// <summary>
+	/// Releases the bookmark without changing the position.
+	/// </summary>
+	void ReleaseBookmark() noexcept {
+		mHasBookmark = false;
+	}
+
+	/// <summary>
+	/// Returns the size of data which is kept in the buffer (when loading from the stream).
+	/// </summary>
+	[[nodiscard]] size_t GetBufferedSize() const noexcept {
+		return mStreamBuffer.size();
+	}
+
+	/// <summary>
+	/// Rethrows the error which was deferred in the noexcept method.
+	/// </summary>
+	void CheckError() const
+	{
+		if (mDeferredError) {
+			std::rethrow_exception(mDeferredError);
+		}
+	}
+
+private:
+	struct Element
+	{
+		size_t NamePos;
+		size_t NameSize;
+		bool IsSelfClosed;
+		bool IsEndReached;
+	};
+
+	struct Bookmark
+	{
+		// Position from the beginning of input data (including discarded from the stream buffer)
+		size_t Pos = 0;
+		uint64_t ElementIndex = 0;
+		bool IsEndReached = false;
+	};
+
+	struct Attributes
+	{
+		// The storage is reused for elements at the same depth, only first 'Count' items are valid
+		std::vector<std::pair<std::string, std::string>> Items;
+		size_t Count = 0;
+	};
+
+	[[nodiscard]] static bool IsWhitespace(char ch) noexcept {
+		return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';
+	}
+
+	[[noreturn]] void ThrowParsingError(const char* message, size_t pos) const {
+		throw ParsingException(message, 0, mDiscardedSize + pos);
+	}
+
+	bool ReadNextChunk()
+	{
+		if (!mEncodedStreamReader || !mEncodedStreamReader->ReadChunk(mStreamBuffer)) {
+			return false;
+		}
+		mData = mStreamBuffer;
+		return true;
+	}
+
+	/// <summary>
+	/// Removes the processed data from the stream buffer (when it takes more than half of buffer, to reduce moving of data).
+	/// The data after bookmark is kept while its size does not exceed the limit (or always, when the stream is not seekable).
+	/// </summary>
+	void DiscardProcessedData()
+	{
+		size_t discardSize = mPos;
+		if (mHasBookmark && mBookmark.Pos >= mDiscardedSize)
+		{
+			const size_t bookmarkPos = mBookmark.Pos - mDiscardedSize;
+			if (mPos <= bookmarkPos + MaxBookmarkedSize || !IsSeekableStream()) {
+				discardSize = std::min(mPos, bookmarkPos);
+			}
+		}
+		if (mEncodedStreamReader && discardSize != 0 && discardSize >= mStreamBuffer.size() / 2)
+		{
+			mStreamBuffer.erase(0, discardSize);
+			mDiscardedSize += discardSize;
+			mPos -= discardSize;
+			mData = mStreamBuffer;
+		}
+	}
+
+	[[nodiscard]] bool IsSeekableStream() const noexcept {
+		return mInputStream != nullptr && mStreamStartPos != std::streampos(-1);
+	}
+
+	/// <summary>
+	/// Reads the stream again from the beginning till the chunk which contains the specified position (the previous data is discarded).
+	/// </summary>
+	void RereadStream(size_t pos)
+	{
+		mInputStream->clear();
+		if (!mInputStream->seekg(mStreamStartPos)) {
+			throw SerializationException(SerializationErrorCode::InputOutputError, "Error seeking in the input stream");
+		}
+		mEncodedStreamReader = std::make_unique<Convert::CEncodedStreamReader<Convert::Utf8>>(*mInputStream);
+		mStreamBuffer.clear();
+		mDiscardedSize = 0;
+		while (ReadNextChunk())
+		{
+			if (mDiscardedSize + mStreamBuffer.size() > pos) {
+				return;
+			}
+			mDiscardedSize += mStreamBuffer.size();
+			mStreamBuffer.clear();
+		}
+		mData = mStreamBuffer;
+		ThrowParsingError("Unexpected end of XML", 0);
+	}
+
+	bool IsAvailable(size_t pos)
+	{
+		while (pos >= mData.size())
+		{
+			if (!ReadNextChunk()) {
+				return false;
+			}
+		}
+		return true;
 	}
 
-	inline pugi::xml_node AppendChild(pugi::xml_node& node, const pugi::char_t* key) {
-		return node.append_child(key);
+	bool StartsWith(size_t pos, std::string_view str)
+	{
+		return IsAvailable(pos + str.size() - 1) && mData.compare(pos, str.size(), str) == 0;
 	}
 
-	inline pugi::xml_node GetChild(pugi::xml_node& node, const PugiXmlArchiveTraits::key_type& key) {
-		return node.child(key.c_str());
+	template <typename T>
+	size_t Find(T what, size_t pos)
+	{
+		for (;;)
+		{
+			if (const size_t foundPos = mData.find(what, pos); foundPos != std::string_view::npos) {
+				return foundPos;
+			}
+			// The string may be split between chunks
+			if constexpr (std::is_same_v<T, std::string_view> || std::is_same_v<T, const char*>) {
+				pos = std::max(pos, mData.size() - std::min(mData.size(), std::string_view(what).size() - 1));
+			}
+			else {
+				pos = mData.size();
+			}
+			if (!ReadNextChunk()) {
+				return std::string_view::npos;
+			}
+		}
 	}
 
-	inline pugi::xml_node GetChild(pugi::xml_node& node, const pugi::char_t* key) {
-		return node.child(key);
+	size_t SkipName(size_t pos)
+	{
+		while (IsAvailable(pos))
+		{
+			const char ch = mData[pos];
+			if (IsWhitespace(ch) || ch == '/' || ch == '>' || ch == '=') {
+				break;
+			}
+			++pos;
+		}
+		return pos;
+	}
+
+	size_t SkipWhitespaces(size_t pos)
+	{
+		while (IsAvailable(pos) && IsWhitespace(mData[pos])) {
+			++pos;
+		}
+		return pos;
+	}
+
+	/// <summary>
+	/// Skips the comment, CDATA, DOCTYPE or processing instruction at the current position.
+	/// </summary>
+	void SkipSpecialNode()
+	{
+		size_t endPos, endSize = 1;
+		if (StartsWith(mPos, "<!--")) {
+			endPos = Find("-->", mPos + 4);
+			endSize = 3;
+		}
+		else if (StartsWith(mPos, "<![CDATA[")) {
+			endPos = Find("]]>", mPos + 9);
+			endSize = 3;
+		}
+		else if (mData[mPos + 1] == '?') {
+			endPos = Find("?>", mPos + 2);
+			endSize = 2;
+		}
+		else
+		{
+			// DOCTYPE can contain the internal subset in the square brackets
+			size_t pos = mPos + 2;
+			for (size_t depth = 0; IsAvailable(pos); ++pos)
+			{
+				const char ch = mData[pos];
+				if (ch == '[') {
+					++depth;
+				}
+				else if (ch == ']' && depth != 0) {
+					--depth;
+				}
+				else if (ch == '>' && depth == 0) {
+					break;
+				}
+			}
+			endPos = IsAvailable(pos) ? pos : std::string_view::npos;
+		}
+
+		if (endPos == std::string_view::npos) {
+			ThrowParsingError("Unexpected end of XML", mData.size());
+		}
+		mPos = endPos + endSize;
+	}
+
+	/// <summary>
+	/// Parses the start tag at the current position into the pending element.
+	/// </summary>
+	void ParseStartTag()
+	{
+		mPendingPos = mPos;
+		const size_t nameStart = mPos + 1;
+		size_t pos = SkipName(nameStart);
+		if (pos == nameStart) {
+			ThrowParsingError("Invalid name of element", nameStart);
+		}
+		mPendingName.assign(mData.substr(nameStart, pos - nameStart));
+
+		mPendingAttributes.Count = 0;
+		for (;;)
+		{
+			pos = SkipWhitespaces(pos);
+			if (!IsAvailable(pos)) {
+				ThrowParsingError("Unexpected end of XML", pos);
+			}
+			if (mData[pos] == '>')
+			{
+				mIsPendingSelfClosed = false;
+				++pos;
+				break;
+			}
+			if (mData[pos] == '/')
+			{
+				if (!IsAvailable(pos + 1) || mData[pos + 1] != '>') {
+					ThrowParsingError("Error parsing start element tag", pos);
+				}
+				mIsPendingSelfClosed = true;
+				pos += 2;
+				break;
+			}
+
+			// Parse attribute
+			const size_t attrNameStart = pos;
+			pos = SkipName(pos);
+			if (pos == attrNameStart) {
+				ThrowParsingError("Error parsing start element tag", pos);
+			}
+			if (mPendingAttributes.Count == mPendingAttributes.Items.size()) {
+				mPendingAttributes.Items.emplace_back();
+			}
+			auto& attribute = mPendingAttributes.Items[mPendingAttributes.Count++];
+			attribute.first.assign(mData.substr(attrNameStart, pos - attrNameStart));
+
+			pos = SkipWhitespaces(pos);
+			if (!IsAvailable(pos) || mData[pos] != '=') {
+				ThrowParsingError("Attribute is missing value", pos);
+			}
+			pos = SkipWhitespaces(pos + 1);
+			if (!IsAvailable(pos) || (mData[pos] != '"' && mData[pos] != '\'')) {
+				ThrowParsingError("Error parsing attribute value", pos);
+			}
+			const size_t valueEnd = Find(mData[pos], pos + 1);
+			if (valueEnd == std::string_view::npos) {
+				ThrowParsingError("Error parsing attribute value", pos);
+			}
+			attribute.second.clear();
+			AppendDecoded(attribute.second, mData.substr(pos + 1, valueEnd - pos - 1), true);
+			pos = valueEnd + 1;
+		}
+
+		mPos = pos;
+		mHasPending = true;
+		++mElementIndex;
+	}
+
+	void MoveTextToBuffer(bool& isDecoded, size_t textPos, size_t textSize)
+	{
+		if (!isDecoded)
+		{
+			mTextBuffer.append(mData.substr(textPos, textSize));
+			isDecoded = true;
+		}
+	}
+
+	/// <summary>
+	/// Appends the text with decoding entities and normalizing line endings (in attributes all whitespaces are converted to spaces).
+	/// </summary>
+	static void AppendDecoded(std::string& out, std::string_view str, bool isAttribute)
+	{
+		for (size_t i = 0; i < str.size(); ++i)
+		{
+			const char ch = str[i];
+			if (ch == '&')
+			{
+				if (const size_t endPos = str.find(';', i + 1); endPos != std::string_view::npos)
+				{
+					if (AppendEntity(out, str.substr(i + 1, endPos - i - 1)))
+					{
+						i = endPos;
+						continue;
+					}
+				}
+				out.push_back(ch);
+			}
+			else if (ch == '\r')
+			{
+				if (i + 1 < str.size() && str[i + 1] == '\n') {
+					++i;
+				}
+				out.push_back(isAttribute ? ' ' : '\n');
+			}
+			else if (isAttribute && (ch == '\t' || ch == '\n')) {
+				out.push_back(' ');
+			}
+			else {
+				out.push_back(ch);
+			}
+		}
+	}
+
+	static bool AppendEntity(std::string& out, std::string_view entity)
+	{
+		if (entity == "lt") out.push_back('<');
+		else if (entity == "gt") out.push_back('>');
+		else if (entity == "amp") out.push_back('&');
+		else if (entity == "quot") out.push_back('"');
+		else if (entity == "apos") out.push_back('\'');
+		else if (entity.size() > 1 && entity[0] == '#')
+		{
+			const bool isHex = entity[1] == 'x';
+			const char* begin = entity.data() + (isHex ? 2 : 1);
+			const char* end = entity.data() + entity.size();
+			uint32_t code = 0;
+			const auto result = std::from_chars(begin, end, code, isHex ? 16 : 10);
+			if (begin == end || result.ptr != end || result.ec != std::errc() || code > 0x10FFFF) {
+				return false;
+			}
+			const char32_t sym = code;
+			Convert::Utf8::Encode(&sym, &sym + 1, out);
+		}
+		else {
+			return false;
+		}
+		return true;
 	}
 
-	inline pugi::xml_attribute AppendAttribute(pugi::xml_node& node, const PugiXmlArchiveTraits::key_type& key) {
-		return node.append_attribute(key.c_str());
+	// Max size of data after bookmark which is kept in the stream buffer (the rest is re-read from the seekable stream)
+	static constexpr size_t MaxBookmarkedSize = 16 * Convert::CEncodedStreamReader<Convert::Utf8>::chunk_size;
+
+	std::istream* mInputStream = nullptr;
+	std::streampos mStreamStartPos = -1;
+	std::unique_ptr<Convert::CEncodedStreamReader<Convert::Utf8>> mEncodedStreamReader;
+	std::string mStreamBuffer;
+	std::string_view mData;
+	size_t mPos = 0;
+	// Size of data which was removed from the stream buffer (for reporting offset of errors)
+	size_t mDiscardedSize = 0;
+
+	std::vector<Element> mElements;
+	std::string mNames;
+	std::vector<Attributes> mAttributes;
+	bool mIsRootLoaded = false;
+
+	// Peeked element
+	bool mHasPending = false;
+	bool mIsPendingSelfClosed = false;
+	std::string mPendingName;
+	Attributes mPendingAttributes;
+	size_t mPendingPos = 0;
+	uint64_t mElementIndex = 0;
+
+	Bookmark mBookmark;
+	bool mHasBookmark = false;
+
+	std::string mTextBuffer;
+	std::exception_ptr mDeferredError;
+};
+
+namespace PugiXmlExtensions
+{
+	inline pugi::xml_node GetChild(pugi::xml_node& node, const PugiXmlArchiveTraits::key_type& key) {
+		return node.child(key.c_str());
 	}
 
-	inline pugi::xml_attribute AppendAttribute(pugi::xml_node& node, const pugi::char_t* key) {
-		return node.append_attribute(key);
+	inline pugi::xml_node GetChild(pugi::xml_node& node, const pugi::char_t* key) {
+		return node.child(key);
 	}
 
 	inline pugi::xml_attribute GetAttribute(pugi::xml_node& node, const PugiXmlArchiveTraits::key_type& key) {
@@ -125,26 +1132,155 @@ namespace PugiXmlExtensions
 		return false;
 	}
 
+	/// <summary>
+	/// Loads the value as view to the internal buffer of document (available only for native PugiXml char type).
+	/// </summary>
+	inline bool LoadValue(const pugi::xml_node& node, std::basic_string_view<pugi::char_t>& value, const SerializationOptions& serializationOptions)
+	{
+		// Empty node is treated as Null
+		if (const auto strValue = node.text().as_string(nullptr))
+		{
+			value = strValue;
+			return true;
+		}
+		return false;
+	}
+
+	/// <summary>
+	/// Converts the string in the PugiXml's char type to UTF-8 (which is used by streaming writer).
+	/// </summary>
+#ifdef PUGIXML_WCHAR_MODE
+	inline std::string ToUtf8(std::basic_string_view<pugi::char_t> str) {
+		return Convert::ToString(str);
+	}
+#else
+	inline std::string_view ToUtf8(std::string_view str) noexcept {
+		return str;
+	}
+#endif
+
+	/// <summary>
+	/// Formats the number into the buffer (must be at least 32 chars), floating point numbers are formatted with
+	/// the passed number of significant digits or in the shortest form which guarantees round-trip (when precision is zero).
+	/// </summary>
+	template <typename T>
+	std::string_view FormatNumber(T value, char* buffer, size_t bufferSize, uint8_t precision = 0)
+	{
+		if constexpr (std::is_same_v<T, bool>) {
+			return value ? "true" : "false";
+		}
+		else if constexpr (std::is_integral_v<T>)
+		{
+			const auto result = std::to_chars(buffer, buffer + bufferSize, value);
+			return { buffer, static_cast<size_t>(result.ptr - buffer) };
+		}
+		else {
+			return Convert::Detail::FormatFloat(value, buffer, bufferSize, precision);
+		}
+	}
+
 	template <typename T>
-	void SaveValue(const pugi::xml_node& node, const T& value) {
-		node.text().set(value);
+	void SaveValue(CXmlWriter& xmlWriter, const T& value)
+	{
+		char buffer[32];
+		xmlWriter.WriteText(FormatNumber(value, buffer, sizeof(buffer), xmlWriter.GetFormatOptions().floatPrecision));
+	}
+
+	inline void SaveValue(CXmlWriter&, const std::nullptr_t&) {}
+
+	inline void SaveValue(CXmlWriter& xmlWriter, const pugi::char_t* value) {
+		xmlWriter.WriteText(ToUtf8(value));
+	}
+
+	template <typename TSym, typename TStrAllocator>
+	void SaveValue(CXmlWriter& xmlWriter, const std::basic_string<TSym, std::char_traits<TSym>, TStrAllocator>& value)
+	{
+		if constexpr (std::is_same_v<TSym, char>)
+			xmlWriter.WriteText(value);
+		else
+			xmlWriter.WriteText(Convert::ToString(value));
+	}
+
+	inline void SaveValue(CXmlWriter& xmlWriter, std::basic_string_view<pugi::char_t> value) {
+		xmlWriter.WriteText(ToUtf8(value));
 	}
 
-	inline void SaveValue(const pugi::xml_node& node, const std::nullptr_t& value) {}
+	/// <summary>
+	/// The `std::string_view` is supported only when it matches to the char type of PugiXml (depends on PUGIXML_WCHAR_MODE).
+	/// </summary>
+	template <typename T>
+	constexpr bool is_supported_value_v = !std::is_same_v<T, std::string_view> || std::is_same_v<pugi::char_t, char>;
 
-	inline void SaveValue(const pugi::xml_node& node, const pugi::char_t* value) {
-		node.text().set(value);
+	/// <summary>
+	/// Converts the text which was read by the pull reader (always in UTF-8, regardless of PUGIXML_WCHAR_MODE).
+	/// </summary>
+	template <typename T>
+	bool LoadValueFromText(std::string_view text, T& value, const SerializationOptions& serializationOptions)
+	{
+		try
+		{
+			value = Convert::To<T>(text);
+			return true;
+		}
+		catch (const std::out_of_range&)
+		{
+			if (serializationOptions.overflowNumberPolicy == OverflowNumberPolicy::ThrowError)
+			{
+				throw SerializationException(SerializationErrorCode::Overflow,
+					"The size of target field is not sufficient to deserialize number: " + std::string(text));
+			}
+		}
+		catch (...)
+		{
+			if (serializationOptions.mismatchedTypesPolicy == MismatchedTypesPolicy::ThrowError)
+			{
+				throw SerializationException(SerializationErrorCode::MismatchedTypes,
+					"The type of target field does not match the value being loaded: " + std::string(text));
+			}
+		}
+		return false;
 	}
 
 	template <typename TSym, typename TStrAllocator>
-	void SaveValue(const pugi::xml_node& node, const std::basic_string<TSym, std::char_traits<TSym>, TStrAllocator>& value)
+	bool LoadValueFromText(std::string_view text, std::basic_string<TSym, std::char_traits<TSym>, TStrAllocator>& value, const SerializationOptions&)
 	{
-		if constexpr (std::is_same_v<TSym, pugi::char_t>)
-			node.text().set(value.c_str());
+		if constexpr (std::is_same_v<TSym, char>)
+			value.assign(text);
 		else
-			node.text().set(Convert::To<pugi::string_t>(value).c_str());
+			value = Convert::To<std::basic_string<TSym, std::char_traits<TSym>, TStrAllocator>>(text);
+		return true;
+	}
+
+	/// <summary>
+	/// Loads the value as view to the buffer of pull reader (valid until the next read).
+	/// </summary>
+	inline bool LoadValueFromText(std::string_view text, std::string_view& value, const SerializationOptions&) noexcept
+	{
+		value = text;
+		return true;
+	}
+
+	/// <summary>
+	/// Loads the value from the text of current element of the pull reader (empty element is treated as Null).
+	/// </summary>
+	template <typename T>
+	bool LoadValue(CXmlPullReader& xmlReader, T& value, const SerializationOptions& serializationOptions)
+	{
+		std::string_view text;
+		if constexpr (std::is_null_pointer_v<T>) {
+			return !xmlReader.ReadText(text);
+		}
+		else {
+			return xmlReader.ReadText(text) && LoadValueFromText(text, value, serializationOptions);
+		}
 	}
 
+	/// <summary>
+	/// The pull reader returns texts in UTF-8, so the `std::string_view` is supported regardless of PUGIXML_WCHAR_MODE.
+	/// </summary>
+	template <typename T>
+	constexpr bool is_pull_supported_value_v = !std::is_same_v<T, std::wstring_view>;
+
 	[[nodiscard]] inline std::string GetPath(const pugi::xml_node& node)
 	{
 #ifdef PUGIXML_WCHAR_MODE
@@ -174,11 +1310,31 @@ public:
 		, mValueIt(mNode.begin())
 	{ }
 
+	explicit PugiXmlArrayScope(CXmlWriter* xmlWriter, SerializationContext& serializationContext)
+		: TArchiveScope<TMode>(serializationContext)
+		, mXmlWriter(xmlWriter)
+	{
+		static_assert(TMode == SerializeMode::Save);
+	}
+
+	~PugiXmlArrayScope()
+	{
+		if constexpr (TMode == SerializeMode::Save) {
+			mXmlWriter->EndElement();
+		}
+	}
+
 	/// <summary>
 	/// Gets the current path in XML. Unicode symbols encode to UTF-8.
 	/// </summary>
-	[[nodiscard]] std::string GetPath() const {
-		return PugiXmlExtensions::GetPath(mNode);
+	[[nodiscard]] std::string GetPath() const
+	{
+		if constexpr (TMode == SerializeMode::Load) {
+			return PugiXmlExtensions::GetPath(mNode);
+		}
+		else {
+			return mXmlWriter->GetPath();
+		}
 	}
 
 	/// <summary>
@@ -198,7 +1354,7 @@ public:
 		return mValueIt == mNode.end();
 	}
 
-	template<typename T>
+	template<typename T, std::enable_if_t<PugiXmlExtensions::is_supported_value_v<T>, int> = 0>
 	bool SerializeValue(T& value)
 	{
 		if constexpr (TMode == SerializeMode::Load)
@@ -207,14 +1363,11 @@ public:
 		}
 		else
 		{
-			auto child = mNode.append_child("value");
-			if (!child.empty())
-			{
-				PugiXmlExtensions::SaveValue(child, value);
-				return true;
-			}
+			mXmlWriter->BeginElement("value");
+			PugiXmlExtensions::SaveValue(*mXmlWriter, value);
+			mXmlWriter->EndElement();
+			return true;
 		}
-		return false;
 	}
 
 	std::optional<PugiXmlArrayScope<TMode>> OpenArrayScope(size_t arraySize)
@@ -230,8 +1383,8 @@ public:
 		}
 		else
 		{
-			auto node = mNode.append_child(PUGIXML_TEXT("array"));
-			return node.empty() ? std::nullopt : std::make_optional<PugiXmlArrayScope<TMode>>(node, TArchiveScope<TMode>::GetContext());
+			mXmlWriter->BeginElement("array");
+			return std::make_optional<PugiXmlArrayScope<TMode>>(mXmlWriter, TArchiveScope<TMode>::GetContext());
 		}
 	}
 
@@ -248,8 +1401,8 @@ public:
 		}
 		else
 		{
-			auto node = mNode.append_child(PUGIXML_TEXT("object"));
-			return node.empty() ? std::nullopt : std::make_optional<PugiXmlObjectScope<TMode>>(node, TArchiveScope<TMode>::GetContext());
+			mXmlWriter->BeginElement("object");
+			return std::make_optional<PugiXmlObjectScope<TMode>>(mXmlWriter, TArchiveScope<TMode>::GetContext());
 		}
 	}
 
@@ -268,6 +1421,7 @@ protected:
 
 	pugi::xml_node mNode;
 	pugi::xml_node_iterator mValueIt;
+	CXmlWriter* mXmlWriter = nullptr;
 };
 
 
@@ -286,11 +1440,25 @@ public:
 		assert(mNode.type() == pugi::node_element);
 	}
 
+	explicit PugiXmlAttributeScope(CXmlWriter* xmlWriter, SerializationContext& serializationContext)
+		: TArchiveScope<TMode>(serializationContext)
+		, mXmlWriter(xmlWriter)
+	{
+		static_assert(TMode == SerializeMode::Save);
+		assert(mXmlWriter->IsStartTagOpened());
+	}
+
 	/// <summary>
 	/// Gets the current path in XML. Unicode symbols encode to UTF-8.
 	/// </summary>
-	[[nodiscard]] std::string GetPath() const {
-		return PugiXmlExtensions::GetPath(mNode);
+	[[nodiscard]] std::string GetPath() const
+	{
+		if constexpr (TMode == SerializeMode::Load) {
+			return PugiXmlExtensions::GetPath(mNode);
+		}
+		else {
+			return mXmlWriter->GetPath();
+		}
 	}
 
 	template <typename TKey, typename T, std::enable_if_t<std::is_arithmetic_v<T> || std::is_null_pointer_v<T>, int> = 0>
@@ -328,11 +1496,13 @@ public:
 		}
 		else
 		{
-			auto attr = PugiXmlExtensions::AppendAttribute(mNode, std::forward<TKey>(key));
-			if (attr.empty())
-				return false;
-			if constexpr (!std::is_null_pointer_v<T>) {
-				attr.set_value(value);
+			if constexpr (std::is_null_pointer_v<T>) {
+				mXmlWriter->WriteAttribute(PugiXmlExtensions::ToUtf8(key), {});
+			}
+			else
+			{
+				char buffer[32];
+				mXmlWriter->WriteAttribute(PugiXmlExtensions::ToUtf8(key), PugiXmlExtensions::FormatNumber(value, buffer, sizeof(buffer), mXmlWriter->GetFormatOptions().floatPrecision));
 			}
 			return true;
 		}
@@ -355,20 +1525,17 @@ public:
 		}
 		else
 		{
-			auto attr = PugiXmlExtensions::AppendAttribute(mNode, std::forward<TKey>(key));
-			if (attr.empty())
-				return false;
-
-			if constexpr (std::is_same_v<TSym, pugi::char_t>)
-				attr.set_value(value.c_str());
+			if constexpr (std::is_same_v<TSym, char>)
+				mXmlWriter->WriteAttribute(PugiXmlExtensions::ToUtf8(key), value);
 			else
-				attr.set_value(Convert::To<pugi::string_t>(value).c_str());
+				mXmlWriter->WriteAttribute(PugiXmlExtensions::ToUtf8(key), Convert::ToString(value));
 			return true;
 		}
 	}
 
 protected:
 	pugi::xml_node mNode;
+	CXmlWriter* mXmlWriter = nullptr;
 };
 
 
@@ -419,6 +1586,20 @@ public:
 		assert(mNode.type() == pugi::node_element);
 	}
 
+	explicit PugiXmlObjectScope(CXmlWriter* xmlWriter, SerializationContext& serializationContext)
+		: TArchiveScope<TMode>(serializationContext)
+		, mXmlWriter(xmlWriter)
+	{
+		static_assert(TMode == SerializeMode::Save);
+	}
+
+	~PugiXmlObjectScope()
+	{
+		if constexpr (TMode == SerializeMode::Save) {
+			mXmlWriter->EndElement();
+		}
+	}
+
 	[[nodiscard]] key_const_iterator cbegin() const {
 		return key_const_iterator(mNode.begin());
 	}
@@ -437,26 +1618,31 @@ public:
 	/// <summary>
 	/// Gets the current path in XML. Unicode symbols encode to UTF-8.
 	/// </summary>
-	[[nodiscard]] std::string GetPath() const {
-		return PugiXmlExtensions::GetPath(mNode);
+	[[nodiscard]] std::string GetPath() const
+	{
+		if constexpr (TMode == SerializeMode::Load) {
+			return PugiXmlExtensions::GetPath(mNode);
+		}
+		else {
+			return mXmlWriter->GetPath();
+		}
 	}
 
-	template <typename TKey, typename T>
+	template <typename TKey, typename T, std::enable_if_t<PugiXmlExtensions::is_supported_value_v<T>, int> = 0>
 	bool SerializeValue(TKey&& key, T& value)
 	{
 		if constexpr (TMode == SerializeMode::Load)
 		{
-			auto child = PugiXmlExtensions::GetChild(mNode, std::forward<TKey>(key));
+			auto child = FindChild(key);
 			if (child.empty())
 				return false;
 			return PugiXmlExtensions::LoadValue(child, value, this->GetOptions());
 		}
 		else
 		{
-			auto child = PugiXmlExtensions::AppendChild(mNode, std::forward<TKey>(key));
-			if (child.empty())
-				return false;
-			PugiXmlExtensions::SaveValue(child, value);
+			mXmlWriter->BeginElement(PugiXmlExtensions::ToUtf8(key));
+			PugiXmlExtensions::SaveValue(*mXmlWriter, value);
+			mXmlWriter->EndElement();
 			return true;
 		}
 	}
@@ -466,38 +1652,76 @@ public:
 	{
 		if constexpr (TMode == SerializeMode::Load)
 		{
-			auto child = PugiXmlExtensions::GetChild(mNode, std::forward<TKey>(key));
+			auto child = FindChild(key);
 			return child.first_child().type() == pugi::node_element ? std::make_optional<PugiXmlObjectScope<TMode>>(child, TArchiveScope<TMode>::GetContext()) : std::nullopt;
 		}
 		else
 		{
-			auto child = PugiXmlExtensions::AppendChild(mNode, std::forward<TKey>(key));
-			return child.empty() ? std::nullopt : std::make_optional<PugiXmlObjectScope<TMode>>(child, TArchiveScope<TMode>::GetContext());
+			mXmlWriter->BeginElement(PugiXmlExtensions::ToUtf8(key));
+			return std::make_optional<PugiXmlObjectScope<TMode>>(mXmlWriter, TArchiveScope<TMode>::GetContext());
 		}
 	}
 
 	template <typename TKey>
 	std::optional<PugiXmlArrayScope<TMode>> OpenArrayScope(TKey&& key, size_t arraySize)
 	{
-		if constexpr (TMode == SerializeMode::Load)
+		if constexpr (TMode == SerializeMode::Load)
+		{
+			auto node = FindChild(key);
+			return node.first_child().type() == pugi::node_element ? std::make_optional<PugiXmlArrayScope<TMode>>(node, TArchiveScope<TMode>::GetContext()) : std::nullopt;
+		}
+		else
+		{
+			mXmlWriter->BeginElement(PugiXmlExtensions::ToUtf8(key));
+			return std::make_optional<PugiXmlArrayScope<TMode>>(mXmlWriter, TArchiveScope<TMode>::GetContext());
+		}
+	}
+
+	std::optional<PugiXmlAttributeScope<TMode>> OpenAttributeScope()
+	{
+		if constexpr (TMode == SerializeMode::Load)
+		{
+			return std::make_optional<PugiXmlAttributeScope<TMode>>(mNode, TArchiveScope<TMode>::GetContext());
+		}
+		else
+		{
+			// Attributes are a part of start tag, which is closed when the first child element is written
+			if (!mXmlWriter->IsStartTagOpened())
+			{
+				throw SerializationException(SerializationErrorCode::OutOfRange,
+					"XML attributes must be saved before child elements, path: " + mXmlWriter->GetPath());
+			}
+			return std::make_optional<PugiXmlAttributeScope<TMode>>(mXmlWriter, TArchiveScope<TMode>::GetContext());
+		}
+	}
+
+protected:
+	/// <summary>
+	/// Finds the child element by name, starting from the next sibling of the last found one (wraps around only on a miss).
+	/// Elements are usually loaded in the same order as they were saved, so loading of all children is linear.
+	/// </summary>
+	pugi::xml_node FindChild(std::basic_string_view<pugi::char_t> name)
+	{
+		const auto startNode = mLastChild ? mLastChild.next_sibling() : mNode.first_child();
+		for (auto node = startNode; node; node = node.next_sibling())
 		{
-			auto node = PugiXmlExtensions::GetChild(mNode, std::forward<TKey>(key));
-			return node.first_child().type() == pugi::node_element ? std::make_optional<PugiXmlArrayScope<TMode>>(node, TArchiveScope<TMode>::GetContext()) : std::nullopt;
+			if (node.type() == pugi::node_element && name == node.name()) {
+				return mLastChild = node;
+			}
 		}
-		else
+		for (auto node = mNode.first_child(); node != startNode; node = node.next_sibling())
 		{
-			auto node = PugiXmlExtensions::AppendChild(mNode, std::forward<TKey>(key));
-			return node.empty() ? std::nullopt : std::make_optional<PugiXmlArrayScope<TMode>>(node, TArchiveScope<TMode>::GetContext());
+			if (node.type() == pugi::node_element && name == node.name()) {
+				return mLastChild = node;
+			}
 		}
+		return {};
 	}
 
-	std::optional<PugiXmlAttributeScope<TMode>> OpenAttributeScope()
-	{
-		return std::make_optional<PugiXmlAttributeScope<TMode>>(mNode, TArchiveScope<TMode>::GetContext());
-	}
-
-protected:
 	pugi::xml_node mNode;
+	// The last found child element (the search of next one starts from its sibling)
+	pugi::xml_node mLastChild;
+	CXmlWriter* mXmlWriter = nullptr;
 };
 
 
@@ -510,43 +1734,63 @@ class PugiXmlRootScope final : public TArchiveScope<TMode>, public PugiXmlArchiv
 public:
 	PugiXmlRootScope(const std::string& inputStr, SerializationContext& serializationContext)
 		: TArchiveScope<TMode>(serializationContext)
-		, mOutput(nullptr)
 	{
 		static_assert(TMode == SerializeMode::Load, "BitSerializer. This data type can be used only in 'Load' mode.");
-		const auto result = mRootXml.load_buffer(inputStr.data(), inputStr.size(), pugi::parse_default, pugi::encoding_auto);
+		const auto result = mRootXml.load_buffer(inputStr.data(), inputStr.size(), GetParseFlags(serializationContext), pugi::encoding_auto);
+		if (!result)
+			throw ParsingException(result.description(), 0, result.offset);
+	}
+
+	/// <summary>
+	/// Loads XML from the mutable buffer, which is parsed in place (without copying, texts of document point to the buffer).
+	/// </summary>
+	PugiXmlRootScope(const CMutableBuffer& inputBuffer, SerializationContext& serializationContext)
+		: TArchiveScope<TMode>(serializationContext)
+	{
+		static_assert(TMode == SerializeMode::Load, "BitSerializer. This data type can be used only in 'Load' mode.");
+		const auto result = mRootXml.load_buffer_inplace(inputBuffer.data(), inputBuffer.size(), GetParseFlags(serializationContext), pugi::encoding_auto);
 		if (!result)
 			throw ParsingException(result.description(), 0, result.offset);
 	}
 
 	PugiXmlRootScope(std::string& outputStr, SerializationContext& serializationContext)
 		: TArchiveScope<TMode>(serializationContext)
-		, mOutput(&outputStr)
 	{
 		static_assert(TMode == SerializeMode::Save, "BitSerializer. This data type can be used only in 'Save' mode.");
+		outputStr.clear();
+		mXmlWriter = std::make_unique<CXmlWriter>(outputStr, serializationContext.GetOptions().formatOptions);
+		mXmlWriter->WriteDeclaration();
 	}
 
 	PugiXmlRootScope(std::istream& inputStream, SerializationContext& serializationContext)
 		: TArchiveScope<TMode>(serializationContext)
-		, mOutput(nullptr)
 	{
 		static_assert(TMode == SerializeMode::Load, "BitSerializer. This data type can be used only in 'Load' mode.");
-		const auto result = mRootXml.load(inputStream);
+		const auto result = mRootXml.load(inputStream, GetParseFlags(serializationContext), pugi::encoding_auto);
 		if (!result)
 			throw ParsingException(result.description(), 0, result.offset);
 	}
 
 	PugiXmlRootScope(std::ostream& outputStream, SerializationContext& serializationContext)
 		: TArchiveScope<TMode>(serializationContext)
-		, mOutput(&outputStream)
 	{
 		static_assert(TMode == SerializeMode::Save, "BitSerializer. This data type can be used only in 'Save' mode.");
+		const auto& options = serializationContext.GetOptions();
+		mXmlWriter = std::make_unique<CXmlStreamWriter>(outputStream, options.formatOptions, options.streamOptions);
+		mXmlWriter->WriteDeclaration();
 	}
 
 	/// <summary>
 	/// Gets the current path in XML. Unicode symbols encode to UTF-8.
 	/// </summary>
-	[[nodiscard]] std::string GetPath() const {
-		return PugiXmlExtensions::GetPath(mRootXml);
+	[[nodiscard]] std::string GetPath() const
+	{
+		if constexpr (TMode == SerializeMode::Load) {
+			return PugiXmlExtensions::GetPath(mRootXml);
+		}
+		else {
+			return mXmlWriter->GetPath();
+		}
 	}
 
 	std::optional<PugiXmlArrayScope<TMode>> OpenArrayScope(size_t arraySize)
@@ -558,8 +1802,8 @@ public:
 		}
 		else
 		{
-			auto node = mRootXml.append_child(PUGIXML_TEXT("array"));
-			return node.empty() ? std::nullopt : std::make_optional<PugiXmlArrayScope<TMode>>(node, TArchiveScope<TMode>::GetContext());
+			mXmlWriter->BeginElement("array");
+			return std::make_optional<PugiXmlArrayScope<TMode>>(mXmlWriter.get(), TArchiveScope<TMode>::GetContext());
 		}
 	}
 
@@ -573,8 +1817,8 @@ public:
 		}
 		else
 		{
-			auto node = PugiXmlExtensions::AppendChild(mRootXml, std::forward<TKey>(key));
-			return node.empty() ? std::nullopt : std::make_optional<PugiXmlArrayScope<TMode>>(node, TArchiveScope<TMode>::GetContext());
+			mXmlWriter->BeginElement(PugiXmlExtensions::ToUtf8(key));
+			return std::make_optional<PugiXmlArrayScope<TMode>>(mXmlWriter.get(), TArchiveScope<TMode>::GetContext());
 		}
 	}
 
@@ -587,8 +1831,8 @@ public:
 		}
 		else
 		{
-			auto node = mRootXml.append_child(PUGIXML_TEXT("root"));
-			return node.empty() ? std::nullopt : std::make_optional<PugiXmlObjectScope<TMode>>(node, TArchiveScope<TMode>::GetContext());
+			mXmlWriter->BeginElement("root");
+			return std::make_optional<PugiXmlObjectScope<TMode>>(mXmlWriter.get(), TArchiveScope<TMode>::GetContext());
 		}
 	}
 
@@ -601,8 +1845,8 @@ public:
 		}
 		else
 		{
-			auto child = PugiXmlExtensions::AppendChild(mRootXml, std::forward<TKey>(key));
-			return child.empty() ? std::nullopt : std::make_optional<PugiXmlObjectScope<TMode>>(child, TArchiveScope<TMode>::GetContext());
+			mXmlWriter->BeginElement(PugiXmlExtensions::ToUtf8(key));
+			return std::make_optional<PugiXmlObjectScope<TMode>>(mXmlWriter.get(), TArchiveScope<TMode>::GetContext());
 		}
 	}
 
@@ -610,58 +1854,387 @@ public:
 	{
 		if constexpr (TMode == SerializeMode::Save)
 		{
-			std::visit([this](auto&& arg)
-			{
-				using T = std::decay_t<decltype(arg)>;
+			mXmlWriter->Flush();
+		}
+	}
 
-				auto& options = TArchiveScope<TMode>::GetOptions();
-				unsigned int flags = options.formatOptions.enableFormat ? pugi::format_indent : pugi::format_raw;
-				const pugi::string_t indent(options.formatOptions.paddingCharNum, options.formatOptions.paddingChar);
-				assert(!options.formatOptions.enableFormat || !indent.empty());
+private:
+	static unsigned int GetParseFlags(const SerializationContext& serializationContext) noexcept {
+		return serializationContext.GetOptions().parseFlags.value_or(pugi::parse_default);
+	}
 
-				if constexpr (std::is_same_v<T, std::string*>)
-				{
-					std::ostringstream stream;
-					auto decl = mRootXml.prepend_child(pugi::node_declaration);
-					decl.append_attribute(PUGIXML_TEXT("version")) = PUGIXML_TEXT("1.0");
-					mRootXml.print(stream, indent.c_str(), flags, pugi::encoding_utf8);
-					*arg = stream.str();
-				}
-				else if constexpr (std::is_same_v<T, std::ostream*>)
-				{
-					flags |= options.streamOptions.writeBom ? pugi::format_write_bom : 0;
-					mRootXml.save(*arg, indent.c_str(), flags, ToPugiUtfType(options.streamOptions.encoding));
-				}
-			}, mOutput);
-			mOutput = nullptr;
+	pugi::xml_document mRootXml;
+	// Streaming writer which is used in the save mode (the DOM is not built)
+	std::unique_ptr<CXmlWriter> mXmlWriter;
+};
+
+
+class XmlPullObjectScope;
+
+/// <summary>
+/// XML scope for loading arrays via the pull reader (items are loaded in the document order).
+/// </summary>
+class XmlPullArrayScope final : public TArchiveScope<SerializeMode::Load>, public PugiXmlArchiveTraits
+{
+public:
+	XmlPullArrayScope(CXmlPullReader* xmlReader, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mXmlReader(xmlReader)
+	{ }
+
+	~XmlPullArrayScope()
+	{
+		mXmlReader->LeaveElement();
+	}
+
+	/// <summary>
+	/// Returns the estimated number of items to load (the size is unknown until all items are read).
+	/// </summary>
+	[[nodiscard]] static size_t GetEstimatedSize() noexcept {
+		return 0;
+	}
+
+	/// <summary>
+	/// Gets the current path in XML. Unicode symbols encode to UTF-8.
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const
+	{
+		return mXmlReader->GetPath() + path_separator + Convert::ToString(mIndex);
+	}
+
+	/// <summary>
+	/// Returns `true` when all no more values to load.
+	/// </summary>
+	[[nodiscard]] bool IsEnd() const
+	{
+		return !mXmlReader->PeekElement();
+	}
+
+	template <typename T, std::enable_if_t<PugiXmlExtensions::is_pull_supported_value_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		EnterNextItem();
+		const bool result = PugiXmlExtensions::LoadValue(*mXmlReader, value, GetOptions());
+		mXmlReader->LeaveElement();
+		return result;
+	}
+
+	std::optional<XmlPullObjectScope> OpenObjectScope();
+
+	std::optional<XmlPullArrayScope> OpenArrayScope(size_t)
+	{
+		EnterNextItem();
+		return std::make_optional<XmlPullArrayScope>(mXmlReader, GetContext());
+	}
+
+private:
+	void EnterNextItem()
+	{
+		if (!mXmlReader->PeekElement()) {
+			throw SerializationException(SerializationErrorCode::OutOfRange, "No more items to load");
+		}
+		mXmlReader->EnterElement();
+		++mIndex;
+	}
+
+	CXmlPullReader* mXmlReader;
+	size_t mIndex = 0;
+};
+
+
+/// <summary>
+/// XML scope for loading attributes of the current element via the pull reader.
+/// </summary>
+class XmlPullAttributeScope final : public TArchiveScope<SerializeMode::Load>, public PugiXmlArchiveTraits
+{
+public:
+	XmlPullAttributeScope(CXmlPullReader* xmlReader, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mXmlReader(xmlReader)
+	{ }
+
+	/// <summary>
+	/// Gets the current path in XML. Unicode symbols encode to UTF-8.
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const
+	{
+		return mXmlReader->GetPath();
+	}
+
+	template <typename TKey, typename T, std::enable_if_t<std::is_arithmetic_v<T> || std::is_null_pointer_v<T>, int> = 0>
+	bool SerializeValue(TKey&& key, T& value)
+	{
+		std::string_view text;
+		if (!mXmlReader->FindAttribute(PugiXmlExtensions::ToUtf8(key), text)) {
+			return std::is_null_pointer_v<T>;
+		}
+		if constexpr (std::is_null_pointer_v<T>) {
+			return true;
 		}
+		else {
+			return PugiXmlExtensions::LoadValueFromText(text, value, GetOptions());
+		}
+	}
+
+	template <typename TKey, typename TSym, typename TStrAllocator>
+	bool SerializeValue(TKey&& key, std::basic_string<TSym, std::char_traits<TSym>, TStrAllocator>& value)
+	{
+		std::string_view text;
+		return mXmlReader->FindAttribute(PugiXmlExtensions::ToUtf8(key), text)
+			&& PugiXmlExtensions::LoadValueFromText(text, value, GetOptions());
 	}
 
 private:
-	static pugi::xml_encoding ToPugiUtfType(const Convert::UtfType utfType)
+	CXmlPullReader* mXmlReader;
+};
+
+
+/// <summary>
+/// XML scope for loading objects via the pull reader.
+/// </summary>
+/// <remarks>
+/// Child elements are searched forward from the current position, elements which are skipped on the way can't be loaded later.
+/// Therefore, the order of elements in the document should match the order of serialization (as the archive saves them).
+/// </remarks>
+class XmlPullObjectScope final : public TArchiveScope<SerializeMode::Load>, public PugiXmlArchiveTraits
+{
+public:
+	/// <summary>
+	/// Constant iterator for keys of elements in the document order.
+	/// The element which is not loaded by the key is skipped when the iterator is incremented.
+	/// </summary>
+	class key_const_iterator
 	{
-		switch (utfType)
+		friend XmlPullObjectScope;
+
+		CXmlPullReader* mXmlReader;
+		// Sequence number of the element in the document (zero is the end)
+		uint64_t mElementIndex;
+
+		explicit key_const_iterator(CXmlPullReader* xmlReader)
+			: mXmlReader(xmlReader)
+			, mElementIndex(xmlReader && xmlReader->PeekElement() ? xmlReader->GetPendingIndex() : 0)
+		{ }
+
+	public:
+		bool operator==(const key_const_iterator& rhs) const noexcept {
+			return this->mElementIndex == rhs.mElementIndex;
+		}
+		bool operator!=(const key_const_iterator& rhs) const noexcept {
+			return this->mElementIndex != rhs.mElementIndex;
+		}
+
+		key_const_iterator& operator++()
 		{
-		case Convert::UtfType::Utf8:
-			return pugi::xml_encoding::encoding_utf8;
-		case Convert::UtfType::Utf16le:
-			return pugi::xml_encoding::encoding_utf16_le;
-		case Convert::UtfType::Utf16be:
-			return pugi::xml_encoding::encoding_utf16_be;
-		case Convert::UtfType::Utf32le:
-			return pugi::xml_encoding::encoding_utf32_le;
-		case Convert::UtfType::Utf32be:
-			return pugi::xml_encoding::encoding_utf32_be;
-		default:
-			const auto strEncodingType = Convert::TryTo<std::string>(utfType);
-			throw SerializationException(SerializationErrorCode::UnsupportedEncoding,
-				"The archive does not support encoding: " +
-				(strEncodingType.has_value() ? strEncodingType.value() : std::to_string(static_cast<int>(utfType))));
+			if (mXmlReader->PeekElement() && mXmlReader->GetPendingIndex() == mElementIndex) {
+				mXmlReader->SkipElement();
+			}
+			mElementIndex = mXmlReader->PeekElement() ? mXmlReader->GetPendingIndex() : 0;
+			return *this;
 		}
+
+		key_type operator*() const
+		{
+#ifdef PUGIXML_WCHAR_MODE
+			return Convert::To<key_type>(mXmlReader->GetPendingName());
+#else
+			return key_type(mXmlReader->GetPendingName());
+#endif
+		}
+	};
+
+	XmlPullObjectScope(CXmlPullReader* xmlReader, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mXmlReader(xmlReader)
+	{ }
+
+	~XmlPullObjectScope()
+	{
+		mXmlReader->LeaveElement();
 	}
 
-	pugi::xml_document mRootXml;
-	std::variant<std::nullptr_t, std::string*, std::ostream*> mOutput;
+	[[nodiscard]] key_const_iterator cbegin() const {
+		return key_const_iterator(mXmlReader);
+	}
+
+	[[nodiscard]] key_const_iterator cend() const {
+		return key_const_iterator(nullptr);
+	}
+
+	/// <summary>
+	/// Returns the estimated number of items to load (the size is unknown until all items are read).
+	/// </summary>
+	[[nodiscard]] static size_t GetEstimatedSize() noexcept {
+		return 0;
+	}
+
+	/// <summary>
+	/// Gets the current path in XML. Unicode symbols encode to UTF-8.
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const
+	{
+		return mXmlReader->GetPath();
+	}
+
+	template <typename TKey, typename T, std::enable_if_t<PugiXmlExtensions::is_pull_supported_value_v<T>, int> = 0>
+	bool SerializeValue(TKey&& key, T& value)
+	{
+		if (!FindElement(key)) {
+			return false;
+		}
+		mXmlReader->EnterElement();
+		const bool result = PugiXmlExtensions::LoadValue(*mXmlReader, value, GetOptions());
+		mXmlReader->LeaveElement();
+		return result;
+	}
+
+	template <typename TKey>
+	std::optional<XmlPullObjectScope> OpenObjectScope(TKey&& key)
+	{
+		if (!FindElement(key)) {
+			return std::nullopt;
+		}
+		mXmlReader->EnterElement();
+		return std::make_optional<XmlPullObjectScope>(mXmlReader, GetContext());
+	}
+
+	template <typename TKey>
+	std::optional<XmlPullArrayScope> OpenArrayScope(TKey&& key, size_t)
+	{
+		if (!FindElement(key)) {
+			return std::nullopt;
+		}
+		mXmlReader->EnterElement();
+		return std::make_optional<XmlPullArrayScope>(mXmlReader, GetContext());
+	}
+
+	std::optional<XmlPullAttributeScope> OpenAttributeScope()
+	{
+		return std::make_optional<XmlPullAttributeScope>(mXmlReader, GetContext());
+	}
+
+private:
+	/// <summary>
+	/// Finds the child element by name, skipping all elements before it.
+	/// </summary>
+	template <typename TKey>
+	bool FindElement(const TKey& key)
+	{
+		const auto name = PugiXmlExtensions::ToUtf8(key);
+		if (!mXmlReader->PeekElement()) {
+			return false;
+		}
+		if (mXmlReader->GetPendingName() == name) {
+			return true;
+		}
+
+		// The element may be missed (e.g. optional field), so the position is restored when it is not found for loading the rest fields
+		mXmlReader->SetBookmark();
+		do
+		{
+			mXmlReader->SkipElement();
+			if (!mXmlReader->PeekElement())
+			{
+				mXmlReader->RestoreBookmark();
+				return false;
+			}
+		} while (mXmlReader->GetPendingName() != name);
+		mXmlReader->ReleaseBookmark();
+		return true;
+	}
+
+	CXmlPullReader* mXmlReader;
+};
+
+inline std::optional<XmlPullObjectScope> XmlPullArrayScope::OpenObjectScope()
+{
+	EnterNextItem();
+	return std::make_optional<XmlPullObjectScope>(mXmlReader, GetContext());
+}
+
+
+/// <summary>
+/// XML root scope for loading via the pull reader (from the string or incrementally from the stream).
+/// </summary>
+class XmlPullRootScope final : public TArchiveScope<SerializeMode::Load>, public PugiXmlArchiveTraits
+{
+public:
+	XmlPullRootScope(std::string_view inputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mXmlReader(inputData)
+	{ }
+
+	XmlPullRootScope(std::istream& inputStream, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mXmlReader(inputStream)
+	{ }
+
+	/// <summary>
+	/// Gets the current path in XML. Unicode symbols encode to UTF-8.
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const
+	{
+		return mXmlReader.GetPath();
+	}
+
+	std::optional<XmlPullArrayScope> OpenArrayScope(size_t)
+	{
+		EnterDocumentElement();
+		return std::make_optional<XmlPullArrayScope>(&mXmlReader, GetContext());
+	}
+
+	template <typename TKey>
+	std::optional<XmlPullArrayScope> OpenArrayScope(TKey&& key, size_t)
+	{
+		if (!EnterDocumentElement(key)) {
+			return std::nullopt;
+		}
+		return std::make_optional<XmlPullArrayScope>(&mXmlReader, GetContext());
+	}
+
+	std::optional<XmlPullObjectScope> OpenObjectScope()
+	{
+		EnterDocumentElement();
+		return std::make_optional<XmlPullObjectScope>(&mXmlReader, GetContext());
+	}
+
+	template <typename TKey>
+	std::optional<XmlPullObjectScope> OpenObjectScope(TKey&& key)
+	{
+		if (!EnterDocumentElement(key)) {
+			return std::nullopt;
+		}
+		return std::make_optional<XmlPullObjectScope>(&mXmlReader, GetContext());
+	}
+
+	void Finalize()
+	{
+		mXmlReader.CheckError();
+	}
+
+private:
+	void EnterDocumentElement()
+	{
+		if (!mXmlReader.PeekElement()) {
+			throw ParsingException("No document element found");
+		}
+		mXmlReader.EnterElement();
+	}
+
+	template <typename TKey>
+	bool EnterDocumentElement(const TKey& key)
+	{
+		if (!mXmlReader.PeekElement()) {
+			throw ParsingException("No document element found");
+		}
+		if (mXmlReader.GetPendingName() != PugiXmlExtensions::ToUtf8(key)) {
+			return false;
+		}
+		mXmlReader.EnterElement();
+		return true;
+	}
+
+	CXmlPullReader mXmlReader;
 };
 
 }
@@ -671,16 +2244,34 @@ private:
 /// XML archive based on the PugiXml library.
 /// Supports load/save from:
 /// - <c>std::string</c>: UTF-8
+/// - <c>CMutableBuffer</c>: UTF-8, the buffer is parsed in place (only for loading)
 /// - <c>std::istream</c> and <c>std::ostream</c>: UTF-8, UTF-16LE, UTF-16BE, UTF-32LE, UTF-32BE
 /// </summary>
 /// <remarks>
 /// The XML-key type is depends from global definition in the PugiXml 'PUGIXML_WCHAR_MODE' in the PugiXml, by default uses std::string.
 /// For stay your code cross compiled you can use macros PUGIXML_TEXT("MyKey") from PugiXml or
 /// use BitSerializer::AutoKeyValue() but with possible small overhead for converting.
+/// The output XML is written by the streaming writer (without building DOM), so saving requires memory only for the output.
 /// </remarks>
 using XmlArchive = TArchiveBase<
 	Detail::PugiXmlArchiveTraits,
 	Detail::PugiXmlRootScope<SerializeMode::Load>,
 	Detail::PugiXmlRootScope<SerializeMode::Save>>;
 
+/// <summary>
+/// XML archive with the pull reader for loading huge documents (the format is the same as in the `XmlArchive`).
+/// The document is read in the order of serialization (without building DOM), from the string or incrementally from the stream.
+/// Supports load/save from:
+/// - <c>std::string</c>: UTF-8
+/// - <c>std::istream</c> and <c>std::ostream</c>: UTF-8, UTF-16LE, UTF-16BE, UTF-32LE, UTF-32BE
+/// </summary>
+/// <remarks>
+/// Elements are searched only forward, so they should be stored in the same order as the object is serialized.
+/// Elements which are not loaded (unknown or out of order) are skipped, loaded `std::string_view` is valid until the next read.
+/// </remarks>
+using XmlPullArchive = TArchiveBase<
+	Detail::PugiXmlArchiveTraits,
+	Detail::XmlPullRootScope,
+	Detail::PugiXmlRootScope<SerializeMode::Save>>;
+
 }
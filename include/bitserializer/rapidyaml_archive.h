@@ -3,12 +3,22 @@
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
 #pragma once
+#include <algorithm>
 #include <cassert>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <istream>
+#include <ostream>
+#include <limits>
+#include <string>
+#include <string_view>
 #include <type_traits>
 #include <optional>
 #include <variant>
 #include "bitserializer/serialization_detail/errors_handling.h"
 #include "bitserializer/serialization_detail/archive_base.h"
+#include "bitserializer/serialization_detail/archive_helpers.h"
 
 // External dependency (Rapid YAML)
 #include <c4/format.hpp>
@@ -92,6 +102,12 @@ namespace BitSerializer::Yaml::RapidYaml {
 				const auto str = std::string_view(yamlValue.val().data(), yamlValue.val().size());
 				try
 				{
+					if constexpr (std::is_floating_point_v<T>)
+					{
+						if (ParseNonFiniteFloat(str, value)) {
+							return true;
+						}
+					}
 					if constexpr (!std::is_null_pointer_v<T>)
 					{
 						value = Convert::To<T>(str);
@@ -137,13 +153,40 @@ namespace BitSerializer::Yaml::RapidYaml {
 				return true;
 			}
 
+			/// <summary>
+			/// Loads the value as view to the internal buffer of YAML tree (or to the input buffer, when it was parsed in place).
+			/// </summary>
+			static bool LoadValue(const RapidYamlNode& yamlValue, std::string_view& value, const SerializationOptions& serializationOptions)
+			{
+				if (!yamlValue.is_val() && !yamlValue.is_keyval())
+					return false;
+
+				if (IsNullYamlValue(yamlValue.val())) {
+					return false;
+				}
+
+				const auto str = yamlValue.val();
+				value = std::string_view(str.data(), str.size());
+				return true;
+			}
+
 			template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
-			static void SaveValue(RapidYamlNode& yamlValue, T& value)
+			static void SaveValue(RapidYamlNode& yamlValue, T& value, const SerializationOptions& serializationOptions)
 			{
 				if constexpr (std::is_null_pointer_v<T>) {
 					yamlValue << nullValue;
 				} else if constexpr (std::is_floating_point_v<T>) {
-					yamlValue << c4::fmt::real(value, std::numeric_limits<T>::max_digits10, c4::RealFormat_e::FTOA_SCIENT);
+					if (std::isfinite(value))
+					{
+						char buffer[32];
+						const auto str = Convert::Detail::FormatFloat(value, buffer, sizeof(buffer), serializationOptions.formatOptions.floatPrecision);
+						yamlValue << c4::csubstr(str.data(), str.size());
+					}
+					else
+					{
+						// YAML has own representation for infinity and NaN
+						yamlValue << (std::isnan(value) ? c4::csubstr(".nan") : (value > 0 ? c4::csubstr(".inf") : c4::csubstr("-.inf")));
+					}
 				} else if constexpr (std::is_same_v<T, char>) {
 					// Need to extend size of type for prevent save as character
 					yamlValue << static_cast<int16_t>(value);
@@ -153,7 +196,7 @@ namespace BitSerializer::Yaml::RapidYaml {
 			}
 
 			template <typename TSym, typename TAllocator>
-			static void SaveValue(RapidYamlNode& yamlValue, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+			static void SaveValue(RapidYamlNode& yamlValue, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value, const SerializationOptions&)
 			{
 				if constexpr (std::is_same_v<TSym, std::string::value_type>)
 					yamlValue << value;
@@ -161,6 +204,35 @@ namespace BitSerializer::Yaml::RapidYaml {
 					yamlValue << Convert::To<std::string>(value);
 			}
 
+			static void SaveValue(RapidYamlNode& yamlValue, std::string_view& value, const SerializationOptions&)
+			{
+				yamlValue << c4::csubstr(value.data(), value.size());
+			}
+
+			/// <summary>
+			/// Parses YAML representation of infinity and NaN (`.inf`, `-.inf`, `.nan` in any of allowed cases).
+			/// </summary>
+			template <typename T>
+			static bool ParseNonFiniteFloat(std::string_view str, T& value)
+			{
+				if (str.size() < 4) {
+					return false;
+				}
+				const char sign = str.front();
+				const auto name = (sign == '-' || sign == '+') ? str.substr(1) : str;
+				if (name == ".inf" || name == ".Inf" || name == ".INF")
+				{
+					value = sign == '-' ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+					return true;
+				}
+				if (str == ".nan" || str == ".NaN" || str == ".NAN")
+				{
+					value = std::numeric_limits<T>::quiet_NaN();
+					return true;
+				}
+				return false;
+			}
+
 			static bool IsNullYamlValue(c4::csubstr str)
 			{
 				return str.data() == nullptr ||
@@ -235,10 +307,8 @@ namespace BitSerializer::Yaml::RapidYaml {
 				}
 				else
 				{
-					assert(mIndex < GetEstimatedSize());
-					auto yamlValue = mNode.append_child();
-					SaveValue(yamlValue, value);
-					mIndex++;
+					auto yamlValue = AppendNextItem();
+					SaveValue(yamlValue, value, this->GetOptions());
 					return true;
 				}
 				return false;
@@ -260,10 +330,8 @@ namespace BitSerializer::Yaml::RapidYaml {
 				}
 				else
 				{
-					assert(mIndex < GetEstimatedSize());
-					auto yamlValue = mNode.append_child();
+					auto yamlValue = AppendNextItem();
 					yamlValue |= ryml::MAP;
-					mIndex++;
 					return std::make_optional<RapidYamlObjectScope<TMode>>(yamlValue, TArchiveScope<TMode>::GetContext(), this);
 				}
 			}
@@ -285,10 +353,8 @@ namespace BitSerializer::Yaml::RapidYaml {
 				}
 				else
 				{
-					assert(mIndex < GetEstimatedSize());
-					auto yamlValue = mNode.append_child();
+					auto yamlValue = AppendNextItem();
 					yamlValue |= ryml::SEQ;
-					mIndex++;
 					return std::make_optional<RapidYamlArrayScope<TMode>>(yamlValue, TArchiveScope<TMode>::GetContext(), arraySize, this);
 				}
 			}
@@ -304,8 +370,36 @@ namespace BitSerializer::Yaml::RapidYaml {
 				throw SerializationException(SerializationErrorCode::OutOfRange, "No more items to load");
 			}
 
+			/// <summary>
+			/// Appends node for the next item, when the second item is appended, the tree is reserved for all rest items
+			/// (the number of nodes and the size of arena are estimated by the first item).
+			/// </summary>
+			RapidYamlNode AppendNextItem()
+			{
+				static_assert(TMode == SerializeMode::Save);
+				assert(mIndex < mSize);
+				ryml::Tree* tree = mNode.tree();
+				if (mIndex == 0)
+				{
+					mFirstItemTreeSize = tree->size();
+					mFirstItemArenaSize = tree->arena_size();
+				}
+				else if (mIndex == 1 && mSize > 2)
+				{
+					const size_t restItems = mSize - 1;
+					tree->reserve(tree->size() + (tree->size() - mFirstItemTreeSize) * restItems);
+					if (const size_t arenaPerItem = tree->arena_size() - mFirstItemArenaSize; arenaPerItem != 0) {
+						tree->reserve_arena(tree->arena_size() + arenaPerItem * restItems);
+					}
+				}
+				++mIndex;
+				return mNode.append_child();
+			}
+
 			size_t mSize;
 			size_t mIndex;
+			size_t mFirstItemTreeSize = 0;
+			size_t mFirstItemArenaSize = 0;
 		};
 
 		/// <summary>
@@ -398,7 +492,7 @@ namespace BitSerializer::Yaml::RapidYaml {
 					assert(!mNode.find_child(c4::to_csubstr(key)).valid());
 					auto yamlValue = mNode.append_child();
 					yamlValue << ryml::key(key);
-					SaveValue(yamlValue, value);
+					SaveValue(yamlValue, value, this->GetOptions());
 					return true;
 				}
 			}
@@ -453,6 +547,150 @@ namespace BitSerializer::Yaml::RapidYaml {
 			}
 		};
 
+		/// <summary>
+		/// Writer for the emitter of RapidYaml library (`ryml::Emitter`), which collects emitted YAML into chunks and writes them
+		/// to the stream in the target UTF encoding (chunks are encoded at boundaries of code points).
+		/// </summary>
+		class RapidYamlStreamWriter
+		{
+		public:
+			static constexpr size_t StreamChunkSize = 64 * 1024;
+
+			RapidYamlStreamWriter(std::ostream& outputStream, const StreamOptions& streamOptions)
+				: mOutputStream(outputStream)
+				, mEncoding(streamOptions.encoding)
+			{
+				switch (mEncoding)
+				{
+				case Convert::UtfType::Utf8:
+				case Convert::UtfType::Utf16le:
+				case Convert::UtfType::Utf16be:
+				case Convert::UtfType::Utf32le:
+				case Convert::UtfType::Utf32be:
+					break;
+				default:
+					const auto strEncodingType = Convert::TryTo<std::string>(mEncoding);
+					throw SerializationException(SerializationErrorCode::UnsupportedEncoding,
+						"The archive does not support encoding: " +
+						(strEncodingType.has_value() ? strEncodingType.value() : std::to_string(static_cast<int>(mEncoding))));
+				}
+
+				if (streamOptions.writeBom) {
+					Convert::WriteBom(mOutputStream, mEncoding);
+				}
+				mChunk.reserve(StreamChunkSize);
+			}
+
+			/// <summary>
+			/// Writes the rest of emitted data to the stream.
+			/// </summary>
+			void Flush()
+			{
+				WriteChunk(mChunk.size());
+				mOutputStream.flush();
+				if (!mOutputStream.good()) {
+					throw SerializationException(SerializationErrorCode::InputOutputError, "Error writing to the output stream");
+				}
+			}
+
+			// Interface of writer which is used by `ryml::Emitter`
+			c4::substr _get(bool /*errorOnExcess*/) const noexcept
+			{
+				c4::substr result;
+				result.str = nullptr;
+				result.len = mPos;
+				return result;
+			}
+
+			template <size_t N>
+			void _do_write(const char (&str)[N])
+			{
+				_do_write(c4::csubstr(str, N - 1));
+			}
+
+			void _do_write(c4::csubstr str)
+			{
+				mChunk.append(str.str, str.len);
+				mPos += str.len;
+				WriteChunkWhenFull();
+			}
+
+			void _do_write(char ch)
+			{
+				mChunk.push_back(ch);
+				++mPos;
+				WriteChunkWhenFull();
+			}
+
+			void _do_write(char ch, size_t numTimes)
+			{
+				mChunk.append(numTimes, ch);
+				mPos += numTimes;
+				WriteChunkWhenFull();
+			}
+
+		private:
+			/// <summary>
+			/// Writes the collected chunk when it is full, except the last code point when it is not yet completely emitted.
+			/// </summary>
+			void WriteChunkWhenFull()
+			{
+				if (mChunk.size() < StreamChunkSize) {
+					return;
+				}
+
+				size_t lastCodePointPos = mChunk.size() - 1;
+				while (lastCodePointPos != 0 && (static_cast<unsigned char>(mChunk[lastCodePointPos]) & 0xC0) == 0x80) {
+					--lastCodePointPos;
+				}
+				const auto leadByte = static_cast<unsigned char>(mChunk[lastCodePointPos]);
+				const size_t codePointSize = leadByte < 0x80 ? 1 : (leadByte & 0xE0) == 0xC0 ? 2 : (leadByte & 0xF0) == 0xE0 ? 3 : 4;
+				WriteChunk(mChunk.size() - lastCodePointPos >= codePointSize ? mChunk.size() : lastCodePointPos);
+			}
+
+			void WriteChunk(size_t size)
+			{
+				const std::string_view chunk(mChunk.data(), size);
+				switch (mEncoding)
+				{
+				case Convert::UtfType::Utf8:
+					mOutputStream.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+					break;
+				case Convert::UtfType::Utf16le:
+					WriteEncoded<Convert::Utf16Le>(chunk, mU16Chunk);
+					break;
+				case Convert::UtfType::Utf16be:
+					WriteEncoded<Convert::Utf16Be>(chunk, mU16Chunk);
+					break;
+				case Convert::UtfType::Utf32le:
+					WriteEncoded<Convert::Utf32Le>(chunk, mU32Chunk);
+					break;
+				case Convert::UtfType::Utf32be:
+					WriteEncoded<Convert::Utf32Be>(chunk, mU32Chunk);
+					break;
+				default:
+					break;
+				}
+				mChunk.erase(0, size);
+			}
+
+			template <typename TUtf, typename TString>
+			void WriteEncoded(std::string_view utf8Chunk, TString& encodedChunk)
+			{
+				encodedChunk.clear();
+				TUtf::Encode(utf8Chunk.cbegin(), utf8Chunk.cend(), encodedChunk);
+				mOutputStream.write(reinterpret_cast<const char*>(encodedChunk.data()),
+					static_cast<std::streamsize>(encodedChunk.size() * sizeof(typename TString::value_type)));
+			}
+
+			std::ostream& mOutputStream;
+			Convert::UtfType mEncoding;
+			std::string mChunk;
+			std::u16string mU16Chunk;
+			std::u32string mU32Chunk;
+			size_t mPos = 0;
+		};
+
 		/// <summary>
 		/// YAML root scope.
 		/// </summary>
@@ -497,6 +735,18 @@ namespace BitSerializer::Yaml::RapidYaml {
 				Parse<c4::yml::Parser>(inputStr);
 			}
 
+			/// <summary>
+			/// Loads YAML from the mutable buffer, which is parsed in place (without copying to the arena, values of tree point to the buffer).
+			/// </summary>
+			RapidYamlRootScope(const CMutableBuffer& inputBuffer, SerializationContext& serializationContext)
+				: TArchiveScope<TMode>(serializationContext)
+				, RapidYamlScopeBase(mRootNode)
+				, mOutput(nullptr)
+			{
+				static_assert(TMode == SerializeMode::Load, "BitSerializer. This data type can be used only in 'Load' mode.");
+				ParseInPlace<c4::yml::Parser>(c4::substr(inputBuffer.data(), inputBuffer.size()));
+			}
+
 			RapidYamlRootScope(std::string& outputStr, SerializationContext& serializationContext)
 				: TArchiveScope<TMode>(serializationContext)
 				, RapidYamlScopeBase(mRootNode)
@@ -512,14 +762,9 @@ namespace BitSerializer::Yaml::RapidYaml {
 			{
 				static_assert(TMode == SerializeMode::Load, "BitSerializer. This data type can be used only in 'Load' mode.");
 
-				const auto utfType = Convert::DetectEncoding(inputStream);
-				if (utfType != Convert::UtfType::Utf8) {
-					throw SerializationException(SerializationErrorCode::UnsupportedEncoding, "The archive does not support encoding: " + Convert::ToString(utfType));
-				}
-
-				// ToDo: base library does not support std::stream (check in new versions)
-				const std::string inputStr(std::istreambuf_iterator<char>(inputStream), {});
-				Parse<c4::yml::Parser>(inputStr);
+				// The base library does not support std::stream, the data is read by blocks and parsed in place (without copying to arena)
+				mStreamData = BitSerializer::Detail::ReadAllFromEncodedStream(inputStream);
+				ParseInPlace<c4::yml::Parser>(c4::substr(mStreamData.data(), mStreamData.size()));
 			}
 
 			RapidYamlRootScope(std::ostream& outputStream, SerializationContext& serializationContext)
@@ -573,22 +818,25 @@ namespace BitSerializer::Yaml::RapidYaml {
 					std::visit([this](auto&& arg)
 					{
 						using T = std::decay_t<decltype(arg)>;
-						auto& options = TArchiveScope<TMode>::GetOptions();
 						if constexpr (std::is_same_v<T, std::string*>) {
-							*arg = ryml::emitrs<std::string>(mTree);
+							EmitToString(mTree, *arg);
 						}
 						else if constexpr (std::is_same_v<T, std::ostream*>)
 						{
-							if (options.streamOptions.writeBom) {
-								arg->write(Convert::Utf8::bom, sizeof Convert::Utf8::bom);
-							}
-							*arg << mTree;
+							ryml::Emitter<RapidYamlStreamWriter> emitter(*arg, TArchiveScope<TMode>::GetOptions().streamOptions);
+							EmitByEmitter(emitter, mTree, 0);
+							emitter.Flush();
 						}
 					}, mOutput);
 					mOutput = nullptr;
 				}
 			}
 
+			~RapidYamlRootScope()
+			{
+				ReleaseTree();
+			}
+
 		private:
 			RapidYamlRootScope(RapidYamlRootScope&&) = default;
 			RapidYamlRootScope& operator=(RapidYamlRootScope&&) = default;
@@ -599,7 +847,7 @@ namespace BitSerializer::Yaml::RapidYaml {
 				if constexpr (ryml_has_parse_in_arena<T>::value)
 				{
 					T parser(ryml::Callbacks(nullptr, nullptr, nullptr, &RapidYamlRootScope::ErrorCallback));
-					mTree = parser.parse_in_arena({}, c4::csubstr(inputStr.data(), inputStr.size()));
+					parser.parse_in_arena({}, c4::csubstr(inputStr.data(), inputStr.size()), &mTree);
 				}
 				else
 				{
@@ -614,14 +862,112 @@ namespace BitSerializer::Yaml::RapidYaml {
 				mRootNode = mTree.rootref();
 			}
 
+			template <typename T>
+			void ParseInPlace(c4::substr inputStr)
+			{
+				if constexpr (ryml_has_parse_in_arena<T>::value)
+				{
+					T parser(ryml::Callbacks(nullptr, nullptr, nullptr, &RapidYamlRootScope::ErrorCallback));
+					parser.parse_in_place({}, inputStr, &mTree);
+				}
+				else
+				{
+					// For keep compatibility with old versions of RapidYaml library (mutable buffer is parsed in place)
+					if (c4::yml::get_callbacks().m_error != &RapidYamlRootScope::ErrorCallback)
+					{
+						ryml::set_callbacks(ryml::Callbacks(nullptr, nullptr, nullptr, &RapidYamlRootScope::ErrorCallback));
+						c4::set_error_flags(c4::get_error_flags() | c4::ON_ERROR_CALLBACK);
+					}
+					c4::yml::parse(inputStr, &mTree);
+				}
+				mRootNode = mTree.rootref();
+			}
+
+			/// <summary>
+			/// Emits YAML into the existing capacity of string, it is emitted again only when the output does not fit.
+			/// </summary>
+			static void EmitToString(const ryml::Tree& tree, std::string& outputStr)
+			{
+				outputStr.resize(outputStr.capacity());
+				const size_t requiredSize = EmitToBuffer(tree, c4::substr(outputStr.data(), outputStr.size()), 0).len;
+				if (requiredSize > outputStr.size())
+				{
+					outputStr.resize(requiredSize);
+					EmitToBuffer(tree, c4::substr(outputStr.data(), outputStr.size()), 0);
+				}
+				else {
+					outputStr.resize(requiredSize);
+				}
+			}
+
+			template <typename TTree>
+			static auto EmitToBuffer(const TTree& tree, c4::substr buffer, int) -> decltype(emit_yaml(tree, buffer, false))
+			{
+				return emit_yaml(tree, buffer, false);
+			}
+
+			template <typename TTree>
+			static c4::substr EmitToBuffer(const TTree& tree, c4::substr buffer, long)
+			{
+				// For keep compatibility with old versions of RapidYaml library
+				return emit(tree, buffer, false);
+			}
+
+			template <typename TEmitter>
+			static auto EmitByEmitter(TEmitter& emitter, const ryml::Tree& tree, int) -> decltype(emitter.emit_as(ryml::EMIT_YAML, tree, false))
+			{
+				return emitter.emit_as(ryml::EMIT_YAML, tree, false);
+			}
+
+			template <typename TEmitter>
+			static c4::substr EmitByEmitter(TEmitter& emitter, const ryml::Tree& tree, long)
+			{
+				// For keep compatibility with old versions of RapidYaml library
+				return emitter.emit(ryml::EMIT_YAML, tree, tree.root_id(), false);
+			}
+
+			/// <summary>
+			/// Returns the tree which is cached per thread for reusing its memory by next serializations.
+			/// </summary>
+			static ryml::Tree& GetCachedTree() noexcept
+			{
+				thread_local ryml::Tree cachedTree;
+				return cachedTree;
+			}
+
+			/// <summary>
+			/// Takes the tree with memory which was allocated by the previous serialization in the current thread.
+			/// </summary>
+			static ryml::Tree TakeCachedTree() noexcept
+			{
+				return std::move(GetCachedTree());
+			}
+
+			/// <summary>
+			/// Clears the tree and puts it back to the cache (keeping allocated memory, unless it is larger than
+			/// `SerializationOptions::maxCachedMemorySize`, as the cached tree lives until the thread ends).
+			/// </summary>
+			void ReleaseTree() noexcept
+			{
+				const size_t allocatedSize = mTree.capacity() * sizeof(ryml::NodeData) + mTree.arena_capacity();
+				if (allocatedSize != 0 && allocatedSize <= TArchiveScope<TMode>::GetOptions().maxCachedMemorySize)
+				{
+					mTree.clear();
+					mTree.clear_arena();
+					GetCachedTree() = std::move(mTree);
+				}
+			}
+
 			static void ErrorCallback(const char* msg, size_t length, ryml::Location location, [[maybe_unused]] void* user_data)
 			{
 				throw ParsingException({ msg, msg + length }, location.line);
 			}
 
-			ryml::Tree mTree;
+			ryml::Tree mTree = TakeCachedTree();
 			RapidYamlNode mRootNode = mTree.rootref();
 			std::variant<std::nullptr_t, std::string*, std::ostream*> mOutput;
+			// Data which was read from the stream (the tree references it, as it is parsed in place)
+			std::string mStreamData;
 		};
 	}
 
@@ -629,7 +975,9 @@ namespace BitSerializer::Yaml::RapidYaml {
 	/// YAML archive based on Rapid YAML library.
 	/// Supports load/save from:
 	/// - <c>std::string</c>: UTF-8
-	/// - <c>std::istream</c> and <c>std::ostream</c>: UTF-8
+	/// - <c>CMutableBuffer</c>: UTF-8, the buffer is parsed in place (only for loading)
+	/// - <c>std::istream</c>: UTF-8, UTF-16LE, UTF-16BE, UTF-32LE, UTF-32BE
+	/// - <c>std::ostream</c>: UTF-8, UTF-16LE, UTF-16BE, UTF-32LE, UTF-32BE
 	/// </summary>
 	using YamlArchive = TArchiveBase<
 		Detail::RapidYamlArchiveTraits,
@@ -5,6 +5,7 @@
 #pragma once
 #include <tuple>
 #include <limits>
+#include <string>
 #include "serialization_context.h"
 #include "bitserializer/conversion_detail/convert_enum.h"
 
@@ -27,14 +28,26 @@ enum class ArchiveType
 	Json,
 	Xml,
 	Yaml,
-	Csv
+	Csv,
+	MsgPack,
+	Cbor,
+	Snapshot,
+	Columnar,
+	Protobuf,
+	Bson
 };
 
 REGISTER_ENUM(ArchiveType, {
 	{ ArchiveType::Json, "Json" },
 	{ ArchiveType::Xml, "Xml" },
 	{ ArchiveType::Yaml, "Yaml" },
-	{ ArchiveType::Csv, "Csv" }
+	{ ArchiveType::Csv, "Csv" },
+	{ ArchiveType::MsgPack, "MsgPack" },
+	{ ArchiveType::Cbor, "Cbor" },
+	{ ArchiveType::Snapshot, "Snapshot" },
+	{ ArchiveType::Columnar, "Columnar" },
+	{ ArchiveType::Protobuf, "Protobuf" },
+	{ ArchiveType::Bson, "Bson" }
 })
 
 /// <summary>
@@ -43,6 +56,36 @@ REGISTER_ENUM(ArchiveType, {
 template <class ...KeyTypes>
 using TSupportedKeyTypes = std::tuple<KeyTypes...>;
 
+/// <summary>
+/// Mutable buffer with input data, allows archives to parse it in place (without copying to the internal storage).
+/// The content of buffer is modified during loading, it must outlive the loaded `std::string_view` values which can point to it.
+/// </summary>
+class CMutableBuffer
+{
+public:
+	CMutableBuffer(char* data, size_t size) noexcept
+		: mData(data)
+		, mSize(size)
+	{ }
+
+	explicit CMutableBuffer(std::string& str) noexcept
+		: mData(str.data())
+		, mSize(str.size())
+	{ }
+
+	[[nodiscard]] char* data() const noexcept {
+		return mData;
+	}
+
+	[[nodiscard]] size_t size() const noexcept {
+		return mSize;
+	}
+
+private:
+	char* mData;
+	size_t mSize;
+};
+
 /// <summary>
 /// Base class of scope in archive (lower level of archive).
 /// Implementation should have certain set of serialization methods which depending from structure of format.
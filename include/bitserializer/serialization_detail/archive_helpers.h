@@ -0,0 +1,124 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <type_traits>
+#include "bitserializer/conversion_detail/convert_utf.h"
+#include "bitserializer/serialization_detail/archive_base.h"
+#include "bitserializer/serialization_detail/errors_handling.h"
+
+namespace BitSerializer::Detail
+{
+	/// <summary>
+	/// Casts the loaded number to the target type according to policy (negative numbers can't be loaded to unsigned types,
+	/// integers are loaded to floating point types via `double`).
+	/// </summary>
+	template <typename TSource, typename TTarget>
+	bool CastNumber(TSource sourceValue, TTarget& targetValue, OverflowNumberPolicy overflowNumberPolicy)
+	{
+		if constexpr (std::is_floating_point_v<TTarget> && std::is_integral_v<TSource>)
+		{
+			return SafeNumberCast(static_cast<double>(sourceValue), targetValue, overflowNumberPolicy);
+		}
+		else
+		{
+			if constexpr (std::is_signed_v<TSource> && std::is_unsigned_v<TTarget>)
+			{
+				// Negative number can't be loaded to unsigned type (regardless of its size)
+				if (sourceValue < 0)
+				{
+					if (overflowNumberPolicy == OverflowNumberPolicy::ThrowError)
+					{
+						throw SerializationException(SerializationErrorCode::Overflow,
+							"The size of target field is not sufficient to deserialize number " + Convert::ToString(sourceValue));
+					}
+					return false;
+				}
+			}
+			return SafeNumberCast(sourceValue, targetValue, overflowNumberPolicy);
+		}
+	}
+
+	/// <summary>
+	/// Reads unsigned integer of passed size (up to 8 bytes) in the little-endian byte order.
+	/// </summary>
+	inline uint64_t ReadLittleEndian(const char* data, size_t size) noexcept
+	{
+		uint64_t value = 0;
+		for (size_t i = 0; i < size; ++i) {
+			value |= static_cast<uint64_t>(static_cast<uint8_t>(data[i])) << (i * 8);
+		}
+		return value;
+	}
+
+	constexpr uint64_t ZigZagEncode(int64_t value) noexcept
+	{
+		return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+	}
+
+	constexpr int64_t ZigZagDecode(uint64_t value) noexcept
+	{
+		return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+	}
+
+	/// <summary>
+	/// Returns the remaining size of stream or zero when the stream is not seekable.
+	/// </summary>
+	inline size_t GetRemainingStreamSize(std::istream& inputStream)
+	{
+		if (const auto startPos = inputStream.tellg(); startPos != std::istream::pos_type(-1))
+		{
+			inputStream.seekg(0, std::ios::end);
+			const auto endPos = inputStream.tellg();
+			inputStream.seekg(startPos);
+			if (endPos > startPos) {
+				return static_cast<size_t>(endPos - startPos);
+			}
+		}
+		return 0;
+	}
+
+	/// <summary>
+	/// Reads whole stream of binary data (at once when the stream is seekable, otherwise by large blocks).
+	/// </summary>
+	inline std::string ReadAllFromStream(std::istream& inputStream)
+	{
+		constexpr size_t chunkSize = 64 * 1024;
+
+		std::string data(GetRemainingStreamSize(inputStream), 0);
+		if (!data.empty())
+		{
+			inputStream.read(data.data(), static_cast<std::streamsize>(data.size()));
+			data.resize(static_cast<size_t>(inputStream.gcount()));
+		}
+		while (inputStream.good())
+		{
+			const size_t prevSize = data.size();
+			data.resize(prevSize + chunkSize);
+			inputStream.read(data.data() + prevSize, static_cast<std::streamsize>(chunkSize));
+			data.resize(prevSize + static_cast<size_t>(inputStream.gcount()));
+		}
+		return data;
+	}
+
+	/// <summary>
+	/// Reads whole stream with decoding to UTF-8 (the encoding is detected automatically by BOM or content).
+	/// The size of buffer is reserved when the stream is seekable.
+	/// </summary>
+	inline std::string ReadAllFromEncodedStream(std::istream& inputStream)
+	{
+		std::string data;
+		if (const size_t size = GetRemainingStreamSize(inputStream); size != 0) {
+			data.reserve(size + Convert::CEncodedStreamReader<Convert::Utf8>::chunk_size);
+		}
+
+		Convert::CEncodedStreamReader<Convert::Utf8> encodedStreamReader(inputStream);
+		// ReSharper disable once CppPossiblyErroneousEmptyStatements
+		while (encodedStreamReader.ReadChunk(data));
+		return data;
+	}
+}
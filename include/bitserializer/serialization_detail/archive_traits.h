@@ -96,6 +96,40 @@ public:
 template <typename TArchive, typename TValue, typename TKey>
 constexpr bool can_serialize_value_with_key_v = can_serialize_value_with_key<TArchive, TValue, TKey>::value;
 
+/// <summary>
+/// Checks that the continuous BLOCK of fundamental values (like array of numbers) can be serialized at once in target archive scope.
+/// </summary>
+template <typename TArchive, typename TValue>
+struct can_serialize_block
+{
+private:
+	template <typename TObj, typename TVal>
+	static std::enable_if_t<std::is_same_v<bool, decltype(std::declval<TObj>().SerializeBlock(std::declval<TVal*>(), std::declval<size_t>()))>, std::true_type> test(int);
+
+	template <typename, typename>
+	static std::false_type test(...);
+
+public:
+	typedef decltype(test<TArchive, TValue>(0)) type;
+	enum { value = type::value };
+};
+
+template <typename TArchive, typename TValue>
+constexpr bool can_serialize_block_v = can_serialize_block<TArchive, TValue>::value;
+
+/// <summary>
+/// Checks that the type can be stored as item of continuous block in binary archives (integers up to 64 bits and floating point types).
+/// </summary>
+template <typename T>
+constexpr bool is_block_item_v = (std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8)
+	|| std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+/// <summary>
+/// Checks that the type is a byte, arrays of bytes can be stored as native binary type of archive (BSON, MessagePack).
+/// </summary>
+template <typename T>
+constexpr bool is_binary_item_v = std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) == 1;
+
 //------------------------------------------------------------------------------
 
 /// <summary>
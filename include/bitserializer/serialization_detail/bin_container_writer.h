@@ -0,0 +1,229 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <vector>
+#include "bitserializer/serialization_detail/errors_handling.h"
+
+namespace BitSerializer::Detail
+{
+	/// <summary>
+	/// Helper for writers of binary formats where the size of container is stored before its content (MessagePack, CBOR, Protobuf).
+	/// The writer appends data to the output buffer directly, the helper tracks the headers of opened containers.
+	/// When the size of container is unknown, the space for its header is reserved with the maximum size, and when the
+	/// container is closed, the actual header is written at the end of this space. Unused bytes are skipped when the data
+	/// is flushed or when the last container is closed, so the content is never shifted. When writing to the stream, the data
+	/// before the first container with not yet known header is written in chunks.
+	/// </summary>
+	template <class TBuffer>
+	class CBinContainerWriter
+	{
+	public:
+		static constexpr size_t StreamChunkSize = 64 * 1024;
+
+		CBinContainerWriter(TBuffer& outputBuffer, std::ostream* outputStream) noexcept
+			: mBuffer(outputBuffer)
+			, mOutputStream(outputStream)
+		{ }
+
+		/// <summary>
+		/// Opens a container with the known header (it can be replaced with a header of the same or smaller size when closing).
+		/// </summary>
+		void BeginContainer(const uint8_t* header, size_t headerSize)
+		{
+			const size_t position = GetPosition();
+			mBuffer.insert(mBuffer.end(), header, header + headerSize);
+			mOpenedContainers.push_back({ position, headerSize, GetDataSize(), false });
+		}
+
+		/// <summary>
+		/// Opens a container with unknown header, the space of passed size is reserved for it.
+		/// </summary>
+		void BeginContainer(size_t maxHeaderSize)
+		{
+			const size_t position = GetPosition();
+			mBuffer.resize(mBuffer.size() + maxHeaderSize);
+			mOpenedContainers.push_back({ position, maxHeaderSize, GetDataSize(), true });
+		}
+
+		/// <summary>
+		/// Returns the size of content of the last opened container (without unused bytes of nested headers).
+		/// </summary>
+		[[nodiscard]] size_t GetContentSize() const noexcept
+		{
+			return GetDataSize() - mOpenedContainers.back().ContentPosition;
+		}
+
+		/// <summary>
+		/// Closes the last opened container, its header is replaced when passed.
+		/// Returns `false` when the header can't be replaced (it is already written to the stream or its size is not enough).
+		/// </summary>
+		bool EndContainer(const uint8_t* header = nullptr, size_t headerSize = 0) noexcept
+		{
+			const ContainerInfo container = mOpenedContainers.back();
+			mOpenedContainers.pop_back();
+
+			bool result = true;
+			if (header != nullptr)
+			{
+				if (container.Position < mFlushedSize || headerSize > container.HeaderSize) {
+					result = false;
+				}
+				else
+				{
+					const size_t unusedSize = container.HeaderSize - headerSize;
+					std::memcpy(&mBuffer[container.Position - mFlushedSize + unusedSize], header, headerSize);
+					if (unusedSize != 0)
+					{
+						mUnusedRanges.push_back({ container.Position, unusedSize });
+						mUnusedSize += unusedSize;
+					}
+				}
+			}
+
+			if (mOpenedContainers.empty() && !mOutputStream)
+			{
+				RemoveUnusedRanges();
+				return result;
+			}
+
+			// Flush the data to the stream which can't be changed anymore (all before the first not yet known header)
+			if (mOutputStream && mBuffer.size() >= StreamChunkSize)
+			{
+				size_t flushSize = mBuffer.size();
+				for (const auto& openedContainer : mOpenedContainers)
+				{
+					if (openedContainer.IsReserved)
+					{
+						flushSize = openedContainer.Position - mFlushedSize;
+						break;
+					}
+				}
+				if (flushSize >= StreamChunkSize)
+				{
+					try {
+						FlushToStream(flushSize);
+					}
+					catch (...) {
+						// Will be thrown again when finalizing
+					}
+				}
+			}
+			return result;
+		}
+
+		/// <summary>
+		/// Removes the last opened container with its header (it must be empty, e.g. to replace with a value of other type).
+		/// </summary>
+		void DiscardContainer() noexcept
+		{
+			const ContainerInfo container = mOpenedContainers.back();
+			mOpenedContainers.pop_back();
+			mBuffer.resize(container.Position - mFlushedSize);
+		}
+
+		/// <summary>
+		/// Writes all data to the stream (all containers must be closed).
+		/// </summary>
+		void Flush()
+		{
+			if (mOutputStream) {
+				FlushToStream(mBuffer.size());
+			}
+		}
+
+	private:
+		struct ContainerInfo
+		{
+			// Position of header (including data which is already written to the stream)
+			size_t Position;
+			size_t HeaderSize;
+			// Position of content (excluding unused bytes)
+			size_t ContentPosition;
+			bool IsReserved;
+		};
+
+		struct UnusedRange
+		{
+			size_t Position;
+			size_t Size;
+
+			bool operator<(const UnusedRange& rhs) const noexcept { return Position < rhs.Position; }
+		};
+
+		[[nodiscard]] size_t GetPosition() const noexcept
+		{
+			return mFlushedSize + mBuffer.size();
+		}
+
+		[[nodiscard]] size_t GetDataSize() const noexcept
+		{
+			return GetPosition() - mUnusedSize;
+		}
+
+		/// <summary>
+		/// Removes unused bytes of headers from the output buffer (moves the data between them in one pass).
+		/// </summary>
+		void RemoveUnusedRanges()
+		{
+			if (mUnusedRanges.empty()) {
+				return;
+			}
+
+			std::sort(mUnusedRanges.begin(), mUnusedRanges.end());
+			auto* data = mBuffer.data();
+			size_t targetPos = mUnusedRanges.front().Position;
+			size_t sourcePos = targetPos;
+			for (const auto& unusedRange : mUnusedRanges)
+			{
+				const size_t size = unusedRange.Position - sourcePos;
+				std::memmove(data + targetPos, data + sourcePos, size);
+				targetPos += size;
+				sourcePos = unusedRange.Position + unusedRange.Size;
+			}
+			const size_t tailSize = mBuffer.size() - sourcePos;
+			std::memmove(data + targetPos, data + sourcePos, tailSize);
+			mBuffer.resize(targetPos + tailSize);
+			mUnusedRanges.clear();
+			mUnusedSize = 0;
+		}
+
+		void FlushToStream(size_t size)
+		{
+			if (size == 0) {
+				return;
+			}
+
+			std::sort(mUnusedRanges.begin(), mUnusedRanges.end());
+			const auto* data = reinterpret_cast<const char*>(mBuffer.data());
+			size_t pos = 0;
+			auto it = mUnusedRanges.begin();
+			for (; it != mUnusedRanges.end() && it->Position < mFlushedSize + size; ++it)
+			{
+				const size_t rangePos = it->Position - mFlushedSize;
+				mOutputStream->write(data + pos, static_cast<std::streamsize>(rangePos - pos));
+				pos = rangePos + it->Size;
+			}
+			mOutputStream->write(data + pos, static_cast<std::streamsize>(size - pos));
+			if (!mOutputStream->good()) {
+				throw SerializationException(SerializationErrorCode::InputOutputError, "Error writing to the output stream");
+			}
+
+			mUnusedRanges.erase(mUnusedRanges.begin(), it);
+			mBuffer.erase(mBuffer.begin(), mBuffer.begin() + static_cast<std::ptrdiff_t>(size));
+			mFlushedSize += size;
+		}
+
+		TBuffer& mBuffer;
+		std::ostream* mOutputStream;
+		size_t mFlushedSize = 0;
+		size_t mUnusedSize = 0;
+		std::vector<ContainerInfo> mOpenedContainers;
+		std::vector<UnusedRange> mUnusedRanges;
+	};
+}
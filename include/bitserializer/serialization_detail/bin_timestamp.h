@@ -0,0 +1,33 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <cstdint>
+
+namespace BitSerializer::Detail
+{
+	/// <summary>
+	/// Binary timestamp (number of seconds and nanoseconds since Unix epoch).
+	/// Archives which have native type for datetime (like binary formats) can declare support of this type,
+	/// in this case it will be used for serialization `std::chrono::time_point` instead of ISO 8601 string.
+	/// </summary>
+	struct CBinTimestamp
+	{
+		CBinTimestamp() = default;
+		explicit CBinTimestamp(int64_t seconds, int32_t nanoseconds = 0) noexcept
+			: Seconds(seconds), Nanoseconds(nanoseconds)
+		{ }
+
+		bool operator==(const CBinTimestamp& rhs) const noexcept {
+			return Seconds == rhs.Seconds && Nanoseconds == rhs.Nanoseconds;
+		}
+
+		bool operator!=(const CBinTimestamp& rhs) const noexcept {
+			return !(*this == rhs);
+		}
+
+		int64_t Seconds = 0;
+		int32_t Nanoseconds = 0;	// Fractions of second in range [0, 999999999]
+	};
+}
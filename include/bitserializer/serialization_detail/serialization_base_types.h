@@ -3,6 +3,7 @@
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
 #pragma once
+#include <iterator>
 #include <type_traits>
 #include "object_traits.h"
 #include "archive_traits.h"
@@ -99,7 +100,7 @@ namespace BitSerializer
 	namespace Detail
 	{
 		template <class TValue, std::enable_if_t<std::is_enum_v<TValue>, int> = 0>
-		bool ConvertStringToEnumByPolicy(const std::string& str, TValue& out_value, MismatchedTypesPolicy policy)
+		bool ConvertStringToEnumByPolicy(std::string_view str, TValue& out_value, MismatchedTypesPolicy policy)
 		{
 			try
 			{
@@ -111,7 +112,7 @@ namespace BitSerializer
 				if (policy == MismatchedTypesPolicy::ThrowError)
 				{
 					throw SerializationException(SerializationErrorCode::MismatchedTypes,
-						"The string (" + str + ") cannot be converted to target enum");
+						"The string (" + std::string(str) + ") cannot be converted to target enum");
 				}
 			}
 			catch (...) {
@@ -121,22 +122,43 @@ namespace BitSerializer
 		}
 	}
 
+	/// <summary>
+	/// Serializes enum types as strings.
+	/// When archive supports `std::string_view` values, the registered name is passed without any temporary string
+	/// (on loading, the view points to the internal storage of archive and is valid only during this call).
+	/// </summary>
 	template <class TArchive, typename TKey, class TValue, std::enable_if_t<std::is_enum_v<TValue>, int> = 0>
 	bool Serialize(TArchive& archive, TKey&& key, TValue& value)
 	{
 		if constexpr (TArchive::IsLoading())
 		{
-			std::string str;
-			if (Serialize(archive, std::forward<TKey>(key), str)) {
-				return Detail::ConvertStringToEnumByPolicy(str, value, archive.GetOptions().mismatchedTypesPolicy);
+			if constexpr (can_serialize_value_with_key_v<TArchive, std::string_view, TKey>)
+			{
+				if (std::string_view str; archive.SerializeValue(std::forward<TKey>(key), str)) {
+					return Detail::ConvertStringToEnumByPolicy(str, value, archive.GetOptions().mismatchedTypesPolicy);
+				}
+			}
+			else
+			{
+				if (std::string str; Serialize(archive, std::forward<TKey>(key), str)) {
+					return Detail::ConvertStringToEnumByPolicy(str, value, archive.GetOptions().mismatchedTypesPolicy);
+				}
 			}
 			return false;
 		}
 		else
 		{
 			// May throw exception when enum is not registered or has invalid value
-			auto str = Convert::ToString(value);
-			return Serialize(archive, std::forward<TKey>(key), str);
+			if constexpr (can_serialize_value_with_key_v<TArchive, std::string_view, TKey>)
+			{
+				std::string_view str = Convert::Detail::EnumRegistry<TValue>::GetEnumMetadata(value).Name;
+				return archive.SerializeValue(std::forward<TKey>(key), str);
+			}
+			else
+			{
+				auto str = Convert::ToString(value);
+				return Serialize(archive, std::forward<TKey>(key), str);
+			}
 		}
 	}
 
@@ -145,17 +167,33 @@ namespace BitSerializer
 	{
 		if constexpr (TArchive::IsLoading())
 		{
-			std::string str;
-			if (Serialize(archive, str)) {
-				return Detail::ConvertStringToEnumByPolicy(str, value, archive.GetOptions().mismatchedTypesPolicy);
+			if constexpr (can_serialize_value_v<TArchive, std::string_view>)
+			{
+				if (std::string_view str; archive.SerializeValue(str)) {
+					return Detail::ConvertStringToEnumByPolicy(str, value, archive.GetOptions().mismatchedTypesPolicy);
+				}
+			}
+			else
+			{
+				if (std::string str; Serialize(archive, str)) {
+					return Detail::ConvertStringToEnumByPolicy(str, value, archive.GetOptions().mismatchedTypesPolicy);
+				}
 			}
 			return false;
 		}
 		else
 		{
 			// May throw exception when enum is not registered or has invalid value
-			auto str = Convert::ToString(value);
-			return Serialize(archive, str);
+			if constexpr (can_serialize_value_v<TArchive, std::string_view>)
+			{
+				std::string_view str = Convert::Detail::EnumRegistry<TValue>::GetEnumMetadata(value).Name;
+				return archive.SerializeValue(str);
+			}
+			else
+			{
+				auto str = Convert::ToString(value);
+				return Serialize(archive, str);
+			}
 		}
 	}
 
@@ -345,7 +383,22 @@ namespace BitSerializer
 		template<typename TArchive, typename TIterator>
 		void SerializeFixedSizeArray(TArchive& arrayScope, TIterator startIt, TIterator endIt)
 		{
-			if constexpr (TArchive::IsLoading())
+			// Fundamental values can be serialized as one continuous block (when it is supported by archive)
+			using TValue = std::remove_reference_t<decltype(*startIt)>;
+			if constexpr (can_serialize_block_v<TArchive, TValue>)
+			{
+				const auto arraySize = static_cast<size_t>(std::distance(startIt, endIt));
+				if constexpr (TArchive::IsLoading())
+				{
+					if (arraySize != arrayScope.GetEstimatedSize())
+					{
+						throw SerializationException(SerializationErrorCode::OutOfRange,
+							"Target array with fixed size does not match the number of loading items");
+					}
+				}
+				arrayScope.SerializeBlock(&*startIt, arraySize);
+			}
+			else if constexpr (TArchive::IsLoading())
 			{
 				auto it = startIt;
 				for (; it != endIt && !arrayScope.IsEnd(); ++it)
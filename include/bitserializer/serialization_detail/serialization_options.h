@@ -3,7 +3,9 @@
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
 #pragma once
+#include <cstddef>
 #include <cstdint>
+#include <optional>
 #include "bitserializer/conversion_detail/convert_utf.h"
 
 namespace BitSerializer
@@ -28,6 +30,12 @@ namespace BitSerializer
 		/// The number of characters for padding each level.
 		/// </summary>
 		uint16_t paddingCharNum = 1;
+
+		/// <summary>
+		/// The number of significant digits for floating point numbers, zero means the shortest form which guarantees round-trip.
+		/// Currently used only for XML and YAML formats.
+		/// </summary>
+		uint8_t floatPrecision = 0;
 	};
 
 	/// <summary>
@@ -111,5 +119,25 @@ namespace BitSerializer
 		/// Values separator, currently used only for CSV format (allowed: ',', ';', '\t', ' ', '|').
 		/// </summary>
 		char valuesSeparator = ',';
+
+		/// <summary>
+		/// Fingerprint of the data schema, currently used only for Snapshot format.
+		/// It is written to the header when saving and must match to the fingerprint in the header when loading (zero means any).
+		/// </summary>
+		uint64_t schemaFingerprint = 0;
+
+		/// <summary>
+		/// Flags for the parser of input text, currently used only for PugiXml archive (combination of `pugi::parse_*` flags).
+		/// For example, `pugi::parse_minimal` can be used when the input is known to be free of escapes, comments and PI.
+		/// When not set, the default flags of the archive are used.
+		/// </summary>
+		std::optional<uint32_t> parseFlags;
+
+		/// <summary>
+		/// The maximum size of memory which can be kept by the archive for reusing by next serializations in the same thread,
+		/// currently used only for RapidYaml archive (the document tree is kept until the thread ends, zero disables reusing).
+		/// Can be increased for avoiding repeated allocations, when large documents are periodically serialized in the same thread.
+		/// </summary>
+		size_t maxCachedMemorySize = 1024 * 1024;
 	};
 }
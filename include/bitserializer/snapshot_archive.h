@@ -0,0 +1,880 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "bitserializer/serialization_detail/archive_base.h"
+#include "bitserializer/serialization_detail/archive_traits.h"
+#include "bitserializer/serialization_detail/bin_timestamp.h"
+#include "bitserializer/serialization_detail/errors_handling.h"
+
+
+namespace BitSerializer::Snapshot {
+namespace Detail {
+
+using BitSerializer::Detail::CBinTimestamp;
+
+/// <summary>
+/// The traits of Snapshot archive (internal implementation - no dependencies)
+/// </summary>
+struct SnapshotArchiveTraits
+{
+	static constexpr ArchiveType archive_type = ArchiveType::Snapshot;
+	using key_type = std::string;
+	using supported_key_types = TSupportedKeyTypes<const char*, std::string_view, key_type>;
+	using preferred_output_format = std::basic_string<char, std::char_traits<char>>;
+	using preferred_stream_char_type = char;
+	static constexpr char path_separator = '/';
+
+protected:
+	~SnapshotArchiveTraits() = default;
+};
+
+/// <summary>
+/// Types of values in the snapshot.
+/// </summary>
+enum class SnapshotType : uint8_t
+{
+	Null = 0,
+	False,
+	True,
+	Int8,
+	UInt8,
+	Int16,
+	UInt16,
+	Int32,
+	UInt32,
+	Int64,
+	UInt64,
+	Float,
+	Double,
+	String,
+	Array,
+	Map,
+	Block,
+	Timestamp
+};
+
+/// <summary>
+/// Returns the type of number with fixed width (`int8_t` ... `uint64_t`, `float` or `double`).
+/// </summary>
+template <typename T>
+constexpr SnapshotType GetNumberType() noexcept
+{
+	if constexpr (std::is_same_v<T, float>) {
+		return SnapshotType::Float;
+	}
+	else if constexpr (std::is_floating_point_v<T>) {
+		return SnapshotType::Double;
+	}
+	else if constexpr (sizeof(T) == 1) {
+		return std::is_signed_v<T> ? SnapshotType::Int8 : SnapshotType::UInt8;
+	}
+	else if constexpr (sizeof(T) == 2) {
+		return std::is_signed_v<T> ? SnapshotType::Int16 : SnapshotType::UInt16;
+	}
+	else if constexpr (sizeof(T) == 4) {
+		return std::is_signed_v<T> ? SnapshotType::Int32 : SnapshotType::UInt32;
+	}
+	else {
+		return std::is_signed_v<T> ? SnapshotType::Int64 : SnapshotType::UInt64;
+	}
+}
+
+class ISnapshotWriter
+{
+public:
+	virtual ~ISnapshotWriter() = default;
+
+	virtual void WriteNull() = 0;
+	virtual void WriteBoolean(bool value) = 0;
+	virtual void WriteNumber(SnapshotType type, const void* value) = 0;
+	virtual void WriteString(std::string_view value) = 0;
+	virtual void WriteTimestamp(const CBinTimestamp& timestamp) = 0;
+	virtual void WriteKey(std::string_view key) = 0;
+	virtual void WriteBlock(SnapshotType itemType, const void* data, size_t size) = 0;
+	virtual void BeginArray() = 0;
+	virtual void EndArray(size_t actualSize) noexcept = 0;
+	virtual void BeginMap() = 0;
+	virtual void EndMap(size_t actualSize) noexcept = 0;
+	virtual void Flush() = 0;
+};
+
+class ISnapshotReader
+{
+public:
+	virtual ~ISnapshotReader() = default;
+
+	[[nodiscard]] virtual size_t GetPosition() const noexcept = 0;
+	virtual void SetPosition(size_t pos) noexcept = 0;
+	virtual bool ReadValue(std::nullptr_t& value) = 0;
+	virtual bool ReadValue(bool& value) = 0;
+	virtual bool ReadValue(uint8_t& value) = 0;
+	virtual bool ReadValue(uint16_t& value) = 0;
+	virtual bool ReadValue(uint32_t& value) = 0;
+	virtual bool ReadValue(uint64_t& value) = 0;
+	virtual bool ReadValue(int8_t& value) = 0;
+	virtual bool ReadValue(int16_t& value) = 0;
+	virtual bool ReadValue(int32_t& value) = 0;
+	virtual bool ReadValue(int64_t& value) = 0;
+	virtual bool ReadValue(float& value) = 0;
+	virtual bool ReadValue(double& value) = 0;
+	virtual bool ReadValue(std::string_view& value) = 0;
+	virtual bool ReadValue(CBinTimestamp& timestamp) = 0;
+	virtual void ReadKey(std::string_view& key) noexcept = 0;
+	virtual bool ReadArraySize(size_t& arraySize, size_t& endPos) noexcept = 0;
+	virtual bool ReadMapSize(size_t& mapSize, size_t& endPos) noexcept = 0;
+	virtual bool ReadBlock(SnapshotType itemType, void* data, size_t size) noexcept = 0;
+	virtual void EndArray(size_t endPos) noexcept = 0;
+	virtual void SkipValue() noexcept = 0;
+};
+
+
+/// <summary>
+/// Base class of Snapshot scope
+/// </summary>
+class SnapshotScopeBase : public SnapshotArchiveTraits
+{
+public:
+	SnapshotScopeBase(const SnapshotScopeBase&) = delete;
+	SnapshotScopeBase& operator=(const SnapshotScopeBase&) = delete;
+
+	/// <summary>
+	/// Gets the current path in Snapshot (in the same format as JSON Pointer).
+	/// </summary>
+	[[nodiscard]] virtual std::string GetPath() const
+	{
+		const std::string localPath = mParentKey.empty()
+			? std::string()
+			: path_separator + std::string(mParentKey);
+		return mParent == nullptr ? localPath : mParent->GetPath() + localPath;
+	}
+
+protected:
+	explicit SnapshotScopeBase(const SnapshotScopeBase* parent = nullptr, std::string_view parentKey = {}) noexcept
+		: mParent(parent)
+		, mParentKey(parentKey)
+	{ }
+
+	~SnapshotScopeBase() = default;
+
+	/// <summary>
+	/// Number type with fixed width which is used for storing value with type `T`.
+	/// </summary>
+	template <typename T>
+	using fixed_number_t = std::conditional_t<std::is_floating_point_v<T>,
+		std::conditional_t<std::is_same_v<T, float>, float, double>,
+		std::conditional_t<std::is_signed_v<T>,
+			std::conditional_t<sizeof(T) == 1, int8_t, std::conditional_t<sizeof(T) == 2, int16_t, std::conditional_t<sizeof(T) == 4, int32_t, int64_t>>>,
+			std::conditional_t<sizeof(T) == 1, uint8_t, std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>>>;
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	static bool LoadValue(ISnapshotReader* snapshotReader, T& value)
+	{
+		if constexpr (std::is_same_v<T, bool> || std::is_null_pointer_v<T>)
+		{
+			return snapshotReader->ReadValue(value);
+		}
+		else
+		{
+			fixed_number_t<T> fixedValue;
+			if (snapshotReader->ReadValue(fixedValue))
+			{
+				value = static_cast<T>(fixedValue);
+				return true;
+			}
+			return false;
+		}
+	}
+
+	template <typename TSym, typename TAllocator>
+	static bool LoadValue(ISnapshotReader* snapshotReader, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		if (std::string_view strValue; snapshotReader->ReadValue(strValue))
+		{
+			if constexpr (std::is_same_v<TSym, char>) {
+				value.assign(strValue.data(), strValue.size());
+			}
+			else {
+				value = Convert::To<std::basic_string<TSym, std::char_traits<TSym>, TAllocator>>(strValue);
+			}
+			return true;
+		}
+		return false;
+	}
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	static void SaveValue(ISnapshotWriter* snapshotWriter, const T& value)
+	{
+		if constexpr (std::is_null_pointer_v<T>) {
+			snapshotWriter->WriteNull();
+		}
+		else if constexpr (std::is_same_v<T, bool>) {
+			snapshotWriter->WriteBoolean(value);
+		}
+		else
+		{
+			const auto fixedValue = static_cast<fixed_number_t<T>>(value);
+			snapshotWriter->WriteNumber(GetNumberType<fixed_number_t<T>>(), &fixedValue);
+		}
+	}
+
+	template <typename TSym, typename TAllocator>
+	static void SaveValue(ISnapshotWriter* snapshotWriter, const std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		if constexpr (std::is_same_v<TSym, char>) {
+			snapshotWriter->WriteString(std::string_view(value.data(), value.size()));
+		}
+		else {
+			snapshotWriter->WriteString(Convert::ToString(value));
+		}
+	}
+
+	const SnapshotScopeBase* mParent;
+	std::string_view mParentKey;
+};
+
+
+// Forward declarations
+class SnapshotWriteObjectScope;
+
+/// <summary>
+/// Snapshot scope for writing arrays (list of values without keys).
+/// Arrays of numbers are written as one continuous block (when they are serialized via `SerializeBlock()`).
+/// </summary>
+class SnapshotWriteArrayScope final : public TArchiveScope<SerializeMode::Save>, public SnapshotScopeBase
+{
+public:
+	SnapshotWriteArrayScope(ISnapshotWriter* snapshotWriter, SerializationContext& serializationContext,
+		const SnapshotScopeBase* parent = nullptr, std::string_view parentKey = {})
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, SnapshotScopeBase(parent, parentKey)
+		, mSnapshotWriter(snapshotWriter)
+	{
+		mSnapshotWriter->BeginArray();
+	}
+
+	~SnapshotWriteArrayScope()
+	{
+		mSnapshotWriter->EndArray(mIndex);
+	}
+
+	/// <summary>
+	/// Gets the current path in Snapshot (in the same format as JSON Pointer).
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const override
+	{
+		return SnapshotScopeBase::GetPath() + path_separator + Convert::ToString(mIndex);
+	}
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		SaveValue(mSnapshotWriter, value);
+		++mIndex;
+		return true;
+	}
+
+	template <typename TSym, typename TAllocator>
+	bool SerializeValue(std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		SaveValue(mSnapshotWriter, value);
+		++mIndex;
+		return true;
+	}
+
+	bool SerializeValue(std::string_view& value)
+	{
+		mSnapshotWriter->WriteString(value);
+		++mIndex;
+		return true;
+	}
+
+	bool SerializeValue(CBinTimestamp& timestamp)
+	{
+		mSnapshotWriter->WriteTimestamp(timestamp);
+		++mIndex;
+		return true;
+	}
+
+	/// <summary>
+	/// Writes the continuous block of numbers as is (must be called before any other values).
+	/// </summary>
+	template <typename T, std::enable_if_t<is_block_item_v<T>, int> = 0>
+	bool SerializeBlock(T* data, size_t size)
+	{
+		if (mIndex != 0)
+		{
+			for (size_t i = 0; i < size; ++i) {
+				SerializeValue(data[i]);
+			}
+			return true;
+		}
+		mSnapshotWriter->WriteBlock(GetNumberType<fixed_number_t<T>>(), data, size);
+		mIndex = size;
+		return true;
+	}
+
+	std::optional<SnapshotWriteObjectScope> OpenObjectScope();
+
+	std::optional<SnapshotWriteArrayScope> OpenArrayScope(size_t)
+	{
+		++mIndex;
+		return std::make_optional<SnapshotWriteArrayScope>(mSnapshotWriter, GetContext(), this);
+	}
+
+private:
+	ISnapshotWriter* mSnapshotWriter;
+	size_t mIndex = 0;
+};
+
+
+/// <summary>
+/// Snapshot scope for writing objects (list of values with keys).
+/// </summary>
+class SnapshotWriteObjectScope final : public TArchiveScope<SerializeMode::Save>, public SnapshotScopeBase
+{
+public:
+	SnapshotWriteObjectScope(ISnapshotWriter* snapshotWriter, SerializationContext& serializationContext,
+		const SnapshotScopeBase* parent = nullptr, std::string_view parentKey = {})
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, SnapshotScopeBase(parent, parentKey)
+		, mSnapshotWriter(snapshotWriter)
+	{
+		mSnapshotWriter->BeginMap();
+	}
+
+	~SnapshotWriteObjectScope()
+	{
+		mSnapshotWriter->EndMap(mSize);
+	}
+
+	/// <summary>
+	/// Constant iterator for keys (saved keys are not accessible, so the range is always empty).
+	/// </summary>
+	class key_const_iterator
+	{
+	public:
+		bool operator==(const key_const_iterator&) const noexcept { return true; }
+		bool operator!=(const key_const_iterator&) const noexcept { return false; }
+		key_const_iterator& operator++() noexcept { return *this; }
+		key_type operator*() const { return {}; }
+	};
+
+	[[nodiscard]] key_const_iterator cbegin() const noexcept { return {}; }
+	[[nodiscard]] key_const_iterator cend() const noexcept { return {}; }
+
+	template <typename TKey, typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(TKey&& key, T& value)
+	{
+		WriteKey(key);
+		SaveValue(mSnapshotWriter, value);
+		return true;
+	}
+
+	template <typename TKey, typename TSym, typename TAllocator>
+	bool SerializeValue(TKey&& key, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		WriteKey(key);
+		SaveValue(mSnapshotWriter, value);
+		return true;
+	}
+
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, std::string_view& value)
+	{
+		WriteKey(key);
+		mSnapshotWriter->WriteString(value);
+		return true;
+	}
+
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, CBinTimestamp& timestamp)
+	{
+		WriteKey(key);
+		mSnapshotWriter->WriteTimestamp(timestamp);
+		return true;
+	}
+
+	template <typename TKey>
+	std::optional<SnapshotWriteObjectScope> OpenObjectScope(TKey&& key)
+	{
+		const std::string_view keyView = WriteKey(key);
+		return std::make_optional<SnapshotWriteObjectScope>(mSnapshotWriter, GetContext(), this, keyView);
+	}
+
+	template <typename TKey>
+	std::optional<SnapshotWriteArrayScope> OpenArrayScope(TKey&& key, size_t)
+	{
+		const std::string_view keyView = WriteKey(key);
+		return std::make_optional<SnapshotWriteArrayScope>(mSnapshotWriter, GetContext(), this, keyView);
+	}
+
+private:
+	template <typename TKey>
+	std::string_view WriteKey(const TKey& key)
+	{
+		const std::string_view keyView(key);
+		mSnapshotWriter->WriteKey(keyView);
+		++mSize;
+		return keyView;
+	}
+
+	ISnapshotWriter* mSnapshotWriter;
+	size_t mSize = 0;
+};
+
+inline std::optional<SnapshotWriteObjectScope> SnapshotWriteArrayScope::OpenObjectScope()
+{
+	++mIndex;
+	return std::make_optional<SnapshotWriteObjectScope>(mSnapshotWriter, GetContext(), this);
+}
+
+
+/// <summary>
+/// Snapshot root scope (can write value, array or object)
+/// </summary>
+class SnapshotWriteRootScope final : public TArchiveScope<SerializeMode::Save>, public SnapshotScopeBase
+{
+public:
+	SnapshotWriteRootScope(std::string& outputData, SerializationContext& serializationContext);
+	SnapshotWriteRootScope(std::vector<uint8_t>& outputData, SerializationContext& serializationContext);
+	SnapshotWriteRootScope(std::ostream& outputStream, SerializationContext& serializationContext);
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		SaveValue(mSnapshotWriter.get(), value);
+		return true;
+	}
+
+	template <typename TSym, typename TAllocator>
+	bool SerializeValue(std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		SaveValue(mSnapshotWriter.get(), value);
+		return true;
+	}
+
+	bool SerializeValue(std::string_view& value)
+	{
+		mSnapshotWriter->WriteString(value);
+		return true;
+	}
+
+	bool SerializeValue(CBinTimestamp& timestamp)
+	{
+		mSnapshotWriter->WriteTimestamp(timestamp);
+		return true;
+	}
+
+	std::optional<SnapshotWriteObjectScope> OpenObjectScope()
+	{
+		return std::make_optional<SnapshotWriteObjectScope>(mSnapshotWriter.get(), GetContext());
+	}
+
+	std::optional<SnapshotWriteArrayScope> OpenArrayScope(size_t)
+	{
+		return std::make_optional<SnapshotWriteArrayScope>(mSnapshotWriter.get(), GetContext());
+	}
+
+	void Finalize()
+	{
+		mSnapshotWriter->Flush();
+	}
+
+private:
+	std::unique_ptr<ISnapshotWriter> mSnapshotWriter;
+};
+
+
+// Forward declarations
+class SnapshotReadObjectScope;
+
+/// <summary>
+/// Snapshot scope for reading arrays (list of values without keys).
+/// </summary>
+class SnapshotReadArrayScope final : public TArchiveScope<SerializeMode::Load>, public SnapshotScopeBase
+{
+public:
+	SnapshotReadArrayScope(ISnapshotReader* snapshotReader, size_t arraySize, size_t endPos, SerializationContext& serializationContext,
+		const SnapshotScopeBase* parent = nullptr, std::string_view parentKey = {}) noexcept
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, SnapshotScopeBase(parent, parentKey)
+		, mSnapshotReader(snapshotReader)
+		, mSize(arraySize)
+		, mEndPos(endPos)
+	{ }
+
+	~SnapshotReadArrayScope()
+	{
+		// Skip not loaded items (the size of array is known, so it does not require parsing them)
+		mSnapshotReader->EndArray(mEndPos);
+	}
+
+	/// <summary>
+	/// Gets the current path in Snapshot (in the same format as JSON Pointer).
+	/// </summary>
+	[[nodiscard]] std::string GetPath() const override
+	{
+		return SnapshotScopeBase::GetPath() + path_separator + Convert::ToString(mIndex);
+	}
+
+	/// <summary>
+	/// Returns the exact number of items to load (for reserving the size of containers).
+	/// </summary>
+	[[nodiscard]] size_t GetEstimatedSize() const noexcept
+	{
+		return mSize;
+	}
+
+	/// <summary>
+	/// Returns `true` when all no more values to load.
+	/// </summary>
+	[[nodiscard]] bool IsEnd() const noexcept
+	{
+		return mIndex == mSize;
+	}
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		NextItem();
+		return LoadValue(mSnapshotReader, value);
+	}
+
+	template <typename TSym, typename TAllocator>
+	bool SerializeValue(std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		NextItem();
+		return LoadValue(mSnapshotReader, value);
+	}
+
+	/// <summary>
+	/// Reads the value as view to the input data (valid until the archive is destroyed).
+	/// </summary>
+	bool SerializeValue(std::string_view& value)
+	{
+		NextItem();
+		return mSnapshotReader->ReadValue(value);
+	}
+
+	bool SerializeValue(CBinTimestamp& timestamp)
+	{
+		NextItem();
+		return mSnapshotReader->ReadValue(timestamp);
+	}
+
+	/// <summary>
+	/// Loads all items of array into the continuous block of memory.
+	/// When the array was saved as block of the same type, it is just copied, otherwise items are loaded one by one with conversion.
+	/// </summary>
+	template <typename T, std::enable_if_t<is_block_item_v<T>, int> = 0>
+	bool SerializeBlock(T* data, size_t size)
+	{
+		if (mIndex != 0 || size != mSize)
+		{
+			throw SerializationException(SerializationErrorCode::OutOfRange,
+				"The size of target block does not match the number of loading items");
+		}
+		if (mSnapshotReader->ReadBlock(GetNumberType<fixed_number_t<T>>(), data, size))
+		{
+			mIndex = size;
+			return true;
+		}
+		for (size_t i = 0; i < size; ++i) {
+			SerializeValue(data[i]);
+		}
+		return true;
+	}
+
+	std::optional<SnapshotReadObjectScope> OpenObjectScope();
+
+	std::optional<SnapshotReadArrayScope> OpenArrayScope(size_t)
+	{
+		NextItem();
+		if (size_t actualSize, endPos; mSnapshotReader->ReadArraySize(actualSize, endPos)) {
+			return std::make_optional<SnapshotReadArrayScope>(mSnapshotReader, actualSize, endPos, GetContext(), this);
+		}
+		return std::nullopt;
+	}
+
+private:
+	void NextItem()
+	{
+		if (mIndex == mSize) {
+			throw SerializationException(SerializationErrorCode::OutOfRange, "No more items to load");
+		}
+		++mIndex;
+	}
+
+	ISnapshotReader* mSnapshotReader;
+	size_t mSize;
+	size_t mEndPos;
+	size_t mIndex = 0;
+};
+
+
+/// <summary>
+/// Snapshot scope for reading objects (list of values with keys).
+/// Values are searched starting from the last loaded one, so loading in the same order as they were saved does not require any lookups.
+/// </summary>
+class SnapshotReadObjectScope final : public TArchiveScope<SerializeMode::Load>, public SnapshotScopeBase
+{
+public:
+	SnapshotReadObjectScope(ISnapshotReader* snapshotReader, size_t mapSize, size_t endPos, SerializationContext& serializationContext,
+		const SnapshotScopeBase* parent = nullptr, std::string_view parentKey = {}) noexcept
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, SnapshotScopeBase(parent, parentKey)
+		, mSnapshotReader(snapshotReader)
+		, mSize(mapSize)
+		, mStartPos(snapshotReader->GetPosition())
+		, mEndPos(endPos)
+	{ }
+
+	~SnapshotReadObjectScope()
+	{
+		// Skip not loaded items (the size of map is known, so it does not require parsing them)
+		mSnapshotReader->SetPosition(mEndPos);
+	}
+
+	/// <summary>
+	/// Constant iterator for keys.
+	/// </summary>
+	class key_const_iterator
+	{
+		friend class SnapshotReadObjectScope;
+
+		ISnapshotReader* mSnapshotReader;
+		size_t mPos;
+		size_t mIndex;
+
+		key_const_iterator(ISnapshotReader* snapshotReader, size_t pos, size_t index) noexcept
+			: mSnapshotReader(snapshotReader), mPos(pos), mIndex(index) { }
+
+	public:
+		bool operator==(const key_const_iterator& rhs) const noexcept {
+			return mIndex == rhs.mIndex;
+		}
+		bool operator!=(const key_const_iterator& rhs) const noexcept {
+			return mIndex != rhs.mIndex;
+		}
+
+		key_const_iterator& operator++() noexcept
+		{
+			const size_t currentPos = mSnapshotReader->GetPosition();
+			mSnapshotReader->SetPosition(mPos);
+			std::string_view key;
+			mSnapshotReader->ReadKey(key);
+			mSnapshotReader->SkipValue();
+			mPos = mSnapshotReader->GetPosition();
+			mSnapshotReader->SetPosition(currentPos);
+			++mIndex;
+			return *this;
+		}
+
+		key_type operator*() const
+		{
+			const size_t currentPos = mSnapshotReader->GetPosition();
+			mSnapshotReader->SetPosition(mPos);
+			std::string_view key;
+			mSnapshotReader->ReadKey(key);
+			mSnapshotReader->SetPosition(currentPos);
+			return key_type(key);
+		}
+	};
+
+	/// <summary>
+	/// Get the begin constant iterator of keys.
+	/// </summary>
+	[[nodiscard]] key_const_iterator cbegin() const noexcept {
+		return { mSnapshotReader, mStartPos, 0 };
+	}
+
+	/// <summary>
+	/// Get the end constant iterator of keys.
+	/// </summary>
+	[[nodiscard]] key_const_iterator cend() const noexcept {
+		return { mSnapshotReader, 0, mSize };
+	}
+
+	/// <summary>
+	/// Returns the exact number of items to load (for reserving the size of containers).
+	/// </summary>
+	[[nodiscard]] size_t GetEstimatedSize() const noexcept
+	{
+		return mSize;
+	}
+
+	template <typename TKey, typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(TKey&& key, T& value)
+	{
+		return FindValue(key) && LoadValue(mSnapshotReader, value);
+	}
+
+	template <typename TKey, typename TSym, typename TAllocator>
+	bool SerializeValue(TKey&& key, std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		return FindValue(key) && LoadValue(mSnapshotReader, value);
+	}
+
+	/// <summary>
+	/// Reads the value as view to the input data (valid until the archive is destroyed).
+	/// </summary>
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, std::string_view& value)
+	{
+		return FindValue(key) && mSnapshotReader->ReadValue(value);
+	}
+
+	template <typename TKey>
+	bool SerializeValue(TKey&& key, CBinTimestamp& timestamp)
+	{
+		return FindValue(key) && mSnapshotReader->ReadValue(timestamp);
+	}
+
+	template <typename TKey>
+	std::optional<SnapshotReadObjectScope> OpenObjectScope(TKey&& key)
+	{
+		const std::string_view keyView(key);
+		if (size_t mapSize, endPos; FindValue(keyView) && mSnapshotReader->ReadMapSize(mapSize, endPos)) {
+			return std::make_optional<SnapshotReadObjectScope>(mSnapshotReader, mapSize, endPos, GetContext(), this, keyView);
+		}
+		return std::nullopt;
+	}
+
+	template <typename TKey>
+	std::optional<SnapshotReadArrayScope> OpenArrayScope(TKey&& key, size_t)
+	{
+		const std::string_view keyView(key);
+		if (size_t actualSize, endPos; FindValue(keyView) && mSnapshotReader->ReadArraySize(actualSize, endPos)) {
+			return std::make_optional<SnapshotReadArrayScope>(mSnapshotReader, actualSize, endPos, GetContext(), this, keyView);
+		}
+		return std::nullopt;
+	}
+
+private:
+	/// <summary>
+	/// Finds the value by key, starts searching from the current position of reader (must point to the key).
+	/// When the key is found, the reader will be positioned on the value.
+	/// </summary>
+	bool FindValue(std::string_view key) noexcept
+	{
+		for (size_t i = 0; i < mSize; ++i)
+		{
+			if (mNextIndex == mSize)
+			{
+				mNextIndex = 0;
+				mSnapshotReader->SetPosition(mStartPos);
+			}
+
+			++mNextIndex;
+			std::string_view currentKey;
+			mSnapshotReader->ReadKey(currentKey);
+			if (currentKey == key) {
+				return true;
+			}
+			mSnapshotReader->SkipValue();
+		}
+		return false;
+	}
+
+	ISnapshotReader* mSnapshotReader;
+	size_t mSize;
+	size_t mStartPos;
+	size_t mEndPos;
+	size_t mNextIndex = 0;
+};
+
+inline std::optional<SnapshotReadObjectScope> SnapshotReadArrayScope::OpenObjectScope()
+{
+	NextItem();
+	if (size_t mapSize, endPos; mSnapshotReader->ReadMapSize(mapSize, endPos)) {
+		return std::make_optional<SnapshotReadObjectScope>(mSnapshotReader, mapSize, endPos, GetContext(), this);
+	}
+	return std::nullopt;
+}
+
+
+/// <summary>
+/// Snapshot root scope (can read value, array or object)
+/// </summary>
+class SnapshotReadRootScope final : public TArchiveScope<SerializeMode::Load>, public SnapshotScopeBase
+{
+public:
+	SnapshotReadRootScope(std::string_view inputData, SerializationContext& serializationContext);
+	SnapshotReadRootScope(const std::vector<uint8_t>& inputData, SerializationContext& serializationContext);
+	SnapshotReadRootScope(std::istream& inputStream, SerializationContext& serializationContext);
+
+	template <typename T, std::enable_if_t<std::is_fundamental_v<T>, int> = 0>
+	bool SerializeValue(T& value)
+	{
+		return LoadValue(mSnapshotReader.get(), value);
+	}
+
+	template <typename TSym, typename TAllocator>
+	bool SerializeValue(std::basic_string<TSym, std::char_traits<TSym>, TAllocator>& value)
+	{
+		return LoadValue(mSnapshotReader.get(), value);
+	}
+
+	/// <summary>
+	/// Reads the value as view to the input data (valid until the archive is destroyed).
+	/// </summary>
+	bool SerializeValue(std::string_view& value)
+	{
+		return mSnapshotReader->ReadValue(value);
+	}
+
+	bool SerializeValue(CBinTimestamp& timestamp)
+	{
+		return mSnapshotReader->ReadValue(timestamp);
+	}
+
+	std::optional<SnapshotReadObjectScope> OpenObjectScope()
+	{
+		if (size_t mapSize, endPos; mSnapshotReader->ReadMapSize(mapSize, endPos)) {
+			return std::make_optional<SnapshotReadObjectScope>(mSnapshotReader.get(), mapSize, endPos, GetContext());
+		}
+		return std::nullopt;
+	}
+
+	std::optional<SnapshotReadArrayScope> OpenArrayScope(size_t)
+	{
+		if (size_t actualSize, endPos; mSnapshotReader->ReadArraySize(actualSize, endPos)) {
+			return std::make_optional<SnapshotReadArrayScope>(mSnapshotReader.get(), actualSize, endPos, GetContext());
+		}
+		return std::nullopt;
+	}
+
+	void Finalize() const noexcept { /* Not required */ }
+
+private:
+	std::string mStreamData;
+	std::unique_ptr<ISnapshotReader> mSnapshotReader;
+};
+
+}
+
+
+/// <summary>
+/// Binary snapshot archive (internal implementation - no dependencies).
+/// The data is stored in the native byte order with aligned values, arrays of numbers are stored as continuous blocks,
+/// so they are loaded just by copying memory. Strings can be loaded as views (without copying) from the input data,
+/// which can be a memory mapped file.
+/// Supports load/save from:
+/// - <c>std::string</c>: binary data
+/// - <c>std::vector&lt;uint8_t&gt;</c>: binary data
+/// - <c>std::istream</c> and <c>std::ostream</c>: binary data
+/// </summary>
+using SnapshotArchive = TArchiveBase<
+	Detail::SnapshotArchiveTraits,
+	Detail::SnapshotReadRootScope,
+	Detail::SnapshotWriteRootScope>;
+
+}
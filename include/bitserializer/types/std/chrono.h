@@ -5,6 +5,7 @@
 #pragma once
 #include <chrono>
 #include <type_traits>
+#include "bitserializer/serialization_detail/bin_timestamp.h"
 
 namespace BitSerializer
 {
@@ -40,6 +41,40 @@ namespace BitSerializer
 			return false;
 		}
 
+		/// <summary>
+		/// Converts `std::chrono::time_point` to the binary timestamp (seconds and nanoseconds since Unix epoch).
+		/// </summary>
+		template <typename TClock, typename TDuration>
+		CBinTimestamp ToBinTimestamp(const std::chrono::time_point<TClock, TDuration>& timePoint)
+		{
+			const auto sinceEpoch = timePoint.time_since_epoch();
+			const auto seconds = std::chrono::floor<std::chrono::seconds>(sinceEpoch);
+			const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(sinceEpoch - seconds);
+			return CBinTimestamp(static_cast<int64_t>(seconds.count()), static_cast<int32_t>(nanoseconds.count()));
+		}
+
+		template <typename TClock, typename TDuration>
+		bool SafeConvertBinTimestamp(const CBinTimestamp& timestamp, std::chrono::time_point<TClock, TDuration>& targetTimePoint, const SerializationOptions& options)
+		{
+			try
+			{
+				std::chrono::time_point<TClock, TDuration> timePoint;
+				Convert::Detail::SafeAddDuration(timePoint, std::chrono::seconds(timestamp.Seconds));
+				Convert::Detail::SafeAddDuration(timePoint, std::chrono::nanoseconds(timestamp.Nanoseconds));
+				targetTimePoint = timePoint;
+				return true;
+			}
+			catch (const std::out_of_range&)
+			{
+				if (options.overflowNumberPolicy == OverflowNumberPolicy::ThrowError)
+				{
+					throw SerializationException(SerializationErrorCode::Overflow,
+						"Target timepoint range is not sufficient to deserialize timestamp: " + Convert::ToString(timestamp.Seconds) + "s");
+				}
+			}
+			return false;
+		}
+
 		template <typename TRep, typename TPeriod>
 		bool SafeConvertIsoDuration(const std::string& isoDuration, std::chrono::duration<TRep, TPeriod>& targetDuration, const SerializationOptions& options)
 		{
@@ -73,11 +108,27 @@ namespace BitSerializer
 
 	/// <summary>
 	/// Serializes std::chrono::time_point (wall clock types) as ISO 8601 string in format: YYYY-MM-DDThh:mm:ss[.SSS]Z.
+	/// Archives with native support of timestamps (which declare support of `Detail::CBinTimestamp`) store it in their own format.
 	/// </summary>
 	template <typename TArchive, typename TKey, typename TClock, typename TDuration, std::enable_if_t<(TClock::is_steady == false), int> = 0>
 	bool Serialize(TArchive& archive, TKey&& key, std::chrono::time_point<TClock, TDuration>& tpValue)
 	{
-		if constexpr (TArchive::IsLoading())
+		if constexpr (can_serialize_value_with_key_v<TArchive, Detail::CBinTimestamp, TKey>)
+		{
+			if constexpr (TArchive::IsLoading())
+			{
+				if (Detail::CBinTimestamp timestamp; archive.SerializeValue(std::forward<TKey>(key), timestamp)) {
+					return Detail::SafeConvertBinTimestamp(timestamp, tpValue, archive.GetOptions());
+				}
+				return false;
+			}
+			else
+			{
+				Detail::CBinTimestamp timestamp = Detail::ToBinTimestamp(tpValue);
+				return archive.SerializeValue(std::forward<TKey>(key), timestamp);
+			}
+		}
+		else if constexpr (TArchive::IsLoading())
 		{
 			std::string isoDate;
 			if (Serialize(archive, std::forward<TKey>(key), isoDate)) {
@@ -94,11 +145,27 @@ namespace BitSerializer
 
 	/// <summary>
 	/// Serializes std::chrono::time_point (wall clock types) as ISO 8601 string in format: YYYY-MM-DDThh:mm:ss[.SSS]Z.
+	/// Archives with native support of timestamps (which declare support of `Detail::CBinTimestamp`) store it in their own format.
 	/// </summary>
 	template<typename TArchive, typename TClock, typename TDuration, std::enable_if_t<(TClock::is_steady == false), int> = 0>
 	bool Serialize(TArchive& archive, std::chrono::time_point<TClock, TDuration>& tpValue)
 	{
-		if constexpr (TArchive::IsLoading())
+		if constexpr (can_serialize_value_v<TArchive, Detail::CBinTimestamp>)
+		{
+			if constexpr (TArchive::IsLoading())
+			{
+				if (Detail::CBinTimestamp timestamp; archive.SerializeValue(timestamp)) {
+					return Detail::SafeConvertBinTimestamp(timestamp, tpValue, archive.GetOptions());
+				}
+				return false;
+			}
+			else
+			{
+				Detail::CBinTimestamp timestamp = Detail::ToBinTimestamp(tpValue);
+				return archive.SerializeValue(timestamp);
+			}
+		}
+		else if constexpr (TArchive::IsLoading())
 		{
 			std::string isoDate;
 			if (Serialize(archive, isoDate)) {
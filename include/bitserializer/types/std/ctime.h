@@ -5,6 +5,7 @@
 #pragma once
 #include <ctime>
 #include "bitserializer/conversion_detail/convert_chrono.h"
+#include "bitserializer/serialization_detail/bin_timestamp.h"
 
 namespace BitSerializer
 {
@@ -45,12 +46,24 @@ namespace BitSerializer
 
 	/// <summary>
 	/// Serializes Unix time in the `time_t` as ISO 8601/UTC string (YYYY-MM-DDThh:mm:ssZ).
+	/// Archives with native support of timestamps (which declare support of `Detail::CBinTimestamp`) store it in their own format.
 	///	Usage example: archive << MakeKeyValue("Time", CTimeRef(timeValue));
 	/// </summary>
 	template <typename TArchive, typename TKey>
 	bool Serialize(TArchive& archive, TKey&& key, CTimeRef timeRef)
 	{
-		if constexpr (TArchive::IsLoading())
+		if constexpr (can_serialize_value_with_key_v<TArchive, Detail::CBinTimestamp, TKey>)
+		{
+			// Fractions of second are ignored when loading (like in the ISO string)
+			Detail::CBinTimestamp timestamp(static_cast<int64_t>(timeRef.Time));
+			if (archive.SerializeValue(std::forward<TKey>(key), timestamp))
+			{
+				timeRef.Time = static_cast<time_t>(timestamp.Seconds);
+				return true;
+			}
+			return false;
+		}
+		else if constexpr (TArchive::IsLoading())
 		{
 			std::string isoDate;
 			if (Serialize(archive, std::forward<TKey>(key), isoDate)) {
@@ -67,12 +80,24 @@ namespace BitSerializer
 
 	/// <summary>
 	/// Serializes Unix time in the `time_t` as ISO 8601/UTC string (YYYY-MM-DDThh:mm:ssZ).
+	/// Archives with native support of timestamps (which declare support of `Detail::CBinTimestamp`) store it in their own format.
 	///	Usage example: archive << MakeKeyValue("Time", CTimeRef(timeValue));
 	/// </summary>
 	template<typename TArchive>
 	bool Serialize(TArchive& archive, CTimeRef timeRef)
 	{
-		if constexpr (TArchive::IsLoading())
+		if constexpr (can_serialize_value_v<TArchive, Detail::CBinTimestamp>)
+		{
+			// Fractions of second are ignored when loading (like in the ISO string)
+			Detail::CBinTimestamp timestamp(static_cast<int64_t>(timeRef.Time));
+			if (archive.SerializeValue(timestamp))
+			{
+				timeRef.Time = static_cast<time_t>(timestamp.Seconds);
+				return true;
+			}
+			return false;
+		}
+		else if constexpr (TArchive::IsLoading())
 		{
 			std::string isoDate;
 			if (Serialize(archive, isoDate)) {
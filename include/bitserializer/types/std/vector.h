@@ -14,7 +14,25 @@ namespace BitSerializer
 	template<typename TArchive, typename TValue, typename TAllocator>
 	void SerializeArray(TArchive& archive, std::vector<TValue, TAllocator>& cont)
 	{
-		Detail::SerializeContainer(archive, cont);
+		// Fundamental values can be serialized as one continuous block (when it is supported by archive)
+		if constexpr (can_serialize_block_v<TArchive, TValue>)
+		{
+			if constexpr (TArchive::IsLoading())
+			{
+				cont.resize(archive.GetEstimatedSize());
+				// Do not leave default items when the block was not loaded
+				if (!archive.SerializeBlock(cont.data(), cont.size())) {
+					cont.clear();
+				}
+			}
+			else {
+				archive.SerializeBlock(cont.data(), cont.size());
+			}
+		}
+		else
+		{
+			Detail::SerializeContainer(archive, cont);
+		}
 	}
 
 	/// <summary>
@@ -0,0 +1,44 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <istream>
+#include "bson_readers.h"
+#include "bson_writers.h"
+#include "bitserializer/serialization_detail/archive_helpers.h"
+
+
+namespace BitSerializer::Bson::Detail
+{
+	BsonWriteRootScope::BsonWriteRootScope(std::string& outputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mBsonWriter(std::make_unique<CBsonBufferWriter<std::string>>(outputData))
+	{ }
+
+	BsonWriteRootScope::BsonWriteRootScope(std::vector<uint8_t>& outputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mBsonWriter(std::make_unique<CBsonBufferWriter<std::vector<uint8_t>>>(outputData))
+	{ }
+
+	BsonWriteRootScope::BsonWriteRootScope(std::ostream& outputStream, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mBsonWriter(std::make_unique<CBsonStreamWriter>(outputStream))
+	{ }
+
+	BsonReadRootScope::BsonReadRootScope(std::string_view inputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mBsonReader(std::make_unique<CBsonReader>(inputData, serializationContext.GetOptions()))
+	{ }
+
+	BsonReadRootScope::BsonReadRootScope(const std::vector<uint8_t>& inputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mBsonReader(std::make_unique<CBsonReader>(
+			std::string_view(reinterpret_cast<const char*>(inputData.data()), inputData.size()), serializationContext.GetOptions()))
+	{ }
+
+	BsonReadRootScope::BsonReadRootScope(std::istream& inputStream, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mStreamData(BitSerializer::Detail::ReadAllFromStream(inputStream))
+		, mBsonReader(std::make_unique<CBsonReader>(mStreamData, serializationContext.GetOptions()))
+	{ }
+}
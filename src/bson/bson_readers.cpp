@@ -0,0 +1,498 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <cstring>
+#include "bson_readers.h"
+#include "bitserializer/serialization_detail/archive_helpers.h"
+
+
+namespace
+{
+	using namespace BitSerializer;
+	using namespace BitSerializer::Bson::Detail;
+	using BitSerializer::Detail::CastNumber;
+	using BitSerializer::Detail::ReadLittleEndian;
+
+	constexpr size_t MinDocumentSize = 5;
+	constexpr size_t ObjectIdSize = 12;
+	constexpr size_t Decimal128Size = 16;
+
+	int32_t ReadInt32(std::string_view data, size_t pos) noexcept
+	{
+		return static_cast<int32_t>(static_cast<uint32_t>(ReadLittleEndian(data.data() + pos, sizeof(int32_t))));
+	}
+
+	/// <summary>
+	/// Checks the size which is stored at passed position (it must be in range [minSize, limit - pos - sizeOffset]).
+	/// </summary>
+	bool CheckSize(std::string_view data, size_t pos, size_t limit, size_t minSize, size_t sizeOffset, size_t& size) noexcept
+	{
+		// The size itself and data which follow it (like ObjectId of DbPointer) must fit before the limit
+		if (limit - pos < sizeof(int32_t) || limit - pos < sizeOffset) {
+			return false;
+		}
+		const int32_t value = ReadInt32(data, pos);
+		if (value < 0 || static_cast<size_t>(value) < minSize || static_cast<size_t>(value) > limit - pos - sizeOffset) {
+			return false;
+		}
+		size = static_cast<size_t>(value);
+		return true;
+	}
+
+	/// <summary>
+	/// Returns the position after the terminating zero of string (or zero when it is not found before the limit).
+	/// </summary>
+	size_t SkipCString(std::string_view data, size_t pos, size_t limit) noexcept
+	{
+		const void* terminator = std::memchr(data.data() + pos, 0, limit - pos);
+		return terminator ? static_cast<size_t>(static_cast<const char*>(terminator) - data.data()) + 1 : 0;
+	}
+}
+
+namespace BitSerializer::Bson::Detail
+{
+	CBsonReader::CBsonReader(std::string_view inputData, const SerializationOptions& serializationOptions)
+		: mInputData(inputData)
+		, mSerializationOptions(serializationOptions)
+	{
+		ValidateInput();
+	}
+
+	void CBsonReader::ReadKey(std::string_view& key) noexcept
+	{
+		if (mIsBinary)
+		{
+			// Items of binary data do not have keys
+			mType = BsonType::Binary;
+			mValuePos = mPos;
+			mValueEndPos = mPos + 1;
+			return;
+		}
+
+		mType = static_cast<BsonType>(mInputData[mPos]);
+		const size_t keyPos = mPos + 1;
+		const size_t keySize = std::strlen(mInputData.data() + keyPos);
+		key = mInputData.substr(keyPos, keySize);
+		mValuePos = mPos = keyPos + keySize + 1;
+		mValueEndPos = mValuePos + GetValueSize(mType, mValuePos);
+	}
+
+	bool CBsonReader::ReadValue(std::nullptr_t&)
+	{
+		if (mType == BsonType::Null)
+		{
+			mPos = mValueEndPos;
+			return true;
+		}
+		return HandleMismatchedType();
+	}
+
+	bool CBsonReader::ReadValue(bool& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CBsonReader::ReadValue(uint8_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CBsonReader::ReadValue(uint16_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CBsonReader::ReadValue(uint32_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CBsonReader::ReadValue(uint64_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CBsonReader::ReadValue(int8_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CBsonReader::ReadValue(int16_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CBsonReader::ReadValue(int32_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CBsonReader::ReadValue(int64_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CBsonReader::ReadValue(float& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CBsonReader::ReadValue(double& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CBsonReader::ReadValue(std::string_view& value)
+	{
+		switch (mType)
+		{
+		case BsonType::String:
+		case BsonType::Symbol:
+		case BsonType::JavaScript:
+			// The size includes the terminating zero
+			value = mInputData.substr(mValuePos + sizeof(int32_t), static_cast<size_t>(ReadInt32(mInputData, mValuePos)) - 1);
+			break;
+		case BsonType::Binary:
+			if (mIsBinary) {
+				return HandleMismatchedType();
+			}
+			value = mInputData.substr(mValuePos + sizeof(int32_t) + 1, static_cast<size_t>(ReadInt32(mInputData, mValuePos)));
+			break;
+		case BsonType::Null:
+			// Null value is excluded from MismatchedTypesPolicy processing
+			mPos = mValueEndPos;
+			return false;
+		default:
+			return HandleMismatchedType();
+		}
+		mPos = mValueEndPos;
+		return true;
+	}
+
+	bool CBsonReader::ReadValue(CBinTimestamp& timestamp)
+	{
+		switch (mType)
+		{
+		case BsonType::DateTime:
+		{
+			// Number of milliseconds since Unix epoch (seconds are rounded down for negative values)
+			const auto milliseconds = static_cast<int64_t>(ReadLittleEndian(mInputData.data() + mValuePos, sizeof(int64_t)));
+			int64_t seconds = milliseconds / 1000;
+			int64_t fraction = milliseconds % 1000;
+			if (fraction < 0)
+			{
+				--seconds;
+				fraction += 1000;
+			}
+			timestamp = CBinTimestamp(seconds, static_cast<int32_t>(fraction * 1000000));
+			break;
+		}
+		case BsonType::Timestamp:
+			// Internal timestamp of document databases (the high 32 bits contain seconds since Unix epoch)
+			timestamp = CBinTimestamp(static_cast<int64_t>(ReadLittleEndian(mInputData.data() + mValuePos, sizeof(uint64_t)) >> 32));
+			break;
+		case BsonType::Null:
+			// Null value is excluded from MismatchedTypesPolicy processing
+			mPos = mValueEndPos;
+			return false;
+		default:
+			return HandleMismatchedType();
+		}
+		mPos = mValueEndPos;
+		return true;
+	}
+
+	void CBsonReader::ReadRootDocument(size_t& endPos)
+	{
+		if (mPos == mInputData.size()) {
+			throw ParsingException("Unexpected end of BSON data", 0, mPos);
+		}
+		endPos = mPos + static_cast<size_t>(ReadInt32(mInputData, mPos));
+		mPos += sizeof(int32_t);
+	}
+
+	size_t CBsonReader::CountRootDocuments() const noexcept
+	{
+		size_t count = 0;
+		for (size_t pos = mPos; pos != mInputData.size(); ++count) {
+			pos += static_cast<size_t>(ReadInt32(mInputData, pos));
+		}
+		return count;
+	}
+
+	bool CBsonReader::ReadDocument(size_t& endPos)
+	{
+		mPos = mValueEndPos;
+		if (mType == BsonType::Document)
+		{
+			endPos = mValueEndPos;
+			mPos = mValuePos + sizeof(int32_t);
+			return true;
+		}
+		return false;
+	}
+
+	bool CBsonReader::ReadArray(size_t& arraySize, size_t& endPos)
+	{
+		mPos = mValueEndPos;
+		switch (mType)
+		{
+		case BsonType::Array:
+			endPos = mValueEndPos;
+			mPos = mValuePos + sizeof(int32_t);
+			arraySize = CountElements(mPos, endPos - 1);
+			return true;
+		case BsonType::Binary:
+			if (mIsBinary) {
+				return false;
+			}
+			endPos = mValueEndPos;
+			arraySize = static_cast<size_t>(ReadInt32(mInputData, mValuePos));
+			mPos = mValuePos + sizeof(int32_t) + 1;
+			mIsBinary = true;
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	size_t CBsonReader::CountElements(size_t startPos, size_t endPos) const noexcept
+	{
+		size_t count = 0;
+		for (size_t pos = startPos; pos < endPos; ++count)
+		{
+			const auto type = static_cast<BsonType>(mInputData[pos]);
+			pos += std::strlen(mInputData.data() + pos + 1) + 2;
+			pos += GetValueSize(type, pos);
+		}
+		return count;
+	}
+
+	bool CBsonReader::ReadBinary(void* data, size_t size) noexcept
+	{
+		if (!mIsBinary) {
+			return false;
+		}
+		if (size != 0) {
+			std::memcpy(data, mInputData.data() + mPos, size);
+		}
+		mPos += size;
+		return true;
+	}
+
+	void CBsonReader::EndArray(size_t endPos) noexcept
+	{
+		mPos = endPos;
+		mIsBinary = false;
+	}
+
+	void CBsonReader::SkipValue() noexcept
+	{
+		mPos = mValueEndPos;
+	}
+
+	template <typename T>
+	bool CBsonReader::ReadNumber(T& value)
+	{
+		const auto overflowNumberPolicy = mSerializationOptions.overflowNumberPolicy;
+		const char* valueData = mInputData.data() + mValuePos;
+		switch (mType)
+		{
+		case BsonType::Int32:
+			mPos = mValueEndPos;
+			return CastNumber(ReadInt32(mInputData, mValuePos), value, overflowNumberPolicy);
+		case BsonType::Int64:
+			mPos = mValueEndPos;
+			return CastNumber(static_cast<int64_t>(ReadLittleEndian(valueData, sizeof(int64_t))), value, overflowNumberPolicy);
+		case BsonType::Double:
+		{
+			mPos = mValueEndPos;
+			const uint64_t bits = ReadLittleEndian(valueData, sizeof(uint64_t));
+			double doubleValue;
+			std::memcpy(&doubleValue, &bits, sizeof(doubleValue));
+			return CastNumber(doubleValue, value, overflowNumberPolicy);
+		}
+		case BsonType::Boolean:
+			if constexpr (std::is_integral_v<T>)
+			{
+				mPos = mValueEndPos;
+				return CastNumber(*valueData != 0, value, overflowNumberPolicy);
+			}
+			break;
+		case BsonType::Binary:
+			if (mIsBinary)
+			{
+				mPos = mValueEndPos;
+				return CastNumber(static_cast<uint8_t>(*valueData), value, overflowNumberPolicy);
+			}
+			break;
+		case BsonType::Null:
+			// Null value is excluded from MismatchedTypesPolicy processing
+			mPos = mValueEndPos;
+			return false;
+		default:
+			break;
+		}
+		return HandleMismatchedType();
+	}
+
+	size_t CBsonReader::GetValueSize(BsonType type, size_t pos) const noexcept
+	{
+		switch (type)
+		{
+		case BsonType::Boolean:
+			return 1;
+		case BsonType::Int32:
+			return sizeof(int32_t);
+		case BsonType::Double:
+		case BsonType::DateTime:
+		case BsonType::Timestamp:
+		case BsonType::Int64:
+			return sizeof(int64_t);
+		case BsonType::ObjectId:
+			return ObjectIdSize;
+		case BsonType::Decimal128:
+			return Decimal128Size;
+		case BsonType::String:
+		case BsonType::JavaScript:
+		case BsonType::Symbol:
+			return sizeof(int32_t) + static_cast<size_t>(ReadInt32(mInputData, pos));
+		case BsonType::Document:
+		case BsonType::Array:
+		case BsonType::JavaScriptWithScope:
+			return static_cast<size_t>(ReadInt32(mInputData, pos));
+		case BsonType::Binary:
+			return sizeof(int32_t) + 1 + static_cast<size_t>(ReadInt32(mInputData, pos));
+		case BsonType::DbPointer:
+			return sizeof(int32_t) + static_cast<size_t>(ReadInt32(mInputData, pos)) + ObjectIdSize;
+		case BsonType::Regex:
+		{
+			// Pattern and options (two C-strings)
+			const size_t patternSize = std::strlen(mInputData.data() + pos) + 1;
+			return patternSize + std::strlen(mInputData.data() + pos + patternSize) + 1;
+		}
+		default:
+			return 0;
+		}
+	}
+
+	void CBsonReader::ValidateInput() const
+	{
+		// End positions of opened documents
+		std::vector<size_t> openedDocuments;
+		size_t pos = 0;
+		while (pos != mInputData.size())
+		{
+			size_t size;
+			if (!CheckSize(mInputData, pos, mInputData.size(), MinDocumentSize, 0, size) || mInputData[pos + size - 1] != 0) {
+				throw ParsingException("Invalid size of BSON document", 0, pos);
+			}
+			openedDocuments.push_back(pos + size);
+			pos += sizeof(int32_t);
+
+			while (!openedDocuments.empty())
+			{
+				// Elements are limited by the terminating zero of document
+				const size_t limit = openedDocuments.back() - 1;
+				if (pos == limit)
+				{
+					pos = openedDocuments.back();
+					openedDocuments.pop_back();
+					continue;
+				}
+
+				const size_t elementPos = pos;
+				const auto type = static_cast<BsonType>(mInputData[pos]);
+				pos = SkipCString(mInputData, pos + 1, limit);
+				if (pos == 0) {
+					throw ParsingException("Invalid key of BSON element", 0, elementPos);
+				}
+
+				size_t valueSize = 0;
+				switch (type)
+				{
+				case BsonType::Undefined:
+				case BsonType::Null:
+				case BsonType::MinKey:
+				case BsonType::MaxKey:
+					break;
+				case BsonType::Boolean:
+					if (pos == limit || static_cast<uint8_t>(mInputData[pos]) > 1) {
+						throw ParsingException("Invalid boolean value", 0, elementPos);
+					}
+					valueSize = 1;
+					break;
+				case BsonType::Int32:
+				case BsonType::Double:
+				case BsonType::DateTime:
+				case BsonType::Timestamp:
+				case BsonType::Int64:
+				case BsonType::ObjectId:
+				case BsonType::Decimal128:
+					valueSize = GetValueSize(type, pos);
+					if (limit - pos < valueSize) {
+						throw ParsingException("Unexpected end of BSON data", 0, elementPos);
+					}
+					break;
+				case BsonType::String:
+				case BsonType::JavaScript:
+				case BsonType::Symbol:
+				case BsonType::DbPointer:
+				{
+					const size_t extraSize = type == BsonType::DbPointer ? ObjectIdSize : 0;
+					if (size_t strSize; !CheckSize(mInputData, pos, limit, 1, sizeof(int32_t) + extraSize, strSize)
+						|| mInputData[pos + sizeof(int32_t) + strSize - 1] != 0) {
+						throw ParsingException("Invalid size of BSON string", 0, elementPos);
+					}
+					valueSize = GetValueSize(type, pos);
+					break;
+				}
+				case BsonType::Binary:
+					if (size_t binarySize; !CheckSize(mInputData, pos, limit, 0, sizeof(int32_t) + 1, binarySize)) {
+						throw ParsingException("Invalid size of BSON binary", 0, elementPos);
+					}
+					valueSize = GetValueSize(type, pos);
+					break;
+				case BsonType::Regex:
+				{
+					const size_t optionsPos = SkipCString(mInputData, pos, limit);
+					if (optionsPos == 0 || SkipCString(mInputData, optionsPos, limit) == 0) {
+						throw ParsingException("Invalid BSON regular expression", 0, elementPos);
+					}
+					valueSize = GetValueSize(type, pos);
+					break;
+				}
+				case BsonType::JavaScriptWithScope:
+					// The code and scope are not loadable, only the total size is validated
+					if (!CheckSize(mInputData, pos, limit, MinDocumentSize + sizeof(int32_t), 0, valueSize)) {
+						throw ParsingException("Invalid size of BSON element", 0, elementPos);
+					}
+					break;
+				case BsonType::Document:
+				case BsonType::Array:
+					if (!CheckSize(mInputData, pos, limit, MinDocumentSize, 0, valueSize) || mInputData[pos + valueSize - 1] != 0) {
+						throw ParsingException("Invalid size of BSON document", 0, elementPos);
+					}
+					openedDocuments.push_back(pos + valueSize);
+					pos += sizeof(int32_t);
+					continue;
+				default:
+					throw ParsingException("Invalid type of BSON element", 0, elementPos);
+				}
+				pos += valueSize;
+			}
+		}
+	}
+
+	bool CBsonReader::HandleMismatchedType()
+	{
+		mPos = mValueEndPos;
+		if (mSerializationOptions.mismatchedTypesPolicy == MismatchedTypesPolicy::ThrowError)
+		{
+			throw SerializationException(SerializationErrorCode::MismatchedTypes,
+				"The type of target field does not match the value being loaded");
+		}
+		return false;
+	}
+}
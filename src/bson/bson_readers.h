@@ -0,0 +1,64 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include "bitserializer/bson_archive.h"
+
+namespace BitSerializer::Bson::Detail
+{
+	/// <summary>
+	/// BSON reader from the continuous block of memory.
+	/// The structure of all documents is validated in the constructor, so further reads can't go out of the input data.
+	/// Each element is accessed directly by its offset, not loaded elements are skipped in O(1) by their length prefixes.
+	/// Strings are returned as views to the input data.
+	/// </summary>
+	class CBsonReader final : public IBsonReader
+	{
+	public:
+		CBsonReader(std::string_view inputData, const SerializationOptions& serializationOptions);
+
+		[[nodiscard]] size_t GetPosition() const noexcept override { return mPos; }
+		void SetPosition(size_t pos) noexcept override { mPos = pos; }
+		void ReadKey(std::string_view& key) noexcept override;
+		bool ReadValue(std::nullptr_t& value) override;
+		bool ReadValue(bool& value) override;
+		bool ReadValue(uint8_t& value) override;
+		bool ReadValue(uint16_t& value) override;
+		bool ReadValue(uint32_t& value) override;
+		bool ReadValue(uint64_t& value) override;
+		bool ReadValue(int8_t& value) override;
+		bool ReadValue(int16_t& value) override;
+		bool ReadValue(int32_t& value) override;
+		bool ReadValue(int64_t& value) override;
+		bool ReadValue(float& value) override;
+		bool ReadValue(double& value) override;
+		bool ReadValue(std::string_view& value) override;
+		bool ReadValue(CBinTimestamp& timestamp) override;
+		void ReadRootDocument(size_t& endPos) override;
+		[[nodiscard]] size_t CountRootDocuments() const noexcept override;
+		bool ReadDocument(size_t& endPos) override;
+		bool ReadArray(size_t& arraySize, size_t& endPos) override;
+		[[nodiscard]] size_t CountElements(size_t startPos, size_t endPos) const noexcept override;
+		bool ReadBinary(void* data, size_t size) noexcept override;
+		void EndArray(size_t endPos) noexcept override;
+		void SkipValue() noexcept override;
+
+	private:
+		template <typename T>
+		bool ReadNumber(T& value);
+		[[nodiscard]] size_t GetValueSize(BsonType type, size_t pos) const noexcept;
+		void ValidateInput() const;
+		bool HandleMismatchedType();
+
+		std::string_view mInputData;
+		const SerializationOptions& mSerializationOptions;
+		size_t mPos = 0;
+		// Type, start and end position of the current value
+		BsonType mType = BsonType::EndOfDocument;
+		size_t mValuePos = 0;
+		size_t mValueEndPos = 0;
+		// The binary data which is read as array of bytes
+		bool mIsBinary = false;
+	};
+}
@@ -0,0 +1,199 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <cstring>
+#include "bson_writers.h"
+
+
+namespace
+{
+	using namespace BitSerializer;
+
+	constexpr size_t MaxDocumentSize = static_cast<size_t>(std::numeric_limits<int32_t>::max());
+	constexpr int64_t MaxDateTimeSeconds = std::numeric_limits<int64_t>::max() / 1000 - 1;
+	constexpr int64_t MinDateTimeSeconds = std::numeric_limits<int64_t>::min() / 1000 + 1;
+	constexpr uint8_t GenericBinarySubtype = 0x00;
+}
+
+namespace BitSerializer::Bson::Detail
+{
+	template <class TBuffer>
+	CBsonBufferWriter<TBuffer>::CBsonBufferWriter(TBuffer& outputBuffer, std::ostream* outputStream)
+		: mBuffer(outputBuffer)
+		, mOutputStream(outputStream)
+	{ }
+
+	template <class TBuffer>
+	void CBsonBufferWriter<TBuffer>::WriteNull(std::string_view key)
+	{
+		WriteElementHeader(BsonType::Null, key);
+	}
+
+	template <class TBuffer>
+	void CBsonBufferWriter<TBuffer>::WriteBoolean(std::string_view key, bool value)
+	{
+		WriteElementHeader(BsonType::Boolean, key);
+		mBuffer.push_back(static_cast<typename TBuffer::value_type>(value ? 1 : 0));
+	}
+
+	template <class TBuffer>
+	void CBsonBufferWriter<TBuffer>::WriteInt32(std::string_view key, int32_t value)
+	{
+		WriteElementHeader(BsonType::Int32, key);
+		WriteRawLittleEndian(static_cast<uint32_t>(value), sizeof(value));
+	}
+
+	template <class TBuffer>
+	void CBsonBufferWriter<TBuffer>::WriteInt64(std::string_view key, int64_t value)
+	{
+		WriteElementHeader(BsonType::Int64, key);
+		WriteRawLittleEndian(static_cast<uint64_t>(value), sizeof(value));
+	}
+
+	template <class TBuffer>
+	void CBsonBufferWriter<TBuffer>::WriteDouble(std::string_view key, double value)
+	{
+		WriteElementHeader(BsonType::Double, key);
+		uint64_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		WriteRawLittleEndian(bits, sizeof(bits));
+	}
+
+	template <class TBuffer>
+	void CBsonBufferWriter<TBuffer>::WriteString(std::string_view key, std::string_view value)
+	{
+		if (value.size() >= MaxDocumentSize) {
+			throw SerializationException(SerializationErrorCode::Overflow, "The string is too large for BSON");
+		}
+		WriteElementHeader(BsonType::String, key);
+		// The size includes the terminating zero
+		WriteRawLittleEndian(value.size() + 1, sizeof(int32_t));
+		mBuffer.insert(mBuffer.end(), value.cbegin(), value.cend());
+		mBuffer.push_back(0);
+	}
+
+	template <class TBuffer>
+	void CBsonBufferWriter<TBuffer>::WriteDateTime(std::string_view key, const CBinTimestamp& timestamp)
+	{
+		// UTC datetime is stored as number of milliseconds since Unix epoch (fractions of millisecond are truncated)
+		if (timestamp.Seconds > MaxDateTimeSeconds || timestamp.Seconds < MinDateTimeSeconds)
+		{
+			throw SerializationException(SerializationErrorCode::Overflow,
+				"The timestamp " + Convert::ToString(timestamp.Seconds) + " is out of range of BSON datetime");
+		}
+		const int64_t milliseconds = timestamp.Seconds * 1000 + timestamp.Nanoseconds / 1000000;
+		WriteElementHeader(BsonType::DateTime, key);
+		WriteRawLittleEndian(static_cast<uint64_t>(milliseconds), sizeof(milliseconds));
+	}
+
+	template <class TBuffer>
+	void CBsonBufferWriter<TBuffer>::WriteBinary(const void* data, size_t size)
+	{
+		if (size >= MaxDocumentSize) {
+			throw SerializationException(SerializationErrorCode::Overflow, "The binary data is too large for BSON");
+		}
+
+		// The binary replaces the just opened (empty) array
+		auto& document = mOpenedDocuments.back();
+		document.IsBinary = true;
+		mBuffer.resize(document.SizePosition);
+		mBuffer[document.TypePosition] = static_cast<typename TBuffer::value_type>(BsonType::Binary);
+
+		WriteRawLittleEndian(size, sizeof(int32_t));
+		mBuffer.push_back(static_cast<typename TBuffer::value_type>(GenericBinarySubtype));
+		const auto* bytes = static_cast<const typename TBuffer::value_type*>(data);
+		mBuffer.insert(mBuffer.end(), bytes, bytes + size);
+	}
+
+	template <class TBuffer>
+	void CBsonBufferWriter<TBuffer>::BeginRootDocument()
+	{
+		mOpenedDocuments.push_back({ mBuffer.size(), mBuffer.size(), false });
+		WriteRawLittleEndian(0, sizeof(int32_t));
+	}
+
+	template <class TBuffer>
+	void CBsonBufferWriter<TBuffer>::BeginDocument(std::string_view key)
+	{
+		const size_t typePos = mBuffer.size();
+		WriteElementHeader(BsonType::Document, key);
+		mOpenedDocuments.push_back({ typePos, mBuffer.size(), false });
+		WriteRawLittleEndian(0, sizeof(int32_t));
+	}
+
+	template <class TBuffer>
+	void CBsonBufferWriter<TBuffer>::BeginArray(std::string_view key)
+	{
+		const size_t typePos = mBuffer.size();
+		WriteElementHeader(BsonType::Array, key);
+		mOpenedDocuments.push_back({ typePos, mBuffer.size(), false });
+		WriteRawLittleEndian(0, sizeof(int32_t));
+	}
+
+	template <class TBuffer>
+	void CBsonBufferWriter<TBuffer>::EndDocument() noexcept
+	{
+		const DocumentInfo document = mOpenedDocuments.back();
+		mOpenedDocuments.pop_back();
+		if (document.IsBinary) {
+			return;
+		}
+
+		mBuffer.push_back(static_cast<typename TBuffer::value_type>(BsonType::EndOfDocument));
+		const size_t size = mBuffer.size() - document.SizePosition;
+		if (size > MaxDocumentSize)
+		{
+			// Exceptions can't be thrown from the destructor of scope, the error will be reported when flushing
+			mIsSizeOverflow = true;
+			return;
+		}
+		PatchInt32(document.SizePosition, static_cast<uint32_t>(size));
+	}
+
+	template <class TBuffer>
+	void CBsonBufferWriter<TBuffer>::Flush()
+	{
+		if (mIsSizeOverflow) {
+			throw SerializationException(SerializationErrorCode::Overflow, "The size of BSON document exceeds 2GB");
+		}
+		if (mOutputStream && mOpenedDocuments.empty())
+		{
+			mOutputStream->write(reinterpret_cast<const char*>(mBuffer.data()), static_cast<std::streamsize>(mBuffer.size()));
+			if (!mOutputStream->good()) {
+				throw SerializationException(SerializationErrorCode::InputOutputError, "Error writing to the output stream");
+			}
+			mBuffer.clear();
+		}
+	}
+
+	template <class TBuffer>
+	void CBsonBufferWriter<TBuffer>::WriteElementHeader(BsonType type, std::string_view key)
+	{
+		if (key.find('\0') != std::string_view::npos) {
+			throw SerializationException(SerializationErrorCode::OutOfRange, "The key of BSON element can't contain null character");
+		}
+		mBuffer.push_back(static_cast<typename TBuffer::value_type>(type));
+		mBuffer.insert(mBuffer.end(), key.cbegin(), key.cend());
+		mBuffer.push_back(0);
+	}
+
+	template <class TBuffer>
+	void CBsonBufferWriter<TBuffer>::WriteRawLittleEndian(uint64_t value, size_t size)
+	{
+		for (size_t i = 0; i < size; ++i, value >>= 8) {
+			mBuffer.push_back(static_cast<typename TBuffer::value_type>(value & 0xFF));
+		}
+	}
+
+	template <class TBuffer>
+	void CBsonBufferWriter<TBuffer>::PatchInt32(size_t pos, uint32_t value) noexcept
+	{
+		for (size_t i = 0; i < sizeof(value); ++i, value >>= 8) {
+			mBuffer[pos + i] = static_cast<typename TBuffer::value_type>(value & 0xFF);
+		}
+	}
+
+	template class CBsonBufferWriter<std::string>;
+	template class CBsonBufferWriter<std::vector<uint8_t>>;
+}
@@ -0,0 +1,73 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <ostream>
+#include "bitserializer/bson_archive.h"
+
+namespace BitSerializer::Bson::Detail
+{
+	/// <summary>
+	/// BSON writer to the buffer (<c>std::string</c> or <c>std::vector&lt;uint8_t&gt;</c>).
+	/// Documents are written in a single pass, the slot for size is reserved when document is opened and patched when it is closed.
+	/// </summary>
+	template <class TBuffer>
+	class CBsonBufferWriter : public IBsonWriter
+	{
+	public:
+		explicit CBsonBufferWriter(TBuffer& outputBuffer, std::ostream* outputStream = nullptr);
+
+		void WriteNull(std::string_view key) override;
+		void WriteBoolean(std::string_view key, bool value) override;
+		void WriteInt32(std::string_view key, int32_t value) override;
+		void WriteInt64(std::string_view key, int64_t value) override;
+		void WriteDouble(std::string_view key, double value) override;
+		void WriteString(std::string_view key, std::string_view value) override;
+		void WriteDateTime(std::string_view key, const CBinTimestamp& timestamp) override;
+		void WriteBinary(const void* data, size_t size) override;
+		void BeginRootDocument() override;
+		void BeginDocument(std::string_view key) override;
+		void BeginArray(std::string_view key) override;
+		void EndDocument() noexcept override;
+		void Flush() override;
+
+	protected:
+		struct DocumentInfo
+		{
+			// Position of the type code of element (not used for root documents)
+			size_t TypePosition;
+			// Position of the size of document
+			size_t SizePosition;
+			bool IsBinary;
+		};
+
+		void WriteElementHeader(BsonType type, std::string_view key);
+		void WriteRawLittleEndian(uint64_t value, size_t size);
+		void PatchInt32(size_t pos, uint32_t value) noexcept;
+
+		TBuffer& mBuffer;
+		std::ostream* mOutputStream;
+		std::vector<DocumentInfo> mOpenedDocuments;
+		bool mIsSizeOverflow = false;
+	};
+
+	/// <summary>
+	/// Holds the internal buffer of stream writer (must be constructed before the base writer).
+	/// </summary>
+	struct CBsonStreamBuffer
+	{
+		std::string mStreamBuffer;
+	};
+
+	/// <summary>
+	/// BSON writer to the stream (completed root documents are written when flushing).
+	/// </summary>
+	class CBsonStreamWriter final : private CBsonStreamBuffer, public CBsonBufferWriter<std::string>
+	{
+	public:
+		explicit CBsonStreamWriter(std::ostream& outputStream)
+			: CBsonBufferWriter<std::string>(mStreamBuffer, &outputStream)
+		{ }
+	};
+}
@@ -0,0 +1,44 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <istream>
+#include "cbor_readers.h"
+#include "cbor_writers.h"
+#include "bitserializer/serialization_detail/archive_helpers.h"
+
+
+namespace BitSerializer::Cbor::Detail
+{
+	CborWriteRootScope::CborWriteRootScope(std::string& outputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mCborWriter(std::make_unique<CCborBufferWriter<std::string>>(outputData))
+	{ }
+
+	CborWriteRootScope::CborWriteRootScope(std::vector<uint8_t>& outputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mCborWriter(std::make_unique<CCborBufferWriter<std::vector<uint8_t>>>(outputData))
+	{ }
+
+	CborWriteRootScope::CborWriteRootScope(std::ostream& outputStream, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mCborWriter(std::make_unique<CCborStreamWriter>(outputStream))
+	{ }
+
+	CborReadRootScope::CborReadRootScope(std::string_view inputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mCborReader(std::make_unique<CCborReader>(inputData, serializationContext.GetOptions()))
+	{ }
+
+	CborReadRootScope::CborReadRootScope(const std::vector<uint8_t>& inputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mCborReader(std::make_unique<CCborReader>(
+			std::string_view(reinterpret_cast<const char*>(inputData.data()), inputData.size()), serializationContext.GetOptions()))
+	{ }
+
+	CborReadRootScope::CborReadRootScope(std::istream& inputStream, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mStreamData(BitSerializer::Detail::ReadAllFromStream(inputStream))
+		, mCborReader(std::make_unique<CCborReader>(mStreamData, serializationContext.GetOptions()))
+	{ }
+}
@@ -0,0 +1,658 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "cbor_readers.h"
+#include "bitserializer/serialization_detail/archive_helpers.h"
+
+
+namespace
+{
+	using namespace BitSerializer;
+	using BitSerializer::Detail::CastNumber;
+
+	// Major types of CBOR data items
+	constexpr uint8_t MajorUnsigned = 0;
+	constexpr uint8_t MajorNegative = 1;
+	constexpr uint8_t MajorByteString = 2;
+	constexpr uint8_t MajorTextString = 3;
+	constexpr uint8_t MajorArray = 4;
+	constexpr uint8_t MajorMap = 5;
+	constexpr uint8_t MajorTag = 6;
+	constexpr uint8_t MajorSimple = 7;
+
+	constexpr uint8_t IndefiniteLength = 31;
+	constexpr uint8_t BreakCode = 0xFF;
+
+	// Tags of datetime (RFC 8949, section 3.4.1 and 3.4.2)
+	constexpr uint64_t TagDateTimeString = 0;
+	constexpr uint64_t TagEpochDateTime = 1;
+
+	struct CItemHead
+	{
+		uint8_t MajorType;
+		uint8_t AdditionalInfo;
+		// Value of integer, length of string/container, number of tag or bits of float
+		uint64_t Argument;
+		size_t HeadSize;
+		bool IsIndefinite;
+	};
+
+	template <typename T>
+	T ReadBigEndian(const char* in) noexcept
+	{
+		T value = 0;
+		for (size_t i = 0; i < sizeof(T); ++i)
+		{
+			value = static_cast<T>((static_cast<uint64_t>(value) << 8) | static_cast<uint8_t>(in[i]));
+		}
+		return value;
+	}
+
+	/// <summary>
+	/// Decodes the head of data item at specified position.
+	/// Returns `false` when the additional information is reserved or the head does not fit into the input data.
+	/// </summary>
+	bool DecodeHead(std::string_view data, size_t pos, CItemHead& head) noexcept
+	{
+		const auto initialByte = static_cast<uint8_t>(data[pos]);
+		head = { static_cast<uint8_t>(initialByte >> 5), static_cast<uint8_t>(initialByte & 0x1F), 0, 1, false };
+
+		if (head.AdditionalInfo < 24)
+		{
+			head.Argument = head.AdditionalInfo;
+			return true;
+		}
+		if (head.AdditionalInfo <= 27)
+		{
+			const size_t argumentSize = size_t(1) << (head.AdditionalInfo - 24);
+			if (data.size() - pos - 1 < argumentSize) {
+				return false;
+			}
+			const char* in = data.data() + pos + 1;
+			switch (argumentSize)
+			{
+			case 1:
+				head.Argument = ReadBigEndian<uint8_t>(in);
+				break;
+			case 2:
+				head.Argument = ReadBigEndian<uint16_t>(in);
+				break;
+			case 4:
+				head.Argument = ReadBigEndian<uint32_t>(in);
+				break;
+			default:
+				head.Argument = ReadBigEndian<uint64_t>(in);
+				break;
+			}
+			head.HeadSize += argumentSize;
+			return true;
+		}
+		if (head.AdditionalInfo == IndefiniteLength)
+		{
+			// Indefinite length is allowed only for strings and containers, the major type 7 is the "break" code
+			head.IsIndefinite = head.MajorType >= MajorByteString && head.MajorType <= MajorMap;
+			return head.IsIndefinite || head.MajorType == MajorSimple;
+		}
+		return false;
+	}
+
+	/// <summary>
+	/// Returns the number of nested data items (for maps it includes keys and values).
+	/// </summary>
+	uint64_t GetNestedItemsCount(const CItemHead& head) noexcept
+	{
+		switch (head.MajorType)
+		{
+		case MajorArray:
+			return head.Argument;
+		case MajorMap:
+			return head.Argument * 2;
+		case MajorTag:
+			return 1;
+		default:
+			return 0;
+		}
+	}
+
+	/// <summary>
+	/// Returns the size of data which follows the head (only strings have it).
+	/// </summary>
+	uint64_t GetPayloadSize(const CItemHead& head) noexcept
+	{
+		return head.MajorType == MajorByteString || head.MajorType == MajorTextString ? head.Argument : 0;
+	}
+
+	/// <summary>
+	/// Decodes 16-bit float (half precision), based on sample from RFC 8949 (appendix D).
+	/// </summary>
+	float DecodeHalf(uint16_t half) noexcept
+	{
+		const int exponent = (half >> 10) & 0x1F;
+		const int mantissa = half & 0x3FF;
+		double value;
+		if (exponent == 0) {
+			value = std::ldexp(mantissa, -24);
+		}
+		else if (exponent != 31) {
+			value = std::ldexp(mantissa + 1024, exponent - 25);
+		}
+		else {
+			value = mantissa == 0 ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+		}
+		return static_cast<float>(half & 0x8000 ? -value : value);
+	}
+
+	/// <summary>
+	/// Casts CBOR negative integer (encoded as -1 - argument) to the target type.
+	/// </summary>
+	template <typename TTarget>
+	bool CastNegativeNumber(uint64_t argument, TTarget& targetValue, OverflowNumberPolicy overflowNumberPolicy)
+	{
+		if (argument <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+			return CastNumber(static_cast<int64_t>(~argument), targetValue, overflowNumberPolicy);
+		}
+		if constexpr (std::is_floating_point_v<TTarget>) {
+			return CastNumber(-1.0 - static_cast<double>(argument), targetValue, overflowNumberPolicy);
+		}
+		else
+		{
+			// The number is less than the minimum of 64-bit integer
+			if (overflowNumberPolicy == OverflowNumberPolicy::ThrowError)
+			{
+				throw SerializationException(SerializationErrorCode::Overflow,
+					"The size of target field is not sufficient to deserialize number -1-" + Convert::ToString(argument));
+			}
+			return false;
+		}
+	}
+}
+
+namespace BitSerializer::Cbor::Detail
+{
+	CCborReader::CCborReader(std::string_view inputData, const SerializationOptions& serializationOptions)
+		: mInputData(inputData)
+		, mSerializationOptions(serializationOptions)
+	{
+		ValidateInput();
+	}
+
+	bool CCborReader::ReadValue(std::nullptr_t& value)
+	{
+		SkipTags();
+		// Null and undefined
+		if (const auto code = static_cast<uint8_t>(mInputData[mPos]); code == 0xF6 || code == 0xF7)
+		{
+			++mPos;
+			return true;
+		}
+		return HandleMismatchedType();
+	}
+
+	bool CCborReader::ReadValue(bool& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CCborReader::ReadValue(std::string_view& value)
+	{
+		if (ReadString(value)) {
+			return true;
+		}
+		// Null value is excluded from MismatchedTypesPolicy processing
+		if (const auto code = static_cast<uint8_t>(mInputData[mPos]); code == 0xF6 || code == 0xF7)
+		{
+			++mPos;
+			return false;
+		}
+		return HandleMismatchedType();
+	}
+
+	bool CCborReader::ReadValue(CBinTimestamp& timestamp)
+	{
+		CItemHead head{};
+		DecodeHead(mInputData, mPos, head);
+
+		// The datetime can be tagged (0 - standard datetime string, 1 - epoch-based datetime), untagged values are also allowed
+		std::optional<uint64_t> tag;
+		if (head.MajorType == MajorTag)
+		{
+			tag = head.Argument;
+			mPos += head.HeadSize;
+			SkipTags();
+			DecodeHead(mInputData, mPos, head);
+		}
+
+		if (head.MajorType == MajorTextString && (!tag || tag == TagDateTimeString))
+		{
+			std::string_view isoDate;
+			ReadString(isoDate);
+			try
+			{
+				const auto utc = Convert::Detail::ParseIsoDateTime(isoDate.data(), isoDate.data() + isoDate.size());
+				timestamp.Seconds = static_cast<int64_t>(Convert::Detail::UtcToUnixTime(utc));
+				timestamp.Nanoseconds = utc.ns;
+				return true;
+			}
+			catch (const std::invalid_argument&) {
+				return HandleInvalidTimestamp("The value being loaded is not a valid ISO datetime: " + std::string(isoDate));
+			}
+			catch (const std::out_of_range&) {
+				return HandleInvalidTimestamp("The value being loaded is out of range of ISO datetime: " + std::string(isoDate));
+			}
+		}
+
+		if (!tag || tag == TagEpochDateTime)
+		{
+			const auto overflowNumberPolicy = mSerializationOptions.overflowNumberPolicy;
+			if (head.MajorType == MajorUnsigned)
+			{
+				mPos += head.HeadSize;
+				timestamp.Nanoseconds = 0;
+				return CastNumber(head.Argument, timestamp.Seconds, overflowNumberPolicy);
+			}
+			if (head.MajorType == MajorNegative)
+			{
+				mPos += head.HeadSize;
+				timestamp.Nanoseconds = 0;
+				return CastNegativeNumber(head.Argument, timestamp.Seconds, overflowNumberPolicy);
+			}
+			if (head.MajorType == MajorSimple && head.AdditionalInfo >= 25 && head.AdditionalInfo <= 27)
+			{
+				double time;
+				if (!ReadNumber(time)) {
+					return false;
+				}
+				if (!std::isfinite(time)) {
+					return HandleInvalidTimestamp("The value being loaded is not a valid epoch-based datetime");
+				}
+
+				double seconds = std::floor(time);
+				auto nanoseconds = static_cast<int32_t>(std::lround((time - seconds) * 1e9));
+				if (nanoseconds >= 1000000000)
+				{
+					seconds += 1;
+					nanoseconds -= 1000000000;
+				}
+				// The range of double is wider than int64_t (the upper bound 2^63 is exactly representable)
+				if (seconds < -9223372036854775808.0 || seconds >= 9223372036854775808.0)
+				{
+					if (overflowNumberPolicy == OverflowNumberPolicy::ThrowError)
+					{
+						throw SerializationException(SerializationErrorCode::Overflow,
+							"The size of target field is not sufficient to deserialize timestamp " + Convert::ToString(time));
+					}
+					return false;
+				}
+				timestamp.Seconds = static_cast<int64_t>(seconds);
+				timestamp.Nanoseconds = nanoseconds;
+				return true;
+			}
+		}
+
+		// Null value is excluded from MismatchedTypesPolicy processing
+		if (const auto code = static_cast<uint8_t>(mInputData[mPos]); code == 0xF6 || code == 0xF7)
+		{
+			++mPos;
+			return false;
+		}
+		return HandleMismatchedType();
+	}
+
+	bool CCborReader::ReadKey(std::string_view& key)
+	{
+		if (ReadString(key)) {
+			return true;
+		}
+		// Keys with other types are not supported
+		SkipValue();
+		return false;
+	}
+
+	bool CCborReader::ReadArraySize(size_t& arraySize, bool& isIndefinite) noexcept
+	{
+		return ReadContainerSize(MajorArray, arraySize, isIndefinite);
+	}
+
+	bool CCborReader::ReadMapSize(size_t& mapSize, bool& isIndefinite) noexcept
+	{
+		if (ReadContainerSize(MajorMap, mapSize, isIndefinite))
+		{
+			if (isIndefinite) {
+				mapSize /= 2;
+			}
+			return true;
+		}
+		return false;
+	}
+
+	void CCborReader::SkipValue() noexcept
+	{
+		for (uint64_t pendingValues = 1; pendingValues != 0; --pendingValues)
+		{
+			CItemHead head{};
+			DecodeHead(mInputData, mPos, head);
+			if (head.IsIndefinite)
+			{
+				mPos = GetIndefiniteItemEnd(mPos);
+				continue;
+			}
+			mPos += head.HeadSize + static_cast<size_t>(GetPayloadSize(head));
+			pendingValues += GetNestedItemsCount(head);
+		}
+	}
+
+	void CCborReader::SkipBreak() noexcept
+	{
+		if (static_cast<uint8_t>(mInputData[mPos]) == BreakCode) {
+			++mPos;
+		}
+	}
+
+	template <typename T>
+	bool CCborReader::ReadNumber(T& value)
+	{
+		SkipTags();
+		CItemHead head{};
+		DecodeHead(mInputData, mPos, head);
+		const auto overflowNumberPolicy = mSerializationOptions.overflowNumberPolicy;
+
+		switch (head.MajorType)
+		{
+		case MajorUnsigned:
+			mPos += head.HeadSize;
+			return CastNumber(head.Argument, value, overflowNumberPolicy);
+		case MajorNegative:
+			mPos += head.HeadSize;
+			return CastNegativeNumber(head.Argument, value, overflowNumberPolicy);
+		case MajorSimple:
+			switch (head.AdditionalInfo)
+			{
+			case 20:
+			case 21:
+				if constexpr (std::is_integral_v<T>)
+				{
+					++mPos;
+					return CastNumber(head.AdditionalInfo == 21, value, overflowNumberPolicy);
+				}
+				break;
+			case 22:
+			case 23:
+				// Null and undefined values are excluded from MismatchedTypesPolicy processing
+				++mPos;
+				return false;
+			case 25:
+				mPos += head.HeadSize;
+				return CastNumber(DecodeHalf(static_cast<uint16_t>(head.Argument)), value, overflowNumberPolicy);
+			case 26:
+			{
+				mPos += head.HeadSize;
+				const auto bits = static_cast<uint32_t>(head.Argument);
+				float floatValue;
+				std::memcpy(&floatValue, &bits, sizeof(floatValue));
+				return CastNumber(floatValue, value, overflowNumberPolicy);
+			}
+			case 27:
+			{
+				mPos += head.HeadSize;
+				double doubleValue;
+				std::memcpy(&doubleValue, &head.Argument, sizeof(doubleValue));
+				return CastNumber(doubleValue, value, overflowNumberPolicy);
+			}
+			default:
+				break;
+			}
+			break;
+		default:
+			break;
+		}
+		return HandleMismatchedType();
+	}
+
+	bool CCborReader::ReadValue(uint8_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CCborReader::ReadValue(uint16_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CCborReader::ReadValue(uint32_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CCborReader::ReadValue(uint64_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CCborReader::ReadValue(int8_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CCborReader::ReadValue(int16_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CCborReader::ReadValue(int32_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CCborReader::ReadValue(int64_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CCborReader::ReadValue(float& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CCborReader::ReadValue(double& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CCborReader::ReadString(std::string_view& value)
+	{
+		SkipTags();
+		CItemHead head{};
+		DecodeHead(mInputData, mPos, head);
+		if (head.MajorType != MajorTextString && head.MajorType != MajorByteString) {
+			return false;
+		}
+
+		if (!head.IsIndefinite)
+		{
+			// Zero-copy reading, the view points to the input data
+			value = mInputData.substr(mPos + head.HeadSize, static_cast<size_t>(head.Argument));
+			mPos += head.HeadSize + static_cast<size_t>(head.Argument);
+			return true;
+		}
+
+		// Indefinite-length string consists of chunks (definite-length strings), which need to be concatenated
+		mStringBuffer.clear();
+		for (mPos += head.HeadSize; static_cast<uint8_t>(mInputData[mPos]) != BreakCode; mPos += head.HeadSize + static_cast<size_t>(head.Argument))
+		{
+			DecodeHead(mInputData, mPos, head);
+			mStringBuffer.append(mInputData.data() + mPos + head.HeadSize, static_cast<size_t>(head.Argument));
+		}
+		++mPos;
+		value = mStringBuffer;
+		return true;
+	}
+
+	bool CCborReader::ReadContainerSize(uint8_t majorType, size_t& size, bool& isIndefinite) noexcept
+	{
+		SkipTags();
+		CItemHead head{};
+		DecodeHead(mInputData, mPos, head);
+		if (head.MajorType != majorType)
+		{
+			SkipValue();
+			return false;
+		}
+
+		isIndefinite = head.IsIndefinite;
+		if (!isIndefinite)
+		{
+			mPos += head.HeadSize;
+			size = static_cast<size_t>(head.Argument);
+			return true;
+		}
+
+		// Count the number of items in the indefinite-length container
+		const size_t endPos = GetIndefiniteItemEnd(mPos) - 1;
+		mPos += head.HeadSize;
+		const size_t startPos = mPos;
+		for (size = 0; mPos != endPos; ++size) {
+			SkipValue();
+		}
+		mPos = startPos;
+		return true;
+	}
+
+	void CCborReader::SkipTags() noexcept
+	{
+		CItemHead head{};
+		while (DecodeHead(mInputData, mPos, head) && head.MajorType == MajorTag) {
+			mPos += head.HeadSize;
+		}
+	}
+
+	size_t CCborReader::GetIndefiniteItemEnd(size_t pos) const noexcept
+	{
+		const auto it = std::lower_bound(mIndefiniteItems.cbegin(), mIndefiniteItems.cend(), pos,
+			[](const std::pair<size_t, size_t>& item, size_t startPos) { return item.first < startPos; });
+		return it->second;
+	}
+
+	void CCborReader::ValidateInput()
+	{
+		if (mInputData.empty()) {
+			throw ParsingException("Input data is empty");
+		}
+
+		struct CLevel
+		{
+			uint64_t PendingItems;
+			// Index in the list of indefinite items (or `npos` for definite-length containers)
+			size_t IndefiniteIndex;
+			// Major type of indefinite-length item (strings must consist of chunks with the same type)
+			uint8_t MajorType;
+			size_t ItemsCount;
+		};
+		constexpr auto npos = std::string_view::npos;
+
+		std::vector<CLevel> levels;
+		levels.push_back({ 1, npos, 0, 0 });
+		size_t pos = 0;
+		while (!levels.empty())
+		{
+			CLevel& level = levels.back();
+			const bool isIndefiniteLevel = level.IndefiniteIndex != npos;
+			if (!isIndefiniteLevel)
+			{
+				if (level.PendingItems == 0)
+				{
+					levels.pop_back();
+					continue;
+				}
+				--level.PendingItems;
+			}
+
+			CItemHead head{};
+			if (pos >= mInputData.size()) {
+				throw ParsingException("Unexpected end of CBOR data", 0, pos);
+			}
+			if (!DecodeHead(mInputData, pos, head)) {
+				throw ParsingException("Invalid or truncated CBOR data", 0, pos);
+			}
+
+			if (head.MajorType == MajorSimple && head.AdditionalInfo == IndefiniteLength)
+			{
+				// The "break" code is allowed only at the end of indefinite-length items (map must have even number of items)
+				if (!isIndefiniteLevel || (level.MajorType == MajorMap && level.ItemsCount % 2 != 0)) {
+					throw ParsingException("Unexpected \"break\" code in CBOR data", 0, pos);
+				}
+				mIndefiniteItems[level.IndefiniteIndex].second = ++pos;
+				levels.pop_back();
+				continue;
+			}
+
+			if (isIndefiniteLevel)
+			{
+				++level.ItemsCount;
+				if ((level.MajorType == MajorByteString || level.MajorType == MajorTextString)
+					&& (head.MajorType != level.MajorType || head.IsIndefinite))
+				{
+					throw ParsingException("Invalid chunk of indefinite-length string in CBOR data", 0, pos);
+				}
+			}
+
+			if (head.IsIndefinite)
+			{
+				mIndefiniteItems.emplace_back(pos, 0);
+				levels.push_back({ 0, mIndefiniteItems.size() - 1, head.MajorType, 0 });
+				pos += head.HeadSize;
+				continue;
+			}
+
+			const size_t itemPos = pos;
+			pos += head.HeadSize;
+			const size_t availableSize = mInputData.size() - pos;
+			if (const uint64_t payloadSize = GetPayloadSize(head); payloadSize != 0)
+			{
+				if (payloadSize > availableSize) {
+					throw ParsingException("Unexpected end of CBOR data", 0, itemPos);
+				}
+				pos += static_cast<size_t>(payloadSize);
+			}
+			else if (head.MajorType == MajorArray || head.MajorType == MajorMap || head.MajorType == MajorTag)
+			{
+				// Each nested value takes at least one byte (checks the length before multiplying the number of map items)
+				if (head.MajorType != MajorTag && head.Argument > availableSize) {
+					throw ParsingException("Unexpected end of CBOR data", 0, itemPos);
+				}
+				if (const uint64_t nestedItems = GetNestedItemsCount(head); nestedItems != 0)
+				{
+					if (nestedItems > availableSize) {
+						throw ParsingException("Unexpected end of CBOR data", 0, itemPos);
+					}
+					levels.push_back({ nestedItems, npos, 0, 0 });
+				}
+			}
+		}
+		if (pos != mInputData.size()) {
+			throw ParsingException("Unexpected data after the root value", 0, pos);
+		}
+	}
+
+	bool CCborReader::HandleMismatchedType()
+	{
+		SkipValue();
+		if (mSerializationOptions.mismatchedTypesPolicy == MismatchedTypesPolicy::ThrowError)
+		{
+			throw SerializationException(SerializationErrorCode::MismatchedTypes,
+				"The type of target field does not match the value being loaded");
+		}
+		return false;
+	}
+
+	bool CCborReader::HandleInvalidTimestamp(std::string_view reason)
+	{
+		if (mSerializationOptions.mismatchedTypesPolicy == MismatchedTypesPolicy::ThrowError) {
+			throw SerializationException(SerializationErrorCode::MismatchedTypes, std::string(reason));
+		}
+		return false;
+	}
+}
@@ -0,0 +1,61 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include "bitserializer/cbor_archive.h"
+
+namespace BitSerializer::Cbor::Detail
+{
+	/// <summary>
+	/// CBOR reader from the continuous block of memory.
+	/// The structure of root value is validated in the constructor, so all further reads can't go out of the input data.
+	/// Definite-length strings are returned as views to the input data (without copying).
+	/// </summary>
+	class CCborReader final : public ICborReader
+	{
+	public:
+		CCborReader(std::string_view inputData, const SerializationOptions& serializationOptions);
+
+		[[nodiscard]] size_t GetPosition() const noexcept override { return mPos; }
+		void SetPosition(size_t pos) noexcept override { mPos = pos; }
+		bool ReadValue(std::nullptr_t& value) override;
+		bool ReadValue(bool& value) override;
+		bool ReadValue(uint8_t& value) override;
+		bool ReadValue(uint16_t& value) override;
+		bool ReadValue(uint32_t& value) override;
+		bool ReadValue(uint64_t& value) override;
+		bool ReadValue(int8_t& value) override;
+		bool ReadValue(int16_t& value) override;
+		bool ReadValue(int32_t& value) override;
+		bool ReadValue(int64_t& value) override;
+		bool ReadValue(float& value) override;
+		bool ReadValue(double& value) override;
+		bool ReadValue(std::string_view& value) override;
+		bool ReadValue(CBinTimestamp& timestamp) override;
+		bool ReadKey(std::string_view& key) override;
+		bool ReadArraySize(size_t& arraySize, bool& isIndefinite) noexcept override;
+		bool ReadMapSize(size_t& mapSize, bool& isIndefinite) noexcept override;
+		void SkipValue() noexcept override;
+		void SkipBreak() noexcept override;
+
+	private:
+		template <typename T>
+		bool ReadNumber(T& value);
+		bool ReadString(std::string_view& value);
+		bool ReadContainerSize(uint8_t majorType, size_t& size, bool& isIndefinite) noexcept;
+		void SkipTags() noexcept;
+		[[nodiscard]] size_t GetIndefiniteItemEnd(size_t pos) const noexcept;
+		void ValidateInput();
+		bool HandleMismatchedType();
+		bool HandleInvalidTimestamp(std::string_view reason);
+
+		std::string_view mInputData;
+		const SerializationOptions& mSerializationOptions;
+		size_t mPos = 0;
+		// Start and end positions of all indefinite-length items (sorted by start position, filled when validating)
+		std::vector<std::pair<size_t, size_t>> mIndefiniteItems;
+		// Buffer for concatenation chunks of indefinite-length strings
+		std::string mStringBuffer;
+	};
+}
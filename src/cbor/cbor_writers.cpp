@@ -0,0 +1,297 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include "cbor_writers.h"
+
+
+namespace
+{
+	using namespace BitSerializer;
+
+	// Maximum size of head of data item (major type and 64-bit argument)
+	constexpr size_t MaxHeadSize = 9;
+
+	// Major types of CBOR data items
+	constexpr uint8_t MajorUnsigned = 0;
+	constexpr uint8_t MajorNegative = 1;
+	constexpr uint8_t MajorTextString = 3;
+	constexpr uint8_t MajorArray = 4;
+	constexpr uint8_t MajorMap = 5;
+	constexpr uint8_t MajorTag = 6;
+
+	// Tags of datetime (RFC 8949, section 3.4.1 and 3.4.2)
+	constexpr uint64_t TagDateTimeString = 0;
+	constexpr uint64_t TagEpochDateTime = 1;
+
+	template <typename T>
+	uint8_t* WriteBigEndian(uint8_t* out, T value) noexcept
+	{
+		for (size_t i = sizeof(T); i != 0; --i)
+		{
+			out[i - 1] = static_cast<uint8_t>(value & 0xFF);
+			if constexpr (sizeof(T) > 1) {
+				value >>= 8;
+			}
+		}
+		return out + sizeof(T);
+	}
+
+	/// <summary>
+	/// Encodes the head of data item (major type and argument) in the shortest form, returns the size of head.
+	/// </summary>
+	size_t EncodeHead(uint8_t* out, uint8_t majorType, uint64_t value) noexcept
+	{
+		const auto major = static_cast<uint8_t>(majorType << 5);
+		if (value < 24)
+		{
+			out[0] = static_cast<uint8_t>(major | value);
+			return 1;
+		}
+		if (value <= std::numeric_limits<uint8_t>::max())
+		{
+			out[0] = major | 24;
+			WriteBigEndian(out + 1, static_cast<uint8_t>(value));
+			return 2;
+		}
+		if (value <= std::numeric_limits<uint16_t>::max())
+		{
+			out[0] = major | 25;
+			WriteBigEndian(out + 1, static_cast<uint16_t>(value));
+			return 3;
+		}
+		if (value <= std::numeric_limits<uint32_t>::max())
+		{
+			out[0] = major | 26;
+			WriteBigEndian(out + 1, static_cast<uint32_t>(value));
+			return 5;
+		}
+		out[0] = major | 27;
+		WriteBigEndian(out + 1, value);
+		return 9;
+	}
+
+	/// <summary>
+	/// Converts 32-bit float to the 16-bit (half precision), returns `false` when it can't be done without loss of precision.
+	/// All NaNs are converted to the canonical quiet NaN.
+	/// </summary>
+	bool TryConvertToHalf(float value, uint16_t& half) noexcept
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+		const auto exponent = static_cast<int>((bits >> 23) & 0xFF);
+		const uint32_t mantissa = bits & 0x7FFFFF;
+
+		if (exponent == 0xFF)
+		{
+			half = mantissa == 0 ? static_cast<uint16_t>(sign | 0x7C00) : uint16_t(0x7E00);
+			return true;
+		}
+		if (exponent == 0)
+		{
+			// Subnormal floats are too small for half precision (except zero)
+			half = sign;
+			return mantissa == 0;
+		}
+
+		const int unbiasedExponent = exponent - 127;
+		if (unbiasedExponent >= -14 && unbiasedExponent <= 15)
+		{
+			// Normal number, low 13 bits of mantissa would be lost
+			half = static_cast<uint16_t>(sign | ((unbiasedExponent + 15) << 10) | (mantissa >> 13));
+			return (mantissa & 0x1FFF) == 0;
+		}
+		if (unbiasedExponent >= -24 && unbiasedExponent < -14)
+		{
+			// Subnormal half precision number
+			const uint32_t fullMantissa = mantissa | 0x800000;
+			const int shift = -1 - unbiasedExponent;
+			half = static_cast<uint16_t>(sign | (fullMantissa >> shift));
+			return (fullMantissa & ((uint32_t(1) << shift) - 1)) == 0;
+		}
+		return false;
+	}
+}
+
+namespace BitSerializer::Cbor::Detail
+{
+	template <class TBuffer>
+	CCborBufferWriter<TBuffer>::CCborBufferWriter(TBuffer& outputBuffer, std::ostream* outputStream)
+		: mBuffer(outputBuffer)
+		, mContainerWriter(outputBuffer, outputStream)
+	{ }
+
+	template <class TBuffer>
+	void CCborBufferWriter<TBuffer>::WriteNull()
+	{
+		WriteByte(0xF6);
+	}
+
+	template <class TBuffer>
+	void CCborBufferWriter<TBuffer>::WriteBoolean(bool value)
+	{
+		WriteByte(value ? 0xF5 : 0xF4);
+	}
+
+	template <class TBuffer>
+	void CCborBufferWriter<TBuffer>::WriteSignedInteger(int64_t value)
+	{
+		if (value >= 0) {
+			WriteHead(MajorUnsigned, static_cast<uint64_t>(value));
+		}
+		else {
+			// Negative integer is encoded as (-1 - value)
+			WriteHead(MajorNegative, ~static_cast<uint64_t>(value));
+		}
+	}
+
+	template <class TBuffer>
+	void CCborBufferWriter<TBuffer>::WriteUnsignedInteger(uint64_t value)
+	{
+		WriteHead(MajorUnsigned, value);
+	}
+
+	template <class TBuffer>
+	void CCborBufferWriter<TBuffer>::WriteFloat(float value)
+	{
+		// Use 16-bit float when it can be done without lost precision
+		if (uint16_t half; TryConvertToHalf(value, half))
+		{
+			uint8_t data[3] = { 0xF9 };
+			WriteBigEndian(data + 1, half);
+			WriteBytes(data, sizeof(data));
+			return;
+		}
+
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		uint8_t data[5] = { 0xFA };
+		WriteBigEndian(data + 1, bits);
+		WriteBytes(data, sizeof(data));
+	}
+
+	template <class TBuffer>
+	void CCborBufferWriter<TBuffer>::WriteDouble(double value)
+	{
+		// Use 32-bit (or smaller) float when it can be done without lost precision
+		if (std::isnan(value) || std::isinf(value) || std::fabs(value) <= std::numeric_limits<float>::max())
+		{
+			if (const auto floatValue = static_cast<float>(value); std::isnan(value) || static_cast<double>(floatValue) == value)
+			{
+				WriteFloat(floatValue);
+				return;
+			}
+		}
+
+		uint64_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		uint8_t data[9] = { 0xFB };
+		WriteBigEndian(data + 1, bits);
+		WriteBytes(data, sizeof(data));
+	}
+
+	template <class TBuffer>
+	void CCborBufferWriter<TBuffer>::WriteString(std::string_view value)
+	{
+		WriteHead(MajorTextString, value.size());
+		WriteBytes(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+	}
+
+	template <class TBuffer>
+	void CCborBufferWriter<TBuffer>::WriteTimestamp(const CBinTimestamp& timestamp)
+	{
+		if (timestamp.Nanoseconds == 0)
+		{
+			// Epoch-based datetime as integer number of seconds
+			WriteHead(MajorTag, TagEpochDateTime);
+			WriteSignedInteger(timestamp.Seconds);
+			return;
+		}
+
+		// Fractions of second can't be represented as float without loss of precision, use standard datetime string
+		char buffer[Convert::Detail::UtcBufSize];
+		const tm utc = Convert::Detail::UnixTimeToUtc(static_cast<time_t>(timestamp.Seconds));
+		const char* endPos = Convert::Detail::WriteIsoDateTime(buffer, utc, timestamp.Nanoseconds, true);
+		WriteHead(MajorTag, TagDateTimeString);
+		WriteString(std::string_view(buffer, static_cast<size_t>(endPos - buffer)));
+	}
+
+	template <class TBuffer>
+	void CCborBufferWriter<TBuffer>::BeginArray(size_t arraySize)
+	{
+		uint8_t data[MaxHeadSize];
+		const size_t headerSize = EncodeHead(data, MajorArray, arraySize);
+		mArraySizes.push_back(arraySize);
+		mContainerWriter.BeginContainer(data, headerSize);
+	}
+
+	template <class TBuffer>
+	void CCborBufferWriter<TBuffer>::EndArray(size_t actualSize) noexcept
+	{
+		const size_t declaredSize = mArraySizes.back();
+		mArraySizes.pop_back();
+		if (actualSize == declaredSize)
+		{
+			mContainerWriter.EndContainer();
+			return;
+		}
+
+		// The header can be replaced only when it is not yet written to the stream and has enough size
+		uint8_t data[MaxHeadSize];
+		if (!mContainerWriter.EndContainer(data, EncodeHead(data, MajorArray, actualSize))) {
+			// Error will be thrown when finalizing
+			mHasLostHeader = true;
+		}
+	}
+
+	template <class TBuffer>
+	void CCborBufferWriter<TBuffer>::BeginMap()
+	{
+		// The size of map is not known in advance, reserve the space for the largest header
+		mContainerWriter.BeginContainer(MaxHeadSize);
+	}
+
+	template <class TBuffer>
+	void CCborBufferWriter<TBuffer>::EndMap(size_t actualSize) noexcept
+	{
+		uint8_t data[MaxHeadSize];
+		mContainerWriter.EndContainer(data, EncodeHead(data, MajorMap, actualSize));
+	}
+
+	template <class TBuffer>
+	void CCborBufferWriter<TBuffer>::Flush()
+	{
+		if (mHasLostHeader)
+		{
+			throw SerializationException(SerializationErrorCode::OutOfRange,
+				"The number of saved array items does not match to the declared size");
+		}
+		mContainerWriter.Flush();
+	}
+
+	template <class TBuffer>
+	void CCborBufferWriter<TBuffer>::WriteHead(uint8_t majorType, uint64_t value)
+	{
+		uint8_t data[9];
+		WriteBytes(data, EncodeHead(data, majorType, value));
+	}
+
+	template <class TBuffer>
+	void CCborBufferWriter<TBuffer>::WriteByte(uint8_t value)
+	{
+		mBuffer.push_back(static_cast<typename TBuffer::value_type>(value));
+	}
+
+	template <class TBuffer>
+	void CCborBufferWriter<TBuffer>::WriteBytes(const uint8_t* data, size_t size)
+	{
+		mBuffer.insert(mBuffer.end(), data, data + size);
+	}
+
+	template class CCborBufferWriter<std::string>;
+	template class CCborBufferWriter<std::vector<uint8_t>>;
+}
@@ -0,0 +1,69 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <ostream>
+#include "bitserializer/cbor_archive.h"
+#include "bitserializer/serialization_detail/bin_container_writer.h"
+
+namespace BitSerializer::Cbor::Detail
+{
+	/// <summary>
+	/// CBOR writer to the buffer (<c>std::string</c> or <c>std::vector&lt;uint8_t&gt;</c>).
+	/// Values are written in the preferred serialization (RFC 8949, section 4.1): the shortest form of integers and lengths,
+	/// floating point numbers are narrowed to 16 or 32 bits when it can be done without loss of precision.
+	/// All containers have definite length, headers of maps are written when the scope is closed.
+	/// </summary>
+	template <class TBuffer>
+	class CCborBufferWriter : public ICborWriter
+	{
+	public:
+		explicit CCborBufferWriter(TBuffer& outputBuffer, std::ostream* outputStream = nullptr);
+
+		void WriteNull() override;
+		void WriteBoolean(bool value) override;
+		void WriteSignedInteger(int64_t value) override;
+		void WriteUnsignedInteger(uint64_t value) override;
+		void WriteFloat(float value) override;
+		void WriteDouble(double value) override;
+		void WriteString(std::string_view value) override;
+		void WriteTimestamp(const CBinTimestamp& timestamp) override;
+		void BeginArray(size_t arraySize) override;
+		void EndArray(size_t actualSize) noexcept override;
+		void BeginMap() override;
+		void EndMap(size_t actualSize) noexcept override;
+		void Flush() override;
+
+	protected:
+		void WriteHead(uint8_t majorType, uint64_t value);
+		void WriteByte(uint8_t value);
+		void WriteBytes(const uint8_t* data, size_t size);
+
+		TBuffer& mBuffer;
+		BitSerializer::Detail::CBinContainerWriter<TBuffer> mContainerWriter;
+		// Declared sizes of opened arrays
+		std::vector<size_t> mArraySizes;
+		bool mHasLostHeader = false;
+	};
+
+	/// <summary>
+	/// Holds the internal buffer of stream writer (must be constructed before the base writer).
+	/// </summary>
+	struct CCborStreamBuffer
+	{
+		std::string mStreamBuffer;
+	};
+
+	/// <summary>
+	/// CBOR writer to the stream.
+	/// The data is written in chunks, except the parts which can be changed (headers of not yet closed maps).
+	/// </summary>
+	class CCborStreamWriter final : private CCborStreamBuffer, public CCborBufferWriter<std::string>
+	{
+	public:
+		explicit CCborStreamWriter(std::ostream& outputStream)
+			: CCborBufferWriter<std::string>(mStreamBuffer, &outputStream)
+		{ }
+	};
+}
@@ -0,0 +1,44 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <istream>
+#include "columnar_readers.h"
+#include "columnar_writers.h"
+#include "bitserializer/serialization_detail/archive_helpers.h"
+
+
+namespace BitSerializer::Columnar::Detail
+{
+	ColumnarWriteRootScope::ColumnarWriteRootScope(std::string& outputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mColumnarWriter(std::make_unique<CColumnarBufferWriter<std::string>>(outputData))
+	{ }
+
+	ColumnarWriteRootScope::ColumnarWriteRootScope(std::vector<uint8_t>& outputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mColumnarWriter(std::make_unique<CColumnarBufferWriter<std::vector<uint8_t>>>(outputData))
+	{ }
+
+	ColumnarWriteRootScope::ColumnarWriteRootScope(std::ostream& outputStream, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mColumnarWriter(std::make_unique<CColumnarStreamWriter>(outputStream))
+	{ }
+
+	ColumnarReadRootScope::ColumnarReadRootScope(std::string_view inputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mColumnarReader(std::make_unique<CColumnarReader>(inputData, serializationContext.GetOptions()))
+	{ }
+
+	ColumnarReadRootScope::ColumnarReadRootScope(const std::vector<uint8_t>& inputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mColumnarReader(std::make_unique<CColumnarReader>(
+			std::string_view(reinterpret_cast<const char*>(inputData.data()), inputData.size()), serializationContext.GetOptions()))
+	{ }
+
+	ColumnarReadRootScope::ColumnarReadRootScope(std::istream& inputStream, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mStreamData(BitSerializer::Detail::ReadAllFromStream(inputStream))
+		, mColumnarReader(std::make_unique<CColumnarReader>(mStreamData, serializationContext.GetOptions()))
+	{ }
+}
@@ -0,0 +1,74 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "bitserializer/columnar_archive.h"
+#include "bitserializer/serialization_detail/archive_helpers.h"
+
+/// <summary>
+/// Layout of the columnar archive (all numbers are stored in the little-endian byte order):
+///  - Header: signature "BSCL", version (one byte), number of rows (varint), number of columns (varint).
+///    Each row takes at least one bit in every column (packed values are at least one bit width, columns of nulls have
+///    the bitmap), so the number of rows is limited by the size of data.
+///  - Columns, each of them: key (varint length and characters), type (one byte), encoding (one byte), flags (one byte),
+///    size of data (varint) and data:
+///    - Bitmap of null values (when the flag `HasNulls` is set): one bit per row, values of null rows are stored as zeros.
+///    - Boolean: one bit per row.
+///    - Integers: width in bits (one byte) and bit-packed values (signed values are ZigZag encoded). With delta encoding,
+///      the values are ZigZag encoded differences with previous values.
+///    - Float / Double: 4 / 8 bytes per row.
+///    - String: width in bits (one byte), bit-packed lengths and characters of all strings.
+///      With dictionary encoding: number of unique strings (varint), unique strings (as described above),
+///      width in bits (one byte) and bit-packed indexes of strings.
+/// </summary>
+namespace BitSerializer::Columnar::Detail
+{
+	constexpr char Signature[4] = { 'B', 'S', 'C', 'L' };
+	constexpr uint8_t FormatVersion = 1;
+
+	/// <summary>
+	/// Types of columns (the type is determined by the first non-null value).
+	/// </summary>
+	enum class ColumnType : uint8_t
+	{
+		Null = 0,
+		Boolean,
+		SignedInteger,
+		UnsignedInteger,
+		Float,
+		Double,
+		String
+	};
+
+	enum class ColumnEncoding : uint8_t
+	{
+		Plain = 0,
+		Delta,
+		Dictionary
+	};
+
+	constexpr uint8_t HasNullsFlag = 0x01;
+
+	using BitSerializer::Detail::ZigZagEncode;
+	using BitSerializer::Detail::ZigZagDecode;
+
+	/// <summary>
+	/// Returns the number of bits which are required to store the value.
+	/// </summary>
+	constexpr uint8_t GetBitWidth(uint64_t value) noexcept
+	{
+		uint8_t width = 0;
+		for (; value != 0; value >>= 1) {
+			++width;
+		}
+		return width;
+	}
+
+	constexpr size_t GetPackedSize(size_t count, uint8_t bitWidth) noexcept
+	{
+		return (count * bitWidth + 7) / 8;
+	}
+}
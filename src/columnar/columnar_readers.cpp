@@ -0,0 +1,438 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include "columnar_readers.h"
+#include "bitserializer/serialization_detail/archive_helpers.h"
+
+
+namespace
+{
+	using namespace BitSerializer;
+	using namespace BitSerializer::Columnar::Detail;
+	using BitSerializer::Detail::CastNumber;
+	using BitSerializer::Detail::ReadLittleEndian;
+
+	/// <summary>
+	/// Reader of the input data with checking of bounds (throws `ParsingException` with the offset of wrong data).
+	/// </summary>
+	class CInputCursor
+	{
+	public:
+		CInputCursor(std::string_view data, size_t pos, size_t endPos) noexcept
+			: mData(data)
+			, mPos(pos)
+			, mEndPos(endPos)
+		{ }
+
+		[[nodiscard]] size_t GetPosition() const noexcept { return mPos; }
+		[[nodiscard]] size_t GetRemaining() const noexcept { return mEndPos - mPos; }
+
+		uint8_t ReadByte()
+		{
+			if (mPos == mEndPos) {
+				ThrowError("Unexpected end of data");
+			}
+			return static_cast<uint8_t>(mData[mPos++]);
+		}
+
+		uint64_t ReadVarInt()
+		{
+			uint64_t value = 0;
+			for (size_t shift = 0; shift < 64; shift += 7)
+			{
+				const uint8_t byte = ReadByte();
+				value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0) {
+					return value;
+				}
+			}
+			ThrowError("Invalid variable-length number");
+		}
+
+		std::string_view ReadBytes(uint64_t size)
+		{
+			if (size > GetRemaining()) {
+				ThrowError("Unexpected end of data");
+			}
+			const std::string_view bytes = mData.substr(mPos, static_cast<size_t>(size));
+			mPos += static_cast<size_t>(size);
+			return bytes;
+		}
+
+		/// <summary>
+		/// Reads the block of packed values (checks that the number of values fits into the remaining data).
+		/// </summary>
+		std::string_view ReadPacked(size_t count, uint8_t bitWidth)
+		{
+			// Zero width is allowed only for empty block, otherwise the number of values would not be limited by the data
+			if (bitWidth > 64 || (bitWidth == 0 && count != 0)) {
+				ThrowError("Invalid width of packed values");
+			}
+			if (count != 0 && count > GetRemaining() * 8 / bitWidth) {
+				ThrowError("Unexpected end of data");
+			}
+			return ReadBytes(GetPackedSize(count, bitWidth));
+		}
+
+		[[noreturn]] void ThrowError(const std::string& message) const
+		{
+			throw ParsingException(message, 0, mPos);
+		}
+
+	private:
+		std::string_view mData;
+		size_t mPos;
+		size_t mEndPos;
+	};
+
+	/// <summary>
+	/// Unpacks values with passed width in bits (the lowest bits go first).
+	/// </summary>
+	void UnpackBits(std::string_view packedData, size_t count, uint8_t bitWidth, std::vector<uint64_t>& values)
+	{
+		values.resize(count);
+		const uint64_t mask = bitWidth == 64 ? ~uint64_t(0) : (uint64_t(1) << bitWidth) - 1;
+		for (size_t i = 0; i < count; ++i)
+		{
+			const size_t bitPos = i * bitWidth;
+			const size_t bytePos = bitPos / 8;
+			const size_t shift = bitPos % 8;
+			uint64_t value = ReadLittleEndian(packedData.data() + bytePos, std::min<size_t>(packedData.size() - bytePos, 8)) >> shift;
+			if (shift + bitWidth > 64) {
+				value |= static_cast<uint64_t>(static_cast<uint8_t>(packedData[bytePos + 8])) << (64 - shift);
+			}
+			values[i] = value & mask;
+		}
+	}
+
+	/// <summary>
+	/// Reads width in bits and packed values.
+	/// </summary>
+	void ReadPackedValues(CInputCursor& cursor, size_t count, std::vector<uint64_t>& values)
+	{
+		const uint8_t bitWidth = cursor.ReadByte();
+		const std::string_view packedData = cursor.ReadPacked(count, bitWidth);
+		if (count != 0) {
+			UnpackBits(packedData, count, bitWidth, values);
+		}
+	}
+
+	/// <summary>
+	/// Reads plain strings.
+	/// </summary>
+	void ReadPlainStrings(CInputCursor& cursor, size_t count, std::vector<std::string_view>& strings)
+	{
+		std::vector<uint64_t> lengths;
+		ReadPackedValues(cursor, count, lengths);
+		strings.reserve(count);
+		for (const uint64_t length : lengths) {
+			strings.push_back(cursor.ReadBytes(length));
+		}
+	}
+}
+
+namespace BitSerializer::Columnar::Detail
+{
+	CColumnarReader::CColumnarReader(std::string_view inputData, const SerializationOptions& serializationOptions)
+		: mInputData(inputData)
+		, mSerializationOptions(serializationOptions)
+	{
+		CInputCursor cursor(mInputData, 0, mInputData.size());
+		const std::string_view signature = cursor.ReadBytes(sizeof(Signature));
+		if (!std::equal(std::cbegin(Signature), std::cend(Signature), signature.cbegin())) {
+			throw ParsingException("Input data is not a columnar archive (invalid signature)");
+		}
+		if (cursor.ReadByte() > FormatVersion) {
+			throw ParsingException("Unsupported version of columnar archive");
+		}
+
+		// The number of rows is not trusted until it is confirmed by the data of each column (at least one bit per row)
+		const uint64_t rowsCount = cursor.ReadVarInt();
+		const uint64_t columnsCount = cursor.ReadVarInt();
+		// Each column takes at least 5 bytes
+		if (columnsCount > cursor.GetRemaining() / 5) {
+			cursor.ThrowError("Invalid number of columns");
+		}
+		if (rowsCount > std::numeric_limits<size_t>::max() || (columnsCount == 0 && rowsCount != 0)) {
+			cursor.ThrowError("Invalid number of rows");
+		}
+		mRowsCount = static_cast<size_t>(rowsCount);
+		mColumns.resize(static_cast<size_t>(columnsCount));
+
+		for (CColumn& column : mColumns)
+		{
+			column.Key = cursor.ReadBytes(cursor.ReadVarInt());
+			const uint8_t type = cursor.ReadByte();
+			const uint8_t encoding = cursor.ReadByte();
+			const uint8_t flags = cursor.ReadByte();
+			const uint64_t dataSize = cursor.ReadVarInt();
+			if (dataSize > cursor.GetRemaining()) {
+				cursor.ThrowError("Unexpected end of data");
+			}
+			if (type > static_cast<uint8_t>(ColumnType::String) || encoding > static_cast<uint8_t>(ColumnEncoding::Dictionary)) {
+				cursor.ThrowError("Invalid type or encoding of column '" + std::string(column.Key) + "'");
+			}
+			column.Type = static_cast<ColumnType>(type);
+			const auto columnEncoding = static_cast<ColumnEncoding>(encoding);
+			const bool isInteger = column.Type == ColumnType::SignedInteger || column.Type == ColumnType::UnsignedInteger;
+			if ((columnEncoding == ColumnEncoding::Delta && !isInteger) ||
+				(columnEncoding == ColumnEncoding::Dictionary && column.Type != ColumnType::String))
+			{
+				cursor.ThrowError("Invalid encoding of column '" + std::string(column.Key) + "'");
+			}
+
+			// Decode the column
+			CInputCursor columnCursor(mInputData, cursor.GetPosition(), cursor.GetPosition() + static_cast<size_t>(dataSize));
+			if (flags & HasNullsFlag) {
+				column.NullBitmap = columnCursor.ReadPacked(mRowsCount, 1);
+			}
+
+			switch (column.Type)
+			{
+			case ColumnType::Null:
+				if (column.NullBitmap.empty() && mRowsCount != 0) {
+					columnCursor.ThrowError("Missing bitmap of null values in column '" + std::string(column.Key) + "'");
+				}
+				break;
+			case ColumnType::Boolean:
+				UnpackBits(columnCursor.ReadPacked(mRowsCount, 1), mRowsCount, 1, column.Values);
+				break;
+			case ColumnType::SignedInteger:
+			case ColumnType::UnsignedInteger:
+				if (columnEncoding == ColumnEncoding::Delta)
+				{
+					if (mRowsCount == 0) {
+						columnCursor.ThrowError("Invalid encoding of column '" + std::string(column.Key) + "'");
+					}
+					uint64_t prevValue = columnCursor.ReadVarInt();
+					std::vector<uint64_t> deltas;
+					ReadPackedValues(columnCursor, mRowsCount - 1, deltas);
+					column.Values.resize(mRowsCount);
+					column.Values[0] = prevValue;
+					for (size_t i = 1; i < mRowsCount; ++i) {
+						column.Values[i] = prevValue += static_cast<uint64_t>(ZigZagDecode(deltas[i - 1]));
+					}
+				}
+				else
+				{
+					ReadPackedValues(columnCursor, mRowsCount, column.Values);
+					if (column.Type == ColumnType::SignedInteger)
+					{
+						for (uint64_t& value : column.Values) {
+							value = static_cast<uint64_t>(ZigZagDecode(value));
+						}
+					}
+				}
+				break;
+			case ColumnType::Float:
+			case ColumnType::Double:
+			{
+				const size_t valueSize = column.Type == ColumnType::Float ? sizeof(float) : sizeof(double);
+				if (mRowsCount > columnCursor.GetRemaining() / valueSize) {
+					columnCursor.ThrowError("Unexpected end of data");
+				}
+				const std::string_view data = columnCursor.ReadBytes(mRowsCount * valueSize);
+				column.Values.resize(mRowsCount);
+				for (size_t i = 0; i < mRowsCount; ++i) {
+					column.Values[i] = ReadLittleEndian(data.data() + i * valueSize, valueSize);
+				}
+				break;
+			}
+			case ColumnType::String:
+				if (columnEncoding == ColumnEncoding::Dictionary)
+				{
+					// Unique strings can contain only one empty string, so the size of dictionary is limited by the size of data
+					const uint64_t dictionarySize = columnCursor.ReadVarInt();
+					if (dictionarySize == 0 || dictionarySize > columnCursor.GetRemaining() + 1) {
+						columnCursor.ThrowError("Invalid size of dictionary");
+					}
+					column.IsDictionary = true;
+					ReadPlainStrings(columnCursor, static_cast<size_t>(dictionarySize), column.Strings);
+					const size_t indexesPos = columnCursor.GetPosition();
+					ReadPackedValues(columnCursor, mRowsCount, column.Values);
+					if (std::any_of(column.Values.cbegin(), column.Values.cend(), [dictionarySize](uint64_t index) { return index >= dictionarySize; })) {
+						throw ParsingException("Invalid index of string in the dictionary", 0, indexesPos);
+					}
+				}
+				else {
+					ReadPlainStrings(columnCursor, mRowsCount, column.Strings);
+				}
+				break;
+			}
+
+			if (columnCursor.GetRemaining() != 0) {
+				columnCursor.ThrowError("Invalid size of data in column '" + std::string(column.Key) + "'");
+			}
+			cursor.ReadBytes(dataSize);
+		}
+
+		if (cursor.GetRemaining() != 0) {
+			cursor.ThrowError("Unexpected data after the last column");
+		}
+	}
+
+	bool CColumnarReader::NextRow() noexcept
+	{
+		if (mNextRowIndex >= mRowsCount) {
+			return false;
+		}
+		mRowIndex = mNextRowIndex++;
+		return true;
+	}
+
+	bool CColumnarReader::ReadValue(std::string_view key, std::nullptr_t&)
+	{
+		if (const CColumn* column = FindColumn(key))
+		{
+			if (column->IsNull(mRowIndex)) {
+				return true;
+			}
+			return HandleMismatchedType();
+		}
+		return false;
+	}
+
+	bool CColumnarReader::ReadValue(std::string_view key, bool& value)
+	{
+		return ReadNumber(key, value);
+	}
+
+	bool CColumnarReader::ReadValue(std::string_view key, uint8_t& value)
+	{
+		return ReadNumber(key, value);
+	}
+
+	bool CColumnarReader::ReadValue(std::string_view key, uint16_t& value)
+	{
+		return ReadNumber(key, value);
+	}
+
+	bool CColumnarReader::ReadValue(std::string_view key, uint32_t& value)
+	{
+		return ReadNumber(key, value);
+	}
+
+	bool CColumnarReader::ReadValue(std::string_view key, uint64_t& value)
+	{
+		return ReadNumber(key, value);
+	}
+
+	bool CColumnarReader::ReadValue(std::string_view key, int8_t& value)
+	{
+		return ReadNumber(key, value);
+	}
+
+	bool CColumnarReader::ReadValue(std::string_view key, int16_t& value)
+	{
+		return ReadNumber(key, value);
+	}
+
+	bool CColumnarReader::ReadValue(std::string_view key, int32_t& value)
+	{
+		return ReadNumber(key, value);
+	}
+
+	bool CColumnarReader::ReadValue(std::string_view key, int64_t& value)
+	{
+		return ReadNumber(key, value);
+	}
+
+	bool CColumnarReader::ReadValue(std::string_view key, float& value)
+	{
+		return ReadNumber(key, value);
+	}
+
+	bool CColumnarReader::ReadValue(std::string_view key, double& value)
+	{
+		return ReadNumber(key, value);
+	}
+
+	bool CColumnarReader::ReadValue(std::string_view key, std::string_view& value)
+	{
+		const CColumn* column = FindColumn(key);
+		// Null value is excluded from MismatchedTypesPolicy processing
+		if (column == nullptr || column->IsNull(mRowIndex)) {
+			return false;
+		}
+		if (column->Type == ColumnType::String)
+		{
+			value = column->GetString(mRowIndex);
+			return true;
+		}
+		return HandleMismatchedType();
+	}
+
+	const CColumnarReader::CColumn* CColumnarReader::FindColumn(std::string_view key) noexcept
+	{
+		// Searching from the next column, as usually fields are loaded in the same order as they were saved
+		const size_t columnsCount = mColumns.size();
+		for (size_t i = 0; i < columnsCount; ++i)
+		{
+			size_t index = mNextColumnIndex + i;
+			if (index >= columnsCount) {
+				index -= columnsCount;
+			}
+			if (mColumns[index].Key == key)
+			{
+				mNextColumnIndex = index + 1;
+				return &mColumns[index];
+			}
+		}
+		return nullptr;
+	}
+
+	template <typename T>
+	bool CColumnarReader::ReadNumber(std::string_view key, T& value)
+	{
+		const CColumn* column = FindColumn(key);
+		// Null value is excluded from MismatchedTypesPolicy processing
+		if (column == nullptr || column->IsNull(mRowIndex)) {
+			return false;
+		}
+
+		const auto overflowNumberPolicy = mSerializationOptions.overflowNumberPolicy;
+		const uint64_t rawValue = column->GetValue(mRowIndex);
+		switch (column->Type)
+		{
+		case ColumnType::SignedInteger:
+			return CastNumber(static_cast<int64_t>(rawValue), value, overflowNumberPolicy);
+		case ColumnType::UnsignedInteger:
+			return CastNumber(rawValue, value, overflowNumberPolicy);
+		case ColumnType::Float:
+		{
+			float floatValue;
+			const auto bits = static_cast<uint32_t>(rawValue);
+			std::memcpy(&floatValue, &bits, sizeof(floatValue));
+			return CastNumber(floatValue, value, overflowNumberPolicy);
+		}
+		case ColumnType::Double:
+		{
+			double doubleValue;
+			std::memcpy(&doubleValue, &rawValue, sizeof(doubleValue));
+			return CastNumber(doubleValue, value, overflowNumberPolicy);
+		}
+		case ColumnType::Boolean:
+			if constexpr (std::is_integral_v<T>) {
+				return CastNumber(rawValue != 0, value, overflowNumberPolicy);
+			}
+			break;
+		default:
+			break;
+		}
+		return HandleMismatchedType();
+	}
+
+	bool CColumnarReader::HandleMismatchedType() const
+	{
+		if (mSerializationOptions.mismatchedTypesPolicy == MismatchedTypesPolicy::ThrowError)
+		{
+			throw SerializationException(SerializationErrorCode::MismatchedTypes,
+				"The type of target field does not match the value being loaded");
+		}
+		return false;
+	}
+}
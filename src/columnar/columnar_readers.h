@@ -0,0 +1,86 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include "bitserializer/columnar_archive.h"
+#include "columnar_format.h"
+
+namespace BitSerializer::Columnar::Detail
+{
+	/// <summary>
+	/// Columnar reader from the continuous block of memory.
+	/// All columns are validated and decoded one by one in the constructor, then objects are filled from decoded columns.
+	/// Strings are returned as views to the input data.
+	/// </summary>
+	class CColumnarReader final : public IColumnarReader
+	{
+	public:
+		CColumnarReader(std::string_view inputData, const SerializationOptions& serializationOptions);
+
+		[[nodiscard]] size_t GetCurrentIndex() const noexcept override { return mRowIndex; }
+		[[nodiscard]] size_t GetRowsCount() const noexcept override { return mRowsCount; }
+		[[nodiscard]] size_t GetColumnsCount() const noexcept override { return mColumns.size(); }
+		[[nodiscard]] bool IsEnd() const noexcept override { return mNextRowIndex >= mRowsCount; }
+		bool NextRow() noexcept override;
+		bool ReadValue(std::string_view key, std::nullptr_t& value) override;
+		bool ReadValue(std::string_view key, bool& value) override;
+		bool ReadValue(std::string_view key, uint8_t& value) override;
+		bool ReadValue(std::string_view key, uint16_t& value) override;
+		bool ReadValue(std::string_view key, uint32_t& value) override;
+		bool ReadValue(std::string_view key, uint64_t& value) override;
+		bool ReadValue(std::string_view key, int8_t& value) override;
+		bool ReadValue(std::string_view key, int16_t& value) override;
+		bool ReadValue(std::string_view key, int32_t& value) override;
+		bool ReadValue(std::string_view key, int64_t& value) override;
+		bool ReadValue(std::string_view key, float& value) override;
+		bool ReadValue(std::string_view key, double& value) override;
+		bool ReadValue(std::string_view key, std::string_view& value) override;
+
+	private:
+		struct CColumn
+		{
+			std::string_view Key;
+			ColumnType Type = ColumnType::Null;
+			// One bit per row (empty when the column does not contain null values)
+			std::string_view NullBitmap;
+			// Values of numbers and booleans or indexes of strings in the dictionary (empty for other columns)
+			std::vector<uint64_t> Values;
+			// Strings of all rows or unique strings (when the column is dictionary encoded)
+			std::vector<std::string_view> Strings;
+			bool IsDictionary = false;
+
+			[[nodiscard]] bool IsNull(size_t row) const noexcept
+			{
+				return Type == ColumnType::Null ||
+					(!NullBitmap.empty() && (static_cast<uint8_t>(NullBitmap[row / 8]) >> (row % 8) & 1) != 0);
+			}
+
+			[[nodiscard]] uint64_t GetValue(size_t row) const noexcept
+			{
+				return Values.empty() ? 0 : Values[row];
+			}
+
+			[[nodiscard]] std::string_view GetString(size_t row) const noexcept
+			{
+				if (IsDictionary) {
+					return Strings[static_cast<size_t>(GetValue(row))];
+				}
+				return Strings[row];
+			}
+		};
+
+		const CColumn* FindColumn(std::string_view key) noexcept;
+		template <typename T>
+		bool ReadNumber(std::string_view key, T& value);
+		bool HandleMismatchedType() const;
+
+		std::string_view mInputData;
+		const SerializationOptions& mSerializationOptions;
+		std::vector<CColumn> mColumns;
+		size_t mRowsCount = 0;
+		size_t mRowIndex = 0;
+		size_t mNextRowIndex = 0;
+		size_t mNextColumnIndex = 0;
+	};
+}
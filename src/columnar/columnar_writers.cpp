@@ -0,0 +1,364 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include "columnar_writers.h"
+
+
+namespace
+{
+	using namespace BitSerializer;
+	using namespace BitSerializer::Columnar::Detail;
+
+	void WriteVarInt(std::string& output, uint64_t value)
+	{
+		for (; value >= 0x80; value >>= 7) {
+			output.push_back(static_cast<char>((value & 0x7F) | 0x80));
+		}
+		output.push_back(static_cast<char>(value));
+	}
+
+	void WriteLittleEndian(std::string& output, uint64_t value, size_t size)
+	{
+		for (size_t i = 0; i < size; ++i, value >>= 8) {
+			output.push_back(static_cast<char>(value & 0xFF));
+		}
+	}
+
+	/// <summary>
+	/// Packs values with passed width in bits (the values must fit into this width), the lowest bits go first.
+	/// </summary>
+	template <typename TGetValue>
+	void PackBits(std::string& output, size_t count, uint8_t bitWidth, TGetValue&& getValue)
+	{
+		if (bitWidth == 0) {
+			return;
+		}
+
+		output.reserve(output.size() + GetPackedSize(count, bitWidth));
+		uint64_t acc = 0;
+		size_t accBits = 0;
+		for (size_t i = 0; i < count; ++i)
+		{
+			const uint64_t value = getValue(i);
+			acc |= value << accBits;
+			accBits += bitWidth;
+			if (accBits >= 64)
+			{
+				WriteLittleEndian(output, acc, sizeof(acc));
+				accBits -= 64;
+				const size_t consumedBits = bitWidth - accBits;
+				acc = consumedBits < 64 ? value >> consumedBits : 0;
+			}
+		}
+		WriteLittleEndian(output, acc, (accBits + 7) / 8);
+	}
+
+	/// <summary>
+	/// Writes width in bits and packed values (the width is at least one bit, so the size of data limits the number of values).
+	/// </summary>
+	template <typename TGetValue>
+	void WritePackedValues(std::string& output, size_t count, uint8_t bitWidth, TGetValue&& getValue)
+	{
+		if (count != 0) {
+			bitWidth = std::max<uint8_t>(bitWidth, 1);
+		}
+		output.push_back(static_cast<char>(bitWidth));
+		PackBits(output, count, bitWidth, std::forward<TGetValue>(getValue));
+	}
+
+	/// <summary>
+	/// Writes plain strings: bit-packed lengths and characters of all strings.
+	/// </summary>
+	void WritePlainStrings(std::string& output, const std::vector<std::string_view>& strings)
+	{
+		size_t maxLength = 0;
+		size_t totalLength = 0;
+		for (const auto& str : strings)
+		{
+			maxLength = std::max(maxLength, str.size());
+			totalLength += str.size();
+		}
+		WritePackedValues(output, strings.size(), GetBitWidth(maxLength), [&strings](size_t i) {
+			return static_cast<uint64_t>(strings[i].size());
+		});
+		output.reserve(output.size() + totalLength);
+		for (const auto& str : strings) {
+			output.append(str);
+		}
+	}
+}
+
+namespace BitSerializer::Columnar::Detail
+{
+	void CColumnarWriter::WriteNull(std::string_view key)
+	{
+		CColumn& column = AddValue(key, ColumnType::Null);
+		if (column.NullBitmap.empty()) {
+			column.NullBitmap.reserve(GetPackedSize(std::max(mEstimatedSize, mRowIndex + 1), 1));
+		}
+		column.NullBitmap.resize(GetPackedSize(mRowIndex + 1, 1), 0);
+		column.NullBitmap[mRowIndex / 8] |= static_cast<uint8_t>(1 << (mRowIndex % 8));
+
+		// Placeholders for keeping the index of row (the type of column may be still unknown)
+		column.Values.push_back(0);
+		column.StringEnds.push_back(column.Strings.size());
+	}
+
+	void CColumnarWriter::WriteBoolean(std::string_view key, bool value)
+	{
+		AddValue(key, ColumnType::Boolean).Values.push_back(value ? 1 : 0);
+	}
+
+	void CColumnarWriter::WriteSignedInteger(std::string_view key, int64_t value)
+	{
+		AddValue(key, ColumnType::SignedInteger).Values.push_back(static_cast<uint64_t>(value));
+	}
+
+	void CColumnarWriter::WriteUnsignedInteger(std::string_view key, uint64_t value)
+	{
+		AddValue(key, ColumnType::UnsignedInteger).Values.push_back(value);
+	}
+
+	void CColumnarWriter::WriteFloat(std::string_view key, float value)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		AddValue(key, ColumnType::Float).Values.push_back(bits);
+	}
+
+	void CColumnarWriter::WriteDouble(std::string_view key, double value)
+	{
+		uint64_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		AddValue(key, ColumnType::Double).Values.push_back(bits);
+	}
+
+	void CColumnarWriter::WriteString(std::string_view key, std::string_view value)
+	{
+		CColumn& column = AddValue(key, ColumnType::String);
+		column.Strings.append(value);
+		column.StringEnds.push_back(column.Strings.size());
+	}
+
+	void CColumnarWriter::NextRow() noexcept
+	{
+		if (mValueIndex != mColumns.size()) {
+			mHasIncompleteRow = true;
+		}
+		++mRowIndex;
+		mValueIndex = 0;
+	}
+
+	void CColumnarWriter::CheckIncompleteRow() const
+	{
+		if (mHasIncompleteRow)
+		{
+			throw SerializationException(SerializationErrorCode::OutOfRange,
+				"Number of values are different than in the first row");
+		}
+	}
+
+	CColumnarWriter::CColumn& CColumnarWriter::AddValue(std::string_view key, ColumnType type)
+	{
+		CheckIncompleteRow();
+
+		// Columns are discovered by keys of the first row
+		if (mRowIndex == 0)
+		{
+			CColumn& column = mColumns.emplace_back();
+			column.Key = key;
+			if (type == ColumnType::String) {
+				column.StringEnds.reserve(mEstimatedSize);
+			}
+			else {
+				column.Values.reserve(mEstimatedSize);
+			}
+		}
+		else if (mValueIndex >= mColumns.size() || mColumns[mValueIndex].Key != key)
+		{
+			throw SerializationException(SerializationErrorCode::OutOfRange,
+				"The key '" + std::string(key) + "' does not match to the column of the first row (all objects must have the same set of fields)");
+		}
+
+		CColumn& column = mColumns[mValueIndex++];
+		if (type != ColumnType::Null && column.Type != type)
+		{
+			if (column.Type != ColumnType::Null)
+			{
+				throw SerializationException(SerializationErrorCode::MismatchedTypes,
+					"The values of column '" + column.Key + "' have different types");
+			}
+			column.Type = type;
+		}
+		return column;
+	}
+
+	void CColumnarWriter::Encode(std::string& output)
+	{
+		CheckIncompleteRow();
+		// The number of rows is validated by the size of columns data on loading
+		if (mColumns.empty() && mRowIndex != 0)
+		{
+			throw SerializationException(SerializationErrorCode::OutOfRange,
+				"Objects without fields can't be saved to the columnar archive");
+		}
+
+		output.append(std::cbegin(Signature), std::cend(Signature));
+		output.push_back(static_cast<char>(FormatVersion));
+		WriteVarInt(output, mRowIndex);
+		WriteVarInt(output, mColumns.size());
+		for (const CColumn& column : mColumns)
+		{
+			WriteVarInt(output, column.Key.size());
+			output.append(column.Key);
+			EncodeColumn(column, output);
+		}
+	}
+
+	void CColumnarWriter::EncodeColumn(const CColumn& column, std::string& output)
+	{
+		const size_t rowsCount = mRowIndex;
+		const bool hasNulls = !column.NullBitmap.empty();
+		ColumnEncoding encoding = ColumnEncoding::Plain;
+
+		mColumnData.clear();
+		if (hasNulls)
+		{
+			mColumnData.append(reinterpret_cast<const char*>(column.NullBitmap.data()), column.NullBitmap.size());
+			mColumnData.append(GetPackedSize(rowsCount, 1) - column.NullBitmap.size(), 0);
+		}
+
+		switch (column.Type)
+		{
+		case ColumnType::Null:
+			break;
+		case ColumnType::Boolean:
+			PackBits(mColumnData, rowsCount, 1, [&column](size_t i) { return column.Values[i]; });
+			break;
+		case ColumnType::SignedInteger:
+		case ColumnType::UnsignedInteger:
+		{
+			// The width of all values is determined by OR of them, the delta encoding is used when it requires less bits
+			const bool isSigned = column.Type == ColumnType::SignedInteger;
+			uint64_t plainBits = 0, deltaBits = 0;
+			for (size_t i = 0; i < rowsCount; ++i)
+			{
+				const uint64_t value = column.Values[i];
+				plainBits |= isSigned ? ZigZagEncode(static_cast<int64_t>(value)) : value;
+				if (i != 0) {
+					deltaBits |= ZigZagEncode(static_cast<int64_t>(value - column.Values[i - 1]));
+				}
+			}
+
+			const uint8_t plainWidth = std::max<uint8_t>(GetBitWidth(plainBits), 1);
+			const uint8_t deltaWidth = std::max<uint8_t>(GetBitWidth(deltaBits), 1);
+			if (rowsCount > 1 && deltaWidth < plainWidth)
+			{
+				// The first value is stored as is, next values as differences with previous ones
+				encoding = ColumnEncoding::Delta;
+				WriteVarInt(mColumnData, column.Values[0]);
+				WritePackedValues(mColumnData, rowsCount - 1, deltaWidth, [&column](size_t i) {
+					return ZigZagEncode(static_cast<int64_t>(column.Values[i + 1] - column.Values[i]));
+				});
+			}
+			else
+			{
+				WritePackedValues(mColumnData, rowsCount, plainWidth, [&column, isSigned](size_t i) {
+					return isSigned ? ZigZagEncode(static_cast<int64_t>(column.Values[i])) : column.Values[i];
+				});
+			}
+			break;
+		}
+		case ColumnType::Float:
+		case ColumnType::Double:
+		{
+			const size_t valueSize = column.Type == ColumnType::Float ? sizeof(float) : sizeof(double);
+			mColumnData.reserve(mColumnData.size() + rowsCount * valueSize);
+			for (const uint64_t value : column.Values) {
+				WriteLittleEndian(mColumnData, value, valueSize);
+			}
+			break;
+		}
+		case ColumnType::String:
+		{
+			std::vector<std::string_view> strings;
+			strings.reserve(rowsCount);
+			for (size_t i = 0, startPos = 0; i < rowsCount; startPos = column.StringEnds[i++]) {
+				strings.emplace_back(column.Strings.data() + startPos, column.StringEnds[i] - startPos);
+			}
+
+			// The dictionary is used when the number of unique strings is not more than half of the rows
+			const size_t maxDictionarySize = rowsCount / 2;
+			std::unordered_map<std::string_view, uint64_t> dictionary;
+			std::vector<std::string_view> uniqueStrings;
+			std::vector<uint64_t> indexes;
+			indexes.reserve(rowsCount);
+			for (const auto& str : strings)
+			{
+				const auto result = dictionary.try_emplace(str, uniqueStrings.size());
+				if (result.second)
+				{
+					if (uniqueStrings.size() == maxDictionarySize) {
+						break;
+					}
+					uniqueStrings.push_back(str);
+				}
+				indexes.push_back(result.first->second);
+			}
+
+			if (indexes.size() == rowsCount && rowsCount != 0)
+			{
+				encoding = ColumnEncoding::Dictionary;
+				WriteVarInt(mColumnData, uniqueStrings.size());
+				WritePlainStrings(mColumnData, uniqueStrings);
+				WritePackedValues(mColumnData, rowsCount, GetBitWidth(uniqueStrings.size() - 1), [&indexes](size_t i) {
+					return indexes[i];
+				});
+			}
+			else {
+				WritePlainStrings(mColumnData, strings);
+			}
+			break;
+		}
+		}
+
+		output.push_back(static_cast<char>(column.Type));
+		output.push_back(static_cast<char>(encoding));
+		output.push_back(static_cast<char>(hasNulls ? HasNullsFlag : 0));
+		WriteVarInt(output, mColumnData.size());
+		output.append(mColumnData);
+	}
+
+	//------------------------------------------------------------------------------
+
+	template <class TBuffer>
+	void CColumnarBufferWriter<TBuffer>::Flush()
+	{
+		if constexpr (std::is_same_v<TBuffer, std::string>) {
+			Encode(mBuffer);
+		}
+		else
+		{
+			std::string encodedData;
+			Encode(encodedData);
+			mBuffer.insert(mBuffer.end(), encodedData.cbegin(), encodedData.cend());
+		}
+	}
+
+	void CColumnarStreamWriter::Flush()
+	{
+		std::string encodedData;
+		Encode(encodedData);
+		mOutputStream.write(encodedData.data(), static_cast<std::streamsize>(encodedData.size()));
+		if (!mOutputStream.good()) {
+			throw SerializationException(SerializationErrorCode::InputOutputError, "Error writing to the output stream");
+		}
+	}
+
+	template class CColumnarBufferWriter<std::string>;
+	template class CColumnarBufferWriter<std::vector<uint8_t>>;
+}
@@ -0,0 +1,91 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <ostream>
+#include "bitserializer/columnar_archive.h"
+#include "columnar_format.h"
+
+namespace BitSerializer::Columnar::Detail
+{
+	/// <summary>
+	/// Base columnar writer, collects values into per-field columns and encodes them when flushing.
+	/// Columns are discovered by keys of the first row, all next rows must have the same set of fields (like in the CSV archive).
+	/// </summary>
+	class CColumnarWriter : public IColumnarWriter
+	{
+	public:
+		void SetEstimatedSize(size_t size) override { mEstimatedSize = size; }
+		void WriteNull(std::string_view key) override;
+		void WriteBoolean(std::string_view key, bool value) override;
+		void WriteSignedInteger(std::string_view key, int64_t value) override;
+		void WriteUnsignedInteger(std::string_view key, uint64_t value) override;
+		void WriteFloat(std::string_view key, float value) override;
+		void WriteDouble(std::string_view key, double value) override;
+		void WriteString(std::string_view key, std::string_view value) override;
+		void NextRow() noexcept override;
+		[[nodiscard]] size_t GetCurrentIndex() const noexcept override { return mRowIndex; }
+
+	protected:
+		struct CColumn
+		{
+			std::string Key;
+			ColumnType Type = ColumnType::Null;
+			// Values of numbers and booleans (floating point numbers are stored as bits)
+			std::vector<uint64_t> Values;
+			// Characters of all strings and positions of their ends
+			std::string Strings;
+			std::vector<size_t> StringEnds;
+			// One bit per row, allocated on the first null value
+			std::vector<uint8_t> NullBitmap;
+		};
+
+		void Encode(std::string& output);
+		void EncodeColumn(const CColumn& column, std::string& output);
+
+	private:
+		CColumn& AddValue(std::string_view key, ColumnType type);
+		void CheckIncompleteRow() const;
+
+		std::vector<CColumn> mColumns;
+		std::string mColumnData;
+		size_t mRowIndex = 0;
+		size_t mValueIndex = 0;
+		size_t mEstimatedSize = 0;
+		bool mHasIncompleteRow = false;
+	};
+
+	/// <summary>
+	/// Columnar writer to the buffer (<c>std::string</c> or <c>std::vector&lt;uint8_t&gt;</c>).
+	/// </summary>
+	template <class TBuffer>
+	class CColumnarBufferWriter final : public CColumnarWriter
+	{
+	public:
+		explicit CColumnarBufferWriter(TBuffer& outputBuffer)
+			: mBuffer(outputBuffer)
+		{ }
+
+		void Flush() override;
+
+	private:
+		TBuffer& mBuffer;
+	};
+
+	/// <summary>
+	/// Columnar writer to the stream (the data is written when flushing, as the columns are encoded after collecting all rows).
+	/// </summary>
+	class CColumnarStreamWriter final : public CColumnarWriter
+	{
+	public:
+		explicit CColumnarStreamWriter(std::ostream& outputStream)
+			: mOutputStream(outputStream)
+		{ }
+
+		void Flush() override;
+
+	private:
+		std::ostream& mOutputStream;
+	};
+}
@@ -248,7 +248,7 @@ namespace BitSerializer::Csv::Detail
 				const auto& valueMeta = mRowValuesMeta.at(mValueIndex);
 				if (valueMeta.HasEscapedChars)
 				{
-					out_value = UnescapeValue(mDecodedBuffer.data() + valueMeta.Offset, mDecodedBuffer.data() + valueMeta.Size);
+					out_value = UnescapeValue(mDecodedBuffer.data() + valueMeta.Offset, mDecodedBuffer.data() + valueMeta.Offset + valueMeta.Size);
 				}
 				else
 				{
@@ -322,8 +322,8 @@ namespace BitSerializer::Csv::Detail
 		++mLineNumber;
 		mPrevValuesCount = out_values.size();
 		out_values.clear();
-		// Remove parsed string part
-		if (mCurrentPos)
+		// Remove parsed string part (only when it takes more than half of buffer, for avoid moving data on each line)
+		if (mCurrentPos && mCurrentPos >= mDecodedBuffer.size() / 2)
 		{
 			mDecodedBuffer.erase(0, mCurrentPos);
 			mCurrentPos = 0;
@@ -0,0 +1,57 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <istream>
+#include "json_readers.h"
+#include "json_writers.h"
+#include "bitserializer/serialization_detail/archive_helpers.h"
+
+
+namespace BitSerializer::Json::Simd::Detail
+{
+	JsonWriteRootScope::JsonWriteRootScope(std::string& outputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mJsonWriter(std::make_unique<CJsonWriter>(outputData, serializationContext.GetOptions().formatOptions))
+	{ }
+
+	JsonWriteRootScope::JsonWriteRootScope(std::ostream& outputStream, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mJsonWriter(std::make_unique<CJsonStreamWriter>(outputStream,
+			serializationContext.GetOptions().formatOptions, serializationContext.GetOptions().streamOptions))
+	{ }
+
+	JsonReadRootScope::JsonReadRootScope(std::string_view inputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mJsonReader(std::make_unique<CJsonReader>(inputData, serializationContext.GetOptions()))
+	{ }
+
+	JsonReadRootScope::JsonReadRootScope(std::istream& inputStream, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mStreamData(BitSerializer::Detail::ReadAllFromEncodedStream(inputStream))
+		, mJsonReader(std::make_unique<CJsonReader>(mStreamData, serializationContext.GetOptions()))
+	{ }
+
+	//------------------------------------------------------------------------------
+
+	JsonLinesWriteRootScope::JsonLinesWriteRootScope(std::string& outputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mJsonWriter(std::make_unique<CJsonWriter>(outputData, serializationContext.GetOptions().formatOptions, true))
+	{ }
+
+	JsonLinesWriteRootScope::JsonLinesWriteRootScope(std::ostream& outputStream, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mJsonWriter(std::make_unique<CJsonStreamWriter>(outputStream,
+			serializationContext.GetOptions().formatOptions, serializationContext.GetOptions().streamOptions, true))
+	{ }
+
+	JsonLinesReadRootScope::JsonLinesReadRootScope(std::string_view inputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mJsonLinesReader(std::make_unique<CJsonLinesReader>(inputData, serializationContext.GetOptions()))
+	{ }
+
+	JsonLinesReadRootScope::JsonLinesReadRootScope(std::istream& inputStream, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mJsonLinesReader(std::make_unique<CJsonLinesReader>(inputStream, serializationContext.GetOptions()))
+	{ }
+}
@@ -0,0 +1,923 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include "json_readers.h"
+#include "bitserializer/serialization_detail/archive_helpers.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BITSERIALIZER_JSON_SSE2
+#endif
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+
+namespace
+{
+	using namespace BitSerializer;
+	using BitSerializer::Detail::CastNumber;
+
+	constexpr size_t BlockSize = 64;
+
+	/// <summary>
+	/// Bit masks of character classes in the block of 64 bytes (bit N corresponds to the N-th character).
+	/// </summary>
+	struct CBlockMasks
+	{
+		uint64_t Quote = 0;
+		uint64_t Backslash = 0;
+		// Brackets, colons and commas
+		uint64_t Structural = 0;
+		uint64_t Whitespace = 0;
+		// Characters with codes less than 0x20 (not allowed inside strings)
+		uint64_t Control = 0;
+	};
+
+#ifdef BITSERIALIZER_JSON_SSE2
+	uint64_t MoveMask(__m128i value, size_t shift) noexcept
+	{
+		return static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(value))) << shift;
+	}
+
+	CBlockMasks ClassifyBlock(const char* block) noexcept
+	{
+		CBlockMasks masks;
+		for (size_t i = 0; i < BlockSize; i += 16)
+		{
+			const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+			// Square brackets differ from curly brackets only by one bit
+			const __m128i foldedChunk = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+			const __m128i structural = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(foldedChunk, _mm_set1_epi8('{')), _mm_cmpeq_epi8(foldedChunk, _mm_set1_epi8('}'))),
+				_mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(':')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8(','))));
+			const __m128i whitespace = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t'))),
+				_mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r'))));
+			// SSE2 does not have unsigned comparison, but (sym <= 0x1F) is the same as (max(sym, 0x1F) == 0x1F)
+			const __m128i control = _mm_cmpeq_epi8(_mm_max_epu8(chunk, _mm_set1_epi8(0x1F)), _mm_set1_epi8(0x1F));
+
+			masks.Quote |= MoveMask(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')), i);
+			masks.Backslash |= MoveMask(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\')), i);
+			masks.Structural |= MoveMask(structural, i);
+			masks.Whitespace |= MoveMask(whitespace, i);
+			masks.Control |= MoveMask(control, i);
+		}
+		return masks;
+	}
+#else
+	CBlockMasks ClassifyBlock(const char* block) noexcept
+	{
+		CBlockMasks masks;
+		for (size_t i = 0; i < BlockSize; ++i)
+		{
+			const uint64_t bit = uint64_t(1) << i;
+			switch (block[i])
+			{
+			case '"':
+				masks.Quote |= bit;
+				break;
+			case '\\':
+				masks.Backslash |= bit;
+				break;
+			case '{': case '}': case '[': case ']': case ':': case ',':
+				masks.Structural |= bit;
+				break;
+			case ' ':
+				masks.Whitespace |= bit;
+				break;
+			case '\t': case '\n': case '\r':
+				masks.Whitespace |= bit;
+				masks.Control |= bit;
+				break;
+			default:
+				if (static_cast<unsigned char>(block[i]) < 0x20) {
+					masks.Control |= bit;
+				}
+				break;
+			}
+		}
+		return masks;
+	}
+#endif
+
+	size_t TrailingZeros(uint64_t value) noexcept
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<size_t>(__builtin_ctzll(value));
+#elif defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanForward64(&index, value);
+		return index;
+#else
+		size_t index = 0;
+		for (; (value & 1) == 0; value >>= 1, ++index);
+		return index;
+#endif
+	}
+
+	/// <summary>
+	/// Computes XOR of all previous bits for each bit (used for getting the mask of characters inside strings).
+	/// </summary>
+	uint64_t PrefixXor(uint64_t bits) noexcept
+	{
+		bits ^= bits << 1;
+		bits ^= bits << 2;
+		bits ^= bits << 4;
+		bits ^= bits << 8;
+		bits ^= bits << 16;
+		bits ^= bits << 32;
+		return bits;
+	}
+
+	/// <summary>
+	/// Returns the mask of escaped characters (which are preceded by odd number of backslashes).
+	/// The state is passed via `prevEscaped` for handling sequences which are crossing the boundary of blocks.
+	/// </summary>
+	uint64_t FindEscaped(uint64_t backslash, uint64_t& prevEscaped) noexcept
+	{
+		// The first character can't start new escape sequence when it is escaped by the previous block
+		backslash &= ~prevEscaped;
+		const uint64_t followsEscape = (backslash << 1) | prevEscaped;
+
+		// Get sequences starting on even bits by clearing out the odd series using addition
+		constexpr uint64_t evenBits = 0x5555555555555555ULL;
+		const uint64_t oddSequenceStarts = backslash & ~evenBits & ~followsEscape;
+		const uint64_t sequencesStartingOnEvenBits = oddSequenceStarts + backslash;
+		prevEscaped = sequencesStartingOnEvenBits < oddSequenceStarts ? 1 : 0;
+		const uint64_t invertMask = sequencesStartingOnEvenBits << 1;
+
+		return (evenBits ^ invertMask) & followsEscape;
+	}
+
+	void AppendPositions(std::vector<uint32_t>& structuralIndex, size_t offset, uint64_t bits)
+	{
+		while (bits != 0)
+		{
+			structuralIndex.push_back(static_cast<uint32_t>(offset + TrailingZeros(bits)));
+			bits &= bits - 1;
+		}
+	}
+
+	bool IsDigit(char sym) noexcept
+	{
+		return sym >= '0' && sym <= '9';
+	}
+
+	bool IsHexDigit(char sym) noexcept
+	{
+		return IsDigit(sym) || (sym >= 'a' && sym <= 'f') || (sym >= 'A' && sym <= 'F');
+	}
+
+	/// <summary>
+	/// Checks that character can follow the scalar value (number or literal).
+	/// </summary>
+	bool IsScalarDelimiter(char sym) noexcept
+	{
+		switch (sym)
+		{
+		case ' ': case '\t': case '\n': case '\r':
+		case '{': case '}': case '[': case ']': case ':': case ',': case '"':
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	uint32_t DecodeHex4(const char* in) noexcept
+	{
+		uint32_t code = 0;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			const char sym = in[i];
+			const uint32_t digit = IsDigit(sym) ? sym - '0' : (sym | 0x20) - 'a' + 10;
+			code = (code << 4) | digit;
+		}
+		return code;
+	}
+
+	void AppendUtf8(std::string& out, uint32_t code)
+	{
+		if (code < 0x80) {
+			out.push_back(static_cast<char>(code));
+		}
+		else if (code < 0x800)
+		{
+			out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+			out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+		}
+		else if (code < 0x10000)
+		{
+			out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+			out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+			out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+		}
+		else
+		{
+			out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+			out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+			out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+			out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+		}
+	}
+
+	/// <summary>
+	/// Parses the number with floating point (the syntax must be already validated).
+	/// Returns `false` when the number is out of range of target type.
+	/// </summary>
+	template <typename T>
+	bool ParseFloatingPoint(const char* begin, const char* end, T& value)
+	{
+#if defined(__cpp_lib_to_chars)
+		return std::from_chars(begin, end, value).ec == std::errc();
+#else
+		// Fallback for old compilers which do not support floating types in std::from_chars()
+		const std::string str(begin, end);
+		errno = 0;
+		if constexpr (std::is_same_v<T, float>) {
+			value = std::strtof(str.c_str(), nullptr);
+		}
+		else {
+			value = std::strtod(str.c_str(), nullptr);
+		}
+		return errno != ERANGE;
+#endif
+	}
+}
+
+namespace BitSerializer::Json::Simd::Detail
+{
+	CJsonReader::CJsonReader(const SerializationOptions& serializationOptions)
+		: mSerializationOptions(serializationOptions)
+	{ }
+
+	CJsonReader::CJsonReader(std::string_view inputData, const SerializationOptions& serializationOptions)
+		: mSerializationOptions(serializationOptions)
+	{
+		Parse(inputData);
+	}
+
+	void CJsonReader::Parse(std::string_view inputData, size_t firstLineNumber)
+	{
+		mInputData = inputData;
+		mFirstLineNumber = firstLineNumber;
+		mTokens.clear();
+		mPos = 0;
+
+		// Skip UTF-8 BOM
+		if (mInputData.size() >= sizeof(Convert::Utf8::bom) &&
+			std::equal(std::cbegin(Convert::Utf8::bom), std::cend(Convert::Utf8::bom), mInputData.cbegin()))
+		{
+			mInputData.remove_prefix(sizeof(Convert::Utf8::bom));
+		}
+
+		if (mInputData.size() >= std::numeric_limits<uint32_t>::max()) {
+			throw ParsingException("The size of input data exceeds the limit (4GB)");
+		}
+
+		mStructuralIndex.clear();
+		BuildStructuralIndex(mStructuralIndex);
+		BuildTokens(mStructuralIndex);
+	}
+
+	bool CJsonReader::ReadValue(std::nullptr_t& value)
+	{
+		if (GetTokenChar(mTokens[mPos]) == 'n')
+		{
+			++mPos;
+			return true;
+		}
+		return HandleMismatchedType();
+	}
+
+	bool CJsonReader::ReadValue(bool& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CJsonReader::ReadValue(uint8_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CJsonReader::ReadValue(uint16_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CJsonReader::ReadValue(uint32_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CJsonReader::ReadValue(uint64_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CJsonReader::ReadValue(int8_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CJsonReader::ReadValue(int16_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CJsonReader::ReadValue(int32_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CJsonReader::ReadValue(int64_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CJsonReader::ReadValue(float& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CJsonReader::ReadValue(double& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CJsonReader::ReadValue(std::string_view& value)
+	{
+		const CJsonToken& token = mTokens[mPos];
+		const char sym = GetTokenChar(token);
+		if (sym == '"')
+		{
+			++mPos;
+			value = ReadString(token, mValueBuffer);
+			return true;
+		}
+		// Null value is excluded from MismatchedTypesPolicy processing
+		if (sym == 'n')
+		{
+			++mPos;
+			return false;
+		}
+		return HandleMismatchedType();
+	}
+
+	void CJsonReader::ReadKey(std::string_view& key)
+	{
+		// Keys are always strings (validated when building tokens)
+		key = ReadString(mTokens[mPos], mKeyBuffer);
+		++mPos;
+	}
+
+	bool CJsonReader::ReadArraySize(size_t& arraySize) noexcept
+	{
+		const CJsonToken& token = mTokens[mPos];
+		if (GetTokenChar(token) == '[')
+		{
+			++mPos;
+			arraySize = token.Size;
+			return true;
+		}
+		SkipValue();
+		return false;
+	}
+
+	bool CJsonReader::ReadObjectSize(size_t& objectSize) noexcept
+	{
+		const CJsonToken& token = mTokens[mPos];
+		if (GetTokenChar(token) == '{')
+		{
+			++mPos;
+			objectSize = token.Size;
+			return true;
+		}
+		SkipValue();
+		return false;
+	}
+
+	void CJsonReader::SkipValue() noexcept
+	{
+		const CJsonToken& token = mTokens[mPos];
+		const char sym = GetTokenChar(token);
+		mPos = (sym == '{' || sym == '[') ? token.End : mPos + 1;
+	}
+
+	template <typename T>
+	bool CJsonReader::ReadNumber(T& value)
+	{
+		const CJsonToken& token = mTokens[mPos];
+		const char sym = GetTokenChar(token);
+		const auto overflowNumberPolicy = mSerializationOptions.overflowNumberPolicy;
+
+		if (sym == '-' || IsDigit(sym))
+		{
+			++mPos;
+			const char* begin = mInputData.data() + token.Offset;
+			const char* end = mInputData.data() + token.End;
+			// Integers are parsed without conversion to double (to keep precision of 64-bit numbers)
+			if (token.Size == 0)
+			{
+				if (sym == '-')
+				{
+					if (int64_t intValue; std::from_chars(begin, end, intValue).ec == std::errc()) {
+						return CastNumber(intValue, value, overflowNumberPolicy);
+					}
+				}
+				else if (uint64_t uintValue; std::from_chars(begin, end, uintValue).ec == std::errc()) {
+					return CastNumber(uintValue, value, overflowNumberPolicy);
+				}
+			}
+
+			// The float is parsed directly, as its shortest representation may be out of range when it is parsed as double
+			using float_type = std::conditional_t<std::is_same_v<T, float>, float, double>;
+			if (float_type floatValue; ParseFloatingPoint(begin, end, floatValue)) {
+				return CastNumber(floatValue, value, overflowNumberPolicy);
+			}
+			if (overflowNumberPolicy == OverflowNumberPolicy::ThrowError)
+			{
+				throw SerializationException(SerializationErrorCode::Overflow,
+					"The size of target field is not sufficient to deserialize number " + std::string(begin, end));
+			}
+			return false;
+		}
+
+		if constexpr (std::is_integral_v<T>)
+		{
+			if (sym == 't' || sym == 'f')
+			{
+				++mPos;
+				return CastNumber(sym == 't', value, overflowNumberPolicy);
+			}
+		}
+
+		// Null value is excluded from MismatchedTypesPolicy processing
+		if (sym == 'n')
+		{
+			++mPos;
+			return false;
+		}
+		return HandleMismatchedType();
+	}
+
+	std::string_view CJsonReader::ReadString(const CJsonToken& token, std::string& buffer)
+	{
+		const char* it = mInputData.data() + token.Offset + 1;
+		const char* endIt = mInputData.data() + token.End;
+		if (token.Size == 0) {
+			return { it, static_cast<size_t>(endIt - it) };
+		}
+
+		// Decode escaped characters (sequences are validated when building tokens)
+		buffer.clear();
+		while (it != endIt)
+		{
+			const auto* escapePos = static_cast<const char*>(std::memchr(it, '\\', static_cast<size_t>(endIt - it)));
+			if (escapePos == nullptr)
+			{
+				buffer.append(it, endIt);
+				break;
+			}
+			buffer.append(it, escapePos);
+
+			const char sym = escapePos[1];
+			it = escapePos + 2;
+			switch (sym)
+			{
+			case 'b':
+				buffer.push_back('\b');
+				break;
+			case 'f':
+				buffer.push_back('\f');
+				break;
+			case 'n':
+				buffer.push_back('\n');
+				break;
+			case 'r':
+				buffer.push_back('\r');
+				break;
+			case 't':
+				buffer.push_back('\t');
+				break;
+			case 'u':
+			{
+				uint32_t code = DecodeHex4(it);
+				it += 4;
+				if (code >= 0xD800 && code <= 0xDFFF)
+				{
+					// Surrogate pair
+					if (code <= 0xDBFF && endIt - it >= 6 && it[0] == '\\' && it[1] == 'u' &&
+						IsHexDigit(it[2]) && IsHexDigit(it[3]) && IsHexDigit(it[4]) && IsHexDigit(it[5]))
+					{
+						const uint32_t lowSurrogate = DecodeHex4(it + 2);
+						if (lowSurrogate >= 0xDC00 && lowSurrogate <= 0xDFFF)
+						{
+							code = 0x10000 + ((code - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+							it += 6;
+						}
+						else {
+							code = 0xFFFD;
+						}
+					}
+					else {
+						// Lone surrogate is replaced with the "replacement character"
+						code = 0xFFFD;
+					}
+				}
+				AppendUtf8(buffer, code);
+				break;
+			}
+			default:
+				// Quote, backslash and slash
+				buffer.push_back(sym);
+				break;
+			}
+		}
+		return buffer;
+	}
+
+	void CJsonReader::BuildStructuralIndex(std::vector<uint32_t>& structuralIndex) const
+	{
+		const size_t size = mInputData.size();
+		structuralIndex.reserve(size / 8 + 16);
+
+		uint64_t prevEscaped = 0;
+		uint64_t prevInString = 0;
+		uint64_t prevScalar = 0;
+		char lastBlock[BlockSize];
+		for (size_t offset = 0; offset < size; offset += BlockSize)
+		{
+			const char* block = mInputData.data() + offset;
+			if (size - offset < BlockSize)
+			{
+				// The last block is padded with spaces
+				std::memset(lastBlock, ' ', BlockSize);
+				std::memcpy(lastBlock, block, size - offset);
+				block = lastBlock;
+			}
+
+			const CBlockMasks masks = ClassifyBlock(block);
+			const uint64_t escaped = FindEscaped(masks.Backslash, prevEscaped);
+			const uint64_t quotes = masks.Quote & ~escaped;
+			// Opening quotes and characters inside strings (closing quotes are not included)
+			const uint64_t inString = PrefixXor(quotes) ^ prevInString;
+			prevInString = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+
+			// Starts of numbers and literals (characters which do not follow other scalar characters)
+			const uint64_t scalar = ~(masks.Structural | masks.Whitespace | quotes);
+			const uint64_t scalarStarts = scalar & ~((scalar << 1) | prevScalar);
+			prevScalar = scalar >> 63;
+
+			// Inside strings are indexed only escape sequences and control characters (for validation)
+			const uint64_t escapeStarts = masks.Backslash & ~escaped;
+			AppendPositions(structuralIndex, offset,
+				((masks.Structural | scalarStarts) & ~inString) | quotes | ((escapeStarts | masks.Control) & inString));
+		}
+
+		if (prevInString != 0)
+		{
+			// The last quote in the index is opening
+			ThrowParsingError("Missing closing quote of string", structuralIndex.empty() ? size : structuralIndex.back());
+		}
+	}
+
+	void CJsonReader::BuildTokens(const std::vector<uint32_t>& structuralIndex)
+	{
+		enum class Expected
+		{
+			Value,
+			ValueOrArrayEnd,
+			Key,
+			KeyOrObjectEnd,
+			Colon,
+			CommaOrEnd,
+			Nothing
+		};
+
+		mTokens.reserve(structuralIndex.size());
+		auto& openedContainers = mOpenedContainers;
+		openedContainers.clear();
+		Expected expected = Expected::Value;
+
+		const auto closeContainer = [this, &openedContainers, &expected]()
+		{
+			mTokens[openedContainers.back()].End = static_cast<uint32_t>(mTokens.size());
+			openedContainers.pop_back();
+			expected = openedContainers.empty() ? Expected::Nothing : Expected::CommaOrEnd;
+		};
+
+		for (size_t i = 0; i < structuralIndex.size(); ++i)
+		{
+			const uint32_t offset = structuralIndex[i];
+			const char sym = mInputData[offset];
+			switch (expected)
+			{
+			case Expected::ValueOrArrayEnd:
+				if (sym == ']')
+				{
+					closeContainer();
+					break;
+				}
+				[[fallthrough]];
+			case Expected::Value:
+			{
+				if (!openedContainers.empty())
+				{
+					if (CJsonToken& parent = mTokens[openedContainers.back()]; GetTokenChar(parent) == '[') {
+						++parent.Size;
+					}
+				}
+
+				CJsonToken token{ offset, 0, 0 };
+				if (sym == '{' || sym == '[')
+				{
+					openedContainers.push_back(static_cast<uint32_t>(mTokens.size()));
+					mTokens.push_back(token);
+					expected = sym == '{' ? Expected::KeyOrObjectEnd : Expected::ValueOrArrayEnd;
+					break;
+				}
+
+				if (sym == '"') {
+					i = ParseString(structuralIndex, i, token);
+				}
+				else if (sym == '}' || sym == ']' || sym == ':' || sym == ',') {
+					ThrowParsingError(std::string("Unexpected character '") + sym + "', expected value", offset);
+				}
+				else {
+					ParseScalar(token);
+				}
+				mTokens.push_back(token);
+				expected = openedContainers.empty() ? Expected::Nothing : Expected::CommaOrEnd;
+				break;
+			}
+			case Expected::KeyOrObjectEnd:
+				if (sym == '}')
+				{
+					closeContainer();
+					break;
+				}
+				[[fallthrough]];
+			case Expected::Key:
+			{
+				if (sym != '"') {
+					ThrowParsingError("Expected string key of object", offset);
+				}
+				++mTokens[openedContainers.back()].Size;
+				CJsonToken token{ offset, 0, 0 };
+				i = ParseString(structuralIndex, i, token);
+				mTokens.push_back(token);
+				expected = Expected::Colon;
+				break;
+			}
+			case Expected::Colon:
+				if (sym != ':') {
+					ThrowParsingError("Expected ':' after key of object", offset);
+				}
+				expected = Expected::Value;
+				break;
+			case Expected::CommaOrEnd:
+			{
+				const bool isArray = GetTokenChar(mTokens[openedContainers.back()]) == '[';
+				if (sym == ',') {
+					expected = isArray ? Expected::Value : Expected::Key;
+				}
+				else if (sym == (isArray ? ']' : '}')) {
+					closeContainer();
+				}
+				else {
+					ThrowParsingError(isArray ? "Expected ',' or ']'" : "Expected ',' or '}'", offset);
+				}
+				break;
+			}
+			case Expected::Nothing:
+				ThrowParsingError("Unexpected data after the root value", offset);
+			}
+		}
+
+		if (mTokens.empty()) {
+			throw ParsingException("Input data is empty");
+		}
+		if (expected != Expected::Nothing) {
+			ThrowParsingError("Unexpected end of data", mInputData.size());
+		}
+	}
+
+	size_t CJsonReader::ParseString(const std::vector<uint32_t>& structuralIndex, size_t index, CJsonToken& token) const
+	{
+		for (++index; index < structuralIndex.size(); ++index)
+		{
+			const uint32_t offset = structuralIndex[index];
+			const char sym = mInputData[offset];
+			if (sym == '"')
+			{
+				token.End = offset;
+				return index;
+			}
+			if (sym != '\\') {
+				ThrowParsingError("Invalid control character in string", offset);
+			}
+
+			// Validate escape sequence (the closing quote is always after it)
+			token.Size = 1;
+			switch (mInputData[offset + 1])
+			{
+			case '"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't':
+				break;
+			case 'u':
+				if (mInputData.size() - offset < 6 || !IsHexDigit(mInputData[offset + 2]) || !IsHexDigit(mInputData[offset + 3])
+					|| !IsHexDigit(mInputData[offset + 4]) || !IsHexDigit(mInputData[offset + 5]))
+				{
+					ThrowParsingError("Invalid unicode escape sequence in string", offset);
+				}
+				break;
+			default:
+				ThrowParsingError("Invalid escape sequence in string", offset);
+			}
+		}
+		ThrowParsingError("Missing closing quote of string", token.Offset);
+	}
+
+	void CJsonReader::ParseScalar(CJsonToken& token) const
+	{
+		const size_t size = mInputData.size();
+		size_t pos = token.Offset;
+		const char sym = mInputData[pos];
+		if (sym == 't' || sym == 'f' || sym == 'n')
+		{
+			const std::string_view literal = sym == 't' ? "true" : (sym == 'f' ? "false" : "null");
+			if (mInputData.compare(pos, literal.size(), literal) != 0) {
+				ThrowParsingError("Invalid value", pos);
+			}
+			pos += literal.size();
+		}
+		else
+		{
+			// Validate number: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+			if (mInputData[pos] == '-') {
+				++pos;
+			}
+			if (pos < size && mInputData[pos] == '0') {
+				++pos;
+			}
+			else if (pos < size && IsDigit(mInputData[pos])) {
+				// ReSharper disable once CppPossiblyErroneousEmptyStatements
+				for (++pos; pos < size && IsDigit(mInputData[pos]); ++pos);
+			}
+			else {
+				ThrowParsingError("Invalid value", token.Offset);
+			}
+
+			if (pos < size && mInputData[pos] == '.')
+			{
+				token.Size = 1;
+				if (++pos == size || !IsDigit(mInputData[pos])) {
+					ThrowParsingError("Invalid number, expected digit after decimal point", pos);
+				}
+				// ReSharper disable once CppPossiblyErroneousEmptyStatements
+				for (++pos; pos < size && IsDigit(mInputData[pos]); ++pos);
+			}
+
+			if (pos < size && (mInputData[pos] == 'e' || mInputData[pos] == 'E'))
+			{
+				token.Size = 1;
+				if (++pos < size && (mInputData[pos] == '+' || mInputData[pos] == '-')) {
+					++pos;
+				}
+				if (pos == size || !IsDigit(mInputData[pos])) {
+					ThrowParsingError("Invalid number, expected digit in exponent", pos);
+				}
+				// ReSharper disable once CppPossiblyErroneousEmptyStatements
+				for (++pos; pos < size && IsDigit(mInputData[pos]); ++pos);
+			}
+		}
+
+		if (pos != size && !IsScalarDelimiter(mInputData[pos])) {
+			ThrowParsingError("Invalid value", token.Offset);
+		}
+		token.End = static_cast<uint32_t>(pos);
+	}
+
+	void CJsonReader::ThrowParsingError(const std::string& message, size_t offset) const
+	{
+		const size_t line = mFirstLineNumber + static_cast<size_t>(std::count(mInputData.data(), mInputData.data() + offset, '\n'));
+		throw ParsingException(message + ", line: " + Convert::ToString(line), line, offset);
+	}
+
+	bool CJsonReader::HandleMismatchedType()
+	{
+		SkipValue();
+		if (mSerializationOptions.mismatchedTypesPolicy == MismatchedTypesPolicy::ThrowError)
+		{
+			throw SerializationException(SerializationErrorCode::MismatchedTypes,
+				"The type of target field does not match the value being loaded");
+		}
+		return false;
+	}
+
+	//------------------------------------------------------------------------------
+
+	CJsonLinesReader::CJsonLinesReader(std::string_view inputData, const SerializationOptions& serializationOptions)
+		: mRecordReader(serializationOptions)
+		, mInputData(inputData)
+	{
+		// Skip UTF-8 BOM
+		if (mInputData.size() >= sizeof(Convert::Utf8::bom) &&
+			std::equal(std::cbegin(Convert::Utf8::bom), std::cend(Convert::Utf8::bom), mInputData.cbegin()))
+		{
+			mInputData.remove_prefix(sizeof(Convert::Utf8::bom));
+		}
+	}
+
+	CJsonLinesReader::CJsonLinesReader(std::istream& inputStream, const SerializationOptions& serializationOptions)
+		: mRecordReader(serializationOptions)
+	{
+		mEncodedStreamReader.emplace(inputStream);
+	}
+
+	bool CJsonLinesReader::IsEnd()
+	{
+		return !FindNextRecord();
+	}
+
+	IJsonReader* CJsonLinesReader::ReadNextRecord()
+	{
+		if (!FindNextRecord()) {
+			throw SerializationException(SerializationErrorCode::OutOfRange, "No more items to load");
+		}
+
+		mRecordReader.Parse(mInputData.substr(mPos, mRecordEnd - mPos), mLineNumber);
+		if (mRecordEnd < mInputData.size())
+		{
+			mPos = mRecordEnd + 1;
+			++mLineNumber;
+		}
+		else {
+			mPos = mRecordEnd;
+		}
+		mRecordEnd = std::string_view::npos;
+		return &mRecordReader;
+	}
+
+	/// <summary>
+	/// Finds the next not empty line (reads the stream until the end of line), returns `false` when there are no more records.
+	/// </summary>
+	bool CJsonLinesReader::FindNextRecord()
+	{
+		if (mRecordEnd != std::string_view::npos) {
+			return true;
+		}
+
+		size_t searchPos = mPos;
+		for (;;)
+		{
+			const size_t lineEnd = mInputData.find('\n', searchPos);
+			if (lineEnd == std::string_view::npos)
+			{
+				const size_t scannedSize = mInputData.size() - mPos;
+				if (ReadNextChunk())
+				{
+					searchPos = mPos + scannedSize;
+					continue;
+				}
+			}
+
+			const size_t end = lineEnd == std::string_view::npos ? mInputData.size() : lineEnd;
+			if (const size_t dataPos = mInputData.find_first_not_of(" \t\r", mPos); dataPos < end)
+			{
+				mRecordEnd = end;
+				return true;
+			}
+			if (lineEnd == std::string_view::npos)
+			{
+				mPos = mInputData.size();
+				return false;
+			}
+			mPos = searchPos = lineEnd + 1;
+			++mLineNumber;
+		}
+	}
+
+	/// <summary>
+	/// Reads the next chunk of stream to the buffer (processed lines are removed from it).
+	/// </summary>
+	bool CJsonLinesReader::ReadNextChunk()
+	{
+		if (!mEncodedStreamReader) {
+			return false;
+		}
+
+		mStreamBuffer.erase(0, mPos);
+		mPos = 0;
+		const bool hasData = mEncodedStreamReader->ReadChunk(mStreamBuffer);
+		mInputData = mStreamBuffer;
+		return hasData;
+	}
+}
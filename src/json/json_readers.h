@@ -0,0 +1,119 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <istream>
+#include <optional>
+#include <vector>
+#include "bitserializer/json_archive.h"
+
+namespace BitSerializer::Json::Simd::Detail
+{
+	/// <summary>
+	/// Token of the validated JSON (the position of reader is the index of token).
+	/// Commas, colons and closing brackets are not stored, as the number of items in containers is known.
+	/// </summary>
+	struct CJsonToken
+	{
+		// Offset of the first character in the input data
+		uint32_t Offset;
+		// For scalars - offset of the end (for strings - closing quote), for containers - index of the next token after it
+		uint32_t End;
+		// For containers - number of items, for strings - flag of escaped characters, for numbers - flag of fraction or exponent
+		uint32_t Size;
+	};
+
+	/// <summary>
+	/// JSON reader from the continuous block of memory (UTF-8).
+	/// The input is processed in two stages:
+	///  - Building the index of structural characters, quotes and starts of scalar values by processing 64-byte blocks
+	///    (with SSE2 when available). Escaped quotes are detected via sequences of backslashes and the mask of
+	///    characters inside strings is computed via prefix XOR, like it is done in the simdjson library.
+	///  - Validation of grammar by walking through the index (it does not touch the input data except the scalar values).
+	/// Values are bound on demand: numbers are parsed and strings are unescaped only when they are requested.
+	/// </summary>
+	class CJsonReader final : public IJsonReader
+	{
+	public:
+		explicit CJsonReader(const SerializationOptions& serializationOptions);
+		CJsonReader(std::string_view inputData, const SerializationOptions& serializationOptions);
+
+		/// <summary>
+		/// Parses the new input data (the allocated memory of previous parsing is reused).
+		/// The number of first line is used only for reporting errors.
+		/// </summary>
+		void Parse(std::string_view inputData, size_t firstLineNumber = 1);
+
+		[[nodiscard]] size_t GetPosition() const noexcept override { return mPos; }
+		void SetPosition(size_t pos) noexcept override { mPos = pos; }
+		bool ReadValue(std::nullptr_t& value) override;
+		bool ReadValue(bool& value) override;
+		bool ReadValue(uint8_t& value) override;
+		bool ReadValue(uint16_t& value) override;
+		bool ReadValue(uint32_t& value) override;
+		bool ReadValue(uint64_t& value) override;
+		bool ReadValue(int8_t& value) override;
+		bool ReadValue(int16_t& value) override;
+		bool ReadValue(int32_t& value) override;
+		bool ReadValue(int64_t& value) override;
+		bool ReadValue(float& value) override;
+		bool ReadValue(double& value) override;
+		bool ReadValue(std::string_view& value) override;
+		void ReadKey(std::string_view& key) override;
+		bool ReadArraySize(size_t& arraySize) noexcept override;
+		bool ReadObjectSize(size_t& objectSize) noexcept override;
+		void SkipValue() noexcept override;
+
+	private:
+		template <typename T>
+		bool ReadNumber(T& value);
+		std::string_view ReadString(const CJsonToken& token, std::string& buffer);
+		[[nodiscard]] char GetTokenChar(const CJsonToken& token) const noexcept { return mInputData[token.Offset]; }
+		void BuildStructuralIndex(std::vector<uint32_t>& structuralIndex) const;
+		void BuildTokens(const std::vector<uint32_t>& structuralIndex);
+		size_t ParseString(const std::vector<uint32_t>& structuralIndex, size_t index, CJsonToken& token) const;
+		void ParseScalar(CJsonToken& token) const;
+		[[noreturn]] void ThrowParsingError(const std::string& message, size_t offset) const;
+		bool HandleMismatchedType();
+
+		std::string_view mInputData;
+		const SerializationOptions& mSerializationOptions;
+		size_t mFirstLineNumber = 1;
+		std::vector<uint32_t> mStructuralIndex;
+		std::vector<uint32_t> mOpenedContainers;
+		std::vector<CJsonToken> mTokens;
+		size_t mPos = 0;
+		std::string mValueBuffer;
+		std::string mKeyBuffer;
+	};
+
+	/// <summary>
+	/// JSON Lines reader from the continuous block of memory or from the stream (with decoding to UTF-8).
+	/// Records are parsed one by one (each line is a record, empty lines are skipped) by the same JSON reader.
+	/// When reading from the stream, only the current line is kept in the buffer.
+	/// </summary>
+	class CJsonLinesReader final : public IJsonLinesReader
+	{
+	public:
+		CJsonLinesReader(std::string_view inputData, const SerializationOptions& serializationOptions);
+		CJsonLinesReader(std::istream& inputStream, const SerializationOptions& serializationOptions);
+
+		[[nodiscard]] bool IsEnd() override;
+		IJsonReader* ReadNextRecord() override;
+
+	private:
+		bool FindNextRecord();
+		bool ReadNextChunk();
+
+		CJsonReader mRecordReader;
+		std::optional<Convert::CEncodedStreamReader<Convert::Utf8>> mEncodedStreamReader;
+		std::string mStreamBuffer;
+		std::string_view mInputData;
+		// Position of the current line
+		size_t mPos = 0;
+		// End of found record (`std::string_view::npos` when it is not yet searched)
+		size_t mRecordEnd = std::string_view::npos;
+		size_t mLineNumber = 1;
+	};
+}
@@ -0,0 +1,369 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include "json_writers.h"
+
+
+namespace
+{
+	using namespace BitSerializer;
+
+	constexpr size_t StreamChunkSize = 64 * 1024;
+
+	template <typename T>
+	void WriteInteger(std::string& output, T value)
+	{
+		char buf[24];
+		const auto result = std::to_chars(buf, buf + sizeof(buf), value);
+		output.append(buf, result.ptr);
+	}
+
+	/// <summary>
+	/// Writes floating point number in the shortest form which guarantees round-trip.
+	/// JSON does not support NaN and infinity, they are written as null (like in JavaScript).
+	/// </summary>
+	template <typename T>
+	void WriteFloatingPoint(std::string& output, T value)
+	{
+		if (!std::isfinite(value))
+		{
+			output.append("null");
+			return;
+		}
+
+		char buf[32];
+#if defined(__cpp_lib_to_chars)
+		const auto result = std::to_chars(buf, buf + sizeof(buf), value);
+		output.append(buf, result.ptr);
+#else
+		// Fallback for old compilers which do not support floating types in std::to_chars()
+		const int size = snprintf(buf, sizeof(buf), std::is_same_v<T, float> ? "%.9g" : "%.17g", static_cast<double>(value));
+		output.append(buf, static_cast<size_t>(size));
+#endif
+	}
+
+	bool IsCharNeedEscape(char sym) noexcept
+	{
+		return sym == '"' || sym == '\\' || static_cast<unsigned char>(sym) < 0x20;
+	}
+
+	bool IsSupportedEncoding(Convert::UtfType encoding) noexcept
+	{
+		switch (encoding)
+		{
+		case Convert::UtfType::Utf8:
+		case Convert::UtfType::Utf16le:
+		case Convert::UtfType::Utf16be:
+		case Convert::UtfType::Utf32le:
+		case Convert::UtfType::Utf32be:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	void WriteToStreamWithEncoding(const std::string_view& str, std::ostream& outputStream, Convert::UtfType encoding)
+	{
+		switch (encoding)
+		{
+		case Convert::UtfType::Utf8:
+			outputStream.write(str.data(), static_cast<std::streamsize>(str.size()));
+			break;
+		case Convert::UtfType::Utf16le:
+		{
+			std::u16string u16LeStr;
+			Convert::Utf16Le::Encode(str.cbegin(), str.cend(), u16LeStr);
+			outputStream.write(reinterpret_cast<const char*>(u16LeStr.data()),
+				static_cast<std::streamsize>(u16LeStr.size() * sizeof(std::u16string::value_type)));
+			break;
+		}
+		case Convert::UtfType::Utf16be:
+		{
+			std::u16string u16BeStr;
+			Convert::Utf16Be::Encode(str.cbegin(), str.cend(), u16BeStr);
+			outputStream.write(reinterpret_cast<const char*>(u16BeStr.data()),
+				static_cast<std::streamsize>(u16BeStr.size() * sizeof(std::u16string::value_type)));
+			break;
+		}
+		case Convert::UtfType::Utf32le:
+		{
+			std::u32string u32LeStr;
+			Convert::Utf32Le::Encode(str.cbegin(), str.cend(), u32LeStr);
+			outputStream.write(reinterpret_cast<const char*>(u32LeStr.data()),
+				static_cast<std::streamsize>(u32LeStr.size() * sizeof(std::u32string::value_type)));
+			break;
+		}
+		case Convert::UtfType::Utf32be:
+		{
+			std::u32string u32BeStr;
+			Convert::Utf32Be::Encode(str.cbegin(), str.cend(), u32BeStr);
+			outputStream.write(reinterpret_cast<const char*>(u32BeStr.data()),
+				static_cast<std::streamsize>(u32BeStr.size() * sizeof(std::u32string::value_type)));
+			break;
+		}
+		}
+	}
+}
+
+namespace BitSerializer::Json::Simd::Detail
+{
+	CJsonWriter::CJsonWriter(std::string& outputString, const FormatOptions& formatOptions, bool isJsonLines)
+		: mOutput(outputString)
+		// Records of JSON Lines can't be formatted, as each of them must be on a single line
+		, mFormatOptions(isJsonLines ? FormatOptions() : formatOptions)
+		, mIsJsonLines(isJsonLines)
+	{ }
+
+	void CJsonWriter::WriteNull()
+	{
+		PrepareValue();
+		mOutput.append("null");
+		EndValue();
+	}
+
+	void CJsonWriter::WriteBoolean(bool value)
+	{
+		PrepareValue();
+		if (value) {
+			mOutput.append("true");
+		}
+		else {
+			mOutput.append("false");
+		}
+		EndValue();
+	}
+
+	void CJsonWriter::WriteSignedInteger(int64_t value)
+	{
+		PrepareValue();
+		WriteInteger(mOutput, value);
+		EndValue();
+	}
+
+	void CJsonWriter::WriteUnsignedInteger(uint64_t value)
+	{
+		PrepareValue();
+		WriteInteger(mOutput, value);
+		EndValue();
+	}
+
+	void CJsonWriter::WriteFloat(float value)
+	{
+		PrepareValue();
+		WriteFloatingPoint(mOutput, value);
+		EndValue();
+	}
+
+	void CJsonWriter::WriteDouble(double value)
+	{
+		PrepareValue();
+		WriteFloatingPoint(mOutput, value);
+		EndValue();
+	}
+
+	void CJsonWriter::WriteString(std::string_view value)
+	{
+		PrepareValue();
+		WriteEscapedString(value);
+		EndValue();
+	}
+
+	void CJsonWriter::WriteKey(std::string_view key)
+	{
+		PrepareValue();
+		WriteEscapedString(key);
+		mOutput.push_back(':');
+		if (mFormatOptions.enableFormat) {
+			mOutput.push_back(' ');
+		}
+		mIsAfterKey = true;
+	}
+
+	void CJsonWriter::BeginArray()
+	{
+		// The root array of JSON Lines is not written (its items are records)
+		if (mIsJsonLines && mNestingLevel == 0)
+		{
+			mNestingLevel = 1;
+			return;
+		}
+		PrepareValue();
+		mOutput.push_back('[');
+		++mNestingLevel;
+		mHasItems = false;
+	}
+
+	void CJsonWriter::EndArray()
+	{
+		EndContainer(']');
+	}
+
+	void CJsonWriter::BeginObject()
+	{
+		PrepareValue();
+		mOutput.push_back('{');
+		++mNestingLevel;
+		mHasItems = false;
+	}
+
+	void CJsonWriter::EndObject()
+	{
+		EndContainer('}');
+	}
+
+	void CJsonWriter::PrepareValue()
+	{
+		if (mIsAfterKey)
+		{
+			mIsAfterKey = false;
+			return;
+		}
+		if (mNestingLevel != 0 && !IsRecordLevel())
+		{
+			if (mHasItems) {
+				mOutput.push_back(',');
+			}
+			mHasItems = true;
+			if (mFormatOptions.enableFormat) {
+				WriteNewLine();
+			}
+		}
+	}
+
+	void CJsonWriter::EndValue()
+	{
+		if (IsRecordLevel()) {
+			mOutput.push_back('\n');
+		}
+		OnValueWritten();
+	}
+
+	void CJsonWriter::EndContainer(char endSym)
+	{
+		if (IsRecordLevel())
+		{
+			mNestingLevel = 0;
+			return;
+		}
+		--mNestingLevel;
+		if (mHasItems && mFormatOptions.enableFormat) {
+			WriteNewLine();
+		}
+		mOutput.push_back(endSym);
+		// The closed container is an item of the parent one
+		mHasItems = true;
+		EndValue();
+	}
+
+	void CJsonWriter::WriteEscapedString(std::string_view value)
+	{
+		mOutput.push_back('"');
+		const char* it = value.data();
+		const char* endIt = it + value.size();
+		while (it != endIt)
+		{
+			// Append the longest part which does not require escaping
+			const char* startIt = it;
+			// ReSharper disable once CppPossiblyErroneousEmptyStatements
+			for (; it != endIt && !IsCharNeedEscape(*it); ++it);
+			mOutput.append(startIt, it);
+			if (it == endIt) {
+				break;
+			}
+
+			const char sym = *it++;
+			mOutput.push_back('\\');
+			switch (sym)
+			{
+			case '"':
+				mOutput.push_back('"');
+				break;
+			case '\\':
+				mOutput.push_back('\\');
+				break;
+			case '\b':
+				mOutput.push_back('b');
+				break;
+			case '\f':
+				mOutput.push_back('f');
+				break;
+			case '\n':
+				mOutput.push_back('n');
+				break;
+			case '\r':
+				mOutput.push_back('r');
+				break;
+			case '\t':
+				mOutput.push_back('t');
+				break;
+			default:
+			{
+				static constexpr char hexDigits[] = "0123456789ABCDEF";
+				const auto code = static_cast<unsigned char>(sym);
+				const char escaped[] = { 'u', '0', '0', hexDigits[code >> 4], hexDigits[code & 0x0F] };
+				mOutput.append(escaped, sizeof(escaped));
+				break;
+			}
+			}
+		}
+		mOutput.push_back('"');
+	}
+
+	void CJsonWriter::WriteNewLine()
+	{
+		mOutput.push_back('\n');
+		mOutput.append(mNestingLevel * mFormatOptions.paddingCharNum, mFormatOptions.paddingChar);
+	}
+
+	//------------------------------------------------------------------------------
+
+	CJsonStreamWriter::CJsonStreamWriter(std::ostream& outputStream, const FormatOptions& formatOptions, const StreamOptions& streamOptions,
+		bool isJsonLines)
+		: CJsonWriter(mStreamBuffer, formatOptions, isJsonLines)
+		, mOutputStream(outputStream)
+		, mEncoding(streamOptions.encoding)
+	{
+		if (!IsSupportedEncoding(mEncoding))
+		{
+			const auto strEncodingType = Convert::TryTo<std::string>(mEncoding);
+			throw SerializationException(SerializationErrorCode::UnsupportedEncoding,
+				"The archive does not support encoding: " +
+					(strEncodingType.has_value() ? strEncodingType.value() : std::to_string(static_cast<int>(mEncoding))));
+		}
+
+		mStreamBuffer.reserve(StreamChunkSize + StreamChunkSize / 4);
+		if (streamOptions.writeBom) {
+			Convert::WriteBom(mOutputStream, mEncoding);
+		}
+	}
+
+	void CJsonStreamWriter::Flush()
+	{
+		FlushToStream();
+		mOutputStream.flush();
+		if (!mOutputStream.good()) {
+			throw SerializationException(SerializationErrorCode::InputOutputError, "Error writing to the output stream");
+		}
+	}
+
+	void CJsonStreamWriter::OnValueWritten()
+	{
+		// The buffer is flushed only after complete values, so it can't contain partial UTF-8 sequences
+		if (mStreamBuffer.size() >= StreamChunkSize) {
+			FlushToStream();
+		}
+	}
+
+	void CJsonStreamWriter::FlushToStream()
+	{
+		if (!mStreamBuffer.empty())
+		{
+			WriteToStreamWithEncoding(mStreamBuffer, mOutputStream, mEncoding);
+			mStreamBuffer.clear();
+		}
+	}
+}
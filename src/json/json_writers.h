@@ -0,0 +1,77 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <ostream>
+#include "bitserializer/json_archive.h"
+
+namespace BitSerializer::Json::Simd::Detail
+{
+	/// <summary>
+	/// JSON writer to the string (UTF-8), supports formatting according to passed <c>FormatOptions</c>.
+	/// In the JSON Lines mode, the items of root array are written as separate records (one per line, without formatting).
+	/// </summary>
+	class CJsonWriter : public IJsonWriter
+	{
+	public:
+		CJsonWriter(std::string& outputString, const FormatOptions& formatOptions, bool isJsonLines = false);
+
+		void WriteNull() override;
+		void WriteBoolean(bool value) override;
+		void WriteSignedInteger(int64_t value) override;
+		void WriteUnsignedInteger(uint64_t value) override;
+		void WriteFloat(float value) override;
+		void WriteDouble(double value) override;
+		void WriteString(std::string_view value) override;
+		void WriteKey(std::string_view key) override;
+		void BeginArray() override;
+		void EndArray() override;
+		void BeginObject() override;
+		void EndObject() override;
+		void Flush() override { /* Not required */ }
+
+	protected:
+		void PrepareValue();
+		void EndValue();
+		void EndContainer(char endSym);
+		void WriteEscapedString(std::string_view value);
+		void WriteNewLine();
+		[[nodiscard]] bool IsRecordLevel() const noexcept { return mIsJsonLines && mNestingLevel == 1; }
+		virtual void OnValueWritten() { /* Not required for string */ }
+
+		std::string& mOutput;
+		const FormatOptions mFormatOptions;
+		const bool mIsJsonLines;
+		size_t mNestingLevel = 0;
+		bool mHasItems = false;
+		bool mIsAfterKey = false;
+	};
+
+	/// <summary>
+	/// Holds the internal buffer of stream writer (must be constructed before the base writer).
+	/// </summary>
+	struct CJsonStreamBuffer
+	{
+		std::string mStreamBuffer;
+	};
+
+	/// <summary>
+	/// JSON writer to the stream, the data is re-encoded to the target UTF encoding and written in chunks.
+	/// </summary>
+	class CJsonStreamWriter final : private CJsonStreamBuffer, public CJsonWriter
+	{
+	public:
+		CJsonStreamWriter(std::ostream& outputStream, const FormatOptions& formatOptions, const StreamOptions& streamOptions,
+			bool isJsonLines = false);
+
+		void Flush() override;
+
+	private:
+		void OnValueWritten() override;
+		void FlushToStream();
+
+		std::ostream& mOutputStream;
+		const Convert::UtfType mEncoding;
+	};
+}
@@ -0,0 +1,44 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <istream>
+#include "msgpack_readers.h"
+#include "msgpack_writers.h"
+#include "bitserializer/serialization_detail/archive_helpers.h"
+
+
+namespace BitSerializer::MsgPack::Detail
+{
+	MsgPackWriteRootScope::MsgPackWriteRootScope(std::string& outputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mMsgPackWriter(std::make_unique<CMsgPackBufferWriter<std::string>>(outputData))
+	{ }
+
+	MsgPackWriteRootScope::MsgPackWriteRootScope(std::vector<uint8_t>& outputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mMsgPackWriter(std::make_unique<CMsgPackBufferWriter<std::vector<uint8_t>>>(outputData))
+	{ }
+
+	MsgPackWriteRootScope::MsgPackWriteRootScope(std::ostream& outputStream, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mMsgPackWriter(std::make_unique<CMsgPackStreamWriter>(outputStream))
+	{ }
+
+	MsgPackReadRootScope::MsgPackReadRootScope(std::string_view inputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mMsgPackReader(std::make_unique<CMsgPackReader>(inputData, serializationContext.GetOptions()))
+	{ }
+
+	MsgPackReadRootScope::MsgPackReadRootScope(const std::vector<uint8_t>& inputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mMsgPackReader(std::make_unique<CMsgPackReader>(
+			std::string_view(reinterpret_cast<const char*>(inputData.data()), inputData.size()), serializationContext.GetOptions()))
+	{ }
+
+	MsgPackReadRootScope::MsgPackReadRootScope(std::istream& inputStream, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mStreamData(BitSerializer::Detail::ReadAllFromStream(inputStream))
+		, mMsgPackReader(std::make_unique<CMsgPackReader>(mStreamData, serializationContext.GetOptions()))
+	{ }
+}
@@ -0,0 +1,420 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <cstring>
+#include "msgpack_readers.h"
+#include "bitserializer/serialization_detail/archive_helpers.h"
+
+
+namespace
+{
+	using namespace BitSerializer;
+	using BitSerializer::Detail::CastNumber;
+
+	struct CValueHeader
+	{
+		size_t HeaderSize;
+		size_t PayloadSize;
+		// Number of nested values (for maps it includes keys and values)
+		size_t ItemsCount;
+	};
+
+	template <typename T>
+	T ReadBigEndian(const char* in) noexcept
+	{
+		T value = 0;
+		for (size_t i = 0; i < sizeof(T); ++i)
+		{
+			value = static_cast<T>((static_cast<uint64_t>(value) << 8) | static_cast<uint8_t>(in[i]));
+		}
+		return value;
+	}
+
+	size_t ReadLength(const char* in, size_t lengthSize) noexcept
+	{
+		switch (lengthSize)
+		{
+		case 1:
+			return ReadBigEndian<uint8_t>(in);
+		case 2:
+			return ReadBigEndian<uint16_t>(in);
+		default:
+			return ReadBigEndian<uint32_t>(in);
+		}
+	}
+
+	/// <summary>
+	/// Decodes the header of value at specified position.
+	/// Returns `false` when the type code is invalid or the header does not fit into the input data.
+	/// </summary>
+	bool DecodeHeader(std::string_view data, size_t pos, CValueHeader& header) noexcept
+	{
+		const auto code = static_cast<uint8_t>(data[pos]);
+		header = { 1, 0, 0 };
+
+		// Positive / negative fixint, nil and boolean
+		if (code <= 0x7F || code >= 0xE0 || code == 0xC0 || code == 0xC2 || code == 0xC3) {
+			return true;
+		}
+		// Fixmap
+		if (code <= 0x8F)
+		{
+			header.ItemsCount = static_cast<size_t>(code & 0x0F) * 2;
+			return true;
+		}
+		// Fixarray
+		if (code <= 0x9F)
+		{
+			header.ItemsCount = code & 0x0F;
+			return true;
+		}
+		// Fixstr
+		if (code <= 0xBF)
+		{
+			header.PayloadSize = code & 0x1F;
+			return true;
+		}
+
+		size_t lengthSize = 0;
+		size_t itemsPerLength = 0;
+		switch (code)
+		{
+		case 0xC4: case 0xC5: case 0xC6:	// bin 8/16/32
+			lengthSize = size_t(1) << (code - 0xC4);
+			break;
+		case 0xC7: case 0xC8: case 0xC9:	// ext 8/16/32 (length is followed by type)
+			lengthSize = size_t(1) << (code - 0xC7);
+			header.HeaderSize = 2;
+			break;
+		case 0xCA:							// float 32
+			header.PayloadSize = 4;
+			break;
+		case 0xCB:							// float 64
+			header.PayloadSize = 8;
+			break;
+		case 0xCC: case 0xCD: case 0xCE: case 0xCF:	// uint 8/16/32/64
+			header.PayloadSize = size_t(1) << (code - 0xCC);
+			break;
+		case 0xD0: case 0xD1: case 0xD2: case 0xD3:	// int 8/16/32/64
+			header.PayloadSize = size_t(1) << (code - 0xD0);
+			break;
+		case 0xD4: case 0xD5: case 0xD6: case 0xD7: case 0xD8:	// fixext 1/2/4/8/16
+			header.HeaderSize = 2;
+			header.PayloadSize = size_t(1) << (code - 0xD4);
+			break;
+		case 0xD9: case 0xDA: case 0xDB:	// str 8/16/32
+			lengthSize = size_t(1) << (code - 0xD9);
+			break;
+		case 0xDC: case 0xDD:				// array 16/32
+			lengthSize = code == 0xDC ? 2 : 4;
+			itemsPerLength = 1;
+			break;
+		case 0xDE: case 0xDF:				// map 16/32
+			lengthSize = code == 0xDE ? 2 : 4;
+			itemsPerLength = 2;
+			break;
+		default:
+			return false;
+		}
+
+		header.HeaderSize += lengthSize;
+		if (data.size() - pos < header.HeaderSize) {
+			return false;
+		}
+		if (lengthSize != 0)
+		{
+			const size_t length = ReadLength(data.data() + pos + 1, lengthSize);
+			if (itemsPerLength == 0) {
+				header.PayloadSize = length;
+			}
+			else {
+				header.ItemsCount = length * itemsPerLength;
+			}
+		}
+		return true;
+	}
+
+	bool IsStringCode(uint8_t code) noexcept
+	{
+		return (code >= 0xA0 && code <= 0xBF) || (code >= 0xD9 && code <= 0xDB) || (code >= 0xC4 && code <= 0xC6);
+	}
+}
+
+namespace BitSerializer::MsgPack::Detail
+{
+	CMsgPackReader::CMsgPackReader(std::string_view inputData, const SerializationOptions& serializationOptions)
+		: mInputData(inputData)
+		, mSerializationOptions(serializationOptions)
+	{
+		ValidateInput();
+	}
+
+	bool CMsgPackReader::ReadValue(std::nullptr_t& value)
+	{
+		if (static_cast<uint8_t>(mInputData[mPos]) == 0xC0)
+		{
+			++mPos;
+			return true;
+		}
+		return HandleMismatchedType();
+	}
+
+	bool CMsgPackReader::ReadValue(bool& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CMsgPackReader::ReadValue(std::string_view& value)
+	{
+		if (ReadString(value)) {
+			return true;
+		}
+		// Null value is excluded from MismatchedTypesPolicy processing
+		if (static_cast<uint8_t>(mInputData[mPos]) == 0xC0)
+		{
+			++mPos;
+			return false;
+		}
+		return HandleMismatchedType();
+	}
+
+	bool CMsgPackReader::ReadKey(std::string_view& key) noexcept
+	{
+		if (ReadString(key)) {
+			return true;
+		}
+		// Keys with other types are not supported
+		SkipValue();
+		return false;
+	}
+
+	bool CMsgPackReader::ReadArraySize(size_t& arraySize, bool& isBinary) noexcept
+	{
+		const auto code = static_cast<uint8_t>(mInputData[mPos]);
+		isBinary = code >= 0xC4 && code <= 0xC6;
+		if ((code >= 0x90 && code <= 0x9F) || code == 0xDC || code == 0xDD || isBinary)
+		{
+			CValueHeader header{};
+			DecodeHeader(mInputData, mPos, header);
+			mPos += header.HeaderSize;
+			arraySize = isBinary ? header.PayloadSize : header.ItemsCount;
+			return true;
+		}
+		SkipValue();
+		return false;
+	}
+
+	bool CMsgPackReader::ReadMapSize(size_t& mapSize) noexcept
+	{
+		const auto code = static_cast<uint8_t>(mInputData[mPos]);
+		if ((code >= 0x80 && code <= 0x8F) || code == 0xDE || code == 0xDF)
+		{
+			CValueHeader header{};
+			DecodeHeader(mInputData, mPos, header);
+			mPos += header.HeaderSize;
+			mapSize = header.ItemsCount / 2;
+			return true;
+		}
+		SkipValue();
+		return false;
+	}
+
+	void CMsgPackReader::ReadBinary(void* data, size_t size) noexcept
+	{
+		if (size != 0) {
+			std::memcpy(data, mInputData.data() + mPos, size);
+		}
+		mPos += size;
+	}
+
+	void CMsgPackReader::SkipValue() noexcept
+	{
+		for (size_t pendingValues = 1; pendingValues != 0; --pendingValues)
+		{
+			CValueHeader header{};
+			DecodeHeader(mInputData, mPos, header);
+			mPos += header.HeaderSize + header.PayloadSize;
+			pendingValues += header.ItemsCount;
+		}
+	}
+
+	template <typename T>
+	bool CMsgPackReader::ReadNumber(T& value)
+	{
+		const char* data = mInputData.data() + mPos;
+		const auto code = static_cast<uint8_t>(*data);
+		const auto overflowNumberPolicy = mSerializationOptions.overflowNumberPolicy;
+
+		if (code <= 0x7F)
+		{
+			++mPos;
+			return CastNumber(static_cast<uint64_t>(code), value, overflowNumberPolicy);
+		}
+		if (code >= 0xE0)
+		{
+			++mPos;
+			return CastNumber(static_cast<int64_t>(static_cast<int8_t>(code)), value, overflowNumberPolicy);
+		}
+
+		switch (code)
+		{
+		case 0xCC:
+			mPos += 2;
+			return CastNumber(static_cast<uint64_t>(ReadBigEndian<uint8_t>(data + 1)), value, overflowNumberPolicy);
+		case 0xCD:
+			mPos += 3;
+			return CastNumber(static_cast<uint64_t>(ReadBigEndian<uint16_t>(data + 1)), value, overflowNumberPolicy);
+		case 0xCE:
+			mPos += 5;
+			return CastNumber(static_cast<uint64_t>(ReadBigEndian<uint32_t>(data + 1)), value, overflowNumberPolicy);
+		case 0xCF:
+			mPos += 9;
+			return CastNumber(ReadBigEndian<uint64_t>(data + 1), value, overflowNumberPolicy);
+		case 0xD0:
+			mPos += 2;
+			return CastNumber(static_cast<int64_t>(static_cast<int8_t>(ReadBigEndian<uint8_t>(data + 1))), value, overflowNumberPolicy);
+		case 0xD1:
+			mPos += 3;
+			return CastNumber(static_cast<int64_t>(static_cast<int16_t>(ReadBigEndian<uint16_t>(data + 1))), value, overflowNumberPolicy);
+		case 0xD2:
+			mPos += 5;
+			return CastNumber(static_cast<int64_t>(static_cast<int32_t>(ReadBigEndian<uint32_t>(data + 1))), value, overflowNumberPolicy);
+		case 0xD3:
+			mPos += 9;
+			return CastNumber(static_cast<int64_t>(ReadBigEndian<uint64_t>(data + 1)), value, overflowNumberPolicy);
+		case 0xCA:
+		{
+			mPos += 5;
+			const auto bits = ReadBigEndian<uint32_t>(data + 1);
+			float floatValue;
+			std::memcpy(&floatValue, &bits, sizeof(floatValue));
+			return CastNumber(floatValue, value, overflowNumberPolicy);
+		}
+		case 0xCB:
+		{
+			mPos += 9;
+			const auto bits = ReadBigEndian<uint64_t>(data + 1);
+			double doubleValue;
+			std::memcpy(&doubleValue, &bits, sizeof(doubleValue));
+			return CastNumber(doubleValue, value, overflowNumberPolicy);
+		}
+		case 0xC2:
+		case 0xC3:
+			if constexpr (std::is_integral_v<T>)
+			{
+				++mPos;
+				return CastNumber(code == 0xC3, value, overflowNumberPolicy);
+			}
+			break;
+		case 0xC0:
+			// Null value is excluded from MismatchedTypesPolicy processing
+			++mPos;
+			return false;
+		default:
+			break;
+		}
+		return HandleMismatchedType();
+	}
+
+	bool CMsgPackReader::ReadValue(uint8_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CMsgPackReader::ReadValue(uint16_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CMsgPackReader::ReadValue(uint32_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CMsgPackReader::ReadValue(uint64_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CMsgPackReader::ReadValue(int8_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CMsgPackReader::ReadValue(int16_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CMsgPackReader::ReadValue(int32_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CMsgPackReader::ReadValue(int64_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CMsgPackReader::ReadValue(float& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CMsgPackReader::ReadValue(double& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CMsgPackReader::ReadString(std::string_view& value) noexcept
+	{
+		if (IsStringCode(static_cast<uint8_t>(mInputData[mPos])))
+		{
+			CValueHeader header{};
+			DecodeHeader(mInputData, mPos, header);
+			value = mInputData.substr(mPos + header.HeaderSize, header.PayloadSize);
+			mPos += header.HeaderSize + header.PayloadSize;
+			return true;
+		}
+		return false;
+	}
+
+	void CMsgPackReader::ValidateInput() const
+	{
+		if (mInputData.empty()) {
+			throw ParsingException("Input data is empty");
+		}
+
+		size_t pos = 0;
+		for (size_t pendingValues = 1; pendingValues != 0; --pendingValues)
+		{
+			CValueHeader header{};
+			if (pos >= mInputData.size() || !DecodeHeader(mInputData, pos, header)) {
+				throw ParsingException("Invalid or truncated MessagePack data", 0, pos);
+			}
+
+			// Each nested value takes at least one byte
+			const size_t availableSize = mInputData.size() - pos - header.HeaderSize;
+			if (header.PayloadSize > availableSize || header.ItemsCount > availableSize) {
+				throw ParsingException("Unexpected end of MessagePack data", 0, pos);
+			}
+			pos += header.HeaderSize + header.PayloadSize;
+			pendingValues += header.ItemsCount;
+		}
+		if (pos != mInputData.size()) {
+			throw ParsingException("Unexpected data after the root value", 0, pos);
+		}
+	}
+
+	bool CMsgPackReader::HandleMismatchedType()
+	{
+		SkipValue();
+		if (mSerializationOptions.mismatchedTypesPolicy == MismatchedTypesPolicy::ThrowError)
+		{
+			throw SerializationException(SerializationErrorCode::MismatchedTypes,
+				"The type of target field does not match the value being loaded");
+		}
+		return false;
+	}
+}
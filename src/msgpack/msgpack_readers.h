@@ -0,0 +1,51 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include "bitserializer/msgpack_archive.h"
+
+namespace BitSerializer::MsgPack::Detail
+{
+	/// <summary>
+	/// MessagePack reader from the continuous block of memory.
+	/// The structure of root value is validated in the constructor, so all further reads can't go out of the input data.
+	/// </summary>
+	class CMsgPackReader final : public IMsgPackReader
+	{
+	public:
+		CMsgPackReader(std::string_view inputData, const SerializationOptions& serializationOptions);
+
+		[[nodiscard]] size_t GetPosition() const noexcept override { return mPos; }
+		void SetPosition(size_t pos) noexcept override { mPos = pos; }
+		bool ReadValue(std::nullptr_t& value) override;
+		bool ReadValue(bool& value) override;
+		bool ReadValue(uint8_t& value) override;
+		bool ReadValue(uint16_t& value) override;
+		bool ReadValue(uint32_t& value) override;
+		bool ReadValue(uint64_t& value) override;
+		bool ReadValue(int8_t& value) override;
+		bool ReadValue(int16_t& value) override;
+		bool ReadValue(int32_t& value) override;
+		bool ReadValue(int64_t& value) override;
+		bool ReadValue(float& value) override;
+		bool ReadValue(double& value) override;
+		bool ReadValue(std::string_view& value) override;
+		bool ReadKey(std::string_view& key) noexcept override;
+		bool ReadArraySize(size_t& arraySize, bool& isBinary) noexcept override;
+		bool ReadMapSize(size_t& mapSize) noexcept override;
+		void ReadBinary(void* data, size_t size) noexcept override;
+		void SkipValue() noexcept override;
+
+	private:
+		template <typename T>
+		bool ReadNumber(T& value);
+		bool ReadString(std::string_view& value) noexcept;
+		void ValidateInput() const;
+		bool HandleMismatchedType();
+
+		std::string_view mInputData;
+		const SerializationOptions& mSerializationOptions;
+		size_t mPos = 0;
+	};
+}
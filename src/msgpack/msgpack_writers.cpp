@@ -0,0 +1,339 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include "msgpack_writers.h"
+
+
+namespace
+{
+	using namespace BitSerializer;
+
+	// Maximum size of header of array or map (type and 32-bit size)
+	constexpr size_t MaxContainerHeaderSize = 5;
+
+	template <typename T>
+	uint8_t* WriteBigEndian(uint8_t* out, T value) noexcept
+	{
+		for (size_t i = sizeof(T); i != 0; --i)
+		{
+			out[i - 1] = static_cast<uint8_t>(value & 0xFF);
+			if constexpr (sizeof(T) > 1) {
+				value >>= 8;
+			}
+		}
+		return out + sizeof(T);
+	}
+
+	/// <summary>
+	/// Encodes the header of array or map in the smallest possible format, returns the size of header.
+	/// </summary>
+	size_t EncodeContainerHeader(uint8_t* out, size_t size, bool isMap)
+	{
+		if (size <= 15)
+		{
+			out[0] = static_cast<uint8_t>((isMap ? 0x80 : 0x90) | size);
+			return 1;
+		}
+		if (size <= std::numeric_limits<uint16_t>::max())
+		{
+			out[0] = isMap ? 0xDE : 0xDC;
+			WriteBigEndian(out + 1, static_cast<uint16_t>(size));
+			return 3;
+		}
+		if (size <= std::numeric_limits<uint32_t>::max())
+		{
+			out[0] = isMap ? 0xDF : 0xDD;
+			WriteBigEndian(out + 1, static_cast<uint32_t>(size));
+			return 5;
+		}
+		throw SerializationException(SerializationErrorCode::OutOfRange,
+			std::string("MessagePack does not support ") + (isMap ? "maps" : "arrays") + " with size more than 2^32-1");
+	}
+}
+
+namespace BitSerializer::MsgPack::Detail
+{
+	template <class TBuffer>
+	CMsgPackBufferWriter<TBuffer>::CMsgPackBufferWriter(TBuffer& outputBuffer, std::ostream* outputStream)
+		: mBuffer(outputBuffer)
+		, mContainerWriter(outputBuffer, outputStream)
+	{ }
+
+	template <class TBuffer>
+	void CMsgPackBufferWriter<TBuffer>::WriteNil()
+	{
+		WriteByte(0xC0);
+	}
+
+	template <class TBuffer>
+	void CMsgPackBufferWriter<TBuffer>::WriteBoolean(bool value)
+	{
+		WriteByte(value ? 0xC3 : 0xC2);
+	}
+
+	template <class TBuffer>
+	void CMsgPackBufferWriter<TBuffer>::WriteSignedInteger(int64_t value)
+	{
+		if (value >= 0)
+		{
+			WriteUnsignedInteger(static_cast<uint64_t>(value));
+			return;
+		}
+
+		uint8_t data[9];
+		if (value >= -32)
+		{
+			// Negative fixint
+			WriteByte(static_cast<uint8_t>(value));
+			return;
+		}
+		if (value >= std::numeric_limits<int8_t>::min())
+		{
+			data[0] = 0xD0;
+			WriteBigEndian(data + 1, static_cast<uint8_t>(value));
+			WriteBytes(data, 2);
+		}
+		else if (value >= std::numeric_limits<int16_t>::min())
+		{
+			data[0] = 0xD1;
+			WriteBigEndian(data + 1, static_cast<uint16_t>(value));
+			WriteBytes(data, 3);
+		}
+		else if (value >= std::numeric_limits<int32_t>::min())
+		{
+			data[0] = 0xD2;
+			WriteBigEndian(data + 1, static_cast<uint32_t>(value));
+			WriteBytes(data, 5);
+		}
+		else
+		{
+			data[0] = 0xD3;
+			WriteBigEndian(data + 1, static_cast<uint64_t>(value));
+			WriteBytes(data, 9);
+		}
+	}
+
+	template <class TBuffer>
+	void CMsgPackBufferWriter<TBuffer>::WriteUnsignedInteger(uint64_t value)
+	{
+		uint8_t data[9];
+		if (value <= 0x7F)
+		{
+			// Positive fixint
+			WriteByte(static_cast<uint8_t>(value));
+			return;
+		}
+		if (value <= std::numeric_limits<uint8_t>::max())
+		{
+			data[0] = 0xCC;
+			WriteBigEndian(data + 1, static_cast<uint8_t>(value));
+			WriteBytes(data, 2);
+		}
+		else if (value <= std::numeric_limits<uint16_t>::max())
+		{
+			data[0] = 0xCD;
+			WriteBigEndian(data + 1, static_cast<uint16_t>(value));
+			WriteBytes(data, 3);
+		}
+		else if (value <= std::numeric_limits<uint32_t>::max())
+		{
+			data[0] = 0xCE;
+			WriteBigEndian(data + 1, static_cast<uint32_t>(value));
+			WriteBytes(data, 5);
+		}
+		else
+		{
+			data[0] = 0xCF;
+			WriteBigEndian(data + 1, value);
+			WriteBytes(data, 9);
+		}
+	}
+
+	template <class TBuffer>
+	void CMsgPackBufferWriter<TBuffer>::WriteFloat(float value)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		uint8_t data[5] = { 0xCA };
+		WriteBigEndian(data + 1, bits);
+		WriteBytes(data, sizeof(data));
+	}
+
+	template <class TBuffer>
+	void CMsgPackBufferWriter<TBuffer>::WriteDouble(double value)
+	{
+		// Use 32-bit float when it can be done without lost precision
+		if (std::isinf(value) || std::fabs(value) <= std::numeric_limits<float>::max())
+		{
+			if (const auto floatValue = static_cast<float>(value); static_cast<double>(floatValue) == value)
+			{
+				WriteFloat(floatValue);
+				return;
+			}
+		}
+
+		uint64_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		uint8_t data[9] = { 0xCB };
+		WriteBigEndian(data + 1, bits);
+		WriteBytes(data, sizeof(data));
+	}
+
+	template <class TBuffer>
+	void CMsgPackBufferWriter<TBuffer>::WriteString(std::string_view value)
+	{
+		const size_t size = value.size();
+		uint8_t data[5];
+		if (size <= 31)
+		{
+			WriteByte(static_cast<uint8_t>(0xA0 | size));
+		}
+		else if (size <= std::numeric_limits<uint8_t>::max())
+		{
+			data[0] = 0xD9;
+			WriteBigEndian(data + 1, static_cast<uint8_t>(size));
+			WriteBytes(data, 2);
+		}
+		else if (size <= std::numeric_limits<uint16_t>::max())
+		{
+			data[0] = 0xDA;
+			WriteBigEndian(data + 1, static_cast<uint16_t>(size));
+			WriteBytes(data, 3);
+		}
+		else if (size <= std::numeric_limits<uint32_t>::max())
+		{
+			data[0] = 0xDB;
+			WriteBigEndian(data + 1, static_cast<uint32_t>(size));
+			WriteBytes(data, 5);
+		}
+		else
+		{
+			throw SerializationException(SerializationErrorCode::OutOfRange, "MessagePack does not support strings with size more than 2^32-1");
+		}
+		WriteBytes(reinterpret_cast<const uint8_t*>(value.data()), size);
+	}
+
+	template <class TBuffer>
+	void CMsgPackBufferWriter<TBuffer>::WriteBinary(const void* data, size_t size)
+	{
+		// Replaces the just opened (empty) array
+		mContainerWriter.DiscardContainer();
+		mArraySizes.back().IsBinary = true;
+
+		uint8_t header[5];
+		if (size <= std::numeric_limits<uint8_t>::max())
+		{
+			header[0] = 0xC4;
+			WriteBigEndian(header + 1, static_cast<uint8_t>(size));
+			WriteBytes(header, 2);
+		}
+		else if (size <= std::numeric_limits<uint16_t>::max())
+		{
+			header[0] = 0xC5;
+			WriteBigEndian(header + 1, static_cast<uint16_t>(size));
+			WriteBytes(header, 3);
+		}
+		else if (size <= std::numeric_limits<uint32_t>::max())
+		{
+			header[0] = 0xC6;
+			WriteBigEndian(header + 1, static_cast<uint32_t>(size));
+			WriteBytes(header, 5);
+		}
+		else {
+			throw SerializationException(SerializationErrorCode::OutOfRange, "MessagePack does not support binary with size more than 2^32-1");
+		}
+		WriteBytes(static_cast<const uint8_t*>(data), size);
+	}
+
+	template <class TBuffer>
+	void CMsgPackBufferWriter<TBuffer>::BeginArray(size_t arraySize)
+	{
+		uint8_t data[MaxContainerHeaderSize];
+		const size_t headerSize = EncodeContainerHeader(data, arraySize, false);
+		mArraySizes.push_back({ arraySize, false });
+		mContainerWriter.BeginContainer(data, headerSize);
+	}
+
+	template <class TBuffer>
+	void CMsgPackBufferWriter<TBuffer>::EndArray(size_t actualSize) noexcept
+	{
+		const auto [declaredSize, isBinary] = mArraySizes.back();
+		mArraySizes.pop_back();
+		if (isBinary) {
+			return;
+		}
+		if (actualSize == declaredSize)
+		{
+			mContainerWriter.EndContainer();
+			return;
+		}
+
+		// The header can be replaced only when it is not yet written to the stream and has enough size
+		uint8_t data[MaxContainerHeaderSize];
+		try
+		{
+			const size_t headerSize = EncodeContainerHeader(data, actualSize, false);
+			if (mContainerWriter.EndContainer(data, headerSize)) {
+				return;
+			}
+		}
+		catch (const SerializationException&) {
+			mContainerWriter.EndContainer();
+		}
+		// Error will be thrown when finalizing
+		mHasLostHeader = true;
+	}
+
+	template <class TBuffer>
+	void CMsgPackBufferWriter<TBuffer>::BeginMap()
+	{
+		// The size of map is not known in advance, reserve the space for the largest header
+		mContainerWriter.BeginContainer(MaxContainerHeaderSize);
+	}
+
+	template <class TBuffer>
+	void CMsgPackBufferWriter<TBuffer>::EndMap(size_t actualSize) noexcept
+	{
+		uint8_t data[MaxContainerHeaderSize];
+		try
+		{
+			const size_t headerSize = EncodeContainerHeader(data, actualSize, true);
+			mContainerWriter.EndContainer(data, headerSize);
+		}
+		catch (const SerializationException&)
+		{
+			mContainerWriter.EndContainer(data, 0);
+			mHasLostHeader = true;
+		}
+	}
+
+	template <class TBuffer>
+	void CMsgPackBufferWriter<TBuffer>::Flush()
+	{
+		if (mHasLostHeader)
+		{
+			throw SerializationException(SerializationErrorCode::OutOfRange,
+				"The number of saved array items does not match to the declared size");
+		}
+		mContainerWriter.Flush();
+	}
+
+	template <class TBuffer>
+	void CMsgPackBufferWriter<TBuffer>::WriteByte(uint8_t value)
+	{
+		mBuffer.push_back(static_cast<typename TBuffer::value_type>(value));
+	}
+
+	template <class TBuffer>
+	void CMsgPackBufferWriter<TBuffer>::WriteBytes(const uint8_t* data, size_t size)
+	{
+		mBuffer.insert(mBuffer.end(), data, data + size);
+	}
+
+	template class CMsgPackBufferWriter<std::string>;
+	template class CMsgPackBufferWriter<std::vector<uint8_t>>;
+}
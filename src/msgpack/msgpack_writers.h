@@ -0,0 +1,72 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <ostream>
+#include "bitserializer/msgpack_archive.h"
+#include "bitserializer/serialization_detail/bin_container_writer.h"
+
+namespace BitSerializer::MsgPack::Detail
+{
+	/// <summary>
+	/// MessagePack writer to the buffer (<c>std::string</c> or <c>std::vector&lt;uint8_t&gt;</c>).
+	/// Numbers are written in the smallest possible encoding, headers of maps are written when the scope is closed.
+	/// </summary>
+	template <class TBuffer>
+	class CMsgPackBufferWriter : public IMsgPackWriter
+	{
+	public:
+		explicit CMsgPackBufferWriter(TBuffer& outputBuffer, std::ostream* outputStream = nullptr);
+
+		void WriteNil() override;
+		void WriteBoolean(bool value) override;
+		void WriteSignedInteger(int64_t value) override;
+		void WriteUnsignedInteger(uint64_t value) override;
+		void WriteFloat(float value) override;
+		void WriteDouble(double value) override;
+		void WriteString(std::string_view value) override;
+		void WriteBinary(const void* data, size_t size) override;
+		void BeginArray(size_t arraySize) override;
+		void EndArray(size_t actualSize) noexcept override;
+		void BeginMap() override;
+		void EndMap(size_t actualSize) noexcept override;
+		void Flush() override;
+
+	protected:
+		void WriteByte(uint8_t value);
+		void WriteBytes(const uint8_t* data, size_t size);
+
+		TBuffer& mBuffer;
+		BitSerializer::Detail::CBinContainerWriter<TBuffer> mContainerWriter;
+		struct ArrayInfo
+		{
+			size_t DeclaredSize;
+			// The array was replaced with binary
+			bool IsBinary;
+		};
+
+		std::vector<ArrayInfo> mArraySizes;
+		bool mHasLostHeader = false;
+	};
+
+	/// <summary>
+	/// Holds the internal buffer of stream writer (must be constructed before the base writer).
+	/// </summary>
+	struct CMsgPackStreamBuffer
+	{
+		std::string mStreamBuffer;
+	};
+
+	/// <summary>
+	/// MessagePack writer to the stream.
+	/// The data is written in chunks, except the parts which can be changed (headers of not yet closed maps).
+	/// </summary>
+	class CMsgPackStreamWriter final : private CMsgPackStreamBuffer, public CMsgPackBufferWriter<std::string>
+	{
+	public:
+		explicit CMsgPackStreamWriter(std::ostream& outputStream)
+			: CMsgPackBufferWriter<std::string>(mStreamBuffer, &outputStream)
+		{ }
+	};
+}
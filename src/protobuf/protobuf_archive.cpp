@@ -0,0 +1,46 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <istream>
+#include "protobuf_readers.h"
+#include "protobuf_writers.h"
+#include "bitserializer/serialization_detail/archive_helpers.h"
+
+
+namespace BitSerializer::Protobuf::Detail
+{
+	ProtobufWriteRootScope::ProtobufWriteRootScope(std::string& outputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mProtobufWriter(std::make_unique<CProtobufBufferWriter<std::string>>(outputData))
+	{ }
+
+	ProtobufWriteRootScope::ProtobufWriteRootScope(std::vector<uint8_t>& outputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mProtobufWriter(std::make_unique<CProtobufBufferWriter<std::vector<uint8_t>>>(outputData))
+	{ }
+
+	ProtobufWriteRootScope::ProtobufWriteRootScope(std::ostream& outputStream, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mProtobufWriter(std::make_unique<CProtobufStreamWriter>(outputStream))
+	{ }
+
+	ProtobufReadRootScope::ProtobufReadRootScope(std::string_view inputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mInputData(inputData)
+		, mProtobufReader(std::make_unique<CProtobufReader>(mInputData, serializationContext.GetOptions()))
+	{ }
+
+	ProtobufReadRootScope::ProtobufReadRootScope(const std::vector<uint8_t>& inputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mInputData(reinterpret_cast<const char*>(inputData.data()), inputData.size())
+		, mProtobufReader(std::make_unique<CProtobufReader>(mInputData, serializationContext.GetOptions()))
+	{ }
+
+	ProtobufReadRootScope::ProtobufReadRootScope(std::istream& inputStream, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mStreamData(BitSerializer::Detail::ReadAllFromStream(inputStream))
+		, mInputData(mStreamData)
+		, mProtobufReader(std::make_unique<CProtobufReader>(mInputData, serializationContext.GetOptions()))
+	{ }
+}
@@ -0,0 +1,292 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <cstring>
+#include <limits>
+#include "protobuf_readers.h"
+#include "bitserializer/serialization_detail/archive_helpers.h"
+
+
+namespace
+{
+	using namespace BitSerializer;
+	using namespace BitSerializer::Protobuf::Detail;
+	using BitSerializer::Detail::CastNumber;
+	using BitSerializer::Detail::ReadLittleEndian;
+
+	constexpr size_t MaxVarIntSize = 10;
+
+}
+
+namespace BitSerializer::Protobuf::Detail
+{
+	CProtobufReader::CProtobufReader(std::string_view inputData, const SerializationOptions& serializationOptions)
+		: mInputData(inputData)
+		, mSerializationOptions(serializationOptions)
+	{ }
+
+	void CProtobufReader::ReadMessage(std::string_view messageData, std::vector<CProtobufField>& fields)
+	{
+		const char* pos = messageData.data();
+		const char* endPos = pos + messageData.size();
+		while (pos != endPos)
+		{
+			CProtobufField& field = fields.emplace_back();
+			ReadField(pos, endPos, field);
+		}
+	}
+
+	void CProtobufReader::ReadPackedItem(std::string_view& packedData, WireType itemType, CProtobufField& item)
+	{
+		const char* pos = packedData.data();
+		const char* endPos = pos + packedData.size();
+		item.Type = itemType;
+		switch (itemType)
+		{
+		case WireType::Fixed32:
+		case WireType::Fixed64:
+		{
+			const size_t size = itemType == WireType::Fixed32 ? sizeof(uint32_t) : sizeof(uint64_t);
+			if (packedData.size() < size) {
+				ThrowParsingError("Unexpected end of packed repeated field", pos);
+			}
+			item.Value = ReadLittleEndian(pos, size);
+			pos += size;
+			break;
+		}
+		default:
+			if (!ReadRawVarInt(pos, endPos, item.Value)) {
+				ThrowParsingError("Invalid varint in packed repeated field", pos);
+			}
+			break;
+		}
+		packedData.remove_prefix(static_cast<size_t>(pos - packedData.data()));
+	}
+
+	bool CProtobufReader::ReadValue(const CProtobufField&, std::nullptr_t&)
+	{
+		// Any existing value does not match to null (which is represented by the absence of field)
+		return HandleMismatchedType();
+	}
+
+	bool CProtobufReader::ReadValue(const CProtobufField& field, bool& value)
+	{
+		return ReadNumber(field, value);
+	}
+
+	bool CProtobufReader::ReadValue(const CProtobufField& field, uint8_t& value)
+	{
+		return ReadNumber(field, value);
+	}
+
+	bool CProtobufReader::ReadValue(const CProtobufField& field, uint16_t& value)
+	{
+		return ReadNumber(field, value);
+	}
+
+	bool CProtobufReader::ReadValue(const CProtobufField& field, uint32_t& value)
+	{
+		return ReadNumber(field, value);
+	}
+
+	bool CProtobufReader::ReadValue(const CProtobufField& field, uint64_t& value)
+	{
+		return ReadNumber(field, value);
+	}
+
+	bool CProtobufReader::ReadValue(const CProtobufField& field, int8_t& value)
+	{
+		return ReadNumber(field, value);
+	}
+
+	bool CProtobufReader::ReadValue(const CProtobufField& field, int16_t& value)
+	{
+		return ReadNumber(field, value);
+	}
+
+	bool CProtobufReader::ReadValue(const CProtobufField& field, int32_t& value)
+	{
+		return ReadNumber(field, value);
+	}
+
+	bool CProtobufReader::ReadValue(const CProtobufField& field, int64_t& value)
+	{
+		return ReadNumber(field, value);
+	}
+
+	bool CProtobufReader::ReadValue(const CProtobufField& field, float& value)
+	{
+		return ReadNumber(field, value);
+	}
+
+	bool CProtobufReader::ReadValue(const CProtobufField& field, double& value)
+	{
+		return ReadNumber(field, value);
+	}
+
+	bool CProtobufReader::ReadValue(const CProtobufField& field, std::string_view& value)
+	{
+		if (field.Type == WireType::LengthDelimited)
+		{
+			value = field.Data;
+			return true;
+		}
+		return HandleMismatchedType();
+	}
+
+	bool CProtobufReader::ReadValue(const CProtobufField& field, CBinTimestamp& timestamp)
+	{
+		if (field.Type != WireType::LengthDelimited) {
+			return HandleMismatchedType();
+		}
+
+		// Message with the same layout as "google.protobuf.Timestamp" (unknown fields are skipped)
+		CBinTimestamp result;
+		const char* pos = field.Data.data();
+		const char* endPos = pos + field.Data.size();
+		while (pos != endPos)
+		{
+			CProtobufField timestampField;
+			ReadField(pos, endPos, timestampField);
+			if (timestampField.Type == WireType::VarInt)
+			{
+				if (timestampField.Number == 1) {
+					result.Seconds = static_cast<int64_t>(timestampField.Value);
+				}
+				else if (timestampField.Number == 2) {
+					result.Nanoseconds = static_cast<int32_t>(timestampField.Value);
+				}
+			}
+		}
+		timestamp = result;
+		return true;
+	}
+
+	void CProtobufReader::ReadField(const char*& pos, const char* endPos, CProtobufField& field) const
+	{
+		const char* fieldPos = pos;
+		uint64_t tag;
+		if (!ReadRawVarInt(pos, endPos, tag)) {
+			ThrowParsingError("Invalid tag of field", fieldPos);
+		}
+		const uint64_t fieldNumber = tag >> 3;
+		if (fieldNumber == 0 || fieldNumber > std::numeric_limits<uint32_t>::max() >> 3) {
+			ThrowParsingError("Invalid number of field", fieldPos);
+		}
+		field.Number = static_cast<uint32_t>(fieldNumber);
+		field.Type = static_cast<WireType>(tag & 0x07);
+
+		switch (field.Type)
+		{
+		case WireType::VarInt:
+			if (!ReadRawVarInt(pos, endPos, field.Value)) {
+				ThrowParsingError("Invalid varint value", fieldPos);
+			}
+			break;
+		case WireType::Fixed32:
+		case WireType::Fixed64:
+		{
+			const size_t size = field.Type == WireType::Fixed32 ? sizeof(uint32_t) : sizeof(uint64_t);
+			if (static_cast<size_t>(endPos - pos) < size) {
+				ThrowParsingError("Unexpected end of data", fieldPos);
+			}
+			field.Value = ReadLittleEndian(pos, size);
+			pos += size;
+			break;
+		}
+		case WireType::LengthDelimited:
+		{
+			uint64_t length;
+			if (!ReadRawVarInt(pos, endPos, length) || length > static_cast<uint64_t>(endPos - pos)) {
+				ThrowParsingError("Invalid length of field", fieldPos);
+			}
+			field.Data = std::string_view(pos, static_cast<size_t>(length));
+			pos += length;
+			break;
+		}
+		default:
+			ThrowParsingError("Unsupported wire type (groups are deprecated and not supported)", fieldPos);
+		}
+	}
+
+	bool CProtobufReader::ReadRawVarInt(const char*& pos, const char* endPos, uint64_t& value) const noexcept
+	{
+		value = 0;
+		const char* startPos = pos;
+		for (size_t i = 0; i < MaxVarIntSize && pos != endPos; ++i)
+		{
+			const auto byte = static_cast<uint8_t>(*pos++);
+			value |= static_cast<uint64_t>(byte & 0x7F) << (i * 7);
+			if ((byte & 0x80) == 0) {
+				return true;
+			}
+		}
+		pos = startPos;
+		return false;
+	}
+
+	template <typename T>
+	bool CProtobufReader::ReadNumber(const CProtobufField& field, T& value)
+	{
+		const auto overflowNumberPolicy = mSerializationOptions.overflowNumberPolicy;
+		switch (field.Type)
+		{
+		case WireType::VarInt:
+			if constexpr (std::is_same_v<T, bool> || std::is_unsigned_v<T>) {
+				return CastNumber(field.Value, value, overflowNumberPolicy);
+			}
+			else if constexpr (std::is_integral_v<T>) {
+				return CastNumber(ZigZagDecode(field.Value), value, overflowNumberPolicy);
+			}
+			break;
+		case WireType::Fixed32:
+			if constexpr (std::is_floating_point_v<T>)
+			{
+				float floatValue;
+				const auto bits = static_cast<uint32_t>(field.Value);
+				std::memcpy(&floatValue, &bits, sizeof(floatValue));
+				return CastNumber(floatValue, value, overflowNumberPolicy);
+			}
+			else if constexpr (std::is_signed_v<T>) {
+				// The "sfixed32" type
+				return CastNumber(static_cast<int32_t>(field.Value), value, overflowNumberPolicy);
+			}
+			else {
+				return CastNumber(static_cast<uint32_t>(field.Value), value, overflowNumberPolicy);
+			}
+		case WireType::Fixed64:
+			if constexpr (std::is_floating_point_v<T>)
+			{
+				double doubleValue;
+				std::memcpy(&doubleValue, &field.Value, sizeof(doubleValue));
+				return CastNumber(doubleValue, value, overflowNumberPolicy);
+			}
+			else if constexpr (std::is_signed_v<T>) {
+				// The "sfixed64" type
+				return CastNumber(static_cast<int64_t>(field.Value), value, overflowNumberPolicy);
+			}
+			else {
+				return CastNumber(field.Value, value, overflowNumberPolicy);
+			}
+		default:
+			break;
+		}
+		return HandleMismatchedType();
+	}
+
+	bool CProtobufReader::HandleMismatchedType() const
+	{
+		if (mSerializationOptions.mismatchedTypesPolicy == MismatchedTypesPolicy::ThrowError)
+		{
+			throw SerializationException(SerializationErrorCode::MismatchedTypes,
+				"The type of target field does not match the value being loaded");
+		}
+		return false;
+	}
+
+	void CProtobufReader::ThrowParsingError(const std::string& message, const char* pos) const
+	{
+		throw ParsingException(message, 0, static_cast<size_t>(pos - mInputData.data()));
+	}
+}
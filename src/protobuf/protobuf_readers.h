@@ -0,0 +1,49 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include "bitserializer/protobuf_archive.h"
+
+namespace BitSerializer::Protobuf::Detail
+{
+	/// <summary>
+	/// Protobuf reader from the continuous block of memory.
+	/// The wire format does not contain types of length-delimited fields (strings, embedded messages and packed repeated fields
+	/// are the same), so messages are parsed when they are opened, with validation of their fields.
+	/// Strings are returned as views to the input data.
+	/// </summary>
+	class CProtobufReader final : public IProtobufReader
+	{
+	public:
+		CProtobufReader(std::string_view inputData, const SerializationOptions& serializationOptions);
+
+		void ReadMessage(std::string_view messageData, std::vector<CProtobufField>& fields) override;
+		void ReadPackedItem(std::string_view& packedData, WireType itemType, CProtobufField& item) override;
+		bool ReadValue(const CProtobufField& field, std::nullptr_t& value) override;
+		bool ReadValue(const CProtobufField& field, bool& value) override;
+		bool ReadValue(const CProtobufField& field, uint8_t& value) override;
+		bool ReadValue(const CProtobufField& field, uint16_t& value) override;
+		bool ReadValue(const CProtobufField& field, uint32_t& value) override;
+		bool ReadValue(const CProtobufField& field, uint64_t& value) override;
+		bool ReadValue(const CProtobufField& field, int8_t& value) override;
+		bool ReadValue(const CProtobufField& field, int16_t& value) override;
+		bool ReadValue(const CProtobufField& field, int32_t& value) override;
+		bool ReadValue(const CProtobufField& field, int64_t& value) override;
+		bool ReadValue(const CProtobufField& field, float& value) override;
+		bool ReadValue(const CProtobufField& field, double& value) override;
+		bool ReadValue(const CProtobufField& field, std::string_view& value) override;
+		bool ReadValue(const CProtobufField& field, CBinTimestamp& timestamp) override;
+
+	private:
+		void ReadField(const char*& pos, const char* endPos, CProtobufField& field) const;
+		bool ReadRawVarInt(const char*& pos, const char* endPos, uint64_t& value) const noexcept;
+		template <typename T>
+		bool ReadNumber(const CProtobufField& field, T& value);
+		bool HandleMismatchedType() const;
+		[[noreturn]] void ThrowParsingError(const std::string& message, const char* pos) const;
+
+		std::string_view mInputData;
+		const SerializationOptions& mSerializationOptions;
+	};
+}
@@ -0,0 +1,263 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <cstring>
+#include "protobuf_writers.h"
+
+
+namespace
+{
+	using namespace BitSerializer;
+	using namespace BitSerializer::Protobuf::Detail;
+
+	constexpr uint32_t MaxFieldNumber = (1u << 29) - 1;
+	constexpr size_t MaxVarIntSize = 10;
+
+	size_t GetVarIntSize(uint64_t value) noexcept
+	{
+		size_t size = 1;
+		for (; value >= 0x80; value >>= 7) {
+			++size;
+		}
+		return size;
+	}
+
+	char* EncodeVarInt(char* pos, uint64_t value) noexcept
+	{
+		for (; value >= 0x80; value >>= 7) {
+			*pos++ = static_cast<char>((value & 0x7F) | 0x80);
+		}
+		*pos++ = static_cast<char>(value);
+		return pos;
+	}
+
+	bool IsLittleEndian() noexcept
+	{
+		constexpr uint16_t value = 1;
+		uint8_t firstByte;
+		std::memcpy(&firstByte, &value, sizeof(firstByte));
+		return firstByte == 1;
+	}
+
+	/// <summary>
+	/// Converts the item of block to the value of varint (signed integers are ZigZag encoded).
+	/// </summary>
+	template <typename T>
+	uint64_t ToVarInt(T value) noexcept
+	{
+		if constexpr (std::is_signed_v<T>) {
+			return ZigZagEncode(static_cast<int64_t>(value));
+		}
+		else {
+			return static_cast<uint64_t>(value);
+		}
+	}
+}
+
+namespace BitSerializer::Protobuf::Detail
+{
+	template <class TBuffer>
+	CProtobufBufferWriter<TBuffer>::CProtobufBufferWriter(TBuffer& outputBuffer, std::ostream* outputStream)
+		: mBuffer(outputBuffer)
+		, mContainerWriter(outputBuffer, outputStream)
+	{ }
+
+	template <class TBuffer>
+	void CProtobufBufferWriter<TBuffer>::WriteVarInt(uint32_t fieldNumber, uint64_t value)
+	{
+		WriteTag(fieldNumber, WireType::VarInt);
+		WriteRawVarInt(value);
+	}
+
+	template <class TBuffer>
+	void CProtobufBufferWriter<TBuffer>::WriteFixed32(uint32_t fieldNumber, uint32_t value)
+	{
+		WriteTag(fieldNumber, WireType::Fixed32);
+		WriteRawLittleEndian(value, sizeof(value));
+	}
+
+	template <class TBuffer>
+	void CProtobufBufferWriter<TBuffer>::WriteFixed64(uint32_t fieldNumber, uint64_t value)
+	{
+		WriteTag(fieldNumber, WireType::Fixed64);
+		WriteRawLittleEndian(value, sizeof(value));
+	}
+
+	template <class TBuffer>
+	void CProtobufBufferWriter<TBuffer>::WriteBytes(uint32_t fieldNumber, std::string_view value)
+	{
+		WriteTag(fieldNumber, WireType::LengthDelimited);
+		WriteRawVarInt(value.size());
+		mBuffer.insert(mBuffer.end(), value.cbegin(), value.cend());
+	}
+
+	template <class TBuffer>
+	void CProtobufBufferWriter<TBuffer>::WriteTimestamp(uint32_t fieldNumber, const CBinTimestamp& timestamp)
+	{
+		// Message with the same layout as "google.protobuf.Timestamp" (seconds and nanos are not ZigZag encoded, zeros are omitted)
+		const auto seconds = static_cast<uint64_t>(timestamp.Seconds);
+		const auto nanoseconds = static_cast<uint64_t>(static_cast<int64_t>(timestamp.Nanoseconds));
+		const size_t size = (seconds != 0 ? 1 + GetVarIntSize(seconds) : 0) + (nanoseconds != 0 ? 1 + GetVarIntSize(nanoseconds) : 0);
+
+		WriteTag(fieldNumber, WireType::LengthDelimited);
+		WriteRawVarInt(size);
+		if (seconds != 0) {
+			WriteVarInt(1, seconds);
+		}
+		if (nanoseconds != 0) {
+			WriteVarInt(2, nanoseconds);
+		}
+	}
+
+	template <class TBuffer>
+	void CProtobufBufferWriter<TBuffer>::WritePackedBlock(uint32_t fieldNumber, ProtobufNumberType itemType, const void* data, size_t size)
+	{
+		switch (itemType)
+		{
+		case ProtobufNumberType::Int8:
+			WritePackedVarInts(fieldNumber, static_cast<const int8_t*>(data), size);
+			break;
+		case ProtobufNumberType::UInt8:
+			WritePackedVarInts(fieldNumber, static_cast<const uint8_t*>(data), size);
+			break;
+		case ProtobufNumberType::Int16:
+			WritePackedVarInts(fieldNumber, static_cast<const int16_t*>(data), size);
+			break;
+		case ProtobufNumberType::UInt16:
+			WritePackedVarInts(fieldNumber, static_cast<const uint16_t*>(data), size);
+			break;
+		case ProtobufNumberType::Int32:
+			WritePackedVarInts(fieldNumber, static_cast<const int32_t*>(data), size);
+			break;
+		case ProtobufNumberType::UInt32:
+			WritePackedVarInts(fieldNumber, static_cast<const uint32_t*>(data), size);
+			break;
+		case ProtobufNumberType::Int64:
+			WritePackedVarInts(fieldNumber, static_cast<const int64_t*>(data), size);
+			break;
+		case ProtobufNumberType::UInt64:
+			WritePackedVarInts(fieldNumber, static_cast<const uint64_t*>(data), size);
+			break;
+		case ProtobufNumberType::Float:
+			WritePackedFixed(fieldNumber, static_cast<const float*>(data), size);
+			break;
+		case ProtobufNumberType::Double:
+			WritePackedFixed(fieldNumber, static_cast<const double*>(data), size);
+			break;
+		}
+	}
+
+	template <class TBuffer>
+	void CProtobufBufferWriter<TBuffer>::WritePackedItem(WireType itemType, uint64_t value)
+	{
+		switch (itemType)
+		{
+		case WireType::Fixed32:
+			WriteRawLittleEndian(value, sizeof(uint32_t));
+			break;
+		case WireType::Fixed64:
+			WriteRawLittleEndian(value, sizeof(uint64_t));
+			break;
+		default:
+			WriteRawVarInt(value);
+			break;
+		}
+	}
+
+	template <class TBuffer>
+	void CProtobufBufferWriter<TBuffer>::BeginLengthDelimited(uint32_t fieldNumber)
+	{
+		WriteTag(fieldNumber, WireType::LengthDelimited);
+		// The length is not known in advance, reserve the space for the longest varint
+		mContainerWriter.BeginContainer(MaxVarIntSize);
+	}
+
+	template <class TBuffer>
+	void CProtobufBufferWriter<TBuffer>::EndLengthDelimited()
+	{
+		char data[MaxVarIntSize];
+		const size_t lengthSize = static_cast<size_t>(EncodeVarInt(data, mContainerWriter.GetContentSize()) - data);
+		mContainerWriter.EndContainer(reinterpret_cast<const uint8_t*>(data), lengthSize);
+	}
+
+	template <class TBuffer>
+	void CProtobufBufferWriter<TBuffer>::Flush()
+	{
+		mContainerWriter.Flush();
+	}
+
+	template <class TBuffer>
+	void CProtobufBufferWriter<TBuffer>::WriteTag(uint32_t fieldNumber, WireType wireType)
+	{
+		if (fieldNumber == 0 || fieldNumber > MaxFieldNumber)
+		{
+			throw SerializationException(SerializationErrorCode::OutOfRange,
+				"Invalid number of field: " + Convert::ToString(fieldNumber) + " (allowed range is 1..536870911)");
+		}
+		WriteRawVarInt(static_cast<uint64_t>(fieldNumber) << 3 | static_cast<uint64_t>(wireType));
+	}
+
+	template <class TBuffer>
+	void CProtobufBufferWriter<TBuffer>::WriteRawVarInt(uint64_t value)
+	{
+		for (; value >= 0x80; value >>= 7) {
+			mBuffer.push_back(static_cast<typename TBuffer::value_type>((value & 0x7F) | 0x80));
+		}
+		mBuffer.push_back(static_cast<typename TBuffer::value_type>(value));
+	}
+
+	template <class TBuffer>
+	void CProtobufBufferWriter<TBuffer>::WriteRawLittleEndian(uint64_t value, size_t size)
+	{
+		for (size_t i = 0; i < size; ++i, value >>= 8) {
+			mBuffer.push_back(static_cast<typename TBuffer::value_type>(value & 0xFF));
+		}
+	}
+
+	template <class TBuffer>
+	template <typename T>
+	void CProtobufBufferWriter<TBuffer>::WritePackedVarInts(uint32_t fieldNumber, const T* data, size_t size)
+	{
+		// The length of field is calculated before writing, so items are encoded directly to the output buffer
+		size_t length = 0;
+		for (size_t i = 0; i < size; ++i) {
+			length += GetVarIntSize(ToVarInt(data[i]));
+		}
+
+		WriteTag(fieldNumber, WireType::LengthDelimited);
+		WriteRawVarInt(length);
+		const size_t startPos = mBuffer.size();
+		mBuffer.resize(startPos + length);
+		char* pos = reinterpret_cast<char*>(mBuffer.data()) + startPos;
+		for (size_t i = 0; i < size; ++i) {
+			pos = EncodeVarInt(pos, ToVarInt(data[i]));
+		}
+	}
+
+	template <class TBuffer>
+	template <typename T>
+	void CProtobufBufferWriter<TBuffer>::WritePackedFixed(uint32_t fieldNumber, const T* data, size_t size)
+	{
+		WriteTag(fieldNumber, WireType::LengthDelimited);
+		WriteRawVarInt(size * sizeof(T));
+		if (IsLittleEndian())
+		{
+			// Memory layout is the same as in the Protobuf wire format
+			const auto* bytes = reinterpret_cast<const typename TBuffer::value_type*>(data);
+			mBuffer.insert(mBuffer.end(), bytes, bytes + size * sizeof(T));
+		}
+		else
+		{
+			for (size_t i = 0; i < size; ++i)
+			{
+				std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t> bits;
+				std::memcpy(&bits, data + i, sizeof(bits));
+				WriteRawLittleEndian(bits, sizeof(bits));
+			}
+		}
+	}
+
+	template class CProtobufBufferWriter<std::string>;
+	template class CProtobufBufferWriter<std::vector<uint8_t>>;
+}
@@ -0,0 +1,66 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <ostream>
+#include "bitserializer/protobuf_archive.h"
+#include "bitserializer/serialization_detail/bin_container_writer.h"
+
+namespace BitSerializer::Protobuf::Detail
+{
+	/// <summary>
+	/// Protobuf writer to the buffer (<c>std::string</c> or <c>std::vector&lt;uint8_t&gt;</c>).
+	/// The length of embedded messages is unknown until they are closed, so the space for the longest varint is reserved
+	/// for it, unused bytes are skipped without shifting the content.
+	/// </summary>
+	template <class TBuffer>
+	class CProtobufBufferWriter : public IProtobufWriter
+	{
+	public:
+		explicit CProtobufBufferWriter(TBuffer& outputBuffer, std::ostream* outputStream = nullptr);
+
+		void WriteVarInt(uint32_t fieldNumber, uint64_t value) override;
+		void WriteFixed32(uint32_t fieldNumber, uint32_t value) override;
+		void WriteFixed64(uint32_t fieldNumber, uint64_t value) override;
+		void WriteBytes(uint32_t fieldNumber, std::string_view value) override;
+		void WriteTimestamp(uint32_t fieldNumber, const CBinTimestamp& timestamp) override;
+		void WritePackedBlock(uint32_t fieldNumber, ProtobufNumberType itemType, const void* data, size_t size) override;
+		void WritePackedItem(WireType itemType, uint64_t value) override;
+		void BeginLengthDelimited(uint32_t fieldNumber) override;
+		void EndLengthDelimited() override;
+		void Flush() override;
+
+	protected:
+		void WriteTag(uint32_t fieldNumber, WireType wireType);
+		void WriteRawVarInt(uint64_t value);
+		void WriteRawLittleEndian(uint64_t value, size_t size);
+		template <typename T>
+		void WritePackedVarInts(uint32_t fieldNumber, const T* data, size_t size);
+		template <typename T>
+		void WritePackedFixed(uint32_t fieldNumber, const T* data, size_t size);
+
+		TBuffer& mBuffer;
+		BitSerializer::Detail::CBinContainerWriter<TBuffer> mContainerWriter;
+	};
+
+	/// <summary>
+	/// Holds the internal buffer of stream writer (must be constructed before the base writer).
+	/// </summary>
+	struct CProtobufStreamBuffer
+	{
+		std::string mStreamBuffer;
+	};
+
+	/// <summary>
+	/// Protobuf writer to the stream.
+	/// The data is written in chunks, except the parts which can be changed (lengths of not yet closed embedded messages).
+	/// </summary>
+	class CProtobufStreamWriter final : private CProtobufStreamBuffer, public CProtobufBufferWriter<std::string>
+	{
+	public:
+		explicit CProtobufStreamWriter(std::ostream& outputStream)
+			: CProtobufBufferWriter<std::string>(mStreamBuffer, &outputStream)
+		{ }
+	};
+}
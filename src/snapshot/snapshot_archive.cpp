@@ -0,0 +1,47 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <istream>
+#include "snapshot_readers.h"
+#include "snapshot_writers.h"
+#include "bitserializer/serialization_detail/archive_helpers.h"
+
+
+namespace BitSerializer::Snapshot::Detail
+{
+	SnapshotWriteRootScope::SnapshotWriteRootScope(std::string& outputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mSnapshotWriter(std::make_unique<CSnapshotBufferWriter<std::string>>(
+			outputData, serializationContext.GetOptions().schemaFingerprint))
+	{ }
+
+	SnapshotWriteRootScope::SnapshotWriteRootScope(std::vector<uint8_t>& outputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mSnapshotWriter(std::make_unique<CSnapshotBufferWriter<std::vector<uint8_t>>>(
+			outputData, serializationContext.GetOptions().schemaFingerprint))
+	{ }
+
+	SnapshotWriteRootScope::SnapshotWriteRootScope(std::ostream& outputStream, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Save>(serializationContext)
+		, mSnapshotWriter(std::make_unique<CSnapshotStreamWriter>(
+			outputStream, serializationContext.GetOptions().schemaFingerprint))
+	{ }
+
+	SnapshotReadRootScope::SnapshotReadRootScope(std::string_view inputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mSnapshotReader(std::make_unique<CSnapshotReader>(inputData, serializationContext.GetOptions()))
+	{ }
+
+	SnapshotReadRootScope::SnapshotReadRootScope(const std::vector<uint8_t>& inputData, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mSnapshotReader(std::make_unique<CSnapshotReader>(
+			std::string_view(reinterpret_cast<const char*>(inputData.data()), inputData.size()), serializationContext.GetOptions()))
+	{ }
+
+	SnapshotReadRootScope::SnapshotReadRootScope(std::istream& inputStream, SerializationContext& serializationContext)
+		: TArchiveScope<SerializeMode::Load>(serializationContext)
+		, mStreamData(BitSerializer::Detail::ReadAllFromStream(inputStream))
+		, mSnapshotReader(std::make_unique<CSnapshotReader>(mStreamData, serializationContext.GetOptions()))
+	{ }
+}
@@ -0,0 +1,68 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "bitserializer/snapshot_archive.h"
+
+/// <summary>
+/// Layout of the snapshot (all values are stored in the native byte order):
+///  - Header (32 bytes): signature "BSSN", version (uint16), reserved (uint16), byte order mark (uint32), reserved (uint32),
+///    schema fingerprint (uint64), size of payload (uint64).
+///  - Root value, each value starts with the type code (one byte), the payload is aligned to its natural boundary
+///    relative to the start of snapshot:
+///    - Numbers: aligned to the size of type.
+///    - String: aligned to 8 bytes - length (uint64) and characters.
+///    - Timestamp: aligned to 8 bytes - seconds (int64) and nanoseconds (int32).
+///    - Array: aligned to 8 bytes - number of items (uint64), size of items in bytes (uint64) and items.
+///    - Map: aligned to 8 bytes - number of items (uint64), size of items in bytes (uint64) and pairs of keys and values,
+///      where keys are stored without type code (aligned to 8 bytes - length (uint64) and characters).
+///    - Block: type of items (one byte), aligned to 8 bytes - number of items (uint64) and items without type codes.
+/// </summary>
+namespace BitSerializer::Snapshot::Detail
+{
+	constexpr char Signature[4] = { 'B', 'S', 'S', 'N' };
+	constexpr uint16_t FormatVersion = 1;
+	constexpr uint32_t ByteOrderMark = 0x01020304;
+	constexpr size_t HeaderSize = 32;
+
+	constexpr size_t VersionOffset = 4;
+	constexpr size_t ByteOrderMarkOffset = 8;
+	constexpr size_t FingerprintOffset = 16;
+	constexpr size_t PayloadSizeOffset = 24;
+
+	constexpr size_t TimestampSize = 12;
+
+	/// <summary>
+	/// Returns the size of number with passed type (or zero when it is not a number).
+	/// </summary>
+	constexpr size_t GetNumberSize(SnapshotType type) noexcept
+	{
+		switch (type)
+		{
+		case SnapshotType::Int8:
+		case SnapshotType::UInt8:
+			return 1;
+		case SnapshotType::Int16:
+		case SnapshotType::UInt16:
+			return 2;
+		case SnapshotType::Int32:
+		case SnapshotType::UInt32:
+		case SnapshotType::Float:
+			return 4;
+		case SnapshotType::Int64:
+		case SnapshotType::UInt64:
+		case SnapshotType::Double:
+			return 8;
+		default:
+			return 0;
+		}
+	}
+
+	constexpr size_t AlignPosition(size_t pos, size_t alignment) noexcept
+	{
+		return (pos + alignment - 1) & ~(alignment - 1);
+	}
+}
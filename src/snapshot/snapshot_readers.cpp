@@ -0,0 +1,470 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <cstring>
+#include "snapshot_readers.h"
+#include "bitserializer/serialization_detail/archive_helpers.h"
+
+
+namespace
+{
+	using namespace BitSerializer;
+	using namespace BitSerializer::Snapshot::Detail;
+	using BitSerializer::Detail::CastNumber;
+
+	struct CContainerInfo
+	{
+		size_t EndPos;
+		uint64_t PendingItems;
+		bool IsMap;
+	};
+
+	/// <summary>
+	/// Reads the aligned 64-bit number (used for sizes), returns `false` when it does not fit into the limit.
+	/// </summary>
+	bool ReadSize(std::string_view data, size_t& pos, size_t limit, uint64_t& value) noexcept
+	{
+		const size_t alignedPos = AlignPosition(pos, 8);
+		if (alignedPos > limit || limit - alignedPos < sizeof(value)) {
+			return false;
+		}
+		std::memcpy(&value, data.data() + alignedPos, sizeof(value));
+		pos = alignedPos + sizeof(value);
+		return true;
+	}
+}
+
+namespace BitSerializer::Snapshot::Detail
+{
+	CSnapshotReader::CSnapshotReader(std::string_view inputData, const SerializationOptions& serializationOptions)
+		: mInputData(inputData)
+		, mSerializationOptions(serializationOptions)
+	{
+		ValidateHeader();
+		ValidateInput();
+	}
+
+	bool CSnapshotReader::ReadValue(std::nullptr_t&)
+	{
+		const size_t valuePos = mPos;
+		if (ReadType() == SnapshotType::Null) {
+			return true;
+		}
+		return HandleMismatchedType(valuePos);
+	}
+
+	bool CSnapshotReader::ReadValue(bool& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CSnapshotReader::ReadValue(uint8_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CSnapshotReader::ReadValue(uint16_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CSnapshotReader::ReadValue(uint32_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CSnapshotReader::ReadValue(uint64_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CSnapshotReader::ReadValue(int8_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CSnapshotReader::ReadValue(int16_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CSnapshotReader::ReadValue(int32_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CSnapshotReader::ReadValue(int64_t& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CSnapshotReader::ReadValue(float& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CSnapshotReader::ReadValue(double& value)
+	{
+		return ReadNumber(value);
+	}
+
+	bool CSnapshotReader::ReadValue(std::string_view& value)
+	{
+		const size_t valuePos = mPos;
+		switch (ReadType())
+		{
+		case SnapshotType::String:
+			ReadKey(value);
+			return true;
+		case SnapshotType::Null:
+			// Null value is excluded from MismatchedTypesPolicy processing
+			return false;
+		default:
+			return HandleMismatchedType(valuePos);
+		}
+	}
+
+	bool CSnapshotReader::ReadValue(CBinTimestamp& timestamp)
+	{
+		const size_t valuePos = mPos;
+		switch (ReadType())
+		{
+		case SnapshotType::Timestamp:
+			timestamp.Seconds = ReadRaw<int64_t>();
+			timestamp.Nanoseconds = ReadRaw<int32_t>();
+			return true;
+		case SnapshotType::Null:
+			// Null value is excluded from MismatchedTypesPolicy processing
+			return false;
+		default:
+			return HandleMismatchedType(valuePos);
+		}
+	}
+
+	void CSnapshotReader::ReadKey(std::string_view& key) noexcept
+	{
+		const auto size = static_cast<size_t>(ReadRaw<uint64_t>());
+		key = mInputData.substr(mPos, size);
+		mPos += size;
+	}
+
+	bool CSnapshotReader::ReadArraySize(size_t& arraySize, size_t& endPos) noexcept
+	{
+		const size_t valuePos = mPos;
+		switch (ReadType())
+		{
+		case SnapshotType::Array:
+			arraySize = static_cast<size_t>(ReadRaw<uint64_t>());
+			endPos = static_cast<size_t>(ReadRaw<uint64_t>()) + mPos;
+			return true;
+		case SnapshotType::Block:
+		{
+			const auto itemType = static_cast<SnapshotType>(mInputData[mPos++]);
+			arraySize = static_cast<size_t>(ReadRaw<uint64_t>());
+			endPos = mPos + arraySize * GetNumberSize(itemType);
+			mBlockItemType = itemType;
+			return true;
+		}
+		default:
+			mPos = valuePos;
+			SkipValue();
+			return false;
+		}
+	}
+
+	bool CSnapshotReader::ReadMapSize(size_t& mapSize, size_t& endPos) noexcept
+	{
+		const size_t valuePos = mPos;
+		if (ReadType() == SnapshotType::Map)
+		{
+			mapSize = static_cast<size_t>(ReadRaw<uint64_t>());
+			endPos = static_cast<size_t>(ReadRaw<uint64_t>()) + mPos;
+			return true;
+		}
+		mPos = valuePos;
+		SkipValue();
+		return false;
+	}
+
+	bool CSnapshotReader::ReadBlock(SnapshotType itemType, void* data, size_t size) noexcept
+	{
+		if (mBlockItemType != itemType) {
+			return false;
+		}
+		const size_t blockSize = size * GetNumberSize(itemType);
+		if (blockSize != 0) {
+			std::memcpy(data, mInputData.data() + mPos, blockSize);
+		}
+		mPos += blockSize;
+		return true;
+	}
+
+	void CSnapshotReader::EndArray(size_t endPos) noexcept
+	{
+		mPos = endPos;
+		mBlockItemType = SnapshotType::Null;
+	}
+
+	void CSnapshotReader::SkipValue() noexcept
+	{
+		const auto type = ReadType();
+		if (const size_t numberSize = GetNumberSize(type); numberSize != 0)
+		{
+			mPos = AlignPosition(mPos, numberSize) + numberSize;
+			return;
+		}
+
+		switch (type)
+		{
+		case SnapshotType::String:
+		{
+			std::string_view value;
+			ReadKey(value);
+			break;
+		}
+		case SnapshotType::Timestamp:
+			mPos = AlignPosition(mPos, 8) + TimestampSize;
+			break;
+		case SnapshotType::Array:
+		case SnapshotType::Map:
+		{
+			ReadRaw<uint64_t>();
+			const auto itemsSize = static_cast<size_t>(ReadRaw<uint64_t>());
+			mPos += itemsSize;
+			break;
+		}
+		case SnapshotType::Block:
+		{
+			const auto itemType = static_cast<SnapshotType>(mInputData[mPos++]);
+			const auto size = static_cast<size_t>(ReadRaw<uint64_t>());
+			mPos += size * GetNumberSize(itemType);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	template <typename T>
+	T CSnapshotReader::ReadRaw() noexcept
+	{
+		mPos = AlignPosition(mPos, sizeof(T) < 8 ? sizeof(T) : 8);
+		T value;
+		std::memcpy(&value, mInputData.data() + mPos, sizeof(T));
+		mPos += sizeof(T);
+		return value;
+	}
+
+	SnapshotType CSnapshotReader::ReadType() noexcept
+	{
+		if (mBlockItemType != SnapshotType::Null) {
+			return mBlockItemType;
+		}
+		return static_cast<SnapshotType>(mInputData[mPos++]);
+	}
+
+	template <typename T>
+	bool CSnapshotReader::ReadNumber(T& value)
+	{
+		const size_t valuePos = mPos;
+		const auto overflowNumberPolicy = mSerializationOptions.overflowNumberPolicy;
+
+		switch (ReadType())
+		{
+		case SnapshotType::Int8:
+			return CastNumber(ReadRaw<int8_t>(), value, overflowNumberPolicy);
+		case SnapshotType::UInt8:
+			return CastNumber(ReadRaw<uint8_t>(), value, overflowNumberPolicy);
+		case SnapshotType::Int16:
+			return CastNumber(ReadRaw<int16_t>(), value, overflowNumberPolicy);
+		case SnapshotType::UInt16:
+			return CastNumber(ReadRaw<uint16_t>(), value, overflowNumberPolicy);
+		case SnapshotType::Int32:
+			return CastNumber(ReadRaw<int32_t>(), value, overflowNumberPolicy);
+		case SnapshotType::UInt32:
+			return CastNumber(ReadRaw<uint32_t>(), value, overflowNumberPolicy);
+		case SnapshotType::Int64:
+			return CastNumber(ReadRaw<int64_t>(), value, overflowNumberPolicy);
+		case SnapshotType::UInt64:
+			return CastNumber(ReadRaw<uint64_t>(), value, overflowNumberPolicy);
+		case SnapshotType::Float:
+			return CastNumber(ReadRaw<float>(), value, overflowNumberPolicy);
+		case SnapshotType::Double:
+			return CastNumber(ReadRaw<double>(), value, overflowNumberPolicy);
+		case SnapshotType::False:
+		case SnapshotType::True:
+			if constexpr (std::is_integral_v<T>) {
+				return CastNumber(mInputData[valuePos] == static_cast<char>(SnapshotType::True), value, overflowNumberPolicy);
+			}
+			break;
+		case SnapshotType::Null:
+			// Null value is excluded from MismatchedTypesPolicy processing
+			return false;
+		default:
+			break;
+		}
+		return HandleMismatchedType(valuePos);
+	}
+
+	void CSnapshotReader::ValidateHeader()
+	{
+		if (mInputData.empty()) {
+			throw ParsingException("Input data is empty");
+		}
+		if (mInputData.size() < HeaderSize || std::memcmp(mInputData.data(), Signature, sizeof(Signature)) != 0) {
+			throw ParsingException("Invalid header of snapshot", 0, 0);
+		}
+
+		uint16_t version;
+		std::memcpy(&version, mInputData.data() + VersionOffset, sizeof(version));
+		uint32_t byteOrderMark;
+		std::memcpy(&byteOrderMark, mInputData.data() + ByteOrderMarkOffset, sizeof(byteOrderMark));
+		if (byteOrderMark != ByteOrderMark) {
+			throw ParsingException("Snapshot was created on the platform with different byte order", 0, ByteOrderMarkOffset);
+		}
+		if (version != FormatVersion) {
+			throw ParsingException("Unsupported version of snapshot format: " + Convert::ToString(version), 0, VersionOffset);
+		}
+
+		uint64_t payloadSize;
+		std::memcpy(&payloadSize, mInputData.data() + PayloadSizeOffset, sizeof(payloadSize));
+		if (payloadSize > mInputData.size() - HeaderSize) {
+			throw ParsingException("Unexpected end of snapshot data", 0, mInputData.size());
+		}
+		mInputData = mInputData.substr(0, HeaderSize + static_cast<size_t>(payloadSize));
+
+		uint64_t schemaFingerprint;
+		std::memcpy(&schemaFingerprint, mInputData.data() + FingerprintOffset, sizeof(schemaFingerprint));
+		if (mSerializationOptions.schemaFingerprint != 0 && mSerializationOptions.schemaFingerprint != schemaFingerprint)
+		{
+			throw SerializationException(SerializationErrorCode::MismatchedTypes,
+				"The schema fingerprint of snapshot does not match the expected one");
+		}
+	}
+
+	void CSnapshotReader::ValidateInput() const
+	{
+		std::vector<CContainerInfo> openedContainers;
+		size_t pos = HeaderSize;
+		bool isRootValue = true;
+		while (true)
+		{
+			size_t limit = mInputData.size();
+			if (!openedContainers.empty())
+			{
+				auto& container = openedContainers.back();
+				if (container.PendingItems == 0)
+				{
+					if (pos != container.EndPos) {
+						throw ParsingException("The size of container does not match its items", 0, pos);
+					}
+					openedContainers.pop_back();
+					continue;
+				}
+				--container.PendingItems;
+				limit = container.EndPos;
+
+				if (container.IsMap)
+				{
+					if (uint64_t keySize; !ReadSize(mInputData, pos, limit, keySize) || keySize > limit - pos) {
+						throw ParsingException("Unexpected end of snapshot data", 0, pos);
+					}
+					else {
+						pos += static_cast<size_t>(keySize);
+					}
+				}
+			}
+			else if (isRootValue) {
+				isRootValue = false;
+			}
+			else {
+				break;
+			}
+
+			if (pos >= limit) {
+				throw ParsingException("Unexpected end of snapshot data", 0, pos);
+			}
+			const size_t valuePos = pos;
+			const auto type = static_cast<SnapshotType>(mInputData[pos++]);
+			if (const size_t numberSize = GetNumberSize(type); numberSize != 0)
+			{
+				pos = AlignPosition(pos, numberSize);
+				if (pos > limit || limit - pos < numberSize) {
+					throw ParsingException("Unexpected end of snapshot data", 0, valuePos);
+				}
+				pos += numberSize;
+				continue;
+			}
+
+			switch (type)
+			{
+			case SnapshotType::Null:
+			case SnapshotType::False:
+			case SnapshotType::True:
+				break;
+			case SnapshotType::String:
+				if (uint64_t size; !ReadSize(mInputData, pos, limit, size) || size > limit - pos) {
+					throw ParsingException("Unexpected end of snapshot data", 0, valuePos);
+				}
+				else {
+					pos += static_cast<size_t>(size);
+				}
+				break;
+			case SnapshotType::Timestamp:
+				pos = AlignPosition(pos, 8);
+				if (pos > limit || limit - pos < TimestampSize) {
+					throw ParsingException("Unexpected end of snapshot data", 0, valuePos);
+				}
+				pos += TimestampSize;
+				break;
+			case SnapshotType::Array:
+			case SnapshotType::Map:
+			{
+				uint64_t size, itemsSize;
+				if (!ReadSize(mInputData, pos, limit, size) || !ReadSize(mInputData, pos, limit, itemsSize) || itemsSize > limit - pos) {
+					throw ParsingException("Unexpected end of snapshot data", 0, valuePos);
+				}
+				// Each item takes at least one byte
+				if (size > itemsSize) {
+					throw ParsingException("The size of container does not match its items", 0, valuePos);
+				}
+				openedContainers.push_back({ pos + static_cast<size_t>(itemsSize), size, type == SnapshotType::Map });
+				break;
+			}
+			case SnapshotType::Block:
+			{
+				const size_t itemSize = pos < limit ? GetNumberSize(static_cast<SnapshotType>(mInputData[pos++])) : 0;
+				if (itemSize == 0) {
+					throw ParsingException("Invalid type of block items", 0, valuePos);
+				}
+				if (uint64_t size; !ReadSize(mInputData, pos, limit, size) || size > (limit - pos) / itemSize) {
+					throw ParsingException("Unexpected end of snapshot data", 0, valuePos);
+				}
+				else {
+					pos += static_cast<size_t>(size) * itemSize;
+				}
+				break;
+			}
+			default:
+				throw ParsingException("Invalid type of value", 0, valuePos);
+			}
+		}
+
+		if (pos != mInputData.size()) {
+			throw ParsingException("Unexpected data after the root value", 0, pos);
+		}
+	}
+
+	bool CSnapshotReader::HandleMismatchedType(size_t valuePos)
+	{
+		mPos = valuePos;
+		SkipValue();
+		if (mSerializationOptions.mismatchedTypesPolicy == MismatchedTypesPolicy::ThrowError)
+		{
+			throw SerializationException(SerializationErrorCode::MismatchedTypes,
+				"The type of target field does not match the value being loaded");
+		}
+		return false;
+	}
+}
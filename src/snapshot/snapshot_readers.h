@@ -0,0 +1,60 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include "bitserializer/snapshot_archive.h"
+#include "snapshot_format.h"
+
+namespace BitSerializer::Snapshot::Detail
+{
+	/// <summary>
+	/// Snapshot reader from the continuous block of memory (e.g. memory mapped file).
+	/// The header and structure of root value are validated in the constructor, so all further reads can't go out of the input data.
+	/// Strings are returned as views to the input data, blocks of numbers are copied as is (when the type of items is matched).
+	/// </summary>
+	class CSnapshotReader final : public ISnapshotReader
+	{
+	public:
+		CSnapshotReader(std::string_view inputData, const SerializationOptions& serializationOptions);
+
+		[[nodiscard]] size_t GetPosition() const noexcept override { return mPos; }
+		void SetPosition(size_t pos) noexcept override { mPos = pos; }
+		bool ReadValue(std::nullptr_t& value) override;
+		bool ReadValue(bool& value) override;
+		bool ReadValue(uint8_t& value) override;
+		bool ReadValue(uint16_t& value) override;
+		bool ReadValue(uint32_t& value) override;
+		bool ReadValue(uint64_t& value) override;
+		bool ReadValue(int8_t& value) override;
+		bool ReadValue(int16_t& value) override;
+		bool ReadValue(int32_t& value) override;
+		bool ReadValue(int64_t& value) override;
+		bool ReadValue(float& value) override;
+		bool ReadValue(double& value) override;
+		bool ReadValue(std::string_view& value) override;
+		bool ReadValue(CBinTimestamp& timestamp) override;
+		void ReadKey(std::string_view& key) noexcept override;
+		bool ReadArraySize(size_t& arraySize, size_t& endPos) noexcept override;
+		bool ReadMapSize(size_t& mapSize, size_t& endPos) noexcept override;
+		bool ReadBlock(SnapshotType itemType, void* data, size_t size) noexcept override;
+		void EndArray(size_t endPos) noexcept override;
+		void SkipValue() noexcept override;
+
+	private:
+		template <typename T>
+		T ReadRaw() noexcept;
+		SnapshotType ReadType() noexcept;
+		template <typename T>
+		bool ReadNumber(T& value);
+		void ValidateHeader();
+		void ValidateInput() const;
+		bool HandleMismatchedType(size_t valuePos);
+
+		std::string_view mInputData;
+		const SerializationOptions& mSerializationOptions;
+		size_t mPos = HeaderSize;
+		// Type of items when reading the block (they are stored without type codes)
+		SnapshotType mBlockItemType = SnapshotType::Null;
+	};
+}
@@ -0,0 +1,182 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <cstring>
+#include "snapshot_writers.h"
+
+
+namespace BitSerializer::Snapshot::Detail
+{
+	template <class TBuffer>
+	CSnapshotBufferWriter<TBuffer>::CSnapshotBufferWriter(TBuffer& outputBuffer, uint64_t schemaFingerprint, std::ostream* outputStream)
+		: mBuffer(outputBuffer)
+		, mOutputStream(outputStream)
+		, mStartOffset(outputBuffer.size())
+	{
+		uint8_t header[HeaderSize] = {};
+		std::memcpy(header, Signature, sizeof(Signature));
+		std::memcpy(header + VersionOffset, &FormatVersion, sizeof(FormatVersion));
+		std::memcpy(header + ByteOrderMarkOffset, &ByteOrderMark, sizeof(ByteOrderMark));
+		std::memcpy(header + FingerprintOffset, &schemaFingerprint, sizeof(schemaFingerprint));
+		WriteBytes(header, HeaderSize);
+	}
+
+	template <class TBuffer>
+	void CSnapshotBufferWriter<TBuffer>::WriteNull()
+	{
+		WriteType(SnapshotType::Null);
+	}
+
+	template <class TBuffer>
+	void CSnapshotBufferWriter<TBuffer>::WriteBoolean(bool value)
+	{
+		WriteType(value ? SnapshotType::True : SnapshotType::False);
+	}
+
+	template <class TBuffer>
+	void CSnapshotBufferWriter<TBuffer>::WriteNumber(SnapshotType type, const void* value)
+	{
+		const size_t size = GetNumberSize(type);
+		WriteType(type);
+		AlignTo(size);
+		WriteBytes(value, size);
+	}
+
+	template <class TBuffer>
+	void CSnapshotBufferWriter<TBuffer>::WriteString(std::string_view value)
+	{
+		WriteType(SnapshotType::String);
+		WriteKey(value);
+	}
+
+	template <class TBuffer>
+	void CSnapshotBufferWriter<TBuffer>::WriteTimestamp(const CBinTimestamp& timestamp)
+	{
+		WriteType(SnapshotType::Timestamp);
+		AlignTo(8);
+		WriteBytes(&timestamp.Seconds, sizeof(timestamp.Seconds));
+		WriteBytes(&timestamp.Nanoseconds, sizeof(timestamp.Nanoseconds));
+	}
+
+	template <class TBuffer>
+	void CSnapshotBufferWriter<TBuffer>::WriteKey(std::string_view key)
+	{
+		WriteUInt64(key.size());
+		WriteBytes(key.data(), key.size());
+	}
+
+	template <class TBuffer>
+	void CSnapshotBufferWriter<TBuffer>::WriteBlock(SnapshotType itemType, const void* data, size_t size)
+	{
+		// The block replaces the header of just opened (empty) array
+		if (!mOpenedContainers.empty())
+		{
+			auto& container = mOpenedContainers.back();
+			container.IsBlock = true;
+			mBuffer.resize(mStartOffset + container.Position);
+		}
+
+		WriteType(SnapshotType::Block);
+		WriteType(itemType);
+		WriteUInt64(size);
+		WriteBytes(data, size * GetNumberSize(itemType));
+	}
+
+	template <class TBuffer>
+	void CSnapshotBufferWriter<TBuffer>::BeginArray()
+	{
+		BeginContainer(SnapshotType::Array);
+	}
+
+	template <class TBuffer>
+	void CSnapshotBufferWriter<TBuffer>::EndArray(size_t actualSize) noexcept
+	{
+		EndContainer(actualSize);
+	}
+
+	template <class TBuffer>
+	void CSnapshotBufferWriter<TBuffer>::BeginMap()
+	{
+		BeginContainer(SnapshotType::Map);
+	}
+
+	template <class TBuffer>
+	void CSnapshotBufferWriter<TBuffer>::EndMap(size_t actualSize) noexcept
+	{
+		EndContainer(actualSize);
+	}
+
+	template <class TBuffer>
+	void CSnapshotBufferWriter<TBuffer>::Flush()
+	{
+		PatchUInt64(PayloadSizeOffset, GetPosition() - HeaderSize);
+		if (mOutputStream)
+		{
+			mOutputStream->write(reinterpret_cast<const char*>(mBuffer.data()), static_cast<std::streamsize>(mBuffer.size()));
+			if (!mOutputStream->good()) {
+				throw SerializationException(SerializationErrorCode::InputOutputError, "Error writing to the output stream");
+			}
+			mBuffer.clear();
+		}
+	}
+
+	template <class TBuffer>
+	void CSnapshotBufferWriter<TBuffer>::WriteType(SnapshotType type)
+	{
+		mBuffer.push_back(static_cast<typename TBuffer::value_type>(type));
+	}
+
+	template <class TBuffer>
+	void CSnapshotBufferWriter<TBuffer>::WriteBytes(const void* data, size_t size)
+	{
+		const auto* bytes = static_cast<const typename TBuffer::value_type*>(data);
+		mBuffer.insert(mBuffer.end(), bytes, bytes + size);
+	}
+
+	template <class TBuffer>
+	void CSnapshotBufferWriter<TBuffer>::WriteUInt64(uint64_t value)
+	{
+		AlignTo(8);
+		WriteBytes(&value, sizeof(value));
+	}
+
+	template <class TBuffer>
+	void CSnapshotBufferWriter<TBuffer>::AlignTo(size_t alignment)
+	{
+		const size_t pos = GetPosition();
+		mBuffer.resize(mBuffer.size() + AlignPosition(pos, alignment) - pos);
+	}
+
+	template <class TBuffer>
+	void CSnapshotBufferWriter<TBuffer>::BeginContainer(SnapshotType type)
+	{
+		const size_t pos = GetPosition();
+		WriteType(type);
+		// Number of items and their size in bytes will be patched when the container is closed
+		WriteUInt64(0);
+		WriteUInt64(0);
+		mOpenedContainers.push_back({ pos, GetPosition(), false });
+	}
+
+	template <class TBuffer>
+	void CSnapshotBufferWriter<TBuffer>::EndContainer(size_t actualSize) noexcept
+	{
+		const ContainerInfo container = mOpenedContainers.back();
+		mOpenedContainers.pop_back();
+		if (!container.IsBlock)
+		{
+			PatchUInt64(container.ItemsPosition - 16, actualSize);
+			PatchUInt64(container.ItemsPosition - 8, GetPosition() - container.ItemsPosition);
+		}
+	}
+
+	template <class TBuffer>
+	void CSnapshotBufferWriter<TBuffer>::PatchUInt64(size_t pos, uint64_t value) noexcept
+	{
+		std::memcpy(&mBuffer[mStartOffset + pos], &value, sizeof(value));
+	}
+
+	template class CSnapshotBufferWriter<std::string>;
+	template class CSnapshotBufferWriter<std::vector<uint8_t>>;
+}
@@ -0,0 +1,78 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#pragma once
+#include <ostream>
+#include "bitserializer/snapshot_archive.h"
+#include "snapshot_format.h"
+
+namespace BitSerializer::Snapshot::Detail
+{
+	/// <summary>
+	/// Snapshot writer to the buffer (<c>std::string</c> or <c>std::vector&lt;uint8_t&gt;</c>).
+	/// Sizes of arrays and maps are patched when the scope is closed, so the whole snapshot is kept in the buffer until flushing.
+	/// </summary>
+	template <class TBuffer>
+	class CSnapshotBufferWriter : public ISnapshotWriter
+	{
+	public:
+		CSnapshotBufferWriter(TBuffer& outputBuffer, uint64_t schemaFingerprint, std::ostream* outputStream = nullptr);
+
+		void WriteNull() override;
+		void WriteBoolean(bool value) override;
+		void WriteNumber(SnapshotType type, const void* value) override;
+		void WriteString(std::string_view value) override;
+		void WriteTimestamp(const CBinTimestamp& timestamp) override;
+		void WriteKey(std::string_view key) override;
+		void WriteBlock(SnapshotType itemType, const void* data, size_t size) override;
+		void BeginArray() override;
+		void EndArray(size_t actualSize) noexcept override;
+		void BeginMap() override;
+		void EndMap(size_t actualSize) noexcept override;
+		void Flush() override;
+
+	protected:
+		struct ContainerInfo
+		{
+			// Position of the type code (relative to the start of snapshot)
+			size_t Position;
+			// Position of the first item (relative to the start of snapshot)
+			size_t ItemsPosition;
+			bool IsBlock;
+		};
+
+		void WriteType(SnapshotType type);
+		void WriteBytes(const void* data, size_t size);
+		void WriteUInt64(uint64_t value);
+		void AlignTo(size_t alignment);
+		void BeginContainer(SnapshotType type);
+		void EndContainer(size_t actualSize) noexcept;
+		void PatchUInt64(size_t pos, uint64_t value) noexcept;
+		[[nodiscard]] size_t GetPosition() const noexcept { return mBuffer.size() - mStartOffset; }
+
+		TBuffer& mBuffer;
+		std::ostream* mOutputStream;
+		const size_t mStartOffset;
+		std::vector<ContainerInfo> mOpenedContainers;
+	};
+
+	/// <summary>
+	/// Holds the internal buffer of stream writer (must be constructed before the base writer).
+	/// </summary>
+	struct CSnapshotStreamBuffer
+	{
+		std::string mStreamBuffer;
+	};
+
+	/// <summary>
+	/// Snapshot writer to the stream (the data is written when flushing, as sizes of containers are patched in the buffer).
+	/// </summary>
+	class CSnapshotStreamWriter final : private CSnapshotStreamBuffer, public CSnapshotBufferWriter<std::string>
+	{
+	public:
+		CSnapshotStreamWriter(std::ostream& outputStream, uint64_t schemaFingerprint)
+			: CSnapshotBufferWriter<std::string>(mStreamBuffer, schemaFingerprint, &outputStream)
+		{ }
+	};
+}
@@ -0,0 +1,550 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <list>
+#include <map>
+#include "testing_tools/common_test_methods.h"
+#include "testing_tools/common_json_test_methods.h"
+#include "bitserializer/bson_archive.h"
+#include "bitserializer/types/std/chrono.h"
+#include "bitserializer/types/std/list.h"
+#include "bitserializer/types/std/map.h"
+#include "bitserializer/types/std/vector.h"
+
+using BitSerializer::Bson::BsonArchive;
+
+namespace
+{
+	template <typename T>
+	std::string SaveToBson(T value)
+	{
+		return BitSerializer::SaveObject<BsonArchive>(value);
+	}
+
+	template <typename T>
+	T LoadFromBson(const std::string& data)
+	{
+		T value{};
+		BitSerializer::LoadObject<BsonArchive>(value, data);
+		return value;
+	}
+
+	std::string MakeDocument(const std::string& elements)
+	{
+		const auto size = static_cast<uint32_t>(elements.size() + 5);
+		std::string document;
+		for (size_t i = 0; i < 4; ++i) {
+			document.push_back(static_cast<char>((size >> (i * 8)) & 0xFF));
+		}
+		return document + elements + std::string(1, '\0');
+	}
+}
+
+#pragma warning(push)
+#pragma warning(disable: 4566)
+
+//-----------------------------------------------------------------------------
+// Tests of serialization for classes
+//-----------------------------------------------------------------------------
+TEST(BsonArchive, SerializeClassWithMemberBoolean)
+{
+	TestSerializeClass<BsonArchive>(TestClassWithSubTypes<bool>(false));
+	TestSerializeClass<BsonArchive>(TestClassWithSubTypes<bool>(true));
+}
+
+TEST(BsonArchive, SerializeClassWithMemberInteger)
+{
+	TestSerializeClass<BsonArchive>(BuildFixture<TestClassWithSubTypes<int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t, int64_t>>());
+	TestSerializeClass<BsonArchive>(TestClassWithSubTypes(std::numeric_limits<int64_t>::min(), std::numeric_limits<uint32_t>::max()));
+	TestSerializeClass<BsonArchive>(TestClassWithSubTypes(static_cast<uint64_t>(std::numeric_limits<int64_t>::max())));
+}
+
+TEST(BsonArchive, SerializeClassWithMemberFloat)
+{
+	TestSerializeClass<BsonArchive>(TestClassWithSubTypes(std::numeric_limits<float>::lowest(), 0.0f, std::numeric_limits<float>::max()));
+}
+
+TEST(BsonArchive, SerializeClassWithMemberDouble)
+{
+	TestSerializeClass<BsonArchive>(TestClassWithSubTypes(std::numeric_limits<double>::min(), 0.0, std::numeric_limits<double>::max()));
+}
+
+TEST(BsonArchive, SerializeClassWithMemberNullptr)
+{
+	TestSerializeClass<BsonArchive>(BuildFixture<TestClassWithSubTypes<std::nullptr_t>>());
+}
+
+TEST(BsonArchive, SerializeClassWithMemberString)
+{
+	TestSerializeClass<BsonArchive>(BuildFixture<TestClassWithSubTypes<std::string, std::wstring, std::u16string, std::u32string>>());
+}
+
+TEST(BsonArchive, SerializeClassHierarchy)
+{
+	TestSerializeClass<BsonArchive>(BuildFixture<TestClassWithInheritance>());
+}
+
+TEST(BsonArchive, SerializeClassWithMemberClass)
+{
+	using TestClassType = TestClassWithSubTypes<TestClassWithSubTypes<int64_t>>;
+	TestSerializeClass<BsonArchive>(BuildFixture<TestClassType>());
+}
+
+TEST(BsonArchive, SerializeClassWithSubArray)
+{
+	TestSerializeClass<BsonArchive>(BuildFixture<TestClassWithSubArray<int64_t>>());
+}
+
+TEST(BsonArchive, SerializeClassWithSubArrayOfBytes)
+{
+	TestSerializeClass<BsonArchive>(BuildFixture<TestClassWithSubArray<uint8_t>>());
+	TestSerializeClass<BsonArchive>(BuildFixture<TestClassWithSubArray<char>>());
+}
+
+TEST(BsonArchive, SerializeClassWithSubArrayOfClasses)
+{
+	TestSerializeClass<BsonArchive>(BuildFixture<TestClassWithSubArray<TestPointClass>>());
+}
+
+TEST(BsonArchive, SerializeClassWithSubTwoDimArray)
+{
+	TestSerializeClass<BsonArchive>(BuildFixture<TestClassWithSubTwoDimArray<int32_t>>());
+}
+
+TEST(BsonArchive, SerializeArrayOfClasses)
+{
+	TestSerializeArray<BsonArchive, TestPointClass>();
+}
+
+TEST(BsonArchive, SerializeTimePoint)
+{
+	using namespace std::chrono;
+	TestSerializeClass<BsonArchive>(TestClassWithSubType(time_point<system_clock, seconds>(seconds(-2208988800))));
+	TestSerializeClass<BsonArchive>(TestClassWithSubType(time_point<system_clock, milliseconds>(milliseconds(1689371091925))));
+	TestSerializeClass<BsonArchive>(TestClassWithSubType(time_point<system_clock, milliseconds>(milliseconds(-1))));
+}
+
+TEST(BsonArchive, ShouldLoadValuesInAnyOrder)
+{
+	// Arrange
+	std::string outputData;
+	{
+		BitSerializer::SerializationOptions options;
+		BitSerializer::SerializationContext context(options);
+		BsonArchive::output_archive_type outputArchive(outputData, context);
+		{
+			auto objScope = outputArchive.OpenObjectScope();
+			int y = 20, x = 10;
+			std::vector<int> unknown(100);
+			objScope->SerializeValue("y", y);
+			BitSerializer::Serialize(*objScope, "unknown", unknown);
+			objScope->SerializeValue("x", x);
+		}
+		outputArchive.Finalize();
+	}
+	TestPointClass actual(0, 0);
+
+	// Act
+	BitSerializer::LoadObject<BsonArchive>(actual, outputData);
+
+	// Assert
+	TestPointClass(10, 20).Assert(actual);
+}
+
+TEST(BsonArchive, ShouldIterateKeysInObjectScope)
+{
+	TestIterateKeysInObjectScope<BsonArchive>();
+}
+
+TEST(BsonArchive, SerializeMap)
+{
+	std::map<std::string, int64_t> expected = { { "first", 1 }, { "second", -2 }, { "third", 3000000000 } };
+	TestClassWithSubType<std::map<std::string, int64_t>> testObj(expected);
+	TestSerializeClass<BsonArchive>(testObj);
+}
+
+//-----------------------------------------------------------------------------
+// Tests of BSON layout
+//-----------------------------------------------------------------------------
+TEST(BsonArchive, ShouldWriteDocumentInBsonFormat)
+{
+	// Example from the BSON specification: {"hello": "world"}
+	std::string data;
+	{
+		BitSerializer::SerializationOptions options;
+		BitSerializer::SerializationContext context(options);
+		BsonArchive::output_archive_type outputArchive(data, context);
+		{
+			auto objScope = outputArchive.OpenObjectScope();
+			std::string value = "world";
+			objScope->SerializeValue("hello", value);
+		}
+		outputArchive.Finalize();
+	}
+	EXPECT_EQ(std::string("\x16\x00\x00\x00\x02hello\x00\x06\x00\x00\x00world\x00\x00", 22), data);
+}
+
+TEST(BsonArchive, ShouldWriteIntegersWithCompactTypes)
+{
+	TestClassWithSubTypes<int16_t, uint32_t, int64_t> testObj(-1, 1, 1);
+	const auto data = SaveToBson(testObj);
+
+	// The size (4 bytes), type code (1 byte) + key "Member_N" (9 bytes) + value of each element, terminator
+	ASSERT_EQ(4 + 10 + 4 + 10 + 8 + 10 + 8 + 1, data.size());
+	EXPECT_EQ('\x10', data[4]);
+	EXPECT_EQ('\x12', data[4 + 10 + 4]);
+	EXPECT_EQ('\x12', data[4 + 10 + 4 + 10 + 8]);
+}
+
+TEST(BsonArchive, ShouldWriteArrayAsDocumentWithIndexKeys)
+{
+	TestClassWithSubType<std::vector<int32_t>> testObj({ 10, 20 });
+	const auto data = SaveToBson(testObj);
+
+	const std::string expectedArray = MakeDocument(std::string("\x10" "0\0\x0A\0\0\0" "\x10" "1\0\x14\0\0\0", 14));
+	EXPECT_NE(std::string::npos, data.find(std::string("\x04TestValue\0", 11) + expectedArray));
+}
+
+TEST(BsonArchive, ShouldWriteArrayOfBytesAsBinary)
+{
+	TestClassWithSubType<std::vector<uint8_t>> testObj({ 1, 2, 3 });
+	const auto data = SaveToBson(testObj);
+
+	const std::string expected = MakeDocument(std::string("\x05TestValue\0\x03\0\0\0\0\x01\x02\x03", 19));
+	EXPECT_EQ(expected, data);
+}
+
+TEST(BsonArchive, ShouldLoadArrayOfBytesFromRegularArray)
+{
+	const std::string data = MakeDocument(std::string("\x04TestValue\0", 11)
+		+ MakeDocument(std::string("\x10" "0\0\x01\0\0\0" "\x10" "1\0\x02\0\0\0", 14)));
+
+	TestClassWithSubType<std::vector<uint8_t>> actual;
+	BitSerializer::LoadObject<BsonArchive>(actual, data);
+	EXPECT_EQ(std::vector<uint8_t>({ 1, 2 }), actual.GetValue());
+}
+
+TEST(BsonArchive, ShouldLoadBinaryToOtherContainers)
+{
+	const auto data = SaveToBson(TestClassWithSubType<std::vector<uint8_t>>({ 1, 2, 3 }));
+
+	EXPECT_EQ(std::list<uint8_t>({ 1, 2, 3 }), LoadFromBson<TestClassWithSubType<std::list<uint8_t>>>(data).GetValue());
+	EXPECT_EQ(std::vector<int32_t>({ 1, 2, 3 }), LoadFromBson<TestClassWithSubType<std::vector<int32_t>>>(data).GetValue());
+	EXPECT_EQ(std::string("\x01\x02\x03"), LoadFromBson<TestClassWithSubType<std::string>>(data).GetValue());
+}
+
+TEST(BsonArchive, ShouldWriteDateTimeInMilliseconds)
+{
+	using namespace std::chrono;
+	const time_point<system_clock, milliseconds> timePoint(milliseconds(1000));
+	const auto data = SaveToBson(TestClassWithSubType(timePoint));
+	EXPECT_EQ(MakeDocument(std::string("\x09TestValue\0\xE8\x03\0\0\0\0\0\0", 19)), data);
+}
+
+TEST(BsonArchive, ShouldSkipUnknownElements)
+{
+	const std::string elements = std::string("\x07oid\0" "0123456789AB", 17)
+		+ std::string("\x0Bregex\0^a.*$\0i\0", 15)
+		+ std::string("\x13" "dec\0" "0123456789ABCDEF", 21)
+		+ std::string("\x0D" "code\0\x03\0\0\0{}\0", 13)
+		+ std::string("\x03sub\0", 5) + MakeDocument(std::string("\x0Ax\0", 3))
+		+ std::string("\x10x\0\x0A\0\0\0" "\x10y\0\x14\0\0\0", 14)
+		+ std::string("\xFFmin\0\x7Fmax\0", 10);
+
+	TestPointClass actual(0, 0);
+	BitSerializer::LoadObject<BsonArchive>(actual, MakeDocument(elements));
+	TestPointClass(10, 20).Assert(actual);
+}
+
+TEST(BsonArchive, ShouldLoadStringAsViewToInputData)
+{
+	const auto data = SaveToBson(TestClassWithSubType<std::string>("Hello world"));
+	BitSerializer::SerializationOptions options;
+	BitSerializer::SerializationContext context(options);
+	BsonArchive::input_archive_type inputArchive(data, context);
+
+	auto objScope = inputArchive.OpenObjectScope();
+	ASSERT_TRUE(objScope.has_value());
+	std::string_view actual;
+	ASSERT_TRUE(objScope->SerializeValue("TestValue", actual));
+	EXPECT_EQ("Hello world", actual);
+	EXPECT_EQ(data.data() + 4 + 11 + 4, actual.data());
+}
+
+//-----------------------------------------------------------------------------
+// Tests of sequence of root documents
+//-----------------------------------------------------------------------------
+TEST(BsonArchive, ShouldWriteRootArrayAsSequenceOfDocuments)
+{
+	std::vector<TestPointClass> testList = { TestPointClass(1, 2), TestPointClass(3, 4) };
+	const auto data = SaveToBson(testList);
+	EXPECT_EQ(SaveToBson(testList[0]) + SaveToBson(testList[1]), data);
+
+	const auto actual = LoadFromBson<std::vector<TestPointClass>>(data);
+	ASSERT_EQ(2U, actual.size());
+	testList[0].Assert(actual[0]);
+	testList[1].Assert(actual[1]);
+}
+
+TEST(BsonArchive, ShouldLoadEmptySequenceOfDocuments)
+{
+	EXPECT_TRUE(LoadFromBson<std::vector<TestPointClass>>(std::string()).empty());
+}
+
+TEST(BsonArchive, ThrowParsingExceptionWhenLoadObjectFromSequenceOfDocuments)
+{
+	const auto data = SaveToBson(std::vector<TestPointClass>(2));
+	EXPECT_THROW(LoadFromBson<TestPointClass>(data), BitSerializer::ParsingException);
+}
+
+//-----------------------------------------------------------------------------
+// Test paths in archive
+//-----------------------------------------------------------------------------
+TEST(BsonArchive, ShouldReturnPathInObjectScopeWhenLoading)
+{
+	TestGetPathInJsonObjectScopeWhenLoading<BsonArchive>();
+}
+
+TEST(BsonArchive, ShouldReturnPathInObjectScopeWhenSaving)
+{
+	TestGetPathInJsonObjectScopeWhenSaving<BsonArchive>();
+}
+
+TEST(BsonArchive, ShouldReturnPathInArrayScopeWhenLoading)
+{
+	TestGetPathInJsonArrayScopeWhenLoading<BsonArchive>();
+}
+
+TEST(BsonArchive, ShouldReturnPathInArrayScopeWhenSaving)
+{
+	TestGetPathInJsonArrayScopeWhenSaving<BsonArchive>();
+}
+
+//-----------------------------------------------------------------------------
+// Tests streams / files / binary vector
+//-----------------------------------------------------------------------------
+TEST(BsonArchive, SerializeClassToStream) {
+	TestSerializeClassToStream<BsonArchive, char>(BuildFixture<TestPointClass>());
+}
+
+TEST(BsonArchive, SerializeUnicodeToStream) {
+	TestClassWithSubType<std::wstring> TestValue(L"Привет мир!");
+	TestSerializeClassToStream<BsonArchive, char>(TestValue);
+}
+
+TEST(BsonArchive, SerializeLargeArrayToStream)
+{
+	std::vector<TestPointClass> expected(10000);
+	::BuildFixture(expected);
+	std::vector<TestPointClass> actual;
+
+	std::stringstream outputStream;
+	BitSerializer::SaveObject<BsonArchive>(expected, outputStream);
+	EXPECT_EQ(BitSerializer::SaveObject<BsonArchive>(expected), outputStream.str());
+	outputStream.seekg(0, std::ios::beg);
+	BitSerializer::LoadObject<BsonArchive>(actual, outputStream);
+
+	ASSERT_EQ(expected.size(), actual.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		expected[i].Assert(actual[i]);
+	}
+}
+
+TEST(BsonArchive, SerializeClassToBinaryVector)
+{
+	auto expected = BuildFixture<TestClassWithSubTypes<int64_t, std::string, double>>();
+	decltype(expected) actual;
+
+	std::vector<uint8_t> outputData;
+	BitSerializer::SaveObject<BsonArchive>(expected, outputData);
+	BitSerializer::LoadObject<BsonArchive>(actual, outputData);
+
+	expected.Assert(actual);
+}
+
+TEST(BsonArchive, SerializeToFile) {
+	TestSerializeArrayToFile<BsonArchive>();
+}
+
+//-----------------------------------------------------------------------------
+// Tests of errors handling
+//-----------------------------------------------------------------------------
+TEST(BsonArchive, ThrowParsingExceptionWhenInputIsEmpty)
+{
+	TestPointClass testObj;
+	EXPECT_THROW(BitSerializer::LoadObject<BsonArchive>(testObj, std::string()), BitSerializer::ParsingException);
+}
+
+TEST(BsonArchive, ThrowParsingExceptionWithCorrectPosition)
+{
+	// Array of two items, where the second one has invalid type code
+	auto data = SaveToBson(TestClassWithSubType<std::vector<std::string>>({ "a", "b" }));
+	const auto pos = data.rfind('b') - 4 - 3;
+	ASSERT_EQ('\x02', data[pos]);
+	data[pos] = '\x20';
+
+	try
+	{
+		LoadFromBson<TestClassWithSubType<std::vector<std::string>>>(data);
+		EXPECT_FALSE(true);
+	}
+	catch (const BitSerializer::ParsingException& ex)
+	{
+		EXPECT_EQ(pos, ex.Offset);
+	}
+}
+
+TEST(BsonArchive, ThrowParsingExceptionWhenDataIsTruncated)
+{
+	auto testObj = BuildFixture<TestClassWithSubTypes<std::string, int64_t>>();
+	const auto data = BitSerializer::SaveObject<BsonArchive>(testObj);
+	for (size_t size = 0; size < data.size(); ++size)
+	{
+		EXPECT_THROW(BitSerializer::LoadObject<BsonArchive>(testObj, data.substr(0, size)), BitSerializer::ParsingException);
+	}
+}
+
+TEST(BsonArchive, ThrowParsingExceptionWhenStringSizeIsInvalid)
+{
+	TestClassWithSubType<std::string> testObj;
+	// Size exceeds the document
+	EXPECT_THROW(BitSerializer::LoadObject<BsonArchive>(testObj, MakeDocument(std::string("\x02TestValue\0\xff\x7f\0\0abc\0", 19))), BitSerializer::ParsingException);
+	// Negative size
+	EXPECT_THROW(BitSerializer::LoadObject<BsonArchive>(testObj, MakeDocument(std::string("\x02TestValue\0\xff\xff\xff\xff" "abc\0", 19))), BitSerializer::ParsingException);
+	// Missed terminating zero
+	EXPECT_THROW(BitSerializer::LoadObject<BsonArchive>(testObj, MakeDocument(std::string("\x02TestValue\0\x04\0\0\0" "abcd", 19))), BitSerializer::ParsingException);
+	// Truncated size
+	EXPECT_THROW(BitSerializer::LoadObject<BsonArchive>(testObj, MakeDocument(std::string("\x02TestValue\0\x04\0", 13))), BitSerializer::ParsingException);
+}
+
+TEST(BsonArchive, ThrowParsingExceptionWhenDbPointerSizeIsInvalid)
+{
+	TestPointClass testObj;
+	// The document is shorter than the size of string and ObjectId
+	EXPECT_THROW(BitSerializer::LoadObject<BsonArchive>(testObj, std::string("\x10\0\0\0\x0Cx\0\0\0\xff\x7f\0\0\0\0\0", 16)), BitSerializer::ParsingException);
+	// String is valid, but ObjectId is truncated
+	EXPECT_THROW(BitSerializer::LoadObject<BsonArchive>(testObj, MakeDocument(std::string("\x0Cx\0\x02\0\0\0a\0" "0123456789", 19))), BitSerializer::ParsingException);
+}
+
+TEST(BsonArchive, ThrowParsingExceptionWhenBinarySizeIsInvalid)
+{
+	TestClassWithSubType<std::vector<uint8_t>> testObj;
+	// Size exceeds the document
+	EXPECT_THROW(BitSerializer::LoadObject<BsonArchive>(testObj, MakeDocument(std::string("\x05TestValue\0\xff\x7f\0\0\0\x01", 17))), BitSerializer::ParsingException);
+	// Missed subtype
+	EXPECT_THROW(BitSerializer::LoadObject<BsonArchive>(testObj, MakeDocument(std::string("\x05TestValue\0\0\0\0\0", 15))), BitSerializer::ParsingException);
+	// Truncated size
+	EXPECT_THROW(BitSerializer::LoadObject<BsonArchive>(testObj, MakeDocument(std::string("\x05TestValue\0\x01\0", 13))), BitSerializer::ParsingException);
+}
+
+TEST(BsonArchive, ThrowSerializationExceptionWhenSaveTooLargeUnsignedInteger)
+{
+	TestClassWithSubType<uint64_t> testObj(std::numeric_limits<uint64_t>::max());
+	try
+	{
+		SaveToBson(testObj);
+		EXPECT_FALSE(true);
+	}
+	catch (const BitSerializer::SerializationException& ex)
+	{
+		EXPECT_EQ(BitSerializer::SerializationErrorCode::Overflow, ex.GetErrorCode());
+	}
+}
+
+TEST(BsonArchive, ThrowSerializationExceptionWhenKeyContainsNullCharacter)
+{
+	std::map<std::string, int> testMap = { { std::string("a\0b", 3), 1 } };
+	EXPECT_THROW(SaveToBson(TestClassWithSubType(testMap)), BitSerializer::SerializationException);
+}
+
+//-----------------------------------------------------------------------------
+TEST(BsonArchive, ThrowValidationExceptionWhenMissedRequiredValue) {
+	TestValidationForNamedValues<BsonArchive, TestClassForCheckValidation<bool>>();
+	TestValidationForNamedValues<BsonArchive, TestClassForCheckValidation<int>>();
+	TestValidationForNamedValues<BsonArchive, TestClassForCheckValidation<double>>();
+	TestValidationForNamedValues<BsonArchive, TestClassForCheckValidation<std::string>>();
+	TestValidationForNamedValues<BsonArchive, TestClassForCheckValidation<TestPointClass>>();
+	TestValidationForNamedValues<BsonArchive, TestClassForCheckValidation<int[3]>>();
+}
+
+//-----------------------------------------------------------------------------
+TEST(BsonArchive, ThrowMismatchedTypesExceptionWhenLoadStringToBoolean) {
+	TestMismatchedTypesPolicy<BsonArchive, std::string, bool>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+TEST(BsonArchive, ThrowMismatchedTypesExceptionWhenLoadStringToInteger) {
+	TestMismatchedTypesPolicy<BsonArchive, std::string, int32_t>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+TEST(BsonArchive, ThrowMismatchedTypesExceptionWhenLoadStringToFloat) {
+	TestMismatchedTypesPolicy<BsonArchive, std::string, float>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+TEST(BsonArchive, ThrowMismatchedTypesExceptionWhenLoadNumberToString) {
+	TestMismatchedTypesPolicy<BsonArchive, int32_t, std::string>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+
+TEST(BsonArchive, ThrowValidationExceptionWhenLoadStringToBoolean) {
+	TestMismatchedTypesPolicy<BsonArchive, std::string, bool>(BitSerializer::MismatchedTypesPolicy::Skip);
+}
+TEST(BsonArchive, ThrowValidationExceptionWhenLoadStringToInteger) {
+	TestMismatchedTypesPolicy<BsonArchive, std::string, int32_t>(BitSerializer::MismatchedTypesPolicy::Skip);
+}
+TEST(BsonArchive, ThrowValidationExceptionWhenLoadStringToFloat) {
+	TestMismatchedTypesPolicy<BsonArchive, std::string, float>(BitSerializer::MismatchedTypesPolicy::Skip);
+}
+TEST(BsonArchive, ThrowValidationExceptionWhenLoadNullToAnyType) {
+	// It doesn't matter what kind of MismatchedTypesPolicy is used, should throw only validation exception
+	TestMismatchedTypesPolicy<BsonArchive, std::nullptr_t, bool>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+	TestMismatchedTypesPolicy<BsonArchive, std::nullptr_t, uint32_t>(BitSerializer::MismatchedTypesPolicy::Skip);
+	TestMismatchedTypesPolicy<BsonArchive, std::nullptr_t, double>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+	TestMismatchedTypesPolicy<BsonArchive, std::nullptr_t, std::string>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+
+//-----------------------------------------------------------------------------
+
+TEST(BsonArchive, ThrowSerializationExceptionWhenOverflowBool) {
+	TestOverflowNumberPolicy<BsonArchive, int32_t, bool>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(BsonArchive, ThrowSerializationExceptionWhenOverflowInt8) {
+	TestOverflowNumberPolicy<BsonArchive, int16_t, int8_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<BsonArchive, uint16_t, uint8_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(BsonArchive, ThrowSerializationExceptionWhenOverflowInt16) {
+	TestOverflowNumberPolicy<BsonArchive, int32_t, int16_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<BsonArchive, uint32_t, uint16_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(BsonArchive, ThrowSerializationExceptionWhenOverflowInt32) {
+	TestOverflowNumberPolicy<BsonArchive, int64_t, int32_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<BsonArchive, uint64_t, uint32_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(BsonArchive, ThrowSerializationExceptionWhenOverflowFloat) {
+	TestOverflowNumberPolicy<BsonArchive, double, float>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(BsonArchive, ThrowSerializationExceptionWhenLoadFloatToInteger) {
+	TestOverflowNumberPolicy<BsonArchive, float, uint32_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<BsonArchive, double, uint32_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+
+TEST(BsonArchive, ThrowValidationExceptionWhenOverflowBool) {
+	TestOverflowNumberPolicy<BsonArchive, int32_t, bool>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(BsonArchive, ThrowValidationExceptionWhenNumberOverflowInt8) {
+	TestOverflowNumberPolicy<BsonArchive, int16_t, int8_t>(BitSerializer::OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<BsonArchive, uint16_t, uint8_t>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(BsonArchive, ThrowValidationExceptionWhenNumberOverflowInt16) {
+	TestOverflowNumberPolicy<BsonArchive, int32_t, int16_t>(BitSerializer::OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<BsonArchive, uint32_t, uint16_t>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(BsonArchive, ThrowValidationExceptionWhenNumberOverflowInt32) {
+	TestOverflowNumberPolicy<BsonArchive, int64_t, int32_t>(BitSerializer::OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<BsonArchive, uint64_t, uint32_t>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(BsonArchive, ThrowValidationExceptionWhenNumberOverflowFloat) {
+	TestOverflowNumberPolicy<BsonArchive, double, float>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(BsonArchive, ThrowValidationExceptionWhenLoadFloatToInteger) {
+	TestOverflowNumberPolicy<BsonArchive, float, uint32_t>(BitSerializer::OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<BsonArchive, double, uint32_t>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+
+#pragma warning(pop)
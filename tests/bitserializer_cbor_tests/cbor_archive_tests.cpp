@@ -0,0 +1,710 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <map>
+#include "testing_tools/common_test_methods.h"
+#include "testing_tools/common_json_test_methods.h"
+#include "bitserializer/cbor_archive.h"
+#include "bitserializer/types/std/chrono.h"
+#include "bitserializer/types/std/ctime.h"
+#include "bitserializer/types/std/map.h"
+#include "bitserializer/types/std/vector.h"
+
+using BitSerializer::Cbor::CborArchive;
+
+namespace
+{
+	template <typename T>
+	std::string SaveToCbor(T value)
+	{
+		return BitSerializer::SaveObject<CborArchive>(value);
+	}
+
+	template <typename T>
+	T LoadFromCbor(const std::string& data)
+	{
+		T value{};
+		BitSerializer::LoadObject<CborArchive>(value, data);
+		return value;
+	}
+}
+
+#pragma warning(push)
+#pragma warning(disable: 4566)
+
+//-----------------------------------------------------------------------------
+// Tests of serialization for fundamental types (at root scope of archive)
+//-----------------------------------------------------------------------------
+TEST(CborArchive, SerializeBoolean)
+{
+	TestSerializeType<CborArchive, bool>(false);
+	TestSerializeType<CborArchive, bool>(true);
+}
+
+TEST(CborArchive, SerializeInteger)
+{
+	TestSerializeType<CborArchive, uint8_t>(std::numeric_limits<uint8_t>::min());
+	TestSerializeType<CborArchive, uint8_t>(std::numeric_limits<uint8_t>::max());
+	TestSerializeType<CborArchive, int8_t>(std::numeric_limits<int8_t>::min());
+	TestSerializeType<CborArchive, int16_t>(std::numeric_limits<int16_t>::min());
+	TestSerializeType<CborArchive, int32_t>(std::numeric_limits<int32_t>::min());
+	TestSerializeType<CborArchive, uint32_t>(std::numeric_limits<uint32_t>::max());
+	TestSerializeType<CborArchive, int64_t>(std::numeric_limits<int64_t>::min());
+	TestSerializeType<CborArchive, uint64_t>(std::numeric_limits<uint64_t>::max());
+}
+
+TEST(CborArchive, SerializeFloat)
+{
+	TestSerializeType<CborArchive, float>(0.f);
+	TestSerializeType<CborArchive, float>(3.141592654f);
+	TestSerializeType<CborArchive, float>(std::numeric_limits<float>::lowest());
+	TestSerializeType<CborArchive, float>(std::numeric_limits<float>::max());
+}
+
+TEST(CborArchive, SerializeDouble)
+{
+	TestSerializeType<CborArchive, double>(std::numeric_limits<double>::min());
+	TestSerializeType<CborArchive, double>(std::numeric_limits<double>::max());
+	TestSerializeType<CborArchive, double>(0.5);
+}
+
+TEST(CborArchive, ShouldAllowToLoadBooleanFromInteger)
+{
+	bool actual = false;
+	BitSerializer::LoadObject<CborArchive>(actual, std::string("\x01", 1));
+	EXPECT_EQ(true, actual);
+}
+
+TEST(CborArchive, ShouldAllowToLoadFloatFromInteger)
+{
+	float actual = 0;
+	BitSerializer::LoadObject<CborArchive>(actual, std::string("\x18\x64", 2));
+	EXPECT_EQ(100, actual);
+}
+
+TEST(CborArchive, SerializeNullptr)
+{
+	TestSerializeType<CborArchive, std::nullptr_t>(nullptr);
+}
+
+//-----------------------------------------------------------------------------
+// Tests of encoding numbers and strings in the preferred (shortest) formats
+//-----------------------------------------------------------------------------
+TEST(CborArchive, SaveIntegersInShortestForm)
+{
+	EXPECT_EQ(std::string("\x17", 1), SaveToCbor(int64_t(23)));
+	EXPECT_EQ(std::string("\x18\x18", 2), SaveToCbor(uint64_t(24)));
+	EXPECT_EQ(std::string("\x20", 1), SaveToCbor(int64_t(-1)));
+	EXPECT_EQ(std::string("\x37", 1), SaveToCbor(int32_t(-24)));
+	EXPECT_EQ(std::string("\x38\x18", 2), SaveToCbor(int8_t(-25)));
+	EXPECT_EQ(std::string("\x19\x01\x00", 3), SaveToCbor(int64_t(256)));
+	EXPECT_EQ(std::string("\x39\x7F\xFF", 3), SaveToCbor(int16_t(-32768)));
+	EXPECT_EQ(std::string("\x1A\x00\x01\x00\x00", 5), SaveToCbor(uint32_t(65536)));
+	EXPECT_EQ(std::string("\x1B\x00\x00\x00\x01\x00\x00\x00\x00", 9), SaveToCbor(uint64_t(0x100000000)));
+	EXPECT_EQ(std::string("\x3B\x7F\xFF\xFF\xFF\xFF\xFF\xFF\xFF", 9), SaveToCbor(std::numeric_limits<int64_t>::min()));
+}
+
+TEST(CborArchive, SaveFloatsInShortestFormWhenNoLostPrecision)
+{
+	// Examples from RFC 8949 (appendix A)
+	EXPECT_EQ(std::string("\xF9\x00\x00", 3), SaveToCbor(0.0));
+	EXPECT_EQ(std::string("\xF9\x80\x00", 3), SaveToCbor(-0.0f));
+	EXPECT_EQ(std::string("\xF9\x38\x00", 3), SaveToCbor(0.5));
+	EXPECT_EQ(std::string("\xF9\x3C\x00", 3), SaveToCbor(1.0f));
+	EXPECT_EQ(std::string("\xF9\x7B\xFF", 3), SaveToCbor(65504.0));
+	EXPECT_EQ(std::string("\xF9\x00\x01", 3), SaveToCbor(5.960464477539063e-8));
+	EXPECT_EQ(std::string("\xF9\x04\x00", 3), SaveToCbor(0.00006103515625));
+	EXPECT_EQ(std::string("\xF9\xC4\x00", 3), SaveToCbor(-4.0));
+	EXPECT_EQ(std::string("\xF9\x7C\x00", 3), SaveToCbor(std::numeric_limits<double>::infinity()));
+	EXPECT_EQ(std::string("\xF9\xFC\x00", 3), SaveToCbor(-std::numeric_limits<float>::infinity()));
+	EXPECT_EQ(std::string("\xF9\x7E\x00", 3), SaveToCbor(std::numeric_limits<double>::quiet_NaN()));
+	EXPECT_EQ(std::string("\xFA\x47\xC3\x50\x00", 5), SaveToCbor(100000.0));
+	EXPECT_EQ(std::string("\xFA\x7F\x7F\xFF\xFF", 5), SaveToCbor(3.4028234663852886e+38));
+	EXPECT_EQ(std::string("\xFB\x3F\xF1\x99\x99\x99\x99\x99\x9A", 9), SaveToCbor(1.1));
+}
+
+TEST(CborArchive, LoadHalfPrecisionFloats)
+{
+	EXPECT_EQ(0.5, LoadFromCbor<double>(std::string("\xF9\x38\x00", 3)));
+	EXPECT_EQ(-4.0f, LoadFromCbor<float>(std::string("\xF9\xC4\x00", 3)));
+	EXPECT_EQ(65504.0f, LoadFromCbor<float>(std::string("\xF9\x7B\xFF", 3)));
+	EXPECT_EQ(5.960464477539063e-8, LoadFromCbor<double>(std::string("\xF9\x00\x01", 3)));
+	EXPECT_TRUE(std::isinf(LoadFromCbor<double>(std::string("\xF9\x7C\x00", 3))));
+	EXPECT_TRUE(std::isnan(LoadFromCbor<float>(std::string("\xF9\x7E\x00", 3))));
+}
+
+TEST(CborArchive, SaveStringsInShortestForm)
+{
+	EXPECT_EQ(std::string("\x63" "abc"), SaveToCbor(std::string("abc")));
+	const std::string str24(24, 'a');
+	EXPECT_EQ(std::string("\x78\x18") + str24, SaveToCbor(str24));
+	const std::string str256(256, 'a');
+	EXPECT_EQ(std::string("\x79\x01\x00", 3) + str256, SaveToCbor(str256));
+}
+
+TEST(CborArchive, ShouldLoadStringAsViewToInputData)
+{
+	const std::string data("\x65" "hello");
+	BitSerializer::SerializationOptions options;
+	BitSerializer::SerializationContext context(options);
+	CborArchive::input_archive_type inputArchive(data, context);
+
+	std::string_view actual;
+	ASSERT_TRUE(inputArchive.SerializeValue(actual));
+	EXPECT_EQ("hello", actual);
+	EXPECT_EQ(data.data() + 1, actual.data());
+}
+
+//-----------------------------------------------------------------------------
+// Tests of serialization any of std::string (at root scope of archive)
+//-----------------------------------------------------------------------------
+TEST(CborArchive, SerializeUtf8Sting)
+{
+	TestSerializeType<CborArchive, std::string>("Test ANSI string");
+	TestSerializeType<CborArchive, std::string>(u8"Test UTF8 string - Привет мир!");
+}
+
+TEST(CborArchive, SerializeUnicodeString)
+{
+	TestSerializeType<CborArchive, std::wstring>(L"Test wide string - Привет мир!");
+	TestSerializeType<CborArchive, std::u16string>(u"Test UTF-16 string - Привет мир!");
+	TestSerializeType<CborArchive, std::u32string>(U"Test UTF-32 string - Привет мир!");
+}
+
+TEST(CborArchive, SerializeEnum)
+{
+	TestSerializeType<CborArchive, TestEnum>(TestEnum::Two);
+}
+
+//-----------------------------------------------------------------------------
+// Tests of serialization for c-arrays (at root scope of archive)
+//-----------------------------------------------------------------------------
+TEST(CborArchive, SerializeArrayOfBooleans)
+{
+	TestSerializeArray<CborArchive, bool>();
+}
+
+TEST(CborArchive, SerializeArrayOfChars)
+{
+	TestSerializeArray<CborArchive, char>();
+	TestSerializeArray<CborArchive, unsigned char>();
+}
+
+TEST(CborArchive, SerializeArrayOfIntegers)
+{
+	TestSerializeArray<CborArchive, uint16_t>();
+	TestSerializeArray<CborArchive, int64_t>();
+}
+
+TEST(CborArchive, SerializeArrayOfFloats)
+{
+	TestSerializeVector<CborArchive, float>({ -3.141592654f, 0.0f, -3.141592654f });
+}
+
+TEST(CborArchive, SerializeArrayOfDoubles)
+{
+	TestSerializeArray<CborArchive, double>();
+}
+
+TEST(CborArchive, SerializeArrayOfNullptrs)
+{
+	TestSerializeArray<CborArchive, std::nullptr_t>();
+}
+
+TEST(CborArchive, SerializeArrayOfStrings)
+{
+	TestSerializeArray<CborArchive, std::string>();
+}
+
+TEST(CborArchive, SerializeArrayOfUnicodeStrings)
+{
+	TestSerializeArray<CborArchive, std::wstring>();
+	TestSerializeArray<CborArchive, std::u16string>();
+	TestSerializeArray<CborArchive, std::u32string>();
+}
+
+TEST(CborArchive, SerializeArrayOfClasses)
+{
+	TestSerializeArray<CborArchive, TestPointClass>();
+}
+
+TEST(CborArchive, SerializeTwoDimensionalArray)
+{
+	TestSerializeTwoDimensionalArray<CborArchive, int32_t>();
+}
+
+TEST(CborArchive, ShouldLoadArrayWithExactSize)
+{
+	std::vector<int16_t> expected(1000);
+	for (size_t i = 0; i < expected.size(); ++i) {
+		expected[i] = static_cast<int16_t>(i * 31);
+	}
+	std::vector<int16_t> actual;
+
+	const auto data = BitSerializer::SaveObject<CborArchive>(expected);
+	BitSerializer::LoadObject<CborArchive>(actual, data);
+
+	EXPECT_EQ(expected, actual);
+	EXPECT_EQ(expected.size(), actual.capacity());
+}
+
+//-----------------------------------------------------------------------------
+// Tests of serialization for classes
+//-----------------------------------------------------------------------------
+TEST(CborArchive, SerializeClassWithMemberBoolean)
+{
+	TestSerializeClass<CborArchive>(TestClassWithSubTypes<bool>(false));
+	TestSerializeClass<CborArchive>(TestClassWithSubTypes<bool>(true));
+}
+
+TEST(CborArchive, SerializeClassWithMemberInteger)
+{
+	TestSerializeClass<CborArchive>(BuildFixture<TestClassWithSubTypes<int8_t, uint8_t, int64_t, uint64_t>>());
+	TestSerializeClass<CborArchive>(TestClassWithSubTypes(std::numeric_limits<int64_t>::min(), std::numeric_limits<uint64_t>::max()));
+}
+
+TEST(CborArchive, SerializeClassWithMemberFloat)
+{
+	TestSerializeClass<CborArchive>(TestClassWithSubTypes(std::numeric_limits<float>::lowest(), 0.0f, std::numeric_limits<float>::max()));
+}
+
+TEST(CborArchive, SerializeClassWithMemberDouble)
+{
+	TestSerializeClass<CborArchive>(TestClassWithSubTypes(std::numeric_limits<double>::min(), 0.0, std::numeric_limits<double>::max()));
+}
+
+TEST(CborArchive, SerializeClassWithMemberNullptr)
+{
+	TestSerializeClass<CborArchive>(BuildFixture<TestClassWithSubTypes<std::nullptr_t>>());
+}
+
+TEST(CborArchive, SerializeClassWithMemberString)
+{
+	TestSerializeClass<CborArchive>(BuildFixture<TestClassWithSubTypes<std::string, std::wstring, std::u16string, std::u32string>>());
+}
+
+TEST(CborArchive, SerializeClassHierarchy)
+{
+	TestSerializeClass<CborArchive>(BuildFixture<TestClassWithInheritance>());
+}
+
+TEST(CborArchive, SerializeClassWithMemberClass)
+{
+	using TestClassType = TestClassWithSubTypes<TestClassWithSubTypes<int64_t>>;
+	TestSerializeClass<CborArchive>(BuildFixture<TestClassType>());
+}
+
+TEST(CborArchive, SerializeClassWithSubArray)
+{
+	TestSerializeClass<CborArchive>(BuildFixture<TestClassWithSubArray<int64_t>>());
+}
+
+TEST(CborArchive, SerializeClassWithSubArrayOfClasses)
+{
+	TestSerializeClass<CborArchive>(BuildFixture<TestClassWithSubArray<TestPointClass>>());
+}
+
+TEST(CborArchive, SerializeClassWithSubTwoDimArray)
+{
+	TestSerializeClass<CborArchive>(BuildFixture<TestClassWithSubTwoDimArray<int32_t>>());
+}
+
+TEST(CborArchive, SerializeMapWithMoreThan23Items)
+{
+	std::map<std::string, int> expected;
+	for (int i = 0; i < 100; ++i) {
+		expected.emplace("key" + std::to_string(i), i * 1000);
+	}
+	std::map<std::string, int> actual;
+
+	const auto data = BitSerializer::SaveObject<CborArchive>(expected);
+	EXPECT_EQ(std::string("\xB8\x64", 2), data.substr(0, 2));
+	BitSerializer::LoadObject<CborArchive>(actual, data);
+
+	EXPECT_EQ(expected, actual);
+}
+
+TEST(CborArchive, ShouldLoadValuesInAnyOrder)
+{
+	// Arrange
+	std::string outputData;
+	{
+		BitSerializer::SerializationOptions options;
+		BitSerializer::SerializationContext context(options);
+		CborArchive::output_archive_type outputArchive(outputData, context);
+		auto objScope = outputArchive.OpenObjectScope();
+		int y = 20, x = 10;
+		std::string unknown = "skipped";
+		objScope->SerializeValue("y", y);
+		objScope->SerializeValue("unknown", unknown);
+		objScope->SerializeValue("x", x);
+	}
+	TestPointClass actual(0, 0);
+
+	// Act
+	BitSerializer::LoadObject<CborArchive>(actual, outputData);
+
+	// Assert
+	TestPointClass(10, 20).Assert(actual);
+}
+
+TEST(CborArchive, ShouldIterateKeysInObjectScope)
+{
+	TestIterateKeysInObjectScope<CborArchive>();
+}
+
+//-----------------------------------------------------------------------------
+// Tests of loading indefinite-length items
+//-----------------------------------------------------------------------------
+TEST(CborArchive, ShouldLoadIndefiniteLengthArray)
+{
+	const auto actual = LoadFromCbor<std::vector<int>>(std::string("\x9F\x01\x02\x03\xFF", 5));
+	EXPECT_EQ(std::vector<int>({ 1, 2, 3 }), actual);
+	EXPECT_EQ(3U, actual.capacity());
+}
+
+TEST(CborArchive, ShouldLoadIndefiniteLengthMap)
+{
+	// {_ "x": 10, "z": [_ 1], "y": 20 }, where "z" is unknown field
+	const std::string data("\xBF\x61x\x0A\x61z\x9F\x01\xFF\x61y\x14\xFF");
+	TestPointClass actual(0, 0);
+	BitSerializer::LoadObject<CborArchive>(actual, data);
+	TestPointClass(10, 20).Assert(actual);
+}
+
+TEST(CborArchive, ShouldLoadIndefiniteLengthString)
+{
+	// (_ "strea", "ming")
+	const std::string data("\x7F\x65strea\x64ming\xFF");
+	EXPECT_EQ("streaming", LoadFromCbor<std::string>(data));
+}
+
+TEST(CborArchive, ShouldContinueLoadingAfterIndefiniteLengthItems)
+{
+	// [{_ "x": 1, "y": 2}, {_ "y": 4, "x": 3, "s": (_ "a")}]
+	const std::string data("\x82\xBF\x61x\x01\x61y\x02\xFF\xBF\x61y\x04\x61x\x03\x61s\x7F\x61" "a\xFF\xFF");
+	std::vector<TestPointClass> actual;
+	BitSerializer::LoadObject<CborArchive>(actual, data);
+	ASSERT_EQ(2U, actual.size());
+	TestPointClass(1, 2).Assert(actual[0]);
+	TestPointClass(3, 4).Assert(actual[1]);
+}
+
+TEST(CborArchive, ShouldSkipTagsOfValues)
+{
+	// Tag 55799 (self-described CBOR) and unsigned integer
+	EXPECT_EQ(100, LoadFromCbor<int>(std::string("\xD9\xD9\xF7\x18\x64", 5)));
+}
+
+//-----------------------------------------------------------------------------
+// Tests of serialization datetime as tagged values
+//-----------------------------------------------------------------------------
+TEST(CborArchive, SaveTimePointAsEpochBasedDatetime)
+{
+	using namespace std::chrono;
+	const auto tp = time_point<system_clock, seconds>(seconds(1363896240));
+	EXPECT_EQ(std::string("\xC1\x1A\x51\x4B\x67\xB0", 6), SaveToCbor(tp));
+}
+
+TEST(CborArchive, SaveTimePointWithFractionsAsDatetimeString)
+{
+	using namespace std::chrono;
+	const auto tp = time_point<system_clock, milliseconds>(milliseconds(1363896240500));
+	EXPECT_EQ(std::string("\xC0\x78\x18" "2013-03-21T20:04:00.500Z"), SaveToCbor(tp));
+}
+
+TEST(CborArchive, LoadTimePointFromTaggedValues)
+{
+	using namespace std::chrono;
+	using TimePoint = time_point<system_clock, milliseconds>;
+	const auto expected = TimePoint(milliseconds(1363896240000));
+	// Examples from RFC 8949 (appendix A)
+	EXPECT_EQ(expected, LoadFromCbor<TimePoint>(std::string("\xC0\x74" "2013-03-21T20:04:00Z")));
+	EXPECT_EQ(expected, LoadFromCbor<TimePoint>(std::string("\xC1\x1A\x51\x4B\x67\xB0", 6)));
+	EXPECT_EQ(expected + milliseconds(500), LoadFromCbor<TimePoint>(std::string("\xC1\xFB\x41\xD4\x52\xD9\xEC\x20\x00\x00", 10)));
+}
+
+TEST(CborArchive, SerializeTimePoint)
+{
+	using namespace std::chrono;
+	TestSerializeType<CborArchive>(time_point<system_clock, seconds>(seconds(-2208988800)));
+	TestSerializeType<CborArchive>(time_point<system_clock, nanoseconds>(nanoseconds(1689371091925000001)));
+	TestSerializeClass<CborArchive>(TestClassWithSubType(time_point<system_clock, microseconds>(microseconds(-1))));
+}
+
+TEST(CborArchive, SerializeTimeT)
+{
+	time_t expected = 1363896240, actual = 0;
+	std::string outputData;
+	BitSerializer::SaveObject<CborArchive>(BitSerializer::CTimeRef(expected), outputData);
+	EXPECT_EQ(std::string("\xC1\x1A\x51\x4B\x67\xB0", 6), outputData);
+	BitSerializer::LoadObject<CborArchive>(BitSerializer::CTimeRef(actual), outputData);
+	EXPECT_EQ(expected, actual);
+}
+
+TEST(CborArchive, ThrowMismatchedTypesExceptionWhenLoadInvalidDatetime)
+{
+	std::chrono::system_clock::time_point actual;
+	EXPECT_THROW(BitSerializer::LoadObject<CborArchive>(actual, std::string("\xC0\x63" "abc")), BitSerializer::SerializationException);
+	// The year is too big for parsing
+	const std::string tooBigYear = "99999999999999999999-01-01T00:00:00Z";
+	EXPECT_THROW(BitSerializer::LoadObject<CborArchive>(actual, std::string("\xC0\x78\x24") + tooBigYear), BitSerializer::SerializationException);
+}
+
+//-----------------------------------------------------------------------------
+// Test paths in archive
+//-----------------------------------------------------------------------------
+TEST(CborArchive, ShouldReturnPathInObjectScopeWhenLoading)
+{
+	TestGetPathInJsonObjectScopeWhenLoading<CborArchive>();
+}
+
+TEST(CborArchive, ShouldReturnPathInObjectScopeWhenSaving)
+{
+	TestGetPathInJsonObjectScopeWhenSaving<CborArchive>();
+}
+
+TEST(CborArchive, ShouldReturnPathInArrayScopeWhenLoading)
+{
+	TestGetPathInJsonArrayScopeWhenLoading<CborArchive>();
+}
+
+TEST(CborArchive, ShouldReturnPathInArrayScopeWhenSaving)
+{
+	TestGetPathInJsonArrayScopeWhenSaving<CborArchive>();
+}
+
+//-----------------------------------------------------------------------------
+// Tests streams / files / binary vector
+//-----------------------------------------------------------------------------
+TEST(CborArchive, SerializeClassToStream) {
+	TestSerializeClassToStream<CborArchive, char>(BuildFixture<TestPointClass>());
+}
+
+TEST(CborArchive, SerializeUnicodeToStream) {
+	TestClassWithSubType<std::wstring> TestValue(L"Привет мир!");
+	TestSerializeClassToStream<CborArchive, char>(TestValue);
+}
+
+TEST(CborArchive, SerializeLargeArrayToStream)
+{
+	std::vector<TestPointClass> expected(10000);
+	::BuildFixture(expected);
+	std::vector<TestPointClass> actual;
+
+	std::stringstream outputStream;
+	BitSerializer::SaveObject<CborArchive>(expected, outputStream);
+	EXPECT_EQ(BitSerializer::SaveObject<CborArchive>(expected), outputStream.str());
+	outputStream.seekg(0, std::ios::beg);
+	BitSerializer::LoadObject<CborArchive>(actual, outputStream);
+
+	ASSERT_EQ(expected.size(), actual.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		expected[i].Assert(actual[i]);
+	}
+}
+
+TEST(CborArchive, SerializeLargeArrayOfMapsToStream)
+{
+	// Headers of maps with more than 23 items are shorter than the reserved space
+	std::vector<std::map<std::string, int>> expected(2000);
+	for (size_t i = 0; i < expected.size(); ++i)
+	{
+		for (int k = 0; k < 30; ++k) {
+			expected[i].emplace("key" + std::to_string(k), static_cast<int>(i) + k);
+		}
+	}
+	std::vector<std::map<std::string, int>> actual;
+
+	std::stringstream outputStream;
+	BitSerializer::SaveObject<CborArchive>(expected, outputStream);
+	EXPECT_EQ(BitSerializer::SaveObject<CborArchive>(expected), outputStream.str());
+	outputStream.seekg(0, std::ios::beg);
+	BitSerializer::LoadObject<CborArchive>(actual, outputStream);
+
+	EXPECT_EQ(expected, actual);
+}
+
+TEST(CborArchive, SerializeClassToBinaryVector)
+{
+	auto expected = BuildFixture<TestClassWithSubTypes<int64_t, std::string, double>>();
+	decltype(expected) actual;
+
+	std::vector<uint8_t> outputData;
+	BitSerializer::SaveObject<CborArchive>(expected, outputData);
+	BitSerializer::LoadObject<CborArchive>(actual, outputData);
+
+	expected.Assert(actual);
+}
+
+TEST(CborArchive, SerializeToFile) {
+	TestSerializeArrayToFile<CborArchive>();
+}
+
+//-----------------------------------------------------------------------------
+// Tests of errors handling
+//-----------------------------------------------------------------------------
+TEST(CborArchive, ThrowParsingExceptionWhenInputIsEmpty)
+{
+	int testInt = 0;
+	EXPECT_THROW(BitSerializer::LoadObject<CborArchive>(testInt, std::string()), BitSerializer::ParsingException);
+}
+
+TEST(CborArchive, ThrowParsingExceptionWithCorrectPosition)
+{
+	// Array with three items, where the last one has the reserved additional information (28)
+	const std::string data("\x83\x01\x02\x1C", 4);
+	std::vector<int> testList;
+
+	try
+	{
+		BitSerializer::LoadObject<CborArchive>(testList, data);
+		EXPECT_FALSE(true);
+	}
+	catch (const BitSerializer::ParsingException& ex)
+	{
+		EXPECT_EQ(3U, ex.Offset);
+	}
+	catch (const std::exception&)
+	{
+		EXPECT_FALSE(true);
+	}
+}
+
+TEST(CborArchive, ThrowParsingExceptionWhenUnexpectedBreakCode)
+{
+	std::vector<int> testList;
+	try
+	{
+		BitSerializer::LoadObject<CborArchive>(testList, std::string("\x82\x01\xFF", 3));
+		EXPECT_FALSE(true);
+	}
+	catch (const BitSerializer::ParsingException& ex)
+	{
+		EXPECT_EQ(2U, ex.Offset);
+	}
+}
+
+TEST(CborArchive, ThrowParsingExceptionWhenDataAfterRootValue)
+{
+	auto testObj = BuildFixture<TestPointClass>();
+	const auto data = BitSerializer::SaveObject<CborArchive>(testObj);
+	EXPECT_THROW(BitSerializer::LoadObject<CborArchive>(testObj, data + '\x01'), BitSerializer::ParsingException);
+}
+
+TEST(CborArchive, ThrowParsingExceptionWhenDataIsTruncated)
+{
+	auto testObj = BuildFixture<TestClassWithSubTypes<std::string, int64_t>>();
+	const auto data = BitSerializer::SaveObject<CborArchive>(testObj);
+	for (size_t size = 0; size < data.size(); ++size)
+	{
+		EXPECT_THROW(BitSerializer::LoadObject<CborArchive>(testObj, data.substr(0, size)), BitSerializer::ParsingException);
+	}
+}
+
+//-----------------------------------------------------------------------------
+TEST(CborArchive, ThrowValidationExceptionWhenMissedRequiredValue) {
+	TestValidationForNamedValues<CborArchive, TestClassForCheckValidation<bool>>();
+	TestValidationForNamedValues<CborArchive, TestClassForCheckValidation<int>>();
+	TestValidationForNamedValues<CborArchive, TestClassForCheckValidation<double>>();
+	TestValidationForNamedValues<CborArchive, TestClassForCheckValidation<std::string>>();
+	TestValidationForNamedValues<CborArchive, TestClassForCheckValidation<TestPointClass>>();
+	TestValidationForNamedValues<CborArchive, TestClassForCheckValidation<int[3]>>();
+}
+
+//-----------------------------------------------------------------------------
+TEST(CborArchive, ThrowMismatchedTypesExceptionWhenLoadStringToBoolean) {
+	TestMismatchedTypesPolicy<CborArchive, std::string, bool>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+TEST(CborArchive, ThrowMismatchedTypesExceptionWhenLoadStringToInteger) {
+	TestMismatchedTypesPolicy<CborArchive, std::string, int32_t>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+TEST(CborArchive, ThrowMismatchedTypesExceptionWhenLoadStringToFloat) {
+	TestMismatchedTypesPolicy<CborArchive, std::string, float>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+TEST(CborArchive, ThrowMismatchedTypesExceptionWhenLoadNumberToString) {
+	TestMismatchedTypesPolicy<CborArchive, int32_t, std::string>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+
+TEST(CborArchive, ThrowValidationExceptionWhenLoadStringToBoolean) {
+	TestMismatchedTypesPolicy<CborArchive, std::string, bool>(BitSerializer::MismatchedTypesPolicy::Skip);
+}
+TEST(CborArchive, ThrowValidationExceptionWhenLoadStringToInteger) {
+	TestMismatchedTypesPolicy<CborArchive, std::string, int32_t>(BitSerializer::MismatchedTypesPolicy::Skip);
+}
+TEST(CborArchive, ThrowValidationExceptionWhenLoadStringToFloat) {
+	TestMismatchedTypesPolicy<CborArchive, std::string, float>(BitSerializer::MismatchedTypesPolicy::Skip);
+}
+TEST(CborArchive, ThrowValidationExceptionWhenLoadNullToAnyType) {
+	// It doesn't matter what kind of MismatchedTypesPolicy is used, should throw only validation exception
+	TestMismatchedTypesPolicy<CborArchive, std::nullptr_t, bool>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+	TestMismatchedTypesPolicy<CborArchive, std::nullptr_t, uint32_t>(BitSerializer::MismatchedTypesPolicy::Skip);
+	TestMismatchedTypesPolicy<CborArchive, std::nullptr_t, double>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+	TestMismatchedTypesPolicy<CborArchive, std::nullptr_t, std::string>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+
+//-----------------------------------------------------------------------------
+
+TEST(CborArchive, ThrowSerializationExceptionWhenOverflowBool) {
+	TestOverflowNumberPolicy<CborArchive, int32_t, bool>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(CborArchive, ThrowSerializationExceptionWhenOverflowInt8) {
+	TestOverflowNumberPolicy<CborArchive, int16_t, int8_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<CborArchive, uint16_t, uint8_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(CborArchive, ThrowSerializationExceptionWhenOverflowInt16) {
+	TestOverflowNumberPolicy<CborArchive, int32_t, int16_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<CborArchive, uint32_t, uint16_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(CborArchive, ThrowSerializationExceptionWhenOverflowInt32) {
+	TestOverflowNumberPolicy<CborArchive, int64_t, int32_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<CborArchive, uint64_t, uint32_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(CborArchive, ThrowSerializationExceptionWhenOverflowFloat) {
+	TestOverflowNumberPolicy<CborArchive, double, float>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(CborArchive, ThrowSerializationExceptionWhenLoadFloatToInteger) {
+	TestOverflowNumberPolicy<CborArchive, float, uint32_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<CborArchive, double, uint32_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(CborArchive, ThrowSerializationExceptionWhenLoadNegativeToUnsigned)
+{
+	uint64_t actual = 0;
+	const auto data = SaveToCbor(int64_t(-1));
+	try
+	{
+		BitSerializer::LoadObject<CborArchive>(actual, data);
+		EXPECT_FALSE(true);
+	}
+	catch (const BitSerializer::SerializationException& ex)
+	{
+		EXPECT_EQ(BitSerializer::SerializationErrorCode::Overflow, ex.GetErrorCode());
+	}
+}
+
+TEST(CborArchive, ThrowValidationExceptionWhenOverflowBool) {
+	TestOverflowNumberPolicy<CborArchive, int32_t, bool>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(CborArchive, ThrowValidationExceptionWhenNumberOverflowInt8) {
+	TestOverflowNumberPolicy<CborArchive, int16_t, int8_t>(BitSerializer::OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<CborArchive, uint16_t, uint8_t>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(CborArchive, ThrowValidationExceptionWhenNumberOverflowInt16) {
+	TestOverflowNumberPolicy<CborArchive, int32_t, int16_t>(BitSerializer::OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<CborArchive, uint32_t, uint16_t>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(CborArchive, ThrowValidationExceptionWhenNumberOverflowInt32) {
+	TestOverflowNumberPolicy<CborArchive, int64_t, int32_t>(BitSerializer::OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<CborArchive, uint64_t, uint32_t>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(CborArchive, ThrowValidationExceptionWhenNumberOverflowFloat) {
+	TestOverflowNumberPolicy<CborArchive, double, float>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(CborArchive, ThrowValidationExceptionWhenLoadFloatToInteger) {
+	TestOverflowNumberPolicy<CborArchive, float, uint32_t>(BitSerializer::OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<CborArchive, double, uint32_t>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+
+
+#pragma warning(pop)
@@ -0,0 +1,494 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include "testing_tools/common_test_methods.h"
+#include "bitserializer/columnar_archive.h"
+#include "bitserializer/types/std/optional.h"
+
+using namespace BitSerializer;
+using BitSerializer::Columnar::ColumnarArchive;
+
+namespace
+{
+	/// <summary>
+	/// Test row with the nullable field (null is saved when the value is not set).
+	/// </summary>
+	class TestNullableRow
+	{
+	public:
+		template <class TArchive>
+		void Serialize(TArchive& archive)
+		{
+			archive << MakeAutoKeyValue("id", id);
+			archive << MakeAutoKeyValue("value", value);
+		}
+
+		int id = 0;
+		std::optional<int> value;
+	};
+
+	class TestRowWithCategory
+	{
+	public:
+		template <class TArchive>
+		void Serialize(TArchive& archive)
+		{
+			archive << MakeAutoKeyValue("id", id);
+			archive << MakeAutoKeyValue("category", category);
+		}
+
+		int64_t id = 0;
+		std::string category;
+	};
+}
+
+//-----------------------------------------------------------------------------
+// Tests of serialization for arrays of flat objects
+//-----------------------------------------------------------------------------
+TEST(ColumnarArchive, SerializeArrayOfClasses)
+{
+	TestSerializeArray<ColumnarArchive, TestPointClass>();
+}
+
+TEST(ColumnarArchive, SerializeArrayOfClassesWithAllTypes)
+{
+	using TestType = TestClassWithSubTypes<bool, char, uint8_t, int16_t, uint16_t, int32_t, uint32_t, int64_t, uint64_t,
+		float, double, std::string, std::wstring>;
+	TestSerializeArray<ColumnarArchive, TestType, 100, 100>();
+}
+
+TEST(ColumnarArchive, SerializeArrayOfClassesWithMinMaxValues)
+{
+	using TestType = TestClassWithSubTypes<int8_t, uint8_t, int64_t, uint64_t, float, double>;
+	std::vector<TestType> expected = {
+		{ std::numeric_limits<int8_t>::min(), std::numeric_limits<uint8_t>::max(), std::numeric_limits<int64_t>::min(),
+			std::numeric_limits<uint64_t>::max(), std::numeric_limits<float>::lowest(), std::numeric_limits<double>::max() },
+		{ std::numeric_limits<int8_t>::max(), 0, std::numeric_limits<int64_t>::max(), 0, std::numeric_limits<float>::max(),
+			std::numeric_limits<double>::lowest() },
+		{ 0, std::numeric_limits<uint8_t>::min(), 0, 1, 0.0f, 0.0 }
+	};
+	std::vector<TestType> actual;
+
+	const auto outputData = BitSerializer::SaveObject<ColumnarArchive>(expected);
+	BitSerializer::LoadObject<ColumnarArchive>(actual, outputData);
+
+	ASSERT_EQ(expected.size(), actual.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		expected[i].Assert(actual[i]);
+	}
+}
+
+TEST(ColumnarArchive, SerializeArrayOfClassesWithNullValues)
+{
+	TestSerializeArray<ColumnarArchive, TestClassWithSubTypes<std::nullptr_t, int>>();
+}
+
+TEST(ColumnarArchive, SerializeColumnWithSomeNullValues)
+{
+	std::vector<TestNullableRow> expected(100);
+	for (size_t i = 0; i < expected.size(); ++i)
+	{
+		expected[i].id = static_cast<int>(i);
+		if (i % 3 != 0) {
+			expected[i].value = static_cast<int>(i * 10);
+		}
+	}
+	std::vector<TestNullableRow> actual;
+
+	const auto outputData = BitSerializer::SaveObject<ColumnarArchive>(expected);
+	BitSerializer::LoadObject<ColumnarArchive>(actual, outputData);
+
+	ASSERT_EQ(expected.size(), actual.size());
+	for (size_t i = 0; i < expected.size(); ++i)
+	{
+		EXPECT_EQ(expected[i].id, actual[i].id);
+		EXPECT_EQ(expected[i].value, actual[i].value);
+	}
+}
+
+TEST(ColumnarArchive, SerializeEmptyArray)
+{
+	std::vector<TestPointClass> expected, actual = { { 1, 2 } };
+	const auto outputData = BitSerializer::SaveObject<ColumnarArchive>(expected);
+	BitSerializer::LoadObject<ColumnarArchive>(actual, outputData);
+	EXPECT_TRUE(actual.empty());
+}
+
+TEST(ColumnarArchive, ShouldLoadValuesInAnyOrder)
+{
+	// Arrange
+	std::string outputData;
+	{
+		SerializationOptions options;
+		SerializationContext context(options);
+		ColumnarArchive::output_archive_type outputArchive(outputData, context);
+		{
+			auto arrayScope = outputArchive.OpenArrayScope(2);
+			for (int i = 1; i <= 2; ++i)
+			{
+				auto objScope = arrayScope->OpenObjectScope();
+				int y = i * 20, unknown = 0, x = i * 10;
+				objScope->SerializeValue("y", y);
+				objScope->SerializeValue("unknown", unknown);
+				objScope->SerializeValue("x", x);
+			}
+		}
+		outputArchive.Finalize();
+	}
+	std::vector<TestPointClass> actual;
+
+	// Act
+	BitSerializer::LoadObject<ColumnarArchive>(actual, outputData);
+
+	// Assert
+	ASSERT_EQ(2U, actual.size());
+	TestPointClass(10, 20).Assert(actual[0]);
+	TestPointClass(20, 40).Assert(actual[1]);
+}
+
+//-----------------------------------------------------------------------------
+// Tests of encoding
+//-----------------------------------------------------------------------------
+TEST(ColumnarArchive, ShouldUseDeltaEncodingForSequentialIntegers)
+{
+	// Arrange
+	std::vector<TestClassWithSubTypes<int64_t>> testList(1000);
+	for (size_t i = 0; i < testList.size(); ++i) {
+		std::get<0>(testList[i]) = 1000000000000 + static_cast<int64_t>(i);
+	}
+
+	// Act
+	const auto outputData = BitSerializer::SaveObject<ColumnarArchive>(testList);
+
+	// Assert (each value should take less than one byte)
+	EXPECT_LT(outputData.size(), testList.size());
+	std::vector<TestClassWithSubTypes<int64_t>> actual;
+	BitSerializer::LoadObject<ColumnarArchive>(actual, outputData);
+	ASSERT_EQ(testList.size(), actual.size());
+	for (size_t i = 0; i < testList.size(); ++i) {
+		testList[i].Assert(actual[i]);
+	}
+}
+
+TEST(ColumnarArchive, ShouldUseDictionaryForRepeatedStrings)
+{
+	// Arrange
+	const char* categories[] = { "electronics", "books", "garden", "toys" };
+	std::vector<TestRowWithCategory> testList(1000);
+	for (size_t i = 0; i < testList.size(); ++i)
+	{
+		testList[i].id = static_cast<int64_t>(i);
+		testList[i].category = categories[i % std::size(categories)];
+	}
+
+	// Act
+	const auto outputData = BitSerializer::SaveObject<ColumnarArchive>(testList);
+
+	// Assert (each string should be encoded by two bits of index)
+	EXPECT_LT(outputData.size(), testList.size() * 2);
+	std::vector<TestRowWithCategory> actual;
+	BitSerializer::LoadObject<ColumnarArchive>(actual, outputData);
+	ASSERT_EQ(testList.size(), actual.size());
+	for (size_t i = 0; i < testList.size(); ++i)
+	{
+		EXPECT_EQ(testList[i].id, actual[i].id);
+		EXPECT_EQ(testList[i].category, actual[i].category);
+	}
+}
+
+TEST(ColumnarArchive, SerializeUniqueStrings)
+{
+	std::vector<TestRowWithCategory> expected(100);
+	for (size_t i = 0; i < expected.size(); ++i)
+	{
+		expected[i].id = static_cast<int64_t>(i) * -7;
+		expected[i].category = std::string(i % 10, 'a') + std::to_string(i);
+	}
+	std::vector<TestRowWithCategory> actual;
+
+	const auto outputData = BitSerializer::SaveObject<ColumnarArchive>(expected);
+	BitSerializer::LoadObject<ColumnarArchive>(actual, outputData);
+
+	ASSERT_EQ(expected.size(), actual.size());
+	for (size_t i = 0; i < expected.size(); ++i)
+	{
+		EXPECT_EQ(expected[i].id, actual[i].id);
+		EXPECT_EQ(expected[i].category, actual[i].category);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Test paths in archive
+//-----------------------------------------------------------------------------
+TEST(ColumnarArchive, ShouldReturnPathInArrayScopeWhenLoading)
+{
+	// Arrange
+	TestPointClass testList[3];
+	::BuildFixture(testList);
+
+	std::string outputData;
+	BitSerializer::SaveObject<ColumnarArchive>(testList, outputData);
+
+	// Act / Assert
+	SerializationOptions options;
+	SerializationContext context(options);
+	ColumnarArchive::input_archive_type inputArchive(outputData, context);
+	ASSERT_EQ(inputArchive.GetPath(), "");
+
+	auto rootArrayScope = inputArchive.OpenArrayScope(3);
+	ASSERT_TRUE(rootArrayScope.has_value());
+
+	for (size_t k = 0; k < 3; k++)
+	{
+		auto objectScope = rootArrayScope->OpenObjectScope();
+		ASSERT_TRUE(objectScope.has_value());
+
+		ASSERT_EQ(ColumnarArchive::path_separator + Convert::ToString(k), rootArrayScope->GetPath());
+		ASSERT_EQ(ColumnarArchive::path_separator + Convert::ToString(k), objectScope->GetPath());
+	}
+}
+
+TEST(ColumnarArchive, ShouldReturnPathInArrayScopeWhenSaving)
+{
+	// Arrange
+	std::string outputData;
+	SerializationOptions options;
+	SerializationContext context(options);
+	ColumnarArchive::output_archive_type outputArchive(outputData, context);
+
+	// Act / Assert
+	auto rootArrayScope = outputArchive.OpenArrayScope(3);
+	ASSERT_TRUE(rootArrayScope.has_value());
+	for (size_t k = 0; k < 3; k++)
+	{
+		auto objectScope = rootArrayScope->OpenObjectScope();
+		ASSERT_TRUE(objectScope.has_value());
+
+		ASSERT_EQ(ColumnarArchive::path_separator + Convert::ToString(k), rootArrayScope->GetPath());
+		ASSERT_EQ(ColumnarArchive::path_separator + Convert::ToString(k), objectScope->GetPath());
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Tests streams / files / binary vector
+//-----------------------------------------------------------------------------
+TEST(ColumnarArchive, SerializeArrayToStream)
+{
+	TestClassWithSubType<std::wstring> testArray[3] = {
+		TestClassWithSubType<std::wstring>(L"Привет мир!"),
+		TestClassWithSubType<std::wstring>(L"Hello world!"),
+		TestClassWithSubType<std::wstring>(L"") };
+	TestSerializeArrayToStream<ColumnarArchive, char>(testArray);
+}
+
+TEST(ColumnarArchive, SerializeArrayToBinaryVector)
+{
+	std::vector<TestClassWithSubTypes<int64_t, std::string, double>> expected(10), actual;
+	::BuildFixture(expected);
+
+	std::vector<uint8_t> outputData;
+	BitSerializer::SaveObject<ColumnarArchive>(expected, outputData);
+	BitSerializer::LoadObject<ColumnarArchive>(actual, outputData);
+
+	ASSERT_EQ(expected.size(), actual.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		expected[i].Assert(actual[i]);
+	}
+}
+
+TEST(ColumnarArchive, SerializeToFile) {
+	TestSerializeArrayToFile<ColumnarArchive>();
+}
+
+//-----------------------------------------------------------------------------
+// Tests of errors handling
+//-----------------------------------------------------------------------------
+TEST(ColumnarArchive, ThrowParsingExceptionWhenInputIsEmpty)
+{
+	std::vector<TestPointClass> actual;
+	EXPECT_THROW(BitSerializer::LoadObject<ColumnarArchive>(actual, std::string()), BitSerializer::ParsingException);
+}
+
+TEST(ColumnarArchive, ThrowParsingExceptionWhenSignatureIsInvalid)
+{
+	std::vector<TestPointClass> testList(3), actual;
+	auto outputData = BitSerializer::SaveObject<ColumnarArchive>(testList);
+	outputData[0] = 'X';
+	EXPECT_THROW(BitSerializer::LoadObject<ColumnarArchive>(actual, outputData), BitSerializer::ParsingException);
+}
+
+TEST(ColumnarArchive, ThrowParsingExceptionWhenDataIsTruncated)
+{
+	std::vector<TestClassWithSubTypes<int, std::string, double, bool>> testList(10), actual;
+	::BuildFixture(testList);
+	const auto outputData = BitSerializer::SaveObject<ColumnarArchive>(testList);
+	for (size_t size = 0; size < outputData.size(); ++size)
+	{
+		EXPECT_THROW(BitSerializer::LoadObject<ColumnarArchive>(actual, outputData.substr(0, size)), BitSerializer::ParsingException)
+			<< "Size: " << size;
+	}
+}
+
+TEST(ColumnarArchive, ThrowParsingExceptionWhenRowsCountIsInvalid)
+{
+	std::vector<TestPointClass> actual;
+	// Huge number of rows without columns
+	const std::string data("BSCL\x01\xff\xff\xff\xff\x0f\x00", 11);
+	EXPECT_THROW(BitSerializer::LoadObject<ColumnarArchive>(actual, data), BitSerializer::ParsingException);
+
+	// Huge number of rows with column of integers which has zero width of values
+	const std::string dataWithColumn("BSCL\x01\xff\xff\xff\xff\x0f\x01\x01x\x03\x00\x00\x01\x00", 18);
+	EXPECT_THROW(BitSerializer::LoadObject<ColumnarArchive>(actual, dataWithColumn), BitSerializer::ParsingException);
+}
+
+TEST(ColumnarArchive, SerializeColumnsWithZeroValues)
+{
+	std::vector<TestClassWithSubTypes<int, std::string, std::nullptr_t>> expected(3), actual;
+	const auto outputData = BitSerializer::SaveObject<ColumnarArchive>(expected);
+	BitSerializer::LoadObject<ColumnarArchive>(actual, outputData);
+	ASSERT_EQ(expected.size(), actual.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		expected[i].Assert(actual[i]);
+	}
+}
+
+TEST(ColumnarArchive, ThrowSerializationExceptionWhenObjectsHaveDifferentFields)
+{
+	std::string outputData;
+	SerializationOptions options;
+	SerializationContext context(options);
+	ColumnarArchive::output_archive_type outputArchive(outputData, context);
+	auto arrayScope = outputArchive.OpenArrayScope(2);
+	{
+		auto objScope = arrayScope->OpenObjectScope();
+		int x = 10;
+		objScope->SerializeValue("x", x);
+	}
+
+	auto objScope = arrayScope->OpenObjectScope();
+	int y = 20;
+	try
+	{
+		objScope->SerializeValue("y", y);
+		EXPECT_FALSE(true);
+	}
+	catch (const SerializationException& ex)
+	{
+		EXPECT_EQ(SerializationErrorCode::OutOfRange, ex.GetErrorCode());
+	}
+}
+
+TEST(ColumnarArchive, ThrowSerializationExceptionWhenObjectHasLessFields)
+{
+	std::string outputData;
+	SerializationOptions options;
+	SerializationContext context(options);
+	ColumnarArchive::output_archive_type outputArchive(outputData, context);
+	{
+		auto arrayScope = outputArchive.OpenArrayScope(2);
+		{
+			auto objScope = arrayScope->OpenObjectScope();
+			int x = 10, y = 20;
+			objScope->SerializeValue("x", x);
+			objScope->SerializeValue("y", y);
+		}
+		{
+			auto objScope = arrayScope->OpenObjectScope();
+			int x = 10;
+			objScope->SerializeValue("x", x);
+		}
+	}
+
+	try
+	{
+		outputArchive.Finalize();
+		EXPECT_FALSE(true);
+	}
+	catch (const SerializationException& ex)
+	{
+		EXPECT_EQ(SerializationErrorCode::OutOfRange, ex.GetErrorCode());
+	}
+}
+
+TEST(ColumnarArchive, ThrowValidationExceptionWhenMissedRequiredValue) {
+	TestValidationForNamedValues<ColumnarArchive, TestClassForCheckValidation<int>>();
+}
+
+//-----------------------------------------------------------------------------
+TEST(ColumnarArchive, ThrowMismatchedTypesExceptionWhenLoadStringToBoolean) {
+	TestMismatchedTypesPolicy<ColumnarArchive, std::string, bool>(MismatchedTypesPolicy::ThrowError);
+}
+TEST(ColumnarArchive, ThrowMismatchedTypesExceptionWhenLoadStringToInteger) {
+	TestMismatchedTypesPolicy<ColumnarArchive, std::string, int32_t>(MismatchedTypesPolicy::ThrowError);
+}
+TEST(ColumnarArchive, ThrowMismatchedTypesExceptionWhenLoadStringToFloat) {
+	TestMismatchedTypesPolicy<ColumnarArchive, std::string, float>(MismatchedTypesPolicy::ThrowError);
+}
+TEST(ColumnarArchive, ThrowMismatchedTypesExceptionWhenLoadNumberToString) {
+	TestMismatchedTypesPolicy<ColumnarArchive, int32_t, std::string>(MismatchedTypesPolicy::ThrowError);
+}
+
+TEST(ColumnarArchive, ThrowValidationExceptionWhenLoadStringToBoolean) {
+	TestMismatchedTypesPolicy<ColumnarArchive, std::string, bool>(MismatchedTypesPolicy::Skip);
+}
+TEST(ColumnarArchive, ThrowValidationExceptionWhenLoadStringToInteger) {
+	TestMismatchedTypesPolicy<ColumnarArchive, std::string, int32_t>(MismatchedTypesPolicy::Skip);
+}
+TEST(ColumnarArchive, ThrowValidationExceptionWhenLoadStringToFloat) {
+	TestMismatchedTypesPolicy<ColumnarArchive, std::string, float>(MismatchedTypesPolicy::Skip);
+}
+TEST(ColumnarArchive, ThrowValidationExceptionWhenLoadNullToAnyType) {
+	// It doesn't matter what kind of MismatchedTypesPolicy is used, should throw only validation exception
+	TestMismatchedTypesPolicy<ColumnarArchive, std::nullptr_t, bool>(MismatchedTypesPolicy::ThrowError);
+	TestMismatchedTypesPolicy<ColumnarArchive, std::nullptr_t, uint32_t>(MismatchedTypesPolicy::Skip);
+	TestMismatchedTypesPolicy<ColumnarArchive, std::nullptr_t, double>(MismatchedTypesPolicy::ThrowError);
+	TestMismatchedTypesPolicy<ColumnarArchive, std::nullptr_t, std::string>(MismatchedTypesPolicy::ThrowError);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ColumnarArchive, ThrowSerializationExceptionWhenOverflowBool) {
+	TestOverflowNumberPolicy<ColumnarArchive, int32_t, bool>(OverflowNumberPolicy::ThrowError);
+}
+TEST(ColumnarArchive, ThrowSerializationExceptionWhenOverflowInt8) {
+	TestOverflowNumberPolicy<ColumnarArchive, int16_t, int8_t>(OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<ColumnarArchive, uint16_t, uint8_t>(OverflowNumberPolicy::ThrowError);
+}
+TEST(ColumnarArchive, ThrowSerializationExceptionWhenOverflowInt16) {
+	TestOverflowNumberPolicy<ColumnarArchive, int32_t, int16_t>(OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<ColumnarArchive, uint32_t, uint16_t>(OverflowNumberPolicy::ThrowError);
+}
+TEST(ColumnarArchive, ThrowSerializationExceptionWhenOverflowInt32) {
+	TestOverflowNumberPolicy<ColumnarArchive, int64_t, int32_t>(OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<ColumnarArchive, uint64_t, uint32_t>(OverflowNumberPolicy::ThrowError);
+}
+TEST(ColumnarArchive, ThrowSerializationExceptionWhenOverflowFloat) {
+	TestOverflowNumberPolicy<ColumnarArchive, double, float>(OverflowNumberPolicy::ThrowError);
+}
+TEST(ColumnarArchive, ThrowSerializationExceptionWhenLoadFloatToInteger) {
+	TestOverflowNumberPolicy<ColumnarArchive, float, uint32_t>(OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<ColumnarArchive, double, uint32_t>(OverflowNumberPolicy::ThrowError);
+}
+
+TEST(ColumnarArchive, ThrowValidationExceptionWhenOverflowBool) {
+	TestOverflowNumberPolicy<ColumnarArchive, int32_t, bool>(OverflowNumberPolicy::Skip);
+}
+TEST(ColumnarArchive, ThrowValidationExceptionWhenNumberOverflowInt8) {
+	TestOverflowNumberPolicy<ColumnarArchive, int16_t, int8_t>(OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<ColumnarArchive, uint16_t, uint8_t>(OverflowNumberPolicy::Skip);
+}
+TEST(ColumnarArchive, ThrowValidationExceptionWhenNumberOverflowInt16) {
+	TestOverflowNumberPolicy<ColumnarArchive, int32_t, int16_t>(OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<ColumnarArchive, uint32_t, uint16_t>(OverflowNumberPolicy::Skip);
+}
+TEST(ColumnarArchive, ThrowValidationExceptionWhenNumberOverflowInt32) {
+	TestOverflowNumberPolicy<ColumnarArchive, int64_t, int32_t>(OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<ColumnarArchive, uint64_t, uint32_t>(OverflowNumberPolicy::Skip);
+}
+TEST(ColumnarArchive, ThrowValidationExceptionWhenNumberOverflowFloat) {
+	TestOverflowNumberPolicy<ColumnarArchive, double, float>(OverflowNumberPolicy::Skip);
+}
+TEST(ColumnarArchive, ThrowValidationExceptionWhenLoadFloatToInteger) {
+	TestOverflowNumberPolicy<ColumnarArchive, float, uint32_t>(OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<ColumnarArchive, double, uint32_t>(OverflowNumberPolicy::Skip);
+}
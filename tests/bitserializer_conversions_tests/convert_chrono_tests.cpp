@@ -56,6 +56,24 @@ TEST(ConvertChrono, ConvertTimePointWithMsToUtcString) {
 	EXPECT_EQ(L"9999-12-31T23:59:59.999Z", Convert::To<std::wstring>(tp9999_12_31T23_59_59 + 999ms));
 }
 
+TEST(ConvertChrono, ConvertTimePointWithUsAndNsToUtcString) {
+	EXPECT_EQ("1970-01-01T00:00:00.000001Z", Convert::ToString(TimePointNs(1us)));
+	EXPECT_EQ("1968-12-31T23:59:59.123456Z", Convert::ToString(TimePointNs(tp1968_12_31T23_59_59) + 123456us));
+	EXPECT_EQ(u"2044-01-01T00:00:00.000000001Z", Convert::To<std::u16string>(TimePointNs(tp2044_01_01T00_00_00) + 1ns));
+	EXPECT_EQ("2262-04-11T23:47:16.854775807Z", Convert::ToString(TimePointNs::max()));
+	EXPECT_EQ("1677-09-21T00:12:43.145224192Z", Convert::ToString(TimePointNs::min()));
+	// Precision should be reduced to milliseconds when it is enough
+	EXPECT_EQ("1970-01-01T00:00:00.250Z", Convert::ToString(TimePointNs(250ms)));
+}
+
+TEST(ConvertChrono, ConvertTimePointsWithinSameDayToUtcString) {
+	EXPECT_EQ("2044-01-01T00:00:00Z", Convert::ToString(tp2044_01_01T00_00_00));
+	EXPECT_EQ("2044-01-01T10:20:30Z", Convert::ToString(tp2044_01_01T00_00_00 + 10h + 20min + 30s));
+	EXPECT_EQ("2044-01-01T23:59:59.999Z", Convert::ToString(tp2044_01_01T00_00_00 + 24h - 1ms));
+	EXPECT_EQ("2044-01-02T00:00:00Z", Convert::ToString(tp2044_01_01T00_00_00 + 24h));
+	EXPECT_EQ("2043-12-31T23:59:59Z", Convert::ToString(tp2044_01_01T00_00_00 - 1s));
+}
+
 TEST(ConvertChrono, ConvertTimePointToUtcStringMaxValues) {
 	using days_i32 = duration<int32_t, std::ratio<86400>>;
 	using TimePointDaysI32Rep = time_point<system_clock, days_i32>;
@@ -89,6 +107,23 @@ TEST(ConvertChrono, ConvertUtcStringWithMsToTimePoint) {
 	EXPECT_EQ(tp9999_12_31T23_59_59 + 999ms, Convert::To<TimePointMs>(L"9999-12-31T23:59:59.999Z"));
 }
 
+TEST(ConvertChrono, ConvertUtcStringWithUsAndNsToTimePoint) {
+	EXPECT_EQ(TimePointNs(1us), Convert::To<TimePointNs>("1970-01-01T00:00:00.000001Z"));
+	EXPECT_EQ(TimePointNs(tp1968_12_31T23_59_59) + 123456us, Convert::To<TimePointNs>("1968-12-31T23:59:59.123456Z"));
+	EXPECT_EQ(TimePointNs(tp2044_01_01T00_00_00) + 1ns, Convert::To<TimePointNs>(u"2044-01-01T00:00:00.000000001Z"));
+	EXPECT_EQ(TimePointNs::max(), Convert::To<TimePointNs>(U"2262-04-11T23:47:16.854775807Z"));
+	EXPECT_EQ(TimePointNs(tp1970_01_01T00_00_00) + 1230us, Convert::To<TimePointNs>("1970-01-01T00:00:00.00123Z"));
+	EXPECT_EQ(tp1970_01_01T00_00_00 + 100ms, Convert::To<TimePointMs>("1970-01-01T00:00:00.100000Z"));
+}
+
+TEST(ConvertChrono, ConvertUtcStringsWithinSameDayToTimePoint) {
+	EXPECT_EQ(tp2044_01_01T00_00_00, Convert::To<TimePointMs>("2044-01-01T00:00:00Z"));
+	EXPECT_EQ(tp2044_01_01T00_00_00 + 10h + 20min + 30s, Convert::To<TimePointMs>("2044-01-01T10:20:30Z"));
+	EXPECT_EQ(tp2044_01_01T00_00_00 + 24h - 1ms, Convert::To<TimePointMs>("2044-01-01T23:59:59.999Z"));
+	EXPECT_EQ(tp2044_01_01T00_00_00 + 24h, Convert::To<TimePointMs>("2044-01-02T00:00:00Z"));
+	EXPECT_EQ(tp2044_01_01T00_00_00 - 1s, Convert::To<TimePointMs>("2043-12-31T23:59:59Z"));
+}
+
 TEST(ConvertChrono, ConvertUtcStringToTimePointMaxValues) {
 	using days_i32 = duration<int32_t, std::ratio<86400>>;
 	using TimePointDaysI32Rep = time_point<system_clock, days_i32>;
@@ -126,7 +161,19 @@ TEST(ConvertChrono, ConvertUtcStringShouldThrowExceptionWhenInvalidTime) {
 	EXPECT_THROW(Convert::To<TimePointMs>("1970-01-01T25:00:00Z"), std::invalid_argument);
 	EXPECT_THROW(Convert::To<TimePointMs>("1970-01-01T00:60:00Z"), std::invalid_argument);
 	EXPECT_THROW(Convert::To<TimePointMs>("1970-01-01T00:00:60Z"), std::invalid_argument);
-	EXPECT_THROW(Convert::To<TimePointMs>("1970-01-01T00:00:00.1000Z"), std::invalid_argument);
+	EXPECT_THROW(Convert::To<TimePointMs>("1970-01-01T00:00:00.1000000000Z"), std::invalid_argument);
+}
+
+TEST(ConvertChrono, ConvertUtcStringShouldThrowExceptionWhenTooManyFractionDigits) {
+	EXPECT_THROW(Convert::To<TimePointNs>("1970-01-01T00:00:00.9999999999Z"), std::invalid_argument);
+	EXPECT_THROW(Convert::To<TimePointNs>("1970-01-01T00:00:00.99999999999999999999Z"), std::invalid_argument);
+	EXPECT_THROW(Convert::To<TimePointNs>(u"1970-01-01T00:00:00.1234567890Z"), std::invalid_argument);
+}
+
+TEST(ConvertChrono, ConvertUtcStringShouldThrowExceptionWhenWideStringIsTooLong) {
+	const std::u16string tooLongStr = u"1970-01-01T00:00:00Z" + std::u16string(100, u' ');
+	EXPECT_THROW(Convert::To<TimePointNs>(tooLongStr), std::invalid_argument);
+	EXPECT_THROW(Convert::To<TimePointNs>(U"1970-01-01T00:00:00.000000000" + std::u32string(100, U'0') + U"Z"), std::invalid_argument);
 }
 
 TEST(ConvertChrono, ConvertUtcStringShouldThrowExceptionWhenEmpty) {
@@ -145,6 +192,7 @@ TEST(ConvertChrono, ConvertUtcStringShouldThrowExceptionWhenOverflow) {
 	EXPECT_THROW(Convert::To<TimePointNs>("1677-09-21T00:12:43Z"), std::out_of_range);
 	EXPECT_THROW(Convert::To<TimePointNs>("2262-04-11T23:47:17Z"), std::out_of_range);
 	EXPECT_THROW(Convert::To<TimePointNs>("2262-04-11T23:47:16.855Z"), std::out_of_range);
+	EXPECT_THROW(Convert::To<TimePointMs>("1970-01-01T00:00:00.0001Z"), std::out_of_range);
 
 	using days_i32 = duration<int32_t, std::ratio<86400>>;
 	using TimePointDaysI32Rep = time_point<system_clock, days_i32>;
@@ -6,6 +6,25 @@
 
 using namespace BitSerializer;
 
+namespace
+{
+	enum class TestSparseEnum : int16_t {
+		Negative = -1000,
+		Zero = 0,
+		Big = 30000,
+		BigAlias = 30000,
+		UpperCase = 5
+	};
+}
+
+REGISTER_ENUM(TestSparseEnum, {
+	{ TestSparseEnum::Negative, "Negative" },
+	{ TestSparseEnum::Zero, "Zero" },
+	{ TestSparseEnum::Big, "Big" },
+	{ TestSparseEnum::BigAlias, "BigAlias" },
+	{ TestSparseEnum::UpperCase, "ZERO" }
+})
+
 //-----------------------------------------------------------------------------
 // Test conversion for enum types
 //-----------------------------------------------------------------------------
@@ -63,6 +82,31 @@ TEST(ConvertEnums, ConvertEnumChainFromStream) {
 }
 
 
+TEST(ConvertEnums, SparseEnumToString) {
+	EXPECT_EQ("Negative", Convert::ToString(TestSparseEnum::Negative));
+	EXPECT_EQ("Zero", Convert::ToString(TestSparseEnum::Zero));
+	EXPECT_EQ("Big", Convert::ToString(TestSparseEnum::BigAlias));
+	EXPECT_EQ(u"ZERO", Convert::To<std::u16string>(TestSparseEnum::UpperCase));
+}
+
+TEST(ConvertEnums, SparseEnumFromString) {
+	EXPECT_EQ(TestSparseEnum::Negative, Convert::To<TestSparseEnum>("negative"));
+	EXPECT_EQ(TestSparseEnum::BigAlias, Convert::To<TestSparseEnum>(U"BIGALIAS"));
+}
+
+TEST(ConvertEnums, ShouldPreferExactMatchOfEnumName) {
+	EXPECT_EQ(TestSparseEnum::Zero, Convert::To<TestSparseEnum>("Zero"));
+	EXPECT_EQ(TestSparseEnum::UpperCase, Convert::To<TestSparseEnum>(u"ZERO"));
+	EXPECT_EQ(TestSparseEnum::Zero, Convert::To<TestSparseEnum>("zero"));
+}
+
+TEST(ConvertEnums, ShouldThrowExceptionWhenEnumIsNotRegistered) {
+	EXPECT_THROW(Convert::To<TestEnum>("Six"), std::invalid_argument);
+	EXPECT_THROW(Convert::ToString(static_cast<TestEnum>(6)), std::invalid_argument);
+	EXPECT_THROW(Convert::ToString(static_cast<TestSparseEnum>(1)), std::invalid_argument);
+}
+
+
 //-----------------------------------------------------------------------------
 // Test conversion for class types (struct, class, union)
 //-----------------------------------------------------------------------------
@@ -3,6 +3,8 @@
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
 #include <memory>
+#include <sstream>
+#include <vector>
 #include <gtest/gtest.h>
 #include "bitserializer/conversion_detail/convert_utf.h"
 
@@ -18,7 +20,8 @@ public:
 	template <typename TSourceUtfType>
 	void PrepareEncodedStreamReader(std::u32string_view testStr, bool addBom = false,
 		BitSerializer::Convert::EncodeErrorPolicy encodeErrorPolicy = BitSerializer::Convert::EncodeErrorPolicy::WriteErrorMark,
-		const target_char_type* errorMark = BitSerializer::Convert::Detail::GetDefaultErrorMark<target_char_type>())
+		const target_char_type* errorMark = BitSerializer::Convert::Detail::GetDefaultErrorMark<target_char_type>(),
+		size_t chunkSize = reader_type::chunk_size)
 	{
 		using source_char_type = typename TSourceUtfType::char_type;
 		using source_string_type = std::basic_string<source_char_type, std::char_traits<source_char_type>>;
@@ -36,7 +39,7 @@ public:
 
 		// Prepare stream reader
 		mInputStream = std::stringstream(mInputString);
-		mEncodedStreamReader = std::make_shared<reader_type>(mInputStream, encodeErrorPolicy, errorMark);
+		mEncodedStreamReader = std::make_shared<reader_type>(mInputStream, encodeErrorPolicy, errorMark, chunkSize);
 	}
 
 	void ReadFromStream()
@@ -54,6 +57,24 @@ public:
 		}
 	}
 
+	void ReadFromStreamToBuffer(size_t bufferSize)
+	{
+		// For prevent infinite loop when something went wrong
+		static constexpr int MaxIterations = 100;
+
+		std::vector<target_char_type> buffer(bufferSize);
+		for (int i = 0; i < MaxIterations; ++i)
+		{
+			const size_t readSize = mEncodedStreamReader->ReadChunk(buffer.data(), buffer.size());
+			if (readSize == 0)
+			{
+				break;
+			}
+			ASSERT_TRUE(readSize <= bufferSize);
+			mActualString.append(buffer.data(), readSize);
+		}
+	}
+
 protected:
 	std::string mInputString;
 	std::stringstream mInputStream;
@@ -159,3 +159,51 @@ TYPED_TEST(EncodedStreamReaderTest, ShouldReadFromUtf32BeStreamWithBom)
 	// Assert
 	EXPECT_EQ(this->mExpectedString, this->mActualString);
 }
+
+TYPED_TEST(EncodedStreamReaderTest, ShouldReadWithChunkSizePassedInConstructor)
+{
+	// Arrange
+	this->template PrepareEncodedStreamReader<Convert::Utf16Be>(U"Привет мир! Hello world!", true,
+		Convert::EncodeErrorPolicy::WriteErrorMark, Convert::Detail::GetDefaultErrorMark<typename TestFixture::target_char_type>(), 8);
+
+	// Act
+	this->ReadFromStream();
+
+	// Assert
+	EXPECT_EQ(8, this->mEncodedStreamReader->GetChunkSize());
+	EXPECT_EQ(this->mExpectedString, this->mActualString);
+}
+
+TYPED_TEST(EncodedStreamReaderTest, ShouldThrowExceptionWhenChunkSizeIsNotMultipleOf4)
+{
+	std::stringstream inputStream("test");
+	using reader_type = typename TestFixture::reader_type;
+	EXPECT_THROW(reader_type(inputStream, Convert::EncodeErrorPolicy::WriteErrorMark,
+		Convert::Detail::GetDefaultErrorMark<typename TestFixture::target_char_type>(), 7), std::invalid_argument);
+}
+
+TYPED_TEST(EncodedStreamReaderTest, ShouldReadFromUtf8StreamToCallerBuffer)
+{
+	// Arrange
+	this->template PrepareEncodedStreamReader<Convert::Utf8>(U"Привет мир!", true);
+
+	// Act
+	this->ReadFromStreamToBuffer(3);
+
+	// Assert
+	EXPECT_EQ(this->mExpectedString, this->mActualString);
+	EXPECT_TRUE(this->mEncodedStreamReader->IsEnd());
+}
+
+TYPED_TEST(EncodedStreamReaderTest, ShouldReadFromUtf16BeStreamToCallerBuffer)
+{
+	// Arrange
+	this->template PrepareEncodedStreamReader<Convert::Utf16Be>(U"Привет мир!", true);
+
+	// Act
+	this->ReadFromStreamToBuffer(3);
+
+	// Assert
+	EXPECT_EQ(this->mExpectedString, this->mActualString);
+	EXPECT_TRUE(this->mEncodedStreamReader->IsEnd());
+}
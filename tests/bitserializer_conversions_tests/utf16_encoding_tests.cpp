@@ -435,4 +435,52 @@ TEST_F(Utf16BeDecodeTest, ShouldReturnIteratorToCroppedSurrogatePairAtEndWhenDec
 	EXPECT_EQ(U"test_тест", actual);
 }
 
+TEST_F(Utf16BeDecodeTest, ShouldDecodeLongUtf16BeFromRawPointers)
+{
+	// Arrange (surrogate pairs are crossing the boundaries of internal blocks)
+	std::u16string sourceStr;
+	for (int i = 0; i < 100; ++i) {
+		sourceStr += u"Test_Тест_😀";
+	}
+	const std::u16string testStr = SwapByteOrder(sourceStr);
+	const auto* beginPtr = testStr.data();
+	const auto* endPtr = testStr.data() + testStr.size();
+
+	// Act
+	std::string actualUtf8;
+	std::u16string actualUtf16;
+	std::u32string actualUtf32;
+	const auto itUtf8 = Convert::Utf16Be::Decode(beginPtr, endPtr, actualUtf8);
+	const auto itUtf16 = Convert::Utf16Be::Decode(beginPtr, endPtr, actualUtf16);
+	const auto itUtf32 = Convert::Utf16Be::Decode(beginPtr, endPtr, actualUtf32);
+
+	// Assert
+	EXPECT_EQ(Convert::ToString(sourceStr), actualUtf8);
+	EXPECT_EQ(sourceStr, actualUtf16);
+	EXPECT_EQ(Convert::To<std::u32string>(sourceStr), actualUtf32);
+	EXPECT_EQ(endPtr, itUtf8);
+	EXPECT_EQ(endPtr, itUtf16);
+	EXPECT_EQ(endPtr, itUtf32);
+}
+
+TEST_F(Utf16BeDecodeTest, ShouldReturnPointerToCroppedSurrogatePairWhenDecodeFromRawPointers)
+{
+	// Arrange
+	const std::u16string croppedSequence({ 0xD83D });
+	const std::u16string testStr = SwapByteOrder(std::u16string(300, u'x') + croppedSequence);
+	const auto* endPtr = testStr.data() + testStr.size();
+
+	// Act
+	std::string actualUtf8;
+	std::u16string actualUtf16;
+	const auto itUtf8 = Convert::Utf16Be::Decode(testStr.data(), endPtr, actualUtf8);
+	const auto itUtf16 = Convert::Utf16Be::Decode(testStr.data(), endPtr, actualUtf16);
+
+	// Assert
+	EXPECT_EQ(std::string(300, 'x'), actualUtf8);
+	EXPECT_EQ(std::u16string(300, u'x'), actualUtf16);
+	EXPECT_EQ(endPtr - 1, itUtf8);
+	EXPECT_EQ(endPtr - 1, itUtf16);
+}
+
 #pragma warning(pop)
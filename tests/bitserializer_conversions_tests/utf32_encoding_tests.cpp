@@ -308,4 +308,32 @@ TEST_F(Utf32BeDecodeTest, ShouldReturnIteratorToEnd)
 	EXPECT_TRUE(actualIt == testStr.cend());
 }
 
+TEST_F(Utf32BeDecodeTest, ShouldDecodeLongUtf32BeFromRawPointers)
+{
+	// Arrange
+	std::u32string sourceStr;
+	for (int i = 0; i < 100; ++i) {
+		sourceStr += U"Test_Тест_😀";
+	}
+	const std::u32string testStr = SwapByteOrder(sourceStr);
+	const auto* beginPtr = testStr.data();
+	const auto* endPtr = testStr.data() + testStr.size();
+
+	// Act
+	std::string actualUtf8;
+	std::u16string actualUtf16;
+	std::u32string actualUtf32;
+	const auto itUtf8 = Convert::Utf32Be::Decode(beginPtr, endPtr, actualUtf8);
+	const auto itUtf16 = Convert::Utf32Be::Decode(beginPtr, endPtr, actualUtf16);
+	const auto itUtf32 = Convert::Utf32Be::Decode(beginPtr, endPtr, actualUtf32);
+
+	// Assert
+	EXPECT_EQ(Convert::ToString(sourceStr), actualUtf8);
+	EXPECT_EQ(Convert::To<std::u16string>(sourceStr), actualUtf16);
+	EXPECT_EQ(sourceStr, actualUtf32);
+	EXPECT_EQ(endPtr, itUtf8);
+	EXPECT_EQ(endPtr, itUtf16);
+	EXPECT_EQ(endPtr, itUtf32);
+}
+
 #pragma warning(pop)
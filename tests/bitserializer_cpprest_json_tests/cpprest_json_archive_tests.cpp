@@ -3,6 +3,8 @@
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
 #include "bitserializer/cpprestjson_archive.h"
+#include "bitserializer/types/std/map.h"
+#include "bitserializer/types/std/vector.h"
 #include "testing_tools/common_test_methods.h"
 #include "testing_tools/common_json_test_methods.h"
 
@@ -180,6 +182,35 @@ TEST(JsonRestCpp, ShouldIterateKeysInObjectScope) {
 	TestIterateKeysInObjectScope<JsonArchive>();
 }
 
+TEST(JsonRestCpp, ShouldSaveArrayOfObjects)
+{
+	std::vector<TestPointClass> testArray = { { 1, 2 }, { 3, 4 }, { 5, 6 } };
+	const auto json = BitSerializer::SaveObject<JsonArchive>(testArray);
+	EXPECT_EQ(R"([{"x":1,"y":2},{"x":3,"y":4},{"x":5,"y":6}])", json);
+}
+
+TEST(JsonRestCpp, ShouldLoadMembersInAnyOrder)
+{
+	TestPointClass actual;
+	BitSerializer::LoadObject<JsonArchive>(actual, std::string(R"({"y":20,"x":10})"));
+	EXPECT_EQ(10, actual.x);
+	EXPECT_EQ(20, actual.y);
+}
+
+TEST(JsonRestCpp, ShouldLoadWideObject)
+{
+	std::map<std::string, int> expected;
+	for (int i = 0; i < 5000; ++i) {
+		expected.emplace("key" + std::to_string(i), i);
+	}
+	std::map<std::string, int> actual;
+
+	const auto json = BitSerializer::SaveObject<JsonArchive>(expected);
+	BitSerializer::LoadObject<JsonArchive>(actual, json);
+
+	EXPECT_EQ(expected, actual);
+}
+
 //-----------------------------------------------------------------------------
 // Test paths in archive
 //-----------------------------------------------------------------------------
@@ -17,6 +17,34 @@ TEST_F(CsvArchiveTests, SerializeArrayOfClasses)
 	TestSerializeArray<CsvArchive, TestPointClass>();
 }
 
+TEST_F(CsvArchiveTests, SaveEnumAsString)
+{
+	TestClassWithSubType<TestEnum> source[2] = { TestClassWithSubType<TestEnum>(TestEnum::Two), TestClassWithSubType<TestEnum>(TestEnum::Five) };
+	std::string outputData;
+	BitSerializer::SaveObject<CsvArchive>(source, outputData);
+	EXPECT_EQ("TestValue\r\nTwo\r\nFive\r\n", outputData);
+}
+
+TEST_F(CsvArchiveTests, ShouldLoadEnumFromEachRow)
+{
+	// Enums are loaded via view to the buffer of reader, which is reused for the next rows
+	TestClassWithSubType<TestEnum> actual[3];
+	BitSerializer::LoadObject<CsvArchive>(actual, "TestValue\r\nOne\r\n\"Three\"\r\nFive\r\n");
+	EXPECT_EQ(TestEnum::One, actual[0].GetValue());
+	EXPECT_EQ(TestEnum::Three, actual[1].GetValue());
+	EXPECT_EQ(TestEnum::Five, actual[2].GetValue());
+}
+
+TEST_F(CsvArchiveTests, ShouldLoadEnumFromEachRowOfStream)
+{
+	TestClassWithSubType<TestEnum> actual[3];
+	std::stringstream inputStream("TestValue\r\nTwo\r\nFour\r\nOne\r\n");
+	BitSerializer::LoadObject<CsvArchive>(actual, inputStream);
+	EXPECT_EQ(TestEnum::Two, actual[0].GetValue());
+	EXPECT_EQ(TestEnum::Four, actual[1].GetValue());
+	EXPECT_EQ(TestEnum::One, actual[2].GetValue());
+}
+
 //-----------------------------------------------------------------------------
 // Test paths in archive
 //-----------------------------------------------------------------------------
@@ -212,6 +240,9 @@ TEST_F(CsvArchiveTests, ThrowMismatchedTypesExceptionWhenLoadStringToInteger) {
 TEST_F(CsvArchiveTests, ThrowMismatchedTypesExceptionWhenLoadStringToFloat) {
 	TestMismatchedTypesPolicy<CsvArchive, std::string, float>(MismatchedTypesPolicy::ThrowError);
 }
+TEST_F(CsvArchiveTests, ThrowMismatchedTypesExceptionWhenLoadStringToEnum) {
+	TestMismatchedTypesPolicy<CsvArchive, std::string, TestEnum>(MismatchedTypesPolicy::ThrowError);
+}
 
 TEST_F(CsvArchiveTests, ThrowValidationExceptionWhenLoadStringToBoolean) {
 	TestMismatchedTypesPolicy<CsvArchive, std::string, bool>(MismatchedTypesPolicy::Skip);
@@ -222,6 +253,9 @@ TEST_F(CsvArchiveTests, ThrowValidationExceptionWhenLoadStringToInteger) {
 TEST_F(CsvArchiveTests, ThrowValidationExceptionWhenLoadStringToFloat) {
 	TestMismatchedTypesPolicy<CsvArchive, std::string, float>(MismatchedTypesPolicy::Skip);
 }
+TEST_F(CsvArchiveTests, ThrowValidationExceptionWhenLoadStringToEnum) {
+	TestMismatchedTypesPolicy<CsvArchive, std::string, TestEnum>(MismatchedTypesPolicy::Skip);
+}
 TEST_F(CsvArchiveTests, ThrowValidationExceptionWhenLoadNullToAnyType) {
 	// It doesn't matter what kind of MismatchedTypesPolicy is used, should throw only validation exception
 	TestMismatchedTypesPolicy<CsvArchive, std::nullptr_t, bool>(MismatchedTypesPolicy::ThrowError);
@@ -0,0 +1,571 @@
+﻿/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include "testing_tools/common_test_methods.h"
+#include "testing_tools/common_json_test_methods.h"
+#include "bitserializer/json_archive.h"
+
+using BitSerializer::Json::Simd::JsonArchive;
+
+#pragma warning(push)
+#pragma warning(disable: 4566)
+
+//-----------------------------------------------------------------------------
+// Tests of serialization for fundamental types (at root scope of archive)
+//-----------------------------------------------------------------------------
+TEST(JsonArchive, SaveBooleanAsTrueFalse)
+{
+	bool value = false;
+	EXPECT_EQ("false", BitSerializer::SaveObject<JsonArchive>(value));
+	value = true;
+	EXPECT_EQ("true", BitSerializer::SaveObject<JsonArchive>(value));
+}
+
+TEST(JsonArchive, SerializeBoolean)
+{
+	TestSerializeType<JsonArchive, bool>(false);
+	TestSerializeType<JsonArchive, bool>(true);
+}
+
+TEST(JsonArchive, SerializeInteger)
+{
+	TestSerializeType<JsonArchive, uint8_t>(std::numeric_limits<uint8_t>::min());
+	TestSerializeType<JsonArchive, uint8_t>(std::numeric_limits<uint8_t>::max());
+	TestSerializeType<JsonArchive, int64_t>(std::numeric_limits<int64_t>::min());
+	TestSerializeType<JsonArchive, uint64_t>(std::numeric_limits<uint64_t>::max());
+}
+
+TEST(JsonArchive, SerializeFloat)
+{
+	TestSerializeType<JsonArchive, float>(std::numeric_limits<float>::min());
+	TestSerializeType<JsonArchive, float>(std::numeric_limits<float>::max());
+	TestSerializeType<JsonArchive, float>(0.f);
+	TestSerializeType<JsonArchive, float>(3.141592654f);
+	TestSerializeType<JsonArchive, float>(-3.141592654f);
+}
+
+TEST(JsonArchive, SerializeDouble)
+{
+	TestSerializeType<JsonArchive, double>(std::numeric_limits<double>::min());
+	TestSerializeType<JsonArchive, double>(std::numeric_limits<double>::max());
+}
+
+TEST(JsonArchive, ShouldAllowToLoadBooleanFromInteger)
+{
+	bool actual = false;
+	BitSerializer::LoadObject<JsonArchive>(actual, "1");
+	EXPECT_EQ(true, actual);
+}
+
+TEST(JsonArchive, ShouldAllowToLoadFloatFromInteger)
+{
+	float actual = 0;
+	BitSerializer::LoadObject<JsonArchive>(actual, "100");
+	EXPECT_EQ(100, actual);
+}
+
+TEST(JsonArchive, SerializeNullptr)
+{
+	TestSerializeType<JsonArchive, std::nullptr_t>(nullptr);
+}
+
+//-----------------------------------------------------------------------------
+// Tests of serialization any of std::string (at root scope of archive)
+//-----------------------------------------------------------------------------
+TEST(JsonArchive, SerializeUtf8Sting)
+{
+	TestSerializeType<JsonArchive, std::string>("Test ANSI string");
+	TestSerializeType<JsonArchive, std::string>(u8"Test UTF8 string - Привет мир!");
+}
+
+TEST(JsonArchive, SerializeUnicodeString)
+{
+	TestSerializeType<JsonArchive, std::wstring>(L"Test wide string - Привет мир!");
+	TestSerializeType<JsonArchive, std::u16string>(u"Test UTF-16 string - Привет мир!");
+	TestSerializeType<JsonArchive, std::u32string>(U"Test UTF-32 string - Привет мир!");
+}
+
+TEST(JsonArchive, SerializeEnum)
+{
+	TestSerializeType<JsonArchive, TestEnum>(TestEnum::Two);
+}
+
+//-----------------------------------------------------------------------------
+// Tests of serialization for c-arrays (at root scope of archive)
+//-----------------------------------------------------------------------------
+TEST(JsonArchive, SerializeArrayOfBooleans)
+{
+	TestSerializeArray<JsonArchive, bool>();
+}
+
+TEST(JsonArchive, SerializeArrayOfChars)
+{
+	TestSerializeArray<JsonArchive, char>();
+	TestSerializeArray<JsonArchive, unsigned char>();
+}
+
+TEST(JsonArchive, SerializeArrayOfIntegers)
+{
+	TestSerializeArray<JsonArchive, uint16_t>();
+	TestSerializeArray<JsonArchive, int64_t>();
+}
+
+TEST(JsonArchive, SerializeArrayOfFloats)
+{
+	TestSerializeArray<JsonArchive, float>();
+}
+
+TEST(JsonArchive, SerializeArrayOfDoubles)
+{
+	TestSerializeArray<JsonArchive, double>();
+}
+
+TEST(JsonArchive, SerializeArrayOfNullptrs)
+{
+	TestSerializeArray<JsonArchive, std::nullptr_t>();
+}
+
+TEST(JsonArchive, SerializeArrayOfStrings)
+{
+	TestSerializeArray<JsonArchive, std::string>();
+}
+
+TEST(JsonArchive, SerializeArrayOfUnicodeStrings)
+{
+	TestSerializeArray<JsonArchive, std::wstring>();
+	TestSerializeArray<JsonArchive, std::u16string>();
+	TestSerializeArray<JsonArchive, std::u32string>();
+}
+
+TEST(JsonArchive, SerializeArrayOfClasses)
+{
+	TestSerializeArray<JsonArchive, TestPointClass>();
+}
+
+TEST(JsonArchive, SerializeTwoDimensionalArray)
+{
+	TestSerializeTwoDimensionalArray<JsonArchive, int32_t>();
+}
+
+//-----------------------------------------------------------------------------
+// Tests of serialization for classes
+//-----------------------------------------------------------------------------
+TEST(JsonArchive, SerializeClassWithMemberBoolean)
+{
+	TestSerializeClass<JsonArchive>(TestClassWithSubTypes<bool>(false));
+	TestSerializeClass<JsonArchive>(TestClassWithSubTypes<bool>(true));
+}
+
+TEST(JsonArchive, SerializeClassWithMemberInteger)
+{
+	TestSerializeClass<JsonArchive>(BuildFixture<TestClassWithSubTypes<int8_t, uint8_t, int64_t, uint64_t>>());
+	TestSerializeClass<JsonArchive>(TestClassWithSubTypes(std::numeric_limits<int64_t>::min(), std::numeric_limits<uint64_t>::max()));
+}
+
+TEST(JsonArchive, SerializeClassWithMemberFloat)
+{
+	TestSerializeClass<JsonArchive>(TestClassWithSubTypes(std::numeric_limits<float>::min(), 0.0f, std::numeric_limits<float>::max()));
+}
+
+TEST(JsonArchive, SerializeClassWithMemberDouble)
+{
+	TestSerializeClass<JsonArchive>(TestClassWithSubTypes(std::numeric_limits<double>::min(), 0.0, std::numeric_limits<double>::max()));
+}
+
+TEST(JsonArchive, SerializeClassWithMemberNullptr)
+{
+	TestSerializeClass<JsonArchive>(BuildFixture<TestClassWithSubTypes<std::nullptr_t>>());
+}
+
+TEST(JsonArchive, SerializeClassWithMemberString)
+{
+	TestSerializeClass<JsonArchive>(BuildFixture<TestClassWithSubTypes<std::string, std::wstring, std::u16string, std::u32string>>());
+}
+
+TEST(JsonArchive, SerializeClassHierarchy)
+{
+	TestSerializeClass<JsonArchive>(BuildFixture<TestClassWithInheritance>());
+}
+
+TEST(JsonArchive, SerializeClassWithMemberClass)
+{
+	using TestClassType = TestClassWithSubTypes<TestClassWithSubTypes<int64_t>>;
+	TestSerializeClass<JsonArchive>(BuildFixture<TestClassType>());
+}
+
+TEST(JsonArchive, SerializeClassWithSubArray)
+{
+	TestSerializeClass<JsonArchive>(BuildFixture<TestClassWithSubArray<int64_t>>());
+}
+
+TEST(JsonArchive, SerializeClassWithSubArrayOfClasses)
+{
+	TestSerializeClass<JsonArchive>(BuildFixture<TestClassWithSubArray<TestPointClass>>());
+}
+
+TEST(JsonArchive, SerializeClassWithSubTwoDimArray)
+{
+	TestSerializeClass<JsonArchive>(BuildFixture<TestClassWithSubTwoDimArray<int32_t>>());
+}
+
+TEST(JsonArchive, ShouldLoadArrayWithExactSize)
+{
+	std::vector<int16_t> expected(1000);
+	for (size_t i = 0; i < expected.size(); ++i) {
+		expected[i] = static_cast<int16_t>(i * 31);
+	}
+	std::vector<int16_t> actual;
+
+	const auto data = BitSerializer::SaveObject<JsonArchive>(expected);
+	BitSerializer::LoadObject<JsonArchive>(actual, data);
+
+	EXPECT_EQ(expected, actual);
+	EXPECT_EQ(expected.size(), actual.capacity());
+}
+
+TEST(JsonArchive, ShouldLoadValuesInAnyOrder)
+{
+	const char* testJson = R"({"y": 20, "unknown": {"a": [1, [2, {}], "]"], "b": null}, "x": 10})";
+	TestPointClass actual(0, 0);
+
+	BitSerializer::LoadObject<JsonArchive>(actual, testJson);
+
+	TestPointClass(10, 20).Assert(actual);
+}
+
+TEST(JsonArchive, ShouldIterateKeysInObjectScope)
+{
+	TestIterateKeysInObjectScope<JsonArchive>();
+}
+
+//-----------------------------------------------------------------------------
+// Tests of strings escaping
+//-----------------------------------------------------------------------------
+TEST(JsonArchive, SerializeStringWithEscapedCharacters)
+{
+	TestSerializeType<JsonArchive, std::string>("Quote: \", backslash: \\, slash: /, control: \b\f\n\r\t\x01\x1F");
+	TestSerializeType<JsonArchive, std::string>(std::string(100, '\\'));
+	TestSerializeType<JsonArchive, std::string>(std::string(100, '"'));
+}
+
+TEST(JsonArchive, SaveControlCharactersAsEscapeSequences)
+{
+	std::string value = "\"\\\n\x01";
+	EXPECT_EQ(R"("\"\\\n\u0001")", BitSerializer::SaveObject<JsonArchive>(value));
+}
+
+TEST(JsonArchive, LoadStringWithUnicodeEscapeSequences)
+{
+	std::string actual;
+	BitSerializer::LoadObject<JsonArchive>(actual, R"("\u0048\u0069 \u041f\u0440\u0438\u0432\u0435\u0442 \uD83D\uDE00")");
+	EXPECT_EQ(u8"Hi Привет \U0001F600", actual);
+}
+
+TEST(JsonArchive, LoadStringsWithEscapesAtBoundariesOfBlocks)
+{
+	// Sequences of backslashes and escaped quotes are crossing boundaries of 64-byte blocks
+	std::vector<std::string> expected;
+	for (size_t i = 0; i < 130; ++i) {
+		expected.emplace_back(std::string(i, 'a') + std::string(i % 7, '\\') + '"' + std::string(i % 5, '"'));
+	}
+	std::vector<std::string> actual;
+
+	const auto data = BitSerializer::SaveObject<JsonArchive>(expected);
+	BitSerializer::LoadObject<JsonArchive>(actual, data);
+
+	EXPECT_EQ(expected, actual);
+}
+
+//-----------------------------------------------------------------------------
+// Test paths in archive
+//-----------------------------------------------------------------------------
+TEST(JsonArchive, ShouldReturnPathInObjectScopeWhenLoading)
+{
+	TestGetPathInJsonObjectScopeWhenLoading<JsonArchive>();
+}
+
+TEST(JsonArchive, ShouldReturnPathInObjectScopeWhenSaving)
+{
+	TestGetPathInJsonObjectScopeWhenSaving<JsonArchive>();
+}
+
+TEST(JsonArchive, ShouldReturnPathInArrayScopeWhenLoading)
+{
+	TestGetPathInJsonArrayScopeWhenLoading<JsonArchive>();
+}
+
+TEST(JsonArchive, ShouldReturnPathInArrayScopeWhenSaving)
+{
+	TestGetPathInJsonArrayScopeWhenSaving<JsonArchive>();
+}
+
+//-----------------------------------------------------------------------------
+// Tests format output JSON
+//-----------------------------------------------------------------------------
+TEST(JsonArchive, SaveWithFormatting)
+{
+	TestSaveFormattedJson<JsonArchive>();
+}
+
+//-----------------------------------------------------------------------------
+// Tests streams / files
+//-----------------------------------------------------------------------------
+TEST(JsonArchive, SerializeClassToStream) {
+	TestSerializeClassToStream<JsonArchive, char>(BuildFixture<TestPointClass>());
+}
+
+TEST(JsonArchive, SerializeUnicodeToEncodedStream) {
+	TestClassWithSubType<std::wstring> TestValue(L"Привет мир!");
+	TestSerializeClassToStream<JsonArchive, char>(TestValue);
+}
+
+TEST(JsonArchive, LoadFromUtf8Stream) {
+	TestLoadJsonFromEncodedStream<JsonArchive, BitSerializer::Convert::Utf8>(false);
+}
+TEST(JsonArchive, LoadFromUtf8StreamWithBom) {
+	TestLoadJsonFromEncodedStream<JsonArchive, BitSerializer::Convert::Utf8>(true);
+}
+
+TEST(JsonArchive, LoadFromUtf16LeStream) {
+	TestLoadJsonFromEncodedStream<JsonArchive, BitSerializer::Convert::Utf16Le>(false);
+}
+TEST(JsonArchive, LoadFromUtf16LeStreamWithBom) {
+	TestLoadJsonFromEncodedStream<JsonArchive, BitSerializer::Convert::Utf16Le>(true);
+}
+
+TEST(JsonArchive, LoadFromUtf16BeStream) {
+	TestLoadJsonFromEncodedStream<JsonArchive, BitSerializer::Convert::Utf16Be>(false);
+}
+TEST(JsonArchive, LoadFromUtf16BeStreamWithBom) {
+	TestLoadJsonFromEncodedStream<JsonArchive, BitSerializer::Convert::Utf16Be>(true);
+}
+
+TEST(JsonArchive, LoadFromUtf32LeStream) {
+	TestLoadJsonFromEncodedStream<JsonArchive, BitSerializer::Convert::Utf32Le>(false);
+}
+TEST(JsonArchive, LoadFromUtf32LeStreamWithBom) {
+	TestLoadJsonFromEncodedStream<JsonArchive, BitSerializer::Convert::Utf32Le>(true);
+}
+
+TEST(JsonArchive, LoadFromUtf32BeStream) {
+	TestLoadJsonFromEncodedStream<JsonArchive, BitSerializer::Convert::Utf32Be>(false);
+}
+TEST(JsonArchive, LoadFromUtf32BeStreamWithBom) {
+	TestLoadJsonFromEncodedStream<JsonArchive, BitSerializer::Convert::Utf32Be>(true);
+}
+
+TEST(JsonArchive, SaveToUtf8Stream) {
+	TestSaveJsonToEncodedStream<JsonArchive, BitSerializer::Convert::Utf8>(false);
+}
+TEST(JsonArchive, SaveToUtf8StreamWithBom) {
+	TestSaveJsonToEncodedStream<JsonArchive, BitSerializer::Convert::Utf8>(true);
+}
+
+TEST(JsonArchive, SaveToUtf16LeStream) {
+	TestSaveJsonToEncodedStream<JsonArchive, BitSerializer::Convert::Utf16Le>(false);
+}
+TEST(JsonArchive, SaveToUtf16LeStreamWithBom) {
+	TestSaveJsonToEncodedStream<JsonArchive, BitSerializer::Convert::Utf16Le>(true);
+}
+
+TEST(JsonArchive, SaveToUtf16BeStream) {
+	TestSaveJsonToEncodedStream<JsonArchive, BitSerializer::Convert::Utf16Be>(false);
+}
+TEST(JsonArchive, SaveToUtf16BeStreamWithBom) {
+	TestSaveJsonToEncodedStream<JsonArchive, BitSerializer::Convert::Utf16Be>(true);
+}
+
+TEST(JsonArchive, SaveToUtf32LeStream) {
+	TestSaveJsonToEncodedStream<JsonArchive, BitSerializer::Convert::Utf32Le>(false);
+}
+TEST(JsonArchive, SaveToUtf32LeStreamWithBom) {
+	TestSaveJsonToEncodedStream<JsonArchive, BitSerializer::Convert::Utf32Le>(true);
+}
+
+TEST(JsonArchive, SaveToUtf32BeStream) {
+	TestSaveJsonToEncodedStream<JsonArchive, BitSerializer::Convert::Utf32Be>(false);
+}
+TEST(JsonArchive, SaveToUtf32BeStreamWithBom) {
+	TestSaveJsonToEncodedStream<JsonArchive, BitSerializer::Convert::Utf32Be>(true);
+}
+
+TEST(JsonArchive, ThrowExceptionWhenUnsupportedStreamEncoding)
+{
+	BitSerializer::SerializationOptions serializationOptions;
+	serializationOptions.streamOptions.encoding = static_cast<BitSerializer::Convert::UtfType>(-1);
+	std::stringstream outputStream;
+	auto testObj = BuildFixture<TestClassWithSubTypes<std::string>>();
+	EXPECT_THROW(BitSerializer::SaveObject<JsonArchive>(testObj, outputStream, serializationOptions), BitSerializer::SerializationException);
+}
+
+TEST(JsonArchive, SerializeLargeArrayToStream)
+{
+	std::vector<TestPointClass> expected(10000);
+	::BuildFixture(expected);
+	std::vector<TestPointClass> actual;
+
+	std::stringstream outputStream;
+	BitSerializer::SerializationOptions serializationOptions;
+	serializationOptions.streamOptions.writeBom = false;
+	BitSerializer::SaveObject<JsonArchive>(expected, outputStream, serializationOptions);
+	EXPECT_EQ(BitSerializer::SaveObject<JsonArchive>(expected), outputStream.str());
+	outputStream.seekg(0, std::ios::beg);
+	BitSerializer::LoadObject<JsonArchive>(actual, outputStream);
+
+	ASSERT_EQ(expected.size(), actual.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		expected[i].Assert(actual[i]);
+	}
+}
+
+TEST(JsonArchive, SerializeToFile) {
+	TestSerializeArrayToFile<JsonArchive>();
+}
+
+//-----------------------------------------------------------------------------
+// Tests of errors handling
+//-----------------------------------------------------------------------------
+TEST(JsonArchive, ThrowExceptionWhenBadSyntaxInSource)
+{
+	int testInt = 0;
+	EXPECT_THROW(BitSerializer::LoadObject<JsonArchive>(testInt, "10 }}"), BitSerializer::SerializationException);
+}
+
+TEST(JsonArchive, ThrowParsingExceptionWhenInputIsEmpty)
+{
+	int testInt = 0;
+	EXPECT_THROW(BitSerializer::LoadObject<JsonArchive>(testInt, std::string()), BitSerializer::ParsingException);
+	EXPECT_THROW(BitSerializer::LoadObject<JsonArchive>(testInt, " \r\n\t "), BitSerializer::ParsingException);
+}
+
+TEST(JsonArchive, ThrowParsingExceptionWhenInvalidSyntax)
+{
+	const char* invalidJsons[] = {
+		R"({"x": 10,})", R"([1, 2,])", R"([1 2])", R"({"x" 10})", R"({x: 10})", R"([01])", R"([1.])", R"([1e])", R"([-])",
+		R"([tru])", R"([nulls])", R"(["abc)", R"(["\x"])", R"(["\u12G4"])", "[\"a\tb\"]", R"([1]])", R"([[1])", R"({"x": 1])"
+	};
+	for (const char* invalidJson : invalidJsons)
+	{
+		std::vector<int> testList;
+		EXPECT_THROW(BitSerializer::LoadObject<JsonArchive>(testList, invalidJson), BitSerializer::ParsingException) << invalidJson;
+	}
+}
+
+TEST(JsonArchive, ThrowParsingExceptionWithCorrectPosition)
+{
+	const char* testJson = R"([
+	{ "x": 10, "y": 20},
+	{ "x": 11, y: 21}
+])";
+	TestPointClass testList[2];
+	try
+	{
+		BitSerializer::LoadObject<JsonArchive>(testList, testJson);
+		EXPECT_FALSE(true);
+	}
+	catch (const BitSerializer::ParsingException& ex)
+	{
+		EXPECT_TRUE(ex.Offset > 24 && ex.Offset < std::strlen(testJson));
+		EXPECT_EQ(3U, ex.Line);
+	}
+	catch (const std::exception&)
+	{
+		EXPECT_FALSE(true);
+	}
+}
+
+//-----------------------------------------------------------------------------
+TEST(JsonArchive, ThrowValidationExceptionWhenMissedRequiredValue) {
+	TestValidationForNamedValues<JsonArchive, TestClassForCheckValidation<bool>>();
+	TestValidationForNamedValues<JsonArchive, TestClassForCheckValidation<int>>();
+	TestValidationForNamedValues<JsonArchive, TestClassForCheckValidation<double>>();
+	TestValidationForNamedValues<JsonArchive, TestClassForCheckValidation<std::string>>();
+	TestValidationForNamedValues<JsonArchive, TestClassForCheckValidation<TestPointClass>>();
+	TestValidationForNamedValues<JsonArchive, TestClassForCheckValidation<int[3]>>();
+}
+
+//-----------------------------------------------------------------------------
+TEST(JsonArchive, ThrowMismatchedTypesExceptionWhenLoadStringToBoolean) {
+	TestMismatchedTypesPolicy<JsonArchive, std::string, bool>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+TEST(JsonArchive, ThrowMismatchedTypesExceptionWhenLoadStringToInteger) {
+	TestMismatchedTypesPolicy<JsonArchive, std::string, int32_t>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+TEST(JsonArchive, ThrowMismatchedTypesExceptionWhenLoadStringToFloat) {
+	TestMismatchedTypesPolicy<JsonArchive, std::string, float>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+TEST(JsonArchive, ThrowMismatchedTypesExceptionWhenLoadNumberToString) {
+	TestMismatchedTypesPolicy<JsonArchive, int32_t, std::string>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+
+TEST(JsonArchive, ThrowValidationExceptionWhenLoadStringToBoolean) {
+	TestMismatchedTypesPolicy<JsonArchive, std::string, bool>(BitSerializer::MismatchedTypesPolicy::Skip);
+}
+TEST(JsonArchive, ThrowValidationExceptionWhenLoadStringToInteger) {
+	TestMismatchedTypesPolicy<JsonArchive, std::string, int32_t>(BitSerializer::MismatchedTypesPolicy::Skip);
+}
+TEST(JsonArchive, ThrowValidationExceptionWhenLoadStringToFloat) {
+	TestMismatchedTypesPolicy<JsonArchive, std::string, float>(BitSerializer::MismatchedTypesPolicy::Skip);
+}
+TEST(JsonArchive, ThrowValidationExceptionWhenLoadNullToAnyType) {
+	// It doesn't matter what kind of MismatchedTypesPolicy is used, should throw only validation exception
+	TestMismatchedTypesPolicy<JsonArchive, std::nullptr_t, bool>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+	TestMismatchedTypesPolicy<JsonArchive, std::nullptr_t, uint32_t>(BitSerializer::MismatchedTypesPolicy::Skip);
+	TestMismatchedTypesPolicy<JsonArchive, std::nullptr_t, double>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+
+//-----------------------------------------------------------------------------
+
+TEST(JsonArchive, ThrowSerializationExceptionWhenOverflowBool) {
+	TestOverflowNumberPolicy<JsonArchive, int32_t, bool>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(JsonArchive, ThrowSerializationExceptionWhenOverflowInt8) {
+	TestOverflowNumberPolicy<JsonArchive, int16_t, int8_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<JsonArchive, uint16_t, uint8_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(JsonArchive, ThrowSerializationExceptionWhenOverflowInt16) {
+	TestOverflowNumberPolicy<JsonArchive, int32_t, int16_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<JsonArchive, uint32_t, uint16_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(JsonArchive, ThrowSerializationExceptionWhenOverflowInt32) {
+	TestOverflowNumberPolicy<JsonArchive, int64_t, int32_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<JsonArchive, uint64_t, uint32_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(JsonArchive, ThrowSerializationExceptionWhenOverflowFloat) {
+	TestOverflowNumberPolicy<JsonArchive, double, float>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(JsonArchive, ThrowSerializationExceptionWhenLoadNegativeToUnsigned) {
+	uint64_t actual = 0;
+	EXPECT_THROW(BitSerializer::LoadObject<JsonArchive>(actual, "-1"), BitSerializer::SerializationException);
+}
+TEST(JsonArchive, ThrowSerializationExceptionWhenLoadFloatToInteger) {
+	TestOverflowNumberPolicy<JsonArchive, float, uint32_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<JsonArchive, double, uint32_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+
+TEST(JsonArchive, ThrowValidationExceptionWhenOverflowBool) {
+	TestOverflowNumberPolicy<JsonArchive, int32_t, bool>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(JsonArchive, ThrowValidationExceptionWhenNumberOverflowInt8) {
+	TestOverflowNumberPolicy<JsonArchive, int16_t, int8_t>(BitSerializer::OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<JsonArchive, uint16_t, uint8_t>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(JsonArchive, ThrowValidationExceptionWhenNumberOverflowInt16) {
+	TestOverflowNumberPolicy<JsonArchive, int32_t, int16_t>(BitSerializer::OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<JsonArchive, uint32_t, uint16_t>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(JsonArchive, ThrowValidationExceptionWhenNumberOverflowInt32) {
+	TestOverflowNumberPolicy<JsonArchive, int64_t, int32_t>(BitSerializer::OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<JsonArchive, uint64_t, uint32_t>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(JsonArchive, ThrowValidationExceptionWhenNumberOverflowFloat) {
+	TestOverflowNumberPolicy<JsonArchive, double, float>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(JsonArchive, ThrowValidationExceptionWhenLoadFloatToInteger) {
+	TestOverflowNumberPolicy<JsonArchive, float, uint32_t>(BitSerializer::OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<JsonArchive, double, uint32_t>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+
+
+#pragma warning(pop)
@@ -0,0 +1,159 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include "testing_tools/common_test_methods.h"
+#include "bitserializer/json_archive.h"
+
+using BitSerializer::Json::Simd::JsonLinesArchive;
+
+//-----------------------------------------------------------------------------
+// Tests of JSON Lines (NDJSON) archive
+//-----------------------------------------------------------------------------
+TEST(JsonLinesArchive, SaveEachRecordOnSeparateLine)
+{
+	std::vector<TestPointClass> records = { { 1, 2 }, { 3, 4 } };
+	EXPECT_EQ("{\"x\":1,\"y\":2}\n{\"x\":3,\"y\":4}\n", BitSerializer::SaveObject<JsonLinesArchive>(records));
+}
+
+TEST(JsonLinesArchive, SaveWithoutFormattingEvenWhenItIsEnabled)
+{
+	std::vector<std::vector<int>> records = { { 1, 2 }, { } };
+	BitSerializer::SerializationOptions serializationOptions;
+	serializationOptions.formatOptions.enableFormat = true;
+	std::string actual;
+	BitSerializer::SaveObject<JsonLinesArchive>(records, actual, serializationOptions);
+	EXPECT_EQ("[1,2]\n[]\n", actual);
+}
+
+TEST(JsonLinesArchive, SaveEmptyList)
+{
+	std::vector<TestPointClass> records;
+	EXPECT_EQ("", BitSerializer::SaveObject<JsonLinesArchive>(records));
+}
+
+TEST(JsonLinesArchive, SerializeListOfObjects)
+{
+	std::vector<TestPointClass> expected(100);
+	::BuildFixture(expected);
+	std::vector<TestPointClass> actual;
+
+	const auto jsonLines = BitSerializer::SaveObject<JsonLinesArchive>(expected);
+	BitSerializer::LoadObject<JsonLinesArchive>(actual, jsonLines);
+
+	ASSERT_EQ(expected.size(), actual.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		expected[i].Assert(actual[i]);
+	}
+}
+
+TEST(JsonLinesArchive, SerializeListOfStrings)
+{
+	TestSerializeStlContainer<JsonLinesArchive, std::vector<std::string>>();
+}
+
+TEST(JsonLinesArchive, LoadRecordsOfDifferentTypes)
+{
+	std::vector<std::vector<int>> actual;
+	BitSerializer::LoadObject<JsonLinesArchive>(actual, "[1, 2]\r\n\r\n[]\n  [3]");
+
+	ASSERT_EQ(3U, actual.size());
+	EXPECT_EQ(std::vector<int>({ 1, 2 }), actual[0]);
+	EXPECT_TRUE(actual[1].empty());
+	EXPECT_EQ(std::vector<int>({ 3 }), actual[2]);
+}
+
+TEST(JsonLinesArchive, LoadEmptyInputAsEmptyList)
+{
+	std::vector<TestPointClass> actual = { { 1, 2 } };
+	BitSerializer::LoadObject<JsonLinesArchive>(actual, "\n");
+	EXPECT_TRUE(actual.empty());
+}
+
+TEST(JsonLinesArchive, SerializeToStream)
+{
+	std::vector<TestPointClass> expected(1000);
+	::BuildFixture(expected);
+	std::vector<TestPointClass> actual;
+
+	std::stringstream outputStream;
+	BitSerializer::SerializationOptions serializationOptions;
+	serializationOptions.streamOptions.writeBom = false;
+	BitSerializer::SaveObject<JsonLinesArchive>(expected, outputStream, serializationOptions);
+	EXPECT_EQ(BitSerializer::SaveObject<JsonLinesArchive>(expected), outputStream.str());
+	outputStream.seekg(0, std::ios::beg);
+	BitSerializer::LoadObject<JsonLinesArchive>(actual, outputStream);
+
+	ASSERT_EQ(expected.size(), actual.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		expected[i].Assert(actual[i]);
+	}
+}
+
+TEST(JsonLinesArchive, LoadFromStreamLargerThanChunk)
+{
+	// Records are read by chunks of stream, some of them are split between chunks (the long one is larger than a chunk)
+	std::vector<std::string> expected(10000);
+	for (size_t i = 0; i < expected.size(); ++i) {
+		expected[i] = "Record " + std::to_string(i);
+	}
+	expected[5000] = std::string(100000, 'x');
+	std::vector<std::string> actual;
+
+	std::stringstream stream;
+	BitSerializer::SerializationOptions serializationOptions;
+	serializationOptions.streamOptions.encoding = BitSerializer::Convert::UtfType::Utf16le;
+	BitSerializer::SaveObject<JsonLinesArchive>(expected, stream, serializationOptions);
+	stream.seekg(0, std::ios::beg);
+	BitSerializer::LoadObject<JsonLinesArchive>(actual, stream);
+
+	EXPECT_EQ(expected, actual);
+}
+
+TEST(JsonLinesArchive, ThrowParsingExceptionWithLineOfWrongRecordInStream)
+{
+	std::stringstream stream;
+	for (size_t i = 0; i < 20000; ++i) {
+		stream << "{\"x\":" << i << ",\"y\":" << i << "}\n\n";
+	}
+	stream << "{\"x\":1,y:2}\n";
+	std::vector<TestPointClass> actual;
+	try
+	{
+		BitSerializer::LoadObject<JsonLinesArchive>(actual, stream);
+		EXPECT_FALSE(true);
+	}
+	catch (const BitSerializer::ParsingException& ex)
+	{
+		EXPECT_EQ(40001U, ex.Line);
+	}
+	catch (...)
+	{
+		EXPECT_FALSE(true);
+	}
+}
+
+TEST(JsonLinesArchive, ThrowParsingExceptionWhenRecordsAreOnSameLine)
+{
+	std::vector<TestPointClass> actual;
+	EXPECT_THROW(BitSerializer::LoadObject<JsonLinesArchive>(actual, R"({"x":1,"y":2} {"x":3,"y":4})"), BitSerializer::ParsingException);
+}
+
+TEST(JsonLinesArchive, ThrowParsingExceptionWithLineOfWrongRecord)
+{
+	const char* testJsonLines = "{\"x\":1,\"y\":2}\n{\"x\":3,\"y\":4}\n{\"x\":5,y:6}\n";
+	std::vector<TestPointClass> actual;
+	try
+	{
+		BitSerializer::LoadObject<JsonLinesArchive>(actual, testJsonLines);
+		EXPECT_FALSE(true);
+	}
+	catch (const BitSerializer::ParsingException& ex)
+	{
+		EXPECT_EQ(3U, ex.Line);
+	}
+	catch (...)
+	{
+		EXPECT_FALSE(true);
+	}
+}
@@ -0,0 +1,602 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <map>
+#include "testing_tools/common_test_methods.h"
+#include "testing_tools/common_json_test_methods.h"
+#include "bitserializer/msgpack_archive.h"
+#include "bitserializer/types/std/map.h"
+#include "bitserializer/types/std/vector.h"
+
+using BitSerializer::MsgPack::MsgPackArchive;
+
+namespace
+{
+	template <typename T>
+	std::string SaveToMsgPack(T value)
+	{
+		return BitSerializer::SaveObject<MsgPackArchive>(value);
+	}
+}
+
+#pragma warning(push)
+#pragma warning(disable: 4566)
+
+//-----------------------------------------------------------------------------
+// Tests of serialization for fundamental types (at root scope of archive)
+//-----------------------------------------------------------------------------
+TEST(MsgPackArchive, SerializeBoolean)
+{
+	TestSerializeType<MsgPackArchive, bool>(false);
+	TestSerializeType<MsgPackArchive, bool>(true);
+}
+
+TEST(MsgPackArchive, SerializeInteger)
+{
+	TestSerializeType<MsgPackArchive, uint8_t>(std::numeric_limits<uint8_t>::min());
+	TestSerializeType<MsgPackArchive, uint8_t>(std::numeric_limits<uint8_t>::max());
+	TestSerializeType<MsgPackArchive, int8_t>(std::numeric_limits<int8_t>::min());
+	TestSerializeType<MsgPackArchive, int16_t>(std::numeric_limits<int16_t>::min());
+	TestSerializeType<MsgPackArchive, int32_t>(std::numeric_limits<int32_t>::min());
+	TestSerializeType<MsgPackArchive, uint32_t>(std::numeric_limits<uint32_t>::max());
+	TestSerializeType<MsgPackArchive, int64_t>(std::numeric_limits<int64_t>::min());
+	TestSerializeType<MsgPackArchive, uint64_t>(std::numeric_limits<uint64_t>::max());
+}
+
+TEST(MsgPackArchive, SerializeFloat)
+{
+	TestSerializeType<MsgPackArchive, float>(0.f);
+	TestSerializeType<MsgPackArchive, float>(3.141592654f);
+	TestSerializeType<MsgPackArchive, float>(std::numeric_limits<float>::lowest());
+	TestSerializeType<MsgPackArchive, float>(std::numeric_limits<float>::max());
+}
+
+TEST(MsgPackArchive, SerializeDouble)
+{
+	TestSerializeType<MsgPackArchive, double>(std::numeric_limits<double>::min());
+	TestSerializeType<MsgPackArchive, double>(std::numeric_limits<double>::max());
+	TestSerializeType<MsgPackArchive, double>(0.5);
+}
+
+TEST(MsgPackArchive, ShouldAllowToLoadBooleanFromInteger)
+{
+	bool actual = false;
+	BitSerializer::LoadObject<MsgPackArchive>(actual, std::string("\x01", 1));
+	EXPECT_EQ(true, actual);
+}
+
+TEST(MsgPackArchive, ShouldAllowToLoadFloatFromInteger)
+{
+	float actual = 0;
+	BitSerializer::LoadObject<MsgPackArchive>(actual, std::string("\x64", 1));
+	EXPECT_EQ(100, actual);
+}
+
+TEST(MsgPackArchive, SerializeNullptr)
+{
+	TestSerializeType<MsgPackArchive, std::nullptr_t>(nullptr);
+}
+
+//-----------------------------------------------------------------------------
+// Tests of encoding numbers and strings in the smallest formats
+//-----------------------------------------------------------------------------
+TEST(MsgPackArchive, SaveIntegersInSmallestEncoding)
+{
+	EXPECT_EQ(std::string("\x7F", 1), SaveToMsgPack(int64_t(127)));
+	EXPECT_EQ(std::string("\xE0", 1), SaveToMsgPack(int64_t(-32)));
+	EXPECT_EQ(std::string("\xCC\xFF", 2), SaveToMsgPack(uint64_t(255)));
+	EXPECT_EQ(std::string("\xD0\xDF", 2), SaveToMsgPack(int32_t(-33)));
+	EXPECT_EQ(std::string("\xCD\x01\x00", 3), SaveToMsgPack(int64_t(256)));
+	EXPECT_EQ(std::string("\xD1\x80\x00", 3), SaveToMsgPack(int16_t(-32768)));
+	EXPECT_EQ(std::string("\xCE\x00\x01\x00\x00", 5), SaveToMsgPack(uint32_t(65536)));
+	EXPECT_EQ(std::string("\xCF\x00\x00\x00\x01\x00\x00\x00\x00", 9), SaveToMsgPack(uint64_t(0x100000000)));
+}
+
+TEST(MsgPackArchive, SaveDoubleAsFloatWhenNoLostPrecision)
+{
+	EXPECT_EQ(std::string("\xCA\x3F\x00\x00\x00", 5), SaveToMsgPack(0.5));
+	EXPECT_EQ(9, SaveToMsgPack(0.1).size());
+}
+
+TEST(MsgPackArchive, SaveStringsInSmallestEncoding)
+{
+	EXPECT_EQ(std::string("\xA3" "abc"), SaveToMsgPack(std::string("abc")));
+	const std::string str32(32, 'a');
+	EXPECT_EQ(std::string("\xD9\x20") + str32, SaveToMsgPack(str32));
+	const std::string str256(256, 'a');
+	EXPECT_EQ(std::string("\xDA\x01\x00", 3) + str256, SaveToMsgPack(str256));
+}
+
+TEST(MsgPackArchive, SaveArrayOfBytesAsBinary)
+{
+	EXPECT_EQ(std::string("\xC4\x03\x01\x02\x03", 5), SaveToMsgPack(std::vector<uint8_t>{ 1, 2, 3 }));
+	EXPECT_EQ(std::string("\xC4\x00", 2), SaveToMsgPack(std::vector<uint8_t>()));
+	const std::vector<uint8_t> bin300(300, 0xAB);
+	EXPECT_EQ(std::string("\xC5\x01\x2C", 3) + std::string(300, '\xAB'), SaveToMsgPack(bin300));
+}
+
+TEST(MsgPackArchive, LoadArrayOfBytesFromBinary)
+{
+	std::vector<uint8_t> actual;
+	BitSerializer::LoadObject<MsgPackArchive>(actual, std::string("\xC4\x03\x01\x02\x03", 5));
+	EXPECT_EQ((std::vector<uint8_t>{ 1, 2, 3 }), actual);
+
+	BitSerializer::LoadObject<MsgPackArchive>(actual, std::string("\xC5\x01\x2C", 3) + std::string(300, '\x7F'));
+	EXPECT_EQ(std::vector<uint8_t>(300, 0x7F), actual);
+}
+
+TEST(MsgPackArchive, LoadArrayOfBytesFromRegularArray)
+{
+	std::vector<uint8_t> actual;
+	BitSerializer::LoadObject<MsgPackArchive>(actual, std::string("\x93\x01\x02\xCC\xFF", 5));
+	EXPECT_EQ((std::vector<uint8_t>{ 1, 2, 255 }), actual);
+}
+
+TEST(MsgPackArchive, SerializeMapWithBinaryValues)
+{
+	std::map<std::string, std::vector<uint8_t>> expected{
+		{ "x", { 1, 2, 3 } }, { "y", {} }, { "z", std::vector<uint8_t>(70000, 0x55) }
+	};
+	std::map<std::string, std::vector<uint8_t>> actual;
+
+	const auto data = BitSerializer::SaveObject<MsgPackArchive>(expected);
+	EXPECT_EQ(std::string("\x83\xA1x\xC4\x03\x01\x02\x03\xA1y\xC4\x00\xA1z\xC6\x00\x01\x11\x70", 19), data.substr(0, 19));
+	BitSerializer::LoadObject<MsgPackArchive>(actual, data);
+
+	EXPECT_EQ(expected, actual);
+}
+
+//-----------------------------------------------------------------------------
+// Tests of serialization any of std::string (at root scope of archive)
+//-----------------------------------------------------------------------------
+TEST(MsgPackArchive, SerializeUtf8Sting)
+{
+	TestSerializeType<MsgPackArchive, std::string>("Test ANSI string");
+	TestSerializeType<MsgPackArchive, std::string>(u8"Test UTF8 string - Привет мир!");
+}
+
+TEST(MsgPackArchive, SerializeUnicodeString)
+{
+	TestSerializeType<MsgPackArchive, std::wstring>(L"Test wide string - Привет мир!");
+	TestSerializeType<MsgPackArchive, std::u16string>(u"Test UTF-16 string - Привет мир!");
+	TestSerializeType<MsgPackArchive, std::u32string>(U"Test UTF-32 string - Привет мир!");
+}
+
+TEST(MsgPackArchive, SerializeEnum)
+{
+	TestSerializeType<MsgPackArchive, TestEnum>(TestEnum::Two);
+}
+
+//-----------------------------------------------------------------------------
+// Tests of serialization for c-arrays (at root scope of archive)
+//-----------------------------------------------------------------------------
+TEST(MsgPackArchive, SerializeArrayOfBooleans)
+{
+	TestSerializeArray<MsgPackArchive, bool>();
+}
+
+TEST(MsgPackArchive, SerializeArrayOfChars)
+{
+	TestSerializeArray<MsgPackArchive, char>();
+	TestSerializeArray<MsgPackArchive, unsigned char>();
+}
+
+TEST(MsgPackArchive, SerializeArrayOfIntegers)
+{
+	TestSerializeArray<MsgPackArchive, uint16_t>();
+	TestSerializeArray<MsgPackArchive, int64_t>();
+}
+
+TEST(MsgPackArchive, SerializeArrayOfFloats)
+{
+	TestSerializeVector<MsgPackArchive, float>({ -3.141592654f, 0.0f, -3.141592654f });
+}
+
+TEST(MsgPackArchive, SerializeArrayOfDoubles)
+{
+	TestSerializeArray<MsgPackArchive, double>();
+}
+
+TEST(MsgPackArchive, SerializeArrayOfNullptrs)
+{
+	TestSerializeArray<MsgPackArchive, std::nullptr_t>();
+}
+
+TEST(MsgPackArchive, SerializeArrayOfStrings)
+{
+	TestSerializeArray<MsgPackArchive, std::string>();
+}
+
+TEST(MsgPackArchive, SerializeArrayOfUnicodeStrings)
+{
+	TestSerializeArray<MsgPackArchive, std::wstring>();
+	TestSerializeArray<MsgPackArchive, std::u16string>();
+	TestSerializeArray<MsgPackArchive, std::u32string>();
+}
+
+TEST(MsgPackArchive, SerializeArrayOfClasses)
+{
+	TestSerializeArray<MsgPackArchive, TestPointClass>();
+}
+
+TEST(MsgPackArchive, SerializeTwoDimensionalArray)
+{
+	TestSerializeTwoDimensionalArray<MsgPackArchive, int32_t>();
+}
+
+TEST(MsgPackArchive, ShouldLoadArrayWithExactSize)
+{
+	std::vector<int16_t> expected(1000);
+	for (size_t i = 0; i < expected.size(); ++i) {
+		expected[i] = static_cast<int16_t>(i * 31);
+	}
+	std::vector<int16_t> actual;
+
+	const auto data = BitSerializer::SaveObject<MsgPackArchive>(expected);
+	BitSerializer::LoadObject<MsgPackArchive>(actual, data);
+
+	EXPECT_EQ(expected, actual);
+	EXPECT_EQ(expected.size(), actual.capacity());
+}
+
+//-----------------------------------------------------------------------------
+// Tests of serialization for classes
+//-----------------------------------------------------------------------------
+TEST(MsgPackArchive, SerializeClassWithMemberBoolean)
+{
+	TestSerializeClass<MsgPackArchive>(TestClassWithSubTypes<bool>(false));
+	TestSerializeClass<MsgPackArchive>(TestClassWithSubTypes<bool>(true));
+}
+
+TEST(MsgPackArchive, SerializeClassWithMemberInteger)
+{
+	TestSerializeClass<MsgPackArchive>(BuildFixture<TestClassWithSubTypes<int8_t, uint8_t, int64_t, uint64_t>>());
+	TestSerializeClass<MsgPackArchive>(TestClassWithSubTypes(std::numeric_limits<int64_t>::min(), std::numeric_limits<uint64_t>::max()));
+}
+
+TEST(MsgPackArchive, SerializeClassWithMemberFloat)
+{
+	TestSerializeClass<MsgPackArchive>(TestClassWithSubTypes(std::numeric_limits<float>::lowest(), 0.0f, std::numeric_limits<float>::max()));
+}
+
+TEST(MsgPackArchive, SerializeClassWithMemberDouble)
+{
+	TestSerializeClass<MsgPackArchive>(TestClassWithSubTypes(std::numeric_limits<double>::min(), 0.0, std::numeric_limits<double>::max()));
+}
+
+TEST(MsgPackArchive, SerializeClassWithMemberNullptr)
+{
+	TestSerializeClass<MsgPackArchive>(BuildFixture<TestClassWithSubTypes<std::nullptr_t>>());
+}
+
+TEST(MsgPackArchive, SerializeClassWithMemberString)
+{
+	TestSerializeClass<MsgPackArchive>(BuildFixture<TestClassWithSubTypes<std::string, std::wstring, std::u16string, std::u32string>>());
+}
+
+TEST(MsgPackArchive, SerializeClassHierarchy)
+{
+	TestSerializeClass<MsgPackArchive>(BuildFixture<TestClassWithInheritance>());
+}
+
+TEST(MsgPackArchive, SerializeClassWithMemberClass)
+{
+	using TestClassType = TestClassWithSubTypes<TestClassWithSubTypes<int64_t>>;
+	TestSerializeClass<MsgPackArchive>(BuildFixture<TestClassType>());
+}
+
+TEST(MsgPackArchive, SerializeClassWithSubArray)
+{
+	TestSerializeClass<MsgPackArchive>(BuildFixture<TestClassWithSubArray<int64_t>>());
+}
+
+TEST(MsgPackArchive, SerializeClassWithSubArrayOfClasses)
+{
+	TestSerializeClass<MsgPackArchive>(BuildFixture<TestClassWithSubArray<TestPointClass>>());
+}
+
+TEST(MsgPackArchive, SerializeClassWithSubTwoDimArray)
+{
+	TestSerializeClass<MsgPackArchive>(BuildFixture<TestClassWithSubTwoDimArray<int32_t>>());
+}
+
+TEST(MsgPackArchive, SerializeMapWithMoreThan15Items)
+{
+	std::map<std::string, int> expected;
+	for (int i = 0; i < 100; ++i) {
+		expected.emplace("key" + std::to_string(i), i * 1000);
+	}
+	std::map<std::string, int> actual;
+
+	const auto data = BitSerializer::SaveObject<MsgPackArchive>(expected);
+	EXPECT_EQ('\xDE', data[0]);
+	BitSerializer::LoadObject<MsgPackArchive>(actual, data);
+
+	EXPECT_EQ(expected, actual);
+}
+
+TEST(MsgPackArchive, ShouldLoadValuesInAnyOrder)
+{
+	// Arrange
+	std::string outputData;
+	{
+		BitSerializer::SerializationOptions options;
+		BitSerializer::SerializationContext context(options);
+		MsgPackArchive::output_archive_type outputArchive(outputData, context);
+		auto objScope = outputArchive.OpenObjectScope();
+		int y = 20, x = 10;
+		std::string unknown = "skipped";
+		objScope->SerializeValue("y", y);
+		objScope->SerializeValue("unknown", unknown);
+		objScope->SerializeValue("x", x);
+	}
+	TestPointClass actual(0, 0);
+
+	// Act
+	BitSerializer::LoadObject<MsgPackArchive>(actual, outputData);
+
+	// Assert
+	TestPointClass(10, 20).Assert(actual);
+}
+
+TEST(MsgPackArchive, ShouldIterateKeysInObjectScope)
+{
+	TestIterateKeysInObjectScope<MsgPackArchive>();
+}
+
+//-----------------------------------------------------------------------------
+// Test paths in archive
+//-----------------------------------------------------------------------------
+TEST(MsgPackArchive, ShouldReturnPathInObjectScopeWhenLoading)
+{
+	TestGetPathInJsonObjectScopeWhenLoading<MsgPackArchive>();
+}
+
+TEST(MsgPackArchive, ShouldReturnPathInObjectScopeWhenSaving)
+{
+	TestGetPathInJsonObjectScopeWhenSaving<MsgPackArchive>();
+}
+
+TEST(MsgPackArchive, ShouldReturnPathInArrayScopeWhenLoading)
+{
+	TestGetPathInJsonArrayScopeWhenLoading<MsgPackArchive>();
+}
+
+TEST(MsgPackArchive, ShouldReturnPathInArrayScopeWhenSaving)
+{
+	TestGetPathInJsonArrayScopeWhenSaving<MsgPackArchive>();
+}
+
+//-----------------------------------------------------------------------------
+// Tests streams / files / binary vector
+//-----------------------------------------------------------------------------
+TEST(MsgPackArchive, SerializeClassToStream) {
+	TestSerializeClassToStream<MsgPackArchive, char>(BuildFixture<TestPointClass>());
+}
+
+TEST(MsgPackArchive, SerializeUnicodeToStream) {
+	TestClassWithSubType<std::wstring> TestValue(L"Привет мир!");
+	TestSerializeClassToStream<MsgPackArchive, char>(TestValue);
+}
+
+TEST(MsgPackArchive, SerializeLargeArrayToStream)
+{
+	std::vector<TestPointClass> expected(10000);
+	::BuildFixture(expected);
+	std::vector<TestPointClass> actual;
+
+	std::stringstream outputStream;
+	BitSerializer::SaveObject<MsgPackArchive>(expected, outputStream);
+	EXPECT_EQ(BitSerializer::SaveObject<MsgPackArchive>(expected), outputStream.str());
+	outputStream.seekg(0, std::ios::beg);
+	BitSerializer::LoadObject<MsgPackArchive>(actual, outputStream);
+
+	ASSERT_EQ(expected.size(), actual.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		expected[i].Assert(actual[i]);
+	}
+}
+
+TEST(MsgPackArchive, SerializeLargeArrayOfMapsToStream)
+{
+	// Headers of maps with more than 15 items are shorter than the reserved space
+	std::vector<std::map<std::string, int>> expected(2000);
+	for (size_t i = 0; i < expected.size(); ++i)
+	{
+		for (int k = 0; k < 20; ++k) {
+			expected[i].emplace("key" + std::to_string(k), static_cast<int>(i) + k);
+		}
+	}
+	std::vector<std::map<std::string, int>> actual;
+
+	std::stringstream outputStream;
+	BitSerializer::SaveObject<MsgPackArchive>(expected, outputStream);
+	EXPECT_EQ(BitSerializer::SaveObject<MsgPackArchive>(expected), outputStream.str());
+	outputStream.seekg(0, std::ios::beg);
+	BitSerializer::LoadObject<MsgPackArchive>(actual, outputStream);
+
+	EXPECT_EQ(expected, actual);
+}
+
+TEST(MsgPackArchive, SerializeClassToBinaryVector)
+{
+	auto expected = BuildFixture<TestClassWithSubTypes<int64_t, std::string, double>>();
+	decltype(expected) actual;
+
+	std::vector<uint8_t> outputData;
+	BitSerializer::SaveObject<MsgPackArchive>(expected, outputData);
+	BitSerializer::LoadObject<MsgPackArchive>(actual, outputData);
+
+	expected.Assert(actual);
+}
+
+TEST(MsgPackArchive, SerializeToFile) {
+	TestSerializeArrayToFile<MsgPackArchive>();
+}
+
+//-----------------------------------------------------------------------------
+// Tests of errors handling
+//-----------------------------------------------------------------------------
+TEST(MsgPackArchive, ThrowParsingExceptionWhenInputIsEmpty)
+{
+	int testInt = 0;
+	EXPECT_THROW(BitSerializer::LoadObject<MsgPackArchive>(testInt, std::string()), BitSerializer::ParsingException);
+}
+
+TEST(MsgPackArchive, ThrowParsingExceptionWithCorrectPosition)
+{
+	// Array with three items, where the last one has the reserved (never used) code 0xC1
+	const std::string data("\x93\x01\x02\xC1", 4);
+	std::vector<int> testList;
+
+	try
+	{
+		BitSerializer::LoadObject<MsgPackArchive>(testList, data);
+		EXPECT_FALSE(true);
+	}
+	catch (const BitSerializer::ParsingException& ex)
+	{
+		EXPECT_EQ(3U, ex.Offset);
+	}
+	catch (const std::exception&)
+	{
+		EXPECT_FALSE(true);
+	}
+}
+
+TEST(MsgPackArchive, ThrowParsingExceptionWhenDataAfterRootValue)
+{
+	auto testObj = BuildFixture<TestPointClass>();
+	const auto data = BitSerializer::SaveObject<MsgPackArchive>(testObj);
+	EXPECT_THROW(BitSerializer::LoadObject<MsgPackArchive>(testObj, data + '\x01'), BitSerializer::ParsingException);
+}
+
+TEST(MsgPackArchive, ThrowParsingExceptionWhenDataIsTruncated)
+{
+	auto testObj = BuildFixture<TestClassWithSubTypes<std::string, int64_t>>();
+	const auto data = BitSerializer::SaveObject<MsgPackArchive>(testObj);
+	for (size_t size = 0; size < data.size(); ++size)
+	{
+		EXPECT_THROW(BitSerializer::LoadObject<MsgPackArchive>(testObj, data.substr(0, size)), BitSerializer::ParsingException);
+	}
+}
+
+//-----------------------------------------------------------------------------
+TEST(MsgPackArchive, ThrowValidationExceptionWhenMissedRequiredValue) {
+	TestValidationForNamedValues<MsgPackArchive, TestClassForCheckValidation<bool>>();
+	TestValidationForNamedValues<MsgPackArchive, TestClassForCheckValidation<int>>();
+	TestValidationForNamedValues<MsgPackArchive, TestClassForCheckValidation<double>>();
+	TestValidationForNamedValues<MsgPackArchive, TestClassForCheckValidation<std::string>>();
+	TestValidationForNamedValues<MsgPackArchive, TestClassForCheckValidation<TestPointClass>>();
+	TestValidationForNamedValues<MsgPackArchive, TestClassForCheckValidation<int[3]>>();
+}
+
+//-----------------------------------------------------------------------------
+TEST(MsgPackArchive, ThrowMismatchedTypesExceptionWhenLoadStringToBoolean) {
+	TestMismatchedTypesPolicy<MsgPackArchive, std::string, bool>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+TEST(MsgPackArchive, ThrowMismatchedTypesExceptionWhenLoadStringToInteger) {
+	TestMismatchedTypesPolicy<MsgPackArchive, std::string, int32_t>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+TEST(MsgPackArchive, ThrowMismatchedTypesExceptionWhenLoadStringToFloat) {
+	TestMismatchedTypesPolicy<MsgPackArchive, std::string, float>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+TEST(MsgPackArchive, ThrowMismatchedTypesExceptionWhenLoadNumberToString) {
+	TestMismatchedTypesPolicy<MsgPackArchive, int32_t, std::string>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+
+TEST(MsgPackArchive, ThrowValidationExceptionWhenLoadStringToBoolean) {
+	TestMismatchedTypesPolicy<MsgPackArchive, std::string, bool>(BitSerializer::MismatchedTypesPolicy::Skip);
+}
+TEST(MsgPackArchive, ThrowValidationExceptionWhenLoadStringToInteger) {
+	TestMismatchedTypesPolicy<MsgPackArchive, std::string, int32_t>(BitSerializer::MismatchedTypesPolicy::Skip);
+}
+TEST(MsgPackArchive, ThrowValidationExceptionWhenLoadStringToFloat) {
+	TestMismatchedTypesPolicy<MsgPackArchive, std::string, float>(BitSerializer::MismatchedTypesPolicy::Skip);
+}
+TEST(MsgPackArchive, ThrowMismatchedTypesExceptionWhenLoadBinaryToArrayOfIntegers)
+{
+	std::vector<int> actual;
+	try
+	{
+		BitSerializer::LoadObject<MsgPackArchive>(actual, std::string("\xC4\x03\x01\x02\x03", 5));
+		EXPECT_FALSE(true);
+	}
+	catch (const BitSerializer::SerializationException& ex)
+	{
+		EXPECT_EQ(BitSerializer::SerializationErrorCode::MismatchedTypes, ex.GetErrorCode());
+	}
+}
+TEST(MsgPackArchive, ThrowValidationExceptionWhenLoadNullToAnyType) {
+	// It doesn't matter what kind of MismatchedTypesPolicy is used, should throw only validation exception
+	TestMismatchedTypesPolicy<MsgPackArchive, std::nullptr_t, bool>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+	TestMismatchedTypesPolicy<MsgPackArchive, std::nullptr_t, uint32_t>(BitSerializer::MismatchedTypesPolicy::Skip);
+	TestMismatchedTypesPolicy<MsgPackArchive, std::nullptr_t, double>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+	TestMismatchedTypesPolicy<MsgPackArchive, std::nullptr_t, std::string>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+
+//-----------------------------------------------------------------------------
+
+TEST(MsgPackArchive, ThrowSerializationExceptionWhenOverflowBool) {
+	TestOverflowNumberPolicy<MsgPackArchive, int32_t, bool>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(MsgPackArchive, ThrowSerializationExceptionWhenOverflowInt8) {
+	TestOverflowNumberPolicy<MsgPackArchive, int16_t, int8_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<MsgPackArchive, uint16_t, uint8_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(MsgPackArchive, ThrowSerializationExceptionWhenOverflowInt16) {
+	TestOverflowNumberPolicy<MsgPackArchive, int32_t, int16_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<MsgPackArchive, uint32_t, uint16_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(MsgPackArchive, ThrowSerializationExceptionWhenOverflowInt32) {
+	TestOverflowNumberPolicy<MsgPackArchive, int64_t, int32_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<MsgPackArchive, uint64_t, uint32_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(MsgPackArchive, ThrowSerializationExceptionWhenOverflowFloat) {
+	TestOverflowNumberPolicy<MsgPackArchive, double, float>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(MsgPackArchive, ThrowSerializationExceptionWhenLoadFloatToInteger) {
+	TestOverflowNumberPolicy<MsgPackArchive, float, uint32_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<MsgPackArchive, double, uint32_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(MsgPackArchive, ThrowSerializationExceptionWhenLoadNegativeToUnsigned)
+{
+	uint64_t actual = 0;
+	const auto data = SaveToMsgPack(int64_t(-1));
+	try
+	{
+		BitSerializer::LoadObject<MsgPackArchive>(actual, data);
+		EXPECT_FALSE(true);
+	}
+	catch (const BitSerializer::SerializationException& ex)
+	{
+		EXPECT_EQ(BitSerializer::SerializationErrorCode::Overflow, ex.GetErrorCode());
+	}
+}
+
+TEST(MsgPackArchive, ThrowValidationExceptionWhenOverflowBool) {
+	TestOverflowNumberPolicy<MsgPackArchive, int32_t, bool>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(MsgPackArchive, ThrowValidationExceptionWhenNumberOverflowInt8) {
+	TestOverflowNumberPolicy<MsgPackArchive, int16_t, int8_t>(BitSerializer::OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<MsgPackArchive, uint16_t, uint8_t>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(MsgPackArchive, ThrowValidationExceptionWhenNumberOverflowInt16) {
+	TestOverflowNumberPolicy<MsgPackArchive, int32_t, int16_t>(BitSerializer::OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<MsgPackArchive, uint32_t, uint16_t>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(MsgPackArchive, ThrowValidationExceptionWhenNumberOverflowInt32) {
+	TestOverflowNumberPolicy<MsgPackArchive, int64_t, int32_t>(BitSerializer::OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<MsgPackArchive, uint64_t, uint32_t>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(MsgPackArchive, ThrowValidationExceptionWhenNumberOverflowFloat) {
+	TestOverflowNumberPolicy<MsgPackArchive, double, float>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(MsgPackArchive, ThrowValidationExceptionWhenLoadFloatToInteger) {
+	TestOverflowNumberPolicy<MsgPackArchive, float, uint32_t>(BitSerializer::OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<MsgPackArchive, double, uint32_t>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+
+
+#pragma warning(pop)
@@ -0,0 +1,499 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <sstream>
+#include <gtest/gtest.h>
+#include "bitserializer/bit_serializer.h"
+#include "bitserializer/protobuf_archive.h"
+#include "bitserializer/types/std/chrono.h"
+#include "bitserializer/types/std/vector.h"
+
+using namespace BitSerializer;
+using BitSerializer::Protobuf::ProtobufArchive;
+
+namespace
+{
+	class TestPoint
+	{
+	public:
+		TestPoint() = default;
+		TestPoint(int32_t x, int32_t y) : x(x), y(y) { }
+
+		bool operator==(const TestPoint& rhs) const noexcept { return x == rhs.x && y == rhs.y; }
+
+		template <class TArchive>
+		void Serialize(TArchive& archive)
+		{
+			archive << MakeKeyValue(1, x);
+			archive << MakeKeyValue(2, y);
+		}
+
+		int32_t x = 0;
+		int32_t y = 0;
+	};
+
+	class TestAllTypes
+	{
+	public:
+		template <class TArchive>
+		void Serialize(TArchive& archive)
+		{
+			archive << MakeKeyValue(1, boolValue);
+			archive << MakeKeyValue(2, int8Value);
+			archive << MakeKeyValue(3, uint8Value);
+			archive << MakeKeyValue(4, int16Value);
+			archive << MakeKeyValue(5, uint16Value);
+			archive << MakeKeyValue(6, int32Value);
+			archive << MakeKeyValue(7, uint32Value);
+			archive << MakeKeyValue(8, int64Value);
+			archive << MakeKeyValue(9, uint64Value);
+			archive << MakeKeyValue(10, floatValue);
+			archive << MakeKeyValue(11, doubleValue);
+			archive << MakeKeyValue(12, stringValue);
+			archive << MakeKeyValue(536870911, wstringValue);
+		}
+
+		bool boolValue = false;
+		int8_t int8Value = 0;
+		uint8_t uint8Value = 0;
+		int16_t int16Value = 0;
+		uint16_t uint16Value = 0;
+		int32_t int32Value = 0;
+		uint32_t uint32Value = 0;
+		int64_t int64Value = 0;
+		uint64_t uint64Value = 0;
+		float floatValue = 0;
+		double doubleValue = 0;
+		std::string stringValue;
+		std::wstring wstringValue;
+	};
+
+	class TestMessage
+	{
+	public:
+		template <class TArchive>
+		void Serialize(TArchive& archive)
+		{
+			archive << MakeKeyValue(1, name);
+			archive << MakeKeyValue(2, point);
+			archive << MakeKeyValue(3, points);
+			archive << MakeKeyValue(4, ids);
+			archive << MakeKeyValue(5, tags);
+			archive << MakeKeyValue(6, weights);
+			archive << MakeKeyValue(7, flags);
+			archive << MakeKeyValue(8, timestamp);
+		}
+
+		std::string name;
+		TestPoint point;
+		std::vector<TestPoint> points;
+		std::vector<int64_t> ids;
+		std::vector<std::string> tags;
+		std::vector<float> weights;
+		std::vector<bool> flags;
+		std::chrono::system_clock::time_point timestamp;
+	};
+
+	template <typename T>
+	class TestSingleField
+	{
+	public:
+		template <class TArchive>
+		void Serialize(TArchive& archive)
+		{
+			archive << MakeKeyValue(1, value);
+		}
+
+		T value{};
+	};
+
+	class TestRequiredField
+	{
+	public:
+		template <class TArchive>
+		void Serialize(TArchive& archive)
+		{
+			archive << MakeKeyValue(1, point, Required());
+			archive << MakeKeyValue(2, value, Required());
+		}
+
+		TestPoint point;
+		int32_t value = 0;
+	};
+
+	class TestInvalidFieldNumber
+	{
+	public:
+		template <class TArchive>
+		void Serialize(TArchive& archive)
+		{
+			archive << MakeKeyValue(0, value);
+		}
+
+		int32_t value = 0;
+	};
+
+	TestMessage BuildTestMessage()
+	{
+		TestMessage message;
+		message.name = "test message";
+		message.point = TestPoint(-100, 200);
+		message.points = { TestPoint(1, 2), TestPoint(-3, -4), TestPoint() };
+		for (int64_t i = 0; i < 1000; ++i) {
+			message.ids.push_back(i * 1000 - 5000);
+		}
+		message.tags = { "first", "", std::string(300, 'x') };
+		message.weights = { 0.5f, -1.25f, 1000.0f };
+		message.flags = { true, false, true };
+		message.timestamp = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+		return message;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Tests of wire format (examples from Protobuf documentation)
+//-----------------------------------------------------------------------------
+TEST(ProtobufArchive, ShouldWriteVarInt)
+{
+	TestSingleField<uint32_t> testObj;
+	testObj.value = 150;
+	EXPECT_EQ(std::string("\x08\x96\x01"), BitSerializer::SaveObject<ProtobufArchive>(testObj));
+}
+
+TEST(ProtobufArchive, ShouldWriteSignedIntegerWithZigZagEncoding)
+{
+	TestSingleField<int32_t> testObj;
+	testObj.value = -2;
+	EXPECT_EQ(std::string("\x08\x03"), BitSerializer::SaveObject<ProtobufArchive>(testObj));
+}
+
+TEST(ProtobufArchive, ShouldWriteString)
+{
+	TestSingleField<std::string> testObj;
+	testObj.value = "testing";
+	EXPECT_EQ(std::string("\x0A\x07testing"), BitSerializer::SaveObject<ProtobufArchive>(testObj));
+}
+
+TEST(ProtobufArchive, ShouldWriteEmbeddedMessage)
+{
+	TestSingleField<TestSingleField<uint32_t>> testObj;
+	testObj.value.value = 150;
+	EXPECT_EQ(std::string("\x0A\x03\x08\x96\x01"), BitSerializer::SaveObject<ProtobufArchive>(testObj));
+}
+
+TEST(ProtobufArchive, ShouldWritePackedRepeatedField)
+{
+	TestSingleField<std::vector<uint32_t>> testObj;
+	testObj.value = { 3, 270, 86942 };
+	EXPECT_EQ(std::string("\x0A\x06\x03\x8E\x02\x9E\xA7\x05"), BitSerializer::SaveObject<ProtobufArchive>(testObj));
+}
+
+TEST(ProtobufArchive, ShouldWritePackedRepeatedFieldOfBooleans)
+{
+	TestSingleField<std::vector<bool>> testObj;
+	testObj.value = { true, false, true };
+	EXPECT_EQ(std::string("\x0A\x03\x01\x00\x01", 5), BitSerializer::SaveObject<ProtobufArchive>(testObj));
+}
+
+TEST(ProtobufArchive, ShouldWriteRepeatedStringsAsSeparateFields)
+{
+	TestSingleField<std::vector<std::string>> testObj;
+	testObj.value = { "a", "bc" };
+	EXPECT_EQ(std::string("\x0A\x01" "a" "\x0A\x02" "bc"), BitSerializer::SaveObject<ProtobufArchive>(testObj));
+}
+
+TEST(ProtobufArchive, ShouldNotWriteEmptyRepeatedField)
+{
+	TestSingleField<std::vector<int32_t>> testObj;
+	EXPECT_TRUE(BitSerializer::SaveObject<ProtobufArchive>(testObj).empty());
+}
+
+TEST(ProtobufArchive, ShouldWriteLongLengthOfEmbeddedMessage)
+{
+	TestSingleField<TestSingleField<std::string>> testObj;
+	testObj.value.value = std::string(200, 'a');
+	const auto outputData = BitSerializer::SaveObject<ProtobufArchive>(testObj);
+
+	// Length of embedded message: 203 (two bytes), length of string: 200 (two bytes)
+	ASSERT_EQ(206U, outputData.size());
+	EXPECT_EQ(std::string("\x0A\xCB\x01\x0A\xC8\x01"), outputData.substr(0, 6));
+}
+
+TEST(ProtobufArchive, ShouldReadPackedAndNotPackedRepeatedFields)
+{
+	// Two not packed items and packed block
+	const std::string inputData("\x08\x03\x08\x8E\x02\x0A\x02\x01\x02", 9);
+	TestSingleField<std::vector<uint32_t>> testObj;
+	BitSerializer::LoadObject<ProtobufArchive>(testObj, inputData);
+	EXPECT_EQ(std::vector<uint32_t>({ 3, 270, 1, 2 }), testObj.value);
+}
+
+TEST(ProtobufArchive, ShouldLoadLastValueOfRepeatedScalarField)
+{
+	const std::string inputData("\x08\x01\x10\x05\x08\x02", 6);
+	TestSingleField<uint32_t> testObj;
+	BitSerializer::LoadObject<ProtobufArchive>(testObj, inputData);
+	EXPECT_EQ(2U, testObj.value);
+}
+
+TEST(ProtobufArchive, ShouldSkipUnknownFields)
+{
+	// Unknown fields: #3 (fixed64), #4 (string), #5 (fixed32)
+	const std::string inputData("\x19\x01\x02\x03\x04\x05\x06\x07\x08\x22\x02xy\x2D\x01\x02\x03\x04\x08\x04\x10\x06", 22);
+	TestPoint testObj;
+	BitSerializer::LoadObject<ProtobufArchive>(testObj, inputData);
+	EXPECT_EQ(TestPoint(2, 3), testObj);
+}
+
+TEST(ProtobufArchive, ShouldLoadFieldsInAnyOrder)
+{
+	const std::string inputData("\x10\x06\x08\x04", 4);
+	TestPoint testObj;
+	BitSerializer::LoadObject<ProtobufArchive>(testObj, inputData);
+	EXPECT_EQ(TestPoint(2, 3), testObj);
+}
+
+TEST(ProtobufArchive, ShouldLoadFixedIntegers)
+{
+	// sfixed32: -2, fixed64: 1
+	TestPoint point;
+	BitSerializer::LoadObject<ProtobufArchive>(point, std::string("\x0D\xFE\xFF\xFF\xFF\x11\x01\x00\x00\x00\x00\x00\x00\x00", 14));
+	EXPECT_EQ(TestPoint(-2, 1), point);
+}
+
+//-----------------------------------------------------------------------------
+// Tests of round trip
+//-----------------------------------------------------------------------------
+TEST(ProtobufArchive, SerializeAllTypes)
+{
+	TestAllTypes expected;
+	expected.boolValue = true;
+	expected.int8Value = std::numeric_limits<int8_t>::min();
+	expected.uint8Value = std::numeric_limits<uint8_t>::max();
+	expected.int16Value = std::numeric_limits<int16_t>::min();
+	expected.uint16Value = std::numeric_limits<uint16_t>::max();
+	expected.int32Value = std::numeric_limits<int32_t>::min();
+	expected.uint32Value = std::numeric_limits<uint32_t>::max();
+	expected.int64Value = std::numeric_limits<int64_t>::min();
+	expected.uint64Value = std::numeric_limits<uint64_t>::max();
+	expected.floatValue = std::numeric_limits<float>::lowest();
+	expected.doubleValue = std::numeric_limits<double>::max();
+	expected.stringValue = "Hello world!";
+	expected.wstringValue = L"Привет мир!";
+
+	TestAllTypes actual;
+	BitSerializer::LoadObject<ProtobufArchive>(actual, BitSerializer::SaveObject<ProtobufArchive>(expected));
+
+	EXPECT_EQ(expected.boolValue, actual.boolValue);
+	EXPECT_EQ(expected.int8Value, actual.int8Value);
+	EXPECT_EQ(expected.uint8Value, actual.uint8Value);
+	EXPECT_EQ(expected.int16Value, actual.int16Value);
+	EXPECT_EQ(expected.uint16Value, actual.uint16Value);
+	EXPECT_EQ(expected.int32Value, actual.int32Value);
+	EXPECT_EQ(expected.uint32Value, actual.uint32Value);
+	EXPECT_EQ(expected.int64Value, actual.int64Value);
+	EXPECT_EQ(expected.uint64Value, actual.uint64Value);
+	EXPECT_EQ(expected.floatValue, actual.floatValue);
+	EXPECT_EQ(expected.doubleValue, actual.doubleValue);
+	EXPECT_EQ(expected.stringValue, actual.stringValue);
+	EXPECT_EQ(expected.wstringValue, actual.wstringValue);
+}
+
+TEST(ProtobufArchive, SerializeMessageWithRepeatedFields)
+{
+	TestMessage expected = BuildTestMessage();
+	TestMessage actual;
+	actual.ids = { 1, 2, 3 };
+
+	BitSerializer::LoadObject<ProtobufArchive>(actual, BitSerializer::SaveObject<ProtobufArchive>(expected));
+
+	EXPECT_EQ(expected.name, actual.name);
+	EXPECT_EQ(expected.point, actual.point);
+	EXPECT_EQ(expected.points, actual.points);
+	EXPECT_EQ(expected.ids, actual.ids);
+	EXPECT_EQ(expected.tags, actual.tags);
+	EXPECT_EQ(expected.weights, actual.weights);
+	EXPECT_EQ(expected.flags, actual.flags);
+	EXPECT_EQ(expected.timestamp, actual.timestamp);
+}
+
+TEST(ProtobufArchive, ShouldClearArrayWhenRepeatedFieldIsAbsent)
+{
+	TestSingleField<std::vector<int32_t>> testObj;
+	testObj.value = { 1, 2, 3 };
+	BitSerializer::LoadObject<ProtobufArchive>(testObj, std::string());
+	EXPECT_TRUE(testObj.value.empty());
+}
+
+TEST(ProtobufArchive, SerializeToStream)
+{
+	TestMessage expected = BuildTestMessage();
+	std::stringstream outputStream;
+	BitSerializer::SaveObject<ProtobufArchive>(expected, outputStream);
+
+	TestMessage actual;
+	outputStream.seekg(0, std::ios::beg);
+	BitSerializer::LoadObject<ProtobufArchive>(actual, outputStream);
+	EXPECT_EQ(expected.points, actual.points);
+	EXPECT_EQ(expected.ids, actual.ids);
+	EXPECT_EQ(expected.tags, actual.tags);
+}
+
+TEST(ProtobufArchive, SerializeLargeRepeatedMessageToStream)
+{
+	// Embedded messages longer than 127 bytes and the stream is written in several chunks
+	TestSingleField<std::vector<TestSingleField<std::string>>> expected;
+	expected.value.resize(2000);
+	for (size_t i = 0; i < expected.value.size(); ++i) {
+		expected.value[i].value = std::string(100 + i % 100, static_cast<char>('a' + i % 26));
+	}
+	std::stringstream outputStream;
+	BitSerializer::SaveObject<ProtobufArchive>(expected, outputStream);
+	EXPECT_EQ(BitSerializer::SaveObject<ProtobufArchive>(expected), outputStream.str());
+
+	TestSingleField<std::vector<TestSingleField<std::string>>> actual;
+	outputStream.seekg(0, std::ios::beg);
+	BitSerializer::LoadObject<ProtobufArchive>(actual, outputStream);
+	ASSERT_EQ(expected.value.size(), actual.value.size());
+	for (size_t i = 0; i < expected.value.size(); ++i) {
+		EXPECT_EQ(expected.value[i].value, actual.value[i].value);
+	}
+}
+
+TEST(ProtobufArchive, SerializeToBinaryVector)
+{
+	TestMessage expected = BuildTestMessage();
+	std::vector<uint8_t> outputData;
+	BitSerializer::SaveObject<ProtobufArchive>(expected, outputData);
+
+	TestMessage actual;
+	BitSerializer::LoadObject<ProtobufArchive>(actual, outputData);
+	EXPECT_EQ(expected.name, actual.name);
+	EXPECT_EQ(expected.points, actual.points);
+	EXPECT_EQ(expected.ids, actual.ids);
+	EXPECT_EQ(expected.weights, actual.weights);
+}
+
+TEST(ProtobufArchive, SerializeToFile)
+{
+	const auto path = std::filesystem::temp_directory_path() / "TestProtobufArchive.bin";
+	TestMessage expected = BuildTestMessage();
+	BitSerializer::SaveObjectToFile<ProtobufArchive>(expected, path);
+
+	TestMessage actual;
+	BitSerializer::LoadObjectFromFile<ProtobufArchive>(actual, path);
+	EXPECT_EQ(expected.name, actual.name);
+	EXPECT_EQ(expected.ids, actual.ids);
+}
+
+//-----------------------------------------------------------------------------
+// Tests of errors handling
+//-----------------------------------------------------------------------------
+TEST(ProtobufArchive, ThrowParsingExceptionWhenDataIsTruncated)
+{
+	auto sourceObj = BuildTestMessage();
+	const auto outputData = BitSerializer::SaveObject<ProtobufArchive>(sourceObj);
+	TestMessage actual;
+	for (size_t size : { size_t(1), size_t(2), outputData.size() - 1 })
+	{
+		EXPECT_THROW(BitSerializer::LoadObject<ProtobufArchive>(actual, outputData.substr(0, size)), BitSerializer::ParsingException)
+			<< "Size: " << size;
+	}
+}
+
+TEST(ProtobufArchive, ThrowParsingExceptionWithOffsetOfWrongField)
+{
+	// The group (wire type 3) in the embedded message
+	TestSingleField<TestSingleField<int32_t>> testObj;
+	try
+	{
+		BitSerializer::LoadObject<ProtobufArchive>(testObj, std::string("\x0A\x02\x0B\x00", 4));
+		EXPECT_FALSE(true);
+	}
+	catch (const ParsingException& ex)
+	{
+		EXPECT_EQ(2U, ex.Offset);
+	}
+}
+
+TEST(ProtobufArchive, ThrowSerializationExceptionWhenFieldNumberIsInvalid)
+{
+	TestInvalidFieldNumber testObj;
+	try
+	{
+		BitSerializer::SaveObject<ProtobufArchive>(testObj);
+		EXPECT_FALSE(true);
+	}
+	catch (const SerializationException& ex)
+	{
+		EXPECT_EQ(SerializationErrorCode::OutOfRange, ex.GetErrorCode());
+	}
+}
+
+TEST(ProtobufArchive, ThrowValidationExceptionWhenMissedRequiredValue)
+{
+	TestRequiredField testObj;
+	try
+	{
+		BitSerializer::LoadObject<ProtobufArchive>(testObj, std::string("\x0A\x00", 2));
+		EXPECT_FALSE(true);
+	}
+	catch (const ValidationException& ex)
+	{
+		ASSERT_EQ(1U, ex.GetValidationErrors().size());
+		EXPECT_EQ("/2", ex.GetValidationErrors().begin()->first);
+	}
+}
+
+TEST(ProtobufArchive, ThrowMismatchedTypesExceptionWhenLoadStringToInteger)
+{
+	TestSingleField<int32_t> testObj;
+	try
+	{
+		BitSerializer::LoadObject<ProtobufArchive>(testObj, std::string("\x0A\x02xy"));
+		EXPECT_FALSE(true);
+	}
+	catch (const SerializationException& ex)
+	{
+		EXPECT_EQ(SerializationErrorCode::MismatchedTypes, ex.GetErrorCode());
+	}
+}
+
+TEST(ProtobufArchive, ShouldSkipMismatchedTypeWhenPolicyIsSkip)
+{
+	SerializationOptions options;
+	options.mismatchedTypesPolicy = MismatchedTypesPolicy::Skip;
+	TestSingleField<std::string> testObj;
+	testObj.value = "unchanged";
+	BitSerializer::LoadObject<ProtobufArchive>(testObj, std::string("\x08\x01"), options);
+	EXPECT_EQ("unchanged", testObj.value);
+}
+
+TEST(ProtobufArchive, ThrowSerializationExceptionWhenOverflowInt8)
+{
+	TestSingleField<int64_t> sourceObj;
+	sourceObj.value = 1000;
+	const auto outputData = BitSerializer::SaveObject<ProtobufArchive>(sourceObj);
+
+	TestSingleField<int8_t> targetObj;
+	try
+	{
+		BitSerializer::LoadObject<ProtobufArchive>(targetObj, outputData);
+		EXPECT_FALSE(true);
+	}
+	catch (const SerializationException& ex)
+	{
+		EXPECT_EQ(SerializationErrorCode::Overflow, ex.GetErrorCode());
+	}
+}
+
+TEST(ProtobufArchive, ThrowSerializationExceptionWhenOverflowFloat)
+{
+	TestSingleField<double> sourceObj;
+	sourceObj.value = std::numeric_limits<double>::max();
+	const auto outputData = BitSerializer::SaveObject<ProtobufArchive>(sourceObj);
+
+	TestSingleField<float> targetObj;
+	EXPECT_THROW(BitSerializer::LoadObject<ProtobufArchive>(targetObj, outputData), SerializationException);
+}
@@ -50,6 +50,10 @@ TEST(PugiXmlArchive, SerializeArrayOfUnicodeStrings) {
 	TestSerializeArray<XmlArchive, std::u32string>();
 }
 
+TEST(PugiXmlArchive, SerializeArrayOfEnums) {
+	TestSerializeArray<XmlArchive, TestEnum>();
+}
+
 TEST(PugiXmlArchive, SerializeArrayOfClasses) {
 	TestSerializeArray<XmlArchive, TestPointClass>();
 }
@@ -91,6 +95,10 @@ TEST(PugiXmlArchive, SerializeClassWithMemberString) {
 	TestSerializeClass<XmlArchive>(BuildFixture<TestClassWithSubTypes<std::string, std::wstring, std::u16string, std::u32string>>());
 }
 
+TEST(PugiXmlArchive, SerializeClassWithMemberEnum) {
+	TestSerializeClass<XmlArchive>(BuildFixture<TestClassWithSubTypes<TestEnum, TestEnum>>());
+}
+
 TEST(PugiXmlArchive, SerializeClassHierarchy) {
 	TestSerializeClass<XmlArchive>(BuildFixture<TestClassWithInheritance>());
 }
@@ -130,6 +138,15 @@ TEST(PugiXmlArchive, ShouldAllowToLoadFloatFromInteger)
 	EXPECT_EQ(100, actual.GetValue());
 }
 
+TEST(PugiXmlArchive, ShouldLoadElementsInAnyOrder)
+{
+	TestClassWithSubTypes<int, int, int> actual;
+	BitSerializer::LoadObject<XmlArchive>(actual, "<root><Member_2>3</Member_2><x/><Member_0>1</Member_0><Member_1>2</Member_1></root>");
+	EXPECT_EQ(1, std::get<0>(actual));
+	EXPECT_EQ(2, std::get<1>(actual));
+	EXPECT_EQ(3, std::get<2>(actual));
+}
+
 //-----------------------------------------------------------------------------
 // Tests of serialization for attributes
 //-----------------------------------------------------------------------------
@@ -153,6 +170,48 @@ TEST(PugiXmlArchive, SerializeAttributesWithString) {
 	TestSerializeClass<XmlArchive>(BuildFixture<TestClassWithAttributes<std::string, std::wstring>>());
 }
 
+//-----------------------------------------------------------------------------
+// Tests of loading options
+//-----------------------------------------------------------------------------
+TEST(PugiXmlArchive, LoadFromMutableBufferInPlace)
+{
+	std::string xml = "<root><TestValue>Hello &amp; world</TestValue></root>";
+	TestClassWithSubType<std::string> actual;
+	BitSerializer::LoadObject<XmlArchive>(actual, BitSerializer::CMutableBuffer(xml));
+	EXPECT_EQ("Hello & world", actual.GetValue());
+}
+
+TEST(PugiXmlArchive, ShouldLoadStringViewPointingToMutableBuffer)
+{
+	std::string xml = "<root><TestValue>Hello world</TestValue></root>";
+	BitSerializer::SerializationOptions options;
+	BitSerializer::SerializationContext context(options);
+	XmlArchive::input_archive_type inputArchive(BitSerializer::CMutableBuffer(xml), context);
+
+	auto objScope = inputArchive.OpenObjectScope();
+	ASSERT_TRUE(objScope.has_value());
+	std::string_view actual;
+	ASSERT_TRUE(objScope->SerializeValue(PUGIXML_TEXT("TestValue"), actual));
+	EXPECT_EQ("Hello world", actual);
+	EXPECT_EQ(xml.data() + 17, actual.data());
+}
+
+TEST(PugiXmlArchive, ShouldLoadEnumViaStringViewToDocument)
+{
+	TestClassWithSubType<TestEnum> actual;
+	BitSerializer::LoadObject<XmlArchive>(actual, "<root><TestValue>Three</TestValue></root>");
+	EXPECT_EQ(TestEnum::Three, actual.GetValue());
+}
+
+TEST(PugiXmlArchive, ShouldUseParseFlagsFromOptions)
+{
+	BitSerializer::SerializationOptions options;
+	options.parseFlags = pugi::parse_minimal;
+	TestClassWithSubType<std::string> actual;
+	BitSerializer::LoadObject<XmlArchive>(actual, "<root><TestValue>a &amp; b</TestValue></root>", options);
+	EXPECT_EQ("a &amp; b", actual.GetValue());
+}
+
 //-----------------------------------------------------------------------------
 // Tests format output XML
 //-----------------------------------------------------------------------------
@@ -255,6 +314,93 @@ TEST(PugiXmlArchive, SerializeToFile) {
 	TestSerializeArrayToFile<XmlArchive>();
 }
 
+TEST(PugiXmlArchive, SerializeLargeArrayToStream)
+{
+	std::vector<TestPointClass> expected(10000);
+	::BuildFixture(expected);
+	std::vector<TestPointClass> actual;
+
+	BitSerializer::SerializationOptions serializationOptions;
+	serializationOptions.streamOptions.writeBom = false;
+	std::stringstream outputStream;
+	BitSerializer::SaveObject<XmlArchive>(expected, outputStream, serializationOptions);
+	EXPECT_EQ(BitSerializer::SaveObject<XmlArchive>(expected), outputStream.str());
+	outputStream.seekg(0, std::ios::beg);
+	BitSerializer::LoadObject<XmlArchive>(actual, outputStream);
+
+	ASSERT_EQ(expected.size(), actual.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		expected[i].Assert(actual[i]);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Tests of streaming writer
+//-----------------------------------------------------------------------------
+TEST(PugiXmlArchive, ShouldEscapeSpecialCharactersWhenSaving)
+{
+	TestClassWithSubType<std::string> testObj("<a & \"b\">\x01");
+	const auto result = BitSerializer::SaveObject<XmlArchive>(testObj);
+	EXPECT_EQ("<?xml version=\"1.0\"?><root><TestValue>&lt;a &amp; \"b\"&gt;&#01;</TestValue></root>", result);
+
+	TestClassWithSubType<std::string> actual;
+	BitSerializer::LoadObject<XmlArchive>(actual, result);
+	EXPECT_EQ(testObj.GetValue(), actual.GetValue());
+}
+
+TEST(PugiXmlArchive, ShouldEscapeSpecialCharactersInAttributes)
+{
+	TestClassWithAttributes<std::string> testObj("<a & \"b\">\t");
+	const auto result = BitSerializer::SaveObject<XmlArchive>(testObj);
+	EXPECT_EQ("<?xml version=\"1.0\"?><root Attribute_0=\"&lt;a &amp; &quot;b&quot;>&#09;\"/>", result);
+}
+
+TEST(PugiXmlArchive, ShouldWriteEmptyElementsWhenSaving)
+{
+	TestClassWithSubTypes<std::nullptr_t, std::vector<int>> testObj;
+	const auto result = BitSerializer::SaveObject<XmlArchive>(testObj);
+	EXPECT_EQ("<?xml version=\"1.0\"?><root><Member_0/><Member_1/></root>", result);
+}
+
+TEST(PugiXmlArchive, ShouldSaveFloatsInShortestForm)
+{
+	TestClassWithSubTypes<float, double> testObj(0.1f, 0.3);
+	const auto result = BitSerializer::SaveObject<XmlArchive>(testObj);
+	EXPECT_EQ("<?xml version=\"1.0\"?><root><Member_0>0.1</Member_0><Member_1>0.3</Member_1></root>", result);
+}
+
+TEST(PugiXmlArchive, ShouldSaveFloatsWithPrecisionFromOptions)
+{
+	BitSerializer::SerializationOptions options;
+	options.formatOptions.floatPrecision = 3;
+	TestClassWithAttributes<double> testObj(3.14159);
+	std::string result;
+	BitSerializer::SaveObject<XmlArchive>(testObj, result, options);
+	EXPECT_EQ("<?xml version=\"1.0\"?><root Attribute_0=\"3.14\"/>", result);
+}
+
+namespace
+{
+	class TestAttributeAfterElement
+	{
+	public:
+		template <class TArchive>
+		void Serialize(TArchive& archive)
+		{
+			archive << BitSerializer::MakeAutoKeyValue("x", x);
+			archive << BitSerializer::MakeAutoAttributeValue("y", y);
+		}
+
+		int x = 10, y = 20;
+	};
+}
+
+TEST(PugiXmlArchive, ThrowExceptionWhenSaveAttributeAfterChildElement)
+{
+	TestAttributeAfterElement testObj;
+	EXPECT_THROW(BitSerializer::SaveObject<XmlArchive>(testObj), BitSerializer::SerializationException);
+}
+
 //-----------------------------------------------------------------------------
 // Tests of errors handling
 //-----------------------------------------------------------------------------
@@ -310,6 +456,9 @@ TEST(PugiXmlArchive, ThrowMismatchedTypesExceptionWhenLoadStringToInteger) {
 TEST(PugiXmlArchive, ThrowMismatchedTypesExceptionWhenLoadStringToFloat) {
 	TestMismatchedTypesPolicy<XmlArchive, std::string, float>(BitSerializer::MismatchedTypesPolicy::ThrowError);
 }
+TEST(PugiXmlArchive, ThrowMismatchedTypesExceptionWhenLoadStringToEnum) {
+	TestMismatchedTypesPolicy<XmlArchive, std::string, TestEnum>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
 
 TEST(PugiXmlArchive, ThrowValidationExceptionWhenLoadStringToBoolean) {
 	TestMismatchedTypesPolicy<XmlArchive, std::string, bool>(BitSerializer::MismatchedTypesPolicy::Skip);
@@ -320,6 +469,9 @@ TEST(PugiXmlArchive, ThrowValidationExceptionWhenLoadStringToInteger) {
 TEST(PugiXmlArchive, ThrowValidationExceptionWhenLoadStringToFloat) {
 	TestMismatchedTypesPolicy<XmlArchive, std::string, float>(BitSerializer::MismatchedTypesPolicy::Skip);
 }
+TEST(PugiXmlArchive, ThrowValidationExceptionWhenLoadStringToEnum) {
+	TestMismatchedTypesPolicy<XmlArchive, std::string, TestEnum>(BitSerializer::MismatchedTypesPolicy::Skip);
+}
 TEST(PugiXmlArchive, ThrowValidationExceptionWhenLoadNullToAnyType) {
 	// It doesn't matter what kind of MismatchedTypesPolicy is used, should throw only validation exception
 	TestMismatchedTypesPolicy<XmlArchive, std::nullptr_t, bool>(BitSerializer::MismatchedTypesPolicy::ThrowError);
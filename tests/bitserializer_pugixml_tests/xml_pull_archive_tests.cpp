@@ -0,0 +1,344 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include "bitserializer/pugixml_archive.h"
+#include "bitserializer/types/std/map.h"
+#include "testing_tools/common_test_methods.h"
+#include "testing_tools/common_xml_test_methods.h"
+
+using BitSerializer::Xml::PugiXml::XmlPullArchive;
+
+//-----------------------------------------------------------------------------
+// Tests of serialization for c-arrays (at root scope of archive)
+//-----------------------------------------------------------------------------
+TEST(XmlPullArchive, SerializeArrayWithKeyOnRootLevel) {
+	TestSerializeArray<XmlPullArchive, int16_t>();
+}
+
+TEST(XmlPullArchive, SerializeArrayOfBooleans) {
+	TestSerializeArray<XmlPullArchive, bool>();
+}
+
+TEST(XmlPullArchive, SerializeArrayOfIntegers)
+{
+	TestSerializeArray<XmlPullArchive, uint16_t>();
+	TestSerializeArray<XmlPullArchive, int64_t>();
+}
+
+TEST(XmlPullArchive, SerializeArrayOfFloats) {
+	TestSerializeArray<XmlPullArchive, float>();
+	TestSerializeArray<XmlPullArchive, double>();
+}
+
+TEST(XmlPullArchive, SerializeArrayOfNullptrs) {
+	TestSerializeArray<XmlPullArchive, std::nullptr_t>();
+}
+
+TEST(XmlPullArchive, SerializeArrayOfStrings) {
+	TestSerializeArray<XmlPullArchive, std::string>();
+}
+
+TEST(XmlPullArchive, SerializeArrayOfUnicodeStrings) {
+	TestSerializeArray<XmlPullArchive, std::wstring>();
+	TestSerializeArray<XmlPullArchive, std::u16string>();
+	TestSerializeArray<XmlPullArchive, std::u32string>();
+}
+
+TEST(XmlPullArchive, SerializeArrayOfClasses) {
+	TestSerializeArray<XmlPullArchive, TestPointClass>();
+}
+
+TEST(XmlPullArchive, SerializeTwoDimensionalArray) {
+	TestSerializeTwoDimensionalArray<XmlPullArchive, int32_t>();
+}
+
+//-----------------------------------------------------------------------------
+// Tests of serialization for classes
+//-----------------------------------------------------------------------------
+TEST(XmlPullArchive, SerializeClassWithKeyOnRootLevel) {
+	TestSerializeClassWithKey<XmlPullArchive>(BuildFixture<TestClassWithSubTypes<int16_t>>());
+}
+
+TEST(XmlPullArchive, SerializeClassWithMemberBoolean) {
+	TestSerializeClass<XmlPullArchive>(TestClassWithSubTypes<bool>(false));
+	TestSerializeClass<XmlPullArchive>(TestClassWithSubTypes<bool>(true));
+}
+
+TEST(XmlPullArchive, SerializeClassWithMemberInteger) {
+	TestSerializeClass<XmlPullArchive>(BuildFixture<TestClassWithSubTypes<int8_t, uint8_t, int64_t, uint64_t>>());
+	TestSerializeClass<XmlPullArchive>(TestClassWithSubTypes(std::numeric_limits<int64_t>::min(), std::numeric_limits<uint64_t>::max()));
+}
+
+TEST(XmlPullArchive, SerializeClassWithMemberDouble) {
+	TestSerializeClass<XmlPullArchive>(TestClassWithSubTypes(std::numeric_limits<double>::min(), 0.0, std::numeric_limits<double>::max()));
+}
+
+TEST(XmlPullArchive, SerializeClassWithMemberNullptr) {
+	TestSerializeClass<XmlPullArchive>(BuildFixture<TestClassWithSubTypes<std::nullptr_t>>());
+}
+
+TEST(XmlPullArchive, SerializeClassWithMemberString) {
+	TestSerializeClass<XmlPullArchive>(BuildFixture<TestClassWithSubTypes<std::string, std::wstring, std::u16string, std::u32string>>());
+}
+
+TEST(XmlPullArchive, SerializeClassHierarchy) {
+	TestSerializeClass<XmlPullArchive>(BuildFixture<TestClassWithInheritance>());
+}
+
+TEST(XmlPullArchive, SerializeClassWithMemberClass) {
+	using TestClassType = TestClassWithSubTypes<TestClassWithSubTypes<int64_t>>;
+	TestSerializeClass<XmlPullArchive>(BuildFixture<TestClassType>());
+}
+
+TEST(XmlPullArchive, SerializeClassWithSubArrayOfClasses) {
+	TestSerializeClass<XmlPullArchive>(BuildFixture<TestClassWithSubArray<TestPointClass>>());
+}
+
+TEST(XmlPullArchive, SerializeClassWithSubTwoDimArray) {
+	TestSerializeClass<XmlPullArchive>(BuildFixture<TestClassWithSubTwoDimArray<int32_t>>());
+}
+
+TEST(XmlPullArchive, ShouldIterateKeysInObjectScope) {
+	TestIterateKeysInObjectScope<XmlPullArchive>();
+}
+
+TEST(XmlPullArchive, ShouldLoadMapInDocumentOrder)
+{
+	std::map<std::string, int> actual;
+	BitSerializer::LoadObject<XmlPullArchive>(actual, "<root><b>2</b><a>1</a></root>");
+	EXPECT_EQ((std::map<std::string, int>{ { "a", 1 }, { "b", 2 } }), actual);
+}
+
+//-----------------------------------------------------------------------------
+// Tests of serialization for attributes
+//-----------------------------------------------------------------------------
+TEST(XmlPullArchive, SerializeAttributesWithIntegers) {
+	TestSerializeClass<XmlPullArchive>(BuildFixture<TestClassWithAttributes<int8_t, uint8_t, int64_t, uint64_t>>());
+}
+
+TEST(XmlPullArchive, SerializeAttributesWithNullptr) {
+	TestSerializeClass<XmlPullArchive>(BuildFixture<TestClassWithAttributes<std::nullptr_t>>());
+}
+
+TEST(XmlPullArchive, SerializeAttributesWithString) {
+	TestSerializeClass<XmlPullArchive>(BuildFixture<TestClassWithAttributes<std::string, std::wstring>>());
+}
+
+//-----------------------------------------------------------------------------
+// Tests of pull reader
+//-----------------------------------------------------------------------------
+TEST(XmlPullArchive, ShouldSkipNotLoadedElements)
+{
+	TestClassWithSubTypes<int, std::string> actual;
+	BitSerializer::LoadObject<XmlPullArchive>(actual, R"(<?xml version="1.0"?>
+<!DOCTYPE root [<!ELEMENT root ANY>]>
+<!-- Comment -->
+<root>
+	<Unknown a="<>"><Member_0>1</Member_0><x/><![CDATA[</Unknown>]]></Unknown>
+	<Member_0>10</Member_0>
+	<?pi text?>
+	<Unknown><y><z>text</z></y></Unknown>
+	<Member_1>Hello</Member_1>
+	<Unknown/>
+</root>)");
+	EXPECT_EQ(10, std::get<0>(actual));
+	EXPECT_EQ("Hello", std::get<1>(actual));
+}
+
+TEST(XmlPullArchive, ShouldLoadRestFieldsWhenMiddleOneIsMissed)
+{
+	TestClassWithSubTypes<int, int, int> actual;
+	BitSerializer::LoadObject<XmlPullArchive>(actual, "<root><Member_0>1</Member_0><Member_2>3</Member_2></root>");
+	EXPECT_EQ(1, std::get<0>(actual));
+	EXPECT_EQ(0, std::get<1>(actual));
+	EXPECT_EQ(3, std::get<2>(actual));
+}
+
+TEST(XmlPullArchive, ShouldLoadRestFieldsWhenMiddleOneIsMissedInStream)
+{
+	// The skipped element exceeds several chunks of stream reader
+	std::stringstream stream;
+	stream << "<root><Member_0>1</Member_0><Unknown>" << std::string(300000, 'x') << "</Unknown><Member_2>3</Member_2></root>";
+	TestClassWithSubTypes<int, int, int> actual;
+	BitSerializer::LoadObject<XmlPullArchive>(actual, stream);
+	EXPECT_EQ(1, std::get<0>(actual));
+	EXPECT_EQ(0, std::get<1>(actual));
+	EXPECT_EQ(3, std::get<2>(actual));
+}
+
+TEST(XmlPullArchive, ShouldLoadRestFieldsWhenMiddleOneIsMissedAfterHugeElementsInStream)
+{
+	// The skipped elements exceed the limit of data which is kept after bookmark, so they are re-read from the stream
+	std::stringstream stream;
+	stream << "<root><Member_0>1</Member_0>";
+	for (size_t i = 0; i < 100000; ++i) {
+		stream << "<Unknown><Value>" << i << "</Value><Text>" << std::string(50, 'x') << "</Text></Unknown>";
+	}
+	stream << "<Member_2>3</Member_2></root>";
+	TestClassWithSubTypes<int, int, int> actual;
+	BitSerializer::LoadObject<XmlPullArchive>(actual, stream);
+	EXPECT_EQ(1, std::get<0>(actual));
+	EXPECT_EQ(0, std::get<1>(actual));
+	EXPECT_EQ(3, std::get<2>(actual));
+}
+
+TEST(XmlPullArchive, ShouldNotKeepSkippedElementsInBufferWhenBookmarkIsSet)
+{
+	std::stringstream stream;
+	stream << "<root>";
+	for (size_t i = 0; i < 100000; ++i) {
+		stream << "<Item" << i << ">" << std::string(100, 'x') << "</Item" << i << ">";
+	}
+	stream << "</root>";
+	BitSerializer::Xml::PugiXml::Detail::CXmlPullReader reader(stream);
+	ASSERT_TRUE(reader.PeekElement());
+	reader.EnterElement();
+	ASSERT_TRUE(reader.PeekElement());
+	reader.SetBookmark();
+
+	size_t maxBufferedSize = 0;
+	do
+	{
+		reader.SkipElement();
+		maxBufferedSize = std::max(maxBufferedSize, reader.GetBufferedSize());
+	} while (reader.PeekElement());
+	reader.RestoreBookmark();
+
+	EXPECT_GT(stream.str().size(), 10000000U);
+	EXPECT_LT(maxBufferedSize, 4000000U);
+	ASSERT_TRUE(reader.PeekElement());
+	EXPECT_EQ("Item0", reader.GetPendingName());
+	reader.SkipElement();
+	ASSERT_TRUE(reader.PeekElement());
+	EXPECT_EQ("Item1", reader.GetPendingName());
+}
+
+TEST(XmlPullArchive, ShouldDecodeEntitiesAndCData)
+{
+	TestClassWithSubType<std::string> actual;
+	BitSerializer::LoadObject<XmlPullArchive>(actual, "<root><TestValue>&lt;a &amp; &quot;b&quot;&gt;&#x41;&#66;<![CDATA[<&>]]>\r\n</TestValue></root>");
+	EXPECT_EQ("<a & \"b\">AB<&>\n", actual.GetValue());
+}
+
+TEST(XmlPullArchive, ShouldLoadStringAsViewToInputData)
+{
+	const std::string xml = "<root><TestValue>Hello world</TestValue></root>";
+	BitSerializer::SerializationOptions options;
+	BitSerializer::SerializationContext context(options);
+	XmlPullArchive::input_archive_type inputArchive(xml, context);
+
+	auto objScope = inputArchive.OpenObjectScope();
+	ASSERT_TRUE(objScope.has_value());
+	std::string_view actual;
+	ASSERT_TRUE(objScope->SerializeValue("TestValue", actual));
+	EXPECT_EQ("Hello world", actual);
+	EXPECT_EQ(xml.data() + 17, actual.data());
+}
+
+//-----------------------------------------------------------------------------
+// Tests streams / files
+//-----------------------------------------------------------------------------
+TEST(XmlPullArchive, SerializeClassToStream) {
+	TestSerializeClassToStream<XmlPullArchive, char>(BuildFixture<TestPointClass>());
+}
+
+TEST(XmlPullArchive, LoadFromUtf8Stream) {
+	TestLoadXmlFromEncodedStream<XmlPullArchive, BitSerializer::Convert::Utf8>(false);
+}
+TEST(XmlPullArchive, LoadFromUtf8StreamWithBom) {
+	TestLoadXmlFromEncodedStream<XmlPullArchive, BitSerializer::Convert::Utf8>(true);
+}
+
+TEST(XmlPullArchive, LoadFromUtf16LeStream) {
+	TestLoadXmlFromEncodedStream<XmlPullArchive, BitSerializer::Convert::Utf16Le>(false);
+}
+TEST(XmlPullArchive, LoadFromUtf16LeStreamWithBom) {
+	TestLoadXmlFromEncodedStream<XmlPullArchive, BitSerializer::Convert::Utf16Le>(true);
+}
+
+TEST(XmlPullArchive, LoadFromUtf32BeStreamWithBom) {
+	TestLoadXmlFromEncodedStream<XmlPullArchive, BitSerializer::Convert::Utf32Be>(true);
+}
+
+TEST(XmlPullArchive, SerializeLargeArrayViaStream)
+{
+	// The size of XML should exceed several chunks of stream reader
+	std::vector<TestPointClass> expected(50000);
+	for (auto& item : expected) {
+		::BuildFixture(item);
+	}
+	std::vector<TestPointClass> actual;
+
+	std::stringstream stream;
+	BitSerializer::SaveObject<XmlPullArchive>(expected, stream);
+	stream.seekg(0, std::ios::beg);
+	BitSerializer::LoadObject<XmlPullArchive>(actual, stream);
+
+	ASSERT_EQ(expected.size(), actual.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		expected[i].Assert(actual[i]);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Tests of errors handling
+//-----------------------------------------------------------------------------
+TEST(XmlPullArchive, ThrowExceptionWhenBadSyntaxInSource) {
+	auto fixture = BuildFixture<TestClassWithSubTypes<std::string>>();
+	EXPECT_THROW(BitSerializer::LoadObject<XmlPullArchive>(fixture, "<root>Hello"), BitSerializer::ParsingException);
+}
+
+TEST(XmlPullArchive, ThrowExceptionWhenMismatchedEndTag) {
+	TestClassWithSubTypes<int, int> actual;
+	EXPECT_THROW(BitSerializer::LoadObject<XmlPullArchive>(actual, "<root><Member_0>1</Member_1></root>"), BitSerializer::ParsingException);
+	EXPECT_THROW(BitSerializer::LoadObject<XmlPullArchive>(actual, "<root><x><y></x></root>"), BitSerializer::ParsingException);
+}
+
+TEST(XmlPullArchive, ThrowExceptionWhenNoDocumentElement) {
+	TestPointClass actual;
+	EXPECT_THROW(BitSerializer::LoadObject<XmlPullArchive>(actual, "<?xml version=\"1.0\"?>"), BitSerializer::ParsingException);
+}
+
+TEST(XmlPullArchive, ThrowParsingExceptionWithCorrectPosition)
+{
+	const std::string testXml = "<root><x>10</x><y 20</y></root>";
+	TestPointClass actual;
+	try
+	{
+		BitSerializer::LoadObject<XmlPullArchive>(actual, testXml);
+		EXPECT_FALSE(true);
+	}
+	catch (const BitSerializer::ParsingException& ex)
+	{
+		EXPECT_EQ(21, ex.Offset);
+	}
+}
+
+//-----------------------------------------------------------------------------
+TEST(XmlPullArchive, ThrowValidationExceptionWhenMissedRequiredValue) {
+	TestValidationForNamedValues<XmlPullArchive, TestClassForCheckValidation<int>>();
+	TestValidationForNamedValues<XmlPullArchive, TestClassForCheckValidation<std::string>>();
+	TestValidationForNamedValues<XmlPullArchive, TestClassForCheckValidation<TestPointClass>>();
+}
+
+TEST(XmlPullArchive, ThrowMismatchedTypesExceptionWhenLoadStringToInteger) {
+	TestMismatchedTypesPolicy<XmlPullArchive, std::string, int32_t>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+
+TEST(XmlPullArchive, ThrowValidationExceptionWhenLoadStringToInteger) {
+	TestMismatchedTypesPolicy<XmlPullArchive, std::string, int32_t>(BitSerializer::MismatchedTypesPolicy::Skip);
+}
+
+TEST(XmlPullArchive, ThrowValidationExceptionWhenLoadNullToAnyType) {
+	TestMismatchedTypesPolicy<XmlPullArchive, std::nullptr_t, bool>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+	TestMismatchedTypesPolicy<XmlPullArchive, std::nullptr_t, double>(BitSerializer::MismatchedTypesPolicy::Skip);
+}
+
+TEST(XmlPullArchive, ThrowSerializationExceptionWhenOverflowInt8) {
+	TestOverflowNumberPolicy<XmlPullArchive, int16_t, int8_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+
+TEST(XmlPullArchive, ThrowValidationExceptionWhenNumberOverflowInt8) {
+	TestOverflowNumberPolicy<XmlPullArchive, int16_t, int8_t>(BitSerializer::OverflowNumberPolicy::Skip);
+}
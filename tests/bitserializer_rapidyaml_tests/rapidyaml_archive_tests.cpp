@@ -2,6 +2,8 @@
 * Copyright (C) 2020-2023 by Artsiom Marozau, Pavel Kisliak                    *
 * This file is part of BitSerializer library, licensed under the MIT license.  *
 *******************************************************************************/
+#include <atomic>
+#include <thread>
 #include "testing_tools/common_test_methods.h"
 #include "testing_tools/common_json_test_methods.h"
 #include "testing_tools/common_yaml_test_methods.h"
@@ -35,6 +37,32 @@ TEST(RapidYamlArchive, SerializeArrayOfFloats)
 	TestSerializeArray<YamlArchive, double>();
 }
 
+TEST(RapidYamlArchive, SerializeArrayOfNonFiniteFloats)
+{
+	const double source[3] = { std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN() };
+	std::string outputData;
+	BitSerializer::SaveObject<YamlArchive>(source, outputData);
+	EXPECT_NE(std::string::npos, outputData.find("- .inf"));
+	EXPECT_NE(std::string::npos, outputData.find("- -.inf"));
+	EXPECT_NE(std::string::npos, outputData.find("- .nan"));
+
+	double actual[3] = { 0, 0, 0 };
+	BitSerializer::LoadObject<YamlArchive>(actual, outputData);
+	EXPECT_EQ(std::numeric_limits<double>::infinity(), actual[0]);
+	EXPECT_EQ(-std::numeric_limits<double>::infinity(), actual[1]);
+	EXPECT_TRUE(std::isnan(actual[2]));
+}
+
+TEST(RapidYamlArchive, ShouldLoadNonFiniteFloatsInAnyCase)
+{
+	float actual[4] = { 0, 0, 0, 0 };
+	BitSerializer::LoadObject<YamlArchive>(actual, "- .Inf\n- -.INF\n- +.inf\n- .NaN\n");
+	EXPECT_EQ(std::numeric_limits<float>::infinity(), actual[0]);
+	EXPECT_EQ(-std::numeric_limits<float>::infinity(), actual[1]);
+	EXPECT_EQ(std::numeric_limits<float>::infinity(), actual[2]);
+	EXPECT_TRUE(std::isnan(actual[3]));
+}
+
 TEST(RapidYamlArchive, SerializeArrayOfNullptrs)
 {
 	TestSerializeArray<YamlArchive, std::nullptr_t>();
@@ -52,6 +80,11 @@ TEST(RapidYamlArchive, SerializeArrayOfUnicodeStrings)
 	TestSerializeArray<YamlArchive, std::u32string>();
 }
 
+TEST(RapidYamlArchive, SerializeArrayOfEnums)
+{
+	TestSerializeArray<YamlArchive, TestEnum>();
+}
+
 TEST(RapidYamlArchive, SerializeArrayOfClasses)
 {
 	TestSerializeArray<YamlArchive, TestPointClass>();
@@ -97,6 +130,11 @@ TEST(RapidYamlArchive, SerializeClassWithMemberString)
 	TestSerializeClass<YamlArchive>(BuildFixture<TestClassWithSubTypes<std::string, std::wstring, std::u16string, std::u32string>>());
 }
 
+TEST(RapidYamlArchive, SerializeClassWithMemberEnum)
+{
+	TestSerializeClass<YamlArchive>(BuildFixture<TestClassWithSubTypes<TestEnum, TestEnum>>());
+}
+
 TEST(RapidYamlArchive, SerializeClassHierarchy)
 {
 	TestSerializeClass<YamlArchive>(BuildFixture<TestClassWithInheritance>());
@@ -165,6 +203,39 @@ TEST(RapidYamlArchive, ShouldReturnPathInArrayScopeWhenSaving)
 	TestGetPathInJsonArrayScopeWhenSaving<YamlArchive>();
 }
 
+//-----------------------------------------------------------------------------
+// Tests of loading from mutable buffer
+//-----------------------------------------------------------------------------
+TEST(RapidYamlArchive, LoadFromMutableBufferInPlace)
+{
+	std::string yaml = "x: 10\ny: 20\n";
+	TestPointClass actual(0, 0);
+	BitSerializer::LoadObject<YamlArchive>(actual, BitSerializer::CMutableBuffer(yaml));
+	actual.Assert(TestPointClass(10, 20));
+}
+
+TEST(RapidYamlArchive, ShouldLoadStringViewPointingToMutableBuffer)
+{
+	std::string yaml = "TestValue: Hello world\n";
+	BitSerializer::SerializationOptions options;
+	BitSerializer::SerializationContext context(options);
+	YamlArchive::input_archive_type inputArchive(BitSerializer::CMutableBuffer(yaml), context);
+
+	auto objScope = inputArchive.OpenObjectScope();
+	ASSERT_TRUE(objScope.has_value());
+	std::string_view actual;
+	ASSERT_TRUE(objScope->SerializeValue("TestValue", actual));
+	EXPECT_EQ("Hello world", actual);
+	EXPECT_EQ(yaml.data() + 11, actual.data());
+}
+
+TEST(RapidYamlArchive, ShouldLoadEnumViaStringViewToTree)
+{
+	TestClassWithSubType<TestEnum> actual;
+	BitSerializer::LoadObject<YamlArchive>(actual, "TestValue: Three");
+	EXPECT_EQ(TestEnum::Three, actual.GetValue());
+}
+
 //-----------------------------------------------------------------------------
 // Tests streams / files
 //-----------------------------------------------------------------------------
@@ -184,6 +255,34 @@ TEST(RapidYamlArchive, LoadFromUtf8StreamWithBom) {
 	TestLoadYamlFromEncodedStream<YamlArchive, BitSerializer::Convert::Utf8>(true);
 }
 
+TEST(RapidYamlArchive, LoadFromUtf16LeStream) {
+	TestLoadYamlFromEncodedStream<YamlArchive, BitSerializer::Convert::Utf16Le>(false);
+}
+TEST(RapidYamlArchive, LoadFromUtf16LeStreamWithBom) {
+	TestLoadYamlFromEncodedStream<YamlArchive, BitSerializer::Convert::Utf16Le>(true);
+}
+
+TEST(RapidYamlArchive, LoadFromUtf16BeStream) {
+	TestLoadYamlFromEncodedStream<YamlArchive, BitSerializer::Convert::Utf16Be>(false);
+}
+TEST(RapidYamlArchive, LoadFromUtf16BeStreamWithBom) {
+	TestLoadYamlFromEncodedStream<YamlArchive, BitSerializer::Convert::Utf16Be>(true);
+}
+
+TEST(RapidYamlArchive, LoadFromUtf32LeStream) {
+	TestLoadYamlFromEncodedStream<YamlArchive, BitSerializer::Convert::Utf32Le>(false);
+}
+TEST(RapidYamlArchive, LoadFromUtf32LeStreamWithBom) {
+	TestLoadYamlFromEncodedStream<YamlArchive, BitSerializer::Convert::Utf32Le>(true);
+}
+
+TEST(RapidYamlArchive, LoadFromUtf32BeStream) {
+	TestLoadYamlFromEncodedStream<YamlArchive, BitSerializer::Convert::Utf32Be>(false);
+}
+TEST(RapidYamlArchive, LoadFromUtf32BeStreamWithBom) {
+	TestLoadYamlFromEncodedStream<YamlArchive, BitSerializer::Convert::Utf32Be>(true);
+}
+
 TEST(RapidYamlArchive, SaveToUtf8Stream) {
 	TestSaveYamlToEncodedStream<YamlArchive, BitSerializer::Convert::Utf8>(false);
 }
@@ -191,10 +290,192 @@ TEST(RapidYamlArchive, SaveToUtf8StreamWithBom) {
 	TestSaveYamlToEncodedStream<YamlArchive, BitSerializer::Convert::Utf8>(true);
 }
 
+TEST(RapidYamlArchive, SaveToUtf16LeStream) {
+	TestSaveYamlToEncodedStream<YamlArchive, BitSerializer::Convert::Utf16Le>(false);
+}
+TEST(RapidYamlArchive, SaveToUtf16LeStreamWithBom) {
+	TestSaveYamlToEncodedStream<YamlArchive, BitSerializer::Convert::Utf16Le>(true);
+}
+
+TEST(RapidYamlArchive, SaveToUtf16BeStream) {
+	TestSaveYamlToEncodedStream<YamlArchive, BitSerializer::Convert::Utf16Be>(false);
+}
+TEST(RapidYamlArchive, SaveToUtf16BeStreamWithBom) {
+	TestSaveYamlToEncodedStream<YamlArchive, BitSerializer::Convert::Utf16Be>(true);
+}
+
+TEST(RapidYamlArchive, SaveToUtf32LeStream) {
+	TestSaveYamlToEncodedStream<YamlArchive, BitSerializer::Convert::Utf32Le>(false);
+}
+TEST(RapidYamlArchive, SaveToUtf32LeStreamWithBom) {
+	TestSaveYamlToEncodedStream<YamlArchive, BitSerializer::Convert::Utf32Le>(true);
+}
+
+TEST(RapidYamlArchive, SaveToUtf32BeStream) {
+	TestSaveYamlToEncodedStream<YamlArchive, BitSerializer::Convert::Utf32Be>(false);
+}
+TEST(RapidYamlArchive, SaveToUtf32BeStreamWithBom) {
+	TestSaveYamlToEncodedStream<YamlArchive, BitSerializer::Convert::Utf32Be>(true);
+}
+
 TEST(RapidYamlArchive, SerializeToFile) {
 	TestSerializeArrayToFile<YamlArchive>();
 }
 
+TEST(RapidYamlArchive, SerializeLargeArrayToStream)
+{
+	// The size of YAML should exceed several blocks which are read from the stream
+	std::vector<TestPointClass> expected(20000);
+	for (auto& item : expected) {
+		::BuildFixture(item);
+	}
+	std::vector<TestPointClass> actual;
+
+	std::stringstream stream;
+	BitSerializer::SaveObject<YamlArchive>(expected, stream);
+	stream.seekg(0, std::ios::beg);
+	BitSerializer::LoadObject<YamlArchive>(actual, stream);
+
+	ASSERT_EQ(expected.size(), actual.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		expected[i].Assert(actual[i]);
+	}
+}
+
+TEST(RapidYamlArchive, SerializeLargeArrayToEncodedStream)
+{
+	// The size of YAML should exceed several chunks which are written to the stream (multibyte chars may be split between chunks)
+	std::vector<std::string> expected(20000, "Привет мир! 😀");
+	for (size_t i = 0; i < expected.size(); ++i) {
+		expected[i] += std::to_string(i);
+	}
+	std::vector<std::string> actual;
+	BitSerializer::SerializationOptions options;
+	options.streamOptions.encoding = BitSerializer::Convert::UtfType::Utf16le;
+
+	std::stringstream stream;
+	BitSerializer::SaveObject<YamlArchive>(expected, stream, options);
+	stream.seekg(0, std::ios::beg);
+	BitSerializer::LoadObject<YamlArchive>(actual, stream);
+
+	EXPECT_EQ(expected, actual);
+}
+
+TEST(RapidYamlArchive, ShouldSaveFloatsInShortestForm)
+{
+	TestClassWithSubType<double> testObj(0.5);
+	std::string yaml;
+	BitSerializer::SaveObject<YamlArchive>(testObj, yaml);
+	EXPECT_EQ("TestValue: 0.5\n", yaml);
+
+	TestClassWithSubType<float> testFloatObj(0.1f);
+	BitSerializer::SaveObject<YamlArchive>(testFloatObj, yaml);
+	EXPECT_EQ("TestValue: 0.1\n", yaml);
+}
+
+TEST(RapidYamlArchive, ShouldSaveFloatsWithPrecisionFromOptions)
+{
+	TestClassWithSubType<double> testObj(3.14159265);
+	BitSerializer::SerializationOptions options;
+	options.formatOptions.floatPrecision = 3;
+	std::string yaml;
+	BitSerializer::SaveObject<YamlArchive>(testObj, yaml, options);
+	EXPECT_EQ("TestValue: 3.14\n", yaml);
+}
+
+TEST(RapidYamlArchive, ShouldEmitIntoExistingStringCapacity)
+{
+	// The output string contains data which should be overwritten
+	std::string yaml(1024, 'x');
+	const auto* prevData = yaml.data();
+	const std::vector<int> testArray = { 1, 2, 3 };
+	BitSerializer::SaveObject<YamlArchive>(testArray, yaml);
+	EXPECT_EQ("- 1\n- 2\n- 3\n", yaml);
+	EXPECT_EQ(prevData, yaml.data());
+
+	// The output string is too small
+	std::vector<std::string> largeArray(1000, "Hello world!");
+	yaml.shrink_to_fit();
+	BitSerializer::SaveObject<YamlArchive>(largeArray, yaml);
+	std::vector<std::string> actual;
+	BitSerializer::LoadObject<YamlArchive>(actual, yaml);
+	EXPECT_EQ(largeArray, actual);
+}
+
+TEST(RapidYamlArchive, ShouldReuseTreeForNextSerializations)
+{
+	// Serialize large array for allocating the tree which is reused by next calls
+	std::vector<TestPointClass> largeArray(5000);
+	for (auto& item : largeArray) {
+		::BuildFixture(item);
+	}
+	std::string yaml;
+	BitSerializer::SaveObject<YamlArchive>(largeArray, yaml);
+	std::vector<TestPointClass> loadedLargeArray;
+	BitSerializer::LoadObject<YamlArchive>(loadedLargeArray, yaml);
+	ASSERT_EQ(largeArray.size(), loadedLargeArray.size());
+
+	// The reused tree should not contain anything from previous calls
+	std::vector<int> smallArray = { 1, 2 };
+	std::string smallYaml;
+	BitSerializer::SaveObject<YamlArchive>(smallArray, smallYaml);
+	std::vector<int> loadedSmallArray;
+	BitSerializer::LoadObject<YamlArchive>(loadedSmallArray, smallYaml);
+	EXPECT_EQ(smallArray, loadedSmallArray);
+
+	BitSerializer::LoadObject<YamlArchive>(loadedLargeArray, yaml);
+	ASSERT_EQ(largeArray.size(), loadedLargeArray.size());
+	for (size_t i = 0; i < largeArray.size(); ++i) {
+		largeArray[i].Assert(loadedLargeArray[i]);
+	}
+}
+
+namespace
+{
+	std::atomic<size_t> RymlAllocationsCount = 0;
+
+	void* CountingRymlAllocate(size_t len, void* /*hint*/, void* /*userData*/)
+	{
+		++RymlAllocationsCount;
+		return ::operator new(len);
+	}
+
+	void CountingRymlFree(void* mem, size_t /*len*/, void* /*userData*/)
+	{
+		::operator delete(mem);
+	}
+}
+
+TEST(RapidYamlArchive, ShouldReuseTreeOfLargeDocumentWhenAllowedByOptions)
+{
+	std::vector<TestPointClass> largeArray(50000);
+	for (auto& item : largeArray) {
+		::BuildFixture(item);
+	}
+	BitSerializer::SerializationOptions serializationOptions;
+	serializationOptions.maxCachedMemorySize = 64 * 1024 * 1024;
+
+	// The cached tree is created in the new thread with the counting allocator
+	const auto prevCallbacks = ryml::get_callbacks();
+	ryml::set_callbacks(ryml::Callbacks(nullptr, &CountingRymlAllocate, &CountingRymlFree, prevCallbacks.m_error));
+	std::string yaml, nextYaml;
+	size_t allocationsByFirstSave = 0, allocationsBySecondSave = 0;
+	std::thread([&]()
+	{
+		BitSerializer::SaveObject<YamlArchive>(largeArray, yaml, serializationOptions);
+		allocationsByFirstSave = RymlAllocationsCount.exchange(0);
+		BitSerializer::SaveObject<YamlArchive>(largeArray, nextYaml, serializationOptions);
+		allocationsBySecondSave = RymlAllocationsCount.exchange(0);
+	}).join();
+	ryml::set_callbacks(prevCallbacks);
+
+	// Assert
+	ASSERT_GT(yaml.size(), 1024U * 1024U);
+	EXPECT_EQ(yaml, nextYaml);
+	EXPECT_NE(0U, allocationsByFirstSave);
+	EXPECT_EQ(0U, allocationsBySecondSave);
+}
+
 //-----------------------------------------------------------------------------
 // Tests of errors handling
 //-----------------------------------------------------------------------------
@@ -243,6 +524,9 @@ TEST(RapidYamlArchive, ThrowMismatchedTypesExceptionWhenLoadStringToInteger) {
 TEST(RapidYamlArchive, ThrowMismatchedTypesExceptionWhenLoadStringToFloat) {
 	TestMismatchedTypesPolicy<YamlArchive, std::string, float>(BitSerializer::MismatchedTypesPolicy::ThrowError);
 }
+TEST(RapidYamlArchive, ThrowMismatchedTypesExceptionWhenLoadStringToEnum) {
+	TestMismatchedTypesPolicy<YamlArchive, std::string, TestEnum>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
 
 TEST(RapidYamlArchive, ThrowValidationExceptionWhenLoadStringToBoolean) {
 	TestMismatchedTypesPolicy<YamlArchive, std::string, bool>(BitSerializer::MismatchedTypesPolicy::Skip);
@@ -253,6 +537,9 @@ TEST(RapidYamlArchive, ThrowValidationExceptionWhenLoadStringToInteger) {
 TEST(RapidYamlArchive, ThrowValidationExceptionWhenLoadStringToFloat) {
 	TestMismatchedTypesPolicy<YamlArchive, std::string, float>(BitSerializer::MismatchedTypesPolicy::Skip);
 }
+TEST(RapidYamlArchive, ThrowValidationExceptionWhenLoadStringToEnum) {
+	TestMismatchedTypesPolicy<YamlArchive, std::string, TestEnum>(BitSerializer::MismatchedTypesPolicy::Skip);
+}
 TEST(RapidYamlArchive, ThrowValidationExceptionWhenLoadNullToAnyType) {
 	// It doesn't matter what kind of MismatchedTypesPolicy is used, should throw only validation exception
 	TestMismatchedTypesPolicy<YamlArchive, std::nullptr_t, bool>(BitSerializer::MismatchedTypesPolicy::ThrowError);
@@ -0,0 +1,645 @@
+/*******************************************************************************
+* Copyright (C) 2018-2023 by Pavel Kisliak                                     *
+* This file is part of BitSerializer library, licensed under the MIT license.  *
+*******************************************************************************/
+#include <cstring>
+#include <list>
+#include <map>
+#include "testing_tools/common_test_methods.h"
+#include "testing_tools/common_json_test_methods.h"
+#include "bitserializer/snapshot_archive.h"
+#include "bitserializer/types/std/chrono.h"
+#include "bitserializer/types/std/list.h"
+#include "bitserializer/types/std/map.h"
+#include "bitserializer/types/std/vector.h"
+
+using BitSerializer::Snapshot::SnapshotArchive;
+
+namespace
+{
+	constexpr size_t SnapshotHeaderSize = 32;
+
+	template <typename T>
+	std::string SaveToSnapshot(T value)
+	{
+		return BitSerializer::SaveObject<SnapshotArchive>(value);
+	}
+
+	template <typename T>
+	T LoadFromSnapshot(const std::string& data)
+	{
+		T value{};
+		BitSerializer::LoadObject<SnapshotArchive>(value, data);
+		return value;
+	}
+
+	struct TestSnapshotState
+	{
+		template <class TArchive>
+		void Serialize(TArchive& archive)
+		{
+			archive << BitSerializer::MakeAutoKeyValue("name", Name);
+			archive << BitSerializer::MakeAutoKeyValue("ids", Ids);
+			archive << BitSerializer::MakeAutoKeyValue("weights", Weights);
+		}
+
+		std::string Name;
+		std::vector<int64_t> Ids;
+		std::vector<double> Weights;
+	};
+}
+
+#pragma warning(push)
+#pragma warning(disable: 4566)
+
+//-----------------------------------------------------------------------------
+// Tests of serialization for fundamental types (at root scope of archive)
+//-----------------------------------------------------------------------------
+TEST(SnapshotArchive, SerializeBoolean)
+{
+	TestSerializeType<SnapshotArchive, bool>(false);
+	TestSerializeType<SnapshotArchive, bool>(true);
+}
+
+TEST(SnapshotArchive, SerializeInteger)
+{
+	TestSerializeType<SnapshotArchive, uint8_t>(std::numeric_limits<uint8_t>::min());
+	TestSerializeType<SnapshotArchive, uint8_t>(std::numeric_limits<uint8_t>::max());
+	TestSerializeType<SnapshotArchive, int8_t>(std::numeric_limits<int8_t>::min());
+	TestSerializeType<SnapshotArchive, int16_t>(std::numeric_limits<int16_t>::min());
+	TestSerializeType<SnapshotArchive, int32_t>(std::numeric_limits<int32_t>::min());
+	TestSerializeType<SnapshotArchive, uint32_t>(std::numeric_limits<uint32_t>::max());
+	TestSerializeType<SnapshotArchive, int64_t>(std::numeric_limits<int64_t>::min());
+	TestSerializeType<SnapshotArchive, uint64_t>(std::numeric_limits<uint64_t>::max());
+}
+
+TEST(SnapshotArchive, SerializeFloat)
+{
+	TestSerializeType<SnapshotArchive, float>(0.f);
+	TestSerializeType<SnapshotArchive, float>(3.141592654f);
+	TestSerializeType<SnapshotArchive, float>(std::numeric_limits<float>::lowest());
+	TestSerializeType<SnapshotArchive, float>(std::numeric_limits<float>::max());
+}
+
+TEST(SnapshotArchive, SerializeDouble)
+{
+	TestSerializeType<SnapshotArchive, double>(std::numeric_limits<double>::min());
+	TestSerializeType<SnapshotArchive, double>(std::numeric_limits<double>::max());
+	TestSerializeType<SnapshotArchive, double>(0.5);
+}
+
+TEST(SnapshotArchive, ShouldAllowToLoadBooleanFromInteger)
+{
+	EXPECT_EQ(true, LoadFromSnapshot<bool>(SaveToSnapshot(uint8_t(1))));
+}
+
+TEST(SnapshotArchive, ShouldAllowToLoadFloatFromInteger)
+{
+	EXPECT_EQ(100, LoadFromSnapshot<float>(SaveToSnapshot(int64_t(100))));
+}
+
+TEST(SnapshotArchive, SerializeNullptr)
+{
+	TestSerializeType<SnapshotArchive, std::nullptr_t>(nullptr);
+}
+
+TEST(SnapshotArchive, SerializeUtf8Sting)
+{
+	TestSerializeType<SnapshotArchive, std::string>("Test ANSI string");
+	TestSerializeType<SnapshotArchive, std::string>(u8"Test UTF8 string - Привет мир!");
+}
+
+TEST(SnapshotArchive, SerializeUnicodeString)
+{
+	TestSerializeType<SnapshotArchive, std::wstring>(L"Test wide string - Привет мир!");
+	TestSerializeType<SnapshotArchive, std::u16string>(u"Test UTF-16 string - Привет мир!");
+	TestSerializeType<SnapshotArchive, std::u32string>(U"Test UTF-32 string - Привет мир!");
+}
+
+TEST(SnapshotArchive, SerializeEnum)
+{
+	TestSerializeType<SnapshotArchive, TestEnum>(TestEnum::Two);
+}
+
+//-----------------------------------------------------------------------------
+// Tests of serialization for c-arrays (at root scope of archive)
+//-----------------------------------------------------------------------------
+TEST(SnapshotArchive, SerializeArrayOfBooleans)
+{
+	TestSerializeArray<SnapshotArchive, bool>();
+}
+
+TEST(SnapshotArchive, SerializeArrayOfChars)
+{
+	TestSerializeArray<SnapshotArchive, char>();
+	TestSerializeArray<SnapshotArchive, unsigned char>();
+}
+
+TEST(SnapshotArchive, SerializeArrayOfIntegers)
+{
+	TestSerializeArray<SnapshotArchive, uint16_t>();
+	TestSerializeArray<SnapshotArchive, int64_t>();
+}
+
+TEST(SnapshotArchive, SerializeArrayOfFloats)
+{
+	TestSerializeVector<SnapshotArchive, float>({ -3.141592654f, 0.0f, -3.141592654f });
+}
+
+TEST(SnapshotArchive, SerializeArrayOfDoubles)
+{
+	TestSerializeArray<SnapshotArchive, double>();
+}
+
+TEST(SnapshotArchive, SerializeArrayOfNullptrs)
+{
+	TestSerializeArray<SnapshotArchive, std::nullptr_t>();
+}
+
+TEST(SnapshotArchive, SerializeArrayOfStrings)
+{
+	TestSerializeArray<SnapshotArchive, std::string>();
+}
+
+TEST(SnapshotArchive, SerializeArrayOfUnicodeStrings)
+{
+	TestSerializeArray<SnapshotArchive, std::wstring>();
+	TestSerializeArray<SnapshotArchive, std::u16string>();
+	TestSerializeArray<SnapshotArchive, std::u32string>();
+}
+
+TEST(SnapshotArchive, SerializeArrayOfClasses)
+{
+	TestSerializeArray<SnapshotArchive, TestPointClass>();
+}
+
+TEST(SnapshotArchive, SerializeTwoDimensionalArray)
+{
+	TestSerializeTwoDimensionalArray<SnapshotArchive, int32_t>();
+}
+
+TEST(SnapshotArchive, ShouldLoadArrayWithExactSize)
+{
+	std::vector<int16_t> expected(1000);
+	for (size_t i = 0; i < expected.size(); ++i) {
+		expected[i] = static_cast<int16_t>(i * 31);
+	}
+	std::vector<int16_t> actual;
+
+	const auto data = BitSerializer::SaveObject<SnapshotArchive>(expected);
+	BitSerializer::LoadObject<SnapshotArchive>(actual, data);
+
+	EXPECT_EQ(expected, actual);
+	EXPECT_EQ(expected.size(), actual.capacity());
+}
+
+//-----------------------------------------------------------------------------
+// Tests of serialization for classes
+//-----------------------------------------------------------------------------
+TEST(SnapshotArchive, SerializeClassWithMemberBoolean)
+{
+	TestSerializeClass<SnapshotArchive>(TestClassWithSubTypes<bool>(false));
+	TestSerializeClass<SnapshotArchive>(TestClassWithSubTypes<bool>(true));
+}
+
+TEST(SnapshotArchive, SerializeClassWithMemberInteger)
+{
+	TestSerializeClass<SnapshotArchive>(BuildFixture<TestClassWithSubTypes<int8_t, uint8_t, int64_t, uint64_t>>());
+	TestSerializeClass<SnapshotArchive>(TestClassWithSubTypes(std::numeric_limits<int64_t>::min(), std::numeric_limits<uint64_t>::max()));
+}
+
+TEST(SnapshotArchive, SerializeClassWithMemberFloat)
+{
+	TestSerializeClass<SnapshotArchive>(TestClassWithSubTypes(std::numeric_limits<float>::lowest(), 0.0f, std::numeric_limits<float>::max()));
+}
+
+TEST(SnapshotArchive, SerializeClassWithMemberDouble)
+{
+	TestSerializeClass<SnapshotArchive>(TestClassWithSubTypes(std::numeric_limits<double>::min(), 0.0, std::numeric_limits<double>::max()));
+}
+
+TEST(SnapshotArchive, SerializeClassWithMemberNullptr)
+{
+	TestSerializeClass<SnapshotArchive>(BuildFixture<TestClassWithSubTypes<std::nullptr_t>>());
+}
+
+TEST(SnapshotArchive, SerializeClassWithMemberString)
+{
+	TestSerializeClass<SnapshotArchive>(BuildFixture<TestClassWithSubTypes<std::string, std::wstring, std::u16string, std::u32string>>());
+}
+
+TEST(SnapshotArchive, SerializeClassHierarchy)
+{
+	TestSerializeClass<SnapshotArchive>(BuildFixture<TestClassWithInheritance>());
+}
+
+TEST(SnapshotArchive, SerializeClassWithMemberClass)
+{
+	using TestClassType = TestClassWithSubTypes<TestClassWithSubTypes<int64_t>>;
+	TestSerializeClass<SnapshotArchive>(BuildFixture<TestClassType>());
+}
+
+TEST(SnapshotArchive, SerializeClassWithSubArray)
+{
+	TestSerializeClass<SnapshotArchive>(BuildFixture<TestClassWithSubArray<int64_t>>());
+}
+
+TEST(SnapshotArchive, SerializeClassWithSubArrayOfClasses)
+{
+	TestSerializeClass<SnapshotArchive>(BuildFixture<TestClassWithSubArray<TestPointClass>>());
+}
+
+TEST(SnapshotArchive, SerializeClassWithSubTwoDimArray)
+{
+	TestSerializeClass<SnapshotArchive>(BuildFixture<TestClassWithSubTwoDimArray<int32_t>>());
+}
+
+//-----------------------------------------------------------------------------
+// Tests of snapshot layout
+//-----------------------------------------------------------------------------
+TEST(SnapshotArchive, ShouldWriteHeaderWithSchemaFingerprint)
+{
+	BitSerializer::SerializationOptions options;
+	options.schemaFingerprint = 0x0102030405060708;
+	std::string data;
+	int32_t value = 100;
+	BitSerializer::SaveObject<SnapshotArchive>(value, data, options);
+
+	ASSERT_LE(SnapshotHeaderSize, data.size());
+	EXPECT_EQ("BSSN", data.substr(0, 4));
+	uint64_t fingerprint, payloadSize;
+	std::memcpy(&fingerprint, data.data() + 16, sizeof(fingerprint));
+	std::memcpy(&payloadSize, data.data() + 24, sizeof(payloadSize));
+	EXPECT_EQ(options.schemaFingerprint, fingerprint);
+	EXPECT_EQ(data.size() - SnapshotHeaderSize, payloadSize);
+}
+
+TEST(SnapshotArchive, SaveArrayOfNumbersAsContinuousBlock)
+{
+	const std::vector<int32_t> expected = { 1, -2, 3, std::numeric_limits<int32_t>::max() };
+	const auto data = SaveToSnapshot(expected);
+
+	// Type code, type of items, padding, number of items (uint64) and items
+	const size_t itemsOffset = SnapshotHeaderSize + 16;
+	ASSERT_EQ(itemsOffset + expected.size() * sizeof(int32_t), data.size());
+	EXPECT_EQ(0, std::memcmp(data.data() + itemsOffset, expected.data(), expected.size() * sizeof(int32_t)));
+	EXPECT_EQ(expected, LoadFromSnapshot<std::vector<int32_t>>(data));
+}
+
+TEST(SnapshotArchive, ShouldAlignNumbersInObject)
+{
+	TestSnapshotState expected;
+	expected.Name = "state";
+	expected.Ids = { 1, 2, 3 };
+	expected.Weights = { 0.5, 1.5 };
+
+	const auto data = SaveToSnapshot(expected);
+
+	const std::string_view weights(reinterpret_cast<const char*>(expected.Weights.data()), expected.Weights.size() * sizeof(double));
+	const auto weightsPos = data.find(weights);
+	ASSERT_NE(std::string::npos, weightsPos);
+	EXPECT_EQ(0U, weightsPos % sizeof(double));
+
+	const auto actual = LoadFromSnapshot<TestSnapshotState>(data);
+	EXPECT_EQ(expected.Name, actual.Name);
+	EXPECT_EQ(expected.Ids, actual.Ids);
+	EXPECT_EQ(expected.Weights, actual.Weights);
+}
+
+TEST(SnapshotArchive, ShouldLoadBlockWithConversionToOtherType)
+{
+	const std::vector<int16_t> expected = { -1000, 0, 1000 };
+	const auto data = SaveToSnapshot(expected);
+
+	EXPECT_EQ(std::vector<int64_t>({ -1000, 0, 1000 }), LoadFromSnapshot<std::vector<int64_t>>(data));
+	EXPECT_EQ(std::vector<double>({ -1000.0, 0.0, 1000.0 }), LoadFromSnapshot<std::vector<double>>(data));
+	EXPECT_EQ(std::list<int16_t>({ -1000, 0, 1000 }), LoadFromSnapshot<std::list<int16_t>>(data));
+}
+
+TEST(SnapshotArchive, ShouldLoadBlockFromArrayOfValues)
+{
+	const std::list<uint8_t> expected = { 1, 2, 3 };
+	const auto data = SaveToSnapshot(expected);
+
+	EXPECT_EQ(std::vector<uint8_t>({ 1, 2, 3 }), LoadFromSnapshot<std::vector<uint8_t>>(data));
+}
+
+TEST(SnapshotArchive, ThrowOverflowExceptionWhenLoadBlockToSmallerType)
+{
+	const auto data = SaveToSnapshot(std::vector<int32_t>({ 1, 100000 }));
+	try
+	{
+		LoadFromSnapshot<std::vector<int16_t>>(data);
+		EXPECT_FALSE(true);
+	}
+	catch (const BitSerializer::SerializationException& ex)
+	{
+		EXPECT_EQ(BitSerializer::SerializationErrorCode::Overflow, ex.GetErrorCode());
+	}
+}
+
+TEST(SnapshotArchive, ShouldLoadStringAsViewToInputData)
+{
+	const auto data = SaveToSnapshot(std::string("Hello world"));
+	BitSerializer::SerializationOptions options;
+	BitSerializer::SerializationContext context(options);
+	SnapshotArchive::input_archive_type inputArchive(data, context);
+
+	std::string_view actual;
+	ASSERT_TRUE(inputArchive.SerializeValue(actual));
+	EXPECT_EQ("Hello world", actual);
+	EXPECT_EQ(data.data() + SnapshotHeaderSize + 16, actual.data());
+}
+
+TEST(SnapshotArchive, SerializeTimePoint)
+{
+	using namespace std::chrono;
+	TestSerializeType<SnapshotArchive>(time_point<system_clock, seconds>(seconds(-2208988800)));
+	TestSerializeType<SnapshotArchive>(time_point<system_clock, nanoseconds>(nanoseconds(1689371091925000001)));
+	TestSerializeClass<SnapshotArchive>(TestClassWithSubType(time_point<system_clock, microseconds>(microseconds(-1))));
+}
+
+TEST(SnapshotArchive, ShouldLoadValuesInAnyOrder)
+{
+	// Arrange
+	std::string outputData;
+	{
+		BitSerializer::SerializationOptions options;
+		BitSerializer::SerializationContext context(options);
+		SnapshotArchive::output_archive_type outputArchive(outputData, context);
+		{
+			auto objScope = outputArchive.OpenObjectScope();
+			int y = 20, x = 10;
+			std::vector<int> unknown(100);
+			objScope->SerializeValue("y", y);
+			BitSerializer::Serialize(*objScope, "unknown", unknown);
+			objScope->SerializeValue("x", x);
+		}
+		outputArchive.Finalize();
+	}
+	TestPointClass actual(0, 0);
+
+	// Act
+	BitSerializer::LoadObject<SnapshotArchive>(actual, outputData);
+
+	// Assert
+	TestPointClass(10, 20).Assert(actual);
+}
+
+TEST(SnapshotArchive, ShouldIterateKeysInObjectScope)
+{
+	TestIterateKeysInObjectScope<SnapshotArchive>();
+}
+
+//-----------------------------------------------------------------------------
+// Test paths in archive
+//-----------------------------------------------------------------------------
+TEST(SnapshotArchive, ShouldReturnPathInObjectScopeWhenLoading)
+{
+	TestGetPathInJsonObjectScopeWhenLoading<SnapshotArchive>();
+}
+
+TEST(SnapshotArchive, ShouldReturnPathInObjectScopeWhenSaving)
+{
+	TestGetPathInJsonObjectScopeWhenSaving<SnapshotArchive>();
+}
+
+TEST(SnapshotArchive, ShouldReturnPathInArrayScopeWhenLoading)
+{
+	TestGetPathInJsonArrayScopeWhenLoading<SnapshotArchive>();
+}
+
+TEST(SnapshotArchive, ShouldReturnPathInArrayScopeWhenSaving)
+{
+	TestGetPathInJsonArrayScopeWhenSaving<SnapshotArchive>();
+}
+
+//-----------------------------------------------------------------------------
+// Tests streams / files / binary vector
+//-----------------------------------------------------------------------------
+TEST(SnapshotArchive, SerializeClassToStream) {
+	TestSerializeClassToStream<SnapshotArchive, char>(BuildFixture<TestPointClass>());
+}
+
+TEST(SnapshotArchive, SerializeUnicodeToStream) {
+	TestClassWithSubType<std::wstring> TestValue(L"Привет мир!");
+	TestSerializeClassToStream<SnapshotArchive, char>(TestValue);
+}
+
+TEST(SnapshotArchive, SerializeLargeArrayToStream)
+{
+	std::vector<TestPointClass> expected(10000);
+	::BuildFixture(expected);
+	std::vector<TestPointClass> actual;
+
+	std::stringstream outputStream;
+	BitSerializer::SaveObject<SnapshotArchive>(expected, outputStream);
+	EXPECT_EQ(BitSerializer::SaveObject<SnapshotArchive>(expected), outputStream.str());
+	outputStream.seekg(0, std::ios::beg);
+	BitSerializer::LoadObject<SnapshotArchive>(actual, outputStream);
+
+	ASSERT_EQ(expected.size(), actual.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		expected[i].Assert(actual[i]);
+	}
+}
+
+TEST(SnapshotArchive, SerializeClassToBinaryVector)
+{
+	auto expected = BuildFixture<TestClassWithSubTypes<int64_t, std::string, double>>();
+	decltype(expected) actual;
+
+	std::vector<uint8_t> outputData;
+	BitSerializer::SaveObject<SnapshotArchive>(expected, outputData);
+	BitSerializer::LoadObject<SnapshotArchive>(actual, outputData);
+
+	expected.Assert(actual);
+}
+
+TEST(SnapshotArchive, SerializeToFile) {
+	TestSerializeArrayToFile<SnapshotArchive>();
+}
+
+//-----------------------------------------------------------------------------
+// Tests of errors handling
+//-----------------------------------------------------------------------------
+TEST(SnapshotArchive, ThrowParsingExceptionWhenInputIsEmpty)
+{
+	int testInt = 0;
+	EXPECT_THROW(BitSerializer::LoadObject<SnapshotArchive>(testInt, std::string()), BitSerializer::ParsingException);
+}
+
+TEST(SnapshotArchive, ThrowParsingExceptionWhenHeaderIsInvalid)
+{
+	auto data = SaveToSnapshot(int32_t(1));
+	data[0] = 'X';
+	EXPECT_THROW(LoadFromSnapshot<int32_t>(data), BitSerializer::ParsingException);
+}
+
+TEST(SnapshotArchive, ThrowParsingExceptionWhenByteOrderIsDifferent)
+{
+	auto data = SaveToSnapshot(int32_t(1));
+	std::swap(data[8], data[11]);
+	std::swap(data[9], data[10]);
+	EXPECT_THROW(LoadFromSnapshot<int32_t>(data), BitSerializer::ParsingException);
+}
+
+TEST(SnapshotArchive, ThrowParsingExceptionWithCorrectPosition)
+{
+	// Array of two items, where the second one has invalid type code
+	auto data = SaveToSnapshot(std::vector<std::string>({ "a", "b" }));
+	const auto pos = data.rfind('b') - 8 - 7;
+	ASSERT_EQ('\x0D', data[pos]);
+	data[pos] = '\x7F';
+
+	try
+	{
+		LoadFromSnapshot<std::vector<std::string>>(data);
+		EXPECT_FALSE(true);
+	}
+	catch (const BitSerializer::ParsingException& ex)
+	{
+		EXPECT_EQ(pos, ex.Offset);
+	}
+}
+
+TEST(SnapshotArchive, ThrowMismatchedTypesExceptionWhenSchemaFingerprintIsDifferent)
+{
+	BitSerializer::SerializationOptions options;
+	options.schemaFingerprint = 0xABCD;
+	std::string data;
+	int32_t value = 100;
+	BitSerializer::SaveObject<SnapshotArchive>(value, data, options);
+
+	int32_t actual = 0;
+	BitSerializer::LoadObject<SnapshotArchive>(actual, data);
+	EXPECT_EQ(100, actual);
+	BitSerializer::LoadObject<SnapshotArchive>(actual, data, options);
+	EXPECT_EQ(100, actual);
+
+	options.schemaFingerprint = 0xABCE;
+	try
+	{
+		BitSerializer::LoadObject<SnapshotArchive>(actual, data, options);
+		EXPECT_FALSE(true);
+	}
+	catch (const BitSerializer::SerializationException& ex)
+	{
+		EXPECT_EQ(BitSerializer::SerializationErrorCode::MismatchedTypes, ex.GetErrorCode());
+	}
+}
+
+TEST(SnapshotArchive, ThrowParsingExceptionWhenDataIsTruncated)
+{
+	auto testObj = BuildFixture<TestClassWithSubTypes<std::string, int64_t>>();
+	const auto data = BitSerializer::SaveObject<SnapshotArchive>(testObj);
+	for (size_t size = 0; size < data.size(); ++size)
+	{
+		EXPECT_THROW(BitSerializer::LoadObject<SnapshotArchive>(testObj, data.substr(0, size)), BitSerializer::ParsingException);
+	}
+}
+
+//-----------------------------------------------------------------------------
+TEST(SnapshotArchive, ThrowValidationExceptionWhenMissedRequiredValue) {
+	TestValidationForNamedValues<SnapshotArchive, TestClassForCheckValidation<bool>>();
+	TestValidationForNamedValues<SnapshotArchive, TestClassForCheckValidation<int>>();
+	TestValidationForNamedValues<SnapshotArchive, TestClassForCheckValidation<double>>();
+	TestValidationForNamedValues<SnapshotArchive, TestClassForCheckValidation<std::string>>();
+	TestValidationForNamedValues<SnapshotArchive, TestClassForCheckValidation<TestPointClass>>();
+	TestValidationForNamedValues<SnapshotArchive, TestClassForCheckValidation<int[3]>>();
+}
+
+//-----------------------------------------------------------------------------
+TEST(SnapshotArchive, ThrowMismatchedTypesExceptionWhenLoadStringToBoolean) {
+	TestMismatchedTypesPolicy<SnapshotArchive, std::string, bool>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+TEST(SnapshotArchive, ThrowMismatchedTypesExceptionWhenLoadStringToInteger) {
+	TestMismatchedTypesPolicy<SnapshotArchive, std::string, int32_t>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+TEST(SnapshotArchive, ThrowMismatchedTypesExceptionWhenLoadStringToFloat) {
+	TestMismatchedTypesPolicy<SnapshotArchive, std::string, float>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+TEST(SnapshotArchive, ThrowMismatchedTypesExceptionWhenLoadNumberToString) {
+	TestMismatchedTypesPolicy<SnapshotArchive, int32_t, std::string>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+
+TEST(SnapshotArchive, ThrowValidationExceptionWhenLoadStringToBoolean) {
+	TestMismatchedTypesPolicy<SnapshotArchive, std::string, bool>(BitSerializer::MismatchedTypesPolicy::Skip);
+}
+TEST(SnapshotArchive, ThrowValidationExceptionWhenLoadStringToInteger) {
+	TestMismatchedTypesPolicy<SnapshotArchive, std::string, int32_t>(BitSerializer::MismatchedTypesPolicy::Skip);
+}
+TEST(SnapshotArchive, ThrowValidationExceptionWhenLoadStringToFloat) {
+	TestMismatchedTypesPolicy<SnapshotArchive, std::string, float>(BitSerializer::MismatchedTypesPolicy::Skip);
+}
+TEST(SnapshotArchive, ThrowValidationExceptionWhenLoadNullToAnyType) {
+	// It doesn't matter what kind of MismatchedTypesPolicy is used, should throw only validation exception
+	TestMismatchedTypesPolicy<SnapshotArchive, std::nullptr_t, bool>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+	TestMismatchedTypesPolicy<SnapshotArchive, std::nullptr_t, uint32_t>(BitSerializer::MismatchedTypesPolicy::Skip);
+	TestMismatchedTypesPolicy<SnapshotArchive, std::nullptr_t, double>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+	TestMismatchedTypesPolicy<SnapshotArchive, std::nullptr_t, std::string>(BitSerializer::MismatchedTypesPolicy::ThrowError);
+}
+
+//-----------------------------------------------------------------------------
+
+TEST(SnapshotArchive, ThrowSerializationExceptionWhenOverflowBool) {
+	TestOverflowNumberPolicy<SnapshotArchive, int32_t, bool>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(SnapshotArchive, ThrowSerializationExceptionWhenOverflowInt8) {
+	TestOverflowNumberPolicy<SnapshotArchive, int16_t, int8_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<SnapshotArchive, uint16_t, uint8_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(SnapshotArchive, ThrowSerializationExceptionWhenOverflowInt16) {
+	TestOverflowNumberPolicy<SnapshotArchive, int32_t, int16_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<SnapshotArchive, uint32_t, uint16_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(SnapshotArchive, ThrowSerializationExceptionWhenOverflowInt32) {
+	TestOverflowNumberPolicy<SnapshotArchive, int64_t, int32_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<SnapshotArchive, uint64_t, uint32_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(SnapshotArchive, ThrowSerializationExceptionWhenOverflowFloat) {
+	TestOverflowNumberPolicy<SnapshotArchive, double, float>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(SnapshotArchive, ThrowSerializationExceptionWhenLoadFloatToInteger) {
+	TestOverflowNumberPolicy<SnapshotArchive, float, uint32_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+	TestOverflowNumberPolicy<SnapshotArchive, double, uint32_t>(BitSerializer::OverflowNumberPolicy::ThrowError);
+}
+TEST(SnapshotArchive, ThrowSerializationExceptionWhenLoadNegativeToUnsigned)
+{
+	uint64_t actual = 0;
+	const auto data = SaveToSnapshot(int64_t(-1));
+	try
+	{
+		BitSerializer::LoadObject<SnapshotArchive>(actual, data);
+		EXPECT_FALSE(true);
+	}
+	catch (const BitSerializer::SerializationException& ex)
+	{
+		EXPECT_EQ(BitSerializer::SerializationErrorCode::Overflow, ex.GetErrorCode());
+	}
+}
+
+TEST(SnapshotArchive, ThrowValidationExceptionWhenOverflowBool) {
+	TestOverflowNumberPolicy<SnapshotArchive, int32_t, bool>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(SnapshotArchive, ThrowValidationExceptionWhenNumberOverflowInt8) {
+	TestOverflowNumberPolicy<SnapshotArchive, int16_t, int8_t>(BitSerializer::OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<SnapshotArchive, uint16_t, uint8_t>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(SnapshotArchive, ThrowValidationExceptionWhenNumberOverflowInt16) {
+	TestOverflowNumberPolicy<SnapshotArchive, int32_t, int16_t>(BitSerializer::OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<SnapshotArchive, uint32_t, uint16_t>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(SnapshotArchive, ThrowValidationExceptionWhenNumberOverflowInt32) {
+	TestOverflowNumberPolicy<SnapshotArchive, int64_t, int32_t>(BitSerializer::OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<SnapshotArchive, uint64_t, uint32_t>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(SnapshotArchive, ThrowValidationExceptionWhenNumberOverflowFloat) {
+	TestOverflowNumberPolicy<SnapshotArchive, double, float>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+TEST(SnapshotArchive, ThrowValidationExceptionWhenLoadFloatToInteger) {
+	TestOverflowNumberPolicy<SnapshotArchive, float, uint32_t>(BitSerializer::OverflowNumberPolicy::Skip);
+	TestOverflowNumberPolicy<SnapshotArchive, double, uint32_t>(BitSerializer::OverflowNumberPolicy::Skip);
+}
+
+#pragma warning(pop)